@@ -16,6 +16,7 @@
 
 #include <dsd-neo/core/opts_fwd.h>
 #include <dsd-neo/core/state_fwd.h>
+#include <dsd-neo/core/upsample.h>
 #include <dsd-neo/platform/audio.h>
 
 #include <stddef.h>
@@ -92,15 +93,21 @@ void analog_gain_f(dsd_opts* opts, dsd_state* state, float* input, int len); //
 
 /** @brief Multiply float buffer by gain factor in-place. */
 void audio_apply_gain_f32(float* buf, size_t n, float gain);
-/** @brief Multiply int16 buffer by gain factor in-place. */
+/** @brief Multiply int16 buffer by gain factor in-place, saturating to the int16 range. */
 void audio_apply_gain_s16(short* buf, size_t n, float gain);
-
-/** @brief Simple legacy 8k→48k upsampler (6:1) with linear interpolation. */
-void upsampleS(short invalue, short prev, short outbuf[6]);
-/** @brief Float 8k→48k upsampler (6:1) with linear interpolation. */
-void upsampleF(float invalue, float prev, float outbuf[6]);
-/** @brief Legacy analog monitor 6x upsampler (sample repetition). */
-void upsample(dsd_state* state, float invalue);
+/**
+ * @brief Float voice autogain kernel behind agf().
+ *
+ * Scales PCM-level samples by the slot's current level, clips to ±0.9, applies
+ * `out_gain * 0.8` and steps the level by ±0.5 after every 20-sample block.
+ * All-zero buffers are left untouched.
+ *
+ * @param samp     Samples, processed in place in whole 20-sample blocks.
+ * @param n        Number of samples.
+ * @param level    Per-slot autogain level (1..46), updated in place.
+ * @param out_gain Output gain multiplier.
+ */
+void audio_agf_f32(float* samp, size_t n, float* level, float out_gain);
 
 /** @brief Convert float samples to int16 with scaling. */
 void audio_float_to_s16(const float* in, short* out, size_t n, float scale);
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Sparse trunking channel-to-frequency map with a reverse index.
+ *
+ * Channel numbers span 16 bits but a site only ever uses a few hundred, so the
+ * map is a fixed-size open-addressing table embedded in `dsd_state` (no heap
+ * pointers, so state snapshots stay plain copies). A second table indexes the
+ * same entries by frequency. The mapped channels are also kept as a sorted
+ * list, updated as mappings are learned or changed, so displays walk them in
+ * channel order without collecting and sorting on every refresh.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Table slots (power of two). */
+#define DSD_CHAN_MAP_SLOTS 4096
+/** @brief Maximum mapped channels; inserts beyond this fail. */
+#define DSD_CHAN_MAP_MAX_ENTRIES 3072
+/** @brief Highest valid channel number. */
+#define DSD_CHAN_MAP_MAX_CHANNEL 0xFFFE
+
+typedef struct dsd_chan_map_entry {
+    uint32_t key; /* channel + 1, 0 = empty */
+    long int freq;
+} dsd_chan_map_entry;
+
+typedef struct dsd_chan_map {
+    dsd_chan_map_entry by_chan[DSD_CHAN_MAP_SLOTS]; /* keyed by channel */
+    dsd_chan_map_entry by_freq[DSD_CHAN_MAP_SLOTS]; /* same entries keyed by frequency */
+    uint16_t sorted[DSD_CHAN_MAP_MAX_ENTRIES];      /* mapped channels, ascending; `count` valid */
+    uint32_t count;
+    uint32_t distinct_freqs; /* frequencies mapped by at least one channel */
+} dsd_chan_map;
+
+/** @brief Callback for dsd_chan_map_foreach(); return non-zero to stop. */
+typedef int (*dsd_chan_map_visit_fn)(long int channel, long int freq, void* user);
+
+/** @brief Remove every mapping. A zero-filled map is also empty. */
+void dsd_chan_map_clear(dsd_chan_map* map);
+
+/** @brief Frequency mapped to `channel` in Hz, or 0 when unmapped or out of range. */
+long int dsd_chan_map_get(const dsd_chan_map* map, long int channel);
+
+/**
+ * @brief Map `channel` to `freq`; a zero frequency removes the mapping.
+ *
+ * @return 0 on success, -1 when the channel is out of range or the map is full.
+ */
+int dsd_chan_map_set(dsd_chan_map* map, long int channel, long int freq);
+
+/** @brief Lowest channel mapped to `freq`, or -1 when none. */
+long int dsd_chan_map_find_freq(const dsd_chan_map* map, long int freq);
+
+/** @brief Number of mapped channels. */
+static inline uint32_t
+dsd_chan_map_count(const dsd_chan_map* map) {
+    return map->count;
+}
+
+/** @brief Mapped channels in ascending order; `dsd_chan_map_count()` entries. */
+static inline const uint16_t*
+dsd_chan_map_sorted(const dsd_chan_map* map) {
+    return map->sorted;
+}
+
+/** @brief Number of distinct mapped frequencies. */
+static inline uint32_t
+dsd_chan_map_distinct_freqs(const dsd_chan_map* map) {
+    return map->distinct_freqs;
+}
+
+/**
+ * @brief Visit every mapped channel in ascending channel order.
+ *
+ * The map must not be modified from the callback.
+ *
+ * @return Number of entries visited.
+ */
+size_t dsd_chan_map_foreach(const dsd_chan_map* map, dsd_chan_map_visit_fn fn, void* user);
+
+#ifdef __cplusplus
+}
+#endif
@@ -63,6 +63,7 @@ struct dsd_opts {
     dsd_audio_stream* audio_out_streamR; /* Secondary audio output stream (slot 2/right) */
     dsd_audio_stream* audio_raw_out;     /* Raw/analog audio output stream (48kHz) */
     FILE* symbolfile;
+    unsigned int symbolfile_gen; /* bumped by dsd_symbol_in_close(); keys the replay reader */
     void* udp_in_ctx;                  // opaque UDP input context
     unsigned long long udp_in_packets; // received datagrams
     unsigned long long udp_in_bytes;   // received bytes
@@ -140,6 +141,8 @@ struct dsd_opts {
     /* Android native USB RTL-SDR support */
     int rtl_android_usb_fd;        /* USB file descriptor from Android UsbDeviceConnection (-1 if not used) */
     char rtl_android_usb_path[256]; /* USB device path from Android UsbDevice.getDeviceName() */
+    /* 1 when IQ is pushed in-process by the host app (rtl_device_push_iq), e.g. a HackRF owned by Java */
+    int rtl_external_iq;
     /* Base DSP bandwidth for RTL path in kHz (4,6,8,12,16,24,48). Influences capture rate planning.
        Not the hardware tuner IF bandwidth. */
     int rtl_dsp_bw_khz;
@@ -13,13 +13,17 @@
 
 #pragma once
 
+#include <dsd-neo/core/chan_map.h>
 #include <dsd-neo/core/state_ext.h>
 #include <dsd-neo/core/state_fwd.h>
+#include <dsd-neo/core/unit_registry.h>
+#include <dsd-neo/core/upsample.h>
 
 #include <stdbool.h>
 #include <stdint.h>
 #include <time.h>
 
+#include <dsd-neo/crypto/rc4.h>
 #include <dsd-neo/fec/rs_12_9.h>
 
 #include <dsd-neo/dsp/p25p1_heuristics.h>
@@ -34,6 +38,9 @@ struct RtlSdrContext;
 /* Forward declaration for Codec2 context (opaque, always present in ABI) */
 struct CODEC2;
 
+/* Forward declaration for the runtime config snapshot (see runtime/config.h) */
+struct dsdneoRuntimeConfig;
+
 //event history (each item)
 // NOLINTBEGIN(clang-analyzer-optin.performance.Padding)
 // The dsd_state structure is intentionally organized by functional groups for clarity
@@ -157,6 +164,10 @@ typedef struct {
     uint8_t NextIVComputed[8];
 } NxdnElementsContent_t;
 
+// P25 affiliation registry limits (least recently seen entries are evicted beyond these)
+#define DSD_P25_AFF_MAX_ENTRIES 16384
+#define DSD_P25_GA_MAX_ENTRIES  32768
+
 //dPMR
 /* Could only be 2 or 4 */
 #define NB_OF_DPMR_VOICE_FRAME_TO_DECODE 2
@@ -274,7 +285,7 @@ struct dsd_state {
     long int trunk_vc_freq[2]; //protocol-agnostic alias (kept in sync with p25_vc_freq)
     // Trunking LCNs and maps
     long int trunk_lcn_freq[26];
-    long int trunk_chan_map[0xFFFF];
+    dsd_chan_map trunk_chan_map; //channel -> frequency (Hz), see core/chan_map.h
     // DMR Tier III: simple provenance/trust for learned LCN->freq mappings
     // 0=unset, 1=learned (unconfirmed), 2=trusted (confirmed on-current-site CC)
     uint8_t dmr_lcn_trust[0x1000];
@@ -307,6 +318,8 @@ struct dsd_state {
     short s_ru[160 * 6];     //single sample right
     short s_l4u[4][160 * 6]; //quad sample for up to a P25p2 4V
     short s_r4u[4][160 * 6]; //quad sample for up to a P25p2 4V
+    dsd_upsampler upsample_l; //8k->48k filter history, left / slot 1
+    dsd_upsampler upsample_r; //8k->48k filter history, right / slot 2
     int audio_out_idx;
     int audio_out_idx2;
     int audio_out_idxR;
@@ -536,6 +549,7 @@ struct dsd_state {
     unsigned int dmrburstR;
     int dropL;
     int dropR;
+    rc4_stream rc4_voice[2]; //per-slot RC4 voice keystream, keyed on key||MI
     int DMRvcL;
     int DMRvcR;
 
@@ -567,12 +581,7 @@ struct dsd_state {
     int p2_is_lcch;         //flag to tell us when a frame is lcch and not sacch
     // P25p2 per-slot audio gating (set on MAC_PTT/ACTIVE, cleared on MAC_END/IDLE/SIGNAL)
     int p25_p2_audio_allowed[2];
-    // P25p2 small output jitter buffers (per-slot ring of decoded 20 ms frames)
-    // Depth 3 per checklist to bound latency (~60 ms max)
-    float p25_p2_audio_ring[2][3][160];
-    int p25_p2_audio_ring_head[2]; // pop index
-    int p25_p2_audio_ring_tail[2]; // push index
-    int p25_p2_audio_ring_count[2];
+    // P25p2 per-slot output jitter buffers live in a state_ext slot (runtime/p25_p2_audio_ring.h)
     // P25p2 currently active voice slot (0 or 1), -1 when unknown/idle
     int p25_p2_active_slot;
     // P25p2 recent MAC_ACTIVE/PTT timestamps per slot (guards early bounce)
@@ -729,19 +738,13 @@ struct dsd_state {
     // Whether p25_patch_key[i] has been explicitly set by a GRG command
     uint8_t p25_patch_key_valid[8];
 
-    // P25 affiliated RIDs tracking (simple fixed-size table)
-    // Tracks up to 256 recent unit registrations (RIDs) with last-seen time for aging.
+    // P25 affiliated RIDs tracking (hashed, least-recently-seen ordered; tg is always 0).
     // Entries are added on Unit Registration Accept and removed on Deregistration Ack
-    // or when the last-seen exceeds an aging threshold.
-    int p25_aff_count;             // number of active entries
-    uint32_t p25_aff_rid[256];     // RID values
-    time_t p25_aff_last_seen[256]; // last seen timestamp per RID
+    // or when the last-seen exceeds an aging threshold. Entries are dense in [0, count).
+    dsd_unit_registry p25_aff;
 
     // P25 Group Affiliation tracking: RID↔TG observations with aging
-    int p25_ga_count;
-    uint32_t p25_ga_rid[512];
-    uint16_t p25_ga_tg[512];
-    time_t p25_ga_last_seen[512];
+    dsd_unit_registry p25_ga;
 
     // P25 neighbors seen via Adjacent Status (best-effort)
     // Track a small set of recently announced neighbor/control candidates for UI purposes.
@@ -933,6 +936,9 @@ struct dsd_state {
     // Transient UI message (shown briefly in ncurses printer)
     char ui_msg[128];
 
+    // Immutable runtime config snapshot for decode paths; refreshed at each getFrameSync entry.
+    const struct dsdneoRuntimeConfig* rt_cfg;
+
     // Extension slots for module-owned per-state allocations (see core/state_ext.h).
     void* state_ext[DSD_STATE_EXT_MAX];
     dsd_state_ext_cleanup_fn state_ext_cleanup[DSD_STATE_EXT_MAX];
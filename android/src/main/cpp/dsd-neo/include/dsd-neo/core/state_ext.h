@@ -45,7 +45,12 @@ enum { DSD_STATE_EXT_MAX = 32 };
 typedef enum dsd_state_ext_id {
     DSD_STATE_EXT_ENGINE_START_MS = 0,
     DSD_STATE_EXT_ENGINE_TRUNK_CC_CANDIDATES = 1,
+    DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE = 2,
+    DSD_STATE_EXT_ENGINE_DECODER_EVENTS = 3,
+    DSD_STATE_EXT_ENGINE_TRUNK_TIMERS = 4,
+    DSD_STATE_EXT_IO_SYMBOL_FILE = 8,
     DSD_STATE_EXT_PROTO_NXDN_TRUNK_DIAG = 24,
+    DSD_STATE_EXT_PROTO_P25_P2_AUDIO_RING = 25,
 } dsd_state_ext_id;
 
 typedef void (*dsd_state_ext_cleanup_fn)(void*);
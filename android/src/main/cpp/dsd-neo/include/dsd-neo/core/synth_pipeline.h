@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Pipelined vocoder synthesis stage.
+ *
+ * Decouples MBE synthesis and digital voice output from the frame decoder
+ * thread. The decoder finishes ECC/decryption and stages the decoded vocoder
+ * parameter bits; once the output path has decided whether the frame is
+ * audible it commits the frame into a bounded queue. A dedicated worker owns
+ * its own per-slot mbelib state, synthesizes, applies gain/HPF and writes the
+ * PCM to the sink, so symbol processing never waits on audio.
+ *
+ * With two lanes each TDMA slot has its own queue and worker, so both slots
+ * of dual-voice DMR / P25 Phase 2 traffic synthesize in parallel. Sink calls
+ * are serialized across lanes, and the decoder binding's writes to the audio
+ * outputs take `dsd_audio_sink_lock` like every inline writer on the decoder
+ * thread, so the two never interleave on a shared sink.
+ *
+ * The pipeline is opt-in (`DSD_NEO_SYNTH_PIPELINE=1`) and only attaches for
+ * 8 kHz short stereo output without WAV capture; all other configurations
+ * keep the inline synthesis path.
+ */
+
+#pragma once
+
+#include <dsd-neo/core/opts_fwd.h>
+#include <dsd-neo/core/state_fwd.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Maximum queue depth accepted by `dsd_synth_pipeline_create`. */
+enum { DSD_SYNTH_PIPELINE_MAX_DEPTH = 64 };
+
+/** @brief Maximum worker lanes (one per TDMA slot). */
+enum { DSD_SYNTH_PIPELINE_MAX_LANES = 2 };
+
+/** @brief Vocoder parameter layout carried by a queued frame. */
+typedef enum dsd_synth_vocoder {
+    DSD_SYNTH_IMBE_4400 = 0, /**< 88 IMBE parameter bits (P25 Phase 1). */
+    DSD_SYNTH_AMBE_2450 = 1, /**< 49 AMBE+2 parameter bits (DMR, P25 Phase 2). */
+} dsd_synth_vocoder;
+
+/** @brief Back-pressure policy applied when the queue is full. */
+typedef enum dsd_synth_policy {
+    DSD_SYNTH_DROP_OLDEST = 0, /**< Evict the oldest queued frame (default, bounds latency). */
+    DSD_SYNTH_DROP_NEWEST = 1, /**< Reject the incoming frame. */
+    DSD_SYNTH_BLOCK = 2,       /**< Wait up to `block_timeout_ms`, then reject the incoming frame. */
+} dsd_synth_policy;
+
+/** @brief One queued vocoder frame (or a per-slot reset marker). */
+typedef struct dsd_synth_frame {
+    uint64_t enqueue_ns; /**< Set by submit; used for latency metrics. */
+    float gain;          /**< 0 = auto gain, <0 = unity, >0 = fixed multiplier. */
+    int slot;            /**< 0 or 1; selects the worker's mbelib state. */
+    int vocoder;         /**< `dsd_synth_vocoder`. */
+    int errs;
+    int errs2;
+    int uvquality;
+    int muted;  /**< Synthesize to keep vocoder continuity, but do not emit. */
+    int hpf;    /**< Apply the digital voice high-pass filter. */
+    int reset;  /**< Reset marker: reinitialize slot state; no audio. */
+    char bits[88];
+} dsd_synth_frame;
+
+/**
+ * @brief PCM sink invoked on a worker thread (never concurrently with itself).
+ *
+ * @param user  Opaque pointer given at create time.
+ * @param slot  Slot the frame belongs to.
+ * @param pcm   160 mono 8 kHz samples.
+ * @param n     Sample count (160).
+ */
+typedef void (*dsd_synth_sink_fn)(void* user, int slot, const short* pcm, size_t n);
+
+typedef struct dsd_synth_pipeline_config {
+    int depth;            /**< Queue capacity in frames per lane (1..DSD_SYNTH_PIPELINE_MAX_DEPTH). */
+    int policy;           /**< `dsd_synth_policy`. */
+    int block_timeout_ms; /**< Upper bound for `DSD_SYNTH_BLOCK` waits. */
+    int lanes;            /**< 2 = one queue/worker per slot; 0 or 1 = a single shared worker. */
+} dsd_synth_pipeline_config;
+
+typedef struct dsd_synth_pipeline_metrics {
+    uint64_t submitted;      /**< Frames accepted by submit (including evicting ones). */
+    uint64_t synthesized;    /**< Frames run through mbelib by the worker. */
+    uint64_t played;         /**< Frames handed to the sink. */
+    uint64_t dropped_oldest; /**< Frames evicted by `DSD_SYNTH_DROP_OLDEST`. */
+    uint64_t dropped_newest; /**< Frames rejected by `DROP_NEWEST` or a timed-out `BLOCK`. */
+    uint64_t producer_waits; /**< Times submit waited for space under `DSD_SYNTH_BLOCK`. */
+    uint64_t latency_last_ns;
+    uint64_t latency_max_ns;
+    uint64_t latency_sum_ns; /**< Sum over `synthesized`; divide for the mean. */
+    int depth;               /**< Frames currently queued (all lanes). */
+    int max_depth;           /**< High-water mark of a single lane's depth. */
+} dsd_synth_pipeline_metrics;
+
+typedef struct dsd_synth_pipeline dsd_synth_pipeline;
+
+/**
+ * @brief Create a pipeline and start its worker thread(s).
+ *
+ * @param cfg  Queue configuration; NULL selects depth 8, drop-oldest, one lane.
+ * @param sink PCM sink called on the worker thread (required).
+ * @param user Opaque pointer passed to `sink`.
+ * @return New pipeline, or NULL on invalid arguments/allocation failure.
+ */
+dsd_synth_pipeline* dsd_synth_pipeline_create(const dsd_synth_pipeline_config* cfg, dsd_synth_sink_fn sink,
+                                              void* user);
+
+/** @brief Stop the workers (draining queued frames) and free the pipeline. NULL-safe. */
+void dsd_synth_pipeline_destroy(dsd_synth_pipeline* p);
+
+/** @brief Number of worker lanes (1 or 2; 0 for NULL). */
+int dsd_synth_pipeline_lanes(const dsd_synth_pipeline* p);
+
+/**
+ * @brief Queue one frame for synthesis. Never blocks unless the policy is `DSD_SYNTH_BLOCK`.
+ *
+ * @return 1 when queued, 0 when dropped by policy, -1 on invalid input.
+ */
+int dsd_synth_pipeline_submit(dsd_synth_pipeline* p, const dsd_synth_frame* frame);
+
+/** @brief Queue a reset marker for one slot (0/1) or both (negative). */
+void dsd_synth_pipeline_reset(dsd_synth_pipeline* p, int slot);
+
+/**
+ * @brief Wait until every queue is empty and every worker is idle.
+ *
+ * @return 0 when idle, -1 on timeout.
+ */
+int dsd_synth_pipeline_wait_idle(dsd_synth_pipeline* p, unsigned int timeout_ms);
+
+/** @brief Snapshot the pipeline counters, summed over lanes. */
+void dsd_synth_pipeline_get_metrics(dsd_synth_pipeline* p, dsd_synth_pipeline_metrics* out);
+
+/*
+ * Decoder integration (binds one pipeline to a `dsd_state` via state_ext).
+ */
+
+/**
+ * @brief Attach a pipeline to `state` when enabled and the output config is supported.
+ *
+ * @return 1 when attached, 0 when disabled/unsupported, -1 on failure.
+ */
+int dsd_synth_pipeline_attach(dsd_opts* opts, dsd_state* state);
+
+/** @brief Drain and detach the pipeline bound to `state` (no-op when none). */
+void dsd_synth_pipeline_detach(dsd_state* state);
+
+/** @brief Pipeline bound to `state`, or NULL when synthesis runs inline. */
+dsd_synth_pipeline* dsd_synth_pipeline_get(dsd_state* state);
+
+/**
+ * @brief Stage decoded vocoder bits for `slot` until the output path commits them.
+ *
+ * A frame still staged on the same slot is submitted muted so the worker's
+ * vocoder state stays continuous.
+ *
+ * @return 1 when staged (caller must skip inline synthesis), 0 when no pipeline is attached.
+ */
+int dsd_synth_pipeline_stage(dsd_opts* opts, dsd_state* state, int slot, dsd_synth_vocoder vocoder,
+                             const char* bits, int errs, int errs2);
+
+/**
+ * @brief Submit the frame staged for `slot` with its final mute decision.
+ *
+ * @return 1 when a staged frame was consumed (caller must skip its own output),
+ *         0 when nothing was staged for `slot`.
+ */
+int dsd_synth_pipeline_commit(dsd_state* state, int slot, int muted);
+
+/** @brief Discard staged frames and reset worker vocoder state for `slot` (negative = both). */
+void dsd_synth_pipeline_reset_state(dsd_state* state, int slot);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Hashed RID/TG registry with least-recently-seen ordering.
+ *
+ * Backs the P25 unit affiliation and group affiliation tables. Entries are
+ * stored densely in `[0, count)` so consumers can walk the parallel `rid`,
+ * `tg` and `last_seen` arrays directly; a hash index gives O(1) lookup and a
+ * doubly linked list over the same indices keeps entries ordered by the last
+ * touch, so aging only visits expired entries and eviction at the cap drops
+ * the least recently seen one. Storage grows on demand up to `max_entries`.
+ *
+ * Removal moves the last entry into the freed slot, so indices are not stable
+ * across mutations. A zero-filled registry is valid, empty and unbounded.
+ *
+ * Not thread-safe: growth reallocates every array. The P25 tables are only
+ * touched on the decoder thread (TSBK/MAC handlers and trunk timer jobs);
+ * other threads get a bounded copy via `dsd_unit_registry_copy_recent` taken
+ * on that thread, as the UI snapshot does.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dsd_unit_registry {
+    uint32_t* rid;       /* dense, [0, count) */
+    uint16_t* tg;        /* dense; 0 for RID-only tables */
+    time_t* last_seen;   /* dense */
+    int32_t* lru_prev;   /* towards least recently seen */
+    int32_t* lru_next;   /* towards most recently seen */
+    int32_t* hash_next;  /* bucket chain */
+    int32_t* buckets;    /* bucket heads, -1 = empty */
+    uint32_t bucket_mask;
+    int32_t lru_oldest;  /* valid while count > 0 */
+    int32_t lru_newest;  /* valid while count > 0 */
+    int count;
+    int capacity;
+    int max_entries;
+} dsd_unit_registry;
+
+/** @brief Initialize an empty registry holding at most `max_entries` (<= 0: unbounded); no allocation. */
+void dsd_unit_registry_init(dsd_unit_registry* reg, int max_entries);
+
+/** @brief Release storage; the registry is left empty and can be reused. */
+void dsd_unit_registry_free(dsd_unit_registry* reg);
+
+/** @brief Drop all entries but keep the storage. */
+void dsd_unit_registry_clear(dsd_unit_registry* reg);
+
+/** @brief Index of the (rid, tg) entry, or -1 when absent. */
+int dsd_unit_registry_find(const dsd_unit_registry* reg, uint32_t rid, uint16_t tg);
+
+/**
+ * @brief Insert (rid, tg) or refresh its timestamp, marking it most recently seen.
+ *
+ * When the registry is at `max_entries`, the least recently seen entry is
+ * evicted to make room.
+ *
+ * @return Index of the entry, or -1 on allocation failure.
+ */
+int dsd_unit_registry_touch(dsd_unit_registry* reg, uint32_t rid, uint16_t tg, time_t now);
+
+/** @brief Remove (rid, tg). @return 1 when an entry was removed, 0 otherwise. */
+int dsd_unit_registry_remove(dsd_unit_registry* reg, uint32_t rid, uint16_t tg);
+
+/**
+ * @brief Remove entries last seen more than `ttl` seconds before `now`.
+ *
+ * @return Number of entries removed.
+ */
+int dsd_unit_registry_expire(dsd_unit_registry* reg, time_t now, time_t ttl);
+
+/** @brief Timestamp of the least recently seen entry, or 0 when empty. */
+time_t dsd_unit_registry_oldest_seen(const dsd_unit_registry* reg);
+
+/** @brief Timestamp of the most recently seen entry, or 0 when empty. */
+time_t dsd_unit_registry_newest_seen(const dsd_unit_registry* reg);
+
+/**
+ * @brief Copy up to `max` entry indices into `out`, most recently seen first.
+ *
+ * @return Number of indices written.
+ */
+int dsd_unit_registry_recent(const dsd_unit_registry* reg, int* out, int max);
+
+/**
+ * @brief Replace `dst` with the `max` most recently seen entries of `src`.
+ *
+ * Used to hand a bounded, independently owned copy to another thread.
+ *
+ * @return Number of entries copied, or -1 on allocation failure.
+ */
+int dsd_unit_registry_copy_recent(dsd_unit_registry* dst, const dsd_unit_registry* src, int max);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Block 8 kHz to 48 kHz polyphase upsampler for decoded voice.
+ *
+ * Each output channel (slot) owns a `dsd_upsampler` holding the filter
+ * history, so frames can be fed in any block size without clicks at the
+ * boundaries and without touching shared `dsd_state` buffer pointers.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Interpolation factor (8 kHz to 48 kHz). */
+#define DSD_UPSAMPLE_FACTOR 6
+/** @brief Filter taps per polyphase branch (96-tap prototype lowpass). */
+#define DSD_UPSAMPLE_TAPS   16
+
+/** @brief Per-channel upsampler state: the last `DSD_UPSAMPLE_TAPS - 1` input samples, oldest first. */
+typedef struct dsd_upsampler {
+    float hist[DSD_UPSAMPLE_TAPS - 1];
+} dsd_upsampler;
+
+/** @brief Clear the filter history (silence). */
+void dsd_upsampler_reset(dsd_upsampler* us);
+
+/**
+ * @brief Upsample `n` samples at 8 kHz to `n * DSD_UPSAMPLE_FACTOR` samples at 48 kHz.
+ *
+ * Any block length works (a 160-sample vocoder frame, a 20/60 ms multi-frame);
+ * consecutive calls on the same state are seamless. `in` and `out` must not overlap.
+ *
+ * @param us  Per-channel filter state.
+ * @param in  Input samples at 8 kHz.
+ * @param n   Number of input samples.
+ * @param out Output buffer, `n * DSD_UPSAMPLE_FACTOR` samples at 48 kHz.
+ */
+void dsd_upsample_8k_48k(dsd_upsampler* us, const float* in, size_t n, float* out);
+
+#ifdef __cplusplus
+}
+#endif
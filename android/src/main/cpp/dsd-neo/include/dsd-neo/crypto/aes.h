@@ -8,6 +8,8 @@
  * @brief AES helper entrypoints.
  *
  * Declares the AES wrapper helpers implemented in `src/crypto/crypt-aes.c`.
+ * Expanded key schedules are cached per thread by key material, and block
+ * rounds run on AES-NI or ARMv8 Crypto Extensions when the CPU has them.
  */
 
 #pragma once
@@ -32,6 +34,13 @@ void aes_cfb_bytewise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* in, uint
 void aes_ctr_bytewise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* payload, int type);
 /** @brief Encrypt/decrypt payload in AES-CTR mode (bit-wise counter). */
 void aes_ctr_bitwise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* payload, int type);
+/** @brief AES CBC-MAC over `nblocks` blocks; writes the final 16-byte block to `out`. */
+void aes_cbc_mac_generator(uint8_t* key, uint8_t* in, uint8_t* out, int type, int nblocks);
+
+/** @brief Active block implementation: "aesni", "armv8", or "portable". */
+const char* aes_get_impl_name(void);
+/** @brief Force the portable T-table rounds (tests/benchmarks); 0 restores runtime dispatch. */
+void aes_set_portable_only(int enable);
 
 #ifdef __cplusplus
 }
@@ -8,7 +8,10 @@
  * @brief DES/3DES keystream helpers.
  *
  * Declares the DES and Triple-DES keystream generators implemented in
- * `src/crypto/crypt-des.c`.
+ * `src/crypto/crypt-des.c`. Keys are expanded once into a `des_key_schedule`
+ * and each block then runs through combined S/P lookup tables, so the mode
+ * wrappers (OFB, CA, TOFB, ...) pay for the key schedule once per call rather
+ * than once per block.
  */
 
 #pragma once
@@ -19,6 +22,38 @@
 extern "C" {
 #endif
 
+/** @brief Expanded DES key: 16 round subkeys, each split into even/odd 6-bit groups. */
+typedef struct des_key_schedule {
+    uint32_t k[16][2];
+} des_key_schedule;
+
+/** @brief Expand an 8-byte DES key (parity bits ignored). */
+void des_key_setup(des_key_schedule* ks, const uint8_t* main_key);
+/** @brief Encrypt (`de` = 1) or decrypt (`de` = 0) one 8-byte block; `in` and `out` may alias. */
+void des_crypt_block(const des_key_schedule* ks, const uint8_t* in, uint8_t* out, uint8_t de);
+
+/** @brief Generate DES56 OFB keystream blocks for the given IV/key. */
+void des56_ofb_keystream_output(uint8_t* main_key, uint8_t* iv, uint8_t* ks_bytes, uint8_t de, int16_t nblocks);
+/** @brief DES56 CA (DES-XL) keystream: `nbits` single-bit outputs after fast-forwarding the LFSR `ff` steps. */
+void des56_ca_keystream_output(uint8_t* main_key, uint8_t* iv, uint8_t* ks_bytes, uint8_t de, int16_t ff,
+                               int16_t nbits);
+/** @brief Encrypt/decrypt one block in TDEA-ECB mode (pass K3, K2, K1 to decrypt). */
+void tdea_ecb_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* input, uint8_t* output, uint8_t de);
+/** @brief Encrypt/decrypt payload in TDEA-CBC mode; `in` and `out` may alias. */
+void tdea_cbc_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* in, uint8_t* out,
+                            int16_t nblocks, uint8_t de);
+/** @brief TDEA CBC-MAC over `nblocks` blocks; writes the final 8-byte block to `out`. */
+void tdea_cbc_mac_generator(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* in, uint8_t* out, int16_t nblocks);
+/** @brief Encrypt/decrypt payload in TDEA-CFB mode (64-bit feedback). */
+void tdea_cfb_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* in, uint8_t* out,
+                            int16_t nblocks, uint8_t de);
+/** @brief Encrypt/decrypt payload in TDEA-CTR mode; advances the caller's `iv` by `nblocks`. */
+void tdea_ctr_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* input, uint8_t* output,
+                            int16_t nblocks);
+/** @brief Generate TDEA OFB keystream blocks for the given IV/keys. */
+void tdea_tofb_keystream_output(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* ks_bytes, uint8_t de,
+                                int16_t nblocks);
+
 void des_multi_keystream_output(unsigned long long int mi, unsigned long long int key_ulli, uint8_t* output, int type,
                                 int len);
 void tdea_multi_keystream_output(unsigned long long int mi, uint8_t* key, uint8_t* output, int type, int len);
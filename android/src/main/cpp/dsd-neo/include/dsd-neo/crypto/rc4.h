@@ -21,6 +21,30 @@
 extern "C" {
 #endif
 
+/**
+ * @brief RC4 keystream kept alive across the voice frames of one superframe.
+ *
+ * Voice frames ask for consecutive keystream windows (`drop` grows by the
+ * frame length each time) under the same key||MI, so the generator state is
+ * kept and only the bytes between the last window and the next are run.
+ * A new key, a new MI or a window behind the current position re-keys.
+ */
+typedef struct rc4_stream {
+    uint8_t S[256];
+    uint8_t i, j;
+    uint8_t key[16];
+    uint8_t keylen; /* 0 = not keyed */
+    int pos;        /* keystream bytes generated so far */
+} rc4_stream;
+
+void rc4_stream_reset(rc4_stream* rc);
+/**
+ * @brief Same output as rc4_voice_decrypt(), reusing the key schedule when possible.
+ *
+ * Keys longer than 16 bytes are not cached and fall back to rc4_voice_decrypt().
+ */
+void rc4_stream_decrypt(rc4_stream* rc, int drop, uint8_t keylength, uint8_t messagelength, const uint8_t key[],
+                        const uint8_t cipher[], uint8_t plain[]);
 void rc4_block_output(int drop, int keylen, int meslen, uint8_t* key, uint8_t* output_blocks);
 void rc4_voice_decrypt(int drop, uint8_t keylength, uint8_t messagelength, uint8_t key[], uint8_t cipher[],
                        uint8_t plain[]);
@@ -205,14 +205,11 @@ struct demod_state {
     fll_state_t fll_state;
     ted_state_t ted_state;
 
-    /* Minimal 2-thread worker pool bookkeeping */
-    int mt_enabled;
-    int mt_ready;
-    int mt_should_exit;
-    int mt_epoch;
-    int mt_completed_in_epoch;
-    int mt_posted_count;
-    int mt_worker_id[2];
+    /* Intra-block worker pool (runtime/worker_pool.h); NULL when DSD_NEO_MT is off */
+    struct dsd_worker_pool* mt_pool;
+
+    /* Runtime config snapshot (runtime/config.h); refreshed at the top of each full_demod block */
+    const struct dsdneoRuntimeConfig* rt_cfg;
 
     /* CQPSK (H-DQPSK) path enable for P25 LSM/TDMA */
     int cqpsk_enable;
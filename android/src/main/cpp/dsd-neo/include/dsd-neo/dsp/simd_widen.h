@@ -76,6 +76,27 @@ void widen_rotate90_u8_to_f32_bias127(const unsigned char* src, float* dst, uint
  */
 void widen_u8_to_f32_bias128_scalar(const unsigned char* src, float* dst, uint32_t len);
 
+/**
+ * @brief Widen signed 8-bit I/Q (HackRF-style cs8) to normalized float.
+ *
+ * Scales so that the result equals `widen_u8_to_f32_bias127` applied to the
+ * offset-binary value `s + 128`, keeping cs8 and cu8 sources level-matched.
+ *
+ * @param src Source buffer of signed bytes (I/Q interleaved).
+ * @param dst Destination float buffer.
+ * @param len Number of bytes to process.
+ */
+void widen_s8_to_f32(const int8_t* src, float* dst, uint32_t len);
+
+/**
+ * @brief Widen signed 16-bit I/Q (cs16) to normalized float in [-1.0, 1.0).
+ *
+ * @param src Source buffer of native-endian int16 components (I/Q interleaved).
+ * @param dst Destination float buffer.
+ * @param len Number of int16 components to process.
+ */
+void widen_s16_to_f32(const int16_t* src, float* dst, uint32_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Table-driven CRC engine shared by the protocol checksums.
+ *
+ * One parameterized implementation for MSB-first (non-reflected) CRCs of
+ * width 1..32. The register is kept left-aligned in 32 bits so every width
+ * uses the same slice-by-8 tables; input can be packed bytes, an MSB-first
+ * packed bit string of any length, or the decoders' one-bit-per-byte arrays,
+ * which are packed eight at a time before hitting the tables.
+ *
+ * The catalog models (`dsd_crc_get`) build their tables lazily on first use
+ * and are safe to share between threads.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief CRC parameters (Rocksoft model, refin = refout = false). */
+typedef struct dsd_crc_model {
+    uint8_t width;   /**< 1..32 bits. */
+    uint32_t poly;   /**< Generator without the x^width term, MSB-first. */
+    uint32_t init;   /**< Register preset. */
+    uint32_t xorout; /**< Final XOR. */
+} dsd_crc_model;
+
+/** @brief Model plus its slice-by-8 tables (8 KiB). */
+typedef struct dsd_crc {
+    dsd_crc_model model;
+    uint32_t table[8][256]; /**< Left-aligned: `table[k][b]` is byte `b` followed by `k` zero bytes. */
+} dsd_crc;
+
+/** @brief Named models used across the decoders. */
+typedef enum dsd_crc_id {
+    DSD_CRC3_DMR = 0,   /**< x^3+x^2+1 (DMR RC/LE). */
+    DSD_CRC4_DMR,       /**< x^4+x+1, inverted (DMR LE). */
+    DSD_CRC6_NXDN,      /**< 0x27, preset all ones (NXDN SACCH). */
+    DSD_CRC7_DMR,       /**< x^7+x^5+x^2+x+1 (DMR reverse channel). */
+    DSD_CRC7_NXDN_SCCH, /**< 0x09, preset all ones (NXDN SCCH). */
+    DSD_CRC8_DMR,       /**< x^8+x^2+x+1 (DMR short LC). */
+    DSD_CRC9_DMR,       /**< x^9+x^6+x^4+x^3+1, inverted (DMR confirmed data blocks). */
+    DSD_CRC12_P25,      /**< x^12+x^11+x^7+x^4+x^2+x+1, inverted (P25 Phase 2 xCCH). */
+    DSD_CRC12_NXDN,     /**< 0x80F, preset all ones (NXDN FACCH1/UDCH). */
+    DSD_CRC15_NXDN,     /**< 0x4CC5, preset all ones (NXDN FACCH2). */
+    DSD_CRC16_CCITT,    /**< 0x1021, inverted (P25 TSBK/PDU header, DMR CSBK/data header). */
+    DSD_CRC16_M17,      /**< 0x5935, preset 0xFFFF (M17). */
+    DSD_CRC32_CKSUM,    /**< 0x04C11DB7, inverted (P25 PDU packet CRC). */
+    DSD_CRC32_DMR,      /**< 0x04C11DB7, no inversion (DMR data packet CRC). */
+    DSD_CRC_ID_COUNT
+} dsd_crc_id;
+
+/** @brief Build tables for `model`. Returns 0, or -1 when the width is out of range. */
+int dsd_crc_init(dsd_crc* crc, const dsd_crc_model* model);
+
+/** @brief Shared catalog model with tables built on first use; NULL for an unknown id. */
+const dsd_crc* dsd_crc_get(dsd_crc_id id);
+
+/** @brief CRC over `len` packed bytes. */
+uint32_t dsd_crc_bytes(const dsd_crc* crc, const uint8_t* data, size_t len);
+
+/** @brief CRC over the first `nbits` bits of an MSB-first packed buffer. */
+uint32_t dsd_crc_packed_bits(const dsd_crc* crc, const uint8_t* data, size_t nbits);
+
+/** @brief CRC over `nbits` one-bit-per-byte elements (bit 0 of each byte), first element first. */
+uint32_t dsd_crc_bits(const dsd_crc* crc, const uint8_t* bits, size_t nbits);
+
+/**
+ * @brief Raw register update for one-bit-per-byte input.
+ *
+ * `reg` is the register value (right-aligned, no final XOR applied). Useful
+ * for nonstandard presets and for building a CRC incrementally.
+ */
+uint32_t dsd_crc_bits_update(const dsd_crc* crc, uint32_t reg, const uint8_t* bits, size_t nbits);
+
+/** @brief Read `width` one-bit-per-byte elements MSB-first (a transmitted CRC field). */
+uint32_t dsd_crc_load_bits(const uint8_t* bits, unsigned int width);
+
+/** @brief 1 when the `width`-bit CRC field following `nbits` data bits matches, else 0. */
+int dsd_crc_bits_check(const dsd_crc* crc, const uint8_t* bits, size_t nbits);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,16 @@
  *
  * Declares the RS(63,35) and ISCH lookup helpers implemented in `src/fec/ez.cpp`
  * so callers can use them directly.
+ *
+ * All decoders are reentrant and allocation-free: scratch lives on the
+ * caller's stack and the shared code tables are read-only. Three entry
+ * styles are offered per channel:
+ *  - `_hb`: caller-owned hexbit buffers (6 bits per byte), corrected in place.
+ *  - `_packed`: MSB-first packed bits; the payload is corrected in place.
+ *  - plain/`_soft`: one bit per `int`, kept for existing callers.
+ *
+ * Return values follow ezpwd: number of corrected symbols, or -1 when the
+ * block is uncorrectable.
  */
 
 #pragma once
@@ -27,6 +37,35 @@ int ez_rs28_facch_soft(int payload[156], int parity[114], const int* erasures, i
 int ez_rs28_sacch_soft(int payload[180], int parity[132], const int* erasures, int n_erasures);
 int ez_rs28_ess_soft(int payload[96], int parity[168], const int* erasures, int n_erasures);
 
+/**
+ * @brief Decode ESS on hexbits: 16 payload (ESS_B) + 28 parity (ESS_A) hexbits, RS positions 0-43.
+ * @param erasures RS symbol positions to erase, or NULL for none; at most 28 are used.
+ */
+int ez_rs28_ess_hb(uint8_t payload[16], uint8_t parity[28], const int* erasures, int n_erasures);
+/**
+ * @brief Decode FACCH on hexbits: 26 payload + 19 parity hexbits, RS positions 9-53.
+ * @param erasures RS symbol positions (0-62) to erase, or NULL for the fixed shortening
+ *                 positions {0-8, 54-62}. A caller list replaces the fixed one.
+ */
+int ez_rs28_facch_hb(uint8_t payload[26], uint8_t parity[19], const int* erasures, int n_erasures);
+/**
+ * @brief Decode SACCH on hexbits: 30 payload + 22 parity hexbits, RS positions 5-56.
+ * @param erasures As for ez_rs28_facch_hb(); NULL selects {0-4, 57-62}.
+ */
+int ez_rs28_sacch_hb(uint8_t payload[30], uint8_t parity[22], const int* erasures, int n_erasures);
+
+/** @brief ESS on packed bits: 96-bit payload (12 bytes), 168-bit parity (21 bytes). */
+int ez_rs28_ess_packed(uint8_t payload[12], const uint8_t parity[21], const int* erasures, int n_erasures);
+/** @brief FACCH on packed bits: 156-bit payload (20 bytes), 114-bit parity (15 bytes). */
+int ez_rs28_facch_packed(uint8_t payload[20], const uint8_t parity[15], const int* erasures, int n_erasures);
+/** @brief SACCH on packed bits: 180-bit payload (23 bytes), 132-bit parity (17 bytes). */
+int ez_rs28_sacch_packed(uint8_t payload[23], const uint8_t parity[17], const int* erasures, int n_erasures);
+
+/** @brief Pack `n_hexbits * 6` one-bit-per-int values (MSB first) into hexbits. */
+void ez_bits_to_hexbits(const int* bits, uint8_t* hexbits, int n_hexbits);
+/** @brief Expand hexbits into one bit per int (MSB first). */
+void ez_hexbits_to_bits(const uint8_t* hexbits, int* bits, int n_hexbits);
+
 int isch_lookup(uint64_t isch);
 
 #ifdef __cplusplus
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Shared Viterbi engine for the P25/DMR 1/2- and 3/4-rate trellis codes.
+ *
+ * Both codes carry 48 data symbols plus a flush symbol as 49 dibit pairs
+ * (nibbles) spread over 98 interleaved dibits. The engine owns the common
+ * interleave schedule and constellation tables, precomputes branch metrics
+ * for every (observed nibble, transition) pair once, and runs a fixed-width
+ * add-compare-select across all states per symbol so the inner loop
+ * vectorizes.
+ *
+ * Branch metrics:
+ *  - 1/2 rate (4 states): hard metric is the nibble Hamming distance to the
+ *    expected dibit pair.
+ *  - 3/4 rate (8 states): hard metric is the Hamming distance between the
+ *    expected and observed constellation point codes.
+ *  - Soft (either rate): each mismatching bit in the expected nibble costs the
+ *    reliability of the dibit it belongs to.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DSD_TRELLIS_DIBITS      98
+#define DSD_TRELLIS_SYMS        49
+#define DSD_TRELLIS_UNREACHABLE 0x3FFFFFFFu /**< Start metric for states a path may not begin in. */
+
+/** @brief Dibit deinterleave schedule: `deinterleaved[dsd_trellis_interleave[i]] = input[i]`. */
+extern const uint8_t dsd_trellis_interleave[DSD_TRELLIS_DIBITS];
+/** @brief Dibit-pair nibble to constellation point code. */
+extern const uint8_t dsd_trellis_constellation[16];
+/** @brief 3/4-rate FSM: constellation point for `(state * 8) + tribit`. */
+extern const uint8_t dsd_trellis_fsm34[64];
+
+/** @brief Trellis codes known to the engine. */
+typedef enum dsd_trellis_id {
+    DSD_TRELLIS_12 = 0, /**< 1/2 rate, dibit input, 4 states (P25 TSBK/PDU header). */
+    DSD_TRELLIS_34,     /**< 3/4 rate, tribit input, 8 states (DMR/P25 confirmed data). */
+    DSD_TRELLIS_ID_COUNT
+} dsd_trellis_id;
+
+/**
+ * @brief Code description plus precomputed branch metrics.
+ *
+ * Transitions are indexed `prev * 8 + next` for both codes so the ACS always
+ * works on 8 lanes; the 4-state code leaves the upper entries zero.
+ */
+typedef struct dsd_trellis {
+    uint8_t states;          /**< 4 or 8; the next state equals the input symbol. */
+    uint8_t bits;            /**< Input bits per symbol (2 or 3). */
+    uint8_t expect[64];      /**< Transmitted nibble for each transition. */
+    uint32_t hard[16][64];   /**< Hard-decision branch metric per observed nibble. */
+    uint8_t miss_hi[16][64]; /**< Mismatching bits in the high dibit of the nibble. */
+    uint8_t miss_lo[16][64]; /**< Mismatching bits in the low dibit of the nibble. */
+} dsd_trellis;
+
+/** @brief Shared code tables, built on first use; NULL for an unknown id. Thread-safe. */
+const dsd_trellis* dsd_trellis_get(dsd_trellis_id id);
+
+/**
+ * @brief Deinterleave 98 dibits into 49 observed nibbles.
+ *
+ * When `reliab98` is non-NULL the per-dibit reliabilities are deinterleaved
+ * alongside into `rhi` (high dibit) and `rlo` (low dibit).
+ */
+void dsd_trellis_deinterleave(const uint8_t dibits98[DSD_TRELLIS_DIBITS], const uint8_t* reliab98,
+                              uint8_t nibs[DSD_TRELLIS_SYMS], uint8_t* rhi, uint8_t* rlo);
+
+/**
+ * @brief Viterbi decode 49 observed nibbles.
+ *
+ * State 0 starts at metric 0 and every other state at `start_bias`
+ * (`DSD_TRELLIS_UNREACHABLE` forces the path to start in state 0). Hard
+ * metrics are used when `rhi`/`rlo` are NULL. Ties resolve to the lowest
+ * predecessor and the lowest end state.
+ *
+ * @param end_state Forced end state, or -1 for the best one.
+ * @param path [out] Decoded symbol (state after each step) for all 49 steps.
+ * @return Path metric of the chosen end state; `>= DSD_TRELLIS_UNREACHABLE` if it cannot be reached.
+ */
+uint32_t dsd_trellis_viterbi(const dsd_trellis* code, const uint8_t nibs[DSD_TRELLIS_SYMS], const uint8_t* rhi,
+                             const uint8_t* rlo, uint32_t start_bias, int end_state, uint8_t path[DSD_TRELLIS_SYMS]);
+
+/** @brief Pack the first 48 path symbols MSB-first (12 bytes at 1/2 rate, 18 bytes at 3/4 rate). */
+void dsd_trellis_pack(const dsd_trellis* code, const uint8_t path[DSD_TRELLIS_SYMS], uint8_t* out);
+
+/** @brief Encode 12/18 payload bytes plus a zero flush symbol into 98 interleaved dibits. */
+void dsd_trellis_encode(const dsd_trellis* code, const uint8_t* in, uint8_t dibits98[DSD_TRELLIS_DIBITS]);
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <dsd-neo/platform/threading.h>
@@ -70,6 +71,51 @@ struct rtl_device* rtl_device_create_usb_fd(int fd, const char* device_path,
 struct rtl_device* rtl_device_create_tcp(const char* host, int port, struct input_ring_state* input_ring,
                                          int combine_rotate_enabled, int autotune_enabled);
 
+/** @brief Sample formats accepted by `rtl_device_push_iq`. */
+typedef enum rtl_iq_format {
+    RTL_IQ_CS8 = 0,  /**< Signed 8-bit I/Q (HackRF native). */
+    RTL_IQ_CU8 = 1,  /**< Unsigned 8-bit I/Q, offset binary (RTL-SDR native). */
+    RTL_IQ_CS16 = 2, /**< Native-endian signed 16-bit I/Q. */
+    RTL_IQ_CF32 = 3, /**< Native-endian float I/Q, already normalized to [-1, 1]. */
+} rtl_iq_format;
+
+/**
+ * @brief Create a device fed in-process by an external IQ producer.
+ *
+ * There is no driver or socket behind this backend: the host application
+ * (e.g. a HackRF owned by the Android/Java side) pushes samples with
+ * `rtl_device_push_iq`, which converts them straight into `input_ring`.
+ * Tuning, gain and driver options are recorded but not acted on; the producer
+ * owns the hardware. Offset tuning is always reported as enabled so the
+ * demodulator treats the stream as already centered (no fs/4 shift or
+ * 90-degree rotation).
+ *
+ * The device accepts pushes between `rtl_device_start_async` and
+ * `rtl_device_stop_async`/`rtl_device_destroy`; only one external device can be
+ * active at a time.
+ *
+ * @param input_ring Pointer to input ring for incoming I/Q data.
+ * @param combine_rotate_enabled Kept for signature parity with the other backends.
+ * @return Pointer to rtl_device handle, or NULL on failure.
+ */
+struct rtl_device* rtl_device_create_external(struct input_ring_state* input_ring, int combine_rotate_enabled);
+
+/**
+ * @brief Push interleaved I/Q samples into the active external device.
+ *
+ * Converts to normalized float and writes directly into the input ring (no
+ * intermediate copy). Samples that do not fit are counted in
+ * `input_ring->producer_drops` and discarded. A trailing partial I/Q pair is
+ * ignored. Must be called from a single producer thread.
+ *
+ * @param fmt Sample format of `data`.
+ * @param data Sample buffer.
+ * @param len Buffer length in bytes.
+ * @return Bytes consumed (including muted or dropped samples), or -1 when no
+ *         external device is running or the arguments are invalid.
+ */
+int rtl_device_push_iq(rtl_iq_format fmt, const void* data, size_t len);
+
 /**
  * @brief Destroy an RTL-SDR device and free resources.
  *
@@ -209,6 +255,8 @@ int rtl_device_stop_async(struct rtl_device* dev);
  * Note: The argument is in raw input BYTES (u8 I/Q interleaved), not int16
  * samples. This matches how the underlying callback consumes the value
  * (clamping and subtracting from the remaining byte count per callback).
+ * For the external backend the count is in I/Q components regardless of the
+ * pushed sample format.
  *
  * @param dev RTL-SDR device handle.
  * @param bytes Number of input bytes to overwrite with 0x7F (mute).
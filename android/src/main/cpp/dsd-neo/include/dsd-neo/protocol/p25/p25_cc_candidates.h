@@ -66,7 +66,9 @@ void p25_cc_persist_cache(dsd_opts* opts, dsd_state* state);
  */
 void p25_nb_add(dsd_state* state, long freq_hz);
 /**
- * @brief Age/expire neighbor control channel candidates (call periodically).
+ * @brief Age/expire neighbor control channel candidates.
+ *
+ * Scheduled via the trunk timers for when the oldest entry expires.
  *
  * @param state Decoder state containing neighbor list.
  */
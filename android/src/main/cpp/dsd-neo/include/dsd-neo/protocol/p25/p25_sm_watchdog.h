@@ -13,9 +13,11 @@
 #include <dsd-neo/core/state_fwd.h>
 
 /*
- * Background watchdog for the P25 trunking state machine tick.
- * Ensures hangtime/CC-return logic continues even if the main
- * DSP loop is temporarily stalled by upstream I/O.
+ * Stall fallback for the P25 trunking state machine. The SM is driven by its
+ * trunk timer job on the decoder loop; the watchdog thread only notices when
+ * that job's deadline is overdue because the loop is blocked on upstream I/O
+ * and posts a timer run, which the decoder thread executes from its input
+ * wait loop. The watchdog never calls into the SM itself.
  */
 
 #ifdef __cplusplus
@@ -23,9 +25,9 @@ extern "C" {
 #endif
 
 /**
- * @brief Attempt to run one P25 state-machine tick when idle.
+ * @brief Run one P25 state-machine tick unless one is already in progress.
  *
- * Safe to call frequently; a tick is skipped when one is already in progress.
+ * Called by the SM's trunk timer job on the decoder thread.
  *
  * @param opts Decoder options.
  * @param state Decoder state.
@@ -33,8 +35,9 @@ extern "C" {
 void p25_sm_try_tick(dsd_opts* opts, dsd_state* state);
 
 /**
- * @brief Start the background 1 Hz watchdog thread.
+ * @brief Start the stall watchdog thread and register its input wait pump.
  *
+ * Checks every 400 ms (200 ms under ncurses, `DSD_NEO_P25_WD_MS` overrides).
  * No-op if already started.
  *
  * @param opts Decoder options.
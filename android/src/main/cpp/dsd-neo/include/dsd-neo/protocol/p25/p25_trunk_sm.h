@@ -496,6 +496,8 @@ void p25_patch_update(dsd_state* state, int sgid, int is_patch, int active);
  * @brief Compose a compact summary string for active patch SGIDs.
  *
  * Example output: "P: 069,142".
+ * Entries past their TTL are skipped, not removed, so this is safe on a UI
+ * snapshot.
  *
  * @param state Decoder state (read-only).
  * @param out Destination buffer for summary string.
@@ -526,6 +528,8 @@ void p25_patch_add_wuid(dsd_state* state, int sgid, uint32_t wuid);
  * @brief Compose a detailed status string including WGID/WUID context.
  *
  * Example: "SG069[P] WG:2(0345,0789); SG142[S] U:3".
+ * Entries past their TTL are skipped, not removed, so this is safe on a UI
+ * snapshot.
  *
  * @param state Decoder state (read-only).
  * @param out Destination buffer.
@@ -612,7 +616,11 @@ void p25_aff_register(dsd_state* state, uint32_t rid);
 void p25_aff_deregister(dsd_state* state, uint32_t rid);
 
 /**
- * @brief Periodic aging/cleanup of the affiliation table (call at ~1 Hz).
+ * @brief Drop affiliation entries past their TTL.
+ *
+ * Scheduled via the trunk timers for when the oldest entry expires, so
+ * callers need not poll it. Like the other affiliation helpers, decoder
+ * thread only.
  *
  * @param state Decoder state holding affiliation table.
  */
@@ -639,7 +647,9 @@ void p25_ga_add(dsd_state* state, uint32_t rid, uint16_t tg);
  */
 void p25_ga_remove(dsd_state* state, uint32_t rid, uint16_t tg);
 /**
- * @brief Age/cleanup group affiliation entries (call at ~1 Hz).
+ * @brief Drop group affiliation entries past their TTL.
+ *
+ * Scheduled via the trunk timers like `p25_aff_tick`.
  *
  * @param state Decoder state holding group affiliation table.
  */
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Process-wide lock for writes to the decoded audio sinks.
+ *
+ * The digital voice output (`opts->audio_out_stream`, `opts->audio_out_fd`
+ * and the UDP blaster) can be written from the decoder thread and from the
+ * synth pipeline workers at the same time. Every write to those sinks is
+ * bracketed by this lock, so frames from different threads never interleave
+ * inside a backend that is not thread-safe.
+ *
+ * The lock is not recursive: hold it around a single sink write only, never
+ * across calls that may write again (the UDP hook wrappers take it
+ * themselves).
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void dsd_audio_sink_lock(void);
+void dsd_audio_sink_unlock(void);
+
+#ifdef __cplusplus
+}
+#endif
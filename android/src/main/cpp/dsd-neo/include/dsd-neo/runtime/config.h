@@ -44,6 +44,18 @@ extern "C" {
  * - DSD_NEO_CPU_USB | DSD_NEO_CPU_DONGLE | DSD_NEO_CPU_DEMOD
  *     Optional CPU core pinning for each thread. Integer CPU id (>=0). Example: export DSD_NEO_CPU_DEMOD=2
  *
+ * Large DSP buffer backing (RTL input/output rings)
+ * - DSD_NEO_MEM_HUGEPAGES
+ *     Try explicit hugepages (MAP_HUGETLB, needs a reserved pool) before normal pages with a
+ *     transparent-hugepage hint. Values: 1 enable, 0 disable. Default: 0.
+ * - DSD_NEO_MEM_PREFAULT
+ *     Touch every page at allocation, from the allocating thread, so the first call after a
+ *     start or retune does not take page faults and pages land on that thread's NUMA node.
+ *     Values: 1 enable, 0 disable. Default: 1.
+ * - DSD_NEO_MEM_LOCK
+ *     mlock the buffers so they are never paged out (best effort; needs RLIMIT_MEMLOCK or
+ *     CAP_IPC_LOCK). Values: 1 enable, 0 disable. Default: 0.
+ *
  * Frontend/decimation/upsampling
  * - DSD_NEO_COMBINE_ROT
  *     Combine 90° IQ rotation with USB byte→float widening in one pass when offset tuning is off.
@@ -127,6 +139,9 @@ extern "C" {
  *     Values: 1 enable, 0 disable. Default: off.
  * - DSD_NEO_IQ_DC_SHIFT
  *     k in the above relation (10..14 typical, larger=k -> slower). Default: 11.
+ * - DSD_NEO_IQ_BALANCE
+ *     Enable the I/Q amplitude/phase imbalance corrector. Values: 1 enable, 0 disable.
+ *     Default: demodulator setting.
  *
  * Channel complex low-pass (RTL baseband)
  * - DSD_NEO_CHANNEL_LPF
@@ -158,8 +173,49 @@ extern "C" {
  *
  * Intra-block multithreading
  * - DSD_NEO_MT
- *     Enable a minimal 2-thread worker pool for certain CPU-heavy inner loops.
+ *     Enable the intra-block worker pool for CPU-heavy inner loops.
+ *     Values: 1 enable, else disabled. Default: 0 (disabled).
+ * - DSD_NEO_MT_WORKERS
+ *     Worker threads in the pool (the submitting thread also runs tasks).
+ *     Values: 1..16. Default: 2.
+ * - DSD_NEO_MT_CPU
+ *     Pin worker i to CPU (base + i). Values: CPU index >= 0. Default: unpinned.
+ *
+ * Pipelined vocoder synthesis
+ * - DSD_NEO_SYNTH_PIPELINE
+ *     Run MBE synthesis and digital voice output on a dedicated worker fed by a bounded
+ *     frame queue (8 kHz short stereo output without WAV capture only).
+ *     Values: 1 enable, else disabled. Default: 0 (disabled).
+ * - DSD_NEO_SYNTH_QUEUE
+ *     Queue depth in 20 ms vocoder frames. Values: 1..64. Default: 8.
+ * - DSD_NEO_SYNTH_POLICY
+ *     Back-pressure when the queue is full: "oldest" (evict oldest), "newest" (drop incoming),
+ *     "block" (wait up to DSD_NEO_SYNTH_BLOCK_MS, then drop incoming). Default: oldest.
+ * - DSD_NEO_SYNTH_BLOCK_MS
+ *     Producer wait bound for the "block" policy. Values: 0..100. Default: 5.
+ * - DSD_NEO_SYNTH_WORKERS
+ *     1 = one worker for both TDMA slots; 2 = one queue and worker per slot so dual-voice
+ *     slots synthesize in parallel. Values: 1..2. Default: 2.
+ * - DSD_NEO_P25P2_JITTER_DEPTH
+ *     Per-slot P25 Phase 2 audio jitter buffer depth in 20 ms frames; the oldest frame is
+ *     dropped when full. Values: 1..8. Default: 3.
+ *
+ * Symbol capture replay
+ * - DSD_NEO_SYMBOL_FAST
+ *     Replay `.bin` symbol captures as fast as possible: skip the per-symbol
+ *     throttle yield and log x-real-time throughput every minute of signal.
+ *     Live audio output still paces decoding; use `-o null` for full speed.
  *     Values: 1 enable, else disabled. Default: 0 (disabled).
+ * - DSD_NEO_SYMBOL_SEEK
+ *     Start replay of an indexed (v2) `.bin` capture at this time: seconds from the
+ *     capture start, or an absolute unix time when >= 1e9. Default: unset (from start).
+ * - DSD_NEO_SYMBOL_SEEK_SYNC
+ *     Start replay at the first sync event at/after DSD_NEO_SYMBOL_SEEK (or the capture
+ *     start). Values: "any" or a DSD_SYNC_* id. Default: unset.
+ * - DSD_NEO_SYMBOL_LEGACY
+ *     Write `.bin` captures as headerless raw dibits (no header or index records) for
+ *     older dsd-neo builds and other tools; such captures cannot be seeked.
+ *     Values: 1 enable, else disabled. Default: 0 (indexed v2 captures).
  *
  * Debug/advanced knobs (centralized for maintainability)
  * - DSD_NEO_DEBUG_SYNC, DSD_NEO_DEBUG_CQPSK
@@ -258,6 +314,14 @@ typedef struct dsdneoRuntimeConfig {
     int cpu_demod_is_set;
     int cpu_demod;
 
+    /* Large DSP buffer backing */
+    int mem_hugepages_is_set;
+    int mem_hugepages_enable;
+    int mem_prefault_is_set;
+    int mem_prefault_enable;
+    int mem_lock_is_set;
+    int mem_lock_enable;
+
     /* Bootstrap/system toggles */
     int ftz_daz_is_set;
     int ftz_daz_enable;
@@ -451,6 +515,34 @@ typedef struct dsdneoRuntimeConfig {
     /* Intra-block multithreading */
     int mt_is_set;
     int mt_enable;
+    int mt_workers_is_set;
+    int mt_workers;
+    int mt_cpu_is_set;
+    int mt_cpu; /* first worker CPU, -1 = unpinned */
+
+    /* Pipelined vocoder synthesis */
+    int synth_pipeline_is_set;
+    int synth_pipeline_enable;
+    int synth_queue_is_set;
+    int synth_queue_depth;
+    int synth_policy_is_set;
+    int synth_policy; /* 0=drop oldest, 1=drop newest, 2=block */
+    int synth_block_ms_is_set;
+    int synth_block_ms;
+    int synth_workers_is_set;
+    int synth_workers; /* 1 = shared worker, 2 = per-slot workers */
+    int p25p2_jitter_depth_is_set;
+    int p25p2_jitter_depth; /* frames per slot */
+
+    /* Symbol capture replay */
+    int symbol_fast_is_set;
+    int symbol_fast_enable;
+    int symbol_seek_is_set;
+    double symbol_seek_s; /* offset from capture start, or absolute unix seconds when >= 1e9 */
+    int symbol_seek_sync_is_set;
+    int symbol_seek_sync; /* -1 = any sync event */
+    int symbol_legacy_is_set;
+    int symbol_legacy_enable; /* write headerless raw dibit captures */
 
     /* Frontend tuning behavior */
     int fs4_shift_disable_is_set;
@@ -500,6 +592,10 @@ typedef struct dsdneoRuntimeConfig {
     int iq_dc_shift_is_set;
     int iq_dc_shift;
 
+    /* I/Q imbalance corrector */
+    int iq_balance_is_set;
+    int iq_balance_enable;
+
     /* RTL channel complex low-pass (post-HB, complex baseband).
        Allows narrowing noise when running the RTL DSP baseband at higher
        sample rates (e.g., 24 kHz) without forcing it on for all modes. */
@@ -534,6 +630,53 @@ void dsd_neo_config_init(const dsd_opts* opts);
  */
 const dsdneoRuntimeConfig* dsd_neo_get_config(void);
 
+/**
+ * @brief Get the current runtime configuration snapshot, initializing it from
+ * the environment on first use.
+ *
+ * Snapshots are immutable once published and remain valid for the life of the
+ * process, so hot paths may hold the returned pointer in their context and
+ * refresh it at a coarse boundary (frame sync, block start) instead of
+ * querying the config per symbol. Reconfiguration publishes a new snapshot
+ * atomically; holders see either the old or the new one, never a mix.
+ *
+ * @param opts Decoder options forwarded to `dsd_neo_config_init` (may be NULL).
+ * @return Pointer to the current snapshot (never NULL).
+ */
+const dsdneoRuntimeConfig* dsd_neo_config_snapshot(const dsd_opts* opts);
+
+/**
+ * @brief Counter bumped on every snapshot publish; lets holders detect a
+ * reconfiguration cheaply.
+ */
+unsigned int dsd_neo_config_generation(void);
+
+/**
+ * @brief Return the context-held snapshot, or the current one when none is held.
+ *
+ * Unlike `dsd_neo_config_cached` this never initializes; the result is NULL
+ * until the configuration has been initialized.
+ */
+static inline const dsdneoRuntimeConfig*
+dsd_neo_config_held(const dsdneoRuntimeConfig* held) {
+    return held ? held : dsd_neo_get_config();
+}
+
+/**
+ * @brief Return the snapshot held in `*slot`, filling the slot on first use.
+ *
+ * @param slot Context-held snapshot pointer (e.g. `dsd_state::rt_cfg`).
+ * @param opts Decoder options forwarded on first initialization (may be NULL).
+ * @return Snapshot pointer (never NULL).
+ */
+static inline const dsdneoRuntimeConfig*
+dsd_neo_config_cached(const dsdneoRuntimeConfig** slot, const dsd_opts* opts) {
+    if (!*slot) {
+        *slot = dsd_neo_config_snapshot(opts);
+    }
+    return *slot;
+}
+
 /**
  * @brief Apply runtime config values to opts/state.
  *
@@ -10,7 +10,11 @@
  * Protocol/DSP code may call dsd_runtime_pump_controls() during long-running
  * loops to keep user controls responsive without depending on UI headers.
  *
- * The default behavior is a safe no-op until a control pump is registered.
+ * Input wait loops call dsd_runtime_pump_input_wait() each time they time out
+ * waiting for samples, so work posted for the decoder thread still runs while
+ * upstream I/O is stalled.
+ *
+ * The default behavior is a safe no-op until a pump is registered.
  */
 #pragma once
 
@@ -37,6 +41,22 @@ void dsd_runtime_set_control_pump(dsd_control_pump_fn fn);
  */
 void dsd_runtime_pump_controls(dsd_opts* opts, dsd_state* state);
 
+typedef void (*dsd_input_wait_pump_fn)(void);
+
+/**
+ * @brief Register (or unregister) the input wait pump.
+ *
+ * Passing NULL unregisters.
+ */
+void dsd_runtime_set_input_wait_pump(dsd_input_wait_pump_fn fn);
+
+/**
+ * @brief Run the input wait pump if one is registered.
+ *
+ * Called on the decoder thread while it is blocked waiting for input.
+ */
+void dsd_runtime_pump_input_wait(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Pushed decoder change events and the talkgroup filter snapshot.
+ *
+ * Front-ends subscribe to typed call, site, signal, neighbor, patch and
+ * affiliation events instead of polling `dsd_state`. Protocol code reports
+ * changes where they happen, on the decoder thread: calls next to the P25/DMR
+ * trunk SM emit sites and the DMR terminator, site identity where it is
+ * decoded, FEC counters per TSBK/MBT, tables from their mutators, and sync or
+ * carrier edges from the engine. Callbacks therefore see a consistent state
+ * without extra locking, and nothing is diffed per frame.
+ *
+ * The subscriber list and the talkgroup filter are immutable snapshots swapped
+ * RCU-style: readers (dispatch, `dsd_tg_filter_allows`) take no locks, and
+ * writers publish a new copy and wait for in-flight readers before freeing the
+ * old one.
+ */
+
+#pragma once
+
+#include <dsd-neo/core/state_fwd.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum dsd_decoder_event_kind {
+    DSD_EVENT_CALL = 0,
+    DSD_EVENT_SITE = 1,
+    DSD_EVENT_SIGNAL = 2,
+    DSD_EVENT_NEIGHBOR = 3,
+    DSD_EVENT_PATCH = 4,
+    DSD_EVENT_AFFILIATION = 5,  /**< `p25_aff_*` table changed. */
+    DSD_EVENT_GROUP_ATTACH = 6, /**< `p25_ga_*` table changed. */
+    DSD_EVENT_KIND_COUNT
+} dsd_decoder_event_kind;
+
+/** @brief Subscription mask bit for an event kind. */
+#define DSD_EVENT_MASK(kind) (1u << (unsigned)(kind))
+#define DSD_EVENT_MASK_ALL   ((1u << DSD_EVENT_KIND_COUNT) - 1u)
+
+typedef enum dsd_call_phase {
+    DSD_CALL_START = 0,
+    DSD_CALL_UPDATE = 1, /**< Talkgroup or source changed without an idle gap. */
+    DSD_CALL_END = 2,    /**< Carries the talkgroup/source of the call that ended. */
+} dsd_call_phase;
+
+typedef struct dsd_call_event {
+    int phase; /**< `dsd_call_phase`. */
+    int tg;
+    int src;
+    int slot;     /**< 0 or 1 (P25p1 and conventional DMR MS use 0). */
+    int nac;      /**< NAC/color code at the time of the change. */
+    int synctype; /**< `DSD_SYNC_*` at the time of the change. */
+    uint8_t is_private;
+    uint8_t is_emergency;
+    uint8_t filtered; /**< 1 when the talkgroup filter rejects `tg`. */
+} dsd_call_event;
+
+typedef struct dsd_site_event {
+    uint64_t wacn;
+    uint64_t siteid;
+    uint64_t rfssid;
+    int nac;
+} dsd_site_event;
+
+typedef struct dsd_signal_event {
+    unsigned int tsbk_ok;
+    unsigned int tsbk_err;
+    int synctype;
+    int carrier;
+} dsd_signal_event;
+
+/**
+ * @brief One decoder change.
+ *
+ * Table events (neighbor, patch, affiliation, group attach) carry no payload;
+ * read the `p25_*` arrays from `state`, which is only valid for the duration
+ * of the callback.
+ */
+typedef struct dsd_decoder_event {
+    dsd_decoder_event_kind kind;
+    const dsd_state* state;
+
+    union {
+        dsd_call_event call;
+        dsd_site_event site;
+        dsd_signal_event signal;
+    } u;
+} dsd_decoder_event;
+
+typedef void (*dsd_decoder_event_fn)(const dsd_decoder_event* ev, void* user);
+
+/**
+ * @brief Register a callback for the kinds in `mask`.
+ *
+ * Callbacks run synchronously on the decoder thread and must not block or
+ * (un)subscribe; copy what is needed and hand slow work (UI, JNI) to another
+ * thread.
+ * @return Subscription id (> 0), or -1 on invalid arguments/allocation failure.
+ */
+int dsd_decoder_events_subscribe(uint32_t mask, dsd_decoder_event_fn fn, void* user);
+
+/** @brief Remove a subscription; returns once no dispatch can still reach it. */
+void dsd_decoder_events_unsubscribe(int id);
+
+/** @brief Dispatch one event to matching subscribers (lock-free). */
+void dsd_decoder_events_emit(const dsd_decoder_event* ev);
+
+/*
+ * Source-side reporting. Decoder thread only; each is a no-op when nothing is
+ * subscribed to the kind it would emit.
+ */
+
+/**
+ * @brief Report voice activity (`active` = 1) or teardown (0) on `slot`.
+ *
+ * Activity emits START, or UPDATE when the talkgroup/source changed without a
+ * teardown, once the slot's `lasttg`/`lastsrc` (`lasttgR`/`lastsrcR` for slot
+ * 1) are known; teardown emits END for the last reported call. `slot` -1 tears
+ * down both slots.
+ */
+void dsd_decoder_events_call(dsd_state* state, int slot, int active);
+
+/**
+ * @brief Per-frame call fallback for protocols without report sites.
+ *
+ * For NXDN, EDACS/ProVoice, dPMR, M17, YSF and D-STAR, reads the protocol's
+ * own destination/source fields (callsigns are summed into a stable id) and
+ * emits START/UPDATE, or END once they clear. No-op for P25 and DMR, which
+ * report through `dsd_decoder_events_call`. Call once per decoded frame.
+ */
+void dsd_decoder_events_frame(dsd_state* state);
+
+/** @brief Report the decoded site identity (WACN/site/RFSS and NAC); emits when it changed and is non-zero. */
+void dsd_decoder_events_site(dsd_state* state);
+
+/**
+ * @brief Report sync, carrier and P25 FEC counters.
+ *
+ * Emits on a sync or carrier edge, otherwise at most once per 100 ms.
+ */
+void dsd_decoder_events_signal(dsd_state* state);
+
+/** @brief Report that the neighbor, patch, affiliation or group attach table was modified. */
+void dsd_decoder_events_table(dsd_state* state, dsd_decoder_event_kind kind);
+
+/** @brief Forget reported values so the next report re-announces the current call/site/signal. */
+void dsd_decoder_events_reset(dsd_state* state);
+
+/*
+ * Talkgroup filter (RCU snapshot).
+ */
+
+typedef enum dsd_tg_filter_mode {
+    DSD_TG_FILTER_OFF = 0,   /**< Hear every talkgroup. */
+    DSD_TG_FILTER_ALLOW = 1, /**< Hear only listed talkgroups. */
+    DSD_TG_FILTER_BLOCK = 2, /**< Hear all except listed talkgroups. */
+} dsd_tg_filter_mode;
+
+/** @brief Replace mode and list in one publish. @return 0, or -1 on invalid mode/allocation failure. */
+int dsd_tg_filter_set(int mode, const int* tgs, size_t count);
+int dsd_tg_filter_set_mode(int mode);
+int dsd_tg_filter_set_list(const int* tgs, size_t count);
+int dsd_tg_filter_add(int tg);
+int dsd_tg_filter_remove(int tg);
+
+int dsd_tg_filter_get_mode(void);
+size_t dsd_tg_filter_count(void);
+
+/** @brief 1 when `tg` passes the current filter, 0 otherwise. Lock-free; safe from any thread. */
+int dsd_tg_filter_allows(int tg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -21,7 +21,6 @@ extern "C" {
 #endif
 
 typedef struct {
-    void (*p25_sm_try_tick)(dsd_opts* opts, dsd_state* state);
     void (*p25_sm_on_release)(dsd_opts* opts, dsd_state* state);
     void (*eot_cc)(dsd_opts* opts, dsd_state* state);
     void (*no_carrier)(dsd_opts* opts, dsd_state* state);
@@ -29,7 +28,6 @@ typedef struct {
 
 void dsd_frame_sync_hooks_set(dsd_frame_sync_hooks hooks);
 
-void dsd_frame_sync_hook_p25_sm_try_tick(dsd_opts* opts, dsd_state* state);
 void dsd_frame_sync_hook_p25_sm_on_release(dsd_opts* opts, dsd_state* state);
 void dsd_frame_sync_hook_eot_cc(dsd_opts* opts, dsd_state* state);
 void dsd_frame_sync_hook_no_carrier(dsd_opts* opts, dsd_state* state);
@@ -28,6 +28,13 @@ struct input_ring_state {
     dsd_mutex_t ready_m;
     std::atomic<uint64_t> producer_drops; /* bytes dropped when full */
     std::atomic<uint64_t> read_timeouts;  /* waits for data */
+    /* In-band retune marker. Any thread bumps marker_req after a retune; the
+       producer stamps its write position on the next commit, so the consumer
+       sees exactly where samples from the new frequency start. */
+    std::atomic<uint32_t> marker_req; /* requests issued */
+    std::atomic<uint32_t> marker_seq; /* producer: last request stamped */
+    std::atomic<size_t> marker_pos;   /* producer: index of the first sample after the marker */
+    uint32_t marker_seen;             /* consumer: last marker crossed */
 };
 
 /**
@@ -101,13 +108,41 @@ void input_ring_write(struct input_ring_state* r, const float* data, size_t coun
 /**
  * @brief Read up to max_count samples from the input ring, blocking until available.
  *
+ * Samples queued ahead of a pending retune marker are discarded; see
+ * input_ring_read_block_marker().
+ *
  * @param r         Input ring buffer state.
  * @param out       Destination buffer for samples.
  * @param max_count Maximum number of samples to read.
- * @return Number of samples read (>=1), 0 if max_count is 0, or -1 on exit.
+ * @return Number of samples read (>=1), 0 if max_count is 0 or a marker was crossed, or -1 on exit.
  */
 int input_ring_read_block(struct input_ring_state* r, float* out, size_t max_count);
 
+/**
+ * @brief Read like input_ring_read_block(), reporting retune markers.
+ *
+ * When a stamped marker is pending, the samples ahead of it are dropped, the
+ * read stops at the marker and returns 0 with `*marker` set, so the caller can
+ * reset its DSP state before the first sample from the new frequency.
+ *
+ * @param r         Input ring buffer state.
+ * @param out       Destination buffer for samples.
+ * @param max_count Maximum number of samples to read.
+ * @param marker    [out] Set to 1 when a marker was crossed (optional).
+ * @return Number of samples read, 0 at a marker or if max_count is 0, or -1 on exit.
+ */
+int input_ring_read_block_marker(struct input_ring_state* r, float* out, size_t max_count, int* marker);
+
+/**
+ * @brief Request a retune marker at the producer's next write position.
+ *
+ * Safe from any thread. Back-to-back requests collapse into the latest one.
+ */
+static inline void
+input_ring_request_marker(struct input_ring_state* r) {
+    r->marker_req.fetch_add(1, std::memory_order_acq_rel);
+}
+
 /**
  * @brief Discard all pending samples (consumer-side purge).
  *
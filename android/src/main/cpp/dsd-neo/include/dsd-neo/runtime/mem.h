@@ -8,7 +8,9 @@
  * @brief Runtime memory management interface for aligned allocations.
  *
  * Declares `dsd_neo_aligned_malloc` and `dsd_neo_aligned_free`, providing a
- * default alignment of `DSD_NEO_ALIGN` for DSP-intensive buffers.
+ * default alignment of `DSD_NEO_ALIGN` for DSP-intensive buffers, and a pooled
+ * allocator for large long-lived buffers (sample rings) backed by dedicated
+ * page mappings.
  */
 
 #pragma once
@@ -43,6 +45,58 @@ void* dsd_neo_aligned_malloc(size_t size);
  */
 void dsd_neo_aligned_free(void* ptr);
 
+/* Requests at least this large get a dedicated mapping from dsd_neo_buffer_malloc */
+#define DSD_NEO_BUFFER_MAP_MIN ((size_t)256 * 1024)
+
+/**
+ * @brief Allocate a large, long-lived DSP buffer (at least `DSD_NEO_ALIGN` aligned).
+ *
+ * Requests of `DSD_NEO_BUFFER_MAP_MIN` bytes or more get their own anonymous
+ * mapping, backed per the runtime config: explicit hugepages when
+ * `DSD_NEO_MEM_HUGEPAGES=1` and available, else normal pages aligned and
+ * hinted for transparent hugepages; prefaulted from the calling thread
+ * (`DSD_NEO_MEM_PREFAULT`, default on) and optionally `mlock`ed
+ * (`DSD_NEO_MEM_LOCK`). Freed mappings are kept in a small pool and handed
+ * back to the next request of similar size, so resizing a running stream
+ * reuses pages that are already resident; owners call `dsd_neo_buffer_trim`
+ * when they stop so nothing stays mapped while idle. Smaller requests, and platforms without
+ * `mmap`, fall back to `dsd_neo_aligned_malloc`.
+ *
+ * Contents are unspecified.
+ *
+ * @param size Number of bytes to allocate.
+ * @return Pointer to the buffer, or NULL on failure or when `size` is 0.
+ */
+void* dsd_neo_buffer_malloc(size_t size);
+
+/**
+ * @brief Release a buffer from `dsd_neo_buffer_malloc` (NULL is a no-op).
+ *
+ * @param ptr Pointer previously returned by `dsd_neo_buffer_malloc`.
+ */
+void dsd_neo_buffer_free(void* ptr);
+
+/** @brief Unmap every pooled (free) buffer mapping. */
+void dsd_neo_buffer_trim(void);
+
+typedef struct {
+    size_t live_bytes;      /* mapped and handed out */
+    size_t pooled_bytes;    /* mapped and kept for reuse */
+    unsigned live_maps;
+    unsigned pooled_maps;
+    unsigned hugetlb_maps;  /* live or pooled mappings on explicit hugepages */
+    unsigned locked_maps;   /* live or pooled mappings that are mlocked */
+    unsigned long mapped;   /* mappings created */
+    unsigned long reused;   /* requests served from the pool */
+} dsd_neo_buffer_stats;
+
+/**
+ * @brief Snapshot of the buffer pool.
+ *
+ * @param out Receives the counters.
+ */
+void dsd_neo_buffer_get_stats(dsd_neo_buffer_stats* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,48 +5,94 @@
 
 /**
  * @file
- * @brief P25 Phase 2 audio jitter ring helpers.
+ * @brief P25 Phase 2 per-slot audio jitter buffers.
  *
- * Declares helpers for managing the per-slot fixed-size audio jitter buffer
- * stored in `dsd_state`. Implementations live in the runtime module so both
- * core and protocol call sites can share the logic without introducing a
- * core↔protocol link cycle.
+ * Each TDMA slot has a single-producer/single-consumer ring of decoded
+ * 160-sample (20 ms) frames. The producer is the thread running the Phase 2
+ * frame decoder and the consumer is the audio mixer; they may be different
+ * threads. Depth comes from `DSD_NEO_P25P2_JITTER_DEPTH` (default 3, ~60 ms).
+ *
+ * A full ring drops its oldest frame to keep latency bounded. Producer
+ * eviction and consumer reads both claim the head with a compare-and-swap,
+ * so every frame is either read or counted as an overrun exactly once, and
+ * a consumer stalled for any length of time never sees a torn frame.
+ *
+ * The rings hang off `dsd_state` as an extension slot and are created on
+ * first use by the producer, so a zero-filled state works. Implementations
+ * live in the runtime module so both core and protocol call sites can share
+ * them without introducing a core↔protocol link cycle.
  */
 
 #pragma once
 
 #include <dsd-neo/core/state_fwd.h>
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** @brief Largest accepted jitter buffer depth, in frames. */
+#define P25_P2_AUDIO_RING_MAX_DEPTH 8
+
+/** @brief Cumulative per-slot counters; they survive resets. */
+typedef struct {
+    int depth;      /**< configured capacity in frames */
+    int count;      /**< frames currently buffered */
+    int high_water; /**< largest fill level seen */
+    uint32_t pushed;
+    uint32_t popped;
+    uint32_t overruns;  /**< frames dropped because the ring was full */
+    uint32_t underruns; /**< reads that found the ring empty */
+    uint32_t flushed;   /**< frames discarded by reset */
+} p25_p2_audio_ring_stats;
+
 /**
- * @brief Reset Phase 2 audio jitter ring for one or both slots.
+ * @brief Discard buffered audio for one or both slots.
+ *
+ * Producer side. Discarded frames are counted in `flushed`.
  *
- * @param state Decoder state containing jitter rings.
+ * @param state Decoder state owning the rings.
  * @param slot  Slot index (0/1) or negative to reset both.
  */
 void p25_p2_audio_ring_reset(dsd_state* state, int slot);
 
 /**
- * @brief Push one 160-sample float frame into the Phase 2 jitter ring.
+ * @brief Copy one 160-sample float frame into the slot's ring, timestamped now.
  *
- * Drops the oldest frame when the ring is full to keep latency bounded.
+ * Producer side. Drops (and counts) the oldest frame when the ring is full.
  *
- * @return 1 on success, 0 on invalid input.
+ * @return 1 on success, 0 on invalid input or allocation failure.
  */
 int p25_p2_audio_ring_push(dsd_state* state, int slot, const float* frame160);
 
 /**
- * @brief Pop one 160-sample float frame from the Phase 2 jitter ring.
+ * @brief Copy the oldest frame out of the slot's ring.
  *
- * When empty, fills out160 with zeros and returns 0.
+ * Consumer side. The frame is copied before it is claimed and the claim fails
+ * if the producer evicted it meanwhile, so the producer never writes storage
+ * the consumer is reading and the caller owns `out160` outright. When empty,
+ * `out160` is left untouched and an underrun is counted.
+ *
+ * @param ts_ns Optional; receives the monotonic push time in nanoseconds.
+ * @return 1 when a frame was copied; 0 when empty/invalid.
+ */
+int p25_p2_audio_ring_read(dsd_state* state, int slot, float* out160, uint64_t* ts_ns);
+
+/**
+ * @brief Like `p25_p2_audio_ring_read`, but zero-fills `out160` when empty.
  *
  * @return 1 when a frame was returned; 0 when empty/invalid.
  */
 int p25_p2_audio_ring_pop(dsd_state* state, int slot, float* out160);
 
+/** @brief Number of frames buffered for `slot`; safe from either side. */
+int p25_p2_audio_ring_count(const dsd_state* state, int slot);
+
+/** @brief Snapshot the slot's counters. Zeroes `out` when the ring does not exist yet. */
+void p25_p2_audio_ring_get_stats(const dsd_state* state, int slot, p25_p2_audio_ring_stats* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Buffered symbol capture/replay streams.
+ *
+ * Block-buffered reader and writer for dibit (`.bin`) and float (`.raw`/`.sym`)
+ * symbol files, replacing per-symbol `fgetc`/`fread`/`fputc` calls. Dibit
+ * captures start with a small self-describing header (format version, symbol
+ * rate, modulation, start time); headerless legacy captures are still read
+ * transparently since their payload bytes are always 0..3 or 0xFF.
+ *
+ * Version 2 captures are a seekable container: the dibit payload is split
+ * into chunks, each preceded by an index record (wall-clock time, tuned
+ * frequency, sync type, symbol and byte offsets, payload length). Chunks are
+ * cut about once per second of signal and on sync/frequency changes, so a
+ * reader can hop record to record to seek to a timestamp or sync event
+ * without decoding the payload in between.
+ *
+ * The `dsd_symbol_in_*`/`dsd_symbol_out_*` helpers bind a stream to
+ * `opts->symbolfile`/`opts->symbol_out_f` through `dsd_state_ext`, so existing
+ * open/close sites keep working with plain `FILE*` handles.
+ */
+
+#pragma once
+
+#include <dsd-neo/core/opts_fwd.h>
+#include <dsd-neo/core/state_fwd.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Serialized header size in bytes. */
+enum { DSD_SYMBOL_FILE_HEADER_SIZE = 32 };
+
+/** @brief Current header version written by `dsd_symbol_out_begin` (2 = chunked with index records). */
+enum { DSD_SYMBOL_FILE_VERSION = 2 };
+
+/** @brief Serialized index record size in bytes. */
+enum { DSD_SYMBOL_INDEX_RECORD_SIZE = 48 };
+
+/** @brief Reasons a chunk was started (`dsd_symbol_index_record.flags`). */
+enum {
+    DSD_SYMBOL_INDEX_SYNC = 1u << 0,     /**< Sync acquired or sync type changed. */
+    DSD_SYMBOL_INDEX_FREQ = 1u << 1,     /**< Tuned frequency changed. */
+    DSD_SYMBOL_INDEX_PERIODIC = 1u << 2, /**< Periodic index point. */
+};
+
+typedef enum dsd_symbol_format {
+    DSD_SYMBOL_FMT_DIBIT = 0,   /**< One byte per dibit (0..3; 0xFF marks dead air). */
+    DSD_SYMBOL_FMT_FLOAT32 = 1, /**< Native-endian float per symbol. */
+} dsd_symbol_format;
+
+typedef struct dsd_symbol_file_header {
+    uint16_t version;
+    uint8_t format;       /**< `dsd_symbol_format`. */
+    uint8_t modulation;   /**< `state->rf_mod` at capture start (0 C4FM, 1 QPSK, 2 GFSK). */
+    uint32_t symbol_rate; /**< Nominal symbols/s at capture start (0 = unknown). */
+    int64_t start_unix_ns;
+} dsd_symbol_file_header;
+
+/**
+ * @brief Serialize a header (little-endian) into `out`.
+ * @return `DSD_SYMBOL_FILE_HEADER_SIZE`.
+ */
+size_t dsd_symbol_file_header_encode(const dsd_symbol_file_header* hdr, uint8_t out[DSD_SYMBOL_FILE_HEADER_SIZE]);
+
+/**
+ * @brief Parse a header from the first bytes of a file.
+ * @return 1 when `in` starts with a valid header, 0 otherwise (legacy/headerless).
+ */
+int dsd_symbol_file_header_decode(const uint8_t* in, size_t len, dsd_symbol_file_header* hdr);
+
+/** @brief Index record heading each chunk of a version 2 capture. */
+typedef struct dsd_symbol_index_record {
+    uint64_t symbol_offset; /**< Dibits in the capture before this chunk. */
+    uint64_t byte_offset;   /**< File offset of this record. */
+    int64_t wall_unix_ns;   /**< Wall-clock time of the chunk's first dibit. */
+    int64_t freq_hz;        /**< Tuned frequency (0 = unknown). */
+    int32_t synctype;       /**< `DSD_SYNC_*` at chunk start (`DSD_SYNC_NONE` when unsynced). */
+    uint32_t flags;         /**< `DSD_SYMBOL_INDEX_*`. */
+    uint32_t payload_len;   /**< Dibit bytes following the record. */
+} dsd_symbol_index_record;
+
+typedef struct dsd_symbol_reader dsd_symbol_reader;
+typedef struct dsd_symbol_writer dsd_symbol_writer;
+
+/**
+ * @brief Wrap an already-open file for buffered symbol reads.
+ *
+ * Reads from the current position. When positioned at the start of a dibit
+ * file, a header is consumed and exposed via `dsd_symbol_reader_header`.
+ * The reader does not own `f`.
+ */
+dsd_symbol_reader* dsd_symbol_reader_attach(FILE* f, dsd_symbol_format format);
+void dsd_symbol_reader_free(dsd_symbol_reader* r);
+
+/** @brief Header of the attached file, or NULL for headerless captures. */
+const dsd_symbol_file_header* dsd_symbol_reader_header(const dsd_symbol_reader* r);
+
+/** @brief Read up to `n` dibit bytes. @return Count read (0 at EOF). */
+size_t dsd_symbol_reader_read_dibits(dsd_symbol_reader* r, uint8_t* out, size_t n);
+
+/** @brief Read up to `n` float symbols. @return Count read (0 at EOF). */
+size_t dsd_symbol_reader_read_floats(dsd_symbol_reader* r, float* out, size_t n);
+
+/** @brief Next dibit byte, or -1 at EOF. */
+int dsd_symbol_reader_next_dibit(dsd_symbol_reader* r);
+
+/** @brief Symbols delivered so far (absolute symbol offset after a seek). */
+uint64_t dsd_symbol_reader_count(const dsd_symbol_reader* r);
+
+/** @brief Index record of the chunk being read, or NULL for unindexed files/before the first chunk. */
+const dsd_symbol_index_record* dsd_symbol_reader_chunk(const dsd_symbol_reader* r);
+
+/**
+ * @brief Reposition at the chunk covering `unix_ns` (the last chunk starting at or before it).
+ *
+ * Requires a seekable version 2 capture. Times before the first chunk select the first chunk.
+ * @return 0 on success, -1 when unsupported or the file has no index; the position is unchanged on failure.
+ */
+int dsd_symbol_reader_seek_time(dsd_symbol_reader* r, int64_t unix_ns);
+
+/**
+ * @brief Reposition at the first sync event at or after `from_unix_ns`.
+ *
+ * @param synctype `DSD_SYNC_*` to match, or negative for any sync acquisition/change.
+ * @return 0 on success, -1 when no matching chunk exists; the position is unchanged on failure.
+ */
+int dsd_symbol_reader_seek_sync(dsd_symbol_reader* r, int synctype, int64_t from_unix_ns);
+
+/**
+ * @brief Wrap an already-open file for buffered dibit writes.
+ *
+ * When `hdr` is non-NULL it is written first; a version 2 header makes the
+ * writer emit an index record ahead of every chunk. Without a header the
+ * output is a raw legacy dibit stream. The writer does not own `f`; call
+ * `dsd_symbol_writer_free` (which flushes) before closing it.
+ */
+dsd_symbol_writer* dsd_symbol_writer_attach(FILE* f, const dsd_symbol_file_header* hdr);
+void dsd_symbol_writer_free(dsd_symbol_writer* w);
+
+void dsd_symbol_writer_put(dsd_symbol_writer* w, uint8_t dibit);
+void dsd_symbol_writer_write(dsd_symbol_writer* w, const uint8_t* dibits, size_t n);
+int dsd_symbol_writer_flush(dsd_symbol_writer* w);
+
+/**
+ * @brief End the current chunk and start a new one with the given index attributes.
+ *
+ * No-op for unindexed writers. Chunks are also cut automatically when the buffer fills.
+ */
+void dsd_symbol_writer_mark(dsd_symbol_writer* w, int64_t wall_unix_ns, int64_t freq_hz, int synctype, uint32_t flags);
+
+/*
+ * Decoder bindings for opts->symbolfile / opts->symbol_out_f.
+ */
+
+/**
+ * @brief Next dibit from `opts->symbolfile` (AUDIO_IN_SYMBOL_BIN).
+ * @return 0..3 (or 0xFF dead air), -1 at EOF/no file.
+ */
+int dsd_symbol_in_dibit(dsd_opts* opts, dsd_state* state);
+
+/**
+ * @brief Next float symbol from `opts->symbolfile` (AUDIO_IN_SYMBOL_FLT).
+ * @return 1 on success, 0 at EOF/no file.
+ */
+int dsd_symbol_in_float(dsd_opts* opts, dsd_state* state, float* out);
+
+/**
+ * @brief Drop replay buffering; call whenever `opts->symbolfile` is opened/closed.
+ *
+ * The next read re-attaches and applies `DSD_NEO_SYMBOL_SEEK`/`DSD_NEO_SYMBOL_SEEK_SYNC`.
+ */
+void dsd_symbol_in_reset(dsd_state* state);
+
+/**
+ * @brief Close `opts->symbolfile` (if open) and set it to NULL.
+ *
+ * Use instead of a bare `fclose` so the replay reader is never reused for a
+ * later file whose `FILE*` happens to land at the same address.
+ */
+void dsd_symbol_in_close(dsd_opts* opts);
+
+/** @brief Log replay throughput (symbols, signal seconds, x-real-time) for the current file. */
+void dsd_symbol_in_report(dsd_opts* opts, dsd_state* state);
+
+/**
+ * @brief Attach a buffered writer to a freshly opened `opts->symbol_out_f`, writing the header.
+ *
+ * With `DSD_NEO_SYMBOL_LEGACY=1` no header or index is written and the file
+ * is a raw dibit stream.
+ */
+void dsd_symbol_out_begin(dsd_opts* opts, dsd_state* state);
+
+/**
+ * @brief Queue one dibit for `opts->symbol_out_f` (no-op when capture is off).
+ *
+ * Starts a new indexed chunk on sync acquisition/change, retune, and about
+ * once per second of signal.
+ */
+void dsd_symbol_out_put(dsd_opts* opts, dsd_state* state, int dibit);
+
+/** @brief Flush and detach the writer; call before closing `opts->symbol_out_f`. */
+void dsd_symbol_out_end(dsd_state* state);
+
+#ifdef __cplusplus
+}
+#endif
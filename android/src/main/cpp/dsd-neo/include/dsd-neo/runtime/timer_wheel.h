@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Hierarchical timing wheel with intrusive timers.
+ *
+ * Four levels of 64 slots. Level 0 resolves single ticks; each higher level
+ * covers 64 times the span of the one below and is cascaded down as time
+ * reaches it, so arming and cancelling are O(1) and advancing only visits
+ * slots that hold timers. With a 10 ms tick the wheel spans about 46 hours;
+ * later deadlines are parked at the far edge and re-placed as they approach.
+ *
+ * Timers are caller-owned structs linked into the wheel. The wheel does no
+ * locking; callers serialize access. Callbacks run from
+ * `dsd_timer_wheel_advance` with the timer already unlinked and may re-arm or
+ * cancel any timer, including the one firing.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DSD_TIMER_WHEEL_LEVELS 4
+#define DSD_TIMER_WHEEL_BITS   6
+#define DSD_TIMER_WHEEL_SLOTS  (1 << DSD_TIMER_WHEEL_BITS)
+
+struct dsd_timer;
+typedef void (*dsd_timer_fn)(struct dsd_timer* timer, void* user);
+
+typedef struct dsd_timer {
+    struct dsd_timer* next;
+    struct dsd_timer** pprev; /* NULL while not armed */
+    uint64_t expires;         /* tick */
+    int8_t level;             /* -1 while on the firing list */
+    uint8_t slot;
+    dsd_timer_fn fn;
+    void* user;
+} dsd_timer;
+
+typedef struct dsd_timer_wheel {
+    dsd_timer* slots[DSD_TIMER_WHEEL_LEVELS][DSD_TIMER_WHEEL_SLOTS];
+    uint64_t occupied[DSD_TIMER_WHEEL_LEVELS]; /* bit per non-empty slot */
+    uint64_t now_tick;
+    uint64_t origin_ms;
+    uint32_t tick_ms;
+    int count;
+} dsd_timer_wheel;
+
+/** @brief Initialize an empty wheel whose tick 0 is `now_ms`; `tick_ms` of 0 means 1. */
+void dsd_timer_wheel_init(dsd_timer_wheel* w, uint32_t tick_ms, uint64_t now_ms);
+
+/** @brief Prepare an unarmed timer. */
+void dsd_timer_init(dsd_timer* t, dsd_timer_fn fn, void* user);
+
+/**
+ * @brief Arm (or re-arm) `t` to fire once `expires_ms` has been reached.
+ *
+ * Deadlines at or before the wheel's current time fire on the next advance.
+ */
+void dsd_timer_arm(dsd_timer_wheel* w, dsd_timer* t, uint64_t expires_ms);
+
+/** @brief Disarm `t`; no-op when it is not armed. */
+void dsd_timer_cancel(dsd_timer_wheel* w, dsd_timer* t);
+
+/** @brief Nonzero while `t` is armed. */
+int dsd_timer_pending(const dsd_timer* t);
+
+/**
+ * @brief Move the wheel to `now_ms` and fire every timer that has come due.
+ *
+ * Time never moves backwards; an earlier `now_ms` only fires timers that
+ * were armed already due.
+ *
+ * @return Number of callbacks run.
+ */
+int dsd_timer_wheel_advance(dsd_timer_wheel* w, uint64_t now_ms);
+
+/**
+ * @brief Earliest armed deadline, rounded up to a tick boundary.
+ *
+ * @param out_ms Receives the deadline in the caller's millisecond clock.
+ * @return 1 when a timer is armed, 0 when the wheel is empty.
+ */
+int dsd_timer_wheel_next_expiry(const dsd_timer_wheel* w, uint64_t* out_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Deadline scheduler for trunking state machines and table expiry.
+ *
+ * One timing wheel per `dsd_state` (attached via `dsd_state_ext`) with a
+ * fixed timer per job. Protocol code arms a job for the moment its next
+ * hangtime, grant timeout or table entry expires; the decoder loop calls
+ * `dsd_trunk_timers_run` and only jobs that are due execute, instead of each
+ * module polling and sweeping its tables on every tick.
+ *
+ * Deadlines are in `dsd_time_now_monotonic_s()` seconds with 10 ms
+ * resolution. Arming, cancelling and queries are safe from any thread.
+ * Handlers mutate decoder state (SM contexts, affiliation tables), so only
+ * the decoder loop calls `dsd_trunk_timers_run`; they may re-arm their own or
+ * any other job.
+ */
+
+#pragma once
+
+#include <dsd-neo/core/opts_fwd.h>
+#include <dsd-neo/core/state_fwd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum dsd_trunk_timer_id {
+    DSD_TRUNK_TIMER_P25_SM = 0,
+    DSD_TRUNK_TIMER_P25_AFF = 1,
+    DSD_TRUNK_TIMER_P25_GA = 2,
+    DSD_TRUNK_TIMER_P25_NB = 3,
+    DSD_TRUNK_TIMER_P25_PATCH = 4,
+    DSD_TRUNK_TIMER_DMR_SM = 5,
+    DSD_TRUNK_TIMER_COUNT
+} dsd_trunk_timer_id;
+
+typedef void (*dsd_trunk_timer_fn)(dsd_opts* opts, dsd_state* state);
+
+/**
+ * @brief Schedule job `id` to call `fn` at `due_s`, replacing any earlier arming.
+ *
+ * A deadline already in the past runs on the next `dsd_trunk_timers_run`.
+ *
+ * @return 0 on success, -1 on invalid input or allocation failure.
+ */
+int dsd_trunk_timer_arm(dsd_state* state, dsd_trunk_timer_id id, double due_s, dsd_trunk_timer_fn fn);
+
+/** @brief Disarm job `id`; no-op when it is not armed. */
+void dsd_trunk_timer_cancel(dsd_state* state, dsd_trunk_timer_id id);
+
+/**
+ * @brief Whether job `id` is armed.
+ *
+ * @param due_s Optional; receives the deadline when armed.
+ * @return 1 when armed, 0 otherwise.
+ */
+int dsd_trunk_timer_pending(const dsd_state* state, dsd_trunk_timer_id id, double* due_s);
+
+/**
+ * @brief Run every job that has come due.
+ *
+ * Call from the decoder thread only. Returns immediately when a run is
+ * already in progress (a handler re-entering through a nested decoder loop).
+ *
+ * @return Number of handlers run.
+ */
+int dsd_trunk_timers_run(dsd_opts* opts, dsd_state* state);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,10 +5,20 @@
 
 /**
  * @file
- * @brief Minimal 2-thread worker pool API for intra-block demodulation tasks.
+ * @brief N-worker fork/join pool for intra-block demodulation tasks.
  *
- * Exposes functions keyed by `demod_state*` to initialize/destroy a tiny
- * env-gated pool and to run up to two tasks in parallel per processing block.
+ * A pool owns a fixed set of worker threads fed through lock-free bounded
+ * queues: one shared queue any worker may take from, plus one queue per
+ * worker for tasks that must run on a specific worker (affinity). Idle
+ * workers spin briefly and then park on a condition variable; submitters
+ * only touch the mutex when a worker is actually parked.
+ *
+ * Tasks are submitted and joined by a single owning thread (for the demod
+ * pool, the demodulation thread). The owner helps drain the shared queue
+ * while joining, so a batch never waits on a parked worker to start.
+ *
+ * The `demod_mt_*` calls keep the original env-gated (`DSD_NEO_MT=1`)
+ * per-demodulator API on top of the pool stored in `demod_state::mt_pool`.
  */
 
 #ifndef RUNTIME_WORKER_POOL_H
@@ -24,16 +34,58 @@ extern "C" {
 /* Forward declaration to avoid including heavy headers here */
 struct demod_state;
 
-/*
- * Minimal 2-thread worker pool API (env-gated by DSD_NEO_MT)
- * These calls mirror the inlined versions that previously lived in rtl_sdr_fm.cpp
+/** @brief Maximum worker threads per pool. */
+#define DSD_WORKER_POOL_MAX_WORKERS 16
+
+typedef struct dsd_worker_pool dsd_worker_pool;
+
+/** @brief Task body. */
+typedef void (*dsd_worker_task_fn)(void* arg);
+
+/** @brief Range task body over `[begin, end)`. */
+typedef void (*dsd_worker_range_fn)(void* arg, int begin, int end);
+
+/**
+ * @brief Create a pool with `workers` threads.
+ *
+ * @param workers Worker thread count, clamped to 1..DSD_WORKER_POOL_MAX_WORKERS.
+ * @param first_cpu When >= 0, worker i is pinned to CPU `first_cpu + i` (best effort).
+ * @return Pool handle, or NULL on allocation/thread failure.
+ */
+dsd_worker_pool* dsd_worker_pool_create(int workers, int first_cpu);
+
+/** @brief Finish queued tasks, stop the workers and free the pool. NULL is a no-op. */
+void dsd_worker_pool_destroy(dsd_worker_pool* pool);
+
+/** @brief Number of worker threads (excluding the owning thread). */
+int dsd_worker_pool_size(const dsd_worker_pool* pool);
+
+/**
+ * @brief Queue a task without blocking.
+ *
+ * @param worker Worker index to run on, or -1 for any worker.
+ * @return 0 when queued; 1 when the queue was full and the task ran inline.
+ */
+int dsd_worker_pool_submit(dsd_worker_pool* pool, int worker, dsd_worker_task_fn fn, void* arg);
+
+/** @brief Wait until every task submitted so far has finished (spin, then park). */
+void dsd_worker_pool_join(dsd_worker_pool* pool);
+
+/**
+ * @brief Fork/join `fn` over `[begin, end)` split into chunks of at least `grain`.
+ *
+ * The owning thread runs the first chunk itself. Runs inline when `pool` is
+ * NULL or the range fits in a single chunk.
  */
+void dsd_worker_pool_parallel_for(dsd_worker_pool* pool, int begin, int end, int grain, dsd_worker_range_fn fn,
+                                  void* arg);
 
 /**
- * @brief Initialize the minimal worker pool when `DSD_NEO_MT=1`.
+ * @brief Initialize the worker pool for a demodulator when `DSD_NEO_MT=1`.
  *
+ * Worker count and pinning come from `DSD_NEO_MT_WORKERS` / `DSD_NEO_MT_CPU`.
  * Safe to call multiple times per demodulator instance.
- * @param s Demodulator state used as a key for the worker context.
+ * @param s Demodulator state that owns the pool.
  * @note No-op when multithreading is disabled via environment.
  */
 void demod_mt_init(struct demod_state* s);
@@ -41,16 +93,17 @@ void demod_mt_init(struct demod_state* s);
 /**
  * @brief Tear down worker threads created by `demod_mt_init`.
  *
- * @param s Demodulator state used as a key for the worker context.
+ * @param s Demodulator state that owns the pool.
  * @note Safe no-op if the pool was never enabled/initialized.
  */
 void demod_mt_destroy(struct demod_state* s);
 
 /**
- * @brief Post up to two tasks and wait for completion.
+ * @brief Run up to two tasks in parallel and wait for completion.
  *
- * Runs synchronously in the caller thread when the pool is disabled.
- * @param s Demodulator state key for the worker context.
+ * `f1` goes to a worker while the caller runs `f0`. Runs synchronously in
+ * the caller thread when the pool is disabled.
+ * @param s Demodulator state that owns the pool.
  * @param f0 Function pointer for the first task (may be NULL).
  * @param a0 Argument for the first task.
  * @param f1 Function pointer for the second task (may be NULL).
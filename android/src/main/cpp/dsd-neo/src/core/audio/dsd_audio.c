@@ -26,8 +26,10 @@
 #include <dsd-neo/platform/audio.h>
 #include <dsd-neo/platform/file_compat.h>
 #include <dsd-neo/platform/posix_compat.h>
+#include <dsd-neo/runtime/audio_sink.h>
 #include <dsd-neo/runtime/log.h>
 #include <dsd-neo/runtime/net_audio_input_hooks.h>
+#include <dsd-neo/runtime/symbol_file.h>
 #include <dsd-neo/runtime/udp_audio_hooks.h>
 
 #include <sndfile.h>
@@ -261,13 +263,11 @@ processAudio(dsd_opts* opts, dsd_state* state) {
     state->audio_out_temp_buf_p = state->audio_out_temp_buf;
     //we only want to upsample when using sample rates greater than 8k for output
     if (opts->pulse_digi_rate_out > 8000) {
-        for (n = 0; n < 160; n++) {
-            upsample(state, *state->audio_out_temp_buf_p);
-            state->audio_out_temp_buf_p++;
-            state->audio_out_float_buf_p += 6;
-            state->audio_out_idx += 6;
-            state->audio_out_idx2 += 6;
-        }
+        dsd_upsample_8k_48k(&state->upsample_l, state->audio_out_temp_buf_p, 160, state->audio_out_float_buf_p);
+        state->audio_out_temp_buf_p += 160;
+        state->audio_out_float_buf_p += 960;
+        state->audio_out_idx += 960;
+        state->audio_out_idx2 += 960;
         state->audio_out_float_buf_p -= (960 + opts->playoffset);
         // copy to output (short) buffer
         for (n = 0; n < 960; n++) {
@@ -377,13 +377,11 @@ processAudioR(dsd_opts* opts, dsd_state* state) {
     state->audio_out_temp_buf_pR = state->audio_out_temp_bufR;
     //we only want to upsample when using sample rates greater than 8k for output,
     if (opts->pulse_digi_rate_out > 8000) {
-        for (n = 0; n < 160; n++) {
-            upsample(state, *state->audio_out_temp_buf_pR);
-            state->audio_out_temp_buf_pR++;
-            state->audio_out_float_buf_pR += 6;
-            state->audio_out_idxR += 6;
-            state->audio_out_idx2R += 6;
-        }
+        dsd_upsample_8k_48k(&state->upsample_r, state->audio_out_temp_buf_pR, 160, state->audio_out_float_buf_pR);
+        state->audio_out_temp_buf_pR += 160;
+        state->audio_out_float_buf_pR += 960;
+        state->audio_out_idxR += 960;
+        state->audio_out_idx2R += 960;
         state->audio_out_float_buf_pR -= (960 + opts->playoffsetR);
         // copy to output (short) buffer
         for (n = 0; n < 960; n++) {
@@ -523,8 +521,10 @@ playSynthesizedVoice(dsd_opts* opts, dsd_state* state) {
 
     if (state->audio_out_idx > opts->delay) {
         if (opts->audio_out == 1 && opts->audio_out_type == 1) {
+            dsd_audio_sink_lock();
             ssize_t written = dsd_write(opts->audio_out_fd, (state->audio_out_buf_p - state->audio_out_idx),
                                         (size_t)state->audio_out_idx * sizeof(short));
+            dsd_audio_sink_unlock();
             if (written < 0) {
                 LOG_WARN("playSynthesizedVoice: failed to write %zu bytes to audio_out_fd",
                          (size_t)state->audio_out_idx * sizeof(short));
@@ -533,8 +533,10 @@ playSynthesizedVoice(dsd_opts* opts, dsd_state* state) {
         } else if (opts->audio_out == 1 && opts->audio_out_type == 0) {
             /* Use audio abstraction layer */
             if (opts->audio_out_stream) {
+                dsd_audio_sink_lock();
                 dsd_audio_write(opts->audio_out_stream, (state->audio_out_buf_p - state->audio_out_idx),
                                 (size_t)state->audio_out_idx);
+                dsd_audio_sink_unlock();
             }
             state->audio_out_idx = 0;
         } else if (opts->audio_out == 1
@@ -618,8 +620,7 @@ openAudioInDevice(dsd_opts* opts) {
         opts->audio_in_file_info = NULL;
     }
     if (opts->symbolfile) {
-        fclose(opts->symbolfile);
-        opts->symbolfile = NULL;
+        dsd_symbol_in_close(opts);
     }
     if (opts->tcp_in_ctx) {
         dsd_net_audio_input_hook_tcp_close(opts->tcp_in_ctx);
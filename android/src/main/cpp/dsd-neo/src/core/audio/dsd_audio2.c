@@ -17,8 +17,10 @@
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/core/synth_pipeline.h>
 #include <dsd-neo/platform/audio.h>
 #include <dsd-neo/platform/file_compat.h>
+#include <dsd-neo/runtime/audio_sink.h>
 #include <dsd-neo/runtime/p25_p2_audio_ring.h>
 #include <dsd-neo/runtime/udp_audio_hooks.h>
 
@@ -35,7 +37,9 @@
 static void
 write_s16_audio(dsd_opts* opts, const int16_t* buf, size_t frames) {
     if (opts->audio_out_stream) {
+        dsd_audio_sink_lock();
         dsd_audio_write(opts->audio_out_stream, buf, frames);
+        dsd_audio_sink_unlock();
     }
 }
 
@@ -61,7 +65,9 @@ write_float_audio(dsd_opts* opts, const float* buf, size_t frames) {
         }
         tmp[i] = (int16_t)v;
     }
+    dsd_audio_sink_lock();
     dsd_audio_write(opts->audio_out_stream, tmp, frames);
+    dsd_audio_sink_unlock();
 }
 
 // Return 1 if all elements are effectively zero (|x| < 1e-12f)
@@ -81,7 +87,9 @@ dsd_is_all_zero_f(const float* buf, size_t n) {
 
 static inline void
 write_audio_out(int fd, const void* buf, size_t bytes) {
+    dsd_audio_sink_lock();
     const ssize_t written = dsd_write(fd, buf, bytes);
+    dsd_audio_sink_unlock();
     (void)written;
 }
 
@@ -181,7 +189,6 @@ playSynthesizedVoiceFS3(dsd_opts* opts, dsd_state* state) {
     //it doesn't matter if both slots have voice, or if one does, the slot without voice
     //will play silence while this runs if no voice present
 
-    int i;
     int encL, encR;
     float stereo_samp1[320]; //8k 2-channel stereo interleave mix
     float stereo_samp2[320]; //8k 2-channel stereo interleave mix
@@ -233,32 +240,21 @@ playSynthesizedVoiceFS3(dsd_opts* opts, dsd_state* state) {
     agf(opts, state, state->f_l4[2], 0);
     agf(opts, state, state->f_r4[2], 1);
 
-    //interleave left and right channels from the temp (float) buffer
-    audio_mix_interleave_stereo_f32(state->f_l4[0], state->f_r4[0], 160, encL, encR, stereo_samp1);
-    audio_mix_interleave_stereo_f32(state->f_l4[1], state->f_r4[1], 160, encL, encR, stereo_samp2);
-    audio_mix_interleave_stereo_f32(state->f_l4[2], state->f_r4[2], 160, encL, encR, stereo_samp3);
-
     //at this point, if both channels are still flagged as enc, then we can skip all playback/writing functions
     if (encL && encR) {
         goto FS3_END;
     }
 
-    // If only one slot is active, duplicate to both channels for stereo sinks
-    if (!encL && encR) {
-        for (i = 0; i < 320; i += 2) {
-            stereo_samp1[i + 1] = stereo_samp1[i + 0];
-            stereo_samp2[i + 1] = stereo_samp2[i + 0];
-            stereo_samp3[i + 1] = stereo_samp3[i + 0];
-        }
-        encR = 0;
-    } else if (encL && !encR) {
-        for (i = 0; i < 320; i += 2) {
-            stereo_samp1[i + 0] = stereo_samp1[i + 1];
-            stereo_samp2[i + 0] = stereo_samp2[i + 1];
-            stereo_samp3[i + 0] = stereo_samp3[i + 1];
-        }
-        encL = 0;
+    //interleave left and right channels from the temp (float) buffer;
+    //if only one slot is active, it is interleaved onto both channels for stereo sinks
+    float* stereo_out[3] = {stereo_samp1, stereo_samp2, stereo_samp3};
+    for (int j = 0; j < 3; j++) {
+        const float* srcL = encL ? state->f_r4[j] : state->f_l4[j];
+        const float* srcR = encR ? state->f_l4[j] : state->f_r4[j];
+        audio_mix_interleave_stereo_f32(srcL, srcR, 160, 0, 0, stereo_out[j]);
     }
+    encL = 0;
+    encR = 0;
 
     if (opts->audio_out == 1) {
         if (opts->pulse_digi_out_channels == 1) {
@@ -356,7 +352,7 @@ playSynthesizedVoiceFS4(dsd_opts* opts, dsd_state* state) {
     //NOTE: This will run for every TS % 2, except on SACCH inverted slots (10 and 11)
     //WIP: Get the real TS number out of the P25p2 frame, and not our ts_counter values
 
-    int i, encL, encR;
+    int encL, encR;
     float stereo_samp1[320]; //8k 2-channel stereo interleave mix
     float stereo_samp2[320]; //8k 2-channel stereo interleave mix
     float stereo_samp3[320]; //8k 2-channel stereo interleave mix
@@ -393,53 +389,44 @@ playSynthesizedVoiceFS4(dsd_opts* opts, dsd_state* state) {
 
     memset(empty, 0.0f, sizeof(empty));
 
-    // Drain up to 4 frames from per-slot jitter buffers and interleave to stereo
-    float lf[4][160];
-    float rf[4][160];
+    // Drain up to 4 frames from per-slot jitter buffers and interleave to stereo.
+    // A slot stops at its first empty read.
+    float lbuf[4][160];
+    float rbuf[4][160];
+    float* lf[4] = {empty, empty, empty, empty};
+    float* rf[4] = {empty, empty, empty, empty};
     int l_ok[4] = {0, 0, 0, 0};
     int r_ok[4] = {0, 0, 0, 0};
     for (int j = 0; j < 4; j++) {
-        l_ok[j] = p25_p2_audio_ring_pop(state, 0, lf[j]);
-        r_ok[j] = p25_p2_audio_ring_pop(state, 1, rf[j]);
-        if (l_ok[j]) {
+        if ((j == 0 || l_ok[j - 1]) && p25_p2_audio_ring_read(state, 0, lbuf[j], NULL)) {
+            lf[j] = lbuf[j];
+            l_ok[j] = 1;
             agf(opts, state, lf[j], 0);
         }
-        if (r_ok[j]) {
+        if ((j == 0 || r_ok[j - 1]) && p25_p2_audio_ring_read(state, 1, rbuf[j], NULL)) {
+            rf[j] = rbuf[j];
+            r_ok[j] = 1;
             agf(opts, state, rf[j], 1);
         }
     }
 
-    int encL0 = (encL || !l_ok[0]) ? 1 : 0;
-    int encR0 = (encR || !r_ok[0]) ? 1 : 0;
-    int encL1 = (encL || !l_ok[1]) ? 1 : 0;
-    int encR1 = (encR || !r_ok[1]) ? 1 : 0;
-    int encL2 = (encL || !l_ok[2]) ? 1 : 0;
-    int encR2 = (encR || !r_ok[2]) ? 1 : 0;
-    int encL3 = (encL || !l_ok[3]) ? 1 : 0;
-    int encR3 = (encR || !r_ok[3]) ? 1 : 0;
-
-    audio_mix_interleave_stereo_f32(lf[0], rf[0], 160, encL0, encR0, stereo_samp1);
-    audio_mix_interleave_stereo_f32(lf[1], rf[1], 160, encL1, encR1, stereo_samp2);
-    audio_mix_interleave_stereo_f32(lf[2], rf[2], 160, encL2, encR2, stereo_samp3);
-    audio_mix_interleave_stereo_f32(lf[3], rf[3], 160, encL3, encR3, stereo_samp4);
-
-    // If exactly one slot is active (the other enc-muted), duplicate the
-    // active slot onto both channels so users with stereo sinks hear it.
-    if (!encL && encR) {
-        for (i = 0; i < 320; i += 2) {
-            stereo_samp1[i + 1] = stereo_samp1[i + 0];
-            stereo_samp2[i + 1] = stereo_samp2[i + 0];
-            stereo_samp3[i + 1] = stereo_samp3[i + 0];
-            stereo_samp4[i + 1] = stereo_samp4[i + 0];
+    // Interleave each frame span; if exactly one slot is active (the other
+    // enc-muted), it goes onto both channels so users with stereo sinks hear it.
+    float* stereo_out[4] = {stereo_samp1, stereo_samp2, stereo_samp3, stereo_samp4};
+    for (int j = 0; j < 4; j++) {
+        int encLj = (encL || !l_ok[j]) ? 1 : 0;
+        int encRj = (encR || !r_ok[j]) ? 1 : 0;
+        if (!encL && encR) {
+            audio_mix_interleave_stereo_f32(lf[j], lf[j], 160, encLj, encLj, stereo_out[j]);
+        } else if (encL && !encR) {
+            audio_mix_interleave_stereo_f32(rf[j], rf[j], 160, encRj, encRj, stereo_out[j]);
+        } else {
+            audio_mix_interleave_stereo_f32(lf[j], rf[j], 160, encLj, encRj, stereo_out[j]);
         }
+    }
+    if (!encL && encR) {
         encR = 0; // treat as stereo-duplicated
     } else if (encL && !encR) {
-        for (i = 0; i < 320; i += 2) {
-            stereo_samp1[i + 0] = stereo_samp1[i + 1];
-            stereo_samp2[i + 0] = stereo_samp2[i + 1];
-            stereo_samp3[i + 0] = stereo_samp3[i + 1];
-            stereo_samp4[i + 0] = stereo_samp4[i + 1];
-        }
         encL = 0; // treat as stereo-duplicated
     }
 
@@ -952,6 +939,11 @@ playSynthesizedVoiceSS(dsd_opts* opts, dsd_state* state) {
 
     (void)dsd_audio_group_gate_mono(opts, state, TGL, encL, &encL);
 
+    //frame staged for the synth worker: it synthesizes, filters and plays it
+    if (dsd_synth_pipeline_commit(state, 0, encL)) {
+        goto SSM_END;
+    }
+
     //test hpf
     if (opts->use_hpf_d == 1) {
         hpf_dL(state, state->s_l, 160);
@@ -1822,6 +1814,13 @@ playSynthesizedVoiceSS_P25P2(dsd_opts* opts, dsd_state* state) {
     unsigned long TGR = (unsigned long)state->lasttgR;
     (void)dsd_audio_group_gate_dual(opts, state, TGL, TGR, encL, encR, &encL, &encR);
 
+    // Frame staged for the synth worker: hand over the mute decision and skip inline output
+    int muted = (opts->slot1_on == 0 && opts->slot2_on == 0) || (state->currentslot == 0 && encL)
+                || (state->currentslot == 1 && encR);
+    if (dsd_synth_pipeline_commit(state, state->currentslot, muted)) {
+        return;
+    }
+
     // Both slots off - skip output
     if (opts->slot1_on == 0 && opts->slot2_on == 0) {
         return;
@@ -1915,6 +1914,13 @@ playSynthesizedVoiceSS_DMR(dsd_opts* opts, dsd_state* state) {
 
     (void)dsd_audio_group_gate_dual(opts, state, TGL, TGR, encL, encR, &encL, &encR);
 
+    // Frame staged for the synth worker: hand over the mute decision and skip inline output
+    int muted = (opts->slot1_on == 0 && opts->slot2_on == 0) || (state->currentslot == 0 && encL)
+                || (state->currentslot == 1 && encR);
+    if (dsd_synth_pipeline_commit(state, state->currentslot, muted)) {
+        return;
+    }
+
     // Both slots off - skip output
     if (opts->slot1_on == 0 && opts->slot2_on == 0) {
         return;
@@ -1,74 +1,137 @@
 // SPDX-License-Identifier: ISC
 /*-------------------------------------------------------------------------------
  * dsd_upsample.c
- * Simplified 8k to 48k Upsample Functions
- * Uses linear interpolation for smooth transitions without ringing.
+ * 8k to 48k Polyphase Upsampler
  *
+ * The prototype is a 96-tap Kaiser-windowed sinc (beta 7, cutoff 4 kHz at
+ * 48 kHz) split into six 16-tap branches, one per output phase. Each branch
+ * is normalized to unity DC gain so the output level matches the input and
+ * no 8 kHz tone leaks through. Passband is flat to 3 kHz (-0.7 dB at
+ * 3.4 kHz); the first image band is down ~49 dB from 5 kHz.
  *
+ * Coefficients are stored tap-major with the six phases padded to eight
+ * lanes, so each input sample yields all six outputs from two 4-lane
+ * multiply-accumulates per tap (SSE2 on x86-64, NEON on ARM, scalar
+ * otherwise).
  *
  * LWVMOBILE
  * 2024-03 DSD-FME Florida Man Edition
  *-----------------------------------------------------------------------------*/
 
-#include <dsd-neo/core/audio.h>
-#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/upsample.h>
 
-// Produce 6 short samples (48k) for every 1 short sample (8k)
-// Uses linear interpolation between prev and invalue for smoother output.
-// Interpolation coefficients: [0/6, 1/6, 2/6, 3/6, 4/6, 5/6] from prev to invalue
-// The sample at coefficient 6/6 (= invalue) is the first sample of the next call.
-void
-upsampleS(short invalue, short prev, short outbuf[6]) {
-    // Linear interpolation from prev toward invalue
-    // outbuf[i] = prev + (invalue - prev) * (i / 6)
-    float diff = (float)(invalue - prev);
-    outbuf[0] = prev;                                 // 0/6 = prev
-    outbuf[1] = (short)(prev + diff * (1.0f / 6.0f)); // 1/6
-    outbuf[2] = (short)(prev + diff * (2.0f / 6.0f)); // 2/6
-    outbuf[3] = (short)(prev + diff * (3.0f / 6.0f)); // 3/6
-    outbuf[4] = (short)(prev + diff * (4.0f / 6.0f)); // 4/6
-    outbuf[5] = (short)(prev + diff * (5.0f / 6.0f)); // 5/6
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DSD_UPSAMPLE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define DSD_UPSAMPLE_NEON 1
+#endif
+
+/* k_upsample_taps[k][p] = h[6k + p]; columns 6 and 7 are padding. */
+static const float k_upsample_taps[DSD_UPSAMPLE_TAPS][8] = {
+    {-6.172733910e-05f, -2.720678685e-04f, -5.520170817e-04f, -7.777055413e-04f, -7.726744128e-04f, -3.731630892e-04f, 0.0f, 0.0f},
+    {4.815494855e-04f, 1.667251539e-03f, 2.842665159e-03f, 3.502414418e-03f, 3.123741744e-03f, 1.379293752e-03f, 0.0f, 0.0f},
+    {-1.649436845e-03f, -5.347034175e-03f, -8.605724899e-03f, -1.007478578e-02f, -8.584398505e-03f, -3.637849035e-03f, 0.0f, 0.0f},
+    {4.191581854e-03f, 1.313679685e-02f, 2.050241962e-02f, 2.333811013e-02f, 1.938280865e-02f, 8.024370811e-03f, 0.0f, 0.0f},
+    {-9.051575830e-03f, -2.782861745e-02f, -4.268847237e-02f, -4.785292859e-02f, -3.921320992e-02f, -1.604915387e-02f, 0.0f, 0.0f},
+    {1.793401643e-02f, 5.473908578e-02f, 8.355761540e-02f, 9.344918080e-02f, 7.662211429e-02f, 3.148330207e-02f, 0.0f, 0.0f},
+    {-3.545812948e-02f, -1.095948095e-01f, -1.703896680e-01f, -1.955065434e-01f, -1.660248123e-01f, -7.155527899e-02f, 0.0f, 0.0f},
+    {8.604593486e-02f, 2.915044877e-01f, 5.179044216e-01f, 7.313510185e-01f, 8.974613376e-01f, 9.882962652e-01f, 0.0f, 0.0f},
+    {9.882962652e-01f, 8.974613376e-01f, 7.313510185e-01f, 5.179044216e-01f, 2.915044877e-01f, 8.604593486e-02f, 0.0f, 0.0f},
+    {-7.155527899e-02f, -1.660248123e-01f, -1.955065434e-01f, -1.703896680e-01f, -1.095948095e-01f, -3.545812948e-02f, 0.0f, 0.0f},
+    {3.148330207e-02f, 7.662211429e-02f, 9.344918080e-02f, 8.355761540e-02f, 5.473908578e-02f, 1.793401643e-02f, 0.0f, 0.0f},
+    {-1.604915387e-02f, -3.921320992e-02f, -4.785292859e-02f, -4.268847237e-02f, -2.782861745e-02f, -9.051575830e-03f, 0.0f, 0.0f},
+    {8.024370811e-03f, 1.938280865e-02f, 2.333811013e-02f, 2.050241962e-02f, 1.313679685e-02f, 4.191581854e-03f, 0.0f, 0.0f},
+    {-3.637849035e-03f, -8.584398505e-03f, -1.007478578e-02f, -8.605724899e-03f, -5.347034175e-03f, -1.649436845e-03f, 0.0f, 0.0f},
+    {1.379293752e-03f, 3.123741744e-03f, 3.502414418e-03f, 2.842665159e-03f, 1.667251539e-03f, 4.815494855e-04f, 0.0f, 0.0f},
+    {-3.731630892e-04f, -7.726744128e-04f, -7.777055413e-04f, -5.520170817e-04f, -2.720678685e-04f, -6.172733910e-05f, 0.0f, 0.0f},
+};
+
+/* Input samples handled per pass of the scratch window. */
+#define UPSAMPLE_CHUNK 160
+
+/* All six output phases for the input sample at `newest` (history behind it). */
+static inline void
+upsample_one(const float* newest, float out[DSD_UPSAMPLE_FACTOR]) {
+#if defined(DSD_UPSAMPLE_SSE2)
+    /* Even and odd taps accumulate separately to halve the add dependency chains */
+    __m128 lo0 = _mm_setzero_ps();
+    __m128 hi0 = _mm_setzero_ps();
+    __m128 lo1 = _mm_setzero_ps();
+    __m128 hi1 = _mm_setzero_ps();
+    for (int k = 0; k < DSD_UPSAMPLE_TAPS; k += 2) {
+        const __m128 x0 = _mm_set1_ps(newest[-k]);
+        const __m128 x1 = _mm_set1_ps(newest[-k - 1]);
+        lo0 = _mm_add_ps(lo0, _mm_mul_ps(_mm_loadu_ps(&k_upsample_taps[k][0]), x0));
+        hi0 = _mm_add_ps(hi0, _mm_mul_ps(_mm_loadu_ps(&k_upsample_taps[k][4]), x0));
+        lo1 = _mm_add_ps(lo1, _mm_mul_ps(_mm_loadu_ps(&k_upsample_taps[k + 1][0]), x1));
+        hi1 = _mm_add_ps(hi1, _mm_mul_ps(_mm_loadu_ps(&k_upsample_taps[k + 1][4]), x1));
+    }
+    _mm_storeu_ps(out, _mm_add_ps(lo0, lo1));
+    _mm_storel_pi((__m64*)&out[4], _mm_add_ps(hi0, hi1));
+#elif defined(DSD_UPSAMPLE_NEON)
+    float32x4_t lo0 = vdupq_n_f32(0.0f);
+    float32x4_t hi0 = vdupq_n_f32(0.0f);
+    float32x4_t lo1 = vdupq_n_f32(0.0f);
+    float32x4_t hi1 = vdupq_n_f32(0.0f);
+    for (int k = 0; k < DSD_UPSAMPLE_TAPS; k += 2) {
+        const float x0 = newest[-k];
+        const float x1 = newest[-k - 1];
+        lo0 = vmlaq_n_f32(lo0, vld1q_f32(&k_upsample_taps[k][0]), x0);
+        hi0 = vmlaq_n_f32(hi0, vld1q_f32(&k_upsample_taps[k][4]), x0);
+        lo1 = vmlaq_n_f32(lo1, vld1q_f32(&k_upsample_taps[k + 1][0]), x1);
+        hi1 = vmlaq_n_f32(hi1, vld1q_f32(&k_upsample_taps[k + 1][4]), x1);
+    }
+    vst1q_f32(out, vaddq_f32(lo0, lo1));
+    vst1_f32(&out[4], vget_low_f32(vaddq_f32(hi0, hi1)));
+#else
+    float acc[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    for (int k = 0; k < DSD_UPSAMPLE_TAPS; k++) {
+        const float x = newest[-k];
+        for (int p = 0; p < 8; p++) {
+            acc[p] += k_upsample_taps[k][p] * x;
+        }
+    }
+    memcpy(out, acc, DSD_UPSAMPLE_FACTOR * sizeof(float));
+#endif
 }
 
-// Float version: produce 6 float samples for every 1 float sample.
-// Uses linear interpolation for smooth output.
 void
-upsampleF(float invalue, float prev, float outbuf[6]) {
-    float diff = invalue - prev;
-    outbuf[0] = prev;                        // 0/6 = prev
-    outbuf[1] = prev + diff * (1.0f / 6.0f); // 1/6
-    outbuf[2] = prev + diff * (2.0f / 6.0f); // 2/6
-    outbuf[3] = prev + diff * (3.0f / 6.0f); // 3/6
-    outbuf[4] = prev + diff * (4.0f / 6.0f); // 4/6
-    outbuf[5] = prev + diff * (5.0f / 6.0f); // 5/6
+dsd_upsampler_reset(dsd_upsampler* us) {
+    if (us) {
+        memset(us->hist, 0, sizeof(us->hist));
+    }
 }
 
-// Legacy 6x simplified version for the float_buf_p (sample repetition)
-// Maintained for backward compatibility where interpolation isn't desired.
 void
-upsample(dsd_state* state, float invalue) {
-
-    if (!state) {
+dsd_upsample_8k_48k(dsd_upsampler* us, const float* in, size_t n, float* out) {
+    if (!us || !in || !out) {
         return;
     }
 
-    float* outbuf1 = state->audio_out_float_buf_p;
-    if (state->dmr_stereo == 1) {
-        outbuf1 = (state->currentslot == 1) ? state->audio_out_float_buf_pR : state->audio_out_float_buf_p;
-    }
-    if (!outbuf1) {
-        return; // nothing to write to
+    /* Window = history followed by the current chunk, oldest first */
+    float win[(DSD_UPSAMPLE_TAPS - 1) + UPSAMPLE_CHUNK];
+    memcpy(win, us->hist, sizeof(us->hist));
+
+    while (n > 0) {
+        size_t m = (n < UPSAMPLE_CHUNK) ? n : UPSAMPLE_CHUNK;
+        memcpy(&win[DSD_UPSAMPLE_TAPS - 1], in, m * sizeof(float));
+
+        for (size_t i = 0; i < m; i++) {
+            /* x[i - k] for k = 0..15 is newest[-k] */
+            const float* newest = &win[i + (DSD_UPSAMPLE_TAPS - 1)];
+            upsample_one(newest, out);
+            out += DSD_UPSAMPLE_FACTOR;
+        }
+
+        /* Slide the last TAPS-1 samples down as history for the next chunk */
+        memmove(win, &win[m], sizeof(us->hist));
+        in += m;
+        n -= m;
     }
 
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
+    memcpy(us->hist, win, sizeof(us->hist));
 }
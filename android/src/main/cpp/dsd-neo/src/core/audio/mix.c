@@ -15,15 +15,39 @@
 
 #include <stddef.h>
 
+/*
+ * Mute flags and slot selection are resolved once per call, so each inner
+ * loop is a plain copy/scale/average with no per-sample branches. Loops walk
+ * four samples at a time (scalar tail for the rest) so the compiler keeps
+ * them in SSE/NEON registers at -O2.
+ */
+#define MIX_LANES 4
+
 void
 audio_mix_interleave_stereo_f32(const float* left, const float* right, size_t n, int encL, int encR,
                                 float* stereo_out) {
     if (!stereo_out || !left || !right) {
         return;
     }
-    for (size_t i = 0; i < n; i++) {
-        stereo_out[i * 2 + 0] = encL ? 0.0f : left[i];
-        stereo_out[i * 2 + 1] = encR ? 0.0f : right[i];
+    const float gl = encL ? 0.0f : 1.0f;
+    const float gr = encR ? 0.0f : 1.0f;
+    size_t i = 0;
+    for (; i + MIX_LANES <= n; i += MIX_LANES) {
+        // Load the whole group before storing so overlapping buffers can't serialize it
+        float l4[MIX_LANES];
+        float r4[MIX_LANES];
+        for (int l = 0; l < MIX_LANES; l++) {
+            l4[l] = gl * left[i + l];
+            r4[l] = gr * right[i + l];
+        }
+        for (int l = 0; l < MIX_LANES; l++) {
+            stereo_out[(i + l) * 2 + 0] = l4[l];
+            stereo_out[(i + l) * 2 + 1] = r4[l];
+        }
+    }
+    for (; i < n; i++) {
+        stereo_out[i * 2 + 0] = gl * left[i];
+        stereo_out[i * 2 + 1] = gr * right[i];
     }
 }
 
@@ -33,9 +57,24 @@ audio_mix_interleave_stereo_s16(const short* left, const short* right, size_t n,
     if (!stereo_out || !left || !right) {
         return;
     }
-    for (size_t i = 0; i < n; i++) {
-        stereo_out[i * 2 + 0] = encL ? 0 : left[i];
-        stereo_out[i * 2 + 1] = encR ? 0 : right[i];
+    const short ml = encL ? 0 : (short)-1;
+    const short mr = encR ? 0 : (short)-1;
+    size_t i = 0;
+    for (; i + MIX_LANES <= n; i += MIX_LANES) {
+        short l4[MIX_LANES];
+        short r4[MIX_LANES];
+        for (int l = 0; l < MIX_LANES; l++) {
+            l4[l] = (short)(left[i + l] & ml);
+            r4[l] = (short)(right[i + l] & mr);
+        }
+        for (int l = 0; l < MIX_LANES; l++) {
+            stereo_out[(i + l) * 2 + 0] = l4[l];
+            stereo_out[(i + l) * 2 + 1] = r4[l];
+        }
+    }
+    for (; i < n; i++) {
+        stereo_out[i * 2 + 0] = (short)(left[i] & ml);
+        stereo_out[i * 2 + 1] = (short)(right[i] & mr);
     }
 }
 
@@ -44,15 +83,20 @@ audio_mix_mono_from_slots_f32(const float* left, const float* right, size_t n, i
     if (!mono_out || !left || !right) {
         return;
     }
-    for (size_t i = 0; i < n; i++) {
-        if (l_on && !r_on) {
-            mono_out[i] = left[i];
-        } else if (!l_on && r_on) {
-            mono_out[i] = right[i];
-        } else if (l_on && r_on) {
-            mono_out[i] = 0.5f * (left[i] + right[i]);
-        } else {
-            mono_out[i] = 0.0f;
+    // Both on: average; one on: copy it (weights 1/0); none: silence (0/0)
+    const float wl = l_on ? (r_on ? 0.5f : 1.0f) : 0.0f;
+    const float wr = r_on ? (l_on ? 0.5f : 1.0f) : 0.0f;
+    size_t i = 0;
+    for (; i + MIX_LANES <= n; i += MIX_LANES) {
+        float m4[MIX_LANES];
+        for (int l = 0; l < MIX_LANES; l++) {
+            m4[l] = (wl * left[i + l]) + (wr * right[i + l]);
         }
+        for (int l = 0; l < MIX_LANES; l++) {
+            mono_out[i + l] = m4[l];
+        }
+    }
+    for (; i < n; i++) {
+        mono_out[i] = (wl * left[i]) + (wr * right[i]);
     }
 }
@@ -34,6 +34,7 @@
 #include <dsd-neo/protocol/p25/p25p1_const.h> //for imbe fr (7200)
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/log.h>
+#include <dsd-neo/runtime/symbol_file.h>
 
 #include <mbelib.h>
 #include <sndfile.h>
@@ -684,13 +685,13 @@ void
 openSymbolOutFile(dsd_opts* opts, dsd_state* state) {
     closeSymbolOutFile(opts, state);
     opts->symbol_out_f = fopen(opts->symbol_out_file, "w");
+    dsd_symbol_out_begin(opts, state);
 }
 
 void
 closeSymbolOutFile(dsd_opts* opts, dsd_state* state) {
-    UNUSED(state);
-
     if (opts->symbol_out_f) {
+        dsd_symbol_out_end(state);
         fclose(opts->symbol_out_f);
         opts->symbol_out_f = NULL;
     }
@@ -135,8 +135,10 @@ csvChanImport(dsd_opts* opts, dsd_state* state) //channel map import
             }
 
             if (field_count == 1) {
-                if (chan_number >= 0 && chan_number < 0xFFFF) {
-                    sscanf(field, "%ld", &state->trunk_chan_map[chan_number]);
+                long int chan_freq = 0;
+                if (chan_number >= 0 && chan_number <= DSD_CHAN_MAP_MAX_CHANNEL && sscanf(field, "%ld", &chan_freq) == 1
+                    && dsd_chan_map_set(&state->trunk_chan_map, chan_number, chan_freq) != 0) {
+                    LOG_WARNING("Channel map full; channel %ld not imported.\n", chan_number);
                 }
                 // adding this should be compatible with EDACS, test and obsolete the LCN Import function if desired
                 if (state->lcn_freq_count >= 0
@@ -150,8 +152,8 @@ csvChanImport(dsd_opts* opts, dsd_state* state) //channel map import
             field = strtok(NULL, ",");
             field_count++;
         }
-        if (field_count >= 2 && chan_number >= 0 && chan_number < 0xFFFF) {
-            LOG_INFO("Channel [%05ld] [%09ld]", chan_number, state->trunk_chan_map[chan_number]);
+        if (field_count >= 2 && chan_number >= 0 && chan_number <= DSD_CHAN_MAP_MAX_CHANNEL) {
+            LOG_INFO("Channel [%05ld] [%09ld]", chan_number, dsd_chan_map_get(&state->trunk_chan_map, chan_number));
         }
         LOG_INFO("\n");
     }
@@ -27,6 +27,7 @@
 #include <dsd-neo/platform/timing.h>
 #include <dsd-neo/runtime/comp.h>
 #include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/symbol_file.h>
 #ifdef USE_RTLSDR
 #include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
 #endif
@@ -267,6 +268,16 @@ cqpsk_slice(float symbol) {
     return dibit;
 }
 
+/* Capture replay yields per symbol unless DSD_NEO_SYMBOL_FAST asks for full speed. */
+static inline int
+symbol_replay_throttled(const dsd_state* state) {
+    if (state->use_throttle != 1) {
+        return 0;
+    }
+    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
+    return !(cfg && cfg->symbol_fast_enable);
+}
+
 /*
  * CQPSK slicer with optional debug inversion for sync alignment.
  *
@@ -274,12 +285,8 @@ cqpsk_slice(float symbol) {
  * by the differential Costas loop.
  */
 static inline int
-cqpsk_slice_aligned(float symbol) {
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    if (!cfg) {
-        dsd_neo_config_init(NULL);
-        cfg = dsd_neo_get_config();
-    }
+cqpsk_slice_aligned(float symbol, dsd_state* state) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_config_cached(&state->rt_cfg, NULL);
     int inv = (cfg && cfg->cqpsk_sync_inv) ? 1 : 0;
     int negate = (cfg && cfg->cqpsk_sync_neg) ? 1 : 0;
 
@@ -482,17 +489,12 @@ is_cqpsk_active(dsd_opts* opts) {
 #ifdef USE_RTLSDR
 /* Optional histogram of CQPSK slicer output during decoding. */
 static void
-debug_log_cqpsk_slice(int dibit, float symbol, const dsd_state* state) {
+debug_log_cqpsk_slice(int dibit, float symbol, dsd_state* state) {
     static int hist[4] = {0, 0, 0, 0};
     static int sample_count = 0;
     static float sym_min = 1e9f, sym_max = -1e9f, sym_sum = 0.0f;
-    (void)state;
 
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    if (!cfg) {
-        dsd_neo_config_init(NULL);
-        cfg = dsd_neo_get_config();
-    }
+    const dsdneoRuntimeConfig* cfg = dsd_neo_config_cached(&state->rt_cfg, NULL);
     if (!cfg || !cfg->debug_cqpsk_enable) {
         return;
     }
@@ -523,7 +525,7 @@ debug_log_cqpsk_slice(int dibit, float symbol, const dsd_state* state) {
 }
 #else
 static inline void
-debug_log_cqpsk_slice(int dibit, float symbol, const dsd_state* state) {
+debug_log_cqpsk_slice(int dibit, float symbol, dsd_state* state) {
     UNUSED3(dibit, symbol, state);
 }
 #endif
@@ -604,7 +606,7 @@ digitize(dsd_opts* opts, dsd_state* state, float symbol) {
                 || state->lastsynctype == DSD_SYNC_P25P2_NEG);
         if (want_cqpsk_slice) {
             float sym = symbol - state->center; /* remove DC bias before fixed-threshold slice */
-            dibit = cqpsk_slice_aligned(sym);
+            dibit = cqpsk_slice_aligned(sym, state);
             valid = 1;
             debug_log_cqpsk_slice(dibit, symbol, state);
         }
@@ -681,7 +683,7 @@ digitize(dsd_opts* opts, dsd_state* state, float symbol) {
                 || state->lastsynctype == DSD_SYNC_P25P2_POS);
         if (want_cqpsk_slice) {
             float sym = symbol - state->center; /* remove DC bias before fixed-threshold slice */
-            dibit = cqpsk_slice_aligned(sym);
+            dibit = cqpsk_slice_aligned(sym, state);
             valid = 1;
             debug_log_cqpsk_slice(dibit, symbol, state);
         }
@@ -766,7 +768,7 @@ get_dibit_and_analog_signal(dsd_opts* opts, dsd_state* state, int* out_analog_si
     if (opts->audio_in_type == AUDIO_IN_SYMBOL_BIN) {
         //assign dibit from last symbol/dibit read from capture bin
         dibit = state->symbolc;
-        if (state->use_throttle == 1) {
+        if (symbol_replay_throttled(state)) {
             dsd_sleep_ms(0); /* yield CPU */
         }
     }
@@ -774,7 +776,7 @@ get_dibit_and_analog_signal(dsd_opts* opts, dsd_state* state, int* out_analog_si
     //symbol/dibit file capture/writing
     if (opts->symbol_out_f) {
         //fprintf (stderr, "%d", dibit);
-        fputc(dibit, opts->symbol_out_f);
+        dsd_symbol_out_put(opts, state, dibit);
     }
 
 #ifdef TRACE_DSD
@@ -856,13 +858,13 @@ getDibitAndSoftSymbol(dsd_opts* opts, dsd_state* state, float* out_soft_symbol)
 
     if (opts->audio_in_type == AUDIO_IN_SYMBOL_BIN) {
         dibit = state->symbolc;
-        if (state->use_throttle == 1) {
+        if (symbol_replay_throttled(state)) {
             dsd_sleep_ms(0); /* yield CPU */
         }
     }
 
     if (opts->symbol_out_f) {
-        fputc(dibit, opts->symbol_out_f);
+        dsd_symbol_out_put(opts, state, dibit);
     }
 
     if (out_soft_symbol != NULL) {
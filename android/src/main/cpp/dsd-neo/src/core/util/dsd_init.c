@@ -164,6 +164,7 @@ initOpts(dsd_opts* opts) {
     opts->rtl_needs_restart = 0;
     opts->rtl_pwr = 0;                // mean power approximation level on rtl input signal
     opts->rtl_bias_tee = 0;           // bias tee disabled by default
+    opts->rtl_external_iq = 0;        // no in-process IQ producer by default
     opts->rtl_auto_ppm = 0;           // spectrum-based auto PPM disabled by default
     opts->rtl_auto_ppm_snr_db = 0.0f; // use default SNR threshold unless overridden
     //end RTL user options
@@ -486,6 +487,8 @@ initState(dsd_state* state) {
     state->aout_gain = 25.0f;
     state->aout_gainR = 25.0f;
     state->aout_gainA = 0.0f; //use purely as a display or internal value, no user setting
+    dsd_upsampler_reset(&state->upsample_l);
+    dsd_upsampler_reset(&state->upsample_r);
     memset(state->aout_max_buf, 0, sizeof(float) * 200);
     state->aout_max_buf_p = state->aout_max_buf;
     state->aout_max_buf_idx = 0;
@@ -589,6 +592,7 @@ initState(dsd_state* state) {
     state->DMRvcR = 0;
     state->dropL = 256;
     state->dropR = 256;
+    memset(state->rc4_voice, 0, sizeof(state->rc4_voice));
 
     state->tyt_ap = 0;
     state->tyt_bp = 0;
@@ -750,7 +754,9 @@ initState(dsd_state* state) {
 
     //trunking
     memset(state->trunk_lcn_freq, 0, sizeof(state->trunk_lcn_freq));
-    memset(state->trunk_chan_map, 0, sizeof(state->trunk_chan_map));
+    dsd_chan_map_clear(&state->trunk_chan_map);
+    dsd_unit_registry_init(&state->p25_aff, DSD_P25_AFF_MAX_ENTRIES);
+    dsd_unit_registry_init(&state->p25_ga, DSD_P25_GA_MAX_ENTRIES);
     state->group_tally = 0;
     state->lcn_freq_count = 0; //number of frequncies imported as an enumerated lcn list
     state->lcn_freq_roll = 0;  //needs reset if sync is found?
@@ -967,6 +973,9 @@ freeState(dsd_state* state) {
     free(state->event_history_s);
     state->event_history_s = NULL;
 
+    dsd_unit_registry_free(&state->p25_aff);
+    dsd_unit_registry_free(&state->p25_ga);
+
     dsd_aligned_free(state->audio_out_buf);
     state->audio_out_buf = NULL;
     state->audio_out_buf_p = NULL;
@@ -195,19 +195,14 @@ resetState(dsd_state* state) {
     state->p25_p2_rs_ess_corr = 0;
 
     // Reset P25 affiliation table
-    state->p25_aff_count = 0;
-    memset(state->p25_aff_rid, 0, sizeof(state->p25_aff_rid));
-    memset(state->p25_aff_last_seen, 0, sizeof(state->p25_aff_last_seen));
+    dsd_unit_registry_clear(&state->p25_aff);
 
     // Reset P25 CC/system TDMA hints
     state->p25_cc_is_tdma = 0;
     state->p25_sys_is_tdma = 0;
 
     // Reset P25 Group Affiliation table
-    state->p25_ga_count = 0;
-    memset(state->p25_ga_rid, 0, sizeof(state->p25_ga_rid));
-    memset(state->p25_ga_tg, 0, sizeof(state->p25_ga_tg));
-    memset(state->p25_ga_last_seen, 0, sizeof(state->p25_ga_last_seen));
+    dsd_unit_registry_clear(&state->p25_ga);
 }
 
 //simple function to reset the dibit buffer
@@ -29,6 +29,7 @@
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/core/synth_pipeline.h>
 #include <dsd-neo/crypto/aes.h>
 #include <dsd-neo/crypto/des.h>
 #include <dsd-neo/crypto/pc4.h>
@@ -49,45 +50,37 @@
 //NOTE: This set of functions will be reorganized and simplified (hopefully) or at least
 //a more logical flow will be established to jive with the new audio handling
 
-void
-keyring(dsd_opts* opts, dsd_state* state) {
-    UNUSED(opts);
-
-    if (state->currentslot == 0) {
-        state->R = state->rkey_array[state->payload_keyid];
-    }
+/* Load the short key and the four AES key words for `keyid` into one slot. */
+static void
+keyring_load_slot(dsd_state* state, int slot, int keyid) {
+    const unsigned long long int* rk = state->rkey_array;
 
-    if (state->currentslot == 1) {
-        state->RR = state->rkey_array[state->payload_keyidR];
+    if (slot == 0) {
+        state->R = rk[keyid];
+    } else {
+        state->RR = rk[keyid];
     }
 
     //load any large keys (AES)
+    state->A1[slot] = rk[keyid + 0x000];
+    state->A2[slot] = rk[keyid + 0x101];
+    state->A3[slot] = rk[keyid + 0x201];
+    state->A4[slot] = rk[keyid + 0x301];
+
+    //check to see if there is a value loaded or not
+    state->aes_key_loaded[slot] = (state->A1[slot] | state->A2[slot] | state->A3[slot] | state->A4[slot]) != 0;
+}
+
+void
+keyring(dsd_opts* opts, dsd_state* state) {
+    UNUSED(opts);
+
     if (state->currentslot == 0) {
-        state->A1[0] = state->rkey_array[state->payload_keyid + 0x000];
-        state->A2[0] = state->rkey_array[state->payload_keyid + 0x101];
-        state->A3[0] = state->rkey_array[state->payload_keyid + 0x201];
-        state->A4[0] = state->rkey_array[state->payload_keyid + 0x301];
-
-        //check to see if there is a value loaded or not
-        if (state->A1[0] == 0 && state->A2[0] == 0 && state->A3[0] == 0 && state->A4[0] == 0) {
-            state->aes_key_loaded[0] = 0;
-        } else {
-            state->aes_key_loaded[0] = 1;
-        }
+        keyring_load_slot(state, 0, state->payload_keyid);
     }
 
     if (state->currentslot == 1) {
-        state->A1[1] = state->rkey_array[state->payload_keyidR + 0x000];
-        state->A2[1] = state->rkey_array[state->payload_keyidR + 0x101];
-        state->A3[1] = state->rkey_array[state->payload_keyidR + 0x201];
-        state->A4[1] = state->rkey_array[state->payload_keyidR + 0x301];
-
-        //check to see if there is a value loaded or not
-        if (state->A1[1] == 0 && state->A2[1] == 0 && state->A3[1] == 0 && state->A4[1] == 0) {
-            state->aes_key_loaded[1] = 0;
-        } else {
-            state->aes_key_loaded[1] = 1;
-        }
+        keyring_load_slot(state, 1, state->payload_keyidR);
     }
 }
 
@@ -203,6 +196,19 @@ playMbeFiles(dsd_opts* opts, dsd_state* state, int argc, char** argv) {
     }
 }
 
+// Frame handed to the synth pipeline: leave silence for the inline audio path and
+// keep the error string meaningful (no repeat/mute markers, those are decided later).
+static void
+synth_staged_placeholder(float* audio_out_temp_buf, char* err_str, int errs2) {
+    int n = errs2 < 0 ? 0 : errs2;
+    if (n > 63) {
+        n = 63;
+    }
+    memset(audio_out_temp_buf, 0, 160 * sizeof(float));
+    memset(err_str, '=', (size_t)n);
+    err_str[n] = 0;
+}
+
 void
 processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe_fr[4][24], char imbe7100_fr[7][24]) {
 
@@ -406,7 +412,7 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
                 }
             }
 
-            rc4_voice_decrypt(state->dropL, 13, 11, rckey, cipher, plain);
+            rc4_stream_decrypt(&state->rc4_voice[0], state->dropL, 13, 11, rckey, cipher, plain);
             state->dropL += 11;
 
             z = 0;
@@ -419,8 +425,12 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
             }
         }
 
-        mbe_processImbe4400Dataf(state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, imbe_d,
-                                 state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+        if (dsd_synth_pipeline_stage(opts, state, 0, DSD_SYNTH_IMBE_4400, imbe_d, state->errs, state->errs2)) {
+            synth_staged_placeholder(state->audio_out_temp_buf, state->err_str, state->errs2);
+        } else {
+            mbe_processImbe4400Dataf(state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, imbe_d,
+                                     state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+        }
         if (DSD_SYNC_IS_P25P1(state->synctype)) {
             int len = state->p25_p1_voice_err_hist_len > 0 ? state->p25_p1_voice_err_hist_len : 50;
             if (len > (int)sizeof(state->p25_p1_voice_err_hist)) {
@@ -862,7 +872,7 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
                 //this occurs because we are supposed to either have a a 'repeat' frame, or 'silent' frame play
                 //due to the error, but the keystream application makes it random 'pfft pop' sound instead
                 if (state->errs < 3) {
-                    rc4_voice_decrypt(state->dropL, 9, 7, rckey, cipher, plain);
+                    rc4_stream_decrypt(&state->rc4_voice[0], state->dropL, 9, 7, rckey, cipher, plain);
                 } else {
                     memcpy(plain, cipher, sizeof(plain));
                 }
@@ -903,7 +913,7 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
                 //pack cipher byte array from ambe_d bit array
                 pack_ambe(ambe_d, cipher, 49);
 
-                rc4_voice_decrypt(state->dropL, 13, 7, rckey, cipher, plain);
+                rc4_stream_decrypt(&state->rc4_voice[0], state->dropL, 13, 7, rckey, cipher, plain);
                 state->dropL += 7;
 
                 //unpack deciphered plain array back into ambe_d bit array
@@ -981,8 +991,14 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
                 }
             }
 
-            mbe_processAmbe2450Dataf(state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, ambe_d,
-                                     state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+            if ((DSD_SYNC_IS_P25P2(state->synctype) || DSD_SYNC_IS_DMR(state->synctype))
+                && dsd_synth_pipeline_stage(opts, state, 0, DSD_SYNTH_AMBE_2450, ambe_d, state->errs, state->errs2)) {
+                synth_staged_placeholder(state->audio_out_temp_buf, state->err_str, state->errs2);
+            } else {
+                mbe_processAmbe2450Dataf(state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
+                                         ambe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced,
+                                         opts->uvquality);
+            }
             if (DSD_SYNC_IS_P25P2(state->synctype)) {
                 int len2 = state->p25_p2_voice_err_hist_len > 0 ? state->p25_p2_voice_err_hist_len : 50;
                 if (len2 > 64) {
@@ -1273,7 +1289,7 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
                 //this occurs because we are supposed to either have a a 'repeat' frame, or 'silent' frame play
                 //due to the error, but the keystream application makes it random 'pfft pop' sound instead
                 if (state->errsR < 3) {
-                    rc4_voice_decrypt(state->dropR, 9, 7, rckey, cipher, plain);
+                    rc4_stream_decrypt(&state->rc4_voice[1], state->dropR, 9, 7, rckey, cipher, plain);
                 } else {
                     memcpy(plain, cipher, sizeof(plain));
                 }
@@ -1313,7 +1329,7 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
                 //pack cipher byte array from ambe_d bit array
                 pack_ambe(ambe_d, cipher, 49);
 
-                rc4_voice_decrypt(state->dropR, 13, 7, rckey, cipher, plain);
+                rc4_stream_decrypt(&state->rc4_voice[1], state->dropR, 13, 7, rckey, cipher, plain);
                 state->dropR += 7;
 
                 //unpack deciphered plain array back into ambe_d bit array
@@ -1391,8 +1407,15 @@ processMbeFrame(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], char ambe
                 }
             }
 
-            mbe_processAmbe2450Dataf(state->audio_out_temp_bufR, &state->errsR, &state->errs2R, state->err_strR, ambe_d,
-                                     state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2, opts->uvquality);
+            if ((DSD_SYNC_IS_P25P2(state->synctype) || DSD_SYNC_IS_DMR(state->synctype))
+                && dsd_synth_pipeline_stage(opts, state, 1, DSD_SYNTH_AMBE_2450, ambe_d, state->errsR,
+                                            state->errs2R)) {
+                synth_staged_placeholder(state->audio_out_temp_bufR, state->err_strR, state->errs2R);
+            } else {
+                mbe_processAmbe2450Dataf(state->audio_out_temp_bufR, &state->errsR, &state->errs2R, state->err_strR,
+                                         ambe_d, state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2,
+                                         opts->uvquality);
+            }
             if (DSD_SYNC_IS_P25P2(state->synctype)) {
                 int len2 = state->p25_p2_voice_err_hist_len > 0 ? state->p25_p2_voice_err_hist_len : 50;
                 if (len2 > 64) {
@@ -0,0 +1,671 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Pipelined vocoder synthesis stage.
+ *
+ * The frame decoder stages decoded vocoder bits per slot and commits them once
+ * the output path has made its mute decision. Committed frames go into a
+ * bounded ring guarded by a mutex; the lock is never held while synthesizing
+ * or writing audio. Workers own per-slot mbelib state, auto gain and HPF
+ * state so they never touch the decoder's copies.
+ *
+ * With one lane a single worker serves both slots in commit order. With two
+ * lanes each TDMA slot gets its own queue and worker, so dual-voice DMR and
+ * P25 Phase 2 synthesize concurrently; only the sink call is serialized.
+ */
+
+#include <dsd-neo/core/audio.h>
+#include <dsd-neo/core/opts.h>
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/core/synth_pipeline.h>
+#include <dsd-neo/platform/audio.h>
+#include <dsd-neo/platform/file_compat.h>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/platform/timing.h>
+#include <dsd-neo/runtime/audio_sink.h>
+#include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/log.h>
+#include <dsd-neo/runtime/udp_audio_hooks.h>
+
+#include <mbelib.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SYNTH_FRAME_SAMPLES 160
+#define SYNTH_GAIN_HISTORY  25
+
+typedef struct synth_slot {
+    mbe_parms cur_mp;
+    mbe_parms prev_mp;
+    mbe_parms prev_mp_enhanced;
+    float aout_gain;
+    float max_hist[SYNTH_GAIN_HISTORY];
+    int max_hist_idx;
+    /* One-pole HPF, same response as HRCFilterL/R (960 Hz @ 8 kHz). */
+    float hpf_coef;
+    float hpf_in;
+    float hpf_out;
+} synth_slot;
+
+/* One queue + worker. Lane i serves slot i, or both slots when there is one lane. */
+typedef struct synth_lane {
+    struct dsd_synth_pipeline* owner;
+    dsd_mutex_t lock;
+    dsd_cond_t not_empty;
+    dsd_cond_t not_full; /* also signalled when the worker goes idle */
+    dsd_thread_t thread;
+    int thread_started;
+    int stop;
+    int busy;
+
+    dsd_synth_frame* q;
+    int cap;
+    int head;
+    int count;
+
+    dsd_synth_pipeline_metrics m;
+} synth_lane;
+
+struct dsd_synth_pipeline {
+    synth_lane lanes[DSD_SYNTH_PIPELINE_MAX_LANES];
+    int nlanes;
+    int policy;
+    unsigned int block_timeout_ms;
+
+    dsd_synth_sink_fn sink;
+    void* user;
+    dsd_mutex_t sink_lock; /* serializes sink calls across lanes */
+
+    synth_slot slots[2]; /* slot s is only touched by the lane serving s */
+};
+
+static void
+synth_slot_reset(synth_slot* s) {
+    mbe_initMbeParms(&s->cur_mp, &s->prev_mp, &s->prev_mp_enhanced);
+    s->aout_gain = 25.0f;
+    memset(s->max_hist, 0, sizeof(s->max_hist));
+    s->max_hist_idx = 0;
+    const float rc = 1.0f / (2.0f * (float)M_PI * 960.0f);
+    const float ts = 1.0f / 8000.0f;
+    s->hpf_coef = rc / (ts + rc);
+    s->hpf_in = 0.0f;
+    s->hpf_out = 0.0f;
+}
+
+static synth_lane*
+synth_lane_for(dsd_synth_pipeline* p, int slot) {
+    return &p->lanes[(p->nlanes > 1) ? (slot & 1) : 0];
+}
+
+/* Mirrors processAudio(): 25-frame peak history, 5% per-frame upward slew, cap at 50x. */
+static void
+synth_apply_gain(synth_slot* s, float* buf, float fixed_gain) {
+    float gaindelta = 0.0f;
+
+    if (fixed_gain < 0.0f) {
+        return;
+    }
+    if (fixed_gain > 0.0f) {
+        for (int n = 0; n < SYNTH_FRAME_SAMPLES; n++) {
+            buf[n] *= fixed_gain;
+        }
+        return;
+    }
+
+    float max = 0.0f;
+    for (int n = 0; n < SYNTH_FRAME_SAMPLES; n++) {
+        float a = fabsf(buf[n]);
+        if (a > max) {
+            max = a;
+        }
+    }
+    s->max_hist[s->max_hist_idx] = max;
+    s->max_hist_idx = (s->max_hist_idx + 1) % SYNTH_GAIN_HISTORY;
+    for (int i = 0; i < SYNTH_GAIN_HISTORY; i++) {
+        if (s->max_hist[i] > max) {
+            max = s->max_hist[i];
+        }
+    }
+
+    float gainfactor = (max > 0.0f) ? (30000.0f / max) : 50.0f;
+    if (gainfactor < s->aout_gain) {
+        s->aout_gain = gainfactor;
+    } else {
+        if (gainfactor > 50.0f) {
+            gainfactor = 50.0f;
+        }
+        gaindelta = gainfactor - s->aout_gain;
+        if (gaindelta > (0.05f * s->aout_gain)) {
+            gaindelta = 0.05f * s->aout_gain;
+        }
+    }
+    gaindelta /= (float)SYNTH_FRAME_SAMPLES;
+
+    for (int n = 0; n < SYNTH_FRAME_SAMPLES; n++) {
+        buf[n] *= s->aout_gain + ((float)n * gaindelta);
+    }
+    s->aout_gain += (float)SYNTH_FRAME_SAMPLES * gaindelta;
+}
+
+static void
+synth_process_frame(dsd_synth_pipeline* p, dsd_synth_frame* f) {
+    synth_slot* s = &p->slots[f->slot & 1];
+    float fbuf[SYNTH_FRAME_SAMPLES];
+    short pcm[SYNTH_FRAME_SAMPLES];
+    char err_str[128];
+    int errs = f->errs;
+    int errs2 = f->errs2;
+
+    if (errs2 < 0) {
+        errs2 = 0;
+    } else if (errs2 > 64) {
+        errs2 = 64;
+    }
+
+    if (f->vocoder == DSD_SYNTH_IMBE_4400) {
+        mbe_processImbe4400Dataf(fbuf, &errs, &errs2, err_str, f->bits, &s->cur_mp, &s->prev_mp,
+                                 &s->prev_mp_enhanced, f->uvquality);
+    } else {
+        mbe_processAmbe2450Dataf(fbuf, &errs, &errs2, err_str, f->bits, &s->cur_mp, &s->prev_mp,
+                                 &s->prev_mp_enhanced, f->uvquality);
+    }
+
+    if (f->muted) {
+        return;
+    }
+
+    synth_apply_gain(s, fbuf, f->gain);
+
+    for (int n = 0; n < SYNTH_FRAME_SAMPLES; n++) {
+        float v = fbuf[n];
+        if (v > 32767.0f) {
+            v = 32767.0f;
+        } else if (v < -32768.0f) {
+            v = -32768.0f;
+        }
+        pcm[n] = (short)v;
+    }
+
+    if (f->hpf) {
+        for (int n = 0; n < SYNTH_FRAME_SAMPLES; n++) {
+            float in = (float)pcm[n];
+            s->hpf_out = s->hpf_coef * (in - s->hpf_in + s->hpf_out);
+            s->hpf_in = in;
+            pcm[n] = (short)s->hpf_out;
+        }
+    }
+
+    if (p->nlanes > 1) {
+        dsd_mutex_lock(&p->sink_lock);
+        p->sink(p->user, f->slot, pcm, SYNTH_FRAME_SAMPLES);
+        dsd_mutex_unlock(&p->sink_lock);
+    } else {
+        p->sink(p->user, f->slot, pcm, SYNTH_FRAME_SAMPLES);
+    }
+}
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    synth_worker(void* arg) {
+    synth_lane* l = (synth_lane*)arg;
+    dsd_synth_pipeline* p = l->owner;
+
+    for (;;) {
+        dsd_synth_frame f;
+
+        dsd_mutex_lock(&l->lock);
+        while (l->count == 0 && !l->stop) {
+            dsd_cond_wait(&l->not_empty, &l->lock);
+        }
+        if (l->count == 0) {
+            dsd_mutex_unlock(&l->lock);
+            break;
+        }
+        f = l->q[l->head];
+        l->head = (l->head + 1) % l->cap;
+        l->count--;
+        l->m.depth = l->count;
+        l->busy = 1;
+        dsd_cond_broadcast(&l->not_full);
+        dsd_mutex_unlock(&l->lock);
+
+        int played = 0;
+        if (f.reset) {
+            synth_slot_reset(&p->slots[f.slot & 1]);
+        } else {
+            synth_process_frame(p, &f);
+            played = !f.muted;
+        }
+
+        uint64_t lat = dsd_time_monotonic_ns() - f.enqueue_ns;
+
+        dsd_mutex_lock(&l->lock);
+        if (!f.reset) {
+            l->m.synthesized++;
+            l->m.played += (uint64_t)played;
+            l->m.latency_last_ns = lat;
+            l->m.latency_sum_ns += lat;
+            if (lat > l->m.latency_max_ns) {
+                l->m.latency_max_ns = lat;
+            }
+        }
+        l->busy = 0;
+        dsd_cond_broadcast(&l->not_full);
+        dsd_mutex_unlock(&l->lock);
+    }
+
+    DSD_THREAD_RETURN;
+}
+
+static void
+synth_lane_stop(synth_lane* l) {
+    if (l->thread_started) {
+        dsd_mutex_lock(&l->lock);
+        l->stop = 1;
+        dsd_cond_broadcast(&l->not_empty);
+        dsd_cond_broadcast(&l->not_full);
+        dsd_mutex_unlock(&l->lock);
+        dsd_thread_join(l->thread);
+        l->thread_started = 0;
+    }
+    dsd_cond_destroy(&l->not_full);
+    dsd_cond_destroy(&l->not_empty);
+    dsd_mutex_destroy(&l->lock);
+    free(l->q);
+    l->q = NULL;
+}
+
+dsd_synth_pipeline*
+dsd_synth_pipeline_create(const dsd_synth_pipeline_config* cfg, dsd_synth_sink_fn sink, void* user) {
+    if (!sink) {
+        return NULL;
+    }
+
+    int depth = cfg ? cfg->depth : 8;
+    if (depth < 1 || depth > DSD_SYNTH_PIPELINE_MAX_DEPTH) {
+        return NULL;
+    }
+    int nlanes = (cfg && cfg->lanes > 1) ? DSD_SYNTH_PIPELINE_MAX_LANES : 1;
+
+    dsd_synth_pipeline* p = (dsd_synth_pipeline*)calloc(1, sizeof(*p));
+    if (!p) {
+        return NULL;
+    }
+    p->policy = cfg ? cfg->policy : DSD_SYNTH_DROP_OLDEST;
+    p->block_timeout_ms = (cfg && cfg->block_timeout_ms > 0) ? (unsigned int)cfg->block_timeout_ms : 0;
+    p->sink = sink;
+    p->user = user;
+    synth_slot_reset(&p->slots[0]);
+    synth_slot_reset(&p->slots[1]);
+    dsd_mutex_init(&p->sink_lock);
+
+    for (int i = 0; i < nlanes; i++) {
+        synth_lane* l = &p->lanes[i];
+        l->owner = p;
+        l->cap = depth;
+        dsd_mutex_init(&l->lock);
+        dsd_cond_init(&l->not_empty);
+        dsd_cond_init(&l->not_full);
+        p->nlanes = i + 1;
+        l->q = (dsd_synth_frame*)calloc((size_t)depth, sizeof(dsd_synth_frame));
+        if (!l->q || dsd_thread_create(&l->thread, synth_worker, l) != 0) {
+            dsd_synth_pipeline_destroy(p);
+            return NULL;
+        }
+        l->thread_started = 1;
+    }
+    return p;
+}
+
+void
+dsd_synth_pipeline_destroy(dsd_synth_pipeline* p) {
+    if (!p) {
+        return;
+    }
+    for (int i = 0; i < p->nlanes; i++) {
+        synth_lane_stop(&p->lanes[i]);
+    }
+    dsd_mutex_destroy(&p->sink_lock);
+    free(p);
+}
+
+int
+dsd_synth_pipeline_lanes(const dsd_synth_pipeline* p) {
+    return p ? p->nlanes : 0;
+}
+
+/* Caller holds l->lock and has ensured there is space. */
+static void
+synth_enqueue_locked(synth_lane* l, const dsd_synth_frame* frame) {
+    int tail = (l->head + l->count) % l->cap;
+    l->q[tail] = *frame;
+    l->q[tail].slot = frame->slot & 1;
+    l->q[tail].enqueue_ns = dsd_time_monotonic_ns();
+    l->count++;
+    l->m.depth = l->count;
+    if (l->count > l->m.max_depth) {
+        l->m.max_depth = l->count;
+    }
+    dsd_cond_signal(&l->not_empty);
+}
+
+int
+dsd_synth_pipeline_submit(dsd_synth_pipeline* p, const dsd_synth_frame* frame) {
+    if (!p || !frame) {
+        return -1;
+    }
+    synth_lane* l = synth_lane_for(p, frame->slot);
+
+    dsd_mutex_lock(&l->lock);
+    if (l->stop) {
+        dsd_mutex_unlock(&l->lock);
+        return 0;
+    }
+
+    if (l->count == l->cap) {
+        if (p->policy == DSD_SYNTH_BLOCK && p->block_timeout_ms > 0) {
+            uint64_t deadline = dsd_time_monotonic_ms() + p->block_timeout_ms;
+            l->m.producer_waits++;
+            while (l->count == l->cap && !l->stop) {
+                uint64_t now = dsd_time_monotonic_ms();
+                if (now >= deadline) {
+                    break;
+                }
+                dsd_cond_timedwait(&l->not_full, &l->lock, (unsigned int)(deadline - now));
+            }
+        }
+        if (l->count == l->cap && p->policy == DSD_SYNTH_DROP_OLDEST) {
+            l->head = (l->head + 1) % l->cap;
+            l->count--;
+            l->m.dropped_oldest++;
+        }
+        if (l->count == l->cap || l->stop) {
+            l->m.dropped_newest++;
+            dsd_mutex_unlock(&l->lock);
+            return 0;
+        }
+    }
+
+    synth_enqueue_locked(l, frame);
+    l->m.submitted++;
+    dsd_mutex_unlock(&l->lock);
+    return 1;
+}
+
+void
+dsd_synth_pipeline_reset(dsd_synth_pipeline* p, int slot) {
+    if (!p) {
+        return;
+    }
+    dsd_synth_frame f;
+    memset(&f, 0, sizeof(f));
+    f.reset = 1;
+
+    /* Reset markers bypass the drop policy: evict the oldest frame if needed. */
+    for (int s = 0; s < 2; s++) {
+        if (slot >= 0 && (slot & 1) != s) {
+            continue;
+        }
+        synth_lane* l = synth_lane_for(p, s);
+        dsd_mutex_lock(&l->lock);
+        if (l->count == l->cap) {
+            l->head = (l->head + 1) % l->cap;
+            l->count--;
+            l->m.dropped_oldest++;
+        }
+        f.slot = s;
+        synth_enqueue_locked(l, &f);
+        dsd_mutex_unlock(&l->lock);
+    }
+}
+
+int
+dsd_synth_pipeline_wait_idle(dsd_synth_pipeline* p, unsigned int timeout_ms) {
+    if (!p) {
+        return 0;
+    }
+    int rc = 0;
+    uint64_t deadline = dsd_time_monotonic_ms() + timeout_ms;
+    for (int i = 0; i < p->nlanes && rc == 0; i++) {
+        synth_lane* l = &p->lanes[i];
+        dsd_mutex_lock(&l->lock);
+        while (l->count > 0 || l->busy) {
+            uint64_t now = dsd_time_monotonic_ms();
+            if (now >= deadline) {
+                rc = -1;
+                break;
+            }
+            dsd_cond_timedwait(&l->not_full, &l->lock, (unsigned int)(deadline - now));
+        }
+        dsd_mutex_unlock(&l->lock);
+    }
+    return rc;
+}
+
+void
+dsd_synth_pipeline_get_metrics(dsd_synth_pipeline* p, dsd_synth_pipeline_metrics* out) {
+    if (!out) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    if (!p) {
+        return;
+    }
+    /* Counters add up across lanes; depth is the total, max_depth the worst lane. */
+    for (int i = 0; i < p->nlanes; i++) {
+        synth_lane* l = &p->lanes[i];
+        dsd_mutex_lock(&l->lock);
+        dsd_synth_pipeline_metrics m = l->m;
+        dsd_mutex_unlock(&l->lock);
+        out->submitted += m.submitted;
+        out->synthesized += m.synthesized;
+        out->played += m.played;
+        out->dropped_oldest += m.dropped_oldest;
+        out->dropped_newest += m.dropped_newest;
+        out->producer_waits += m.producer_waits;
+        out->latency_sum_ns += m.latency_sum_ns;
+        if (m.latency_max_ns > out->latency_max_ns) {
+            out->latency_max_ns = m.latency_max_ns;
+        }
+        if (m.synthesized > 0) {
+            out->latency_last_ns = m.latency_last_ns;
+        }
+        out->depth += m.depth;
+        if (m.max_depth > out->max_depth) {
+            out->max_depth = m.max_depth;
+        }
+    }
+}
+
+/*
+ * Decoder integration
+ */
+
+typedef struct synth_binding {
+    dsd_synth_pipeline* pipeline;
+    dsd_opts* opts;
+    dsd_state* state;
+    dsd_synth_frame staged[2];
+    int has_staged[2];
+} synth_binding;
+
+/* Same stereo-duplicated 8 kHz output the SS/SS_P25P2/SS_DMR paths produce. */
+static void
+synth_state_sink(void* user, int slot, const short* pcm, size_t n) {
+    synth_binding* b = (synth_binding*)user;
+    dsd_opts* opts = b->opts;
+    short stereo[SYNTH_FRAME_SAMPLES * 2];
+
+    (void)slot;
+    if (n > SYNTH_FRAME_SAMPLES) {
+        n = SYNTH_FRAME_SAMPLES;
+    }
+    if (opts->audio_out != 1) {
+        return;
+    }
+    audio_mono_to_stereo_s16(pcm, stereo, n);
+
+    /* The decoder thread may write the same sinks inline (other modes, analog). */
+    if (opts->audio_out_type == 0 && opts->audio_out_stream) {
+        dsd_audio_sink_lock();
+        dsd_audio_write(opts->audio_out_stream, stereo, n);
+        dsd_audio_sink_unlock();
+    }
+    if (opts->audio_out_type == 8) {
+        dsd_udp_audio_hook_blast(opts, b->state, n * 2u * sizeof(short), stereo);
+    }
+    if (opts->audio_out_type == 1) {
+        dsd_audio_sink_lock();
+        const ssize_t written = dsd_write(opts->audio_out_fd, stereo, n * 2u * sizeof(short));
+        dsd_audio_sink_unlock();
+        (void)written;
+    }
+}
+
+static void
+synth_binding_free(void* ptr) {
+    synth_binding* b = (synth_binding*)ptr;
+    if (!b) {
+        return;
+    }
+    dsd_synth_pipeline_destroy(b->pipeline);
+    free(b);
+}
+
+int
+dsd_synth_pipeline_attach(dsd_opts* opts, dsd_state* state) {
+    if (!opts || !state) {
+        return -1;
+    }
+    if (DSD_STATE_EXT_GET_AS(synth_binding, state, DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE)) {
+        return 1;
+    }
+
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg || !cfg->synth_pipeline_enable) {
+        return 0;
+    }
+    /* Only the 8 kHz short stereo outputs are routed through the worker. */
+    if (opts->floating_point != 0 || opts->pulse_digi_rate_out != 8000 || opts->pulse_digi_out_channels != 2
+        || opts->wav_out_f != NULL || opts->wav_out_fR != NULL || opts->static_wav_file != 0
+        || opts->dmr_stereo_wav != 0) {
+        LOG_NOTICE("Synth pipeline requested but output config is unsupported; using inline synthesis.\n");
+        return 0;
+    }
+
+    synth_binding* b = (synth_binding*)calloc(1, sizeof(*b));
+    if (!b) {
+        return -1;
+    }
+    b->opts = opts;
+    b->state = state;
+
+    dsd_synth_pipeline_config pc;
+    pc.depth = cfg->synth_queue_depth;
+    pc.policy = cfg->synth_policy;
+    pc.block_timeout_ms = cfg->synth_block_ms;
+    pc.lanes = cfg->synth_workers;
+    b->pipeline = dsd_synth_pipeline_create(&pc, synth_state_sink, b);
+    if (!b->pipeline) {
+        free(b);
+        return -1;
+    }
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE, b, synth_binding_free) != 0) {
+        synth_binding_free(b);
+        return -1;
+    }
+    LOG_NOTICE("Synth pipeline enabled (queue %d, policy %d, %d worker%s).\n", pc.depth, pc.policy,
+               dsd_synth_pipeline_lanes(b->pipeline), (dsd_synth_pipeline_lanes(b->pipeline) > 1) ? "s" : "");
+    return 1;
+}
+
+void
+dsd_synth_pipeline_detach(dsd_state* state) {
+    if (!state) {
+        return;
+    }
+    (void)dsd_state_ext_set(state, DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE, NULL, NULL);
+}
+
+dsd_synth_pipeline*
+dsd_synth_pipeline_get(dsd_state* state) {
+    synth_binding* b = state ? DSD_STATE_EXT_GET_AS(synth_binding, state, DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE) : NULL;
+    return b ? b->pipeline : NULL;
+}
+
+int
+dsd_synth_pipeline_stage(dsd_opts* opts, dsd_state* state, int slot, dsd_synth_vocoder vocoder, const char* bits,
+                         int errs, int errs2) {
+    synth_binding* b = state ? DSD_STATE_EXT_GET_AS(synth_binding, state, DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE) : NULL;
+    if (!b || !opts || !bits) {
+        return 0;
+    }
+    slot &= 1;
+
+    /* Never committed (output path skipped): keep vocoder continuity, stay silent. */
+    if (b->has_staged[slot]) {
+        b->staged[slot].muted = 1;
+        (void)dsd_synth_pipeline_submit(b->pipeline, &b->staged[slot]);
+    }
+
+    dsd_synth_frame* f = &b->staged[slot];
+    memset(f, 0, sizeof(*f));
+    f->slot = slot;
+    f->vocoder = vocoder;
+    f->errs = errs;
+    f->errs2 = errs2;
+    f->uvquality = opts->uvquality;
+    f->hpf = (opts->use_hpf_d == 1);
+    if (opts->audio_gain == 0.0f) {
+        f->gain = 0.0f;
+    } else if (opts->audio_gain < 0.0f) {
+        f->gain = -1.0f;
+    } else {
+        f->gain = (slot == 0) ? state->aout_gain : state->aout_gainR;
+    }
+    memcpy(f->bits, bits, (vocoder == DSD_SYNTH_IMBE_4400) ? 88u : 49u);
+    b->has_staged[slot] = 1;
+    return 1;
+}
+
+int
+dsd_synth_pipeline_commit(dsd_state* state, int slot, int muted) {
+    synth_binding* b = state ? DSD_STATE_EXT_GET_AS(synth_binding, state, DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE) : NULL;
+    if (!b) {
+        return 0;
+    }
+    slot &= 1;
+    if (!b->has_staged[slot]) {
+        return 0;
+    }
+    b->staged[slot].muted = muted ? 1 : 0;
+    b->has_staged[slot] = 0;
+    (void)dsd_synth_pipeline_submit(b->pipeline, &b->staged[slot]);
+    return 1;
+}
+
+void
+dsd_synth_pipeline_reset_state(dsd_state* state, int slot) {
+    synth_binding* b = state ? DSD_STATE_EXT_GET_AS(synth_binding, state, DSD_STATE_EXT_ENGINE_SYNTH_PIPELINE) : NULL;
+    if (!b) {
+        return;
+    }
+    for (int s = 0; s < 2; s++) {
+        if (slot < 0 || (slot & 1) == s) {
+            b->has_staged[s] = 0;
+        }
+    }
+    dsd_synth_pipeline_reset(b->pipeline, slot);
+}
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief AES block rounds using the ARMv8 Cryptography Extensions.
+ *
+ * Compiled with +crypto enabled (see CMakeLists.txt); only called after
+ * crypt-aes.c has confirmed CPU support at runtime.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arm_neon.h>
+
+/* AESE folds AddRoundKey into the round, so the last key is applied with a plain XOR. */
+void
+aes_armv8_encrypt_block(const uint8_t* rk, int nr, const uint8_t* in, uint8_t* out) {
+    uint8x16_t s = vld1q_u8(in);
+    for (int r = 0; r < nr - 1; r++) {
+        s = vaesmcq_u8(vaeseq_u8(s, vld1q_u8(rk + (size_t)r * 16)));
+    }
+    s = vaeseq_u8(s, vld1q_u8(rk + (size_t)(nr - 1) * 16));
+    s = veorq_u8(s, vld1q_u8(rk + (size_t)nr * 16));
+    vst1q_u8(out, s);
+}
+
+/* dk is the equivalent-inverse schedule: reversed, InvMixColumns on rounds 1..nr-1. */
+void
+aes_armv8_decrypt_block(const uint8_t* dk, int nr, const uint8_t* in, uint8_t* out) {
+    uint8x16_t s = vld1q_u8(in);
+    for (int r = 0; r < nr - 1; r++) {
+        s = vaesimcq_u8(vaesdq_u8(s, vld1q_u8(dk + (size_t)r * 16)));
+    }
+    s = vaesdq_u8(s, vld1q_u8(dk + (size_t)(nr - 1) * 16));
+    s = veorq_u8(s, vld1q_u8(dk + (size_t)nr * 16));
+    vst1q_u8(out, s);
+}
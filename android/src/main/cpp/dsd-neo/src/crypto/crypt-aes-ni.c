@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief AES block rounds using x86 AES-NI.
+ *
+ * Compiled with AES-NI enabled (see CMakeLists.txt); only called after
+ * crypt-aes.c has confirmed CPU support at runtime.
+ */
+
+#include <stdint.h>
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+void
+aes_ni_encrypt_block(const uint8_t* rk, int nr, const uint8_t* in, uint8_t* out) {
+    const __m128i* k = (const __m128i*)rk;
+    __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), _mm_loadu_si128(k));
+    for (int r = 1; r < nr; r++) {
+        s = _mm_aesenc_si128(s, _mm_loadu_si128(k + r));
+    }
+    s = _mm_aesenclast_si128(s, _mm_loadu_si128(k + nr));
+    _mm_storeu_si128((__m128i*)out, s);
+}
+
+/* dk is the equivalent-inverse schedule: reversed, InvMixColumns on rounds 1..nr-1. */
+void
+aes_ni_decrypt_block(const uint8_t* dk, int nr, const uint8_t* in, uint8_t* out) {
+    const __m128i* k = (const __m128i*)dk;
+    __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), _mm_loadu_si128(k));
+    for (int r = 1; r < nr; r++) {
+        s = _mm_aesdec_si128(s, _mm_loadu_si128(k + r));
+    }
+    s = _mm_aesdeclast_si128(s, _mm_loadu_si128(k + nr));
+    _mm_storeu_si128((__m128i*)out, s);
+}
@@ -35,29 +35,72 @@
 
 */
 
+#include <dsd-neo/crypto/aes.h>
+#include <dsd-neo/platform/atomic_compat.h>
+#include <dsd-neo/platform/platform.h>
+
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
-#define AES_BLOCKLEN 16
-unsigned Nb = 4;
-unsigned Nk = 8;
-unsigned Nr = 14;
-
-struct AES_ctx {
-    uint8_t RoundKey[240];
-    uint8_t Iv[16];
-};
+#if defined(DSD_NEO_AES_HW_X86)
+#if DSD_COMPILER_MSVC && !DSD_COMPILER_CLANG
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(DSD_NEO_AES_HW_ARMV8) && (defined(__linux__) || defined(__ANDROID__))
+#include <sys/auxv.h>
+#ifndef HWCAP_AES
+#define HWCAP_AES (1 << 3)
+#endif
+#endif
+
+#if DSD_COMPILER_MSVC && !DSD_COMPILER_CLANG
+#define AES_THREAD_LOCAL __declspec(thread)
+#else
+#define AES_THREAD_LOCAL _Thread_local
+#endif
+
+#define AES_BLOCKLEN        16
+#define AES_MAX_ROUNDS      14
+#define AES_SCHED_BYTES     (AES_BLOCKLEN * (AES_MAX_ROUNDS + 1))
+#define AES_KEY_CACHE_SLOTS 4
 
-//internal function prototypes
-void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key);
-void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv);
-void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv);
-void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf);
-void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf);
-void AES_CBC_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
-void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
-void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+/*
+ * Expanded key for one AES key. `ek` is the FIPS-197 byte schedule (used as-is
+ * by AES-NI/ARMv8 and the portable decrypt), `ew` the same schedule as
+ * big-endian words for the T-table rounds, and `dk` the equivalent-inverse
+ * schedule (reversed, InvMixColumns applied to the middle rounds) for the
+ * hardware decrypt paths.
+ */
+typedef struct aes_key_sched {
+    uint8_t ek[AES_SCHED_BYTES];
+    uint8_t dk[AES_SCHED_BYTES];
+    uint32_t ew[4 * (AES_MAX_ROUNDS + 1)];
+    int nr;
+} aes_key_sched;
+
+typedef struct aes_key_cache_entry {
+    int valid;
+    int type;
+    uint8_t key[32];
+    aes_key_sched ks;
+} aes_key_cache_entry;
+
+typedef void (*aes_block_fn)(const aes_key_sched* ks, const uint8_t* in, uint8_t* out);
+
+/* Hardware rounds, built only when the compiler accepts the ISA flags (see CMakeLists.txt). */
+#if defined(DSD_NEO_AES_HW_X86)
+void aes_ni_encrypt_block(const uint8_t* rk, int nr, const uint8_t* in, uint8_t* out);
+void aes_ni_decrypt_block(const uint8_t* dk, int nr, const uint8_t* in, uint8_t* out);
+#endif
+#if defined(DSD_NEO_AES_HW_ARMV8)
+void aes_armv8_encrypt_block(const uint8_t* rk, int nr, const uint8_t* in, uint8_t* out);
+void aes_armv8_decrypt_block(const uint8_t* dk, int nr, const uint8_t* in, uint8_t* out);
+#endif
 
 typedef uint8_t state_t[4][4];
 
@@ -96,10 +139,58 @@ static const uint8_t rsbox[256] = {
 
 static const uint8_t Rcon[11] = {0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
 
+/* Encryption T-table: Te0[x] = {2*S[x], S[x], S[x], 3*S[x]}; Te1..Te3 are byte rotations of it. */
+static const uint32_t Te0[256] = {
+    0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU, 0xfff2f20dU, 0xd66b6bbdU,
+    0xde6f6fb1U, 0x91c5c554U, 0x60303050U, 0x02010103U, 0xce6767a9U, 0x562b2b7dU,
+    0xe7fefe19U, 0xb5d7d762U, 0x4dababe6U, 0xec76769aU, 0x8fcaca45U, 0x1f82829dU,
+    0x89c9c940U, 0xfa7d7d87U, 0xeffafa15U, 0xb25959ebU, 0x8e4747c9U, 0xfbf0f00bU,
+    0x41adadecU, 0xb3d4d467U, 0x5fa2a2fdU, 0x45afafeaU, 0x239c9cbfU, 0x53a4a4f7U,
+    0xe4727296U, 0x9bc0c05bU, 0x75b7b7c2U, 0xe1fdfd1cU, 0x3d9393aeU, 0x4c26266aU,
+    0x6c36365aU, 0x7e3f3f41U, 0xf5f7f702U, 0x83cccc4fU, 0x6834345cU, 0x51a5a5f4U,
+    0xd1e5e534U, 0xf9f1f108U, 0xe2717193U, 0xabd8d873U, 0x62313153U, 0x2a15153fU,
+    0x0804040cU, 0x95c7c752U, 0x46232365U, 0x9dc3c35eU, 0x30181828U, 0x379696a1U,
+    0x0a05050fU, 0x2f9a9ab5U, 0x0e070709U, 0x24121236U, 0x1b80809bU, 0xdfe2e23dU,
+    0xcdebeb26U, 0x4e272769U, 0x7fb2b2cdU, 0xea75759fU, 0x1209091bU, 0x1d83839eU,
+    0x582c2c74U, 0x341a1a2eU, 0x361b1b2dU, 0xdc6e6eb2U, 0xb45a5aeeU, 0x5ba0a0fbU,
+    0xa45252f6U, 0x763b3b4dU, 0xb7d6d661U, 0x7db3b3ceU, 0x5229297bU, 0xdde3e33eU,
+    0x5e2f2f71U, 0x13848497U, 0xa65353f5U, 0xb9d1d168U, 0x00000000U, 0xc1eded2cU,
+    0x40202060U, 0xe3fcfc1fU, 0x79b1b1c8U, 0xb65b5bedU, 0xd46a6abeU, 0x8dcbcb46U,
+    0x67bebed9U, 0x7239394bU, 0x944a4adeU, 0x984c4cd4U, 0xb05858e8U, 0x85cfcf4aU,
+    0xbbd0d06bU, 0xc5efef2aU, 0x4faaaae5U, 0xedfbfb16U, 0x864343c5U, 0x9a4d4dd7U,
+    0x66333355U, 0x11858594U, 0x8a4545cfU, 0xe9f9f910U, 0x04020206U, 0xfe7f7f81U,
+    0xa05050f0U, 0x783c3c44U, 0x259f9fbaU, 0x4ba8a8e3U, 0xa25151f3U, 0x5da3a3feU,
+    0x804040c0U, 0x058f8f8aU, 0x3f9292adU, 0x219d9dbcU, 0x70383848U, 0xf1f5f504U,
+    0x63bcbcdfU, 0x77b6b6c1U, 0xafdada75U, 0x42212163U, 0x20101030U, 0xe5ffff1aU,
+    0xfdf3f30eU, 0xbfd2d26dU, 0x81cdcd4cU, 0x180c0c14U, 0x26131335U, 0xc3ecec2fU,
+    0xbe5f5fe1U, 0x359797a2U, 0x884444ccU, 0x2e171739U, 0x93c4c457U, 0x55a7a7f2U,
+    0xfc7e7e82U, 0x7a3d3d47U, 0xc86464acU, 0xba5d5de7U, 0x3219192bU, 0xe6737395U,
+    0xc06060a0U, 0x19818198U, 0x9e4f4fd1U, 0xa3dcdc7fU, 0x44222266U, 0x542a2a7eU,
+    0x3b9090abU, 0x0b888883U, 0x8c4646caU, 0xc7eeee29U, 0x6bb8b8d3U, 0x2814143cU,
+    0xa7dede79U, 0xbc5e5ee2U, 0x160b0b1dU, 0xaddbdb76U, 0xdbe0e03bU, 0x64323256U,
+    0x743a3a4eU, 0x140a0a1eU, 0x924949dbU, 0x0c06060aU, 0x4824246cU, 0xb85c5ce4U,
+    0x9fc2c25dU, 0xbdd3d36eU, 0x43acacefU, 0xc46262a6U, 0x399191a8U, 0x319595a4U,
+    0xd3e4e437U, 0xf279798bU, 0xd5e7e732U, 0x8bc8c843U, 0x6e373759U, 0xda6d6db7U,
+    0x018d8d8cU, 0xb1d5d564U, 0x9c4e4ed2U, 0x49a9a9e0U, 0xd86c6cb4U, 0xac5656faU,
+    0xf3f4f407U, 0xcfeaea25U, 0xca6565afU, 0xf47a7a8eU, 0x47aeaee9U, 0x10080818U,
+    0x6fbabad5U, 0xf0787888U, 0x4a25256fU, 0x5c2e2e72U, 0x381c1c24U, 0x57a6a6f1U,
+    0x73b4b4c7U, 0x97c6c651U, 0xcbe8e823U, 0xa1dddd7cU, 0xe874749cU, 0x3e1f1f21U,
+    0x964b4bddU, 0x61bdbddcU, 0x0d8b8b86U, 0x0f8a8a85U, 0xe0707090U, 0x7c3e3e42U,
+    0x71b5b5c4U, 0xcc6666aaU, 0x904848d8U, 0x06030305U, 0xf7f6f601U, 0x1c0e0e12U,
+    0xc26161a3U, 0x6a35355fU, 0xae5757f9U, 0x69b9b9d0U, 0x17868691U, 0x99c1c158U,
+    0x3a1d1d27U, 0x279e9eb9U, 0xd9e1e138U, 0xebf8f813U, 0x2b9898b3U, 0x22111133U,
+    0xd26969bbU, 0xa9d9d970U, 0x078e8e89U, 0x339494a7U, 0x2d9b9bb6U, 0x3c1e1e22U,
+    0x15878792U, 0xc9e9e920U, 0x87cece49U, 0xaa5555ffU, 0x50282878U, 0xa5dfdf7aU,
+    0x038c8c8fU, 0x59a1a1f8U, 0x09898980U, 0x1a0d0d17U, 0x65bfbfdaU, 0xd7e6e631U,
+    0x844242c6U, 0xd06868b8U, 0x824141c3U, 0x299999b0U, 0x5a2d2d77U, 0x1e0f0f11U,
+    0x7bb0b0cbU, 0xa85454fcU, 0x6dbbbbd6U, 0x2c16163aU,
+};
+
 #define getSBoxValue(num) (sbox[(num)])
 
 static void
-KeyExpansion(uint8_t* RoundKey, const uint8_t* Key) {
+KeyExpansion(uint8_t* RoundKey, const uint8_t* Key, unsigned Nk, unsigned Nr) {
+    const unsigned Nb = 4;
     unsigned i, j, k;
     uint8_t tempa[4]; // Used for the column/row operations
 
@@ -122,10 +213,7 @@ KeyExpansion(uint8_t* RoundKey, const uint8_t* Key) {
         }
 
         if (i % Nk == 0) {
-            // This function shifts the 4 bytes in a word to the left once.
-            // [a0,a1,a2,a3] becomes [a1,a2,a3,a0]
-
-            // Function RotWord()
+            // Function RotWord(): [a0,a1,a2,a3] becomes [a1,a2,a3,a0]
             {
                 const uint8_t u8tmp = tempa[0];
                 tempa[0] = tempa[1];
@@ -134,9 +222,6 @@ KeyExpansion(uint8_t* RoundKey, const uint8_t* Key) {
                 tempa[3] = u8tmp;
             }
 
-            // SubWord() is a function that takes a four-byte input word and
-            // applies the S-box to each of the four bytes to produce an output word.
-
             // Function Subword()
             {
                 tempa[0] = getSBoxValue(tempa[0]);
@@ -207,97 +292,21 @@ unpack_byte_array_into_bit_array_ta(uint8_t* input, uint8_t* output, int len) {
     }
 }
 
-void
-AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key) {
-    KeyExpansion(ctx->RoundKey, key);
-}
-
-void
-AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv) {
-    KeyExpansion(ctx->RoundKey, key);
-    memcpy(ctx->Iv, iv, AES_BLOCKLEN);
-}
-
-void
-AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv) {
-    memcpy(ctx->Iv, iv, AES_BLOCKLEN);
-}
-
-static void
-AddRoundKey(uint8_t round, state_t* state, const uint8_t* RoundKey) {
-    uint8_t i, j;
-    for (i = 0; i < 4; ++i) {
-        for (j = 0; j < 4; ++j) {
-            (*state)[i][j] ^= RoundKey[(round * Nb * 4) + (i * Nb) + j];
-        }
-    }
-}
-
 static void
-SubBytes(state_t* state) {
+AddRoundKey(int round, state_t* state, const uint8_t* RoundKey) {
     uint8_t i, j;
     for (i = 0; i < 4; ++i) {
         for (j = 0; j < 4; ++j) {
-            (*state)[j][i] = getSBoxValue((*state)[j][i]);
+            (*state)[i][j] ^= RoundKey[(round * 16) + (i * 4) + j];
         }
     }
 }
 
-static void
-ShiftRows(state_t* state) {
-    uint8_t temp;
-
-    // Rotate first row 1 columns to left
-    temp = (*state)[0][1];
-    (*state)[0][1] = (*state)[1][1];
-    (*state)[1][1] = (*state)[2][1];
-    (*state)[2][1] = (*state)[3][1];
-    (*state)[3][1] = temp;
-
-    // Rotate second row 2 columns to left
-    temp = (*state)[0][2];
-    (*state)[0][2] = (*state)[2][2];
-    (*state)[2][2] = temp;
-
-    temp = (*state)[1][2];
-    (*state)[1][2] = (*state)[3][2];
-    (*state)[3][2] = temp;
-
-    // Rotate third row 3 columns to left
-    temp = (*state)[0][3];
-    (*state)[0][3] = (*state)[3][3];
-    (*state)[3][3] = (*state)[2][3];
-    (*state)[2][3] = (*state)[1][3];
-    (*state)[1][3] = temp;
-}
-
 static uint8_t
 xtime(uint8_t x) {
     return ((x << 1) ^ (((x >> 7) & 1) * 0x1b));
 }
 
-static void
-MixColumns(state_t* state) {
-    uint8_t i;
-    uint8_t Tmp, Tm, t;
-    for (i = 0; i < 4; ++i) {
-        t = (*state)[i][0];
-        Tmp = (*state)[i][0] ^ (*state)[i][1] ^ (*state)[i][2] ^ (*state)[i][3];
-        Tm = (*state)[i][0] ^ (*state)[i][1];
-        Tm = xtime(Tm);
-        (*state)[i][0] ^= Tm ^ Tmp;
-        Tm = (*state)[i][1] ^ (*state)[i][2];
-        Tm = xtime(Tm);
-        (*state)[i][1] ^= Tm ^ Tmp;
-        Tm = (*state)[i][2] ^ (*state)[i][3];
-        Tm = xtime(Tm);
-        (*state)[i][2] ^= Tm ^ Tmp;
-        Tm = (*state)[i][3] ^ t;
-        Tm = xtime(Tm);
-        (*state)[i][3] ^= Tm ^ Tmp;
-    }
-}
-
 #define Multiply(x, y)                                                                                                 \
     ((((y) & 1) * (x)) ^ (((y) >> 1 & 1) * xtime((x))) ^ (((y) >> 2 & 1) * xtime(xtime((x))))                          \
      ^ (((y) >> 3 & 1) * xtime(xtime(xtime((x))))) ^ (((y) >> 4 & 1) * xtime(xtime(xtime(xtime((x)))))))
@@ -359,43 +368,14 @@ InvShiftRows(state_t* state) {
     (*state)[3][3] = temp;
 }
 
-// Cipher is the main function that encrypts the PlainText,
-// or produces a keystream, depending on application.
 static void
-Cipher(state_t* state, const uint8_t* RoundKey) {
-    uint8_t round = 0;
+InvCipher(state_t* state, const uint8_t* RoundKey, int Nr) {
+    int round;
 
     // Add the First round key to the state before starting the rounds.
-    AddRoundKey(0, state, RoundKey);
-
-    // There will be Nr rounds.
-    // The first Nr-1 rounds are identical.
-    // These Nr rounds are executed in the loop below.
-    // Last one without MixColumns()
-    for (round = 1;; ++round) {
-        SubBytes(state);
-        ShiftRows(state);
-        if (round == Nr) {
-            break;
-        }
-        MixColumns(state);
-        AddRoundKey(round, state, RoundKey);
-    }
-    // Add round key to last round
     AddRoundKey(Nr, state, RoundKey);
-}
 
-static void
-InvCipher(state_t* state, const uint8_t* RoundKey) {
-    uint8_t round = 0;
-
-    // Add the First round key to the state before starting the rounds.
-    AddRoundKey(Nr, state, RoundKey);
-
-    // There will be Nr rounds.
-    // The first Nr-1 rounds are identical.
-    // These Nr rounds are executed in the loop below.
-    // Last one without InvMixColumn()
+    // The first Nr-1 rounds are identical; the last one is without InvMixColumn()
     for (round = (Nr - 1);; --round) {
         InvShiftRows(state);
         InvSubBytes(state);
@@ -407,81 +387,246 @@ InvCipher(state_t* state, const uint8_t* RoundKey) {
     }
 }
 
-void
-AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf) {
-    // The next function call encrypts the PlainText with the Key using AES algorithm.
-    Cipher((state_t*)buf, ctx->RoundKey);
+static inline uint32_t
+load_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
 }
 
-void
-AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf) {
-    // The next function call decrypts the PlainText with the Key using AES algorithm.
-    InvCipher((state_t*)buf, ctx->RoundKey);
+static inline void
+store_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
 }
 
+static inline uint32_t
+ror32(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32u - n));
+}
+
+#define TE_ROUND(a, b, c, d, k)                                                                                        \
+    (Te0[(a) >> 24] ^ ror32(Te0[((b) >> 16) & 0xff], 8) ^ ror32(Te0[((c) >> 8) & 0xff], 16)                           \
+     ^ ror32(Te0[(d) & 0xff], 24) ^ (k))
+
+#define TE_FINAL(a, b, c, d, k)                                                                                        \
+    ((((uint32_t)sbox[(a) >> 24] << 24) | ((uint32_t)sbox[((b) >> 16) & 0xff] << 16)                                  \
+      | ((uint32_t)sbox[((c) >> 8) & 0xff] << 8) | (uint32_t)sbox[(d) & 0xff])                                         \
+     ^ (k))
+
+/* Portable forward cipher: one 32-bit T-table lookup per byte per round. */
 static void
-XorWithIv(uint8_t* buf, const uint8_t* Iv) {
-    uint8_t i;
-    for (i = 0; i < AES_BLOCKLEN; ++i) {
-        buf[i] ^= Iv[i];
+aes_encrypt_block_ttable(const aes_key_sched* ks, const uint8_t* in, uint8_t* out) {
+    const uint32_t* rk = ks->ew;
+    uint32_t s0 = load_be32(in + 0) ^ rk[0];
+    uint32_t s1 = load_be32(in + 4) ^ rk[1];
+    uint32_t s2 = load_be32(in + 8) ^ rk[2];
+    uint32_t s3 = load_be32(in + 12) ^ rk[3];
+
+    for (int round = 1; round < ks->nr; round++) {
+        rk += 4;
+        uint32_t t0 = TE_ROUND(s0, s1, s2, s3, rk[0]);
+        uint32_t t1 = TE_ROUND(s1, s2, s3, s0, rk[1]);
+        uint32_t t2 = TE_ROUND(s2, s3, s0, s1, rk[2]);
+        uint32_t t3 = TE_ROUND(s3, s0, s1, s2, rk[3]);
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
     }
+    rk += 4;
+    store_be32(out + 0, TE_FINAL(s0, s1, s2, s3, rk[0]));
+    store_be32(out + 4, TE_FINAL(s1, s2, s3, s0, rk[1]));
+    store_be32(out + 8, TE_FINAL(s2, s3, s0, s1, rk[2]));
+    store_be32(out + 12, TE_FINAL(s3, s0, s1, s2, rk[3]));
 }
 
-void
-AES_CBC_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length) {
-    size_t i;
-    uint8_t* Iv = ctx->Iv;
-    for (i = 0; i < length; i += AES_BLOCKLEN) {
-        XorWithIv(buf, Iv);
-        Cipher((state_t*)buf, ctx->RoundKey);
-        Iv = buf;
-        buf += AES_BLOCKLEN;
+/* Portable inverse cipher (CBC/ECB decrypt only; not on the keystream hot path). */
+static void
+aes_decrypt_block_bytewise(const aes_key_sched* ks, const uint8_t* in, uint8_t* out) {
+    state_t st;
+    memcpy(st, in, AES_BLOCKLEN);
+    InvCipher(&st, ks->ek, ks->nr);
+    memcpy(out, st, AES_BLOCKLEN);
+}
+
+#if defined(DSD_NEO_AES_HW_X86)
+static void
+aes_encrypt_block_ni(const aes_key_sched* ks, const uint8_t* in, uint8_t* out) {
+    aes_ni_encrypt_block(ks->ek, ks->nr, in, out);
+}
+
+static void
+aes_decrypt_block_ni(const aes_key_sched* ks, const uint8_t* in, uint8_t* out) {
+    aes_ni_decrypt_block(ks->dk, ks->nr, in, out);
+}
+#endif
+
+#if defined(DSD_NEO_AES_HW_ARMV8)
+static void
+aes_encrypt_block_armv8(const aes_key_sched* ks, const uint8_t* in, uint8_t* out) {
+    aes_armv8_encrypt_block(ks->ek, ks->nr, in, out);
+}
+
+static void
+aes_decrypt_block_armv8(const aes_key_sched* ks, const uint8_t* in, uint8_t* out) {
+    aes_armv8_decrypt_block(ks->dk, ks->nr, in, out);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* Runtime dispatch                                                           */
+/* -------------------------------------------------------------------------- */
+
+enum { AES_IMPL_UNPROBED = 0, AES_IMPL_PORTABLE = 1, AES_IMPL_AESNI = 2, AES_IMPL_ARMV8 = 3 };
+
+static atomic_int g_aes_impl;
+static atomic_int g_aes_portable_only;
+
+static int
+aes_probe_impl(void) {
+#if defined(DSD_NEO_AES_HW_X86)
+#if DSD_COMPILER_MSVC && !DSD_COMPILER_CLANG
+    int info[4];
+    __cpuid(info, 1);
+    if (info[2] & (1 << 25)) {
+        return AES_IMPL_AESNI;
+    }
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 25))) {
+        return AES_IMPL_AESNI;
     }
-    /* store Iv in ctx for next call */
-    memcpy(ctx->Iv, Iv, AES_BLOCKLEN);
+#endif
+#elif defined(DSD_NEO_AES_HW_ARMV8)
+#if defined(__APPLE__) || defined(_WIN32)
+    return AES_IMPL_ARMV8; /* every arm64 Apple/Windows target ships the crypto extension */
+#elif defined(__linux__) || defined(__ANDROID__)
+    if (getauxval(AT_HWCAP) & HWCAP_AES) {
+        return AES_IMPL_ARMV8;
+    }
+#endif
+#endif
+    return AES_IMPL_PORTABLE;
 }
 
-void
-AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length) {
-    size_t i;
-    uint8_t storeNextIv[AES_BLOCKLEN];
-    for (i = 0; i < length; i += AES_BLOCKLEN) {
-        memcpy(storeNextIv, buf, AES_BLOCKLEN);
-        InvCipher((state_t*)buf, ctx->RoundKey);
-        XorWithIv(buf, ctx->Iv);
-        memcpy(ctx->Iv, storeNextIv, AES_BLOCKLEN);
-        buf += AES_BLOCKLEN;
+static int
+aes_active_impl(void) {
+    int impl = atomic_load(&g_aes_impl);
+    if (impl == AES_IMPL_UNPROBED) {
+        impl = aes_probe_impl();
+        atomic_store(&g_aes_impl, impl);
+    }
+    return atomic_load(&g_aes_portable_only) ? AES_IMPL_PORTABLE : impl;
+}
+
+static aes_block_fn
+aes_encrypt_fn(void) {
+    switch (aes_active_impl()) {
+#if defined(DSD_NEO_AES_HW_X86)
+        case AES_IMPL_AESNI: return aes_encrypt_block_ni;
+#endif
+#if defined(DSD_NEO_AES_HW_ARMV8)
+        case AES_IMPL_ARMV8: return aes_encrypt_block_armv8;
+#endif
+        default: return aes_encrypt_block_ttable;
+    }
+}
+
+static aes_block_fn
+aes_decrypt_fn(void) {
+    switch (aes_active_impl()) {
+#if defined(DSD_NEO_AES_HW_X86)
+        case AES_IMPL_AESNI: return aes_decrypt_block_ni;
+#endif
+#if defined(DSD_NEO_AES_HW_ARMV8)
+        case AES_IMPL_ARMV8: return aes_decrypt_block_armv8;
+#endif
+        default: return aes_decrypt_block_bytewise;
+    }
+}
+
+const char*
+aes_get_impl_name(void) {
+    switch (aes_active_impl()) {
+        case AES_IMPL_AESNI: return "aesni";
+        case AES_IMPL_ARMV8: return "armv8";
+        default: return "portable";
     }
 }
 
-/* Symmetrical operation: same function for encrypting as for decrypting. Note any IV/nonce should never be reused with the same key */
 void
-AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length) {
-    uint8_t buffer[AES_BLOCKLEN];
+aes_set_portable_only(int enable) {
+    atomic_store(&g_aes_portable_only, enable ? 1 : 0);
+}
 
-    size_t i;
-    int bi;
-    for (i = 0, bi = AES_BLOCKLEN; i < length; ++i, ++bi) {
-        if (bi == AES_BLOCKLEN) /* we need to regen xor compliment in buffer */
-        {
+/* -------------------------------------------------------------------------- */
+/* Per-thread key schedule cache                                              */
+/* -------------------------------------------------------------------------- */
 
-            memcpy(buffer, ctx->Iv, AES_BLOCKLEN);
-            Cipher((state_t*)buffer, ctx->RoundKey);
+/*
+ * Calls re-use the same few keys every superframe, so expanded schedules are
+ * cached by key material. The cache is per thread: no locking, and concurrent
+ * slot decoders never share a context.
+ */
+static AES_THREAD_LOCAL aes_key_cache_entry g_aes_key_cache[AES_KEY_CACHE_SLOTS];
+static AES_THREAD_LOCAL unsigned g_aes_key_cache_next;
 
-            /* Increment Iv and handle overflow */
-            for (bi = (AES_BLOCKLEN - 1); bi >= 0; --bi) {
-                /* inc will overflow */
-                if (ctx->Iv[bi] == 255) {
-                    ctx->Iv[bi] = 0;
-                    continue;
-                }
-                ctx->Iv[bi] += 1;
-                break;
-            }
-            bi = 0;
+static void
+aes_key_sched_build(aes_key_sched* ks, const uint8_t* key, unsigned nk, unsigned nr) {
+    memset(ks, 0, sizeof(*ks));
+    ks->nr = (int)nr;
+    KeyExpansion(ks->ek, key, nk, nr);
+    for (unsigned i = 0; i < 4 * (nr + 1); i++) {
+        ks->ew[i] = load_be32(ks->ek + (size_t)i * 4);
+    }
+
+    memcpy(ks->dk, ks->ek + (size_t)nr * AES_BLOCKLEN, AES_BLOCKLEN);
+    for (unsigned r = 1; r < nr; r++) {
+        state_t st;
+        memcpy(st, ks->ek + (size_t)(nr - r) * AES_BLOCKLEN, AES_BLOCKLEN);
+        InvMixColumns(&st);
+        memcpy(ks->dk + (size_t)r * AES_BLOCKLEN, st, AES_BLOCKLEN);
+    }
+    memcpy(ks->dk + (size_t)nr * AES_BLOCKLEN, ks->ek, AES_BLOCKLEN);
+}
+
+//input type is the type/key len of AES required (0-128, 1-192, 2-256); anything else is treated as 256
+static const aes_key_sched*
+aes_key_sched_get(const uint8_t* key, int type) {
+    unsigned nk = 8;
+    unsigned nr = 14;
+    if (type == 0) {
+        nk = 4;
+        nr = 10;
+    } else if (type == 1) {
+        nk = 6;
+        nr = 12;
+    } else {
+        type = 2;
+    }
+    size_t key_len = (size_t)nk * 4;
+
+    for (unsigned i = 0; i < AES_KEY_CACHE_SLOTS; i++) {
+        aes_key_cache_entry* e = &g_aes_key_cache[i];
+        if (e->valid && e->type == type && memcmp(e->key, key, key_len) == 0) {
+            return &e->ks;
         }
+    }
+
+    aes_key_cache_entry* e = &g_aes_key_cache[g_aes_key_cache_next++ % AES_KEY_CACHE_SLOTS];
+    e->valid = 1;
+    e->type = type;
+    memset(e->key, 0, sizeof(e->key));
+    memcpy(e->key, key, key_len);
+    aes_key_sched_build(&e->ks, key, nk, nr);
+    return &e->ks;
+}
 
-        buf[i] = (buf[i] ^ buffer[bi]);
+static void
+xor_block(uint8_t* dst, const uint8_t* src) {
+    for (int j = 0; j < AES_BLOCKLEN; j++) {
+        dst[j] ^= src[j];
     }
 }
 
@@ -494,43 +639,15 @@ AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length) {
 void
 aes_ofb_keystream_output(uint8_t* iv, uint8_t* key, uint8_t* output, int type, int nblocks) {
 
-    int i;
-    uint8_t input_register[16]; //OFB Input Register
-    memset(input_register, 0, sizeof(input_register));
+    const aes_key_sched* ks = aes_key_sched_get(key, type);
+    aes_block_fn enc = aes_encrypt_fn();
 
-    //Set values specific to type (128/192/256)
-    if (type == 0) //128
-    {
-        Nb = 4;
-        Nk = 4;
-        Nr = 10;
-    } else if (type == 1) //192
-    {
-        Nb = 4;
-        Nk = 6;
-        Nr = 12;
-    } else //if (type == 2) //256
-    {
-        Nb = 4;
-        Nk = 8;
-        Nr = 14;
-    }
-
-    struct AES_ctx ctx;
-
-    //load first round of input_register with received IV (OFB First Input Register)
-    memcpy(input_register, iv, ((size_t)16) * sizeof(uint8_t));
-
-    //initialize the key variable for the Cipher function
-    memset(ctx.RoundKey, 0, ((size_t)240) * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key);
-
-    //execute the cipher function, and copy ciphered input_register to output for required number of rounds
-    for (i = 0; i < nblocks; i++) {
-        Cipher((state_t*)input_register,
-               ctx.RoundKey); //input_register is returned as output, and is put back in as object feedback
-        memcpy(output + ((size_t)i * 16), input_register,
-               ((size_t)16) * sizeof(uint8_t)); //copy ciphered input_register to output
+    //OFB feedback: each output block is the input register for the next
+    const uint8_t* input_register = iv;
+    for (int i = 0; i < nblocks; i++) {
+        uint8_t* block = output + ((size_t)i * 16);
+        enc(ks, input_register, block);
+        input_register = block;
     }
 }
 
@@ -545,54 +662,27 @@ aes_ofb_keystream_output(uint8_t* iv, uint8_t* key, uint8_t* output, int type, i
 void
 aes_cfb_bytewise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* in, uint8_t* out, int type, int nblocks, int de) {
 
-    int i, j;
     uint8_t input_register[16]; //Input Register
-    memset(input_register, 0, sizeof(input_register));
-
-    //Set values specific to type (128/192/256)
-    if (type == 0) //128
-    {
-        Nb = 4;
-        Nk = 4;
-        Nr = 10;
-    } else if (type == 1) //192
-    {
-        Nb = 4;
-        Nk = 6;
-        Nr = 12;
-    } else //if (type == 2) //256
-    {
-        Nb = 4;
-        Nk = 8;
-        Nr = 14;
-    }
-
-    struct AES_ctx ctx;
+    const aes_key_sched* ks = aes_key_sched_get(key, type);
+    aes_block_fn enc = aes_encrypt_fn();
 
     //load first round of input_register with received IV (CFB First Input Register)
-    memcpy(input_register, iv, ((size_t)16) * sizeof(uint8_t));
-
-    //initialize the key variable for the Cipher function
-    memset(ctx.RoundKey, 0, ((size_t)240) * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key);
+    memcpy(input_register, iv, sizeof(input_register));
 
-    //execute the cipher function, and copy ciphered input_register to output for required number of rounds
-    for (i = 0; i < nblocks; i++) {
+    for (int i = 0; i < nblocks; i++) {
 
         //the cipher is always run in the foward, or encryption mode
-        Cipher((state_t*)input_register, ctx.RoundKey);
+        enc(ks, input_register, input_register);
 
         //xor the current input 'in' to the current state of the input_register for cipher feedback
-        for (j = 0; j < 16; j++) {
-            input_register[j] ^= in[j + (i * 16)];
-        }
+        xor_block(input_register, in + ((size_t)i * 16));
 
         //copy ciphered/xor'd input_register to output 'out'
-        memcpy(out + ((size_t)i * 16), input_register, ((size_t)16) * sizeof(uint8_t));
+        memcpy(out + ((size_t)i * 16), input_register, sizeof(input_register));
 
         //if running in decryption mode, we feed in the next round of input
         if (!de) {
-            memcpy(input_register, in + ((size_t)i * 16), ((size_t)16) * sizeof(uint8_t));
+            memcpy(input_register, in + ((size_t)i * 16), sizeof(input_register));
         }
     }
 }
@@ -608,83 +698,27 @@ aes_cfb_bytewise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* in, uint8_t*
 void
 aes_cbc_bytewise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* in, uint8_t* out, int type, int nblocks, int de) {
 
-    int i, j;
     uint8_t input_register[16]; //Input Register
-    memset(input_register, 0, sizeof(input_register));
+    const aes_key_sched* ks = aes_key_sched_get(key, type);
 
-    //Set values specific to type (128/192/256)
-    if (type == 0) //128
-    {
-        Nb = 4;
-        Nk = 4;
-        Nr = 10;
-    } else if (type == 1) //192
+    if (de) //encrypt
     {
-        Nb = 4;
-        Nk = 6;
-        Nr = 12;
-    } else //if (type == 2) //256
-    {
-        Nb = 4;
-        Nk = 8;
-        Nr = 14;
-    }
-
-    struct AES_ctx ctx;
-
-    //load first round of input_register accordingly
-    if (de) {
-        memcpy(input_register, iv, 16 * sizeof(uint8_t));
-    } else {
-        memcpy(input_register, in, 16 * sizeof(uint8_t));
-    }
-
-    //initialize the key variable for the Cipher function
-    memset(ctx.RoundKey, 0, ((size_t)240) * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key);
-
-    //
-    for (i = 0; i < nblocks; i++) {
-
-        //run encryption or decryption depending on de value
-        if (de) //encrypt
-        {
-
+        aes_block_fn enc = aes_encrypt_fn();
+        memcpy(input_register, iv, sizeof(input_register));
+        for (int i = 0; i < nblocks; i++) {
             //xor the current input 'in' pt to the current state of the input_register for cbc feedback
-            for (j = 0; j < 16; j++) {
-                input_register[j] ^= in[j + (i * 16)];
-            }
-
-            Cipher((state_t*)input_register, ctx.RoundKey);
-
-            //copy ciphered input_register to output 'out'
-            memcpy(out + ((size_t)i * 16), input_register, ((size_t)16) * sizeof(uint8_t));
-
+            xor_block(input_register, in + ((size_t)i * 16));
+            enc(ks, input_register, input_register);
+            memcpy(out + ((size_t)i * 16), input_register, sizeof(input_register));
         }
-
-        else //decrypt
-        {
-
-            InvCipher((state_t*)input_register, ctx.RoundKey);
-
-            //copy ciphered input_register to output 'out'
-            memcpy(out + ((size_t)i * 16), input_register, ((size_t)16) * sizeof(uint8_t));
-
+    } else //decrypt
+    {
+        aes_block_fn dec = aes_decrypt_fn();
+        for (int i = 0; i < nblocks; i++) {
+            dec(ks, in + ((size_t)i * 16), input_register);
             //xor the current output by IV, or by last received CT
-            if (i == 0) {
-                for (j = 0; j < 16; j++) {
-                    out[j] ^= iv[j];
-                }
-            } else {
-                for (j = 0; j < 16; j++) {
-                    out[j + ((size_t)i * 16)] ^= in[j + ((size_t)(i - 1) * 16)];
-                }
-            }
-
-            //copy in next segment for input_register (if not last)
-            if (i < nblocks) {
-                memcpy(input_register, in + ((size_t)(i + 1) * 16), ((size_t)16) * sizeof(uint8_t));
-            }
+            xor_block(input_register, i == 0 ? iv : in + ((size_t)(i - 1) * 16));
+            memcpy(out + ((size_t)i * 16), input_register, sizeof(input_register));
         }
     }
 }
@@ -700,51 +734,20 @@ aes_cbc_bytewise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* in, uint8_t*
 void
 aes_cbc_mac_generator(uint8_t* key, uint8_t* in, uint8_t* out, int type, int nblocks) {
 
-    int i, j;
     uint8_t input_register[16]; //Input Register
     memset(input_register, 0, sizeof(input_register));
+    const aes_key_sched* ks = aes_key_sched_get(key, type);
+    aes_block_fn enc = aes_encrypt_fn();
 
-    //Set values specific to type (128/192/256)
-    if (type == 0) //128
-    {
-        Nb = 4;
-        Nk = 4;
-        Nr = 10;
-    } else if (type == 1) //192
-    {
-        Nb = 4;
-        Nk = 6;
-        Nr = 12;
-    } else //if (type == 2) //256
-    {
-        Nb = 4;
-        Nk = 8;
-        Nr = 14;
-    }
-
-    struct AES_ctx ctx;
-
-    //initialize the key variable for the Cipher function
-    memset(ctx.RoundKey, 0, 240 * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key);
-
-    //
-    for (i = 0; i < nblocks; i++) {
-
+    for (int i = 0; i < nblocks; i++) {
         //xor the current input 'in' pt to the current state of the input_register for cbc feedback
         //if this is the first iteration, this will load the first round plain text instead
-        for (j = 0; j < 16; j++) {
-            input_register[j] ^= in[j + ((i + 0) * 16)];
-        }
-
-        Cipher((state_t*)input_register, ctx.RoundKey);
-
-        //debug, load out all intermediate output register values
-        // memcpy (out+(i*16), input_register, 16*sizeof(uint8_t) );
+        xor_block(input_register, in + ((size_t)i * 16));
+        enc(ks, input_register, input_register);
     }
 
     //copy final ciphered input_register to output 'out', user will determine how many bytes of output they want for MAC
-    memcpy(out, input_register, 16 * sizeof(uint8_t));
+    memcpy(out, input_register, sizeof(input_register));
 }
 
 //byte-wise output of AES ECB Ciphering/Deciphering
@@ -755,86 +758,33 @@ aes_cbc_mac_generator(uint8_t* key, uint8_t* in, uint8_t* out, int type, int nbl
 //de is a bit-flag signalling to run Cipher (encrypt) on 1, or InvCipher (decrypt) on 0
 void
 aes_ecb_bytewise_payload_crypt(uint8_t* input, uint8_t* key, uint8_t* output, int type, int de) {
-
-    uint8_t input_register[16]; //ECB Input Register
-    memset(input_register, 0, sizeof(input_register));
-
-    //Set values specific to type (128/192/256)
-    if (type == 0) //128
-    {
-        Nb = 4;
-        Nk = 4;
-        Nr = 10;
-    } else if (type == 1) //192
-    {
-        Nb = 4;
-        Nk = 6;
-        Nr = 12;
-    } else //if (type == 2) //256
-    {
-        Nb = 4;
-        Nk = 8;
-        Nr = 14;
-    }
-
-    struct AES_ctx ctx;
-
-    //load input_register with received input (ECB Payload)
-    memcpy(input_register, input, 16 * sizeof(uint8_t));
-
-    //initialize the key variable for the Cipher function
-    memset(ctx.RoundKey, 0, 240 * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key);
-
-    //run encryption or decryption depending on de value
+    const aes_key_sched* ks = aes_key_sched_get(key, type);
     if (de) { //encrypt
-        Cipher((state_t*)input_register, ctx.RoundKey);
+        aes_encrypt_fn()(ks, input, output);
     } else { //decrypt
-        InvCipher((state_t*)input_register, ctx.RoundKey);
+        aes_decrypt_fn()(ks, input, output);
     }
+}
 
-    //copy ciphered/deciphered input_register to output
-    memcpy(output, input_register, 16 * sizeof(uint8_t));
+//CTR keystream over one 16-byte payload: a single counter block, so the IV is used as-is
+static void
+aes_ctr_block_xcrypt(const uint8_t* iv, const uint8_t* key, uint8_t* payload, int type) {
+    uint8_t ks_block[AES_BLOCKLEN];
+    const aes_key_sched* ks = aes_key_sched_get(key, type);
+    aes_encrypt_fn()(ks, iv, ks_block);
+    xor_block(payload, ks_block);
 }
 
 //symmetrical ctr mode payload encryption and decryption
 void
 aes_ctr_bitwise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* payload, int type) {
 
-    //Set values specific to type (128/192/256)
-    if (type == 0) //128
-    {
-        Nb = 4;
-        Nk = 4;
-        Nr = 10;
-    } else if (type == 1) //192
-    {
-        Nb = 4;
-        Nk = 6;
-        Nr = 12;
-    } else //if (type == 2) //256
-    {
-        Nb = 4;
-        Nk = 8;
-        Nr = 14;
-    }
-
-    struct AES_ctx ctx;
-
-    //init and set the iv and key variables
-    memset(ctx.RoundKey, 0, 240 * sizeof(uint8_t));
-    memset(ctx.Iv, 0, 16 * sizeof(uint8_t));
-
-    KeyExpansion(ctx.RoundKey, key);
-    memcpy(ctx.Iv, iv, AES_BLOCKLEN);
-
     //pack input bit-wise payload to byte array
     uint8_t payload_bytes[16];
     memset(payload_bytes, 0, sizeof(payload_bytes));
     pack_bit_array_into_byte_array_ta(payload, payload_bytes, 16);
 
-    //pass to internal CTR handler for payload
-    AES_CTR_xcrypt_buffer(&ctx, payload_bytes, 16);
+    aes_ctr_block_xcrypt(iv, key, payload_bytes, type);
 
     //unpack output bytes back to bits
     unpack_byte_array_into_bit_array_ta(payload_bytes, payload, 16);
@@ -843,34 +793,5 @@ aes_ctr_bitwise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* payload, int t
 //symmetrical ctr mode payload encryption and decryption
 void
 aes_ctr_bytewise_payload_crypt(uint8_t* iv, uint8_t* key, uint8_t* payload, int type) {
-
-    //Set values specific to type (128/192/256)
-    if (type == 0) //128
-    {
-        Nb = 4;
-        Nk = 4;
-        Nr = 10;
-    } else if (type == 1) //192
-    {
-        Nb = 4;
-        Nk = 6;
-        Nr = 12;
-    } else //if (type == 2) //256
-    {
-        Nb = 4;
-        Nk = 8;
-        Nr = 14;
-    }
-
-    struct AES_ctx ctx;
-
-    //init and set the iv and key variables
-    memset(ctx.RoundKey, 0, 240 * sizeof(uint8_t));
-    memset(ctx.Iv, 0, 16 * sizeof(uint8_t));
-
-    KeyExpansion(ctx.RoundKey, key);
-    memcpy(ctx.Iv, iv, AES_BLOCKLEN);
-
-    //pass to internal CTR handler for payload
-    AES_CTR_xcrypt_buffer(&ctx, payload, 16);
+    aes_ctr_block_xcrypt(iv, key, payload, type);
 }
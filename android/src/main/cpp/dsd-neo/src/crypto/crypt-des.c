@@ -4,281 +4,271 @@
  * DES Alg
  *-----------------------------------------------------------------------------*/
 
+#include <dsd-neo/crypto/des.h>
+
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-//NOTE: The SLUT boxes are S boxes with additional calculations so we don't have
-//to manually sort out row and column values and can cut down on operations
-
-uint8_t SLUT1[64] = {0xE0, 0x00, 0x40, 0xF0, 0xD0, 0x70, 0x10, 0x40, 0x20, 0xE0, 0xF0, 0x20, 0xB0, 0xD0, 0x80, 0x10,
-                     0x30, 0xA0, 0xA0, 0x60, 0x60, 0xC0, 0xC0, 0xB0, 0x50, 0x90, 0x90, 0x50, 0x00, 0x30, 0x70, 0x80,
-                     0x40, 0xF0, 0x10, 0xC0, 0xE0, 0x80, 0x80, 0x20, 0xD0, 0x40, 0x60, 0x90, 0x20, 0x10, 0xB0, 0x70,
-                     0xF0, 0x50, 0xC0, 0xB0, 0x90, 0x30, 0x70, 0xE0, 0x30, 0xA0, 0xA0, 0x00, 0x50, 0x60, 0x00, 0xD0};
-
-uint8_t SLUT2[64] = {0x0F, 0x03, 0x01, 0x0D, 0x08, 0x04, 0x0E, 0x07, 0x06, 0x0F, 0x0B, 0x02, 0x03, 0x08, 0x04, 0x0E,
-                     0x09, 0x0C, 0x07, 0x00, 0x02, 0x01, 0x0D, 0x0A, 0x0C, 0x06, 0x00, 0x09, 0x05, 0x0B, 0x0A, 0x05,
-                     0x00, 0x0D, 0x0E, 0x08, 0x07, 0x0A, 0x0B, 0x01, 0x0A, 0x03, 0x04, 0x0F, 0x0D, 0x04, 0x01, 0x02,
-                     0x05, 0x0B, 0x08, 0x06, 0x0C, 0x07, 0x06, 0x0C, 0x09, 0x00, 0x03, 0x05, 0x02, 0x0E, 0x0F, 0x09};
-
-uint8_t SLUT3[64] = {0xA0, 0xD0, 0x00, 0x70, 0x90, 0x00, 0xE0, 0x90, 0x60, 0x30, 0x30, 0x40, 0xF0, 0x60, 0x50, 0xA0,
-                     0x10, 0x20, 0xD0, 0x80, 0xC0, 0x50, 0x70, 0xE0, 0xB0, 0xC0, 0x40, 0xB0, 0x20, 0xF0, 0x80, 0x10,
-                     0xD0, 0x10, 0x60, 0xA0, 0x40, 0xD0, 0x90, 0x00, 0x80, 0x60, 0xF0, 0x90, 0x30, 0x80, 0x00, 0x70,
-                     0xB0, 0x40, 0x10, 0xF0, 0x20, 0xE0, 0xC0, 0x30, 0x50, 0xB0, 0xA0, 0x50, 0xE0, 0x20, 0x70, 0xC0};
-
-uint8_t SLUT4[64] = {0x07, 0x0D, 0x0D, 0x08, 0x0E, 0x0B, 0x03, 0x05, 0x00, 0x06, 0x06, 0x0F, 0x09, 0x00, 0x0A, 0x03,
-                     0x01, 0x04, 0x02, 0x07, 0x08, 0x02, 0x05, 0x0C, 0x0B, 0x01, 0x0C, 0x0A, 0x04, 0x0E, 0x0F, 0x09,
-                     0x0A, 0x03, 0x06, 0x0F, 0x09, 0x00, 0x00, 0x06, 0x0C, 0x0A, 0x0B, 0x01, 0x07, 0x0D, 0x0D, 0x08,
-                     0x0F, 0x09, 0x01, 0x04, 0x03, 0x05, 0x0E, 0x0B, 0x05, 0x0C, 0x02, 0x07, 0x08, 0x02, 0x04, 0x0E};
-
-uint8_t SLUT5[64] = {0x20, 0xE0, 0xC0, 0xB0, 0x40, 0x20, 0x10, 0xC0, 0x70, 0x40, 0xA0, 0x70, 0xB0, 0xD0, 0x60, 0x10,
-                     0x80, 0x50, 0x50, 0x00, 0x30, 0xF0, 0xF0, 0xA0, 0xD0, 0x30, 0x00, 0x90, 0xE0, 0x80, 0x90, 0x60,
-                     0x40, 0xB0, 0x20, 0x80, 0x10, 0xC0, 0xB0, 0x70, 0xA0, 0x10, 0xD0, 0xE0, 0x70, 0x20, 0x80, 0xD0,
-                     0xF0, 0x60, 0x90, 0xF0, 0xC0, 0x00, 0x50, 0x90, 0x60, 0xA0, 0x30, 0x40, 0x00, 0x50, 0xE0, 0x30};
-
-uint8_t SLUT6[64] = {0x0C, 0x0A, 0x01, 0x0F, 0x0A, 0x04, 0x0F, 0x02, 0x09, 0x07, 0x02, 0x0C, 0x06, 0x09, 0x08, 0x05,
-                     0x00, 0x06, 0x0D, 0x01, 0x03, 0x0D, 0x04, 0x0E, 0x0E, 0x00, 0x07, 0x0B, 0x05, 0x03, 0x0B, 0x08,
-                     0x09, 0x04, 0x0E, 0x03, 0x0F, 0x02, 0x05, 0x0C, 0x02, 0x09, 0x08, 0x05, 0x0C, 0x0F, 0x03, 0x0A,
-                     0x07, 0x0B, 0x00, 0x0E, 0x04, 0x01, 0x0A, 0x07, 0x01, 0x06, 0x0D, 0x00, 0x0B, 0x08, 0x06, 0x0D};
-
-uint8_t SLUT7[64] = {0x40, 0xD0, 0xB0, 0x00, 0x20, 0xB0, 0xE0, 0x70, 0xF0, 0x40, 0x00, 0x90, 0x80, 0x10, 0xD0, 0xA0,
-                     0x30, 0xE0, 0xC0, 0x30, 0x90, 0x50, 0x70, 0xC0, 0x50, 0x20, 0xA0, 0xF0, 0x60, 0x80, 0x10, 0x60,
-                     0x10, 0x60, 0x40, 0xB0, 0xB0, 0xD0, 0xD0, 0x80, 0xC0, 0x10, 0x30, 0x40, 0x70, 0xA0, 0xE0, 0x70,
-                     0xA0, 0x90, 0xF0, 0x50, 0x60, 0x00, 0x80, 0xF0, 0x00, 0xE0, 0x50, 0x20, 0x90, 0x30, 0x20, 0xC0};
-
-uint8_t SLUT8[64] = {0x0D, 0x01, 0x02, 0x0F, 0x08, 0x0D, 0x04, 0x08, 0x06, 0x0A, 0x0F, 0x03, 0x0B, 0x07, 0x01, 0x04,
-                     0x0A, 0x0C, 0x09, 0x05, 0x03, 0x06, 0x0E, 0x0B, 0x05, 0x00, 0x00, 0x0E, 0x0C, 0x09, 0x07, 0x02,
-                     0x07, 0x02, 0x0B, 0x01, 0x04, 0x0E, 0x01, 0x07, 0x09, 0x04, 0x0C, 0x0A, 0x0E, 0x08, 0x02, 0x0D,
-                     0x00, 0x0F, 0x06, 0x0C, 0x0A, 0x09, 0x0D, 0x00, 0x0F, 0x03, 0x03, 0x05, 0x05, 0x06, 0x08, 0x0B};
-
-//initial permutation IP (on input)
-uint8_t initial_register_permutation[64] = {58, 50, 42, 34, 26, 18, 10, 2, 60, 52, 44, 36, 28, 20, 12, 4,
-                                            62, 54, 46, 38, 30, 22, 14, 6, 64, 56, 48, 40, 32, 24, 16, 8,
-                                            57, 49, 41, 33, 25, 17, 9,  1, 59, 51, 43, 35, 27, 19, 11, 3,
-                                            61, 53, 45, 37, 29, 21, 13, 5, 63, 55, 47, 39, 31, 23, 15, 7};
-
-//D-Box Expansion (sometimes noted as E BIT-SELECTION TABLE)
-uint8_t message_expansion[48] = {32, 1,  2,  3,  4,  5,  4,  5,  6,  7,  8,  9,  8,  9,  10, 11,
-                                 12, 13, 12, 13, 14, 15, 16, 17, 16, 17, 18, 19, 20, 21, 20, 21,
-                                 22, 23, 24, 25, 24, 25, 26, 27, 28, 29, 28, 29, 30, 31, 32, 1};
-
-// (sometimes noted as simply 'P')
-uint8_t right_half_permutation[32] = {16, 7, 20, 21, 29, 12, 28, 17, 1,  15, 23, 26, 5,  18, 31, 10,
-                                      2,  8, 24, 14, 32, 27, 3,  9,  19, 13, 30, 6,  22, 11, 4,  25};
-
-//inverse initial PI, a.k.a. final permutation (on output)
-uint8_t final_register_permutation[64] = {40, 8, 48, 16, 56, 24, 64, 32, 39, 7, 47, 15, 55, 23, 63, 31,
-                                          38, 6, 46, 14, 54, 22, 62, 30, 37, 5, 45, 13, 53, 21, 61, 29,
-                                          36, 4, 44, 12, 52, 20, 60, 28, 35, 3, 43, 11, 51, 19, 59, 27,
-                                          34, 2, 42, 10, 50, 18, 58, 26, 33, 1, 41, 9,  49, 17, 57, 25};
+//NOTE: The SP boxes fold each S box together with the P permutation, so one round is
+//eight table lookups XOR'd together. Entry x of box i is P(S_i(x)) as a 32-bit word with
+//DES bit 1 in the MSB; the 6-bit index is the raw E-expanded group (row = b1b6, col = b2..b5).
+
+static const uint32_t des_spbox[8][64] = {
+    {
+        0x00808200U, 0x00000000U, 0x00008000U, 0x00808202U, 0x00808002U, 0x00008202U,
+        0x00000002U, 0x00008000U, 0x00000200U, 0x00808200U, 0x00808202U, 0x00000200U,
+        0x00800202U, 0x00808002U, 0x00800000U, 0x00000002U, 0x00000202U, 0x00800200U,
+        0x00800200U, 0x00008200U, 0x00008200U, 0x00808000U, 0x00808000U, 0x00800202U,
+        0x00008002U, 0x00800002U, 0x00800002U, 0x00008002U, 0x00000000U, 0x00000202U,
+        0x00008202U, 0x00800000U, 0x00008000U, 0x00808202U, 0x00000002U, 0x00808000U,
+        0x00808200U, 0x00800000U, 0x00800000U, 0x00000200U, 0x00808002U, 0x00008000U,
+        0x00008200U, 0x00800002U, 0x00000200U, 0x00000002U, 0x00800202U, 0x00008202U,
+        0x00808202U, 0x00008002U, 0x00808000U, 0x00800202U, 0x00800002U, 0x00000202U,
+        0x00008202U, 0x00808200U, 0x00000202U, 0x00800200U, 0x00800200U, 0x00000000U,
+        0x00008002U, 0x00008200U, 0x00000000U, 0x00808002U,
+    },
+    {
+        0x40084010U, 0x40004000U, 0x00004000U, 0x00084010U, 0x00080000U, 0x00000010U,
+        0x40080010U, 0x40004010U, 0x40000010U, 0x40084010U, 0x40084000U, 0x40000000U,
+        0x40004000U, 0x00080000U, 0x00000010U, 0x40080010U, 0x00084000U, 0x00080010U,
+        0x40004010U, 0x00000000U, 0x40000000U, 0x00004000U, 0x00084010U, 0x40080000U,
+        0x00080010U, 0x40000010U, 0x00000000U, 0x00084000U, 0x00004010U, 0x40084000U,
+        0x40080000U, 0x00004010U, 0x00000000U, 0x00084010U, 0x40080010U, 0x00080000U,
+        0x40004010U, 0x40080000U, 0x40084000U, 0x00004000U, 0x40080000U, 0x40004000U,
+        0x00000010U, 0x40084010U, 0x00084010U, 0x00000010U, 0x00004000U, 0x40000000U,
+        0x00004010U, 0x40084000U, 0x00080000U, 0x40000010U, 0x00080010U, 0x40004010U,
+        0x40000010U, 0x00080010U, 0x00084000U, 0x00000000U, 0x40004000U, 0x00004010U,
+        0x40000000U, 0x40080010U, 0x40084010U, 0x00084000U,
+    },
+    {
+        0x00000104U, 0x04010100U, 0x00000000U, 0x04010004U, 0x04000100U, 0x00000000U,
+        0x00010104U, 0x04000100U, 0x00010004U, 0x04000004U, 0x04000004U, 0x00010000U,
+        0x04010104U, 0x00010004U, 0x04010000U, 0x00000104U, 0x04000000U, 0x00000004U,
+        0x04010100U, 0x00000100U, 0x00010100U, 0x04010000U, 0x04010004U, 0x00010104U,
+        0x04000104U, 0x00010100U, 0x00010000U, 0x04000104U, 0x00000004U, 0x04010104U,
+        0x00000100U, 0x04000000U, 0x04010100U, 0x04000000U, 0x00010004U, 0x00000104U,
+        0x00010000U, 0x04010100U, 0x04000100U, 0x00000000U, 0x00000100U, 0x00010004U,
+        0x04010104U, 0x04000100U, 0x04000004U, 0x00000100U, 0x00000000U, 0x04010004U,
+        0x04000104U, 0x00010000U, 0x04000000U, 0x04010104U, 0x00000004U, 0x00010104U,
+        0x00010100U, 0x04000004U, 0x04010000U, 0x04000104U, 0x00000104U, 0x04010000U,
+        0x00010104U, 0x00000004U, 0x04010004U, 0x00010100U,
+    },
+    {
+        0x80401000U, 0x80001040U, 0x80001040U, 0x00000040U, 0x00401040U, 0x80400040U,
+        0x80400000U, 0x80001000U, 0x00000000U, 0x00401000U, 0x00401000U, 0x80401040U,
+        0x80000040U, 0x00000000U, 0x00400040U, 0x80400000U, 0x80000000U, 0x00001000U,
+        0x00400000U, 0x80401000U, 0x00000040U, 0x00400000U, 0x80001000U, 0x00001040U,
+        0x80400040U, 0x80000000U, 0x00001040U, 0x00400040U, 0x00001000U, 0x00401040U,
+        0x80401040U, 0x80000040U, 0x00400040U, 0x80400000U, 0x00401000U, 0x80401040U,
+        0x80000040U, 0x00000000U, 0x00000000U, 0x00401000U, 0x00001040U, 0x00400040U,
+        0x80400040U, 0x80000000U, 0x80401000U, 0x80001040U, 0x80001040U, 0x00000040U,
+        0x80401040U, 0x80000040U, 0x80000000U, 0x00001000U, 0x80400000U, 0x80001000U,
+        0x00401040U, 0x80400040U, 0x80001000U, 0x00001040U, 0x00400000U, 0x80401000U,
+        0x00000040U, 0x00400000U, 0x00001000U, 0x00401040U,
+    },
+    {
+        0x00000080U, 0x01040080U, 0x01040000U, 0x21000080U, 0x00040000U, 0x00000080U,
+        0x20000000U, 0x01040000U, 0x20040080U, 0x00040000U, 0x01000080U, 0x20040080U,
+        0x21000080U, 0x21040000U, 0x00040080U, 0x20000000U, 0x01000000U, 0x20040000U,
+        0x20040000U, 0x00000000U, 0x20000080U, 0x21040080U, 0x21040080U, 0x01000080U,
+        0x21040000U, 0x20000080U, 0x00000000U, 0x21000000U, 0x01040080U, 0x01000000U,
+        0x21000000U, 0x00040080U, 0x00040000U, 0x21000080U, 0x00000080U, 0x01000000U,
+        0x20000000U, 0x01040000U, 0x21000080U, 0x20040080U, 0x01000080U, 0x20000000U,
+        0x21040000U, 0x01040080U, 0x20040080U, 0x00000080U, 0x01000000U, 0x21040000U,
+        0x21040080U, 0x00040080U, 0x21000000U, 0x21040080U, 0x01040000U, 0x00000000U,
+        0x20040000U, 0x21000000U, 0x00040080U, 0x01000080U, 0x20000080U, 0x00040000U,
+        0x00000000U, 0x20040000U, 0x01040080U, 0x20000080U,
+    },
+    {
+        0x10000008U, 0x10200000U, 0x00002000U, 0x10202008U, 0x10200000U, 0x00000008U,
+        0x10202008U, 0x00200000U, 0x10002000U, 0x00202008U, 0x00200000U, 0x10000008U,
+        0x00200008U, 0x10002000U, 0x10000000U, 0x00002008U, 0x00000000U, 0x00200008U,
+        0x10002008U, 0x00002000U, 0x00202000U, 0x10002008U, 0x00000008U, 0x10200008U,
+        0x10200008U, 0x00000000U, 0x00202008U, 0x10202000U, 0x00002008U, 0x00202000U,
+        0x10202000U, 0x10000000U, 0x10002000U, 0x00000008U, 0x10200008U, 0x00202000U,
+        0x10202008U, 0x00200000U, 0x00002008U, 0x10000008U, 0x00200000U, 0x10002000U,
+        0x10000000U, 0x00002008U, 0x10000008U, 0x10202008U, 0x00202000U, 0x10200000U,
+        0x00202008U, 0x10202000U, 0x00000000U, 0x10200008U, 0x00000008U, 0x00002000U,
+        0x10200000U, 0x00202008U, 0x00002000U, 0x00200008U, 0x10002008U, 0x00000000U,
+        0x10202000U, 0x10000000U, 0x00200008U, 0x10002008U,
+    },
+    {
+        0x00100000U, 0x02100001U, 0x02000401U, 0x00000000U, 0x00000400U, 0x02000401U,
+        0x00100401U, 0x02100400U, 0x02100401U, 0x00100000U, 0x00000000U, 0x02000001U,
+        0x00000001U, 0x02000000U, 0x02100001U, 0x00000401U, 0x02000400U, 0x00100401U,
+        0x00100001U, 0x02000400U, 0x02000001U, 0x02100000U, 0x02100400U, 0x00100001U,
+        0x02100000U, 0x00000400U, 0x00000401U, 0x02100401U, 0x00100400U, 0x00000001U,
+        0x02000000U, 0x00100400U, 0x02000000U, 0x00100400U, 0x00100000U, 0x02000401U,
+        0x02000401U, 0x02100001U, 0x02100001U, 0x00000001U, 0x00100001U, 0x02000000U,
+        0x02000400U, 0x00100000U, 0x02100400U, 0x00000401U, 0x00100401U, 0x02100400U,
+        0x00000401U, 0x02000001U, 0x02100401U, 0x02100000U, 0x00100400U, 0x00000000U,
+        0x00000001U, 0x02100401U, 0x00000000U, 0x00100401U, 0x02100000U, 0x00000400U,
+        0x02000001U, 0x02000400U, 0x00000400U, 0x00100001U,
+    },
+    {
+        0x08000820U, 0x00000800U, 0x00020000U, 0x08020820U, 0x08000000U, 0x08000820U,
+        0x00000020U, 0x08000000U, 0x00020020U, 0x08020000U, 0x08020820U, 0x00020800U,
+        0x08020800U, 0x00020820U, 0x00000800U, 0x00000020U, 0x08020000U, 0x08000020U,
+        0x08000800U, 0x00000820U, 0x00020800U, 0x00020020U, 0x08020020U, 0x08020800U,
+        0x00000820U, 0x00000000U, 0x00000000U, 0x08020020U, 0x08000020U, 0x08000800U,
+        0x00020820U, 0x00020000U, 0x00020820U, 0x00020000U, 0x08020800U, 0x00000800U,
+        0x00000020U, 0x08020020U, 0x00000800U, 0x00020820U, 0x08000800U, 0x00000020U,
+        0x08000020U, 0x08020000U, 0x08020020U, 0x08000000U, 0x00020000U, 0x08000820U,
+        0x00000000U, 0x08020820U, 0x00020020U, 0x08000020U, 0x08020000U, 0x08000800U,
+        0x08000820U, 0x00000000U, 0x08020820U, 0x00020800U, 0x00020800U, 0x00000820U,
+        0x00000820U, 0x00020020U, 0x08000000U, 0x08020800U,
+    },
+};
 
 //initial key permutation
-uint8_t pc1_key_permutation[56] = {57, 49, 41, 33, 25, 17, 9,  1,  58, 50, 42, 34, 26, 18, 10, 2,  59, 51, 43,
-                                   35, 27, 19, 11, 3,  60, 52, 44, 36, 63, 55, 47, 39, 31, 23, 15, 7,  62, 54,
-                                   46, 38, 30, 22, 14, 6,  61, 53, 45, 37, 29, 21, 13, 5,  28, 20, 12, 4};
-
-//sub c and d key permutation
-uint8_t pc2_key_permutation[48] = {
-    //c bits
-    14, 17, 11, 24, 1, 5, 3, 28, 15, 6, 21, 10, 23, 19, 12, 4, 26, 8, 16, 7, 27, 20, 13, 2,
-    //d bits (with -28 offset to simply/only have one permute function)
-    13, 24, 3, 9, 19, 27, 2, 12, 23, 17, 5, 20, 16, 21, 11, 28, 6, 25, 18, 14, 22, 8, 1, 4};
-
-uint8_t key_shift_sizes[17] = {1, 1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1};
-
-uint8_t key_shift_bytes[17] = {0x80, 0x80, 0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
-                               0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x80};
+static const uint8_t pc1_key_permutation[56] = {
+    57, 49, 41, 33, 25, 17, 9,  1,  58, 50, 42, 34, 26, 18, 10, 2,  59, 51, 43, 35, 27, 19, 11, 3,  60, 52, 44, 36,
+    63, 55, 47, 39, 31, 23, 15, 7,  62, 54, 46, 38, 30, 22, 14, 6,  61, 53, 45, 37, 29, 21, 13, 5,  28, 20, 12, 4};
 
-uint8_t key_shift_x[4] = {8, 8, 8, 4};
+//sub key permutation, indexed into the 56-bit C||D register
+static const uint8_t pc2_key_permutation[48] = {14, 17, 11, 24, 1,  5,  3,  28, 15, 6,  21, 10, 23, 19, 12, 4,
+                                                26, 8,  16, 7,  27, 20, 13, 2,  41, 52, 31, 37, 47, 55, 30, 40,
+                                                51, 45, 33, 48, 44, 49, 39, 56, 34, 53, 46, 42, 50, 36, 29, 32};
 
-uint8_t key_shift_y[4] = {1, 2, 3, 0};
+static const uint8_t key_shift_sizes[16] = {1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1};
 
-//input is byte-wise array, output is byte-wise array
-void
-permute(uint8_t* input, uint8_t* output, uint8_t* table, uint8_t start, uint8_t end) {
+static inline uint32_t
+des_load32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
 
-    for (uint8_t i = start; i < end; i++) {
-        uint8_t tdiv = (table[i] - 1) / 8;
-        uint8_t tmod = (table[i] - 1) % 8;
-        uint8_t idiv = i / 8;
-        uint8_t imod = i % 8;
+static inline void
+des_store32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
 
-        //need a way to simplify or get rid of all these shifts
-        uint8_t bit = (((input[tdiv] & (0x80 >> tmod)) << tmod) >> imod);
-        output[idiv] |= bit;
-    }
+static inline uint32_t
+des_rotl32(uint32_t v, unsigned n) {
+    return (v << n) | (v >> (32u - n));
 }
 
-void
-rotate_sub_keys(uint8_t* Kc, uint8_t* Kd, uint8_t shift_size, uint8_t shift_byte) {
+//swap the bits selected by m in a>>n with the same bits in b; IP and FP are each five of these
+#define DES_PERM_OP(a, b, n, m)                                                                                        \
+    do {                                                                                                               \
+        uint32_t w_ = (((a) >> (n)) ^ (b)) & (m);                                                                      \
+        (b) ^= w_;                                                                                                     \
+        (a) ^= w_ << (n);                                                                                              \
+    } while (0)
 
-    uint8_t sb1[4];
-    memset(sb1, 0, sizeof(sb1));
-    uint8_t sb2[4];
-    memset(sb2, 0, sizeof(sb2));
+void
+des_key_setup(des_key_schedule* ks, const uint8_t* main_key) {
 
-    for (uint8_t i = 0; i < 4; i++) {
-        sb1[i] = shift_byte & Kc[i];
-        sb2[i] = shift_byte & Kd[i];
+    uint64_t key = 0, cd = 0;
+    for (int i = 0; i < 8; i++) {
+        key = (key << 8) | main_key[i];
     }
 
-    for (uint8_t i = 0; i < 4; i++) {
-
-        uint8_t x = key_shift_x[i];
-        uint8_t y = key_shift_y[i];
-
-        Kc[i] <<= shift_size;
-        Kd[i] <<= shift_size;
+    //PC1 into a 56-bit C||D register, C in the upper 28 bits
+    for (int i = 0; i < 56; i++) {
+        cd = (cd << 1) | ((key >> (64 - pc1_key_permutation[i])) & 1);
+    }
+    uint32_t c = (uint32_t)(cd >> 28) & 0x0FFFFFFF;
+    uint32_t d = (uint32_t)cd & 0x0FFFFFFF;
+
+    for (int r = 0; r < 16; r++) {
+        unsigned s = key_shift_sizes[r];
+        c = ((c << s) | (c >> (28 - s))) & 0x0FFFFFFF;
+        d = ((d << s) | (d >> (28 - s))) & 0x0FFFFFFF;
+        cd = ((uint64_t)c << 28) | d;
+
+        uint64_t k = 0;
+        for (int i = 0; i < 48; i++) {
+            k = (k << 1) | ((cd >> (56 - pc2_key_permutation[i])) & 1);
+        }
 
-        Kc[i] |= (sb1[y] >> (x - shift_size));
-        Kd[i] |= (sb2[y] >> (x - shift_size));
+        //split the 48-bit subkey into the even and odd 6-bit groups, lined up with the
+        //two rotated copies of R used by the round function below
+        uint32_t k0 = 0, k1 = 0;
+        for (int g = 0; g < 4; g++) {
+            k0 |= (uint32_t)((k >> (42 - 12 * g)) & 0x3F) << (26 - 8 * g);
+            k1 |= (uint32_t)((k >> (36 - 12 * g)) & 0x3F) << (26 - 8 * g);
+        }
+        ks->k[r][0] = k0;
+        ks->k[r][1] = k1;
     }
 }
 
 void
-des_cipher(uint8_t* main_key, uint8_t* input_register, uint8_t* output_register, uint8_t de) {
-
-    //starting and ending permutations
-    uint8_t initial_permutation[8];
-    memset(initial_permutation, 0, sizeof(initial_permutation));
-    uint8_t pre_end_permutation[8];
-    memset(pre_end_permutation, 0, sizeof(pre_end_permutation));
-
-    //intermediate left, right, and expansion/selection arrays
-    uint8_t left[4];
-    memset(left, 0, sizeof(left));
-    uint8_t right[4];
-    memset(right, 0, sizeof(right));
-    uint8_t rperm[4];
-    memset(rperm, 0, sizeof(rperm));
-    uint8_t exp[6];
-    memset(exp, 0, sizeof(exp));
-    uint8_t sel[4];
-    memset(sel, 0, sizeof(sel));
-
-    //key sets
-    uint8_t Ks[16][7];
-    memset(Ks, 0, sizeof(Ks));
-    uint8_t Kc[4];
-    memset(Kc, 0, sizeof(Kc));
-    uint8_t Kd[4];
-    memset(Kd, 0, sizeof(Kd));
-
-    //initial Ks permutation and shuffle to Kc and Kd
-    permute(main_key, Ks[0], pc1_key_permutation, 0, 56);
-    for (uint8_t i = 0; i < 3; i++) {
-        Kc[i] = Ks[0][i];
-    }
-    Kc[3] = Ks[0][3] & 0xF0;
-    for (uint8_t i = 0; i < 3; i++) {
-        Kd[i] = (Ks[0][i + 3] & 0x0F) << 4;
-        Kd[i] |= (Ks[0][i + 4] & 0xF0) >> 4;
+des_crypt_block(const des_key_schedule* ks, const uint8_t* input_register, uint8_t* output_register, uint8_t de) {
+
+    uint32_t l = des_load32(input_register);
+    uint32_t r = des_load32(input_register + 4);
+
+    //initial permutation
+    DES_PERM_OP(l, r, 4, 0x0F0F0F0FU);
+    DES_PERM_OP(l, r, 16, 0x0000FFFFU);
+    DES_PERM_OP(r, l, 2, 0x33333333U);
+    DES_PERM_OP(r, l, 8, 0x00FF00FFU);
+    DES_PERM_OP(l, r, 1, 0x55555555U);
+
+    //16 fiestel rounds (encryption cycles Ks forward, decryption goes in reverse); E is applied
+    //implicitly: groups 1,3,5,7 come from R rotated right by 1, groups 2,4,6,8 from R rotated left by 3
+    for (int f = 0; f < 16; f++) {
+        const uint32_t* k = ks->k[de ? f : 15 - f];
+        uint32_t t = des_rotl32(r, 31) ^ k[0];
+        uint32_t u = des_rotl32(r, 3) ^ k[1];
+        uint32_t fr = des_spbox[0][(t >> 26) & 0x3F] ^ des_spbox[2][(t >> 18) & 0x3F] ^ des_spbox[4][(t >> 10) & 0x3F]
+                      ^ des_spbox[6][(t >> 2) & 0x3F] ^ des_spbox[1][(u >> 26) & 0x3F]
+                      ^ des_spbox[3][(u >> 18) & 0x3F] ^ des_spbox[5][(u >> 10) & 0x3F] ^ des_spbox[7][(u >> 2) & 0x3F];
+        fr ^= l;
+        l = r;
+        r = fr;
     }
-    Kd[3] = (Ks[0][6] & 0x0F) << 4;
-
-    //reset Ks
-    memset(Ks, 0, sizeof(Ks));
-
-    //create the 16 Ks rounds
-    for (uint8_t i = 0; i < 16; i++) {
-        uint8_t shift_size = key_shift_sizes[i + 1];
-        uint8_t shift_byte = key_shift_bytes[i + 1];
-        rotate_sub_keys(Kc, Kd, shift_size, shift_byte);
-        permute(Kc, Ks[i], pc2_key_permutation, 0, 24);
-        permute(Kd, Ks[i], pc2_key_permutation, 24, 48);
-    }
-
-    //permute the input_register with the ip (initial_register_permutation) table
-    permute(input_register, initial_permutation, initial_register_permutation, 0, 64);
-
-    //copy the initial permutation to left and right half arrays
-    memcpy(left, initial_permutation + 0, sizeof(left));
-    memcpy(right, initial_permutation + 4, sizeof(right));
-
-    //16 fiestel rounds
-    for (uint8_t f = 0; f < 16; f++) {
-
-        //reset rperm and exp arrays
-        memset(rperm, 0, sizeof(rperm));
-        memset(exp, 0, sizeof(exp));
-
-        //expand right half from 32-bit to 48-bit
-        permute(right, exp, message_expansion, 0, 48);
-
-        //apply current iteration keyset to the expanded array (encryption cycles Ks forward, decryption goes in reverse)
-        if (de == 1) {
-            for (uint8_t i = 0; i < 6; i++) {
-                exp[i] ^= Ks[f][i];
-            }
-        } else {
-            for (uint8_t i = 0; i < 6; i++) {
-                exp[i] ^= Ks[15 - f][i];
-            }
-        }
-
-        //extract 6 bits for each sbox swap from the expanded array
-        uint8_t e1 = exp[0] >> 2;
-        uint8_t e2 = ((exp[0] & 0x3) << 4) | (exp[1] >> 4);
-        uint8_t e3 = ((exp[1] & 0xF) << 2) | (exp[2] >> 6);
-        uint8_t e4 = exp[2] & 0x3F;
-
-        uint8_t e5 = exp[3] >> 2;
-        uint8_t e6 = ((exp[3] & 0x3) << 4) | (exp[4] >> 4);
-        uint8_t e7 = ((exp[4] & 0xF) << 2) | (exp[5] >> 6);
-        uint8_t e8 = exp[5] & 0x3F;
-
-        //select 32-bits of each 48-bit expansion via modified S Box Look Up Tables
-        //swap the 6 bits for 4 bits via SLUT tables and OR them together into a selection array
-        sel[0] = SLUT1[e1] | SLUT2[e2];
-        sel[1] = SLUT3[e3] | SLUT4[e4];
-        sel[2] = SLUT5[e5] | SLUT6[e6];
-        sel[3] = SLUT7[e7] | SLUT8[e8];
-
-        //permute the selected 32-bits into a new right half
-        permute(sel, rperm, right_half_permutation, 0, 32);
-
-        //xor new right half against left half
-        for (uint8_t i = 0; i < 4; i++) {
-            rperm[i] ^= left[i];
-        }
 
-        //swap old right half to left, set new right half to rperm
-        memcpy(left, right, sizeof(left));
-        memcpy(right, rperm, sizeof(right));
+    //pre-output is R16||L16, then the final permutation (IP steps undone in reverse)
+    DES_PERM_OP(r, l, 1, 0x55555555U);
+    DES_PERM_OP(l, r, 8, 0x00FF00FFU);
+    DES_PERM_OP(l, r, 2, 0x33333333U);
+    DES_PERM_OP(r, l, 16, 0x0000FFFFU);
+    DES_PERM_OP(r, l, 4, 0x0F0F0F0FU);
 
-    } //end fiestel rounds f
+    des_store32(output_register, r);
+    des_store32(output_register + 4, l);
+}
 
-    //combine right and left into the pre_end_permutation array
-    memcpy(pre_end_permutation + 0, right, sizeof(right));
-    memcpy(pre_end_permutation + 4, left, sizeof(left));
+//single-shot convenience; builds the schedule for one block, so loops should use des_key_setup once instead
+void
+des_cipher(uint8_t* main_key, uint8_t* input_register, uint8_t* output_register, uint8_t de) {
+    des_key_schedule ks;
+    des_key_setup(&ks, main_key);
+    des_crypt_block(&ks, input_register, output_register, de);
+}
 
-    //carry out the final permuation to get the completed output_register for this cipher iteration
-    permute(pre_end_permutation, output_register, final_register_permutation, 0, 64);
+//one TDEA pass: first and third keys run in mode de, the middle key in the opposite mode
+static inline void
+tdea_crypt_block(const des_key_schedule* ka, const des_key_schedule* kb, const des_key_schedule* kc,
+                 const uint8_t* in, uint8_t* out, uint8_t de) {
+    uint8_t tmp[8];
+    des_crypt_block(ka, in, tmp, de);
+    des_crypt_block(kb, tmp, tmp, de ^ 1);
+    des_crypt_block(kc, tmp, out, de);
 }
 
 void
 des56_ofb_keystream_output(uint8_t* main_key, uint8_t* iv, uint8_t* ks_bytes, uint8_t de, int16_t nblocks) {
 
-    //cipher input and output
-    uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
+    des_key_schedule ks;
+    des_key_setup(&ks, main_key);
 
     //copy the IV to the input_register (make copy so we don't manipulate the calling functions copy)
+    uint8_t input_register[8];
     memcpy(input_register, iv, sizeof(input_register));
 
-    //execute the des_cipher in output feedback mode
+    //execute the des_cipher in output feedback mode, de should be 1 here for encryption mode
     for (int16_t i = 0; i < nblocks; i++) {
-        //de should be 1 here for encryption mode
-        des_cipher(main_key, input_register, output_register, de);
-        memcpy(input_register, output_register,
-               sizeof(output_register)); //recycle output_register back into input register
-        memcpy(ks_bytes + ((size_t)i * 8), output_register,
-               sizeof(output_register)); //copy output_register to ks_bytes + iteration offset of times 8
-        memset(output_register, 0, sizeof(output_register)); //reset output register
+        des_crypt_block(&ks, input_register, input_register, de);
+        memcpy(ks_bytes + ((size_t)i * 8), input_register, sizeof(input_register));
     }
 }
 
@@ -290,42 +280,18 @@ des56_ecb_payload_crypt(uint8_t* main_key, uint8_t* input_register, uint8_t* out
 }
 
 //TDEA, or triple data encryption algorithm, or triple DES, in electronic codebook mode
+//For TDEA, the cipher alternates between encryption and decryption to the payload
+//so, for example, K1 is run as de=1, K2 is run as de=0, and K3 is run as de=1,
+//K1 and K3 will always use the same mode and K2 will be the opposite
+//NOTE: If running ECB mode in decryption, make sure to send the keys in reverse order
+//so that its K3, K2, and K1 for decryption, and K1, K2, K3 for encryption
 void
 tdea_ecb_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* input, uint8_t* output, uint8_t de) {
-
-    //cipher input and output
-    uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
-
-    //copy the input to the input_register (make copy so we don't manipulate the calling functions copy)
-    memcpy(input_register, input, sizeof(input_register));
-
-    //For TDEA, the cipher alternates between encryption and decryption to the payload
-    //so, for example, K1 is run as de=1, K2 is run as de=0, and K3 is run as de=1,
-    //K1 and K3 will always use the same mode and K2 will be the opposite
-
-    //NOTE: If running ECB mode in decryption, make sure to send the keys in reverse order
-    //so that its K3, K2, and K1 for decryption, and K1, K2, K3 for encryption
-
-    //K1
-    des_cipher(K1, input_register, output_register, de);
-    memcpy(input_register, output_register, sizeof(output_register)); //recycle output_register back into input_register
-    memset(output_register, 0, sizeof(output_register));              //reset output register
-
-    //K2
-    de = (de ^ 1) & 1; //flip the de bit
-    des_cipher(K2, input_register, output_register, de);
-    memcpy(input_register, output_register, sizeof(output_register)); //recycle output_register back into input_register
-    memset(output_register, 0, sizeof(output_register));              //reset output register
-
-    //K3
-    de = (de ^ 1) & 1; //flip the de bit back
-    des_cipher(K3, input_register, output_register, de);
-
-    //copy payload out
-    memcpy(output, output_register, sizeof(output_register)); //copy output_register to output
+    des_key_schedule k1, k2, k3;
+    des_key_setup(&k1, K1);
+    des_key_setup(&k2, K2);
+    des_key_setup(&k3, K3);
+    tdea_crypt_block(&k1, &k2, &k3, input, output, de);
 }
 
 //TDEA, or triple data encryption algorithm, or triple DES, in cipher block chain mode (64-bit)
@@ -335,95 +301,36 @@ void
 tdea_cbc_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* in, uint8_t* out, int16_t nblocks,
                        uint8_t de) {
 
-    int16_t i, j;
-
-    //cipher input and output
-    uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
+    des_key_schedule k1, k2, k3;
+    des_key_setup(&k1, K1);
+    des_key_setup(&k2, K2);
+    des_key_setup(&k3, K3);
 
-    //load first round of input_register accordingly
-    if (de) {
-        memcpy(input_register, iv, sizeof(input_register)); //load the IV as first input_register if encrypting
-    } else {
-        memcpy(input_register, in, sizeof(input_register)); //load first cipher text as input_register is decrypting
-    }
+    //chaining value: the IV, then the previous cipher text block
+    uint8_t chain[8];
+    memcpy(chain, iv, sizeof(chain));
 
-    //run payload for number of payload nblocks required
-    for (i = 0; i < nblocks; i++) {
+    for (int16_t i = 0; i < nblocks; i++) {
+        uint8_t* src = in + ((size_t)i * 8);
+        uint8_t* dst = out + ((size_t)i * 8);
+        uint8_t reg[8];
 
         if (de) {
-
-            //xor the current input 'in' pt to the current state of the input_register for cbc feedback
-            for (j = 0; j < 8; j++) {
-                input_register[j] ^= in[j + (i * 8)];
+            //xor the current pt into the chaining value, then cipher forward (1,0,1)
+            for (int j = 0; j < 8; j++) {
+                reg[j] = chain[j] ^ src[j];
             }
-
-            //K1
-            des_cipher(K1, input_register, output_register, de);
-            memcpy(input_register, output_register,
-                   sizeof(output_register));                     //recycle output_register back into input_register
-            memset(output_register, 0, sizeof(output_register)); //reset output register
-
-            //K2
-            de = (de ^ 1) & 1; //flip the de bit
-            des_cipher(K2, input_register, output_register, de);
-            memcpy(input_register, output_register,
-                   sizeof(output_register));                     //recycle output_register back into input_register
-            memset(output_register, 0, sizeof(output_register)); //reset output register
-
-            //K3
-            de = (de ^ 1) & 1; //flip the de bit back
-            des_cipher(K3, input_register, output_register, de);
-            memcpy(input_register, output_register,
-                   sizeof(output_register)); //recycle output_register back into input_register
-
-            //copy ciphered output_register to output 'out'
-            memcpy(out + ((size_t)i * 8), output_register, sizeof(output_register));
-            memset(output_register, 0, sizeof(output_register)); //reset output register
-
+            tdea_crypt_block(&k1, &k2, &k3, reg, chain, 1);
+            memcpy(dst, chain, sizeof(chain));
         } else {
-
-            //K3
-            des_cipher(K3, input_register, output_register, de);
-            memcpy(input_register, output_register,
-                   sizeof(output_register));                     //recycle output_register back into input_register
-            memset(output_register, 0, sizeof(output_register)); //reset output register
-
-            //K2
-            de = (de ^ 1) & 1; //flip the de bit
-            des_cipher(K2, input_register, output_register, de);
-            memcpy(input_register, output_register,
-                   sizeof(output_register));                     //recycle output_register back into input_register
-            memset(output_register, 0, sizeof(output_register)); //reset output register
-
-            //K1
-            de = (de ^ 1) & 1; //flip the de bit back
-            des_cipher(K1, input_register, output_register, de);
-            memcpy(input_register, output_register,
-                   sizeof(output_register)); //recycle output_register back into input_register
-
-            //copy ciphered input_register to output 'out'
-            memcpy(out + ((size_t)i * 8), output_register, sizeof(output_register));
-
-            //xor the current output by IV, or by last received CT, depending on round
-            if (i == 0) {
-                for (j = 0; j < 8; j++) {
-                    out[j] ^= iv[j];
-                }
-            } else {
-                for (j = 0; j < 8; j++) {
-                    out[j + ((size_t)i * 8)] ^= in[j + ((size_t)(i - 1) * 8)];
-                }
-            }
-
-            //copy in next segment for input_register (if not last)
-            if (i < nblocks) {
-                memcpy(input_register, in + ((size_t)(i + 1) * 8), sizeof(input_register));
+            //decrypt with the keys reversed (0,1,0), then xor by IV or by the last received CT
+            uint8_t ct[8];
+            memcpy(ct, src, sizeof(ct)); //in and out may alias
+            tdea_crypt_block(&k3, &k2, &k1, ct, reg, 0);
+            for (int j = 0; j < 8; j++) {
+                dst[j] = reg[j] ^ chain[j];
             }
-
-            memset(output_register, 0, sizeof(output_register)); //reset output register
+            memcpy(chain, ct, sizeof(chain));
         }
     }
 }
@@ -435,46 +342,25 @@ tdea_cbc_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8
 void
 tdea_cbc_mac_generator(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* in, uint8_t* out, int16_t nblocks) {
 
-    int16_t i, j;
-
-    //cipher input and output
-    uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
-
-    //run payload for number of payload nblocks required
-    for (i = 0; i < nblocks; i++) {
+    des_key_schedule k1, k2, k3;
+    des_key_setup(&k1, K1);
+    des_key_setup(&k2, K2);
+    des_key_setup(&k3, K3);
 
-        //the cipher is always run in the foward, or encryption mode (1,0,1)
+    uint8_t reg[8];
+    memset(reg, 0, sizeof(reg));
 
-        //xor the current input 'in' pt to the current state of the input_register for cbc feedback
-        for (j = 0; j < 8; j++) {
-            input_register[j] ^= in[j + (i * 8)];
+    //the cipher is always run in the foward, or encryption mode (1,0,1)
+    for (int16_t i = 0; i < nblocks; i++) {
+        for (int j = 0; j < 8; j++) {
+            reg[j] ^= in[j + ((size_t)i * 8)];
         }
+        tdea_crypt_block(&k1, &k2, &k3, reg, reg, 1);
+    }
 
-        //K1
-        des_cipher(K1, input_register, output_register, 1);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K2
-        des_cipher(K2, input_register, output_register, 0);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K3
-        des_cipher(K3, input_register, output_register, 1);
-        memcpy(input_register, output_register, sizeof(output_register));
-
-        //copy ciphered output_register to output 'out'
-        //Since we only want the last output_register,
-        //this will overwrite the out until completion
-        memcpy(out, output_register, sizeof(output_register));
-
-        memset(output_register, 0, sizeof(output_register)); //reset output register
+    //only the last output_register is wanted
+    if (nblocks > 0) {
+        memcpy(out, reg, sizeof(reg));
     }
 }
 
@@ -484,118 +370,58 @@ void
 tdea_cfb_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* in, uint8_t* out, int16_t nblocks,
                        uint8_t de) {
 
-    int16_t i, j;
+    des_key_schedule k1, k2, k3;
+    des_key_setup(&k1, K1);
+    des_key_setup(&k2, K2);
+    des_key_setup(&k3, K3);
 
-    //cipher input and output
     uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
-
-    //copy the IV to the input_register (make copy so we don't manipulate the calling functions copy)
     memcpy(input_register, iv, sizeof(input_register));
 
-    //execute the des_cipher in output feedback mode 3 times using each key and transferring output to input each time
-    for (i = 0; i < nblocks; i++) {
-
-        //the cipher is always run in the foward, or encryption mode (1,0,1)
-
-        //K1
-        des_cipher(K1, input_register, output_register, 1);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K2
-        des_cipher(K2, input_register, output_register, 0);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K3
-        des_cipher(K3, input_register, output_register, 1);
-
-        //xor the current input 'in' to the current state of the input_register for cipher feedback
-        for (j = 0; j < 8; j++) {
-            output_register[j] ^= in[j + ((size_t)i * 8)];
-        }
-
-        memcpy(input_register, output_register,
-               sizeof(output_register)); //recycle output_register back into input_register
-
-        //copy keystream out and reset
-        memcpy(out + ((size_t)i * 8), output_register,
-               sizeof(output_register)); //copy output_register to ks_bytes + iteration offset of times 8
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //if running in decryption mode, we feed in the next round of input
+    //the cipher is always run in the foward, or encryption mode (1,0,1); the feedback is always the cipher text
+    for (int16_t i = 0; i < nblocks; i++) {
+        uint8_t* src = in + ((size_t)i * 8);
+        uint8_t reg[8];
+        tdea_crypt_block(&k1, &k2, &k3, input_register, reg, 1);
         if (!de) {
-            memcpy(input_register, in + ((size_t)i * 8), sizeof(input_register));
+            memcpy(input_register, src, sizeof(input_register));
         }
+        for (int j = 0; j < 8; j++) {
+            reg[j] ^= src[j];
+        }
+        if (de) {
+            memcpy(input_register, reg, sizeof(input_register));
+        }
+        memcpy(out + ((size_t)i * 8), reg, sizeof(reg));
     }
 }
 
 //TDEA, or triple data encryption algorithm, or triple DES, in IV counter mode (tested, working)
+//ctr mode will manipulate the IV, since it needs to keep a rolling counter
 void
 tdea_ctr_payload_crypt(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* input, uint8_t* output,
                        int16_t nblocks) {
 
-    int16_t i, j;
+    des_key_schedule k1, k2, k3;
+    des_key_setup(&k1, K1);
+    des_key_setup(&k2, K2);
+    des_key_setup(&k3, K3);
 
-    //cipher input and output
-    uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
-
-    //copy the IV to the input_register (ctr mode will manipulate the IV, since it needs to keep a rolling counter
-    memcpy(input_register, iv, sizeof(input_register));
-
-    //execute the des_cipher in counter mode 3 times using each key and transferring output to input each time
-    //then the IV is iterated and fed back into the input_register to start the next nblocks loop
-    for (i = 0; i < nblocks; i++) {
+    for (int16_t i = 0; i < nblocks; i++) {
+        uint8_t reg[8];
 
         //CTR mode cipher should always run in the forward (encryption) mode
-
-        //K1
-        des_cipher(K1, input_register, output_register, 1);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K2
-        des_cipher(K2, input_register, output_register, 0);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K3
-        des_cipher(K3, input_register, output_register, 1);
-
-        //set output at current pointer to the xor of input current pointer and the output_register
-        for (j = 0; j < 8; j++) {
-            output[j + (i * 8)] = input[j + (i * 8)] ^ output_register[j];
+        tdea_crypt_block(&k1, &k2, &k3, iv, reg, 1);
+        for (int j = 0; j < 8; j++) {
+            output[j + (i * 8)] = input[j + (i * 8)] ^ reg[j];
         }
 
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
         //increment the IV, and handle roll over (uint8_t will rollover to 0 after 0xFF)
-        for (j = 7; j >= 0; j--) {
-            iv[j]++;
-            if (iv[j] == 0) {
-                continue;
-            } else {
+        for (int j = 7; j >= 0; j--) {
+            if (++iv[j] != 0) {
                 break;
             }
         }
-
-        //debug IV iteration
-        // fprintf (stderr, "\n IV: ");
-        // for (j = 0; j < 8; j++)
-        //   fprintf (stderr, "%02X", iv[j]);
-
-        //feed the new IV into the input register
-        memcpy(input_register, iv, sizeof(input_register));
     }
 }
 
@@ -604,110 +430,87 @@ void
 tdea_tofb_keystream_output(uint8_t* K1, uint8_t* K2, uint8_t* K3, uint8_t* iv, uint8_t* ks_bytes, uint8_t de,
                            int16_t nblocks) {
 
-    //cipher input and output
-    uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
+    des_key_schedule k1, k2, k3;
+    des_key_setup(&k1, K1);
+    des_key_setup(&k2, K2);
+    des_key_setup(&k3, K3);
 
     //copy the IV to the input_register (make copy so we don't manipulate the calling functions copy)
+    uint8_t input_register[8];
     memcpy(input_register, iv, sizeof(input_register));
 
-    //execute the des_cipher in output feedback mode 3 times using each key and transferring output to input each time
     for (int16_t i = 0; i < nblocks; i++) {
-        //K1
-        des_cipher(K1, input_register, output_register, de);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K2
-        de = (de ^ 1) & 1; //flip the de bit
-        des_cipher(K2, input_register, output_register, de);
-        memcpy(input_register, output_register,
-               sizeof(output_register));                     //recycle output_register back into input_register
-        memset(output_register, 0, sizeof(output_register)); //reset output register
-
-        //K3
-        de = (de ^ 1) & 1; //flip the de bit back
-        des_cipher(K3, input_register, output_register, de);
-        memcpy(input_register, output_register,
-               sizeof(output_register)); //recycle output_register back into input_register
-
-        //copy keystream out and reset
-        memcpy(ks_bytes + ((size_t)i * 8), output_register,
-               sizeof(output_register)); //copy output_register to ks_bytes + iteration offset of times 8
-        memset(output_register, 0, sizeof(output_register)); //reset output register
+        tdea_crypt_block(&k1, &k2, &k3, input_register, input_register, de);
+        memcpy(ks_bytes + ((size_t)i * 8), input_register, sizeof(input_register));
     }
 }
 
+static inline uint64_t
+lfsr_64_load(const uint8_t* iv) {
+    return ((uint64_t)des_load32(iv) << 32) | des_load32(iv + 4);
+}
+
+static inline void
+lfsr_64_store(uint8_t* iv, uint64_t lfsr) {
+    des_store32(iv, (uint32_t)(lfsr >> 32));
+    des_store32(iv + 4, (uint32_t)lfsr);
+}
+
+static inline uint64_t
+lfsr_64_step(uint64_t lfsr) {
+    //63,61,45,37,27,14
+    // Polynomial is C(x) = x^64 + x^62 + x^46 + x^38 + x^27 + x^15 + 1
+    uint64_t bit = ((lfsr >> 63) ^ (lfsr >> 61) ^ (lfsr >> 45) ^ (lfsr >> 37) ^ (lfsr >> 26) ^ (lfsr >> 14)) & 0x1;
+    return (lfsr << 1) | bit;
+}
+
 //a linear feedback shift register with maximal taps on 64-bit values that can be run to any specified len,
 //its input is a byte array of up to 8 bytes, and its output is same array packed with new LFSR value in it.
 uint64_t
 lfsr_64_to_len_ca(uint8_t* iv, int16_t len) {
 
-    uint64_t lfsr = 0, bit = 0;
-
-    lfsr = ((uint64_t)iv[0] << 56ULL) + ((uint64_t)iv[1] << 48ULL) + ((uint64_t)iv[2] << 40ULL)
-           + ((uint64_t)iv[3] << 32ULL) + ((uint64_t)iv[4] << 24ULL) + ((uint64_t)iv[5] << 16ULL)
-           + ((uint64_t)iv[6] << 8ULL) + ((uint64_t)iv[7] << 0ULL);
-
-    memset(iv, 0, 8 * sizeof(uint8_t));
+    uint64_t lfsr = lfsr_64_load(iv);
 
     for (int16_t cnt = 0; cnt < len; cnt++) {
-        //63,61,45,37,27,14
-        // Polynomial is C(x) = x^64 + x^62 + x^46 + x^38 + x^27 + x^15 + 1
-        bit = ((lfsr >> 63) ^ (lfsr >> 61) ^ (lfsr >> 45) ^ (lfsr >> 37) ^ (lfsr >> 26) ^ (lfsr >> 14)) & 0x1;
-        lfsr = (lfsr << 1) | bit;
-    }
-
-    for (int16_t i = 0; i < 8; i++) {
-        iv[i] = (lfsr >> (56 - (i * 8))) & 0xFF;
+        lfsr = lfsr_64_step(lfsr);
     }
 
-    // fprintf (stderr, "\n IV(%02d): ", len);
-    // for (int16_t i = 0; i < 8; i++)
-    //   fprintf (stderr, "%02X", iv[i]);
+    lfsr_64_store(iv, lfsr);
 
-    return bit;
+    return len > 0 ? (lfsr & 1) : 0;
 }
 
 void
 des56_ca_keystream_output(uint8_t* main_key, uint8_t* iv, uint8_t* ks_bytes, uint8_t de, int16_t ff, int16_t nbits) {
 
-    //cipher input and output
-    uint8_t input_register[8];
-    memset(input_register, 0, sizeof(input_register));
-    uint8_t output_register[8];
-    memset(output_register, 0, sizeof(output_register));
+    des_key_schedule ks;
+    des_key_setup(&ks, main_key);
 
     //copy the IV to the input_register (make copy so we don't manipulate the calling functions copy)
+    uint8_t input_register[8];
+    uint8_t output_register[8];
     memcpy(input_register, iv, sizeof(input_register));
 
     //fast forward the current input_register state
-    lfsr_64_to_len_ca(input_register, ff);
+    uint64_t lfsr = lfsr_64_load(input_register);
+    for (int16_t i = 0; i < ff; i++) {
+        lfsr = lfsr_64_step(lfsr);
+    }
 
-    //execute the des_cipher in (CA) mode with 1-bit output
+    //execute the des_cipher in (CA) mode with 1-bit output, advancing the lfsr 1 time per bit
     for (int16_t i = 0; i < nbits; i++) {
+        lfsr_64_store(input_register, lfsr);
 
         //de should be 1 here for encryption mode
-        des_cipher(main_key, input_register, output_register, de);
+        des_crypt_block(&ks, input_register, output_register, de);
 
         //keystream accumulation, shift current byte and append
         //single bit from current output register's most significant bit
         ks_bytes[i / 8] <<= 1;
         ks_bytes[i / 8] |= ((output_register[0] >> 7) & 1);
 
-        //advance the input_register with the lfsr 1 time
-        lfsr_64_to_len_ca(input_register, 1);
-
-        //reset output register
-        memset(output_register, 0, sizeof(output_register));
+        lfsr = lfsr_64_step(lfsr);
     }
-
-    // fprintf (stderr, "\n  IR: ");
-    // for (int16_t i = 0; i < 8; i++)
-    //   fprintf (stderr, "%02X", input_register[i]);
 }
 
 //transitional function mainly to load key and iv into an array
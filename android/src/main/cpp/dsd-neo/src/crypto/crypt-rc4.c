@@ -7,6 +7,7 @@
 #include <dsd-neo/core/constants.h>
 #include <dsd-neo/core/opts_fwd.h>
 #include <dsd-neo/core/state.h>
+#include <dsd-neo/crypto/rc4.h>
 
 #include <stdint.h>
 #include <string.h>
@@ -56,6 +57,67 @@ rc4_voice_decrypt(int drop, uint8_t keylength, uint8_t messagelength, uint8_t ke
     }
 }
 
+void
+rc4_stream_reset(rc4_stream* rc) {
+    memset(rc, 0, sizeof(*rc));
+}
+
+static void
+rc4_stream_rekey(rc4_stream* rc, uint8_t keylength, const uint8_t key[]) {
+    int i;
+    uint8_t j = 0, t;
+
+    for (i = 0; i < 256; i++) {
+        rc->S[i] = (uint8_t)i;
+    }
+    for (i = 0; i < 256; i++) {
+        j = (uint8_t)(j + rc->S[i] + key[i % keylength]);
+        t = rc->S[i];
+        rc->S[i] = rc->S[j];
+        rc->S[j] = t;
+    }
+    memcpy(rc->key, key, keylength);
+    rc->keylen = keylength;
+    rc->i = rc->j = 0;
+    rc->pos = 0;
+}
+
+void
+rc4_stream_decrypt(rc4_stream* rc, int drop, uint8_t keylength, uint8_t messagelength, const uint8_t key[],
+                   const uint8_t cipher[], uint8_t plain[]) {
+    if (keylength == 0 || keylength > sizeof(rc->key)) {
+        rc4_voice_decrypt(drop, keylength, messagelength, (uint8_t*)key, (uint8_t*)cipher, plain);
+        return;
+    }
+    if (drop < 0) {
+        drop = 0;
+    }
+    if (rc->keylen != keylength || memcmp(rc->key, key, keylength) != 0 || drop < rc->pos) {
+        rc4_stream_rekey(rc, keylength, key);
+    }
+
+    uint8_t* S = rc->S;
+    uint8_t i = rc->i, j = rc->j, t;
+    for (; rc->pos < drop; rc->pos++) {
+        i++;
+        j = (uint8_t)(j + S[i]);
+        t = S[i];
+        S[i] = S[j];
+        S[j] = t;
+    }
+    for (int n = 0; n < messagelength; n++) {
+        i++;
+        j = (uint8_t)(j + S[i]);
+        t = S[i];
+        S[i] = S[j];
+        S[j] = t;
+        plain[n] = S[(uint8_t)(S[i] + S[j])] ^ cipher[n];
+    }
+    rc->pos += messagelength;
+    rc->i = i;
+    rc->j = j;
+}
+
 //this is for PDU usage
 void
 rc4_block_output(int drop, int keylen, int meslen, uint8_t* key, uint8_t* output_blocks) {
@@ -32,13 +32,9 @@ constexpr float kTwoPi = 6.28318530717958647692f;
 constexpr float kPi = 3.14159265358979323846f;
 
 static inline bool
-debug_cqpsk_enabled(void) {
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    if (!cfg) {
-        dsd_neo_config_init(NULL);
-        cfg = dsd_neo_get_config();
-    }
-    return cfg && cfg->debug_cqpsk_enable;
+debug_cqpsk_enabled(const struct demod_state* d) {
+    const dsdneoRuntimeConfig* cfg = (d && d->rt_cfg) ? d->rt_cfg : dsd_neo_config_snapshot(NULL);
+    return cfg->debug_cqpsk_enable != 0;
 }
 
 /* MMSE interpolator parameters - match OP25/GNU Radio */
@@ -257,7 +253,7 @@ op25_gardner_cc(struct demod_state* d) {
 
     if (need_reinit) {
         /* Debug: log TED SPS change when DSD_NEO_DEBUG_CQPSK=1 */
-        if (debug_cqpsk_enabled()) {
+        if (debug_cqpsk_enabled(d)) {
             fprintf(stderr, "[GARDNER] TED %s: sps=%d->%d old_omega=%.3f old_mu=%.3f (mu=%d for warmup)\n",
                     is_first_init ? "init" : "sps_change", ted->sps, sps, ted->omega, ted->mu, sps);
         }
@@ -842,7 +838,7 @@ dsd_fll_band_edge_init(dsd_fll_band_edge_state_t* f, int sps) {
     int is_sps_change = f->initialized && f->sps != sps && f->sps > 0;
 
     /* Debug: log FLL init when DSD_NEO_DEBUG_CQPSK=1 */
-    if (debug_cqpsk_enabled()) {
+    if (debug_cqpsk_enabled(NULL)) {
         if (is_first_init) {
             fprintf(stderr, "[FLL-INIT] first init sps=%d\n", sps);
         } else if (is_sps_change) {
@@ -1002,7 +998,7 @@ op25_fll_band_edge_cc(struct demod_state* d) {
         }
 
         /* Debug: log FLL init/reinit when DSD_NEO_DEBUG_CQPSK=1 */
-        if (debug_cqpsk_enabled()) {
+        if (debug_cqpsk_enabled(d)) {
             float freq_hz = f->freq * ((float)(d->rate_out > 0 ? d->rate_out : 24000) / kTwoPi);
             if (is_first_init) {
                 fprintf(stderr, "[FLL] init: sps=%d filter_size=%d loop_bw=%.6f\n", sps, filter_size, loop_bw);
@@ -1139,7 +1135,7 @@ op25_fll_band_edge_cc(struct demod_state* d) {
     {
         static int call_count = 0;
         static float prev_freq = 0.0f;
-        if (debug_cqpsk_enabled() && (++call_count % 50) == 0) {
+        if (debug_cqpsk_enabled(d) && (++call_count % 50) == 0) {
             /* Convert freq rad/sample to Hz: f_hz = freq * Fs / (2π) */
             float Fs = (float)d->rate_out;
             float freq_hz = freq * Fs / kTwoPi;
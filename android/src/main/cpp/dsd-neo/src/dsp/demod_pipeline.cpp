@@ -62,13 +62,9 @@
 #endif
 
 static inline int
-debug_cqpsk_enabled(void) {
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    if (!cfg) {
-        dsd_neo_config_init(NULL);
-        cfg = dsd_neo_get_config();
-    }
-    return (cfg && cfg->debug_cqpsk_enable) ? 1 : 0;
+debug_cqpsk_enabled(const struct demod_state* d) {
+    const dsdneoRuntimeConfig* cfg = d->rt_cfg ? d->rt_cfg : dsd_neo_config_snapshot(NULL);
+    return cfg->debug_cqpsk_enable ? 1 : 0;
 }
 
 /* Platform-specific aligned pointer assumption */
@@ -1241,7 +1237,7 @@ gardner_timing_adjust(struct demod_state* d) {
     /* Debug: TED state when DSD_NEO_DEBUG_CQPSK=1 */
     {
         static int call_count = 0;
-        if (debug_cqpsk_enabled() && d->cqpsk_enable && (++call_count % 50) == 0) {
+        if (debug_cqpsk_enabled(d) && d->cqpsk_enable && (++call_count % 50) == 0) {
             float lock_norm =
                 (d->ted_state.lock_count > 0) ? d->ted_state.lock_accum / (float)d->ted_state.lock_count : 0.0f;
             fprintf(stderr, "[TED] omega:%.3f mu:%.3f e_ema:%.4f lock:%.2f in:%d out:%d\n", d->ted_state.omega,
@@ -1261,6 +1257,7 @@ gardner_timing_adjust(struct demod_state* d) {
 void
 full_demod(struct demod_state* d) {
     int i, ds_p;
+    d->rt_cfg = dsd_neo_config_snapshot(NULL);
     ds_p = d->downsample_passes;
     if (ds_p > 0) {
         /* Apply ds_p stages of 2:1 half-band decimation on interleaved lowpassed */
@@ -1354,7 +1351,7 @@ full_demod(struct demod_state* d) {
         /* Debug: Post-AGC magnitudes when DSD_NEO_DEBUG_CQPSK=1 */
         {
             static int call_count = 0;
-            if (debug_cqpsk_enabled() && (++call_count % 50) == 0 && d->lp_len >= 8) {
+            if (debug_cqpsk_enabled(d) && (++call_count % 50) == 0 && d->lp_len >= 8) {
                 const float* iq = d->lowpassed;
                 float mag_sum = 0.0f;
                 float max_env = 0.0f;
@@ -1419,7 +1416,7 @@ full_demod(struct demod_state* d) {
             /* Debug: Post-processing state when DSD_NEO_DEBUG_CQPSK=1 */
             {
                 static int call_count = 0;
-                if (debug_cqpsk_enabled() && (++call_count % 50) == 0) {
+                if (debug_cqpsk_enabled(d) && (++call_count % 50) == 0) {
                     dsd_costas_loop_state_t* c = &d->costas_state;
                     dsd_fll_band_edge_state_t* f = &d->fll_band_edge_state;
                     ted_state_t* ted = &d->ted_state;
@@ -1549,7 +1546,7 @@ full_demod(struct demod_state* d) {
             static double evm_err_acc = 0.0;
             static double evm_ref_acc = 0.0;
             static int evm_count = 0;
-            if (debug_cqpsk_enabled()) {
+            if (debug_cqpsk_enabled(d)) {
                 const float* syms = d->result;
                 for (int k = 0; k < d->result_len; k++) {
                     float s = syms[k];
@@ -43,6 +43,8 @@
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/frame_sync_hooks.h>
+#include <dsd-neo/runtime/p25_p2_audio_ring.h>
+#include <dsd-neo/runtime/symbol_file.h>
 #include <dsd-neo/runtime/telemetry.h>
 
 #include <locale.h>
@@ -136,33 +138,12 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
         return -1;
     }
 
+    /* Pick up reconfiguration once per sync search; decoders read state->rt_cfg. */
+    state->rt_cfg = dsd_neo_get_config();
+
     /* Dwell timer for CQPSK entry uses file-scope g_qpsk_dwell_enter_ms. */
     const time_t now = time(NULL);
-    // Periodic P25 trunk SM heartbeat (once per second) to enforce hangtime
-    // fallbacks even if frame processing stalls due to signal loss.
-    // Note: Only run the P25 trunk SM tick when P25 is the active protocol
-    // context. This avoids unintended retunes (CC hunting) while trunking on
-    // other protocols such as NXDN/DMR/EDACS.
-    static time_t last_tick = 0;
-    static time_t last_p25_seen = 0; // runtime cache of recent P25 activity
-    if (now != last_tick) {
-        // Detect current P25 activity via last observed sync type (P25p1: 0/1;
-        // P25p2: 35/36) and maintain a small grace window after last P25
-        // observation so watchdog fallbacks still run on brief fades.
-        int p25_by_sync = (state && DSD_SYNC_IS_P25(state->lastsynctype)) ? 1 : 0;
-        if (p25_by_sync) {
-            last_p25_seen = now;
-        }
-        int p25_recent = (last_p25_seen != 0 && (now - last_p25_seen) <= 3) ? 1 : 0; // 3s grace
-        int p25_active = p25_by_sync || p25_recent || (state && state->p25_p2_active_slot != -1);
-        // Only drive the P25 trunk SM heartbeat when P25 trunking is enabled
-        // and P25 appears to be the active/most-recent protocol context. This
-        // avoids unintended CC hunts while trunking NXDN/DMR/EDACS.
-        if (opts && opts->p25_trunk == 1 && p25_active) {
-            dsd_frame_sync_hook_p25_sm_try_tick(opts, state);
-        }
-        last_tick = now;
-    }
+
     /* detects frame sync and returns frame type
    *  0 = +P25p1
    *  1 = -P25p1
@@ -513,11 +494,7 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
             static int sym_count = 0;
             static int pos_count = 0, neg_count = 0;
             static float sym_min = 1e9f, sym_max = -1e9f, sym_sum = 0.0f;
-            const dsdneoRuntimeConfig* cfg_dbg = dsd_neo_get_config();
-            if (!cfg_dbg) {
-                dsd_neo_config_init(opts);
-                cfg_dbg = dsd_neo_get_config();
-            }
+            const dsdneoRuntimeConfig* cfg_dbg = dsd_neo_config_cached(&state->rt_cfg, opts);
             if (cfg_dbg && cfg_dbg->debug_sync_enable) {
                 if (symbol < sym_min) {
                     sym_min = symbol;
@@ -585,11 +562,7 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
                 static int hist[4] = {0, 0, 0, 0};
                 static float sym_sum = 0.0f;
                 static float sym_min = 1000.0f, sym_max = -1000.0f;
-                const dsdneoRuntimeConfig* cfg_dbg = dsd_neo_get_config();
-                if (!cfg_dbg) {
-                    dsd_neo_config_init(opts);
-                    cfg_dbg = dsd_neo_get_config();
-                }
+                const dsdneoRuntimeConfig* cfg_dbg = dsd_neo_config_cached(&state->rt_cfg, opts);
                 if (cfg_dbg && cfg_dbg->debug_cqpsk_enable) {
                     hist[d]++;
                     sym_sum += sym;
@@ -642,7 +615,7 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
                 }
             }
             //fprintf (stderr, "%d", dibit);
-            fputc(csymbol, opts->symbol_out_f);
+            dsd_symbol_out_put(opts, state, csymbol);
         }
 
         //digitize test for storing dibits in buffer correctly for dmr recovery
@@ -741,7 +714,7 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
             // Falls back to legacy power squelch gating for certain modes.
 #ifdef USE_RTLSDR
             {
-                const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                 int snr_gate = 0;
                 if (cfg && cfg->snr_sql_is_set) {
                     double snr_db = -200.0;
@@ -779,11 +752,7 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
             /* Debug: print sync pattern when DSD_NEO_DEBUG_SYNC=1 */
             {
                 static int debug_count = 0;
-                const dsdneoRuntimeConfig* cfg_dbg = dsd_neo_get_config();
-                if (!cfg_dbg) {
-                    dsd_neo_config_init(opts);
-                    cfg_dbg = dsd_neo_get_config();
-                }
+                const dsdneoRuntimeConfig* cfg_dbg = dsd_neo_config_cached(&state->rt_cfg, opts);
                 int debug_sync = (cfg_dbg && cfg_dbg->debug_sync_enable) ? 1 : 0;
                 int debug_cqpsk = (cfg_dbg && cfg_dbg->debug_cqpsk_enable) ? 1 : 0;
 
@@ -2107,11 +2076,7 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
                         dt_since_tune = (double)(now - state->p25_last_vc_tune_time);
                     }
                     // Startup grace after a VC tune to avoid bouncing before PTT/audio
-                    const dsdneoRuntimeConfig* cfg_hold = dsd_neo_get_config();
-                    if (!cfg_hold) {
-                        dsd_neo_config_init(opts);
-                        cfg_hold = dsd_neo_get_config();
-                    }
+                    const dsdneoRuntimeConfig* cfg_hold = dsd_neo_config_cached(&state->rt_cfg, opts);
                     double vc_grace = cfg_hold ? cfg_hold->p25_vc_grace_s : 0.75;
                     int is_p2_vc = (state->p25_p2_active_slot != -1);
                     // Mirror trunk SM gating: treat jitter ring as activity
@@ -2129,8 +2094,8 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
                                         : ((state->p25_p2_last_mac_active[1] != 0)
                                                ? ((double)(now - state->p25_p2_last_mac_active[1]))
                                                : 1e9);
-                    int l_ring = (state->p25_p2_audio_ring_count[0] > 0) && (l_dmac <= ring_hold);
-                    int r_ring = (state->p25_p2_audio_ring_count[1] > 0) && (r_dmac <= ring_hold);
+                    int l_ring = (p25_p2_audio_ring_count(state, 0) > 0) && (l_dmac <= ring_hold);
+                    int r_ring = (p25_p2_audio_ring_count(state, 1) > 0) && (r_dmac <= ring_hold);
                     int left_has_audio = state->p25_p2_audio_allowed[0] || l_ring;
                     int right_has_audio = state->p25_p2_audio_allowed[1] || r_ring;
                     if (dt >= opts->trunk_hangtime) {
@@ -40,6 +40,7 @@
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/log.h>
 #include <dsd-neo/runtime/net_audio_input_hooks.h>
+#include <dsd-neo/runtime/symbol_file.h>
 #include <dsd-neo/runtime/udp_audio_hooks.h>
 
 #include <math.h>
@@ -130,7 +131,7 @@ maybe_c4fm_clock(dsd_opts* opts, dsd_state* state, int have_sync, int mode, int
     if (opts->audio_in_type != AUDIO_IN_RTL) {
         return;
     }
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
     int allow_when_synced = (cfg && cfg->c4fm_clk_sync_is_set) ? (cfg->c4fm_clk_sync != 0) : 0;
     if (have_sync != 0 && !allow_when_synced) {
         return;
@@ -220,7 +221,7 @@ maybe_c4fm_clock(dsd_opts* opts, dsd_state* state, int have_sync, int mode, int
  */
 static inline void
 maybe_auto_center(dsd_opts* opts, dsd_state* state, int have_sync) {
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
     int freeze_window = (cfg && cfg->window_freeze_is_set) ? (cfg->window_freeze != 0) : 0;
     if (freeze_window) {
         return; // explicit freeze requested
@@ -230,7 +231,7 @@ maybe_auto_center(dsd_opts* opts, dsd_state* state, int have_sync) {
     }
     /* If synced, only run when explicitly allowed by runtime config. */
     if (have_sync != 0) {
-        const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+        const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
         int allow_when_synced = (cfg && cfg->c4fm_clk_sync_is_set) ? (cfg->c4fm_clk_sync != 0) : 0;
         if (!allow_when_synced) {
             return;
@@ -373,11 +374,7 @@ getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
     int clk_mode = 0;
     int clk_early = 0, clk_mid = 0, clk_late = 0;
     if (state->rf_mod == 0) {
-        const dsdneoRuntimeConfig* cfg_clk = dsd_neo_get_config();
-        if (!cfg_clk) {
-            dsd_neo_config_init(opts);
-            cfg_clk = dsd_neo_get_config();
-        }
+        const dsdneoRuntimeConfig* cfg_clk = dsd_neo_config_cached(&state->rt_cfg, opts);
         if (cfg_clk && cfg_clk->c4fm_clk_is_set) {
             clk_mode = cfg_clk->c4fm_clk_mode;
         }
@@ -392,7 +389,7 @@ getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
 #endif
 
     /* Resolve any window freeze override once per symbol to avoid inner-loop overhead */
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
     int freeze_window = (cfg && cfg->window_freeze_is_set) ? (cfg->window_freeze != 0) : 0;
 
     /* Precompute left/right edges for current modulation once per symbol */
@@ -599,11 +596,7 @@ getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
                 }
                 // shorter backoff on TCP input stall to avoid wedging decode/SM
                 int backoff_ms = 300; // default 300ms
-                const dsdneoRuntimeConfig* cfg_retry = dsd_neo_get_config();
-                if (!cfg_retry) {
-                    dsd_neo_config_init(opts);
-                    cfg_retry = dsd_neo_get_config();
-                }
+                const dsdneoRuntimeConfig* cfg_retry = dsd_neo_config_cached(&state->rt_cfg, opts);
                 if (cfg_retry && cfg_retry->tcpin_backoff_ms_is_set) {
                     backoff_ms = cfg_retry->tcpin_backoff_ms;
                 }
@@ -1047,12 +1040,14 @@ getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
             return -1.0f;
         }
 
-        state->symbolc = fgetc(opts->symbolfile);
+        state->symbolc = dsd_symbol_in_dibit(opts, state);
 
         //fprintf(stderr, "%d", state->symbolc);
-        if (feof(opts->symbolfile)) {
+        if (state->symbolc < 0) {
             // opts->audio_in_type = AUDIO_IN_PULSE; //switch to pulse after playback, ncurses terminal can initiate replay if wanted
-            fclose(opts->symbolfile);
+            dsd_symbol_in_report(opts, state);
+            dsd_symbol_in_reset(state);
+            dsd_symbol_in_close(opts);
             fprintf(stderr, "\nEnd of %s\n", opts->audio_in_dev);
             //in debug mode, re-run .bin files over and over (look for memory leaks, etc)
             if (state->debug_mode == 1) {
@@ -1084,15 +1079,11 @@ getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
     //.raw or .sym float symbol files
     if (opts->audio_in_type == AUDIO_IN_SYMBOL_FLT) {
         float float_symbol = 0.0f;
-        size_t read_count = fread(&float_symbol, sizeof(float), 1, opts->symbolfile); //sizeof(float) is 4 (usually)
-        if (read_count != 1) {
+        if (!dsd_symbol_in_float(opts, state, &float_symbol)) {
             exitflag = 1; // EOF or read error, exit loop cleanly
             symbol = 0.0f;
             return symbol;
         }
-        if (feof(opts->symbolfile)) {
-            exitflag = 1; //end of file, exit
-        }
         // float_symbol = -float_symbol; //inversion
         symbol = float_symbol * 10000.0f;
     }
@@ -8,7 +8,8 @@
  * @brief Scalar helpers to widen RTL u8 IQ into normalized float samples.
  *
  * Converts unsigned 8-bit I/Q into centered float in [-1.0, 1.0] with an
- * unbiased midpoint at 127.5. No clamping is applied so headroom is retained
+ * unbiased midpoint at 127.5, plus signed 8/16-bit variants for external
+ * IQ sources. No clamping is applied so headroom is retained
  * for downstream float processing.
  */
 
@@ -40,6 +41,29 @@ widen_u8_to_f32_bias128_scalar(const unsigned char* src, float* dst, uint32_t le
     }
 }
 
+void
+widen_s8_to_f32(const int8_t* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0) {
+        return;
+    }
+    const float inv = 1.0f / 127.5f;
+    for (uint32_t i = 0; i < len; i++) {
+        float v = ((float)src[i] + 0.5f) * inv;
+        dst[i] = v;
+    }
+}
+
+void
+widen_s16_to_f32(const int16_t* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0) {
+        return;
+    }
+    const float inv = 1.0f / 32768.0f;
+    for (uint32_t i = 0; i < len; i++) {
+        dst[i] = (float)src[i] * inv;
+    }
+}
+
 void
 widen_rotate90_u8_to_f32_bias127(const unsigned char* src, float* dst, uint32_t len) {
     if (!src || !dst || len < 2) {
@@ -10,6 +10,7 @@
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/core/synth_pipeline.h>
 #include <dsd-neo/io/control.h>
 #include <dsd-neo/protocol/p25/p25.h>
 #include <dsd-neo/protocol/p25/p25p1_check_nid.h>
@@ -149,6 +150,7 @@ dsd_dispatch_handle_p25p1(dsd_opts* opts, dsd_state* state) {
             }
         }
         mbe_initMbeParms(state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
+        dsd_synth_pipeline_reset_state(state, 0);
         state->lastp25type = 2;
         state->dmrburstL = 25;
         state->currentslot = 0;
@@ -208,6 +210,7 @@ dsd_dispatch_handle_p25p1(dsd_opts* opts, dsd_state* state) {
             }
         }
         mbe_initMbeParms(state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
+        dsd_synth_pipeline_reset_state(state, 0);
         // state->lasttg = 0;
         // state->lastsrc = 0;
         state->lastp25type = 0;
@@ -235,6 +238,7 @@ dsd_dispatch_handle_p25p1(dsd_opts* opts, dsd_state* state) {
             }
         }
         mbe_initMbeParms(state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
+        dsd_synth_pipeline_reset_state(state, 0);
         state->lasttg = 0;
         state->lastsrc = 0;
         state->lastp25type = 0;
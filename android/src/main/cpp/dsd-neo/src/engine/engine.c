@@ -14,6 +14,7 @@
 #include <dsd-neo/core/power.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/core/synth_pipeline.h>
 #include <dsd-neo/core/time_format.h>
 #include <dsd-neo/core/vocoder.h>
 #include <dsd-neo/dsp/frame_sync.h>
@@ -37,9 +38,11 @@
 #include <dsd-neo/runtime/cli.h>
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/control_pump.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/log.h>
 #include <dsd-neo/runtime/trunk_cc_candidates.h>
+#include <dsd-neo/runtime/trunk_timers.h>
 #include <dsd-neo/ui/ui_async.h>
 
 #include <mbelib.h>
@@ -626,32 +629,38 @@ dsd_engine_setup_io(dsd_opts* opts, dsd_state* state) {
 
     RTLEND:
 
-#ifdef __ANDROID__
-        // On Android with native USB, skip standard device enumeration
-        // The device is accessed via file descriptor, not libusb enumeration
-        if (opts->rtl_android_usb_fd >= 0 && opts->rtl_android_usb_path[0] != '\0') {
-            LOG_NOTICE("Using Android native USB RTL-SDR (fd=%d, path=%s) - skipping device enumeration\n",
-                       opts->rtl_android_usb_fd, opts->rtl_android_usb_path);
-            device_count = 1;  // Pretend we have one device
+        if (opts->rtl_external_iq) {
+            // Samples are pushed in-process (rtl_device_push_iq); there is no device to enumerate
+            LOG_NOTICE("Using external IQ source - skipping device enumeration\n");
+            device_count = 0;
         } else {
-            device_count = (int)rtlsdr_get_device_count();
-        }
+#ifdef __ANDROID__
+            // On Android with native USB, skip standard device enumeration
+            // The device is accessed via file descriptor, not libusb enumeration
+            if (opts->rtl_android_usb_fd >= 0 && opts->rtl_android_usb_path[0] != '\0') {
+                LOG_NOTICE("Using Android native USB RTL-SDR (fd=%d, path=%s) - skipping device enumeration\n",
+                           opts->rtl_android_usb_fd, opts->rtl_android_usb_path);
+                device_count = 1; // Pretend we have one device
+            } else {
+                device_count = (int)rtlsdr_get_device_count();
+            }
 #elif defined(_MSC_VER) && defined(_WIN32)
-        __try {
-            device_count = (int)rtlsdr_get_device_count();
-        } __except (EXCEPTION_EXECUTE_HANDLER) {
-            LOG_ERROR("RTL: libusb exception during device enumeration.\n");
-            device_count = 0;
-            exitflag = 1;
-        }
+            __try {
+                device_count = (int)rtlsdr_get_device_count();
+            } __except (EXCEPTION_EXECUTE_HANDLER) {
+                LOG_ERROR("RTL: libusb exception during device enumeration.\n");
+                device_count = 0;
+                exitflag = 1;
+            }
 #else
-        device_count = (int)rtlsdr_get_device_count();
+            device_count = (int)rtlsdr_get_device_count();
 #endif
-        if (!device_count) {
-            LOG_ERROR("No supported devices found.\n");
-            exitflag = 1;
-        } else {
-            LOG_NOTICE("Found %d device(s):\n", device_count);
+            if (!device_count) {
+                LOG_ERROR("No supported devices found.\n");
+                exitflag = 1;
+            } else {
+                LOG_NOTICE("Found %d device(s):\n", device_count);
+            }
         }
         for (int i = 0; i < device_count; i++) {
 #if defined(_MSC_VER) && defined(_WIN32)
@@ -672,7 +681,7 @@ dsd_engine_setup_io(dsd_opts* opts, dsd_state* state) {
         }
 
         // Guard against out-of-range index (indices are 0-based, not serial numbers)
-        if (opts->rtl_dev_index < 0 || opts->rtl_dev_index >= device_count) {
+        if (!opts->rtl_external_iq && (opts->rtl_dev_index < 0 || opts->rtl_dev_index >= device_count)) {
             const int requested = opts->rtl_dev_index;
             LOG_WARNING("Requested RTL device index %d out of range (found %d device(s)); using 0\n", requested,
                         device_count);
@@ -1010,8 +1019,8 @@ noCarrier(dsd_opts* opts, dsd_state* state) {
 
                 //cap+ rest channel - redundant?
                 if (state->dmr_rest_channel != -1) {
-                    if (state->trunk_chan_map[state->dmr_rest_channel] != 0) {
-                        cc = state->trunk_chan_map[state->dmr_rest_channel];
+                    if (dsd_chan_map_get(&state->trunk_chan_map, state->dmr_rest_channel) != 0) {
+                        cc = dsd_chan_map_get(&state->trunk_chan_map, state->dmr_rest_channel);
                         state->p25_cc_freq = cc;
                         state->trunk_cc_freq = cc;
                     }
@@ -1182,6 +1191,7 @@ noCarrier(dsd_opts* opts, dsd_state* state) {
     set_underscores(state->keyid, 16);
     mbe_initMbeParms(state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
     mbe_initMbeParms(state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2);
+    dsd_synth_pipeline_reset_state(state, -1);
 
     state->dmr_ms_mode = 0;
 
@@ -1461,6 +1471,10 @@ noCarrier(dsd_opts* opts, dsd_state* state) {
     //we do reset the counter, but not the static_ks_bits
     memset(state->static_ks_counter, 0, sizeof(state->static_ks_counter));
 
+    // Carrier lost: any call in progress is over
+    dsd_decoder_events_call(state, -1, 0);
+    dsd_decoder_events_signal(state);
+
 } //nocarrier
 
 static int
@@ -1512,6 +1526,11 @@ liveScanner(dsd_opts* opts, dsd_state* state) {
         }
     }
 
+    // Optional: move vocoder synthesis/output off the decoder thread (DSD_NEO_SYNTH_PIPELINE=1).
+    if (dsd_synth_pipeline_attach(opts, state) < 0) {
+        LOG_WARNING("Failed to start synth pipeline; using inline synthesis.\n");
+    }
+
     //push a DSD-neo started event so users can see what this section does, and also gives users an idea of when context started
     state->event_history_s[0].Event_History_Items[0].color_pair = 4;
     watchdog_event_datacall(opts, state, 0, 0, "Any decoded voice calls or data calls display here;", 0);
@@ -1542,21 +1561,23 @@ liveScanner(dsd_opts* opts, dsd_state* state) {
     //test P25 moto alias by loading in test vectors captured from a system and dumped on forum (see dsd_gps.c)
     // apx_embedded_alias_test_phase1(opts, state); //enable this to run test
 
-    /* Start P25 SM watchdog thread to ensure ticks during I/O stalls */
+    /* Start P25 SM stall watchdog: posts overdue timer runs while input is stalled */
     p25_sm_watchdog_start(opts, state);
 
     while (!exitflag) {
         // Drain any pending UI->Demod commands before heavy work
         dsd_runtime_pump_controls(opts, state);
 
-        // Cooperative tick: runs only if another tick isn't in progress
-        p25_sm_try_tick(opts, state);
+        // Trunking deadlines (hangtime, grant timeout, table expiry) that have come due
+        dsd_trunk_timers_run(opts, state);
 
         // Drain again to reduce latency for common key actions
         dsd_runtime_pump_controls(opts, state);
 
         noCarrier(opts, state);
         state->synctype = getFrameSync(opts, state);
+        // Sync acquired (or the hunt timed out): report the edge
+        dsd_decoder_events_signal(state);
         // Recompute thresholds only when extrema change
         if (state->max != last_max || state->min != last_min) {
             state->center = ((state->max) + (state->min)) / 2;
@@ -1571,6 +1592,8 @@ liveScanner(dsd_opts* opts, dsd_state* state) {
             dsd_runtime_pump_controls(opts, state);
 
             processFrame(opts, state);
+            // Call events for protocols without trunk SM report sites
+            dsd_decoder_events_frame(state);
 
 #ifdef TRACE_DSD
             state->debug_prefix = 'S';
@@ -1584,6 +1607,8 @@ liveScanner(dsd_opts* opts, dsd_state* state) {
 
             // Drain again between frames to reduce latency
             dsd_runtime_pump_controls(opts, state);
+            // Deadlines that came due while decoding this run of frames
+            dsd_trunk_timers_run(opts, state);
             state->synctype = getFrameSync(opts, state);
             // Recompute thresholds only when extrema change
             if (state->max != last_max || state->min != last_min) {
@@ -1614,6 +1639,9 @@ dsd_engine_cleanup(dsd_opts* opts, dsd_state* state) {
         ui_stop();
     }
 
+    // Drain queued voice frames and stop the synth worker before audio outputs close.
+    dsd_synth_pipeline_detach(state);
+
     // Emit a summary of any trunking channel map issues after UI teardown so output is visible.
     nxdn_trunk_diag_log_summary(opts, state);
 
@@ -7,13 +7,11 @@
 #include <dsd-neo/runtime/frame_sync_hooks.h>
 
 #include <dsd-neo/protocol/edacs/edacs.h>
-#include <dsd-neo/protocol/p25/p25_sm_watchdog.h>
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
 
 void
 dsd_engine_frame_sync_hooks_install(void) {
     dsd_frame_sync_hooks hooks = {0};
-    hooks.p25_sm_try_tick = p25_sm_try_tick;
     hooks.p25_sm_on_release = p25_sm_on_release;
     hooks.eot_cc = eot_cc;
     hooks.no_carrier = noCarrier;
@@ -157,7 +157,8 @@ dsd_engine_trunk_tune_to_freq(dsd_opts* opts, dsd_state* state, long int freq, i
     // NOTE: We intentionally do NOT call rtl_stream_reset_costas() here.
     //
     // The Costas/TED state reset must happen AFTER the hardware retune completes,
-    // which is handled by demod_reset_on_retune() in the controller thread.
+    // which is handled by demod_reset_on_retune() on the demod thread when it reaches
+    // the input ring marker posted after the retune.
     //
     // If we reset here (before the hardware retune), the DSP thread will:
     //   1. See the reset Costas state (phase=0, freq=0)
@@ -165,7 +166,7 @@ dsd_engine_trunk_tune_to_freq(dsd_opts* opts, dsd_state* state, long int freq, i
     //   3. Try to lock on the wrong signal, corrupting the loop state
     //   4. When the retune completes, the loop is in a bad state
     //
-    // By deferring the reset to the controller thread, the DSP continues with
+    // By deferring the reset to the retune marker, the DSP continues with
     // the current (correct for current signal) state until the hardware retune
     // completes, then resets and acquires on the new signal.
     //
@@ -244,7 +245,7 @@ dsd_engine_trunk_tune_to_cc(dsd_opts* opts, dsd_state* state, long int freq, int
     // Reset modulation auto-detect state for fresh acquisition.
     dsd_frame_sync_reset_mod_state();
 
-    // NOTE: Costas/TED reset is deferred to the controller thread after the hardware
+    // NOTE: Costas/TED reset is deferred to the retune marker after the hardware
     // retune completes. See dsd_engine_trunk_tune_to_freq for the full rationale.
 
     // Ensure any queued audio tail plays before changing channels
@@ -260,7 +261,7 @@ dsd_engine_trunk_tune_to_cc(dsd_opts* opts, dsd_state* state, long int freq, int
     } else if (opts->audio_in_type == AUDIO_IN_RTL) {
 #ifdef USE_RTLSDR
         // Set TED SPS for control channel BEFORE tuning so that demod_reset_on_retune()
-        // (triggered by the controller thread after retune) uses the correct CC SPS,
+        // (run at the retune marker after the hardware retune) uses the correct CC SPS,
         // not the stale VC override value.
         // Clear the override so non-P25 protocols can have SPS computed automatically.
         // Use no_override variant so rate-change refresh can recalculate SPS later.
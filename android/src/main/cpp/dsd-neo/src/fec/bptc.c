@@ -11,8 +11,8 @@
  */
 
 /* Include ------------------------------------------------------------------*/
-#include <dsd-neo/fec/block_codes.h>
 #include <dsd-neo/fec/bptc.h>
+#include <dsd-neo/platform/atomic_compat.h>
 
 /* Define -------------------------------------------------------------------*/
 
@@ -46,6 +46,166 @@ const uint8_t DeInterleaveReverseChannelBptcPlacement[32] = {0,  16, 1,  17, 2,
                                                              21, 6,  22, 7,  23, 8,  24, 9,  25, 10, 26,
                                                              11, 27, 12, 28, 13, 29, 14, 30, 15, 31};
 
+/*
+ * Packed Hamming helpers.
+ *
+ * Rows and columns are held as machine words with bit 0 of the codeword in
+ * the most significant used bit. Each code is described by the syndrome of
+ * a single error at every position (the same H matrices as the bit-per-byte
+ * decoders in fec.c) and the inverse map from syndrome to bit position.
+ * Row syndromes come from two byte tables; the Hamming(13,9) column checks of
+ * the 196x96 matrix are bit-sliced so all 15 columns are checked at once.
+ */
+#define BPTC_NO_FIX 0xFF /* syndrome with no single-bit explanation */
+
+static const uint8_t k_h15_11_col[15] = {9, 13, 15, 14, 7, 10, 5, 11, 12, 6, 3, 8, 4, 2, 1};
+static const uint8_t k_h15_11_fix[16] = {0xFF, 14, 13, 10, 12, 6, 9, 4, 11, 0, 5, 7, 8, 1, 3, 2};
+
+static const uint8_t k_h13_9_col[13] = {15, 14, 7, 10, 5, 11, 12, 6, 3, 8, 4, 2, 1};
+static const uint8_t k_h13_9_fix[16] = {0xFF, 12, 11, 8, 10, 4, 7, 2, 9, 0xFF, 3, 5, 6, 0xFF, 1, 0};
+
+static const uint8_t k_h16_11_col[16] = {19, 26, 31, 28, 14, 21, 11, 22, 25, 13, 7, 16, 8, 4, 2, 1};
+static const uint8_t k_h16_11_fix[32] = {0xFF, 15,   14,   0xFF, 13,   0xFF, 0xFF, 10,   12, 0xFF, 0xFF,
+                                         6,    0xFF, 9,    4,    0xFF, 11,   0xFF, 0xFF, 0,  0xFF, 5,
+                                         7,    0xFF, 0xFF, 8,    1,    0xFF, 3,    0xFF, 0xFF, 2};
+
+/* Reverse channel single burst: input bit i lands at matrix bit k_rc_place[i] (both tables composed). */
+static const uint8_t k_rc_place[32] = {0, 24, 1, 25, 2, 26, 3, 27, 4, 28, 5, 29, 6, 30, 7, 31,
+                                       8, 16, 9, 17, 10, 18, 11, 19, 12, 20, 13, 21, 14, 22, 15, 23};
+
+typedef struct {
+    uint8_t h15_lo[256]; /* syndrome contribution of row bits 7..0 */
+    uint8_t h15_hi[128]; /* ... of row bits 14..8 */
+    uint8_t h16_lo[256];
+    uint8_t h16_hi[256];
+} bptc_syndrome_tables;
+
+static bptc_syndrome_tables g_bptc_syn;
+static atomic_int g_bptc_syn_state; /* 0 = empty, 1 = building, 2 = ready */
+
+/* Syndrome of the byte `v` placed at word bits [shift+7 .. shift] of an n-bit codeword. */
+static uint8_t
+bptc_byte_syndrome(const uint8_t* col, int n, unsigned v, int shift) {
+    uint8_t syn = 0;
+    for (int b = 0; b < 8; b++) {
+        int pos = n - 1 - (shift + b);
+        if (pos >= 0 && ((v >> b) & 1U)) {
+            syn ^= col[pos];
+        }
+    }
+    return syn;
+}
+
+static const bptc_syndrome_tables*
+bptc_tables(void) {
+    if (atomic_load(&g_bptc_syn_state) != 2) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&g_bptc_syn_state, &expected, 1)) {
+            for (unsigned v = 0; v < 256; v++) {
+                g_bptc_syn.h15_lo[v] = bptc_byte_syndrome(k_h15_11_col, 15, v, 0);
+                if (v < 128) {
+                    g_bptc_syn.h15_hi[v] = bptc_byte_syndrome(k_h15_11_col, 15, v, 8);
+                }
+                g_bptc_syn.h16_lo[v] = bptc_byte_syndrome(k_h16_11_col, 16, v, 0);
+                g_bptc_syn.h16_hi[v] = bptc_byte_syndrome(k_h16_11_col, 16, v, 8);
+            }
+            atomic_store(&g_bptc_syn_state, 2);
+        } else {
+            while (atomic_load(&g_bptc_syn_state) != 2) {
+            }
+        }
+    }
+    return &g_bptc_syn;
+}
+
+static inline int
+bptc_popcount16(uint32_t x) {
+    x = x - ((x >> 1) & 0x5555U);
+    x = (x & 0x3333U) + ((x >> 2) & 0x3333U);
+    x = (x + (x >> 4)) & 0x0F0FU;
+    return (int)((x + (x >> 8)) & 0x1FU);
+}
+
+/* Pack `n` bit-per-byte values MSB first. */
+static inline uint32_t
+bptc_pack(const uint8_t* bits, int n) {
+    uint32_t w = 0;
+    for (int i = 0; i < n; i++) {
+        w = (w << 1) | (bits[i] & 1U);
+    }
+    return w;
+}
+
+/*
+ * Hamming(15,11,3) on a packed row. A single error inside the 11 data bits
+ * is corrected in place; a parity bit error is left as is (only data bits
+ * are written back to the matrix). Every non-zero syndrome maps to a bit.
+ */
+static inline uint32_t
+bptc_row15_fix(const bptc_syndrome_tables* t, uint32_t row) {
+    uint8_t syn = t->h15_hi[(row >> 8) & 0x7FU] ^ t->h15_lo[row & 0xFFU];
+    if (syn != 0) {
+        uint8_t pos = k_h15_11_fix[syn];
+        if (pos < 11) {
+            row ^= 1U << (14 - pos);
+        }
+    }
+    return row;
+}
+
+/* Hamming(16,11,4) on a packed row; returns 0 when the syndrome is uncorrectable (row unchanged). */
+static inline int
+bptc_row16_fix(const bptc_syndrome_tables* t, uint32_t* row) {
+    uint8_t syn = t->h16_hi[(*row >> 8) & 0xFFU] ^ t->h16_lo[*row & 0xFFU];
+    if (syn == 0) {
+        return 1;
+    }
+    uint8_t pos = k_h16_11_fix[syn];
+    if (pos == BPTC_NO_FIX) {
+        return 0;
+    }
+    if (pos < 11) {
+        *row ^= 1U << (15 - pos);
+    }
+    return 1;
+}
+
+/*
+ * Hamming(13,9,3) on all 15 columns of the 13 packed rows at once. The four
+ * syndrome bit-planes are XORs of whole rows; only columns with a non-zero
+ * syndrome are visited. Corrections below row 9 are applied, parity row
+ * errors are dropped like the data-only write back they replace.
+ *
+ * @return Number of columns with an uncorrectable syndrome.
+ */
+static uint32_t
+bptc_columns13_fix(uint32_t rows[13]) {
+    uint32_t plane[4] = {0, 0, 0, 0}; /* plane[b] = syndrome bit b for every column */
+    for (int r = 0; r < 13; r++) {
+        for (int b = 0; b < 4; b++) {
+            plane[b] ^= rows[r] & (0U - (uint32_t)((k_h13_9_col[r] >> b) & 1U));
+        }
+    }
+    uint32_t bad = 0;
+    uint32_t pending = (plane[0] | plane[1] | plane[2] | plane[3]) & 0x7FFFU;
+    while (pending) {
+        int bit = 0;
+        while (!((pending >> bit) & 1U)) {
+            bit++;
+        }
+        pending &= pending - 1U;
+        unsigned syn = ((plane[3] >> bit) & 1U) << 3 | ((plane[2] >> bit) & 1U) << 2 | ((plane[1] >> bit) & 1U) << 1
+                       | ((plane[0] >> bit) & 1U);
+        uint8_t pos = k_h13_9_fix[syn];
+        if (pos == BPTC_NO_FIX) {
+            bad++;
+        } else if (pos < 9) {
+            rows[pos] ^= 1U << bit;
+        }
+    }
+    return bad;
+}
+
 /* Functions ----------------------------------------------------------------*/
 
 /*
@@ -59,11 +219,9 @@ const uint8_t DeInterleaveReverseChannelBptcPlacement[32] = {0,  16, 1,  17, 2,
  */
 void
 BPTCDeInterleaveDMRData(uint8_t* Input, uint8_t* Output) {
-    uint32_t i, DeInterleaveIndex;
-
-    for (i = 0; i < 196; i++) {
-        DeInterleaveIndex = BPTCDeInterleavingIndex[i];
-        Output[DeInterleaveIndex] = (Input[i] & 1);
+    /* Gather through the inverse permutation so stores are sequential */
+    for (uint32_t i = 0; i < 196; i++) {
+        Output[i] = (Input[BPTCInterleavingIndex[i]] & 1);
     }
 } /* End BPTCDeInterleaveDMRData() */
 
@@ -71,6 +229,12 @@ BPTCDeInterleaveDMRData(uint8_t* Input, uint8_t* Output) {
  * @brief : This function extract the 96 bits of a deinteleaved 196 bits
  *          buffer using BPTC (196,96)
  *
+ * @note : The 13x15 matrix is held as 13 packed rows. Two passes of row
+ *         Hamming (15,11,3) and column Hamming (13,9,3) checks are run (the
+ *         first pass may fix bits the second can build on); only the second
+ *         pass is counted. A row or column with an uncorrectable syndrome is
+ *         left unchanged.
+ *
  * @param InputDeInteleavedData : Pointer of DMR input data deinterleaved (196 bytes)
  *
  * @param DMRDataExtracted : Pointer where the DMR data will be written (96 bytes)
@@ -79,152 +243,32 @@ BPTCDeInterleaveDMRData(uint8_t* Input, uint8_t* Output) {
  */
 uint32_t
 BPTC_196x96_Extract_Data(uint8_t InputDeInteleavedData[196], uint8_t DMRDataExtracted[96], uint8_t R[3]) {
-    uint32_t i, j, k;
-    uint8_t DataMatrix[13][15];
-    uint8_t LineUncorrected[15];
-    uint8_t LineCorrected[11];
-    uint8_t ColumnUncorrected[13];
-    uint8_t ColumnCorrected[9];
+    const bptc_syndrome_tables* t = bptc_tables();
+    uint32_t rows[13];
     uint32_t HammingIrrecoverableErrorNb = 0;
 
-    /* First step : Reconstitute the BPTC 15x11 matrix
-   * Note : Input data shall be deinterleaved */
-    k = 1; /* Discard R(3) bit - See DMR standard chapter B1.1 BPTC (196,96) */
-    for (i = 0; i < 13; i++) {
-        for (j = 0; j < 15; j++) {
-            /* Only the LSBit of the byte is stored */
-            DataMatrix[i][j] = (InputDeInteleavedData[k] & 1);
-            k++;
-        }
+    /* Reconstitute the BPTC 15x13 matrix, discarding R(3) - See DMR standard chapter B1.1 BPTC (196,96) */
+    for (int i = 0; i < 13; i++) {
+        rows[i] = bptc_pack(&InputDeInteleavedData[1 + (i * 15)], 15);
     }
 
-    /* Set to 0 R(0) to R(2) - See DMR standard chapter B1.1 BPTC (196,96) */
-    // DataMatrix[0][0] = 0; /* R(2) */
-    // DataMatrix[0][1] = 0; /* R(1) */
-    // DataMatrix[0][2] = 0; /* R(0) */
-
-    /* Init the Hamming (15,11,3) library
-   * Not needed because it has already been done
-   * in the "InitAllFecFunction()" function */
-    //Hamming_15_11_init();
-
-    /* Init the Hamming (13,9,3) library
-   * Not needed because it has already been done
-   * in the "InitAllFecFunction()" function */
-    //Hamming_13_9_init();
-
-    /* Init the Hamming error counter */
-    HammingIrrecoverableErrorNb = 0;
-
-    /* Process the the Hamming (15,11,3) code
-   * check on each line (first time).
-   * Do not check the 4th last lines */
-    for (i = 0; i < 9; i++) {
-        /* Get a full line */
-        for (j = 0; j < 15; j++) {
-            LineUncorrected[j] = DataMatrix[i][j];
-        }
-
-        /* Apply Hamming (15,11,3) code correction */
-        if (Hamming_15_11_decode(LineUncorrected, LineCorrected, 1) == false) {
-            HammingIrrecoverableErrorNb++;
-        }
-
-        /* Re-inject the line in the matrix (only the util data [11 bit],
-     * not the Hamming part [4 bit]) */
-        for (j = 0; j < 11; j++) {
-            DataMatrix[i][j] = LineCorrected[j];
+    for (int pass = 0; pass < 2; pass++) {
+        /* Hamming (15,11,3) on the 9 data lines (never uncorrectable: every syndrome maps to a bit) */
+        for (int i = 0; i < 9; i++) {
+            rows[i] = bptc_row15_fix(t, rows[i]);
         }
+        /* Hamming (13,9,3) on the 15 columns */
+        HammingIrrecoverableErrorNb = bptc_columns13_fix(rows);
     }
 
-    /* Process the the Hamming (15,11,3) code
-   * check on each column/row (first time) */
-    for (i = 0; i < 15; i++) {
-        /* Get a full column */
-        for (j = 0; j < 13; j++) {
-            ColumnUncorrected[j] = DataMatrix[j][i];
-        }
-
-        /* Apply Hamming (15,11,3) code correction */
-        if (Hamming_13_9_decode(ColumnUncorrected, ColumnCorrected, 1) == false) {
-            HammingIrrecoverableErrorNb++;
-        }
-
-        /* Re-inject the column in the matrix (only the util data [11 bit],
-     * not the Hamming part [4 bit]) */
-        for (j = 0; j < 9; j++) {
-            DataMatrix[j][i] = ColumnCorrected[j];
-        }
+    /* Extract the DMR data (96 bit): first line skips R(2), R(1) and R(0) */
+    uint32_t k = 0;
+    for (int j = 3; j < 11; j++) {
+        DMRDataExtracted[k++] = (uint8_t)((rows[0] >> (14 - j)) & 1U);
     }
-
-    /* The first Hamming code check has maybe corrected bit
-   * witch can be use to correct other bit, so make the
-   * same operation twice */
-
-    /* Reset the number of irrecoverable errors */
-    HammingIrrecoverableErrorNb = 0;
-
-    /* Process the the Hamming (15,11,3) code
-   * check on each line (second time).
-   * Do not check the 4th last lines */
-    for (i = 0; i < 9; i++) {
-        /* Get a full line */
-        for (j = 0; j < 15; j++) {
-            LineUncorrected[j] = DataMatrix[i][j];
-        }
-
-        /* Apply Hamming (15,11,3) code correction */
-        if (Hamming_15_11_decode(LineUncorrected, LineCorrected, 1) == false) {
-            /* Row/Line contains irrecoverable errors */
-            HammingIrrecoverableErrorNb++;
-        } else {
-            /* Row/Line contains correct data */
-        }
-
-        /* Re-inject the line in the matrix (only the util data [11 bit],
-     * not the Hamming part [4 bit]) */
-        for (j = 0; j < 11; j++) {
-            DataMatrix[i][j] = LineCorrected[j];
-        }
-    }
-
-    /* Process the the Hamming (15,11,3) code
-   * check on each column/row (second time) */
-    for (i = 0; i < 15; i++) {
-        /* Get a full column */
-        for (j = 0; j < 13; j++) {
-            ColumnUncorrected[j] = DataMatrix[j][i];
-        }
-
-        /* Apply Hamming (15,11,3) code correction */
-        if (Hamming_13_9_decode(ColumnUncorrected, ColumnCorrected, 1) == false) {
-            /* Row/Line contains irrecoverable errors */
-            HammingIrrecoverableErrorNb++;
-        } else {
-            /* Row/Line contains correct data */
-        }
-
-        /* Re-inject the column in the matrix (only the util data [11 bit],
-     * not the Hamming part [4 bit]) */
-        for (j = 0; j < 9; j++) {
-            DataMatrix[j][i] = ColumnCorrected[j];
-        }
-    }
-
-    /* Extract the DMR data (96 bit) from the matrix */
-    /* First line : Do not take R(2), R(1) and R(0) */
-    k = 0;
-
-    for (i = 3; i < 11; i++) {
-        DMRDataExtracted[k] = DataMatrix[0][i];
-        k++;
-    }
-
-    /* Next lines */
-    for (i = 1; i < 9; i++) {
-        for (j = 0; j < 11; j++) {
-            DMRDataExtracted[k] = DataMatrix[i][j];
-            k++;
+    for (int i = 1; i < 9; i++) {
+        for (int j = 0; j < 11; j++) {
+            DMRDataExtracted[k++] = (uint8_t)((rows[i] >> (14 - j)) & 1U);
         }
     }
 
@@ -232,11 +276,10 @@ BPTC_196x96_Extract_Data(uint8_t InputDeInteleavedData[196], uint8_t DMRDataExtr
    * Restricted Access System (RAS) information,
    * So save these three bits after hamming correction
    * See patent US 2013/0288643 A1 */
-    R[0] = DataMatrix[0][2]; /* Save R(0) */
-    R[1] = DataMatrix[0][1]; /* Save R(1) */
-    R[2] = DataMatrix[0][0]; /* Save R(2) */
+    R[0] = (uint8_t)((rows[0] >> 12) & 1U); /* Save R(0) */
+    R[1] = (uint8_t)((rows[0] >> 13) & 1U); /* Save R(1) */
+    R[2] = (uint8_t)((rows[0] >> 14) & 1U); /* Save R(2) */
 
-    /* Return the number of irrecoverable Hamming errors */
     return HammingIrrecoverableErrorNb;
 } /* End BPTC_196x96_Extract_Data() */
 
@@ -258,94 +301,44 @@ BPTC_196x96_Extract_Data(uint8_t InputDeInteleavedData[196], uint8_t DMRDataExtr
  */
 uint32_t
 BPTC_128x77_Extract_Data(uint8_t InputDataMatrix[8][16], uint8_t DMRDataExtracted[77]) {
-    uint32_t i, j, k;
-    uint8_t DataMatrix[8][16];
-    uint8_t LineUncorrected[16];
-    uint8_t LineCorrected[11];
+    const bptc_syndrome_tables* t = bptc_tables();
+    uint32_t rows[8];
     uint32_t HammingIrrecoverableErrorNb = 0;
-    uint32_t ParityCheckErrorNb = 0;
-    uint32_t NbOfOne;
-
-    /* First step : Reconstitute the BPTC 16x8 matrix */
-    for (i = 0; i < 8; i++) {
-        for (j = 0; j < 16; j++) {
-            /* Only the LSBit of the byte is stored */
-            DataMatrix[i][j] = (InputDataMatrix[i][j] & 1);
-        }
-    }
 
-    /* Init the Hamming (16,11,4) library
-   * Not needed because it has already been done
-   * in the "InitAllFecFunction()" function */
-    //Hamming_16_11_4_init();
-
-    /* Process the the Hamming (16,11,4) code
-   * check on each line.
-   * Do not check the last line (line nb 8) */
-    for (i = 0; i < 7; i++) {
-        /* Get a full line */
-        for (j = 0; j < 16; j++) {
-            LineUncorrected[j] = DataMatrix[i][j];
-        }
+    for (int i = 0; i < 8; i++) {
+        rows[i] = bptc_pack(InputDataMatrix[i], 16);
+    }
 
-        /* Apply Hamming (16,11,4) code correction */
-        if (Hamming_16_11_4_decode(LineUncorrected, LineCorrected, 1) == false) {
+    /* Hamming (16,11,4) on each line except the last (column parity) line */
+    for (int i = 0; i < 7; i++) {
+        if (!bptc_row16_fix(t, &rows[i])) {
             HammingIrrecoverableErrorNb++;
         }
-
-        /* Re-inject the line in the matrix (only the util data [11 bit],
-     * not the Hamming part [4 bit]) */
-        for (j = 0; j < 11; j++) {
-            DataMatrix[i][j] = LineCorrected[j];
-        }
     }
 
-    /* Extract the DMR data (77 bit) from the matrix */
-    k = 0;
-
-    /* 2 first lines */
-    for (i = 0; i < 2; i++) {
-        for (j = 0; j < 11; j++) {
-            DMRDataExtracted[k] = DataMatrix[i][j];
-            k++;
+    /* Extract the DMR data (77 bit): 2 lines of 11 bits, 5 lines of 10 bits, then the 5 CRC bits of column 10 */
+    uint32_t k = 0;
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 11; j++) {
+            DMRDataExtracted[k++] = (uint8_t)((rows[i] >> (15 - j)) & 1U);
         }
     }
-
-    /* 5 Next lines */
-    for (i = 2; i < 7; i++) {
-        for (j = 0; j < 10; j++) {
-            DMRDataExtracted[k] = DataMatrix[i][j];
-            k++;
+    for (int i = 2; i < 7; i++) {
+        for (int j = 0; j < 10; j++) {
+            DMRDataExtracted[k++] = (uint8_t)((rows[i] >> (15 - j)) & 1U);
         }
     }
-
-    /* 5 bit of CRC */
-    for (i = 2; i < 7; i++) {
-        DMRDataExtracted[k] = DataMatrix[i][10];
-        k++;
+    for (int i = 2; i < 7; i++) {
+        DMRDataExtracted[k++] = (uint8_t)((rows[i] >> 5) & 1U);
     }
 
-    /* Verify the data integrity by checking
-   * all column parity bit */
-    ParityCheckErrorNb = 0;
-    for (i = 0; i < 16; i++) {
-        NbOfOne = 0;
-
-        /* Get a full column */
-        for (j = 0; j < 7; j++) {
-            NbOfOne += DataMatrix[j][i];
-        }
-
-        /* Check the parity bit (number of "1"
-     * must be even) */
-        if ((NbOfOne % 2) != DataMatrix[7][i]) {
-            ParityCheckErrorNb++;
-        }
+    /* Even column parity: XOR of all 8 lines must be zero in every column */
+    uint32_t parity = 0;
+    for (int i = 0; i < 8; i++) {
+        parity ^= rows[i];
     }
 
-    /* Return the number of irrecoverable Hamming errors +
-   * the number of parity check error */
-    return (HammingIrrecoverableErrorNb + ParityCheckErrorNb);
+    return HammingIrrecoverableErrorNb + (uint32_t)bptc_popcount16(parity & 0xFFFFU);
 } /* End BPTC_128x77_Extract_Data() */
 
 /*
@@ -370,61 +363,30 @@ BPTC_128x77_Extract_Data(uint8_t InputDataMatrix[8][16], uint8_t DMRDataExtracte
  */
 uint32_t
 BPTC_16x2_Extract_Data(uint8_t InputInterleavedData[32], uint8_t DMRDataExtracted[32], uint32_t ParityCheckTypeOdd) {
-    uint32_t i;
-    uint8_t DataMatrix[32];
-    uint8_t LineUncorrected[16];
-    uint8_t LineCorrected[11];
+    const bptc_syndrome_tables* t = bptc_tables();
     uint32_t HammingIrrecoverableErrorNb = 0;
-    uint32_t ParityCheckOddErrorNb = 0;
-    uint32_t ParityCheckEvenErrorNb = 0;
+    uint32_t matrix = 0; /* matrix bit i at word bit 31 - i */
 
     //TODO: make this so we can load either rc interleave, or single burst interleave
-    for (i = 0; i < 32; i++) {
-        DataMatrix[DeInterleaveReverseChannelBptcPlacement[DeInterleaveReverseChannelBptc[i]]] =
-            InputInterleavedData[i] & 1;
-    }
-
-    /* Copy the entire input buffer to the output buffer */
-    for (i = 0; i < 32; i++) {
-        DMRDataExtracted[i] = DataMatrix[i] & 1;
-    }
-
-    /* Prepare the line to be corrected */
-    for (i = 0; i < 16; i++) {
-        LineUncorrected[i] = DataMatrix[i] & 1;
+    for (int i = 0; i < 32; i++) {
+        matrix |= (uint32_t)(InputInterleavedData[i] & 1) << (31 - k_rc_place[i]);
     }
 
-    /* Apply Hamming (16,11,4) code correction */
-    if (Hamming_16_11_4_decode(LineUncorrected, LineCorrected, 1) == false) {
+    /* Apply Hamming (16,11,4) code correction on the first line */
+    uint32_t line = matrix >> 16;
+    if (!bptc_row16_fix(t, &line)) {
         HammingIrrecoverableErrorNb++;
     }
+    uint32_t parity = matrix & 0xFFFFU;
 
-    /* Copy the corrected content to the output buffer */
-    for (i = 0; i < 11; i++) {
-        DMRDataExtracted[i] = LineCorrected[i] & 1;
+    for (int i = 0; i < 16; i++) {
+        DMRDataExtracted[i] = (uint8_t)((line >> (15 - i)) & 1U);
+        DMRDataExtracted[i + 16] = (uint8_t)((parity >> (15 - i)) & 1U);
     }
 
-    /* Check Parity bits */
-    for (i = 0; i < 16; i++) {
-        /* Odd parity ==> If data = 1 then parity = 0
-     *                If data = 0 then parity = 1 */
-        if ((DMRDataExtracted[i] & 1) == (DMRDataExtracted[i + 16] & 1)) {
-            ParityCheckOddErrorNb++;
-        }
-        if ((DMRDataExtracted[i] & 1) != (DMRDataExtracted[i + 16] & 1)) {
-            ParityCheckEvenErrorNb++;
-        }
-    }
-
-    //fprintf(stderr, "Hamming ERR=%u ; Parity odd ERR=%u, Parity even ERR=%u, ", HammingIrrecoverableErrorNb, ParityCheckOddErrorNb, ParityCheckEvenErrorNb);
-
-    //fprintf(stderr, "Content =\n");
-    //for(i = 0; i < 32; i++)
-    //{
-    //  fprintf(stderr, "%u", DMRDataExtracted[i] & 1);
-    //  if((i == 15) || (i == 31)) fprintf(stderr, "\n");
-    //  else fprintf(stderr, "-");
-    //}
+    /* Odd parity ==> If data = 1 then parity = 0, If data = 0 then parity = 1 */
+    uint32_t ParityCheckEvenErrorNb = (uint32_t)bptc_popcount16(line ^ parity);
+    uint32_t ParityCheckOddErrorNb = 16U - ParityCheckEvenErrorNb;
 
     /* Return the number of irrecoverable Hamming errors +
    * the number of parity check error */
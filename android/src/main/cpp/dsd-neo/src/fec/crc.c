@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Table-driven CRC engine (slice-by-8, left-aligned register).
+ */
+
+#include <dsd-neo/fec/crc.h>
+#include <dsd-neo/platform/atomic_compat.h>
+
+#include <string.h>
+
+static const dsd_crc_model k_models[DSD_CRC_ID_COUNT] = {
+    [DSD_CRC3_DMR] = {3, 0x5, 0x0, 0x0},
+    [DSD_CRC4_DMR] = {4, 0x3, 0x0, 0xF},
+    [DSD_CRC6_NXDN] = {6, 0x27, 0x3F, 0x0},
+    [DSD_CRC7_DMR] = {7, 0x27, 0x0, 0x0},
+    [DSD_CRC7_NXDN_SCCH] = {7, 0x09, 0x7F, 0x0},
+    [DSD_CRC8_DMR] = {8, 0x07, 0x0, 0x0},
+    [DSD_CRC9_DMR] = {9, 0x059, 0x0, 0x1FF},
+    [DSD_CRC12_P25] = {12, 0x897, 0x0, 0xFFF},
+    [DSD_CRC12_NXDN] = {12, 0x80F, 0xFFF, 0x0},
+    [DSD_CRC15_NXDN] = {15, 0x4CC5, 0x7FFF, 0x0},
+    [DSD_CRC16_CCITT] = {16, 0x1021, 0x0, 0xFFFF},
+    [DSD_CRC16_M17] = {16, 0x5935, 0xFFFF, 0x0},
+    [DSD_CRC32_CKSUM] = {32, 0x04C11DB7, 0x0, 0xFFFFFFFF},
+    [DSD_CRC32_DMR] = {32, 0x04C11DB7, 0x0, 0x0},
+};
+
+static dsd_crc g_catalog[DSD_CRC_ID_COUNT];
+static atomic_int g_catalog_state[DSD_CRC_ID_COUNT]; /* 0 = empty, 1 = building, 2 = ready */
+
+static inline unsigned
+crc_shift(const dsd_crc* crc) {
+    return 32u - crc->model.width;
+}
+
+static inline uint32_t
+crc_poly_aligned(const dsd_crc* crc) {
+    return crc->model.poly << crc_shift(crc);
+}
+
+static inline uint32_t
+crc_step_bit(uint32_t r, uint32_t bit, uint32_t poly) {
+    r ^= bit << 31;
+    return (r & 0x80000000U) ? (r << 1) ^ poly : (r << 1);
+}
+
+static inline uint32_t
+crc_step_byte(const dsd_crc* crc, uint32_t r, uint8_t b) {
+    return (r << 8) ^ crc->table[0][(r >> 24) ^ b];
+}
+
+/* Eight bit-per-byte elements to one byte, first element in the MSB. */
+static inline uint8_t
+crc_pack8(const uint8_t* b) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t x;
+    memcpy(&x, b, sizeof(x));
+    return (uint8_t)(((x & 0x0101010101010101ULL) * 0x8040201008040201ULL) >> 56);
+#else
+    return (uint8_t)(((b[0] & 1) << 7) | ((b[1] & 1) << 6) | ((b[2] & 1) << 5) | ((b[3] & 1) << 4) | ((b[4] & 1) << 3)
+                     | ((b[5] & 1) << 2) | ((b[6] & 1) << 1) | (b[7] & 1));
+#endif
+}
+
+/* Left-aligned register over whole bytes; slice-by-8 for the bulk. */
+static uint32_t
+crc_run_bytes(const dsd_crc* crc, uint32_t r, const uint8_t* p, size_t len) {
+    while (len >= 8) {
+        r ^= ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+        r = crc->table[7][r >> 24] ^ crc->table[6][(r >> 16) & 0xFF] ^ crc->table[5][(r >> 8) & 0xFF]
+            ^ crc->table[4][r & 0xFF] ^ crc->table[3][p[4]] ^ crc->table[2][p[5]] ^ crc->table[1][p[6]]
+            ^ crc->table[0][p[7]];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        r = crc_step_byte(crc, r, *p++);
+    }
+    return r;
+}
+
+int
+dsd_crc_init(dsd_crc* crc, const dsd_crc_model* model) {
+    if (!crc || !model || model->width < 1 || model->width > 32) {
+        return -1;
+    }
+    crc->model = *model;
+    uint32_t mask = (model->width == 32) ? 0xFFFFFFFFU : ((1U << model->width) - 1U);
+    crc->model.poly &= mask;
+    crc->model.init &= mask;
+    crc->model.xorout &= mask;
+
+    const uint32_t poly = crc_poly_aligned(crc);
+    for (unsigned b = 0; b < 256; b++) {
+        uint32_t r = (uint32_t)b << 24;
+        for (int i = 0; i < 8; i++) {
+            r = (r & 0x80000000U) ? (r << 1) ^ poly : (r << 1);
+        }
+        crc->table[0][b] = r;
+    }
+    for (int k = 1; k < 8; k++) {
+        for (unsigned b = 0; b < 256; b++) {
+            uint32_t prev = crc->table[k - 1][b];
+            crc->table[k][b] = (prev << 8) ^ crc->table[0][prev >> 24];
+        }
+    }
+    return 0;
+}
+
+const dsd_crc*
+dsd_crc_get(dsd_crc_id id) {
+    if ((unsigned)id >= DSD_CRC_ID_COUNT) {
+        return NULL;
+    }
+    if (atomic_load(&g_catalog_state[id]) != 2) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&g_catalog_state[id], &expected, 1)) {
+            dsd_crc_init(&g_catalog[id], &k_models[id]);
+            atomic_store(&g_catalog_state[id], 2);
+        } else {
+            /* Another thread is building; this takes a few microseconds. */
+            while (atomic_load(&g_catalog_state[id]) != 2) {
+            }
+        }
+    }
+    return &g_catalog[id];
+}
+
+static inline uint32_t
+crc_finish(const dsd_crc* crc, uint32_t r) {
+    return (r >> crc_shift(crc)) ^ crc->model.xorout;
+}
+
+uint32_t
+dsd_crc_bytes(const dsd_crc* crc, const uint8_t* data, size_t len) {
+    uint32_t r = crc_run_bytes(crc, crc->model.init << crc_shift(crc), data, len);
+    return crc_finish(crc, r);
+}
+
+uint32_t
+dsd_crc_packed_bits(const dsd_crc* crc, const uint8_t* data, size_t nbits) {
+    uint32_t r = crc_run_bytes(crc, crc->model.init << crc_shift(crc), data, nbits / 8);
+    const uint32_t poly = crc_poly_aligned(crc);
+    const uint8_t last = (nbits % 8) ? data[nbits / 8] : 0;
+    for (size_t i = 0; i < nbits % 8; i++) {
+        r = crc_step_bit(r, (last >> (7 - i)) & 1U, poly);
+    }
+    return crc_finish(crc, r);
+}
+
+uint32_t
+dsd_crc_bits_update(const dsd_crc* crc, uint32_t reg, const uint8_t* bits, size_t nbits) {
+    uint32_t r = reg << crc_shift(crc);
+    uint8_t chunk[64];
+
+    /* Pack up to 64 bytes at a time so the bulk still goes through slice-by-8. */
+    while (nbits >= 8) {
+        size_t n = nbits / 8;
+        if (n > sizeof(chunk)) {
+            n = sizeof(chunk);
+        }
+        for (size_t i = 0; i < n; i++) {
+            chunk[i] = crc_pack8(bits + i * 8);
+        }
+        r = crc_run_bytes(crc, r, chunk, n);
+        bits += n * 8;
+        nbits -= n * 8;
+    }
+    const uint32_t poly = crc_poly_aligned(crc);
+    for (size_t i = 0; i < nbits; i++) {
+        r = crc_step_bit(r, bits[i] & 1U, poly);
+    }
+    return r >> crc_shift(crc);
+}
+
+uint32_t
+dsd_crc_bits(const dsd_crc* crc, const uint8_t* bits, size_t nbits) {
+    return dsd_crc_bits_update(crc, crc->model.init, bits, nbits) ^ crc->model.xorout;
+}
+
+uint32_t
+dsd_crc_load_bits(const uint8_t* bits, unsigned int width) {
+    uint32_t v = 0;
+    for (unsigned int i = 0; i < width; i++) {
+        v = (v << 1) | (bits[i] & 1U);
+    }
+    return v;
+}
+
+int
+dsd_crc_bits_check(const dsd_crc* crc, const uint8_t* bits, size_t nbits) {
+    return dsd_crc_bits(crc, bits, nbits) == dsd_crc_load_bits(bits + nbits, crc->model.width);
+}
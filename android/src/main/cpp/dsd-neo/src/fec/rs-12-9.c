@@ -30,16 +30,15 @@
 
 //#include <libs/daemon/console.h>
 
-#include <stdio.h>
 #include <string.h>
 
 typedef struct {
-    uint8_t error_locations[256];
+    uint8_t error_locations[4]; // the locator has degree <= 3, so at most 3 roots
     uint8_t errors_num;
 } rs_12_9_roots_t;
 
 // See DMR AI. spec. page 138.
-static uint8_t rs_12_9_galois_exp_table[256] = {
+static const uint8_t rs_12_9_galois_exp_table[256] = {
     0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1D, 0x3A, 0x74, 0xE8, 0xCD, 0x87, 0x13, 0x26, 0x4C, 0x98, 0x2D,
     0x5A, 0xB4, 0x75, 0xEA, 0xC9, 0x8F, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x9D, 0x27, 0x4E, 0x9C, 0x25, 0x4A,
     0x94, 0x35, 0x6A, 0xD4, 0xB5, 0x77, 0xEE, 0xC1, 0x9F, 0x23, 0x46, 0x8C, 0x05, 0x0A, 0x14, 0x28, 0x50, 0xA0, 0x5D,
@@ -57,7 +56,7 @@ static uint8_t rs_12_9_galois_exp_table[256] = {
 };
 
 // See DMR AI. spec. page 138.
-static uint8_t rs_12_9_galois_log_table[256] = {
+static const uint8_t rs_12_9_galois_log_table[256] = {
     0,   0,   1,   25,  2,   50,  26,  198, 3,   223, 51,  238, 27,  104, 199, 75,  4,   100, 224, 14,  52,  141,
     239, 129, 28,  193, 105, 248, 200, 8,   76,  113, 5,   138, 101, 47,  225, 36,  15,  33,  53,  147, 142, 218,
     240, 18,  130, 69,  29,  181, 194, 125, 106, 39,  249, 185, 201, 154, 9,   120, 77,  228, 114, 166, 6,   191,
@@ -71,262 +70,201 @@ static uint8_t rs_12_9_galois_log_table[256] = {
     187, 204, 62,  90,  203, 89,  95,  176, 156, 169, 160, 81,  11,  245, 22,  235, 122, 117, 44,  215, 79,  174,
     213, 233, 230, 231, 173, 232, 116, 214, 244, 234, 168, 80,  88,  175};
 
-static uint8_t
-rs_12_9_galois_exp_table_get(uint8_t pos) {
-    return rs_12_9_galois_exp_table[pos];
+// All arithmetic is done in the log domain: the exp table is indexed by a
+// sum of logs reduced once (never with %), and the polynomials have fixed
+// small degrees (syndrome 3, error locator <= 3, error evaluator < 3), so the
+// loops below have constant trip counts.
+
+static inline uint8_t
+rs_12_9_exp_mod(unsigned e) {
+    return rs_12_9_galois_exp_table[(e >= 255) ? e - 255 : e];
 }
 
-static uint8_t
+static inline uint8_t
 rs_12_9_galois_multiplication(uint8_t a, uint8_t b) {
     if (a == 0 || b == 0) {
         return 0;
     }
-
-    return rs_12_9_galois_exp_table[(rs_12_9_galois_log_table[a] + rs_12_9_galois_log_table[b]) % 255];
-}
-
-static uint8_t
-rs_12_9_galois_inv(uint8_t elt) {
-    return rs_12_9_galois_exp_table[255 - rs_12_9_galois_log_table[elt]];
-}
-
-// Multiply by z (shift right by 1).
-static void
-rs_12_9_multiply_poly_z(rs_12_9_poly_t* poly) {
-    uint8_t i;
-
-    for (i = RS_12_9_POLY_MAXDEG - 1; i > 0; i--) {
-        poly->data[i] = poly->data[i - 1];
-    }
-    poly->data[0] = 0;
+    return rs_12_9_exp_mod((unsigned)rs_12_9_galois_log_table[a] + rs_12_9_galois_log_table[b]);
 }
 
-static void
-rs_12_9_multiplicate_polys(uint8_t dst[], rs_12_9_poly_t* p1, rs_12_9_poly_t* p2) {
-    int i;
-    int j;
-    int8_t tmp1[RS_12_9_POLY_MAXDEG * 2];
-
-    for (i = 0; i < RS_12_9_POLY_MAXDEG * 2; i++) {
-        dst[i] = 0;
-    }
-
-    for (i = 0; i < RS_12_9_POLY_MAXDEG; i++) {
-        for (j = RS_12_9_POLY_MAXDEG; j < (RS_12_9_POLY_MAXDEG * 2); j++) {
-            tmp1[j] = 0;
-        }
-
-        // Scale tmp1 by p1[i]
-        for (j = 0; j < RS_12_9_POLY_MAXDEG; j++) {
-            tmp1[j] = rs_12_9_galois_multiplication(p2->data[j], p1->data[i]);
-        }
-
-        // Shift (multiply) tmp1 right by i
-        for (j = (RS_12_9_POLY_MAXDEG * 2) - 1; j >= i; j--) {
-            tmp1[j] = tmp1[j - i];
-        }
-        for (j = 0; j < i; j++) {
-            tmp1[j] = 0;
-        }
-
-        // Add into partial product.
-        for (j = 0; j < (RS_12_9_POLY_MAXDEG * 2); j++) {
-            dst[j] ^= tmp1[j];
-        }
-    }
-}
-
-// Computes the combined erasure/error evaluator polynomial (error_locator_poly*syndrome mod z^4)
-static void
-rs_12_9_calc_error_evaluator_poly(rs_12_9_poly_t* error_locator_poly, rs_12_9_poly_t* syndrome,
-                                  rs_12_9_poly_t* error_evaluator_poly) {
-    uint8_t i;
-    uint8_t product[RS_12_9_POLY_MAXDEG * 2];
-
-    rs_12_9_multiplicate_polys(product, error_locator_poly, syndrome);
-    for (i = 0; i < RS_12_9_CHECKSUMSIZE; i++) {
-        error_evaluator_poly->data[i] = product[i];
-    }
-    for (; i < RS_12_9_POLY_MAXDEG; i++) {
-        error_evaluator_poly->data[i] = 0;
+// a * alpha^e for 0 <= e < 255.
+static inline uint8_t
+rs_12_9_galois_mul_exp(uint8_t a, unsigned e) {
+    if (a == 0) {
+        return 0;
     }
+    return rs_12_9_exp_mod((unsigned)rs_12_9_galois_log_table[a] + e);
 }
 
-static uint8_t
-rs_12_9_compute_discrepancy(rs_12_9_poly_t* error_locator_poly, rs_12_9_poly_t* syndrome, uint8_t L, uint8_t n) {
-    uint8_t i;
-    uint8_t sum = 0;
-
-    for (i = 0; i <= L; i++) {
-        sum ^= rs_12_9_galois_multiplication(error_locator_poly->data[i], syndrome->data[n - i]);
-    }
-
-    return sum;
+// Inverse via the log table; like the original code, inv(0) yields 1.
+static inline uint8_t
+rs_12_9_galois_inv(uint8_t elt) {
+    return rs_12_9_galois_exp_table[255 - rs_12_9_galois_log_table[elt]];
 }
 
 // This finds the coefficients of the error locator polynomial, and then calculates
 // the error evaluator polynomial using the Berlekamp-Massey algorithm.
 // From  Cain, Clark, "Error-Correction Coding For Digital Communications", pp. 216.
 static void
-rs_12_9_calculate(rs_12_9_poly_t* syndrome, rs_12_9_poly_t* error_locator_poly, rs_12_9_poly_t* error_evaluator_poly) {
-    uint8_t n;
+rs_12_9_calculate(const rs_12_9_poly_t* syndrome, rs_12_9_poly_t* error_locator_poly,
+                  rs_12_9_poly_t* error_evaluator_poly) {
     uint8_t L = 0;
-    uint8_t L2;
-    int8_t k;
-    uint8_t d;
-    uint8_t i;
-    uint8_t psi2[RS_12_9_POLY_MAXDEG];
-    rs_12_9_poly_t D = {.data = {
-                            0,
-                            1,
-                            0,
-                        }};
-
-    k = -1;
+    int k = -1;
+    uint8_t D[RS_12_9_POLY_MAXDEG] = {0, 1, 0, 0, 0, 0};
+    uint8_t* lambda = error_locator_poly->data;
+
     memset(error_locator_poly, 0, sizeof(rs_12_9_poly_t));
-    error_locator_poly->data[0] = 1;
+    lambda[0] = 1;
 
-    for (n = 0; n < RS_12_9_CHECKSUMSIZE; n++) {
-        d = rs_12_9_compute_discrepancy(error_locator_poly, syndrome, L, n);
+    for (int n = 0; n < RS_12_9_CHECKSUMSIZE; n++) {
+        // Discrepancy: sum(lambda[i] * S[n - i]) for i <= L
+        uint8_t d = 0;
+        for (int i = 0; i <= L; i++) {
+            d ^= rs_12_9_galois_multiplication(lambda[i], syndrome->data[n - i]);
+        }
 
         if (d != 0) {
-            // psi2 = error_locator_poly - d*D
-            for (i = 0; i < RS_12_9_POLY_MAXDEG; i++) {
-                psi2[i] = error_locator_poly->data[i] ^ rs_12_9_galois_multiplication(d, D.data[i]);
+            uint8_t psi2[RS_12_9_POLY_MAXDEG];
+            const unsigned log_d = rs_12_9_galois_log_table[d];
+            for (int i = 0; i < RS_12_9_POLY_MAXDEG; i++) {
+                psi2[i] = lambda[i] ^ rs_12_9_galois_mul_exp(D[i], log_d);
             }
 
             if (L < (n - k)) {
-                L2 = n - k;
+                uint8_t L2 = (uint8_t)(n - k);
                 k = n - L;
-
-                for (i = 0; i < RS_12_9_POLY_MAXDEG; i++) {
-                    D.data[i] = rs_12_9_galois_multiplication(error_locator_poly->data[i], rs_12_9_galois_inv(d));
+                const unsigned log_inv_d = 255 - log_d;
+                for (int i = 0; i < RS_12_9_POLY_MAXDEG; i++) {
+                    D[i] = rs_12_9_galois_mul_exp(lambda[i], log_inv_d);
                 }
-
                 L = L2;
             }
 
-            // error_locator_poly = psi2
-            for (i = 0; i < RS_12_9_POLY_MAXDEG; i++) {
-                error_locator_poly->data[i] = psi2[i];
-            }
+            memcpy(lambda, psi2, sizeof(psi2));
         }
 
-        rs_12_9_multiply_poly_z(&D);
+        // D *= z
+        memmove(&D[1], &D[0], RS_12_9_POLY_MAXDEG - 1);
+        D[0] = 0;
     }
 
-    rs_12_9_calc_error_evaluator_poly(error_locator_poly, syndrome, error_evaluator_poly);
+    // Error evaluator: (lambda * S) mod z^3
+    memset(error_evaluator_poly, 0, sizeof(rs_12_9_poly_t));
+    for (int i = 0; i < RS_12_9_CHECKSUMSIZE; i++) {
+        uint8_t sum = 0;
+        for (int j = 0; j <= i; j++) {
+            sum ^= rs_12_9_galois_multiplication(lambda[j], syndrome->data[i - j]);
+        }
+        error_evaluator_poly->data[i] = sum;
+    }
 }
 
 // The error-locator polynomial's roots are found by looking for the values of a^n where
-// evaluating the polynomial yields zero (evaluating rs_12_9_error_locator_poly at
-// successive values of alpha (Chien's search)).
-static rs_12_9_roots_t*
-rs_12_9_find_roots(rs_12_9_poly_t* error_locator_poly) {
-    static rs_12_9_roots_t roots;
-    uint8_t sum;
-    uint16_t r;
-    uint8_t k;
-
-    memset(&roots, 0, sizeof(rs_12_9_roots_t));
-
-    for (r = 1; r < 256; r++) {
-        sum = 0;
-        // Evaluate rs_12_9_error_locator_poly at r
-        for (k = 0; k < RS_12_9_CHECKSUMSIZE + 1; k++) {
-            sum ^=
-                rs_12_9_galois_multiplication(rs_12_9_galois_exp_table_get((k * r) % 255), error_locator_poly->data[k]);
+// evaluating the polynomial yields zero (Chien's search). Only lambda[0..3] take part.
+// A linear locator (the single-error case) is solved directly; otherwise each term is
+// stepped by multiplying with alpha^k instead of recomputing alpha^(k*r).
+static void
+rs_12_9_find_roots(const rs_12_9_poly_t* error_locator_poly, rs_12_9_roots_t* roots) {
+    const uint8_t* lambda = error_locator_poly->data;
+    memset(roots, 0, sizeof(*roots));
+
+    if (lambda[2] == 0 && lambda[3] == 0) {
+        // lambda[0] + lambda[1] * x: root alpha^r with r = -log(lambda[1] / lambda[0]), r in 1..255
+        if (lambda[1] != 0 && lambda[0] != 0) {
+            int r = (int)rs_12_9_galois_log_table[lambda[0]] - (int)rs_12_9_galois_log_table[lambda[1]];
+            if (r <= 0) {
+                r += 255;
+            }
+            roots->error_locations[roots->errors_num++] = (uint8_t)(255 - r);
         }
+        return;
+    }
 
-        if (sum == 0) {
-            roots.error_locations[roots.errors_num++] = (255 - r);
+    uint8_t term[RS_12_9_CHECKSUMSIZE + 1];
+    for (int k = 0; k <= RS_12_9_CHECKSUMSIZE; k++) {
+        term[k] = lambda[k];
+    }
+    for (unsigned r = 1; r < 256; r++) {
+        uint8_t sum = term[0];
+        for (int k = 1; k <= RS_12_9_CHECKSUMSIZE; k++) {
+            term[k] = rs_12_9_galois_mul_exp(term[k], (unsigned)k);
+            sum ^= term[k];
+        }
+        if (sum == 0 && roots->errors_num < RS_12_9_CHECKSUMSIZE + 1) {
+            roots->error_locations[roots->errors_num++] = (uint8_t)(255 - r);
         }
     }
-    return &roots;
 }
 
 void
 rs_12_9_calc_syndrome(rs_12_9_codeword_t* codeword, rs_12_9_poly_t* syndrome) {
-    size_t i;
-    int j;
-
-    syndrome->data[0] = syndrome->data[1] = syndrome->data[2] = 0;
-
-    for (j = 0; j < 3; j++) {
-        for (i = 0; i < sizeof(rs_12_9_codeword_t); i++) {
-            syndrome->data[j] = codeword->data[i]
-                                ^ rs_12_9_galois_multiplication(rs_12_9_galois_exp_table_get(j + 1), syndrome->data[j]);
-        }
+    uint8_t s0 = 0;
+    uint8_t s1 = 0;
+    uint8_t s2 = 0;
+
+    // Horner evaluation at alpha^1..alpha^3, all three in one pass over the codeword
+    for (size_t i = 0; i < sizeof(rs_12_9_codeword_t); i++) {
+        const uint8_t c = codeword->data[i];
+        s0 = c ^ rs_12_9_galois_mul_exp(s0, 1);
+        s1 = c ^ rs_12_9_galois_mul_exp(s1, 2);
+        s2 = c ^ rs_12_9_galois_mul_exp(s2, 3);
     }
+    syndrome->data[0] = s0;
+    syndrome->data[1] = s1;
+    syndrome->data[2] = s2;
 }
 
 // Returns 1 if syndrome differs from all zeroes.
 uint8_t
 rs_12_9_check_syndrome(rs_12_9_poly_t* syndrome) {
-    uint8_t i;
-
-    for (i = 0; i < 3; i++) {
-        if (syndrome->data[i] != 0) {
-            return 1;
-        }
-    }
-
-    return 0;
+    return (uint8_t)((syndrome->data[0] | syndrome->data[1] | syndrome->data[2]) != 0);
 }
 
 // Returns 1 if errors have been found and corrected, returns 0 if
 // no errors found or errors can't be corrected.
 rs_12_9_correct_errors_result_t
 rs_12_9_correct_errors(rs_12_9_codeword_t* codeword, rs_12_9_poly_t* syndrome, uint8_t* errors_found) {
-    uint8_t r;
-    uint8_t i;
-    uint8_t j;
-    uint8_t err;
     rs_12_9_poly_t error_locator_poly;
     rs_12_9_poly_t error_evaluator_poly;
-    rs_12_9_roots_t* roots;
-    uint8_t num, denom;
+    rs_12_9_roots_t roots;
 
     rs_12_9_calculate(syndrome, &error_locator_poly, &error_evaluator_poly);
-    roots = rs_12_9_find_roots(&error_locator_poly);
-    *errors_found = roots->errors_num;
+    rs_12_9_find_roots(&error_locator_poly, &roots);
+    *errors_found = roots.errors_num;
 
-    if (roots->errors_num == 0) {
+    if (roots.errors_num == 0) {
         return RS_12_9_CORRECT_ERRORS_RESULT_NO_ERRORS_FOUND;
     }
 
     // Error correction is done using the error-evaluator equation on pp 207.
-    if (roots->errors_num > 0 && roots->errors_num <= RS_12_9_CHECKSUMSIZE) {
+    if (roots.errors_num <= RS_12_9_CHECKSUMSIZE) {
         // First check for illegal error locations.
-        for (r = 0; r < roots->errors_num; r++) {
-            if (roots->error_locations[r] >= RS_12_9_DATASIZE + RS_12_9_CHECKSUMSIZE) {
+        for (uint8_t r = 0; r < roots.errors_num; r++) {
+            if (roots.error_locations[r] >= RS_12_9_DATASIZE + RS_12_9_CHECKSUMSIZE) {
                 return RS_12_9_CORRECT_ERRORS_RESULT_ERRORS_CANT_BE_CORRECTED;
             }
         }
 
-        // Evaluates rs_12_9_error_evaluator_poly/rs_12_9_error_locator_poly' at the roots
+        // Evaluates error_evaluator_poly/error_locator_poly' at the roots
         // alpha^(-i) for error locs i.
-        for (r = 0; r < roots->errors_num; r++) {
-            i = roots->error_locations[r];
-
-            // Evaluate rs_12_9_error_evaluator_poly at alpha^(-i)
-            num = 0;
-            for (j = 0; j < RS_12_9_POLY_MAXDEG; j++) {
-                num ^= rs_12_9_galois_multiplication(error_evaluator_poly.data[j],
-                                                     rs_12_9_galois_exp_table_get(((255 - i) * j) % 255));
-            }
+        for (uint8_t r = 0; r < roots.errors_num; r++) {
+            const unsigned inv_i = 255u - roots.error_locations[r];
 
-            // Evaluate rs_12_9_error_evaluator_poly' (derivative) at alpha^(-i). All odd powers disappear.
-            denom = 0;
-            for (j = 1; j < RS_12_9_POLY_MAXDEG; j += 2) {
-                denom ^= rs_12_9_galois_multiplication(error_locator_poly.data[j],
-                                                       rs_12_9_galois_exp_table_get(((255 - i) * (j - 1)) % 255));
+            // Evaluate error_evaluator_poly (degree < 3) at alpha^(-i)
+            uint8_t num = 0;
+            for (unsigned j = 0; j < RS_12_9_CHECKSUMSIZE; j++) {
+                num ^= rs_12_9_galois_mul_exp(error_evaluator_poly.data[j], (inv_i * j) % 255u);
             }
 
-            err = rs_12_9_galois_multiplication(num, rs_12_9_galois_inv(denom));
-            //console_log(LOGLEVEL_CODING LOGLEVEL_DEBUG "    rs (12,9): error magnitude %#x at byte loc. %u\n", err, sizeof(rs_12_9_codeword_t)-i);
+            // Evaluate error_locator_poly' (derivative) at alpha^(-i). All odd powers disappear.
+            uint8_t denom = 0;
+            for (unsigned j = 1; j < RS_12_9_POLY_MAXDEG; j += 2) {
+                denom ^= rs_12_9_galois_mul_exp(error_locator_poly.data[j], (inv_i * (j - 1)) % 255u);
+            }
 
-            codeword->data[sizeof(rs_12_9_codeword_t) - i - 1] ^= err;
+            const uint8_t err = rs_12_9_galois_multiplication(num, rs_12_9_galois_inv(denom));
+            codeword->data[sizeof(rs_12_9_codeword_t) - roots.error_locations[r] - 1] ^= err;
         }
         return RS_12_9_CORRECT_ERRORS_RESULT_ERRORS_CORRECTED;
     }
@@ -338,7 +276,7 @@ rs_12_9_correct_errors(rs_12_9_codeword_t* codeword, rs_12_9_poly_t* syndrome, u
 rs_12_9_checksum_t*
 rs_12_9_calc_checksum(rs_12_9_codeword_t* codeword) {
     // See DMR AI. spec. page 136 for these coefficients.
-    static uint8_t genpoly[] = {0x40, 0x38, 0x0e, 0x01};
+    static const uint8_t genpoly[] = {0x40, 0x38, 0x0e, 0x01};
     static rs_12_9_checksum_t rs_12_9_checksum;
     uint8_t i;
     uint8_t feedback;
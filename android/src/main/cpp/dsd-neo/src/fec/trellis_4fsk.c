@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Table-driven Viterbi engine for the P25/DMR 1/2- and 3/4-rate trellis codes.
+ */
+
+#include <dsd-neo/fec/trellis_4fsk.h>
+#include <dsd-neo/platform/atomic_compat.h>
+
+#include <string.h>
+
+const uint8_t dsd_trellis_interleave[DSD_TRELLIS_DIBITS] = {
+    0,  1,  8,  9,  16, 17, 24, 25, 32, 33, 40, 41, 48, 49, 56, 57, 64, 65, 72, 73, 80, 81, 88, 89, 96,
+    97, 2,  3,  10, 11, 18, 19, 26, 27, 34, 35, 42, 43, 50, 51, 58, 59, 66, 67, 74, 75, 82, 83, 90, 91,
+    4,  5,  12, 13, 20, 21, 28, 29, 36, 37, 44, 45, 52, 53, 60, 61, 68, 69, 76, 77, 84, 85, 92, 93, 6,
+    7,  14, 15, 22, 23, 30, 31, 38, 39, 46, 47, 54, 55, 62, 63, 70, 71, 78, 79, 86, 87, 94, 95};
+
+const uint8_t dsd_trellis_constellation[16] = {11, 12, 0, 7, 14, 9, 5, 2, 10, 13, 1, 6, 15, 8, 4, 3};
+
+const uint8_t dsd_trellis_fsm34[64] = {0, 8,  4, 12, 2, 10, 6, 14, 4, 12, 2, 10, 6, 14, 0, 8, 1, 9,  5, 13, 3, 11,
+                                       7, 15, 5, 13, 3, 11, 7, 15, 1, 9,  3, 11, 7, 15, 1, 9, 5, 13, 7, 15, 1, 9,
+                                       5, 13, 3, 11, 2, 10, 6, 14, 0, 8,  4, 12, 6, 14, 0, 8, 4, 12, 2, 10};
+
+/* 1/2 rate: dibit-pair nibble sent for (prev << 2) | next (SDRTrunk and Ossmann). */
+static const uint8_t k_dtm12[16] = {2, 12, 1, 15, 14, 0, 13, 3, 9, 7, 10, 4, 5, 11, 6, 8};
+
+static dsd_trellis g_codes[DSD_TRELLIS_ID_COUNT];
+static atomic_int g_codes_state[DSD_TRELLIS_ID_COUNT]; /* 0 = empty, 1 = building, 2 = ready */
+
+static inline uint8_t
+pop4(unsigned x) {
+    static const uint8_t k_pop4[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+    return k_pop4[x & 0xF];
+}
+
+static void
+trellis_build(dsd_trellis* t, dsd_trellis_id id) {
+    memset(t, 0, sizeof(*t));
+    uint8_t point_to_nib[16];
+    for (int n = 0; n < 16; n++) {
+        point_to_nib[dsd_trellis_constellation[n]] = (uint8_t)n;
+    }
+
+    t->states = (id == DSD_TRELLIS_12) ? 4 : 8;
+    t->bits = (id == DSD_TRELLIS_12) ? 2 : 3;
+    for (int ps = 0; ps < t->states; ps++) {
+        for (int ns = 0; ns < t->states; ns++) {
+            const int tr = ps * 8 + ns;
+            t->expect[tr] = (id == DSD_TRELLIS_12) ? k_dtm12[(ps << 2) | ns] : point_to_nib[dsd_trellis_fsm34[tr]];
+            for (int obs = 0; obs < 16; obs++) {
+                unsigned x = (unsigned)(obs ^ t->expect[tr]);
+                t->miss_hi[obs][tr] = pop4(x & 0xC);
+                t->miss_lo[obs][tr] = pop4(x & 0x3);
+                if (id == DSD_TRELLIS_12) {
+                    t->hard[obs][tr] = pop4(x);
+                } else {
+                    t->hard[obs][tr] = pop4(dsd_trellis_fsm34[tr] ^ dsd_trellis_constellation[obs]);
+                }
+            }
+        }
+    }
+}
+
+const dsd_trellis*
+dsd_trellis_get(dsd_trellis_id id) {
+    if ((unsigned)id >= DSD_TRELLIS_ID_COUNT) {
+        return NULL;
+    }
+    if (atomic_load(&g_codes_state[id]) != 2) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&g_codes_state[id], &expected, 1)) {
+            trellis_build(&g_codes[id], id);
+            atomic_store(&g_codes_state[id], 2);
+        } else {
+            while (atomic_load(&g_codes_state[id]) != 2) {
+            }
+        }
+    }
+    return &g_codes[id];
+}
+
+void
+dsd_trellis_deinterleave(const uint8_t dibits98[DSD_TRELLIS_DIBITS], const uint8_t* reliab98,
+                         uint8_t nibs[DSD_TRELLIS_SYMS], uint8_t* rhi, uint8_t* rlo) {
+    uint8_t dei[DSD_TRELLIS_DIBITS];
+    for (int i = 0; i < DSD_TRELLIS_DIBITS; i++) {
+        dei[dsd_trellis_interleave[i]] = (uint8_t)(dibits98[i] & 0x3u);
+    }
+    for (int i = 0; i < DSD_TRELLIS_SYMS; i++) {
+        nibs[i] = (uint8_t)((dei[i * 2] << 2) | dei[i * 2 + 1]);
+    }
+    if (reliab98 && rhi && rlo) {
+        for (int i = 0; i < DSD_TRELLIS_DIBITS; i++) {
+            dei[dsd_trellis_interleave[i]] = reliab98[i];
+        }
+        for (int i = 0; i < DSD_TRELLIS_SYMS; i++) {
+            rhi[i] = dei[i * 2];
+            rlo[i] = dei[i * 2 + 1];
+        }
+    }
+}
+
+/*
+ * One add-compare-select step over all next states at once. The lane count
+ * is fixed at 8 for both codes (the 4-state code leaves lanes 4..7 unused),
+ * so the inner loop has a constant trip count and no branches and compiles to
+ * packed adds/compares/blends. Predecessors are visited in ascending order
+ * with a strict compare, so the lowest predecessor wins ties.
+ */
+static inline void
+trellis_acs(const uint32_t* prev, const uint32_t* bm, uint32_t* curr, uint8_t* bp, int n_prev) {
+    uint32_t m[8];
+    uint32_t b[8];
+    for (int ns = 0; ns < 8; ns++) {
+        m[ns] = prev[0] + bm[ns];
+        b[ns] = 0;
+    }
+    for (int ps = 1; ps < n_prev; ps++) {
+        const uint32_t pm = prev[ps];
+        const uint32_t* row = bm + ps * 8;
+        for (int ns = 0; ns < 8; ns++) {
+            uint32_t c = pm + row[ns];
+            uint32_t lt = (uint32_t)0 - (uint32_t)(c < m[ns]);
+            m[ns] = (c & lt) | (m[ns] & ~lt);
+            b[ns] = ((uint32_t)ps & lt) | (b[ns] & ~lt);
+        }
+    }
+    for (int ns = 0; ns < 8; ns++) {
+        curr[ns] = m[ns];
+        bp[ns] = (uint8_t)b[ns];
+    }
+}
+
+uint32_t
+dsd_trellis_viterbi(const dsd_trellis* code, const uint8_t nibs[DSD_TRELLIS_SYMS], const uint8_t* rhi,
+                    const uint8_t* rlo, uint32_t start_bias, int end_state, uint8_t path[DSD_TRELLIS_SYMS]) {
+    const int S = code->states;
+    if (end_state >= S) {
+        return DSD_TRELLIS_UNREACHABLE;
+    }
+
+    uint32_t metric[2][8];
+    uint32_t bm[64];
+    uint8_t backptr[DSD_TRELLIS_SYMS][8];
+    const int soft = (rhi != NULL && rlo != NULL);
+
+    for (int s = 0; s < 8; s++) {
+        metric[0][s] = (s == 0) ? 0 : start_bias;
+    }
+    for (int t = 0; t < DSD_TRELLIS_SYMS; t++) {
+        const uint8_t obs = nibs[t] & 0xF;
+        const uint32_t* step = code->hard[obs];
+        if (soft) {
+            const uint32_t wh = rhi[t];
+            const uint32_t wl = rlo[t];
+            for (int i = 0; i < 64; i++) {
+                bm[i] = code->miss_hi[obs][i] * wh + code->miss_lo[obs][i] * wl;
+            }
+            step = bm;
+        }
+        trellis_acs(metric[t & 1], step, metric[(t + 1) & 1], backptr[t], S);
+    }
+
+    const uint32_t* final = metric[DSD_TRELLIS_SYMS & 1];
+    int st = end_state;
+    if (st < 0) {
+        st = 0;
+        for (int s = 1; s < S; s++) {
+            if (final[s] < final[st]) {
+                st = s;
+            }
+        }
+    }
+    const uint32_t best = final[st];
+    for (int t = DSD_TRELLIS_SYMS - 1; t >= 0; t--) {
+        path[t] = (uint8_t)st;
+        st = backptr[t][st];
+    }
+    return best;
+}
+
+void
+dsd_trellis_pack(const dsd_trellis* code, const uint8_t path[DSD_TRELLIS_SYMS], uint8_t* out) {
+    const unsigned bits = code->bits;
+    const uint8_t mask = (uint8_t)((1u << bits) - 1u);
+    /* 8 symbols fill a whole number of bytes at either rate (16 or 24 bits). */
+    for (int g = 0; g < 6; g++) {
+        uint32_t acc = 0;
+        for (int k = 0; k < 8; k++) {
+            acc = (acc << bits) | (path[g * 8 + k] & mask);
+        }
+        for (unsigned b = 0; b < bits; b++) {
+            *out++ = (uint8_t)(acc >> (8 * (bits - 1 - b)));
+        }
+    }
+}
+
+void
+dsd_trellis_encode(const dsd_trellis* code, const uint8_t* in, uint8_t dibits98[DSD_TRELLIS_DIBITS]) {
+    const unsigned bits = code->bits;
+    uint8_t de[DSD_TRELLIS_DIBITS];
+    uint8_t state = 0;
+    for (int t = 0; t < DSD_TRELLIS_SYMS; t++) {
+        uint8_t sym = 0; /* flush symbol */
+        if (t < 48) {
+            unsigned bit = (unsigned)t * bits;
+            unsigned v = ((unsigned)in[bit / 8] << 8) | ((bit / 8 + 1 < 6u * bits) ? in[bit / 8 + 1] : 0u);
+            sym = (uint8_t)((v >> (16 - bits - bit % 8)) & ((1u << bits) - 1u));
+        }
+        uint8_t nib = code->expect[state * 8 + sym];
+        de[t * 2] = (uint8_t)(nib >> 2);
+        de[t * 2 + 1] = (uint8_t)(nib & 0x3u);
+        state = sym;
+    }
+    for (int i = 0; i < DSD_TRELLIS_DIBITS; i++) {
+        dibits98[i] = de[dsd_trellis_interleave[i]];
+    }
+}
@@ -10,6 +10,7 @@
  * Implements the opaque `rtl_device` handle, device configuration helpers,
  * realtime threading hooks, and the asynchronous USB callback that widens
  * u8 I/Q samples into normalized float and feeds the `input_ring_state`.
+ * Also hosts the rtl_tcp client and the in-process external IQ backend.
  */
 
 #include <atomic>
@@ -22,6 +23,7 @@
 #include <dsd-neo/runtime/input_ring.h>
 #include <dsd-neo/runtime/rt_sched.h>
 #include <errno.h>
+#include <limits.h>
 #include <math.h>
 #include <rtl-sdr.h>
 #include <stdio.h>
@@ -62,7 +64,7 @@ struct rtl_device {
     int thread_started;
     struct input_ring_state* input_ring;
     int combine_rotate_enabled;
-    /* Backend selector: 0 = USB (librtlsdr), 1 = rtl_tcp */
+    /* Backend selector: 0 = USB (librtlsdr), 1 = rtl_tcp, 2 = external IQ push */
     int backend;
     /* rtl_tcp connection */
     dsd_socket_t sockfd;
@@ -300,6 +302,127 @@ static DSD_THREAD_RETURN_TYPE
     DSD_THREAD_RETURN;
 }
 
+/* ---- external IQ backend ---- */
+
+/* Device currently accepting rtl_device_push_iq(), and the number of pushes in
+   flight so stop/destroy can wait until no producer still references it. */
+static std::atomic<struct rtl_device*> g_external_dev{nullptr};
+static std::atomic<int> g_external_pushers{0};
+
+static size_t
+rtl_iq_component_size(rtl_iq_format fmt) {
+    switch (fmt) {
+        case RTL_IQ_CS8:
+        case RTL_IQ_CU8: return 1;
+        case RTL_IQ_CS16: return 2;
+        case RTL_IQ_CF32: return 4;
+        default: return 0;
+    }
+}
+
+static void
+external_widen(rtl_iq_format fmt, const unsigned char* src, float* dst, size_t n) {
+    switch (fmt) {
+        case RTL_IQ_CS8: widen_s8_to_f32(reinterpret_cast<const int8_t*>(src), dst, (uint32_t)n); break;
+        case RTL_IQ_CU8: widen_u8_to_f32_bias127(src, dst, (uint32_t)n); break;
+        case RTL_IQ_CS16: widen_s16_to_f32(reinterpret_cast<const int16_t*>(src), dst, (uint32_t)n); break;
+        case RTL_IQ_CF32: memcpy(dst, src, n * sizeof(float)); break;
+        default: break;
+    }
+}
+
+/**
+ * @brief Stop accepting pushes for `dev` and wait out any push still writing to its ring.
+ */
+static void
+external_detach(struct rtl_device* dev) {
+    struct rtl_device* expected = dev;
+    (void)g_external_dev.compare_exchange_strong(expected, nullptr);
+    while (g_external_pushers.load() > 0) {
+        dsd_sleep_ms(1);
+    }
+}
+
+int
+rtl_device_push_iq(rtl_iq_format fmt, const void* data, size_t len) {
+    size_t csize = rtl_iq_component_size(fmt);
+    if (!data || csize == 0) {
+        return -1;
+    }
+    /* Register as in flight before looking up the device (pairs with external_detach). */
+    g_external_pushers.fetch_add(1);
+    struct rtl_device* s = g_external_dev.load();
+    if (!s) {
+        g_external_pushers.fetch_sub(1);
+        return -1;
+    }
+    if (len > (size_t)INT_MAX) {
+        len = (size_t)INT_MAX;
+    }
+    /* Whole I/Q pairs only */
+    size_t comps = (len / (2 * csize)) * 2;
+    int consumed = (int)(comps * csize);
+    if (exitflag || comps == 0) {
+        g_external_pushers.fetch_sub(1);
+        return consumed;
+    }
+    const unsigned char* buf = static_cast<const unsigned char*>(data);
+
+    /* Mute is counted in components here, matching one u8 byte per component on the USB path. */
+    int old = s->mute.load(std::memory_order_relaxed);
+    if (old > 0) {
+        size_t m = (size_t)old;
+        if (m >= comps) {
+            s->mute.fetch_sub((int)comps, std::memory_order_relaxed);
+            g_external_pushers.fetch_sub(1);
+            return consumed;
+        }
+        m = (m + 1) & ~(size_t)1; /* keep I/Q pairs aligned; comps is even so m <= comps */
+        buf += m * csize;
+        comps -= m;
+        s->mute.fetch_sub((int)m, std::memory_order_relaxed);
+        if (comps == 0) {
+            g_external_pushers.fetch_sub(1);
+            return consumed;
+        }
+    }
+
+    size_t need = comps;
+    while (need > 0) {
+        float *p1 = NULL, *p2 = NULL;
+        size_t n1 = 0, n2 = 0;
+        input_ring_reserve(s->input_ring, need, &p1, &n1, &p2, &n2);
+        if (n1 == 0 && n2 == 0) {
+            s->input_ring->producer_drops.fetch_add((uint64_t)need);
+            break;
+        }
+        if (n1 & 1) {
+            n1--;
+        }
+        size_t w1 = (n1 < need) ? n1 : need;
+        if (n2 & 1) {
+            n2--;
+        }
+        size_t w2 = (n2 < need - w1) ? n2 : need - w1;
+        if (w1 + w2 == 0) {
+            /* A single free slot cannot hold a pair */
+            s->input_ring->producer_drops.fetch_add((uint64_t)need);
+            break;
+        }
+        if (w1) {
+            external_widen(fmt, buf, p1, w1);
+        }
+        if (w2) {
+            external_widen(fmt, buf + w1 * csize, p2, w2);
+        }
+        input_ring_commit(s->input_ring, w1 + w2);
+        buf += (w1 + w2) * csize;
+        need -= w1 + w2;
+    }
+    g_external_pushers.fetch_sub(1);
+    return consumed;
+}
+
 /* ---- rtl_tcp backend helpers ---- */
 
 /* Connect to rtl_tcp server */
@@ -948,6 +1071,11 @@ rtl_device_print_offset_capability(struct rtl_device* dev) {
     if (!dev) {
         return;
     }
+    if (dev->backend == 2) {
+        fprintf(stderr, "external IQ: samples arrive centered from the producer; offset tuning is always on (no fs/4 "
+                        "shift).\n");
+        return;
+    }
     if (dev->backend == 1) {
         fprintf(stderr,
                 "rtl_tcp: offset tuning capability is determined by the server; defaulting to disabled to match USB "
@@ -1264,6 +1392,35 @@ rtl_device_create_tcp(const char* host, int port, struct input_ring_state* input
     return dev;
 }
 
+struct rtl_device*
+rtl_device_create_external(struct input_ring_state* input_ring, int combine_rotate_enabled_param) {
+    if (!input_ring) {
+        return NULL;
+    }
+    struct rtl_device* dev = static_cast<rtl_device*>(calloc(1, sizeof(struct rtl_device)));
+    if (!dev) {
+        return NULL;
+    }
+    dev->dev = NULL;
+    dev->dev_index = -1;
+    dev->input_ring = input_ring;
+    dev->thread_started = 0;
+    dev->mute = 0;
+    dev->combine_rotate_enabled = combine_rotate_enabled_param;
+    dev->backend = 2;
+    dev->sockfd = DSD_INVALID_SOCKET;
+    dev->host[0] = '\0';
+    dev->port = 0;
+    dev->run.store(0);
+    dev->agc_mode = 1;
+    dev->offset_tuning = 1;
+    dev->testmode_on = 0;
+    dev->rtl_xtal_hz = 0;
+    dev->tuner_xtal_hz = 0;
+    dev->if_gain_count = 0;
+    return dev;
+}
+
 /**
  * @brief Destroy an RTL-SDR device and free resources.
  *
@@ -1275,6 +1432,10 @@ rtl_device_destroy(struct rtl_device* dev) {
         return;
     }
 
+    if (dev->thread_started && dev->backend == 2) {
+        external_detach(dev);
+        dev->thread_started = 0;
+    }
     if (dev->thread_started) {
         /* Ensure async read is cancelled before joining to avoid blocking */
         if (dev->backend == 0) {
@@ -1335,6 +1496,8 @@ rtl_device_set_frequency(struct rtl_device* dev, uint32_t frequency) {
             return -1;
         }
         return verbose_set_frequency(dev->dev, frequency);
+    } else if (dev->backend == 2) {
+        return 0; /* producer owns the tuner */
     } else {
         return rtl_tcp_send_cmd(dev->sockfd, 0x01, frequency);
     }
@@ -1358,6 +1521,8 @@ rtl_device_set_sample_rate(struct rtl_device* dev, uint32_t samp_rate) {
             return -1;
         }
         return verbose_set_sample_rate(dev->dev, samp_rate);
+    } else if (dev->backend == 2) {
+        return 0;
     } else {
         return rtl_tcp_send_cmd(dev->sockfd, 0x02, samp_rate);
     }
@@ -1408,6 +1573,9 @@ rtl_device_set_gain(struct rtl_device* dev, int gain) {
             int nearest = nearest_gain(dev->dev, gain);
             return verbose_gain_set(dev->dev, nearest);
         }
+    } else if (dev->backend == 2) {
+        dev->agc_mode = (gain == AUTO_GAIN) ? 1 : 0;
+        return 0;
     } else {
         if (gain == AUTO_GAIN) {
             dev->agc_mode = 1;
@@ -1457,6 +1625,11 @@ rtl_device_set_gain_nearest(struct rtl_device* dev, int target_tenth_db) {
         fprintf(stderr, "Tuner manual gain (nearest): %0.1f dB.\n", (double)g / 10.0);
         return 0;
     }
+    if (dev->backend == 2) {
+        dev->agc_mode = 0;
+        dev->gain = target_tenth_db;
+        return 0;
+    }
     /* rtl_tcp: request manual mode and set target directly */
     int mode = 1;
     (void)rtl_tcp_send_cmd(dev->sockfd, 0x03, (uint32_t)mode);
@@ -1519,6 +1692,8 @@ rtl_device_set_ppm(struct rtl_device* dev, int ppm_error) {
             return -1;
         }
         return verbose_ppm_set(dev->dev, ppm_error);
+    } else if (dev->backend == 2) {
+        return 0;
     } else {
         return rtl_tcp_send_cmd(dev->sockfd, 0x05, (uint32_t)ppm_error);
     }
@@ -1542,6 +1717,8 @@ rtl_device_set_direct_sampling(struct rtl_device* dev, int on) {
             return -1;
         }
         return verbose_direct_sampling(dev->dev, on);
+    } else if (dev->backend == 2) {
+        return on ? -1 : 0;
     } else {
         return rtl_tcp_send_cmd(dev->sockfd, 0x09, (uint32_t)on);
     }
@@ -1577,6 +1754,9 @@ rtl_device_set_offset_tuning_enabled(struct rtl_device* dev, int on) {
             }
             fprintf(stderr, "WARNING: Failed to set offset tuning (%d) for tuner %s.\n", r, tt);
         }
+    } else if (dev->backend == 2) {
+        /* External samples are already centered; disabling would add an fs/4 shift nobody undoes. */
+        r = on ? 0 : -1;
     } else {
         r = rtl_tcp_send_cmd(dev->sockfd, 0x0A, (uint32_t)(on ? 1 : 0));
     }
@@ -1646,6 +1826,13 @@ rtl_device_start_async(struct rtl_device* dev, uint32_t buf_len) {
             return -1;
         }
         r = dsd_thread_create(&dev->thread, (dsd_thread_fn)dongle_thread_fn, dev);
+    } else if (dev->backend == 2) {
+        /* No reader thread: the producer pushes via rtl_device_push_iq() */
+        struct rtl_device* expected = nullptr;
+        if (!g_external_dev.compare_exchange_strong(expected, dev)) {
+            fprintf(stderr, "external IQ: another external device is already active.\n");
+            r = -1;
+        }
     } else {
         dev->run.store(1);
         r = dsd_thread_create(&dev->thread, (dsd_thread_fn)tcp_thread_fn, dev);
@@ -1668,6 +1855,11 @@ rtl_device_stop_async(struct rtl_device* dev) {
     if (!dev || !dev->thread_started) {
         return -1;
     }
+    if (dev->backend == 2) {
+        external_detach(dev);
+        dev->thread_started = 0;
+        return 0;
+    }
     if (dev->backend == 0) {
         if (dev->dev) {
             rtlsdr_cancel_async(dev->dev);
@@ -1710,6 +1902,9 @@ rtl_device_set_bias_tee(struct rtl_device* dev, int on) {
         fprintf(stderr, "rtl_device_set_bias_tee: sending 0x0E command to rtl_tcp with value %d\n", dev->bias_tee_on);
         return rtl_tcp_send_cmd(dev->sockfd, 0x0E, (uint32_t)dev->bias_tee_on);
     }
+    if (dev->backend == 2) {
+        return 0; /* producer owns antenna power */
+    }
 #ifdef USE_RTLSDR_BIAS_TEE
     if (!dev->dev) {
         return -1;
@@ -1758,6 +1953,9 @@ rtl_device_set_xtal_freq(struct rtl_device* dev, uint32_t rtl_xtal_hz, uint32_t
     }
     dev->rtl_xtal_hz = rtl_xtal_hz;
     dev->tuner_xtal_hz = tuner_xtal_hz;
+    if (dev->backend == 2) {
+        return 0;
+    }
     if (dev->backend == 1) {
         if (dev->sockfd == DSD_INVALID_SOCKET) {
             return -1;
@@ -1789,6 +1987,9 @@ rtl_device_set_testmode(struct rtl_device* dev, int on) {
         return -1;
     }
     dev->testmode_on = on ? 1 : 0;
+    if (dev->backend == 2) {
+        return 0;
+    }
     if (dev->backend == 1) {
         if (dev->sockfd == DSD_INVALID_SOCKET) {
             return -1;
@@ -1828,6 +2029,9 @@ rtl_device_set_if_gain(struct rtl_device* dev, int stage, int gain_tenth_db) {
         dev->if_gains[dev->if_gain_count].gain = gain_tenth_db;
         dev->if_gain_count++;
     }
+    if (dev->backend == 2) {
+        return 0;
+    }
     if (dev->backend == 1) {
         if (dev->sockfd == DSD_INVALID_SOCKET) {
             return -1;
@@ -180,11 +180,6 @@ struct dongle_state {
     struct demod_state* demod_target;
 };
 
-struct demod_mt_worker_arg {
-    struct demod_state* s;
-    int id;
-};
-
 struct controller_state {
     int exit_flag;
     dsd_thread_t thread;
@@ -202,13 +197,16 @@ struct controller_state {
      * This prevents the race where demod processes samples with uninitialized
      * TED/Costas state before the controller finishes cold start configuration. */
     std::atomic<int> cold_start_ready;
-    /* Retune gate: demod thread skips processing while retune is in progress.
-     * This prevents the race where demod processes transient/stale samples
-     * during hardware retune before TED/Costas/AGC are reset. Set to 1 at
-     * start of retune, cleared to 0 after reset complete. */
-    std::atomic<int> retune_in_progress;
+    /* Demod-side half of the last retune, published before the input ring
+     * marker is requested and applied by the demod thread when it reaches the
+     * marker. The controller never touches demod state itself. */
+    std::atomic<int> pending_downsample_passes;
+    std::atomic<int> pending_rate_out;
+    std::atomic<uint32_t> pending_complete_id; /* manual retunes executed so far */
+    std::atomic<int> pending_clear_output;     /* drop queued demod output at the marker */
+    std::atomic<int> manual_retune_clear;      /* set by dsd_rtl_stream_tune() callers */
     /* Retune completion signaling: allows dsd_rtl_stream_tune() to block until
-     * the controller thread has finished the hardware retune and DSP reset.
+     * the hardware retune is done and the demod thread has reset its DSP state.
      * This prevents the race where trunking code sets SPS parameters before
      * demod_reset_on_retune() has executed, causing Costas/FLL state corruption. */
     dsd_cond_t retune_done_cond;
@@ -225,8 +223,6 @@ struct demod_state demod;
 struct output_state output;
 struct controller_state controller;
 static struct input_ring_state input_ring;
-/* Controller can request a ring purge; consumer/demod performs the discard safely. */
-static std::atomic<int> g_ring_purge_pending{0};
 
 struct RtlSdrInternals {
     struct rtl_device* device;
@@ -237,7 +233,6 @@ struct RtlSdrInternals {
     struct input_ring_state* input_ring;
     struct udp_control** udp_ctrl_ptr;
     const dsd_opts* opts; /* snapshot for mode hints (P25p1/2, etc.) */
-    const dsdneoRuntimeConfig* cfg;
     /* Cooperative shutdown flag for threads launched by this stream */
     std::atomic<int> should_exit;
 };
@@ -355,24 +350,29 @@ static void eye_ring_clear(void);
 static void snr_ema_reset(void);
 
 /**
- * @brief On retune/hop, drain audio output ring for a short time to avoid
- * cutting off transmissions. If configured to clear, force-clear instead.
+ * @brief On retune/hop, trim the demod output ring without blocking.
+ *
+ * A backlog the decoder can work through within the drain window is kept so
+ * transmissions are not cut off; anything larger is stale and cleared. If
+ * configured to clear, or asked to by the retune requester, force-clear.
  *
  * Also clears the constellation and eye diagram buffers to prevent stale
  * samples from the previous frequency/SPS from contaminating the display.
+ *
+ * @param clear_requested Non-zero to clear the output ring unconditionally.
  */
 static void
-drain_output_on_retune(void) {
+drain_output_on_retune(int clear_requested) {
     struct output_state* outp = &output;
     if (g_stream && g_stream->output) {
         outp = g_stream->output;
     }
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    int force_clear = 0;
+    int force_clear = clear_requested ? 1 : 0;
     int drain_ms = 50;
     if (cfg) {
-        if (cfg->output_clear_on_retune_is_set) {
-            force_clear = (cfg->output_clear_on_retune != 0);
+        if (cfg->output_clear_on_retune_is_set && cfg->output_clear_on_retune != 0) {
+            force_clear = 1;
         }
         if (cfg->retune_drain_ms_is_set) {
             drain_ms = cfg->retune_drain_ms;
@@ -394,17 +394,10 @@ drain_output_on_retune(void) {
         dsd_rtl_stream_clear_output();
         return;
     }
-    size_t before = ring_used(outp);
-    int waited_ms = 0;
-    while (!ring_is_empty(outp) && waited_ms < drain_ms) {
-        dsd_sleep_ms(1);
-        waited_ms++;
-    }
-    if (!ring_is_empty(outp)) {
-        /* Timed out; clear remainder to avoid stale backlog */
+    size_t keep = (outp->rate > 0) ? ((size_t)outp->rate * (size_t)drain_ms) / 1000U : 0;
+    if (ring_used(outp) > keep) {
         dsd_rtl_stream_clear_output();
     }
-    (void)before; /* reserved for future diagnostics */
 }
 
 /* C-linkage helper to toggle bias tee on the active RTL device.
@@ -671,7 +664,7 @@ demod_reset_on_retune(struct demod_state* s) {
     }
 
     /* Debug: summarize key CQPSK/TED state after retune when DSD_NEO_DEBUG_CQPSK=1.
-       This runs in the controller thread after hardware retune and SPS refresh. */
+       This runs in the demod thread at the retune marker, after the SPS refresh. */
     {
         if (debug_cqpsk_enabled()) {
             /* Use the OP25-compatible FLL band-edge state, not legacy fll_freq.
@@ -717,7 +710,7 @@ std::atomic<int> g_snr_qpsk_src{0};
 std::atomic<long long> g_snr_gfsk_last_ms{0};
 std::atomic<int> g_snr_gfsk_src{0};
 /* EMA state for direct SNR estimation (reset on retune for fast acquisition).
- * These are atomic because snr_ema_reset() is called from the controller thread
+ * These are atomic because snr_ema_reset() can be called from other threads
  * while the demod thread reads/writes them during SNR computation. */
 static std::atomic<double> g_snr_ema_c4fm{-100.0};
 static std::atomic<double> g_snr_ema_qpsk{-100.0};
@@ -790,6 +783,35 @@ extern "C" void dsd_rtl_stream_set_tuner_autogain(int onoff);
 /* Spectrum updater used in demod thread (implemented in rtl_metrics.cpp). */
 extern "C" void rtl_metrics_update_spectrum_from_iq(const float* iq_interleaved, int len_interleaved, int out_rate_hz);
 
+/**
+ * @brief Demod-side half of a retune, run on the demod thread at the input
+ * ring marker so no sample from the new frequency sees stale DSP state.
+ *
+ * Applies the capture rate staged by the controller, refreshes the resampler
+ * and TED SPS, resets loops/filters, trims the output ring and wakes
+ * dsd_rtl_stream_tune() waiters.
+ *
+ * @param d Demodulator state.
+ */
+static void
+demod_apply_retune_marker(struct demod_state* d) {
+    struct controller_state* cs = &controller;
+    d->downsample_passes = cs->pending_downsample_passes.load(std::memory_order_relaxed);
+    d->rate_out = cs->pending_rate_out.load(std::memory_order_relaxed);
+    rtl_demod_maybe_update_resampler_after_rate_change(d, &output, rtl_dsp_bw_hz);
+    rtl_demod_maybe_refresh_ted_sps_after_rate_change(d, g_stream ? g_stream->opts : NULL, &output);
+    demod_reset_on_retune(d);
+    drain_output_on_retune(cs->pending_clear_output.exchange(0, std::memory_order_relaxed));
+    /* Wake waiters for every manual retune up to the one this marker belongs to. */
+    uint32_t done = cs->pending_complete_id.load(std::memory_order_relaxed);
+    if (done != cs->retune_complete_id.load(std::memory_order_relaxed)) {
+        dsd_mutex_lock(&cs->retune_done_m);
+        cs->retune_complete_id.store(done, std::memory_order_release);
+        dsd_cond_broadcast(&cs->retune_done_cond);
+        dsd_mutex_unlock(&cs->retune_done_m);
+    }
+}
+
 static DSD_THREAD_RETURN_TYPE
 #if DSD_PLATFORM_WIN_NATIVE
     __stdcall
@@ -835,18 +857,21 @@ static DSD_THREAD_RETURN_TYPE
             dsd_sleep_ms(1); /* short sleep to avoid busy spinning */
             continue;
         }
-        /* Honor pending purge requests in the consumer thread to keep SPSC ownership intact. */
-        if (g_ring_purge_pending.exchange(0, std::memory_order_acq_rel)) {
-            input_ring_discard_all_consumer(&input_ring);
+        /* Read a block from input ring. Samples ahead of a retune marker are
+           dropped by the ring; the DSP reset happens here, before the first
+           sample from the new frequency. */
+        int at_marker = 0;
+        int got = input_ring_read_block_marker(&input_ring, d->input_cb_buf, static_cast<size_t>(MAXIMUM_BUF_LENGTH),
+                                               &at_marker);
+        if (at_marker) {
+            demod_apply_retune_marker(d);
             continue;
         }
-        /* Read a block from input ring */
-        int got = input_ring_read_block(&input_ring, d->input_cb_buf, static_cast<size_t>(MAXIMUM_BUF_LENGTH));
         if (got <= 0) {
             continue;
         }
         if (!ag_initialized) {
-            const dsdneoRuntimeConfig* cfg = (g_stream && g_stream->cfg) ? g_stream->cfg : dsd_neo_get_config();
+            const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
             if (cfg) {
                 g_tuner_autogain_on.store(cfg->tuner_autogain_enable ? 1 : 0, std::memory_order_relaxed);
                 s_probe_ms = cfg->tuner_autogain_probe_ms;
@@ -1088,13 +1113,6 @@ static DSD_THREAD_RETURN_TYPE
         if (!controller.cold_start_ready.load(std::memory_order_acquire)) {
             continue;
         }
-        /* Gate: skip demod processing while a retune is in progress.
-         * This prevents the race where we process transient/stale samples during
-         * hardware retune before TED/AGC/filters are reset for the new frequency.
-         * Applies to all modulations (C4FM, GFSK, QPSK, etc). */
-        if (controller.retune_in_progress.load(std::memory_order_acquire)) {
-            continue;
-        }
         full_demod(d);
         /* Capture decimated I/Q for constellation view after DSP. */
         extern void constellation_ring_append(const float* iq, int len, int sps_hint);
@@ -1440,31 +1458,40 @@ static DSD_THREAD_RETURN_TYPE
     DSD_THREAD_RETURN;
 }
 
+/* Capture parameters for one center frequency under the current demod configuration. */
+struct capture_plan {
+    uint32_t freq;         /* tuner center frequency, fs/4 shift and edge applied */
+    uint32_t rate;         /* requested capture sample rate */
+    int downsample_passes; /* 2:1 half-band stages from capture rate to demod rate */
+};
+
+/* Last planner result and what was last programmed into the device, so a hop
+   only recomputes and sends what actually changed. */
+static struct {
+    int valid;
+    int rate_in;
+    int downsample_passes;
+    uint32_t rate;
+    uint32_t dev_rate; /* requested capture rate last programmed, 0 = none */
+    int dev_bw_valid;
+    uint32_t dev_bw; /* tuner bandwidth last programmed */
+} g_capture;
+
 /**
- * @brief Compute and stage tuner/demodulator capture settings based on the
- * requested center frequency and current demod configuration. The actual
- * device programming occurs elsewhere after these fields are updated.
+ * @brief Pick the half-band decimation depth for a demod input rate.
  *
- * @param freq Desired RF center frequency in Hz.
- * @param rate Current input sample rate (unused).
+ * Targets ~1 MS/s capture via passes = ceil(log2(ds)), nudged toward
+ * RTL2832U clocks known to be stable.
+ *
+ * @param rate_in Demodulator input rate in Hz.
+ * @return Number of 2:1 decimation passes.
  */
-static void
-optimal_settings(int freq, int rate) {
-    UNUSED(rate);
-
-    int capture_freq, capture_rate;
-    struct dongle_state* d = &dongle;
-    struct demod_state* dm = &demod;
-    struct controller_state* cs = &controller;
-    /* Compute integer oversample factor to target ~1 MS/s capture then map
-       to a cascade of 2:1 decimators via passes = ceil(log2(ds)). */
-    int downsample_factor = (1000000 / dm->rate_in) + 1;
+static int
+capture_downsample_passes(int rate_in) {
+    int passes_out = 0;
     {
-        int ds = downsample_factor;
-        if (ds <= 1) {
-            dm->downsample_passes = 0;
-            downsample_factor = 1;
-        } else {
+        int ds = (1000000 / rate_in) + 1;
+        if (ds > 1) {
 #if defined(__GNUC__) || defined(__clang__)
             int floor_log2 = 31 - __builtin_clz(ds);
 #else
@@ -1517,72 +1544,139 @@ optimal_settings(int freq, int rate) {
                 }
                 return best_p;
             };
-            int adj_passes = choose_passes_near_good_rate(dm->rate_in, passes);
-            dm->downsample_passes = adj_passes;
-            downsample_factor = 1 << adj_passes;
+            passes_out = choose_passes_near_good_rate(rate_in, passes);
         }
     }
-    capture_freq = freq;
-    capture_rate = downsample_factor * dm->rate_in;
+    return passes_out;
+}
+
+/**
+ * @brief Plan capture parameters for a center frequency.
+ *
+ * The decimation depth only depends on the demod input rate, so it is
+ * reused across hops until that rate changes.
+ *
+ * @param freq Desired RF center frequency in Hz.
+ * @param p    [out] Capture plan.
+ */
+static void
+plan_capture(int freq, struct capture_plan* p) {
+    struct demod_state* dm = &demod;
+    if (!g_capture.valid || g_capture.rate_in != dm->rate_in) {
+        g_capture.downsample_passes = capture_downsample_passes(dm->rate_in);
+        g_capture.rate = (uint32_t)dm->rate_in << g_capture.downsample_passes;
+        g_capture.rate_in = dm->rate_in;
+        g_capture.valid = 1;
+    }
+    int capture_rate = (int)g_capture.rate;
+    int capture_freq = freq;
     /* Apply fs/4 shift for zero-IF DC spur avoidance when offset_tuning is disabled. */
-    if (!d->offset_tuning && !disable_fs4_shift) {
+    if (!dongle.offset_tuning && !disable_fs4_shift) {
         capture_freq = freq + capture_rate / 4;
     }
-    capture_freq += cs->edge * dm->rate_in / 2;
-    /* Normalize discriminator radians into roughly [-1,1] for float pipeline. */
-    dm->output_scale = (float)(1.0 / M_PI);
-    /* Update the effective discriminator output sample rate based on current settings.
-       HB cascade reduces by (1<<downsample_passes). Apply optional post_downsample on audio. */
-    {
-        int base_decim = (dm->downsample_passes > 0) ? (1 << dm->downsample_passes) : 1;
-        int out_rate = capture_rate / base_decim;
-        if (dm->post_downsample > 1) {
-            out_rate /= dm->post_downsample;
-            if (out_rate < 1) {
-                out_rate = 1;
-            }
+    capture_freq += controller.edge * dm->rate_in / 2;
+    p->freq = (uint32_t)capture_freq;
+    p->rate = g_capture.rate;
+    p->downsample_passes = g_capture.downsample_passes;
+}
+
+/**
+ * @brief Discriminator output rate for a capture rate: HB cascade reduces by
+ * (1<<passes), then the optional post_downsample applies.
+ */
+static int
+capture_rate_out(uint32_t capture_rate, int downsample_passes) {
+    int base_decim = (downsample_passes > 0) ? (1 << downsample_passes) : 1;
+    int out_rate = (int)(capture_rate / (uint32_t)base_decim);
+    if (demod.post_downsample > 1) {
+        out_rate /= demod.post_downsample;
+        if (out_rate < 1) {
+            out_rate = 1;
         }
-        dm->rate_out = out_rate;
     }
-    d->freq = (uint32_t)capture_freq;
-    d->rate = (uint32_t)capture_rate;
+    return out_rate;
+}
+
+/**
+ * @brief Compute and stage tuner/demodulator capture settings based on the
+ * requested center frequency and current demod configuration. The actual
+ * device programming occurs elsewhere after these fields are updated.
+ *
+ * Only for setup paths where the demod thread is not processing yet; retunes
+ * stage the demod fields through the input ring marker instead.
+ *
+ * @param freq Desired RF center frequency in Hz.
+ * @param rate Current input sample rate (unused).
+ */
+static void
+optimal_settings(int freq, int rate) {
+    UNUSED(rate);
+
+    struct capture_plan p;
+    plan_capture(freq, &p);
+    demod.downsample_passes = p.downsample_passes;
+    /* Normalize discriminator radians into roughly [-1,1] for float pipeline. */
+    demod.output_scale = (float)(1.0 / M_PI);
+    demod.rate_out = capture_rate_out(p.rate, p.downsample_passes);
+    dongle.freq = p.freq;
+    dongle.rate = p.rate;
+}
+
+/**
+ * @brief Program the capture rate unless it is the one last sent, then sync
+ * dongle.rate to what the device applied (USB may quantize it).
+ *
+ * @param rate Requested capture sample rate in Hz.
+ */
+static void
+capture_program_rate(uint32_t rate) {
+    if (g_capture.dev_rate == rate) {
+        return;
+    }
+    dongle.rate = rate;
+    rtl_device_set_sample_rate(rtl_device_handle, rate);
+    g_capture.dev_rate = rate;
+    int actual = rtl_device_get_sample_rate(rtl_device_handle);
+    if (actual > 0 && (uint32_t)actual != rate) {
+        dongle.rate = (uint32_t)actual;
+        LOG_INFO("Adjusted to actual device rate: requested=%u, actual=%u.\n", rate, dongle.rate);
+    }
 }
 
 /**
- * @brief Program device to new center frequency and sample rate using a
- * single, consistent path. Applies fs/4 shift when offset_tuning is off.
+ * @brief Program the tuner IF bandwidth (mode-aware heuristic) unless unchanged.
+ */
+static void
+capture_program_bandwidth(void) {
+    uint32_t bw = choose_tuner_bw_hz(dongle.rate, (uint32_t)rtl_dsp_bw_hz);
+    if (g_capture.dev_bw_valid && g_capture.dev_bw == bw) {
+        return;
+    }
+    rtl_device_set_tuner_bandwidth(rtl_device_handle, bw);
+    g_capture.dev_bw = bw;
+    g_capture.dev_bw_valid = 1;
+}
+
+/**
+ * @brief Program the device for a new center frequency, issuing only the
+ * control transfers that differ from the current configuration, and stage
+ * the matching demod rate for the demod thread.
+ *
+ * A plain channel hop is a single frequency write; sample rate and tuner
+ * bandwidth are only reprogrammed when they change.
  *
  * @param center_freq_hz Desired RF center frequency in Hz.
  */
 static void
 apply_capture_settings(uint32_t center_freq_hz) {
-    optimal_settings((int)center_freq_hz, demod.rate_in);
+    struct capture_plan p;
+    plan_capture((int)center_freq_hz, &p);
+    dongle.freq = p.freq;
     rtl_device_set_frequency(rtl_device_handle, dongle.freq);
-    rtl_device_set_sample_rate(rtl_device_handle, dongle.rate);
-    /* Use driver auto hardware bandwidth by default, or override via env */
-    rtl_device_set_tuner_bandwidth(rtl_device_handle, choose_tuner_bw_hz(dongle.rate, (uint32_t)rtl_dsp_bw_hz));
-    /* Sync to actual device rate (USB may quantize). If it changed, update rate_out. */
-    int actual = rtl_device_get_sample_rate(rtl_device_handle);
-    if (actual > 0 && (uint32_t)actual != dongle.rate) {
-        uint32_t prev = dongle.rate;
-        dongle.rate = (uint32_t)actual;
-        int base_decim = (demod.downsample_passes > 0) ? (1 << demod.downsample_passes) : 1;
-        if (base_decim < 1) {
-            base_decim = 1;
-        }
-        int out_rate = (int)(dongle.rate / (uint32_t)base_decim);
-        if (demod.post_downsample > 1) {
-            out_rate /= demod.post_downsample;
-            if (out_rate < 1) {
-                out_rate = 1;
-            }
-        }
-        demod.rate_out = out_rate;
-        LOG_INFO("Adjusted to actual device rate: requested=%u, actual=%u, demod_out=%d Hz.\n", prev, dongle.rate,
-                 demod.rate_out);
-    }
-    /* Ensure TED SPS reflects the current effective sampling rate unless explicitly overridden. */
-    rtl_demod_maybe_refresh_ted_sps_after_rate_change(&demod, g_stream ? g_stream->opts : NULL, &output);
+    capture_program_rate(p.rate);
+    capture_program_bandwidth();
+    controller.pending_downsample_passes.store(p.downsample_passes, std::memory_order_relaxed);
+    controller.pending_rate_out.store(capture_rate_out(dongle.rate, p.downsample_passes), std::memory_order_relaxed);
 }
 
 /* Resampler and TED SPS helpers are implemented in rtl_demod_config.cpp. */
@@ -1610,6 +1704,10 @@ static DSD_THREAD_RETURN_TYPE
         }
     }
 
+    /* New device session: nothing programmed yet. */
+    g_capture.dev_rate = 0;
+    g_capture.dev_bw_valid = 0;
+
     /* set up primary channel */
     optimal_settings(s->freqs[0], demod.rate_in);
     if (dongle.direct_sampling) {
@@ -1620,12 +1718,14 @@ static DSD_THREAD_RETURN_TYPE
        Respect explicit env override when provided. */
     {
         int want = 1;
+        const int external_iq = (g_stream && g_stream->opts && g_stream->opts->rtl_external_iq) ? 1 : 0;
         if (g_stream && g_stream->opts && g_stream->opts->rtltcp_enabled) {
             /* rtl_tcp: keep fs/4 + combine-rotate path consistent with USB defaults */
             want = 0;
         }
-        const dsdneoRuntimeConfig* cfg = (g_stream && g_stream->cfg) ? g_stream->cfg : dsd_neo_get_config();
-        if (cfg && cfg->rtl_offset_tuning_is_set) {
+        const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+        /* External IQ arrives centered; there is no tuner to shift, so the override does not apply. */
+        if (cfg && cfg->rtl_offset_tuning_is_set && !external_iq) {
             want = cfg->rtl_offset_tuning_enable ? 1 : 0;
         }
         int r = rtl_device_set_offset_tuning_enabled(rtl_device_handle, want);
@@ -1645,32 +1745,11 @@ static DSD_THREAD_RETURN_TYPE
     LOG_INFO("Oversampling output by: %ix.\n", demod.post_downsample);
     LOG_INFO("Buffer size: %0.2fms\n", 1000 * 0.5 * (float)ACTUAL_BUF_LENGTH / (float)dongle.rate);
 
-    /* Set the sample rate after frequency */
-    rtl_device_set_sample_rate(rtl_device_handle, dongle.rate);
-    /* USB may quantize the applied sample rate; sync and update out rate if changed. */
-    {
-        int actual = rtl_device_get_sample_rate(rtl_device_handle);
-        if (actual > 0 && (uint32_t)actual != dongle.rate) {
-            uint32_t prev = dongle.rate;
-            dongle.rate = (uint32_t)actual;
-            int base_decim = (demod.downsample_passes > 0) ? (1 << demod.downsample_passes) : 1;
-            if (base_decim < 1) {
-                base_decim = 1;
-            }
-            int out_rate = (int)(dongle.rate / (uint32_t)base_decim);
-            if (demod.post_downsample > 1) {
-                out_rate /= demod.post_downsample;
-                if (out_rate < 1) {
-                    out_rate = 1;
-                }
-            }
-            demod.rate_out = out_rate;
-            LOG_INFO("Adjusted to actual device rate: requested=%u, actual=%u, demod_out=%d Hz.\n", prev, dongle.rate,
-                     demod.rate_out);
-        }
-    }
+    /* Set the sample rate after frequency; USB may quantize it, so resync the out rate. */
+    capture_program_rate(dongle.rate);
+    demod.rate_out = capture_rate_out(dongle.rate, demod.downsample_passes);
     /* Apply tuner IF bandwidth with mode-aware heuristic */
-    rtl_device_set_tuner_bandwidth(rtl_device_handle, choose_tuner_bw_hz(dongle.rate, (uint32_t)rtl_dsp_bw_hz));
+    capture_program_bandwidth();
     LOG_INFO("Demod output at %u Hz.\n", (unsigned int)demod.rate_out);
 
     /* Cold start initialization: apply the same reset sequence used on retunes.
@@ -1691,6 +1770,7 @@ static DSD_THREAD_RETURN_TYPE
      * where it processes samples before TED SPS/Costas/AGC are properly reset. */
     s->cold_start_ready.store(1, std::memory_order_release);
 
+    uint32_t manual_done = s->retune_complete_id.load(std::memory_order_relaxed);
     while (!exitflag && !(g_stream && g_stream->should_exit.load())) {
         /* Wait for a hop signal or a pending retune, with proper predicate guard */
         dsd_mutex_lock(&s->hop_m);
@@ -1712,25 +1792,16 @@ static DSD_THREAD_RETURN_TYPE
                 continue;
             }
             
-            /* Gate demod thread: prevent processing transient samples during retune */
-            s->retune_in_progress.store(1, std::memory_order_release);
-            /* Ask consumer to purge ring safely (keeps SPSC producer/consumer contract). */
-            g_ring_purge_pending.store(1, std::memory_order_release);
             apply_capture_settings((uint32_t)tgt);
-            rtl_demod_maybe_update_resampler_after_rate_change(&demod, &output, rtl_dsp_bw_hz);
-            rtl_demod_maybe_refresh_ted_sps_after_rate_change(&demod, g_stream ? g_stream->opts : NULL, &output);
-            demod_reset_on_retune(&demod);
-            /* Retune complete: allow demod thread to resume processing */
-            s->retune_in_progress.store(0, std::memory_order_release);
-            /* Signal completion to any waiting callers (e.g., dsd_rtl_stream_tune).
-             * Increment the complete_id to match the request_id that was generated
-             * when the tune was requested. This ensures waiters wake up only for
-             * their own request, handling the case where multiple retunes are queued. */
-            dsd_mutex_lock(&s->retune_done_m);
-            s->retune_complete_id.fetch_add(1, std::memory_order_release);
-            dsd_cond_broadcast(&s->retune_done_cond);
-            dsd_mutex_unlock(&s->retune_done_m);
-            drain_output_on_retune();
+            /* The demod thread finishes the retune (DSP reset, output trim) when it
+             * reaches the input ring marker, then wakes dsd_rtl_stream_tune() waiters.
+             * Each executed manual retune completes one request ID. */
+            manual_done++;
+            s->pending_complete_id.store(manual_done, std::memory_order_relaxed);
+            if (s->manual_retune_clear.exchange(0, std::memory_order_relaxed)) {
+                s->pending_clear_output.store(1, std::memory_order_relaxed);
+            }
+            input_ring_request_marker(&input_ring);
             LOG_INFO("Retune applied: %u Hz.\n", tgt);
             continue;
         }
@@ -1738,17 +1809,9 @@ static DSD_THREAD_RETURN_TYPE
             continue;
         }
         s->freq_now = (s->freq_now + 1) % s->freq_len;
-        /* Gate demod thread: prevent processing transient samples during hop */
-        s->retune_in_progress.store(1, std::memory_order_release);
-        /* Flush any leftover IQ from the previous frequency before applying the new center. */
-        g_ring_purge_pending.store(1, std::memory_order_release);
         apply_capture_settings((uint32_t)s->freqs[s->freq_now]);
-        rtl_demod_maybe_update_resampler_after_rate_change(&demod, &output, rtl_dsp_bw_hz);
-        rtl_demod_maybe_refresh_ted_sps_after_rate_change(&demod, g_stream ? g_stream->opts : NULL, &output);
-        demod_reset_on_retune(&demod);
-        /* Hop complete: allow demod thread to resume processing */
-        s->retune_in_progress.store(0, std::memory_order_release);
-        drain_output_on_retune();
+        /* Samples from the previous frequency are dropped at the marker. */
+        input_ring_request_marker(&input_ring);
     }
     DSD_THREAD_RETURN;
 }
@@ -2163,9 +2226,9 @@ output_init(struct output_state* s) {
     dsd_mutex_init(&s->ready_m);
     /* Allocate SPSC ring buffer */
     s->capacity = (size_t)(MAXIMUM_BUF_LENGTH * 8);
-    /* Try aligned allocation for better vectorized copies; fall back if unavailable */
+    /* Multi-MiB ring: pooled, hugepage-backed and prefaulted where available */
     {
-        void* mem_ptr = dsd_neo_aligned_malloc(s->capacity * sizeof(float));
+        void* mem_ptr = dsd_neo_buffer_malloc(s->capacity * sizeof(float));
         if (!mem_ptr) {
             LOG_ERROR("Failed to allocate output ring buffer (%zu samples).\n", s->capacity);
             /* Propagate by keeping buffer NULL; callers must detect before use */
@@ -2191,7 +2254,7 @@ output_cleanup(struct output_state* s) {
     dsd_cond_destroy(&s->space);
     dsd_mutex_destroy(&s->ready_m);
     if (s->buffer) {
-        dsd_neo_aligned_free(s->buffer);
+        dsd_neo_buffer_free(s->buffer);
         s->buffer = NULL;
     }
 }
@@ -2212,7 +2275,11 @@ controller_init(struct controller_state* s) {
     s->manual_retune_pending.store(0);
     s->manual_retune_freq = 0;
     s->cold_start_ready.store(0); /* Demod will wait for controller to signal ready */
-    s->retune_in_progress.store(0);
+    s->pending_downsample_passes.store(0);
+    s->pending_rate_out.store(0);
+    s->pending_complete_id.store(0);
+    s->pending_clear_output.store(0);
+    s->manual_retune_clear.store(0);
     /* Initialize retune completion synchronization */
     dsd_cond_init(&s->retune_done_cond);
     dsd_mutex_init(&s->retune_done_m);
@@ -2409,7 +2476,7 @@ dsd_rtl_stream_open(dsd_opts* opts) {
     }
     /* Init input ring */
     {
-        void* mem_ptr = dsd_neo_aligned_malloc((size_t)(MAXIMUM_BUF_LENGTH * 8) * sizeof(float));
+        void* mem_ptr = dsd_neo_buffer_malloc((size_t)(MAXIMUM_BUF_LENGTH * 8) * sizeof(float));
         if (!mem_ptr) {
             LOG_ERROR("Failed to allocate input ring buffer.\n");
             return -1;
@@ -2423,6 +2490,11 @@ dsd_rtl_stream_open(dsd_opts* opts) {
         /* Metrics */
         input_ring.producer_drops.store(0);
         input_ring.read_timeouts.store(0);
+        /* Retune markers */
+        input_ring.marker_req.store(0);
+        input_ring.marker_seq.store(0);
+        input_ring.marker_pos.store(0);
+        input_ring.marker_seen = 0;
     }
     controller_init(&controller);
 
@@ -2483,7 +2555,15 @@ dsd_rtl_stream_open(dsd_opts* opts) {
     /* Ensure async read uses a valid, explicit buffer length */
     dongle.buf_len = (uint32_t)ACTUAL_BUF_LENGTH;
 
-    if (opts && opts->rtltcp_enabled) {
+    if (opts && opts->rtl_external_iq) {
+        rtl_device_handle = rtl_device_create_external(&input_ring, combine_rotate_enabled);
+        if (!rtl_device_handle) {
+            LOG_ERROR("Failed to create external IQ source.\n");
+            return -1;
+        }
+        LOG_INFO("Using external IQ source (in-process push).\n");
+        rtl_device_print_offset_capability(rtl_device_handle);
+    } else if (opts && opts->rtltcp_enabled) {
         int autotune = opts->rtltcp_autotune;
         if (!autotune) {
             const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
@@ -2553,7 +2633,7 @@ dsd_rtl_stream_open(dsd_opts* opts) {
             dongle.direct_sampling = mode;
         }
 
-        if (cfg && cfg->rtl_offset_tuning_is_set) {
+        if (cfg && cfg->rtl_offset_tuning_is_set && !(opts && opts->rtl_external_iq)) {
             int on = cfg->rtl_offset_tuning_enable ? 1 : 0;
             rtl_device_set_offset_tuning_enabled(rtl_device_handle, on);
             dongle.offset_tuning = on ? 1 : 0;
@@ -2754,7 +2834,6 @@ dsd_rtl_stream_open(dsd_opts* opts) {
         g_stream->input_ring = &input_ring;
         g_stream->udp_ctrl_ptr = &g_udp_ctrl;
         g_stream->opts = opts;
-        g_stream->cfg = dsd_neo_get_config();
         g_stream->should_exit.store(0);
     }
 
@@ -2778,10 +2857,10 @@ dsd_rtl_stream_open(dsd_opts* opts) {
         }
         size_t min_capacity = desired_prebuf * 2; /* use <= 50% for prebuffer */
         if (min_capacity > input_ring.capacity) {
-            float* nb = (float*)dsd_neo_aligned_malloc(min_capacity * sizeof(float));
+            float* nb = (float*)dsd_neo_buffer_malloc(min_capacity * sizeof(float));
             if (nb) {
                 if (input_ring.buffer) {
-                    dsd_neo_aligned_free(input_ring.buffer);
+                    dsd_neo_buffer_free(input_ring.buffer);
                 }
                 input_ring.buffer = nb;
                 input_ring.capacity = min_capacity;
@@ -2922,12 +3001,14 @@ dsd_rtl_stream_close(void) {
 
     /* free input ring */
     if (input_ring.buffer) {
-        dsd_neo_aligned_free(input_ring.buffer);
+        dsd_neo_buffer_free(input_ring.buffer);
         input_ring.buffer = NULL;
     }
 
     rtl_device_destroy(rtl_device_handle);
     rtl_device_handle = NULL;
+    /* Ring mappings were returned to the buffer pool above; release them. */
+    dsd_neo_buffer_trim();
 
     if (g_stream) {
         free(g_stream);
@@ -2968,11 +3049,13 @@ dsd_rtl_stream_soft_stop(void) {
     controller_cleanup(&controller);
 
     if (input_ring.buffer) {
-        dsd_neo_aligned_free(input_ring.buffer);
+        dsd_neo_buffer_free(input_ring.buffer);
         input_ring.buffer = NULL;
     }
     rtl_device_destroy(rtl_device_handle);
     rtl_device_handle = NULL;
+    /* Do not keep the (possibly locked) ring mappings resident while stopped. */
+    dsd_neo_buffer_trim();
     return 0;
 }
 
@@ -3469,8 +3552,8 @@ dsd_rtl_stream_set_ted_sps(int sps) {
      * process stale samples (from the old frequency) with the new SPS.
      *
      * By only setting the override, the DSP continues with the current
-     * (correct for current signal) SPS until the controller thread applies
-     * the hardware retune and calls rtl_demod_maybe_refresh_ted_sps_after_rate_change,
+     * (correct for current signal) SPS until the demod thread reaches the
+     * retune marker and calls rtl_demod_maybe_refresh_ted_sps_after_rate_change,
      * which will see the override and apply it at the right time.
      *
      * This keeps timing/carrier configuration changes aligned with the
@@ -3704,8 +3787,8 @@ dsd_rtl_stream_set_iq_dc(int enable, int shift_k) {
  * @brief Set or disable the resampler target rate and reapply capture settings.
  *
  * Marshals onto the controller thread by scheduling a no-op retune to the
- * current frequency, which safely reconfigures the resampler and updates the
- * output rate with proper buffer draining.
+ * current frequency; the demod thread reconfigures the resampler and updates
+ * the output rate when it reaches the retune marker.
  *
  * @param target_hz Target output rate in Hz. Pass 0 to disable resampler.
  */
@@ -3824,7 +3907,7 @@ rtl_stream_dsp_get(int* cqpsk_enable, int* fll_enable, int* ted_enable) {
  * @brief Tune RTL-SDR to a new center frequency, updating optimal settings.
  *
  * This function is SYNCHRONOUS: it blocks until the controller thread has
- * completed the hardware retune and all DSP state resets. This ensures that
+ * completed the hardware retune and the demod thread has reset its DSP state. This ensures that
  * subsequent SPS/Costas configuration calls operate on properly reset state.
  *
  * @param opts      Decoder options.
@@ -3859,6 +3942,9 @@ dsd_rtl_stream_tune(dsd_opts* opts, long int frequency) {
     }
     dongle.freq = opts->rtlsdr_center_freq = frequency;
 
+    /* The caller is the consumer of the demod output ring, so it cannot drain a
+     * backlog while it waits here: have the demod thread clear it at the marker. */
+    controller.manual_retune_clear.store(1, std::memory_order_relaxed);
     /* Enqueue retune, coalescing with any already-pending request so completion IDs
      * stay aligned with the number of retunes the controller will actually execute. */
     uint32_t my_request_id = schedule_manual_retune((uint32_t)dongle.freq);
@@ -3869,8 +3955,9 @@ dsd_rtl_stream_tune(dsd_opts* opts, long int frequency) {
 
     /* Wait for controller to complete the retune with a timeout.
      *
-     * The timeout (500ms) is generous - typical RTL-SDR retunes complete in
-     * 10-50ms. The timeout protects against controller thread deadlock or
+     * Completion is signaled by the demod thread once it reaches the input ring
+     * marker for this retune. The timeout (500ms) is generous - typical RTL-SDR
+     * retunes complete in 10-50ms. The timeout protects against controller thread deadlock or
      * missed wakeups, allowing the system to continue (with degraded performance)
      * rather than hanging indefinitely.
      *
@@ -3896,9 +3983,6 @@ dsd_rtl_stream_tune(dsd_opts* opts, long int frequency) {
         }
     }
     dsd_mutex_unlock(&controller.retune_done_m);
-
-    /* Honor drain/clear policy for API-triggered tunes as well */
-    drain_output_on_retune();
     return rc;
 }
 
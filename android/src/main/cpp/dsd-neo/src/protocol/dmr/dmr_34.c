@@ -7,28 +7,18 @@
  * 2023-12 DSD-FME Florida Man Edition
  *-----------------------------------------------------------------------------*/
 
+#include <dsd-neo/fec/trellis_4fsk.h>
 #include <dsd-neo/protocol/dmr/dmr.h>
 
 #include <string.h>
 
-uint8_t interleave[98] = {0,  1,  8,  9,  16, 17, 24, 25, 32, 33, 40, 41, 48, 49, 56, 57, 64, 65, 72, 73,
-                          80, 81, 88, 89, 96, 97, 2,  3,  10, 11, 18, 19, 26, 27, 34, 35, 42, 43, 50, 51,
-                          58, 59, 66, 67, 74, 75, 82, 83, 90, 91, 4,  5,  12, 13, 20, 21, 28, 29, 36, 37,
-                          44, 45, 52, 53, 60, 61, 68, 69, 76, 77, 84, 85, 92, 93, 6,  7,  14, 15, 22, 23,
-                          30, 31, 38, 39, 46, 47, 54, 55, 62, 63, 70, 71, 78, 79, 86, 87, 94, 95};
-
-//this is a convertion table for converting the dibit pairs into constellation points
-uint8_t constellation_map[16] = {11, 12, 0, 7, 14, 9, 5, 2, 10, 13, 1, 6, 15, 8, 4, 3};
+//the interleave schedule, dibit-pair to constellation point map, and 3/4 rate
+//finite state machine are shared with the Viterbi decoders (fec/trellis_4fsk.h)
 
 //digitized dibit to OTA symbol conversion for reference
 //0 = +1; 1 = +3;
 //2 = -1; 3 = -3;
 
-//finite state machine values
-uint8_t fsm[64] = {0, 8,  4, 12, 2, 10, 6, 14, 4, 12, 2, 10, 6, 14, 0, 8, 1, 9,  5, 13, 3, 11,
-                   7, 15, 5, 13, 3, 11, 7, 15, 1, 9,  3, 11, 7, 15, 1, 9, 5, 13, 7, 15, 1, 9,
-                   5, 13, 3, 11, 2, 10, 6, 14, 0, 8,  4, 12, 6, 14, 0, 8, 4, 12, 2, 10};
-
 //attempt to find the surviving path, or the 'best' path available (most positions gained)
 uint8_t
 fix_34(uint8_t* p, uint8_t state, int position) {
@@ -69,7 +59,7 @@ fix_34(uint8_t* p, uint8_t state, int position) {
             {
                 tri = 0xFF;
                 for (j = 0; j < 8; j++) {
-                    if (fsm[((size_t)temp_s * 8) + j] == t) {
+                    if (dsd_trellis_fsm34[((size_t)temp_s * 8) + j] == t) {
                         //return our tribit value and state for the next point
                         tri = temp_s = (uint8_t)j;
                         counter++;
@@ -110,7 +100,7 @@ dmr_34(uint8_t* input, uint8_t treturn[18]) {
 
     //deinterleave our input dibits
     for (i = 0; i < 98; i++) {
-        deinterleaved_dibits[interleave[i]] = input[i];
+        deinterleaved_dibits[dsd_trellis_interleave[i]] = input[i];
     }
 
     //pack the input into nibbles (dibit pairs)
@@ -126,7 +116,7 @@ dmr_34(uint8_t* input, uint8_t treturn[18]) {
     memset(point, 0xFF, sizeof(point));
 
     for (i = 0; i < 49; i++) {
-        point[i] = constellation_map[nibs[i]];
+        point[i] = dsd_trellis_constellation[nibs[i]];
     }
 
     //debug view points
@@ -142,7 +132,7 @@ dmr_34(uint8_t* input, uint8_t treturn[18]) {
     for (i = 0; i < 49; i++) {
 
         for (j = 0; j < 8; j++) {
-            if (fsm[((size_t)state * 8) + j] == point[i]) {
+            if (dsd_trellis_fsm34[((size_t)state * 8) + j] == point[i]) {
                 //return our tribit value and state for the next point
                 tribits[i] = state = (uint8_t)j;
                 break;
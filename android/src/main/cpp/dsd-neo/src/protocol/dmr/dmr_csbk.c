@@ -92,7 +92,7 @@ dmr_try_heuristic_fill(dsd_opts* opts, dsd_state* state) {
     int anchors = 0;
 
     for (int l = 1; l <= MAX_LCN; l++) {
-        long f = state->trunk_chan_map[l];
+        long f = dsd_chan_map_get(&state->trunk_chan_map, l);
         if (f == 0) {
             continue;
         }
@@ -133,7 +133,7 @@ dmr_try_heuristic_fill(dsd_opts* opts, dsd_state* state) {
     // Model: f(l) = first_freq + (l - first_lcn) * step
     long max_err = 0;
     for (int l = 1; l <= MAX_LCN; l++) {
-        long f = state->trunk_chan_map[l];
+        long f = dsd_chan_map_get(&state->trunk_chan_map, l);
         if (f == 0) {
             continue;
         }
@@ -151,14 +151,14 @@ dmr_try_heuristic_fill(dsd_opts* opts, dsd_state* state) {
     // Fill between anchors
     int filled = 0;
     for (int l = first_lcn; l <= last_lcn; l++) {
-        if (state->trunk_chan_map[l] != 0) {
+        if (dsd_chan_map_get(&state->trunk_chan_map, l) != 0) {
             continue;
         }
         long f = first_freq + (long)(l - first_lcn) * step;
         if (f <= 0) {
             continue;
         }
-        state->trunk_chan_map[l] = f;
+        dsd_chan_map_set(&state->trunk_chan_map, l, f);
         filled++;
     }
 
@@ -190,11 +190,11 @@ dmr_learn_chan_map(dsd_opts* opts, dsd_state* state, uint16_t lpcn, long int fre
     if (freq <= 0) {
         return;
     }
-    if (state->trunk_chan_map[lpcn] != 0) {
+    if (dsd_chan_map_get(&state->trunk_chan_map, lpcn) != 0) {
         return;
     }
 
-    state->trunk_chan_map[lpcn] = freq;
+    dsd_chan_map_set(&state->trunk_chan_map, lpcn, freq);
     // Mark provenance: trusted if learned while on CC for current site, else unconfirmed
     if (lpcn < 0x1000) {
         uint8_t trust = 1;
@@ -417,7 +417,7 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
 
                 //run external channel map function on logical
                 if (lpchannum != 0 && lpchannum != 0xFFF) {
-                    freq = state->trunk_chan_map[lpchannum];
+                    freq = dsd_chan_map_get(&state->trunk_chan_map, lpchannum);
                     if (freq != 0) {
                         fprintf(stderr, "\n  Frequency: %.6lf MHz", (double)freq / 1000000);
                     } else {
@@ -603,7 +603,7 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                     }
                 } else if (move_lpcn != 0) {
                     // Resolve from existing logical channel map if available
-                    move_freq = state->trunk_chan_map[move_lpcn];
+                    move_freq = dsd_chan_map_get(&state->trunk_chan_map, move_lpcn);
                 }
 
                 // Update simple UI context (active channel and per-slot call string)
@@ -1056,10 +1056,10 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                     // is being withdrawn.
                     long f1 = 0, f2 = 0;
                     if (bcast_ch1 > 0 && bcast_ch1 < 0xFFFF) {
-                        f1 = state->trunk_chan_map[bcast_ch1];
+                        f1 = dsd_chan_map_get(&state->trunk_chan_map, bcast_ch1);
                     }
                     if (bcast_ch2 > 0 && bcast_ch2 < 0xFFFF) {
-                        f2 = state->trunk_chan_map[bcast_ch2];
+                        f2 = dsd_chan_map_get(&state->trunk_chan_map, bcast_ch2);
                     }
 
                     long cand[2];
@@ -1221,8 +1221,8 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
 
                             //experimental -- assign a_channel or mbc_lpchannum and freqr to channel map if not available
                             if (a_channel != 0 && a_channel != 0xFFF && freqr != 0) {
-                                if (state->trunk_chan_map[a_channel] == 0) {
-                                    state->trunk_chan_map[a_channel] = freqr;
+                                if (dsd_chan_map_get(&state->trunk_chan_map, a_channel) == 0) {
+                                    dsd_chan_map_set(&state->trunk_chan_map, a_channel, freqr);
                                     //add to rotation for CC Hunting on extended noframesync
                                     state->trunk_lcn_freq[state->lcn_freq_count++ % 25] =
                                         freqr; //no not exceed 25 entries
@@ -1238,9 +1238,9 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                             //and also since absolute channel grants will also have these values available to figure out frequency to tune to
                             // if (a_channel == 0xFFF && freqr != 0)
                             // {
-                            //   if (state->trunk_chan_map[mbc_lpchannum] == 0 && mbc_lpchannum != 0xFFFF && mbc_lpchannum != 0)
+                            //   if (dsd_chan_map_get(&state->trunk_chan_map, mbc_lpchannum) == 0 && mbc_lpchannum != 0xFFFF && mbc_lpchannum != 0)
                             //   {
-                            //     state->trunk_chan_map[mbc_lpchannum] = freqr;
+                            //     dsd_chan_map_set(&state->trunk_chan_map, mbc_lpchannum, freqr);
                             //     //add to rotation for CC Hunting on extended noframesync
                             //     state->trunk_lcn_freq[state->lcn_freq_count++%25] = freqr; //no not exceed 25 entries
                             //     if (state->lcn_freq_count > 25) state->lcn_freq_count = 25;
@@ -1742,7 +1742,7 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                 int ccount = 0;
                 for (int i = 0; i < 6; i++) {
                     if (nr[i] != 0) {
-                        long f = state->trunk_chan_map[nr[i]];
+                        long f = dsd_chan_map_get(&state->trunk_chan_map, nr[i]);
                         if (f != 0) {
                             cand[ccount++] = f;
                         }
@@ -1822,7 +1822,7 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                 }
 
                 //set to always tuned when rest channel is known
-                if (state->trunk_chan_map[rest_channel] != 0) {
+                if (dsd_chan_map_get(&state->trunk_chan_map, rest_channel) != 0) {
                     opts->trunk_is_tuned = 1;
                 }
 
@@ -2106,7 +2106,7 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                                 //debug print for tuning verification
                                 // fprintf (stderr, "\n LSN/TG to tune to: %d - %d", j+1, t_tg[j]);
 
-                                if (state->trunk_chan_map[j + 1] != 0) //if we have a valid frequency
+                                if (dsd_chan_map_get(&state->trunk_chan_map, j + 1) != 0) //if we have a valid frequency
                                 {
                                     //DMR-specific TG assignment for TG hold
                                     if (state->tg_hold != 0) {
@@ -2120,12 +2120,14 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                                     }
 
                                     // Reset blocks if tuning away
-                                    if (opts->rtlsdr_center_freq != (uint32_t)state->trunk_chan_map[j + 1]) {
+                                    if (opts->rtlsdr_center_freq
+                                        != (uint32_t)dsd_chan_map_get(&state->trunk_chan_map, j + 1)) {
                                         dmr_reset_blocks(opts, state);
                                     }
 
                                     // Use centralized io/control tuning API
-                                    dsd_trunk_tuning_hook_tune_to_freq(opts, state, state->trunk_chan_map[j + 1], 0);
+                                    dsd_trunk_tuning_hook_tune_to_freq(
+                                        opts, state, dsd_chan_map_get(&state->trunk_chan_map, j + 1), 0);
                                     j = 11; //break loop
                                 }
                             }
@@ -2154,15 +2156,15 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                     int busy = memcmp(empty, t_tg, sizeof(empty));
 
                     //testing (don't keep setting on quick data call LSN flip flops but same frequency for rest channel, other misc conditions)
-                    // if (!busy && rest_channel != state->dmr_rest_channel && opts->trunk_enable == 1 && state->trunk_cc_freq != state->trunk_chan_map[rest_channel])
+                    // if (!busy && rest_channel != state->dmr_rest_channel && opts->trunk_enable == 1 && state->trunk_cc_freq != dsd_chan_map_get(&state->trunk_chan_map, rest_channel))
                     if (!busy && opts->trunk_enable == 1
-                        && state->trunk_cc_freq != state->trunk_chan_map[rest_channel]) {
+                        && state->trunk_cc_freq != dsd_chan_map_get(&state->trunk_chan_map, rest_channel)) {
                         //assign now, ideally, this should always trigger a positive p_clear when needed
                         // state->dmr_rest_channel = rest_channel;
 
                         //update frequency
-                        if (state->trunk_chan_map[rest_channel] != 0) {
-                            state->trunk_cc_freq = state->trunk_chan_map[rest_channel];
+                        if (dsd_chan_map_get(&state->trunk_chan_map, rest_channel) != 0) {
+                            state->trunk_cc_freq = dsd_chan_map_get(&state->trunk_chan_map, rest_channel);
                         }
 
                         //Craft a fake CSBK pdu send it to run as a p_clear to go to rest channel if its available (no calls currently)
@@ -2284,10 +2286,10 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                 //FME to return to a dead air channel and start searching
 
                 //shim in here for ncurses freq display when not trunking (playback, not live)
-                if (opts->trunk_enable == 0 && state->trunk_chan_map[lcn] != 0) {
+                if (opts->trunk_enable == 0 && dsd_chan_map_get(&state->trunk_chan_map, lcn) != 0) {
                     //just set to both for now, could go on tslot later
-                    state->trunk_vc_freq[0] = state->trunk_chan_map[lcn];
-                    state->trunk_vc_freq[1] = state->trunk_chan_map[lcn];
+                    state->trunk_vc_freq[0] = dsd_chan_map_get(&state->trunk_chan_map, lcn);
+                    state->trunk_vc_freq[1] = dsd_chan_map_get(&state->trunk_chan_map, lcn);
                 }
 
                 //if tg hold is specified and matches target, allow for a call pre-emption by nullifying the last vc sync time
@@ -2336,7 +2338,7 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
 
                     if (state->trunk_cc_freq != 0 && opts->trunk_enable == 1 && (strcmp(mode, "B") != 0)
                         && (strcmp(mode, "DE") != 0)) {
-                        long f = state->trunk_chan_map[lcn];
+                        long f = dsd_chan_map_get(&state->trunk_chan_map, lcn);
                         if (f != 0) {
                             // Mark as Con+ context for data block reset heuristics
                             state->is_con_plus = 1;
@@ -2389,10 +2391,10 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                 //FME to return to a dead air channel and start searching
 
                 //shim in here for ncurses freq display when not trunking (playback, not live)
-                if (opts->trunk_enable == 0 && state->trunk_chan_map[lcn] != 0) {
+                if (opts->trunk_enable == 0 && dsd_chan_map_get(&state->trunk_chan_map, lcn) != 0) {
                     //just set to both for now, could go on tslot later
-                    state->trunk_vc_freq[0] = state->trunk_chan_map[lcn];
-                    state->trunk_vc_freq[1] = state->trunk_chan_map[lcn];
+                    state->trunk_vc_freq[0] = dsd_chan_map_get(&state->trunk_chan_map, lcn);
+                    state->trunk_vc_freq[1] = dsd_chan_map_get(&state->trunk_chan_map, lcn);
                 }
 
                 //if tg hold is specified and matches target, allow for a call pre-emption by nullifying the last vc sync time
@@ -2426,10 +2428,11 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
 
                     if (state->trunk_cc_freq != 0 && opts->trunk_enable == 1 && (strcmp(mode, "B") != 0)
                         && (strcmp(mode, "DE") != 0)) {
-                        if (state->trunk_chan_map[lcn] != 0) //if we have a valid frequency
+                        if (dsd_chan_map_get(&state->trunk_chan_map, lcn) != 0) //if we have a valid frequency
                         {
                             // Use centralized io/control tuning API
-                            dsd_trunk_tuning_hook_tune_to_freq(opts, state, state->trunk_chan_map[lcn], 0);
+                            dsd_trunk_tuning_hook_tune_to_freq(opts, state,
+                                                               dsd_chan_map_get(&state->trunk_chan_map, lcn), 0);
                             state->is_con_plus = 1;        //flag on
                             dmr_reset_blocks(opts, state); //reset all block gathering since we are tuning away
                         }
@@ -2503,7 +2506,7 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                 fprintf(stderr, " Hytera XPT Site Status - Free LCN: %d SN: %d", xpt_free, xpt_seq);
                 // Add free LCN frequency as a CC candidate if known
                 if (xpt_free != 0) {
-                    long f = state->trunk_chan_map[xpt_free];
+                    long f = dsd_chan_map_get(&state->trunk_chan_map, xpt_free);
                     if (f != 0) {
                         long candx[1] = {f};
                         dmr_sm_on_neighbor_update(opts, state, candx, 1);
@@ -2678,7 +2681,8 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                             //debug print for tuning verification
                             fprintf(stderr, "\n LSN/TG to tune to: %d - %d", j + xpt_bank + 1, t_tg[j + xpt_bank]);
 
-                            if (state->trunk_chan_map[j + xpt_bank + 1] != 0) { // if we have a valid frequency
+                            // if we have a valid frequency
+                            if (dsd_chan_map_get(&state->trunk_chan_map, j + xpt_bank + 1) != 0) {
                                 // Common handling for rigctl or RTL input
                                 if (opts->use_rigctl == 1 || opts->audio_in_type == AUDIO_IN_RTL) {
                                     // TG hold handling (ensure lasttg/lasttgR tracked on tune)
@@ -2691,9 +2695,10 @@ dmr_cspdu(dsd_opts* opts, dsd_state* state, uint8_t cs_pdu_bits[], uint8_t cs_pd
                                     }
 
                                     // Defer tune to SM (common path)
-                                    dmr_sm_emit_group_grant(opts, state,
-                                                            /*freq_hz*/ state->trunk_chan_map[j + xpt_bank + 1],
-                                                            /*lpcn*/ 0, /*tg*/ t_tg[j + xpt_bank], /*src*/ 0);
+                                    dmr_sm_emit_group_grant(
+                                        opts, state,
+                                        /*freq_hz*/ dsd_chan_map_get(&state->trunk_chan_map, j + xpt_bank + 1),
+                                        /*lpcn*/ 0, /*tg*/ t_tg[j + xpt_bank], /*src*/ 0);
                                     j = 11; // break loop
                                 }
                             }
@@ -22,6 +22,7 @@
 #include <dsd-neo/protocol/dmr/dmr.h>
 #include <dsd-neo/protocol/dmr/dmr_utils_api.h>
 #include <dsd-neo/runtime/colors.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #include <dsd-neo/runtime/rigctl_query_hooks.h>
 #include <dsd-neo/runtime/trunk_tuning_hooks.h>
 
@@ -542,6 +543,7 @@ dmr_flco(dsd_opts* opts, dsd_state* state, uint8_t lc_bits[], uint32_t CRCCorrec
                 state->dmr_embedded_gps[1][0] = '\0';
                 state->dmr_lrrp_gps[1][0] = '\0';
             }
+            dsd_decoder_events_call(state, state->currentslot, 0);
         }
 
         //only assign this value here if not trunking
@@ -550,9 +552,9 @@ dmr_flco(dsd_opts* opts, dsd_state* state, uint8_t lc_bits[], uint32_t CRCCorrec
             if (restchannel != state->dmr_rest_channel && restchannel != -1) {
                 state->dmr_rest_channel = restchannel;
                 //assign to cc freq
-                // if (state->trunk_chan_map[restchannel] != 0)
+                // if (dsd_chan_map_get(&state->trunk_chan_map, restchannel) != 0)
                 // {
-                //   state->p25_cc_freq = state->trunk_chan_map[restchannel];
+                //   state->p25_cc_freq = dsd_chan_map_get(&state->trunk_chan_map, restchannel);
                 // }
             }
         }
@@ -1436,8 +1438,8 @@ dmr_slco(dsd_opts* opts, dsd_state* state, uint8_t slco_bits[]) {
                     // fprintf (stderr, " Neither Slot is TG on Hold; ");
 
                     //assign to cc freq if available -- move to right before needed for new logic on rest lsn
-                    if (state->trunk_chan_map[restchannel] != 0) {
-                        state->trunk_cc_freq = state->trunk_chan_map[restchannel];
+                    if (dsd_chan_map_get(&state->trunk_chan_map, restchannel) != 0) {
+                        state->trunk_cc_freq = dsd_chan_map_get(&state->trunk_chan_map, restchannel);
                     }
 
                     //tune to the current rest channel so we can observe its channel status csbks for the TG on hold
@@ -1486,8 +1488,8 @@ dmr_slco(dsd_opts* opts, dsd_state* state, uint8_t slco_bits[]) {
                     }
 
                     //check to see if the XPT free channel converted to lsn is available in the map
-                    if (state->trunk_chan_map[xpt_free] != 0) {
-                        state->trunk_cc_freq = state->trunk_chan_map[xpt_free];
+                    if (dsd_chan_map_get(&state->trunk_chan_map, xpt_free) != 0) {
+                        state->trunk_cc_freq = dsd_chan_map_get(&state->trunk_chan_map, xpt_free);
                     }
 
                     //tune to the current rest channel so we can observe its channel status csbks for the TG on hold
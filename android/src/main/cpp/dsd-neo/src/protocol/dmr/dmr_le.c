@@ -12,6 +12,7 @@
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/fec/block_codes.h>
 #include <dsd-neo/fec/bptc.h>
+#include <dsd-neo/fec/crc.h>
 #include <dsd-neo/protocol/dmr/dmr.h>
 #include <dsd-neo/protocol/dmr/dmr_utils_api.h>
 #include <dsd-neo/runtime/colors.h>
@@ -615,56 +616,14 @@ SBRC_END:
     }
 }
 
+//x^3+x^2+1
 uint8_t
 crc3(uint8_t bits[], unsigned int len) {
-    uint8_t crc = 0;
-    unsigned int K = 3;
-    //x^3+x+1
-    uint8_t poly[4] = {1, 1, 0, 1};
-    uint8_t buf[256];
-    if (len + K > sizeof(buf)) {
-        return 0;
-    }
-    memset(buf, 0, sizeof(buf));
-    for (unsigned int i = 0; i < len; i++) {
-        buf[i] = bits[i];
-    }
-    for (unsigned int i = 0; i < len; i++) {
-        if (buf[i]) {
-            for (unsigned int j = 0; j < K + 1; j++) {
-                buf[i + j] ^= poly[j];
-            }
-        }
-    }
-    for (unsigned int i = 0; i < K; i++) {
-        crc = (crc << 1) + buf[len + i];
-    }
-    return crc;
+    return (uint8_t)dsd_crc_bits(dsd_crc_get(DSD_CRC3_DMR), bits, len);
 }
 
+//x^4+x+1, inverted
 uint8_t
 crc4(uint8_t bits[], unsigned int len) {
-    uint8_t crc = 0;
-    unsigned int K = 4;
-    //x^4+x+1
-    uint8_t poly[5] = {1, 0, 0, 1, 1};
-    uint8_t buf[256];
-    if (len + K > sizeof(buf)) {
-        return 0;
-    }
-    memset(buf, 0, sizeof(buf));
-    for (unsigned int i = 0; i < len; i++) {
-        buf[i] = bits[i];
-    }
-    for (unsigned int i = 0; i < len; i++) {
-        if (buf[i]) {
-            for (unsigned int j = 0; j < K + 1; j++) {
-                buf[i + j] ^= poly[j];
-            }
-        }
-    }
-    for (unsigned int i = 0; i < K; i++) {
-        crc = (crc << 1) + buf[len + i];
-    }
-    return crc ^ 0xF; //invert
+    return (uint8_t)dsd_crc_bits(dsd_crc_get(DSD_CRC4_DMR), bits, len);
 }
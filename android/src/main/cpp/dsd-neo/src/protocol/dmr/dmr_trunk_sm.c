@@ -11,7 +11,9 @@
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/protocol/dmr/dmr_trunk_sm.h>
 #include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #include <dsd-neo/runtime/trunk_cc_candidates.h>
+#include <dsd-neo/runtime/trunk_timers.h>
 #include <dsd-neo/runtime/trunk_tuning_hooks.h>
 
 #include <stdio.h>
@@ -41,7 +43,7 @@ resolve_freq(const dsd_state* state, long freq_hz, int lpcn) {
         return freq_hz;
     }
     if (state && lpcn > 0 && lpcn < 0xFFFF) {
-        return state->trunk_chan_map[lpcn];
+        return dsd_chan_map_get(&state->trunk_chan_map, lpcn);
     }
     return 0;
 }
@@ -312,6 +314,62 @@ dmr_sm_init_ctx(dmr_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state) {
     ctx->initialized = 1;
 }
 
+// DMR voice frames arrive every ~60ms; use 200ms as a generous threshold.
+#define DMR_VOICE_STALE_S 0.2
+
+static void
+sm_timer_fire(dsd_opts* opts, dsd_state* state) {
+    dmr_sm_tick(opts, state);
+}
+
+static void
+earliest(double* due, double t) {
+    if (t > 0.0 && (*due <= 0.0 || t < *due)) {
+        *due = t;
+    }
+}
+
+// Arm the SM timer for the next moment tick() would act without a new event,
+// so hangtime and grant timeouts fire even when no frames arrive.
+static void
+arm_sm_deadline(dmr_sm_ctx_t* ctx, dsd_state* state) {
+    if (!state || ctx != dmr_sm_get_ctx()) {
+        return;
+    }
+    double due = 0.0;
+    switch (ctx->state) {
+        case DMR_SM_ON_CC:
+            if (ctx->t_cc_sync_m > 0.0) {
+                earliest(&due, ctx->t_cc_sync_m + ctx->cc_grace_s + 0.01);
+            }
+            break;
+        case DMR_SM_TUNED: {
+            int has_voice = 0;
+            for (int s = 0; s < 2; s++) {
+                if (ctx->slots[s].voice_active && ctx->slots[s].last_active_m > 0.0) {
+                    has_voice = 1;
+                    earliest(&due, ctx->slots[s].last_active_m + DMR_VOICE_STALE_S + 0.01);
+                }
+            }
+            if (has_voice) {
+                break;
+            }
+            if (ctx->t_voice_m > 0.0) {
+                earliest(&due, ctx->t_voice_m + ctx->hangtime_s);
+            } else if (ctx->t_tune_m > 0.0) {
+                earliest(&due, ctx->t_tune_m + ctx->grant_timeout_s);
+            }
+            break;
+        }
+        default: break;
+    }
+    if (due > 0.0) {
+        dsd_trunk_timer_arm(state, DSD_TRUNK_TIMER_DMR_SM, due, sm_timer_fire);
+    } else {
+        dsd_trunk_timer_cancel(state, DSD_TRUNK_TIMER_DMR_SM);
+    }
+}
+
 void
 dmr_sm_event(dmr_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state, const dmr_sm_event_t* ev) {
     if (!ctx || !ev) {
@@ -330,6 +388,8 @@ dmr_sm_event(dmr_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state, const dmr_sm_e
         case DMR_SM_EV_CC_SYNC: handle_cc_sync(ctx, opts, state); break;
         case DMR_SM_EV_SYNC_LOST: break;
     }
+
+    arm_sm_deadline(ctx, state);
 }
 
 void
@@ -361,8 +421,7 @@ dmr_sm_tick_ctx(dmr_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state) {
 
         case DMR_SM_TUNED: {
             // Clear voice_active for slots that haven't received sync recently.
-            // DMR voice frames arrive every ~60ms; use 200ms as a generous threshold.
-            const double voice_stale_threshold = 0.2;
+            const double voice_stale_threshold = DMR_VOICE_STALE_S;
             for (int s = 0; s < 2; s++) {
                 if (ctx->slots[s].voice_active && ctx->slots[s].last_active_m > 0.0) {
                     double dt_slot = now_m - ctx->slots[s].last_active_m;
@@ -394,6 +453,8 @@ dmr_sm_tick_ctx(dmr_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state) {
 
         case DMR_SM_HUNTING: break;
     }
+
+    arm_sm_deadline(ctx, state);
 }
 
 /* ============================================================================
@@ -425,6 +486,7 @@ void
 dmr_sm_emit_voice_sync(dsd_opts* opts, dsd_state* state, int slot) {
     dmr_sm_event_t ev = dmr_sm_ev_voice_sync(slot);
     dmr_sm_event(dmr_sm_get_ctx(), opts, state, &ev);
+    dsd_decoder_events_call(state, slot, 1);
 }
 
 void
@@ -437,6 +499,7 @@ void
 dmr_sm_emit_release(dsd_opts* opts, dsd_state* state, int slot) {
     dmr_sm_event_t ev = dmr_sm_ev_release(slot);
     dmr_sm_event(dmr_sm_get_ctx(), opts, state, &ev);
+    dsd_decoder_events_call(state, slot, 0);
 }
 
 void
@@ -12,6 +12,7 @@
 //Hamming17123, crc7, crc8, crc8ok functions
 //Original Souce - https://github.com/boatbod/op25
 
+#include <dsd-neo/fec/crc.h>
 #include <dsd-neo/fec/rs_12_9.h>
 #include <dsd-neo/protocol/dmr/dmr_utils_api.h>
 
@@ -20,27 +21,8 @@
 //modified to accept variable payload size and len
 uint16_t
 ComputeCrcCCITT16d(const uint8_t* buf, uint32_t len) {
-    uint32_t i;
-    uint16_t CRC = 0x0000; /* Initialization value = 0x0000 */
-    /* Polynomial x^16 + x^12 + x^5 + 1
-   * Normal     = 0x1021
-   * Reciprocal = 0x0811
-   * Reversed   = 0x8408
-   * Reversed reciprocal = 0x8810 */
-    uint16_t Polynome = 0x1021;
-    for (i = 0; i < len; i++) {
-        if (((CRC >> 15) & 1) ^ (buf[i] & 1)) {
-            CRC = (CRC << 1) ^ Polynome;
-        } else {
-            CRC <<= 1;
-        }
-    }
-
-    /* Invert the CRC */
-    CRC ^= 0xFFFF;
-
-    /* Return the CRC */
-    return CRC;
+    /* Polynomial x^16 + x^12 + x^5 + 1, init 0x0000, inverted */
+    return (uint16_t)dsd_crc_bits(dsd_crc_get(DSD_CRC16_CCITT), buf, len);
 } /* End ComputeCrcCCITTd() */
 
 // A Hamming (17,12,3) Check for completed SLC message
@@ -94,66 +76,18 @@ Hamming17123(uint8_t* d) {
 
 uint8_t
 crc8(uint8_t bits[], unsigned int len) {
-    uint8_t crc = 0;
-    unsigned int K = 8;
-    uint8_t poly[9] = {1, 0, 0, 0, 0, 0, 1, 1, 1}; // crc8 poly
-    uint8_t buf[256];
-    if (len + K > sizeof(buf)) {
-        //fprintf (stderr, "crc8: buffer length %u exceeds maximum %lu\n", len+K, sizeof(buf));
-        return 0;
-    }
-    memset(buf, 0, sizeof(buf));
-    for (unsigned int i = 0; i < len; i++) {
-        buf[i] = bits[i];
-    }
-    for (unsigned int i = 0; i < len; i++) {
-        if (buf[i]) {
-            for (unsigned int j = 0; j < K + 1; j++) {
-                buf[i + j] ^= poly[j];
-            }
-        }
-    }
-    for (unsigned int i = 0; i < K; i++) {
-        crc = (crc << 1) + buf[len + i];
-    }
-    return crc;
+    return (uint8_t)dsd_crc_bits(dsd_crc_get(DSD_CRC8_DMR), bits, len);
 }
 
 bool
 crc8_ok(uint8_t bits[], unsigned int len) {
-    uint16_t crc = 0;
-    for (unsigned int i = 0; i < 8; i++) {
-        crc = (crc << 1) + bits[len + i];
-    }
-    return (crc == crc8(bits, len));
+    return dsd_crc_bits_check(dsd_crc_get(DSD_CRC8_DMR), bits, len) != 0;
 }
 
+//G7(x) = x7 + x5 + x2 + x + 1 (dmr rc crc7)
 uint8_t
 crc7(uint8_t bits[], unsigned int len) {
-    uint8_t crc = 0;
-    unsigned int K = 7;
-    //G7(x) = x7 + x5 + x2 + x + 1   check poly below for correct (dmr rc crc7)
-    uint8_t poly[8] = {1, 0, 1, 0, 0, 1, 1, 1}; // crc7 poly
-    uint8_t buf[256];
-    if (len + K > sizeof(buf)) {
-        // fprintf (stderr, "crc8: buffer length %u exceeds maximum %lu\n", len+K, sizeof(buf));
-        return 0;
-    }
-    memset(buf, 0, sizeof(buf));
-    for (unsigned int i = 0; i < len; i++) {
-        buf[i] = bits[i];
-    }
-    for (unsigned int i = 0; i < len; i++) {
-        if (buf[i]) {
-            for (unsigned int j = 0; j < K + 1; j++) {
-                buf[i + j] ^= poly[j];
-            }
-        }
-    }
-    for (unsigned int i = 0; i < K; i++) {
-        crc = (crc << 1) + buf[len + i];
-    }
-    return crc;
+    return (uint8_t)dsd_crc_bits(dsd_crc_get(DSD_CRC7_DMR), bits, len);
 }
 
 /*
@@ -167,27 +101,7 @@ crc7(uint8_t bits[], unsigned int len) {
 
 uint16_t
 ComputeCrcCCITT(uint8_t* DMRData) {
-    uint32_t i;
-    uint16_t CRC = 0x0000; /* Initialization value = 0x0000 */
-    /* Polynomial x^16 + x^12 + x^5 + 1
-   * Normal     = 0x1021
-   * Reciprocal = 0x0811
-   * Reversed   = 0x8408
-   * Reversed reciprocal = 0x8810 */
-    uint16_t Polynome = 0x1021;
-    for (i = 0; i < 80; i++) {
-        if (((CRC >> 15) & 1) ^ (DMRData[i] & 1)) {
-            CRC = (CRC << 1) ^ Polynome;
-        } else {
-            CRC <<= 1;
-        }
-    }
-
-    /* Invert the CRC */
-    CRC ^= 0xFFFF;
-
-    /* Return the CRC */
-    return CRC;
+    return (uint16_t)dsd_crc_bits(dsd_crc_get(DSD_CRC16_CCITT), DMRData, 80);
 } /* End ComputeCrcCCITT() */
 
 /*
@@ -354,29 +268,8 @@ ConvertBitIntoBytes(uint8_t* BufferIn, uint32_t BitLength) {
  */
 uint16_t
 ComputeCrc9Bit(uint8_t* DMRData, uint32_t NbData) {
-    uint32_t i;
-    uint16_t CRC = 0x0000; /* Initialization value = 0x0000 */
-    /* Polynomial x^9 + x^6 + x^4 + x^3 + 1
-   * Normal     = 0x059
-   * Reciprocal = 0x134
-   * Reversed reciprocal = 0x12C */
-    uint16_t Polynome = 0x059;
-    for (i = 0; i < NbData; i++) {
-        if (((CRC >> 8) & 1) ^ (DMRData[i] & 1)) {
-            CRC = (CRC << 1) ^ Polynome;
-        } else {
-            CRC <<= 1;
-        }
-    }
-
-    /* Conserve only the 9 LSBs */
-    CRC &= 0x01FF;
-
-    /* Invert the CRC */
-    CRC ^= 0x01FF;
-
-    /* Return the CRC */
-    return CRC;
+    /* Polynomial x^9 + x^6 + x^4 + x^3 + 1, init 0x000, inverted */
+    return (uint16_t)dsd_crc_bits(dsd_crc_get(DSD_CRC9_DMR), DMRData, NbData);
 } /* End ComputeCrc9Bit() */
 
 /*
@@ -397,32 +290,8 @@ ComputeCrc9Bit(uint8_t* DMRData, uint32_t NbData) {
  */
 uint32_t
 ComputeCrc32Bit(uint8_t* DMRData, uint32_t NbData) {
-    uint32_t i;
-    uint32_t CRC = 0x00000000; /* Initialization value = 0x00000000 */
-    /* Polynomial x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 + x^7 + x^5 + x^4 + x^2 + x + 1
-   * Normal     = 0x04C11DB7
-   * Reversed   = 0xEDB88320
-   * Reciprocal = 0xDB710641
-   * Reversed reciprocal = 0x82608EDB */
-    uint32_t Polynome = 0x04C11DB7;
-    for (i = 0; i < NbData; i++) {
-        if (((CRC >> 31) & 1) ^ (DMRData[i] & 1)) {
-            CRC = (CRC << 1) ^ Polynome;
-        } else {
-            CRC <<= 1;
-        }
-    }
+    uint32_t CRC = dsd_crc_bits(dsd_crc_get(DSD_CRC32_DMR), DMRData, NbData);
 
     //for whatever reason, we get the CRC returned in a reversed byte order (MSO LSO b***s***)
-    uint32_t a, b, c, d;
-    a = (CRC & 0xFF) << 24;
-    b = (CRC & 0xFF00) >> 8;
-    b = b << 16;
-    c = (CRC & 0xFF0000) >> 16;
-    c = c << 8;
-    d = (CRC & 0xFF000000) >> 24;
-
-    CRC = a + b + c + d;
-    /* Return the CRC */
-    return CRC;
+    return ((CRC & 0xFF) << 24) | ((CRC & 0xFF00) << 8) | ((CRC >> 8) & 0xFF00) | (CRC >> 24);
 } /* End ComputeCrc32Bit() */
@@ -39,6 +39,7 @@
 #include <dsd-neo/platform/audio.h>
 #include <dsd-neo/platform/file_compat.h>
 #include <dsd-neo/protocol/dmr/dmr_utils_api.h>
+#include <dsd-neo/runtime/audio_sink.h>
 #include <dsd-neo/runtime/colors.h>
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/log.h>
@@ -595,16 +596,18 @@ edacs_analog(dsd_opts* opts, dsd_state* state, int afs, unsigned char lcn) {
         }
 
         if (opts->audio_out_type == 1 && opts->floating_point == 0 && opts->slot1_on == 1) {
+            dsd_audio_sink_lock();
             ssize_t written = dsd_write(opts->audio_out_fd, analog1, (size_t)960u * sizeof(short));
+            ssize_t written2 = dsd_write(opts->audio_out_fd, analog2, (size_t)960u * sizeof(short));
+            ssize_t written3 = dsd_write(opts->audio_out_fd, analog3, (size_t)960u * sizeof(short));
+            dsd_audio_sink_unlock();
             if (written < 0) {
                 LOG_WARN("edacs_analog: failed to write analog1 audio block");
             }
-            written = dsd_write(opts->audio_out_fd, analog2, (size_t)960u * sizeof(short));
-            if (written < 0) {
+            if (written2 < 0) {
                 LOG_WARN("edacs_analog: failed to write analog2 audio block");
             }
-            written = dsd_write(opts->audio_out_fd, analog3, (size_t)960u * sizeof(short));
-            if (written < 0) {
+            if (written3 < 0) {
                 LOG_WARN("edacs_analog: failed to write analog3 audio block");
             }
         }
@@ -23,6 +23,7 @@
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/fec/block_codes.h>
+#include <dsd-neo/fec/crc.h>
 #include <dsd-neo/fec/viterbi.h>
 #include <dsd-neo/platform/audio.h>
 #include <dsd-neo/platform/file_compat.h>
@@ -30,12 +31,14 @@
 #include <dsd-neo/protocol/m17/m17_parse.h>
 #include <dsd-neo/protocol/m17/m17_tables.h>
 #include <dsd-neo/protocol/nxdn/nxdn_convolution.h>
+#include <dsd-neo/runtime/audio_sink.h>
 #include <dsd-neo/runtime/control_pump.h>
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/log.h>
 #include <dsd-neo/runtime/m17_udp_hooks.h>
 #include <dsd-neo/runtime/net_audio_input_hooks.h>
 #include <dsd-neo/runtime/rtl_stream_io_hooks.h>
+#include <dsd-neo/runtime/symbol_file.h>
 #include <dsd-neo/runtime/telemetry.h>
 #include <dsd-neo/runtime/udp_audio_hooks.h>
 
@@ -69,19 +72,7 @@ clip_float_to_short(float v) {
 //this setup looks very similar to the OP25 variant of crc16, but with a few differences (uses packed bytes)
 uint16_t
 crc16m17(const uint8_t* in, const uint16_t len) {
-    uint32_t crc = 0xFFFF; //init val
-    uint16_t poly = 0x5935;
-    for (uint16_t i = 0; i < len; i++) {
-        crc ^= in[i] << 8;
-        for (uint8_t j = 0; j < 8; j++) {
-            crc <<= 1;
-            if (crc & 0x10000) {
-                crc = (crc ^ poly) & 0xFFFF;
-            }
-        }
-    }
-
-    return crc & (0xFFFF);
+    return (uint16_t)dsd_crc_bytes(dsd_crc_get(DSD_CRC16_M17), in, len);
 }
 
 void
@@ -417,7 +408,9 @@ M17processCodec2_1600(dsd_opts* opts, dsd_state* state, uint8_t* payload) {
 
         if (opts->audio_out_type == 0 && state->m17_enc == 0) //Pulse Audio
         {
+            dsd_audio_sink_lock();
             dsd_audio_write(opts->audio_out_stream, samp1, (size_t)nsam);
+            dsd_audio_sink_unlock();
         }
 
         if (opts->audio_out_type == 8 && state->m17_enc == 0) //UDP Audio
@@ -426,7 +419,9 @@ M17processCodec2_1600(dsd_opts* opts, dsd_state* state, uint8_t* payload) {
         }
 
         if (opts->audio_out_type == 1 && state->m17_enc == 0) {
+            dsd_audio_sink_lock();
             ssize_t written = dsd_write(opts->audio_out_fd, samp1, nsam * sizeof(short));
+            dsd_audio_sink_unlock();
             if (written < 0) {
                 LOG_WARN("M17processCodec2_1600: failed to write %zu-byte audio block", nsam * sizeof(short));
             }
@@ -528,8 +523,10 @@ M17processCodec2_3200(dsd_opts* opts, dsd_state* state, uint8_t* payload) {
 
         if (opts->audio_out_type == 0 && state->m17_enc == 0) //Pulse Audio
         {
+            dsd_audio_sink_lock();
             dsd_audio_write(opts->audio_out_stream, samp1, (size_t)nsam);
             dsd_audio_write(opts->audio_out_stream, samp2, (size_t)nsam);
+            dsd_audio_sink_unlock();
         }
 
         if (opts->audio_out_type == 8 && state->m17_enc == 0) //UDP Audio
@@ -539,12 +536,14 @@ M17processCodec2_3200(dsd_opts* opts, dsd_state* state, uint8_t* payload) {
         }
 
         if (opts->audio_out_type == 1 && state->m17_enc == 0) {
+            dsd_audio_sink_lock();
             ssize_t written = dsd_write(opts->audio_out_fd, samp1, nsam * sizeof(short));
+            ssize_t written2 = dsd_write(opts->audio_out_fd, samp2, nsam * sizeof(short));
+            dsd_audio_sink_unlock();
             if (written < 0) {
                 LOG_WARN("M17processCodec2_3200: failed to write first %zu-byte audio block", nsam * sizeof(short));
             }
-            written = dsd_write(opts->audio_out_fd, samp2, nsam * sizeof(short));
-            if (written < 0) {
+            if (written2 < 0) {
                 LOG_WARN("M17processCodec2_3200: failed to write second %zu-byte audio block", nsam * sizeof(short));
             }
         }
@@ -1391,7 +1390,7 @@ encodeM17RF(dsd_opts* opts, dsd_state* state, uint8_t* input, int type) {
     if (opts->symbol_out_f) //use -c output.bin to use this format (default type for DSD-neo)
     {
         for (i = 0; i < 192; i++) {
-            fputc(output_dibits[i], opts->symbol_out_f);
+            dsd_symbol_out_put(opts, state, output_dibits[i]);
         }
     }
 
@@ -1424,7 +1423,9 @@ encodeM17RF(dsd_opts* opts, dsd_state* state, uint8_t* input, int type) {
         }
 
         if (opts->audio_out_type == 1) {
+            dsd_audio_sink_lock();
             ssize_t written = dsd_write(opts->audio_out_fd, baseband, sizeof(baseband));
+            dsd_audio_sink_unlock();
             if (written < 0) {
                 LOG_WARN("encodeM17RF: failed to write %zu-byte baseband block", sizeof(baseband));
             }
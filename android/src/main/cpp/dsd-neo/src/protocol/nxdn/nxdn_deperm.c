@@ -29,6 +29,7 @@
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/fec/crc.h>
 #include <dsd-neo/fec/trellis.h>
 #include <dsd-neo/protocol/dmr/dmr_utils_api.h>
 #include <dsd-neo/protocol/nxdn/nxdn_const.h>
@@ -2056,110 +2057,46 @@ load_i(const uint8_t val[], int len) {
     return acc;
 }
 
+//NXDN CRCs run an LFSR preset to all ones; each maps to a plain MSB-first CRC model
 uint8_t
 crc6(const uint8_t buf[], int len) {
-    uint8_t s[6];
-    uint8_t a;
-    for (int i = 0; i < 6; i++) {
-        s[i] = 1;
-    }
-    for (int i = 0; i < len; i++) {
-        a = buf[i] ^ s[0];
-        s[0] = a ^ s[1];
-        s[1] = s[2];
-        s[2] = s[3];
-        s[3] = a ^ s[4];
-        s[4] = a ^ s[5];
-        s[5] = a;
-    }
-    return load_i(s, 6);
+    return (uint8_t)dsd_crc_bits(dsd_crc_get(DSD_CRC6_NXDN), buf, len > 0 ? (size_t)len : 0);
 }
 
 uint16_t
 crc12f(const uint8_t buf[], int len) {
-    uint8_t s[12];
-    uint8_t a;
-    for (int i = 0; i < 12; i++) {
-        s[i] = 1;
-    }
-    for (int i = 0; i < len; i++) {
-        a = buf[i] ^ s[0];
-        s[0] = a ^ s[1];
-        s[1] = s[2];
-        s[2] = s[3];
-        s[3] = s[4];
-        s[4] = s[5];
-        s[5] = s[6];
-        s[6] = s[7];
-        s[7] = s[8];
-        s[8] = a ^ s[9];
-        s[9] = a ^ s[10];
-        s[10] = a ^ s[11];
-        s[11] = a;
-    }
-    return load_i(s, 12);
+    return (uint16_t)dsd_crc_bits(dsd_crc_get(DSD_CRC12_NXDN), buf, len > 0 ? (size_t)len : 0);
 }
 
 uint16_t
 crc15(const uint8_t buf[], int len) {
-    uint8_t s[15];
-    uint8_t a;
-    for (int i = 0; i < 15; i++) {
-        s[i] = 1;
-    }
-    for (int i = 0; i < len; i++) {
-        a = buf[i] ^ s[0];
-        s[0] = a ^ s[1];
-        s[1] = s[2];
-        s[2] = s[3];
-        s[3] = a ^ s[4];
-        s[4] = a ^ s[5];
-        s[5] = s[6];
-        s[6] = s[7];
-        s[7] = a ^ s[8];
-        s[8] = a ^ s[9];
-        s[9] = s[10];
-        s[10] = s[11];
-        s[11] = s[12];
-        s[12] = a ^ s[13];
-        s[13] = s[14];
-        s[14] = a;
-    }
-    return load_i(s, 15);
+    return (uint16_t)dsd_crc_bits(dsd_crc_get(DSD_CRC15_NXDN), buf, len > 0 ? (size_t)len : 0);
 }
 
+//CAC: the message is shifted straight into a register preset to 0xc3ee with no trailing
+//zero bits, so the last 16 bits are only added, not divided; that is the CCITT register
+//over the first len-16 bits, preset to 0xc3ee * x^16 mod G (0x5fe7), with the tail XOR'd on
 uint16_t
 crc16cac(const uint8_t buf[], int len) {
-    uint32_t crc = 0xc3ee;                    //not sure why this though
-    uint32_t poly = (1 << 12) + (1 << 5) + 1; //poly is fine
-    for (int i = 0; i < len; i++) {
-        crc = ((crc << 1) | buf[i]) & 0x1ffff;
-        if (crc & 0x10000) {
-            crc = (crc & 0xffff) ^ poly;
+    const dsd_crc* crc = dsd_crc_get(DSD_CRC16_CCITT);
+    uint32_t reg;
+    if (len >= 16) {
+        reg = dsd_crc_bits_update(crc, 0x5fe7, buf, (size_t)len - 16) ^ dsd_crc_load_bits(buf + len - 16, 16);
+    } else {
+        reg = 0xc3ee;
+        for (int i = 0; i < len; i++) {
+            reg = ((reg << 1) | buf[i]) & 0x1ffff;
+            if (reg & 0x10000) {
+                reg = (reg & 0xffff) ^ 0x1021;
+            }
         }
     }
-    crc = crc ^ 0xffff;
-    return crc & 0xffff;
+    return (uint16_t)(reg ^ 0xffff);
 }
 
 uint8_t
 crc7_scch(uint8_t bits[], int len) {
-    uint8_t s[7];
-    uint8_t a;
-    for (int i = 0; i < 7; i++) {
-        s[i] = 1;
-    }
-    for (int i = 0; i < len; i++) {
-        a = bits[i] ^ s[0];
-        s[0] = s[1];
-        s[1] = s[2];
-        s[2] = s[3];
-        s[3] = a ^ s[4];
-        s[4] = s[5];
-        s[5] = s[6];
-        s[6] = a;
-    }
-    return load_i(s, 7);
+    return (uint8_t)dsd_crc_bits(dsd_crc_get(DSD_CRC7_NXDN_SCCH), bits, len > 0 ? (size_t)len : 0);
 }
 
 void
@@ -1843,11 +1843,12 @@ NXDN_decode_scch(dsd_opts* opts, dsd_state* state, uint8_t* Message, uint8_t dir
             //begin tuning
             if (tune == 1 && rep1 != 0) {
                 //check for control channel frequency in the channel map if not available
-                if (state->trunk_chan_map[31] != 0) {
-                    state->p25_cc_freq =
-                        state->trunk_chan_map[31]; //user provided channel to go to for '31' -- may change to 0 later?
-                } else if (state->trunk_chan_map[rep2] != 0) {
-                    state->p25_cc_freq = state->trunk_chan_map[rep2]; //rep2 is home repeater under this message
+                if (dsd_chan_map_get(&state->trunk_chan_map, 31) != 0) {
+                    //user provided channel to go to for '31' -- may change to 0 later?
+                    state->p25_cc_freq = dsd_chan_map_get(&state->trunk_chan_map, 31);
+                } else if (dsd_chan_map_get(&state->trunk_chan_map, rep2) != 0) {
+                    //rep2 is home repeater under this message
+                    state->p25_cc_freq = dsd_chan_map_get(&state->trunk_chan_map, rep2);
                 }
 
                 //run group/tgt analysis and tune if available/desired
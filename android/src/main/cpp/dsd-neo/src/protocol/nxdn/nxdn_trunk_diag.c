@@ -86,7 +86,7 @@ nxdn_trunk_diag_collect_unmapped_channels(const dsd_state* state, uint16_t* out,
         if ((diag->missing_seen[byte_idx] & bit_mask) == 0) {
             continue;
         }
-        if (state->trunk_chan_map[ch] != 0) {
+        if (dsd_chan_map_get(&state->trunk_chan_map, ch) != 0) {
             continue;
         }
 
@@ -111,7 +111,7 @@ nxdn_trunk_diag_log_missing_channel_once(const dsd_opts* opts, dsd_state* state,
     if (channel == 0 || channel >= 0xFFFFu) {
         return;
     }
-    if (state->trunk_chan_map[channel] != 0) {
+    if (dsd_chan_map_get(&state->trunk_chan_map, channel) != 0) {
         return;
     }
     if (!nxdn_trunk_diag_note_missing_channel(state, channel)) {
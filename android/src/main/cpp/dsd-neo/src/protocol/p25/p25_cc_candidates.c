@@ -9,12 +9,15 @@
  * reused by tests and UI code without pulling in tuning policy.
  */
 
+#include <dsd-neo/core/dsd_time.h>
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/platform/posix_compat.h>
 #include <dsd-neo/protocol/p25/p25_cc_candidates.h>
 #include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #include <dsd-neo/runtime/trunk_cc_candidates.h>
+#include <dsd-neo/runtime/trunk_timers.h>
 
 #include <errno.h>
 #include <stdio.h>
@@ -139,6 +142,36 @@ p25_cc_persist_cache(dsd_opts* opts, dsd_state* state) {
 
 #define P25_NB_TTL_SEC ((time_t)30 * 60)
 
+static void nb_expire_fire(dsd_opts* opts, dsd_state* state);
+
+// Arm the neighbor expiry timer for the least recently seen entry.
+static void
+nb_arm_expiry(dsd_state* state) {
+    time_t oldest = 0;
+    for (int i = 0; i < state->p25_nb_count && i < 32; i++) {
+        time_t last = state->p25_nb_last_seen[i];
+        if (last != 0 && (oldest == 0 || last < oldest)) {
+            oldest = last;
+        }
+    }
+    if (oldest == 0) {
+        dsd_trunk_timer_cancel(state, DSD_TRUNK_TIMER_P25_NB);
+        return;
+    }
+    double wait_s = (double)(oldest + P25_NB_TTL_SEC - time(NULL)) + 1.0;
+    if (wait_s < 0.0) {
+        wait_s = 0.0;
+    }
+    dsd_trunk_timer_arm(state, DSD_TRUNK_TIMER_P25_NB, dsd_time_now_monotonic_s() + wait_s, nb_expire_fire);
+}
+
+static void
+nb_expire_fire(dsd_opts* opts, dsd_state* state) {
+    (void)opts;
+    p25_nb_tick(state);
+    nb_arm_expiry(state);
+}
+
 void
 p25_nb_add(dsd_state* state, long freq) {
     if (!state || freq <= 0) {
@@ -147,6 +180,7 @@ p25_nb_add(dsd_state* state, long freq) {
     for (int i = 0; i < state->p25_nb_count && i < 32; i++) {
         if (state->p25_nb_freq[i] == freq) {
             state->p25_nb_last_seen[i] = time(NULL);
+            dsd_decoder_events_table(state, DSD_EVENT_NEIGHBOR);
             return;
         }
     }
@@ -169,6 +203,10 @@ p25_nb_add(dsd_state* state, long freq) {
     }
     state->p25_nb_freq[idx] = freq;
     state->p25_nb_last_seen[idx] = time(NULL);
+    if (!dsd_trunk_timer_pending(state, DSD_TRUNK_TIMER_P25_NB, NULL)) {
+        nb_arm_expiry(state);
+    }
+    dsd_decoder_events_table(state, DSD_EVENT_NEIGHBOR);
 }
 
 void
@@ -194,5 +232,8 @@ p25_nb_tick(dsd_state* state) {
         state->p25_nb_freq[i] = 0;
         state->p25_nb_last_seen[i] = 0;
     }
-    state->p25_nb_count = w;
+    if (w != state->p25_nb_count) {
+        state->p25_nb_count = w;
+        dsd_decoder_events_table(state, DSD_EVENT_NEIGHBOR);
+    }
 }
@@ -10,61 +10,34 @@
  * 2022-09 DSD-FME Florida Man Edition
  *-----------------------------------------------------------------------------*/
 
+#include <dsd-neo/fec/crc.h>
+
 #include <stdint.h>
-#include <string.h>
 
 //modified from the LEH ComputeCrcCCITT to accept variable len buffer bits
 uint16_t
 ComputeCrcCCITT16b(const uint8_t buf[], unsigned int len) {
-    uint32_t i;
-    uint16_t CRC = 0x0000;
-    uint16_t Polynome = 0x1021;
-    for (i = 0; i < len; i++) {
-        if (((CRC >> 15) & 1) ^ (buf[i] & 1)) {
-            CRC = (CRC << 1) ^ Polynome;
-        } else {
-            CRC <<= 1;
-        }
-    }
-
-    /* Invert the CRC */
-    CRC ^= 0xFFFF;
-
-    /* Return the CRC */
-    return CRC;
+    return (uint16_t)dsd_crc_bits(dsd_crc_get(DSD_CRC16_CCITT), buf, len);
 } /* End ComputeCrcCCITT() */
 
-//modified from crc12_ok to run a quickie on 16 instead
+//check the len data bits against the crc field that follows them
 static uint16_t
-crc16_ok(const uint8_t bits[], unsigned int len, unsigned int cap) {
-    uint16_t crc = 0;
-    // fprintf (stderr, "\n  LEN = %d", len);
-    if ((unsigned int)16 > cap || len > cap || (len + 16) > cap) {
+crc_bits_ok(dsd_crc_id id, const uint8_t bits[], unsigned int len, unsigned int cap) {
+    const dsd_crc* crc = dsd_crc_get(id);
+    unsigned int k = crc->model.width;
+    if (k > cap || len > cap || (len + k) > cap) {
         return (uint16_t)-1;
     }
-    for (int i = 0; i < 16; i++) {
-        crc = crc << 1;
-        crc = crc | bits[i + len];
-    }
-    uint16_t check = ComputeCrcCCITT16b(bits, len);
-
-    if (crc == check) {
-        //fprintf (stderr, " CRC = %04X %04X", crc, check);
-        return (0);
-    } else {
-        //fprintf (stderr, " CRC = %04X %04X", crc, check);
-        return (-1);
-    }
+    return dsd_crc_bits_check(crc, bits, len) ? 0 : (uint16_t)-1;
 }
 
-//TSBK/LCCH CRC16 x-bit bridge to crc16b and crc16b_okay, wip, may need multi pdu format as well
-int
-crc16_lb_bridge(const int* payload, int len) {
-    int err = -2;
+//load an x-bit payload plus its crc field into a byte buffer and check it
+static int
+crc_bridge(dsd_crc_id id, const int* payload, int len) {
     uint8_t buf[190] = {0};
 
-    // add +16 here so we load the entire frame but only run crc on the len portion
-    int total = len + 16;
+    // add the crc width here so we load the entire frame but only run crc on the len portion
+    int total = len + (int)dsd_crc_get(id)->model.width;
     if (total < 0) {
         total = 0;
     }
@@ -74,80 +47,20 @@ crc16_lb_bridge(const int* payload, int len) {
     for (int i = 0; i < total; i++) {
         buf[i] = (uint8_t)payload[i];
     }
-    err = crc16_ok(buf, (unsigned int)len, (unsigned int)sizeof buf);
-    return (err);
+    return crc_bits_ok(id, buf, (unsigned int)len, (unsigned int)sizeof buf);
 }
 
-//borrowing crc12 from OP25
-static uint16_t
-crc12(const uint8_t bits[], unsigned int len) {
-    uint16_t crc = 0;
-    static const unsigned int K = 12;
-    //g12(x) = x12 + x11 + x7 + x4 + x2 + x + 1
-    static const uint8_t poly[13] = {1, 1, 0, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1}; // p25 p2 crc 12 poly
-    uint8_t buf[256];
-    if (len + K > sizeof(buf)) {
-        //fprintf (stderr, "crc12: buffer length %u exceeds maximum %u\n", len+K, sizeof(buf));
-        return 0;
-    }
-    memset(buf, 0, sizeof(buf));
-    for (unsigned int i = 0; i < len; i++) {
-        buf[i] = bits[i];
-    }
-    for (unsigned int i = 0; i < len; i++) {
-        if (buf[i]) {
-            for (unsigned int j = 0; j < K + 1; j++) {
-                buf[i + j] ^= poly[j];
-            }
-        }
-    }
-    for (unsigned int i = 0; i < K; i++) {
-        crc = (crc << 1) + buf[len + i];
-    }
-    return crc ^ 0xfff;
-}
-
-//borrowing crc12_ok from OP25
-static uint16_t
-crc12_ok(const uint8_t bits[], unsigned int len, unsigned int cap) {
-    uint16_t crc = 0;
-    if ((unsigned int)12 > cap || len > cap || (len + 12) > cap) {
-        return (uint16_t)-1;
-    }
-    for (int i = 0; i < 12; i++) {
-        crc = crc << 1;
-        crc = crc | bits[i + len];
-    }
-    uint16_t check = crc12(bits, len);
-
-    if (crc == check) {
-        //fprintf (stderr, " CRC = %03X %03X", crc, check);
-        return (0);
-    } else {
-        //fprintf (stderr, " CRC = %03X %03X", crc, check);
-        return (-1);
-    }
+//TSBK/LCCH CRC16 x-bit bridge to crc16b and crc16b_okay, wip, may need multi pdu format as well
+int
+crc16_lb_bridge(const int* payload, int len) {
+    return crc_bridge(DSD_CRC16_CCITT, payload, len);
 }
 
 //xCCH CRC12 x-bit bridge to crc12b and crc12b_okay
+//g12(x) = x12 + x11 + x7 + x4 + x2 + x + 1, inverted
 int
 crc12_xb_bridge(const int* payload, int len) {
-    int err = -5;
-    uint8_t buf[190] = {0};
-
-    //need to load up the 12 crc bits as well, else it will fail on the check, but not on the crc calc
-    int total = len + 12;
-    if (total < 0) {
-        total = 0;
-    }
-    if (total > (int)sizeof(buf)) {
-        total = (int)sizeof(buf);
-    }
-    for (int i = 0; i < total; i++) {
-        buf[i] = (uint8_t)payload[i];
-    }
-    err = crc12_ok(buf, (unsigned int)len, (unsigned int)sizeof buf);
-    return (err);
+    return crc_bridge(DSD_CRC12_P25, payload, len);
 }
 
 uint8_t lsd_parity[256] = {
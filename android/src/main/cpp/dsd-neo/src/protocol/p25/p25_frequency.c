@@ -93,8 +93,8 @@ process_channel_to_freq(dsd_opts* opts, dsd_state* state, int channel) {
     int step = (chan16 & 0xFFF) / denom;
 
     //first, check channel map
-    if (state->trunk_chan_map[chan16] != 0) {
-        freq = state->trunk_chan_map[chan16];
+    if (dsd_chan_map_get(&state->trunk_chan_map, chan16) != 0) {
+        freq = dsd_chan_map_get(&state->trunk_chan_map, chan16);
         fprintf(stderr, "\n  P25 FREQ: map ch=0x%04X -> %.6lf MHz", chan16, (double)freq / 1000000.0);
         return freq;
     }
@@ -116,7 +116,7 @@ process_channel_to_freq(dsd_opts* opts, dsd_state* state, int channel) {
         }
         // Persist learned mapping so UI can display and future grants can use explicit map
         if (freq != 0) {
-            state->trunk_chan_map[chan16] = freq;
+            dsd_chan_map_set(&state->trunk_chan_map, chan16, freq);
         }
         return freq;
     }
@@ -236,8 +236,8 @@ nxdn_channel_to_frequency(dsd_opts* opts, dsd_state* state, uint16_t channel) {
 
     //first, check channel map for imported value, DFA systems most likely won't need an import,
     //unless it has 'system definable' attributes
-    if (state->trunk_chan_map[channel] != 0) {
-        freq = state->trunk_chan_map[channel];
+    if (dsd_chan_map_get(&state->trunk_chan_map, channel) != 0) {
+        freq = dsd_chan_map_get(&state->trunk_chan_map, channel);
         fprintf(stderr, "\n  Frequency [%.6lf] MHz", (double)freq / 1000000);
         return (freq);
     }
@@ -273,7 +273,7 @@ nxdn_channel_to_frequency(dsd_opts* opts, dsd_state* state, uint16_t channel) {
             fprintf(stderr, "\n  DFA Frequency [%.6lf] MHz", (double)freq / 1000000);
             // Persist learned mapping for UI visibility and later reuse
             if (freq != 0) {
-                state->trunk_chan_map[channel] = freq;
+                dsd_chan_map_set(&state->trunk_chan_map, channel, freq);
             }
             return (freq);
         } else {
@@ -296,7 +296,7 @@ nxdn_channel_to_frequency_quiet(dsd_state* state, uint16_t channel) {
     }
 
     // First: imported/learned mapping.
-    long int freq = state->trunk_chan_map[channel];
+    long int freq = dsd_chan_map_get(&state->trunk_chan_map, channel);
     if (freq != 0) {
         return freq;
     }
@@ -330,7 +330,7 @@ nxdn_channel_to_frequency_quiet(dsd_state* state, uint16_t channel) {
 
     freq = base + ((long int)channel * step);
     if (freq != 0) {
-        state->trunk_chan_map[channel] = freq;
+        dsd_chan_map_set(&state->trunk_chan_map, channel, freq);
     }
     return freq;
 }
@@ -7,8 +7,11 @@
  * P25 regroup/patch tracking utilities
  */
 
+#include <dsd-neo/core/dsd_time.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
+#include <dsd-neo/runtime/decoder_events.h>
+#include <dsd-neo/runtime/trunk_timers.h>
 
 #include <stdio.h>
 #include <time.h>
@@ -28,6 +31,12 @@ find_patch_idx(dsd_state* state, uint16_t sgid) {
     return -1;
 }
 
+// Entry past its TTL; the expiry timer drops it, readers just skip it.
+static int
+patch_is_stale(const dsd_state* state, int i, time_t now) {
+    return state->p25_patch_last_update[i] > 0 && (now - state->p25_patch_last_update[i]) > P25_PATCH_TTL_SECONDS;
+}
+
 static void
 p25_patch_sweep_stale(dsd_state* state) {
     if (!state) {
@@ -36,11 +45,7 @@ p25_patch_sweep_stale(dsd_state* state) {
     time_t now = time(NULL);
     int w = 0;
     for (int i = 0; i < state->p25_patch_count && i < 8; i++) {
-        int keep = 1;
-        if (state->p25_patch_last_update[i] > 0 && (now - state->p25_patch_last_update[i]) > P25_PATCH_TTL_SECONDS) {
-            keep = 0;
-        }
-        if (keep) {
+        if (!patch_is_stale(state, i, now)) {
             if (w != i) {
                 state->p25_patch_sgid[w] = state->p25_patch_sgid[i];
                 state->p25_patch_is_patch[w] = state->p25_patch_is_patch[i];
@@ -61,7 +66,40 @@ p25_patch_sweep_stale(dsd_state* state) {
             w++;
         }
     }
-    state->p25_patch_count = w;
+    if (w != state->p25_patch_count) {
+        state->p25_patch_count = w;
+        dsd_decoder_events_table(state, DSD_EVENT_PATCH);
+    }
+}
+
+static void patch_expire_fire(dsd_opts* opts, dsd_state* state);
+
+// Arm the sweep for when the stalest entry passes its TTL.
+static void
+patch_arm_expiry(dsd_state* state) {
+    time_t oldest = 0;
+    for (int i = 0; i < state->p25_patch_count && i < 8; i++) {
+        time_t last = state->p25_patch_last_update[i];
+        if (last > 0 && (oldest == 0 || last < oldest)) {
+            oldest = last;
+        }
+    }
+    if (oldest == 0) {
+        dsd_trunk_timer_cancel(state, DSD_TRUNK_TIMER_P25_PATCH);
+        return;
+    }
+    double wait_s = (double)(oldest + P25_PATCH_TTL_SECONDS - time(NULL)) + 1.0;
+    if (wait_s < 0.0) {
+        wait_s = 0.0;
+    }
+    dsd_trunk_timer_arm(state, DSD_TRUNK_TIMER_P25_PATCH, dsd_time_now_monotonic_s() + wait_s, patch_expire_fire);
+}
+
+static void
+patch_expire_fire(dsd_opts* opts, dsd_state* state) {
+    (void)opts;
+    p25_patch_sweep_stale(state);
+    patch_arm_expiry(state);
 }
 
 void
@@ -76,6 +114,7 @@ p25_patch_update(dsd_state* state, int sgid, int is_patch, int active) {
             state->p25_patch_is_patch[i] = is_patch ? 1 : 0;
             state->p25_patch_active[i] = active ? 1 : 0;
             state->p25_patch_last_update[i] = now;
+            dsd_decoder_events_table(state, DSD_EVENT_PATCH);
             return;
         }
     }
@@ -105,24 +144,27 @@ p25_patch_update(dsd_state* state, int sgid, int is_patch, int active) {
     state->p25_patch_wgid_count[idx] = 0;
     state->p25_patch_wuid_count[idx] = 0;
     state->p25_patch_key_valid[idx] = 0;
+    if (!dsd_trunk_timer_pending(state, DSD_TRUNK_TIMER_P25_PATCH, NULL)) {
+        patch_arm_expiry(state);
+    }
+    dsd_decoder_events_table(state, DSD_EVENT_PATCH);
 }
 
 int
-p25_patch_compose_summary(const dsd_state* state_in, char* out, size_t cap) {
+p25_patch_compose_summary(const dsd_state* state, char* out, size_t cap) {
     if (!out || cap == 0) {
         return 0;
     }
     out[0] = '\0';
-    if (!state_in) {
+    if (!state) {
         return 0;
     }
-    // Copy to temp and sweep stale to avoid modifying caller's state
-    dsd_state* state = (dsd_state*)state_in;
-    p25_patch_sweep_stale(state);
+    // Read-only (UI snapshots call this): skip stale entries, leave expiry to the timer
+    time_t now = time(NULL);
     char buf[128] = {0};
     int n = 0;
     for (int i = 0; i < state->p25_patch_count && i < 8; i++) {
-        if (!state->p25_patch_active[i]) {
+        if (!state->p25_patch_active[i] || patch_is_stale(state, i, now)) {
             continue;
         }
         if (!state->p25_patch_is_patch[i]) {
@@ -169,6 +211,7 @@ p25_patch_add_wgid(dsd_state* state, int sgid, int wgid) {
     if (cnt < 8) {
         state->p25_patch_wgid[idx][cnt] = (uint16_t)wgid;
         state->p25_patch_wgid_count[idx] = cnt + 1;
+        dsd_decoder_events_table(state, DSD_EVENT_PATCH);
     }
 }
 
@@ -194,23 +237,23 @@ p25_patch_add_wuid(dsd_state* state, int sgid, uint32_t wuid) {
     if (cnt < 8) {
         state->p25_patch_wuid[idx][cnt] = wuid;
         state->p25_patch_wuid_count[idx] = cnt + 1;
+        dsd_decoder_events_table(state, DSD_EVENT_PATCH);
     }
 }
 
 int
-p25_patch_compose_details(const dsd_state* state_in, char* out, size_t cap) {
+p25_patch_compose_details(const dsd_state* state, char* out, size_t cap) {
     if (!out || cap == 0) {
         return 0;
     }
     out[0] = '\0';
-    if (!state_in) {
+    if (!state) {
         return 0;
     }
-    dsd_state* state = (dsd_state*)state_in;
-    p25_patch_sweep_stale(state);
+    time_t now = time(NULL);
     int n = 0;
     for (int i = 0; i < state->p25_patch_count && i < 8; i++) {
-        if (!state->p25_patch_active[i]) {
+        if (!state->p25_patch_active[i] || patch_is_stale(state, i, now)) {
             continue;
         }
         char t = state->p25_patch_is_patch[i] ? 'P' : 'S';
@@ -280,6 +323,7 @@ p25_patch_remove_wgid(dsd_state* state, int sgid, int wgid) {
     if (state->p25_patch_wgid_count[idx] == 0 && state->p25_patch_wuid_count[idx] == 0) {
         state->p25_patch_active[idx] = 0;
     }
+    dsd_decoder_events_table(state, DSD_EVENT_PATCH);
 }
 
 void
@@ -304,6 +348,7 @@ p25_patch_remove_wuid(dsd_state* state, int sgid, uint32_t wuid) {
     if (state->p25_patch_wgid_count[idx] == 0 && state->p25_patch_wuid_count[idx] == 0) {
         state->p25_patch_active[idx] = 0;
     }
+    dsd_decoder_events_table(state, DSD_EVENT_PATCH);
 }
 
 void
@@ -318,6 +363,7 @@ p25_patch_clear_sg(dsd_state* state, int sgid) {
     state->p25_patch_wgid_count[idx] = 0;
     state->p25_patch_wuid_count[idx] = 0;
     state->p25_patch_active[idx] = 0;
+    dsd_decoder_events_table(state, DSD_EVENT_PATCH);
 }
 
 void
@@ -343,6 +389,7 @@ p25_patch_set_kas(dsd_state* state, int sgid, int key, int alg, int ssn) {
     if (ssn >= 0) {
         state->p25_patch_ssn[idx] = (uint8_t)(ssn & 0x1F);
     }
+    dsd_decoder_events_table(state, DSD_EVENT_PATCH);
 }
 
 // Return 1 if the given talkgroup (assumed WGID) is a member of an active
@@ -3,6 +3,7 @@
  * Copyright (C) 2025 by arancormonk <180709949+arancormonk@users.noreply.github.com>
  */
 
+#include <dsd-neo/core/dsd_time.h>
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/platform/atomic_compat.h>
 #include <dsd-neo/platform/threading.h>
@@ -10,7 +11,9 @@
 #include <dsd-neo/protocol/p25/p25_sm_watchdog.h>
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
 #include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/control_pump.h>
 #include <dsd-neo/runtime/exitflag.h>
+#include <dsd-neo/runtime/trunk_timers.h>
 
 /* exitflag declared in runtime/exitflag.h, defined in src/runtime/exitflag.c */
 
@@ -18,6 +21,7 @@ static dsd_thread_t g_p25_sm_wd_thread;
 static atomic_int g_p25_sm_wd_running = 0;
 static atomic_int g_p25_sm_tick_lock = 0;
 static atomic_int g_p25_sm_in_tick = 0;
+static atomic_int g_p25_sm_stall_posted = 0;
 static dsd_opts* g_opts = NULL;
 static dsd_state* g_state = NULL;
 static int g_p25_sm_wd_ms = 0; // 0 => unset (use defaults per UI mode)
@@ -38,6 +42,29 @@ p25_sm_try_tick(dsd_opts* opts, dsd_state* state) {
     }
 }
 
+static int
+p25_sm_watchdog_interval_ms(void) {
+    // Prefer env override when provided; otherwise check more often under
+    // ncurses to reduce perceived wedges.
+    int ms = g_p25_sm_wd_ms;
+    if (ms <= 0) {
+        ms = (g_opts && g_opts->use_ncurses_terminal == 1) ? 200 : 400; // 200ms UI, 400ms headless
+    }
+    if (ms < 20) {
+        ms = 20; // clamp to sane bounds
+    }
+    if (ms > 2000) {
+        ms = 2000; // 2s max
+    }
+    return ms;
+}
+
+/*
+ * Stall detector only: the decoder loop runs due timer jobs between frames,
+ * so an SM deadline overdue by a whole interval means it is blocked on input.
+ * Post the run instead of touching the SM from this thread; the decoder
+ * thread picks it up from the input wait loop (p25_sm_watchdog_service).
+ */
 static DSD_THREAD_RETURN_TYPE
 #if DSD_PLATFORM_WIN_NATIVE
     __stdcall
@@ -45,26 +72,29 @@ static DSD_THREAD_RETURN_TYPE
     p25_sm_watchdog_thread(void* arg) {
     (void)arg;
     while (atomic_load(&g_p25_sm_wd_running) && !exitflag) {
-        if (g_opts && g_state && g_opts->p25_trunk == 1) {
-            p25_sm_try_tick(g_opts, g_state);
-        }
-        // Compute watchdog cadence. Prefer env override when provided;
-        // otherwise, tick faster under ncurses to reduce perceived wedges.
-        int ms = g_p25_sm_wd_ms;
-        if (ms <= 0) {
-            ms = (g_opts && g_opts->use_ncurses_terminal == 1) ? 200 : 400; // 200ms UI, 400ms headless
-        }
-        if (ms < 20) {
-            ms = 20; // clamp to sane bounds
-        }
-        if (ms > 2000) {
-            ms = 2000; // 2s max
+        int ms = p25_sm_watchdog_interval_ms();
+        double due_s = 0.0;
+        if (g_opts && g_state && g_opts->p25_trunk == 1
+            && dsd_trunk_timer_pending(g_state, DSD_TRUNK_TIMER_P25_SM, &due_s)
+            && dsd_time_now_monotonic_s() - due_s >= (double)ms / 1000.0) {
+            atomic_store(&g_p25_sm_stall_posted, 1);
         }
         dsd_sleep_ms((unsigned int)ms);
     }
     DSD_THREAD_RETURN;
 }
 
+/* Input wait pump (decoder thread): run the timer jobs a posted stall found overdue. */
+static void
+p25_sm_watchdog_service(void) {
+    if (!atomic_exchange(&g_p25_sm_stall_posted, 0)) {
+        return;
+    }
+    if (g_opts && g_state) {
+        dsd_trunk_timers_run(g_opts, g_state);
+    }
+}
+
 void
 p25_sm_watchdog_start(dsd_opts* opts, dsd_state* state) {
     if (!opts || !state) {
@@ -82,6 +112,8 @@ p25_sm_watchdog_start(dsd_opts* opts, dsd_state* state) {
     }
     int expected = 0;
     if (atomic_compare_exchange_strong(&g_p25_sm_wd_running, &expected, 1)) {
+        atomic_store(&g_p25_sm_stall_posted, 0);
+        dsd_runtime_set_input_wait_pump(p25_sm_watchdog_service);
         (void)dsd_thread_create(&g_p25_sm_wd_thread, p25_sm_watchdog_thread, NULL);
     }
 }
@@ -91,6 +123,7 @@ p25_sm_watchdog_stop(void) {
     int was = atomic_exchange(&g_p25_sm_wd_running, 0);
     if (was != 0) {
         dsd_thread_join(g_p25_sm_wd_thread);
+        dsd_runtime_set_input_wait_pump(NULL);
     }
 }
 
@@ -203,7 +203,7 @@ p25_test_frequency_for(int iden, int type, int tdma, long base, int spac, int ch
     state->p25_base_freq[iden] = base;
     if (map_override > 0) {
         uint16_t c = (uint16_t)chan16;
-        state->trunk_chan_map[c] = map_override;
+        dsd_chan_map_set(&state->trunk_chan_map, c, map_override);
     }
     long f = process_channel_to_freq(opts, state, chan16);
     if (out_freq) {
@@ -14,12 +14,15 @@
 #include <dsd-neo/protocol/p25/p25_cc_candidates.h>
 #include <dsd-neo/protocol/p25/p25_frequency.h>
 #include <dsd-neo/protocol/p25/p25_sm_ui.h>
+#include <dsd-neo/protocol/p25/p25_sm_watchdog.h>
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
 #include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #include <dsd-neo/runtime/p25_optional_hooks.h>
 #include <dsd-neo/runtime/p25_p2_audio_ring.h>
 #include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
 #include <dsd-neo/runtime/trunk_cc_candidates.h>
+#include <dsd-neo/runtime/trunk_timers.h>
 #include <dsd-neo/runtime/trunk_tuning_hooks.h>
 
 #include <stdio.h>
@@ -33,8 +36,8 @@
 // Forward declaration for do_release (used by handle_enc)
 static void do_release(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state, const char* reason);
 
-// Serialize release-to-CC operations to avoid duplicate retunes when multiple
-// threads (watchdog tick + decoder) request release concurrently.
+// Serialize release-to-CC operations to avoid duplicate retunes when a release
+// re-enters through a nested decoder loop during another release.
 static atomic_int g_p25_sm_release_lock = 0;
 
 static inline double
@@ -164,9 +167,6 @@ tg_is_blocked(const dsd_state* state, int tg) {
     return 0;
 }
 
-// External filter check function provided by dsd_flutter
-extern int dsd_flutter_should_follow_tg(int tg);
-
 static int
 grant_allowed(dsd_opts* opts, dsd_state* state, const p25_sm_event_t* ev) {
     if (!opts || !state || !ev) {
@@ -177,8 +177,8 @@ grant_allowed(dsd_opts* opts, dsd_state* state, const p25_sm_event_t* ev) {
     int tg = ev->tg;
     int is_indiv = !ev->is_group;
 
-    // Check talkgroup filter - skip voice channel if filtered (blacklist mode)
-    if (!is_indiv && dsd_flutter_should_follow_tg(tg) == 0) {
+    // Talkgroup filter snapshot: don't tune voice for filtered group calls
+    if (!is_indiv && !dsd_tg_filter_allows(tg)) {
         sm_log(opts, state, "grant-blocked-filter");
         return 0;
     }
@@ -524,7 +524,7 @@ handle_enc(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state, const p25_sm_eve
     // Check if opposite slot is active - only release if both slots are quiet
     int other = slot ^ 1;
     int other_active = ctx->slots[other].voice_active || state->p25_p2_audio_allowed[other]
-                       || (state->p25_p2_audio_ring_count[other] > 0);
+                       || (p25_p2_audio_ring_count(state, other) > 0);
 
     if (!other_active) {
         do_release(ctx, opts, state, "enc-lockout");
@@ -543,8 +543,8 @@ do_release(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state, const char* reas
         return;
     }
 
-    // Avoid double-return-to-CC thrash if multiple callers attempt to release at
-    // nearly the same time (e.g., explicit call termination + watchdog tick).
+    // Avoid double-return-to-CC thrash if a second release arrives while one is
+    // in progress (e.g., explicit call termination during a timer-driven release).
     int expected = 0;
     if (!atomic_compare_exchange_strong(&g_p25_sm_release_lock, &expected, 1)) {
         return;
@@ -698,6 +698,86 @@ try_next_cc(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state, double now_m) {
     // No candidates - stay in HUNTING and wait for CC_SYNC
 }
 
+/* ============================================================================
+ * Deadline Scheduling
+ * ============================================================================ */
+
+// CC candidate evaluation window: no CC activity within this long => cooldown
+#define CC_EVAL_WINDOW_S 3.0
+
+// Hangtime, extended when P25p1 voice error is elevated to reduce VC<->CC thrash
+static double
+effective_hangtime_s(const p25_sm_ctx_t* ctx, const dsd_state* state) {
+    double hangtime = ctx->config.hangtime_s;
+    if (!state || hangtime <= 0.0) {
+        return hangtime;
+    }
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    double thr_pct = (cfg && cfg->p25p1_err_hold_pct_is_set) ? cfg->p25p1_err_hold_pct : 0.0;
+    double add_s = (cfg && cfg->p25p1_err_hold_s_is_set) ? cfg->p25p1_err_hold_s : 0.0;
+    if (thr_pct > 0.0 && add_s > 0.0 && state->p25_p1_voice_err_hist_len > 0) {
+        double avg = (double)state->p25_p1_voice_err_hist_sum / (double)state->p25_p1_voice_err_hist_len;
+        if (avg >= thr_pct) {
+            return hangtime + add_s;
+        }
+    }
+    return hangtime;
+}
+
+static void
+sm_timer_fire(dsd_opts* opts, dsd_state* state) {
+    p25_sm_try_tick(opts, state);
+}
+
+static void
+earliest(double* due, double t) {
+    if (t > 0.0 && (*due <= 0.0 || t < *due)) {
+        *due = t;
+    }
+}
+
+// Arm the SM timer for the next moment tick() would act without a new event.
+// Only the global context is driven by the timer.
+static void
+arm_sm_deadline(p25_sm_ctx_t* ctx, dsd_state* state) {
+    if (!state || ctx != p25_sm_get_ctx()) {
+        return;
+    }
+    double due = 0.0;
+    switch (ctx->state) {
+        case P25_SM_ON_CC: {
+            double cc_ts = ctx->t_cc_sync_m;
+            if (state->last_cc_sync_time_m > 0.0 && state->last_cc_sync_time_m < cc_ts) {
+                cc_ts = state->last_cc_sync_time_m;
+            }
+            if (cc_ts > 0.0) {
+                earliest(&due, cc_ts + ctx->config.cc_grace_s + 0.01);
+            }
+            if (state->p25_cc_eval_freq != 0 && state->p25_cc_eval_start_m > 0.0) {
+                earliest(&due, state->p25_cc_eval_start_m + CC_EVAL_WINDOW_S);
+            }
+            break;
+        }
+        case P25_SM_TUNED:
+            if (ctx->slots[0].voice_active || ctx->slots[1].voice_active) {
+                break; // voice end arrives as an event
+            }
+            if (ctx->t_voice_m > 0.0) {
+                earliest(&due, ctx->t_voice_m + effective_hangtime_s(ctx, state));
+            } else if (ctx->t_tune_m > 0.0) {
+                earliest(&due, ctx->t_tune_m + ctx->config.grant_timeout_s);
+            }
+            break;
+        case P25_SM_HUNTING: earliest(&due, ctx->t_hunt_try_m + CC_HUNT_INTERVAL_S); break;
+        default: break;
+    }
+    if (due > 0.0) {
+        dsd_trunk_timer_arm(state, DSD_TRUNK_TIMER_P25_SM, due, sm_timer_fire);
+    } else {
+        dsd_trunk_timer_cancel(state, DSD_TRUNK_TIMER_P25_SM);
+    }
+}
+
 /* ============================================================================
  * Public API - Core State Machine
  * ============================================================================ */
@@ -817,6 +897,8 @@ p25_sm_event(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state, const p25_sm_e
 
         case P25_SM_EV_ENC: handle_enc(ctx, opts, state, ev); break;
     }
+
+    arm_sm_deadline(ctx, state);
 }
 
 void
@@ -836,11 +918,11 @@ p25_sm_tick_ctx(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state) {
         if (ctx->state == P25_SM_TUNED) {
             do_release(ctx, opts, state, "release-forced");
         }
+        arm_sm_deadline(ctx, state);
         return;
     }
 
     double now_m = now_monotonic();
-    double hangtime = ctx->config.hangtime_s;
     double grant_timeout = ctx->config.grant_timeout_s;
     double cc_grace = ctx->config.cc_grace_s;
 
@@ -858,7 +940,7 @@ p25_sm_tick_ctx(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state) {
             // and no CC activity appeared within the eval window, penalize
             if (state && state->p25_cc_eval_freq != 0) {
                 double eval_dt = (state->p25_cc_eval_start_m > 0.0) ? (now_m - state->p25_cc_eval_start_m) : 0.0;
-                double eval_window_s = 3.0;
+                double eval_window_s = CC_EVAL_WINDOW_S;
                 if (eval_dt >= eval_window_s) {
                     double cc_ts = ctx->t_cc_sync_m;
                     if (state->last_cc_sync_time_m > 0.0 && state->last_cc_sync_time_m < cc_ts) {
@@ -915,20 +997,7 @@ p25_sm_tick_ctx(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state) {
             } else if (ctx->t_voice_m > 0.0) {
                 // Voice was active before, now in hangtime
                 double dt_voice = now_m - ctx->t_voice_m;
-                double effective_hangtime = hangtime;
-                /* Optional: extend hangtime when P25p1 voice error is elevated to reduce VC↔CC thrash. */
-                if (state && hangtime > 0.0) {
-                    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-                    double thr_pct = (cfg && cfg->p25p1_err_hold_pct_is_set) ? cfg->p25p1_err_hold_pct : 0.0;
-                    double add_s = (cfg && cfg->p25p1_err_hold_s_is_set) ? cfg->p25p1_err_hold_s : 0.0;
-                    if (thr_pct > 0.0 && add_s > 0.0 && state->p25_p1_voice_err_hist_len > 0) {
-                        double avg =
-                            (double)state->p25_p1_voice_err_hist_sum / (double)state->p25_p1_voice_err_hist_len;
-                        if (avg >= thr_pct) {
-                            effective_hangtime = hangtime + add_s;
-                        }
-                    }
-                }
+                double effective_hangtime = effective_hangtime_s(ctx, state);
                 if (dt_voice >= effective_hangtime) {
                     // Hangtime expired - release
                     do_release(ctx, opts, state, "hangtime-expired");
@@ -955,12 +1024,7 @@ p25_sm_tick_ctx(p25_sm_ctx_t* ctx, dsd_opts* opts, dsd_state* state) {
             break;
     }
 
-    // Age affiliation/neighbor tables (1 Hz)
-    if (state) {
-        p25_aff_tick(state);
-        p25_ga_tick(state);
-        p25_nb_tick(state);
-    }
+    arm_sm_deadline(ctx, state);
 }
 
 /* ============================================================================
@@ -992,30 +1056,35 @@ void
 p25_sm_emit_ptt(dsd_opts* opts, dsd_state* state, int slot) {
     p25_sm_event_t ev = p25_sm_ev_ptt(slot);
     p25_sm_event(p25_sm_get_ctx(), opts, state, &ev);
+    dsd_decoder_events_call(state, slot, 1);
 }
 
 void
 p25_sm_emit_active(dsd_opts* opts, dsd_state* state, int slot) {
     p25_sm_event_t ev = p25_sm_ev_active(slot);
     p25_sm_event(p25_sm_get_ctx(), opts, state, &ev);
+    dsd_decoder_events_call(state, slot, 1);
 }
 
 void
 p25_sm_emit_end(dsd_opts* opts, dsd_state* state, int slot) {
     p25_sm_event_t ev = p25_sm_ev_end(slot);
     p25_sm_event(p25_sm_get_ctx(), opts, state, &ev);
+    dsd_decoder_events_call(state, slot, 0);
 }
 
 void
 p25_sm_emit_idle(dsd_opts* opts, dsd_state* state, int slot) {
     p25_sm_event_t ev = p25_sm_ev_idle(slot);
     p25_sm_event(p25_sm_get_ctx(), opts, state, &ev);
+    dsd_decoder_events_call(state, slot, 0);
 }
 
 void
 p25_sm_emit_tdu(dsd_opts* opts, dsd_state* state) {
     p25_sm_event_t ev = p25_sm_ev_tdu();
     p25_sm_event(p25_sm_get_ctx(), opts, state, &ev);
+    dsd_decoder_events_call(state, 0, 0);
 }
 
 void
@@ -1155,30 +1224,27 @@ p25_emit_enc_lockout_once(dsd_opts* opts, dsd_state* state, uint8_t slot, int tg
 
 #define P25_AFF_TTL_SEC ((time_t)15 * 60)
 
-static int
-p25_aff_find_idx(const dsd_state* state, uint32_t rid) {
-    if (!state || rid == 0) {
-        return -1;
+// Arm `id` for when the least recently seen entry of `reg` outlives `ttl`.
+static void
+arm_registry_expiry(dsd_state* state, dsd_trunk_timer_id id, const dsd_unit_registry* reg, time_t ttl,
+                    dsd_trunk_timer_fn fn) {
+    time_t oldest = dsd_unit_registry_oldest_seen(reg);
+    if (oldest == 0) {
+        dsd_trunk_timer_cancel(state, id);
+        return;
     }
-    for (int i = 0; i < 256; i++) {
-        if (state->p25_aff_rid[i] == rid) {
-            return i;
-        }
+    double wait_s = (double)(oldest + ttl - time(NULL)) + 1.0;
+    if (wait_s < 0.0) {
+        wait_s = 0.0;
     }
-    return -1;
+    dsd_trunk_timer_arm(state, id, now_monotonic() + wait_s, fn);
 }
 
-static int
-p25_aff_find_free(const dsd_state* state) {
-    if (!state) {
-        return -1;
-    }
-    for (int i = 0; i < 256; i++) {
-        if (state->p25_aff_rid[i] == 0) {
-            return i;
-        }
-    }
-    return -1;
+static void
+aff_expire_fire(dsd_opts* opts, dsd_state* state) {
+    (void)opts;
+    p25_aff_tick(state);
+    arm_registry_expiry(state, DSD_TRUNK_TIMER_P25_AFF, &state->p25_aff, P25_AFF_TTL_SEC, aff_expire_fire);
 }
 
 void
@@ -1186,25 +1252,11 @@ p25_aff_register(dsd_state* state, uint32_t rid) {
     if (!state || rid == 0) {
         return;
     }
-    int idx = p25_aff_find_idx(state, rid);
-    if (idx < 0) {
-        idx = p25_aff_find_free(state);
-        if (idx < 0) {
-            time_t oldest = state->p25_aff_last_seen[0];
-            int old_idx = 0;
-            for (int i = 1; i < 256; i++) {
-                if (state->p25_aff_last_seen[i] < oldest) {
-                    oldest = state->p25_aff_last_seen[i];
-                    old_idx = i;
-                }
-            }
-            idx = old_idx;
-        } else {
-            state->p25_aff_count++;
-        }
-        state->p25_aff_rid[idx] = rid;
+    dsd_unit_registry_touch(&state->p25_aff, rid, 0, time(NULL));
+    if (!dsd_trunk_timer_pending(state, DSD_TRUNK_TIMER_P25_AFF, NULL)) {
+        arm_registry_expiry(state, DSD_TRUNK_TIMER_P25_AFF, &state->p25_aff, P25_AFF_TTL_SEC, aff_expire_fire);
     }
-    state->p25_aff_last_seen[idx] = time(NULL);
+    dsd_decoder_events_table(state, DSD_EVENT_AFFILIATION);
 }
 
 void
@@ -1212,13 +1264,8 @@ p25_aff_deregister(dsd_state* state, uint32_t rid) {
     if (!state || rid == 0) {
         return;
     }
-    int idx = p25_aff_find_idx(state, rid);
-    if (idx >= 0) {
-        state->p25_aff_rid[idx] = 0;
-        state->p25_aff_last_seen[idx] = 0;
-        if (state->p25_aff_count > 0) {
-            state->p25_aff_count--;
-        }
+    if (dsd_unit_registry_remove(&state->p25_aff, rid, 0)) {
+        dsd_decoder_events_table(state, DSD_EVENT_AFFILIATION);
     }
 }
 
@@ -1227,18 +1274,8 @@ p25_aff_tick(dsd_state* state) {
     if (!state) {
         return;
     }
-    time_t now = time(NULL);
-    for (int i = 0; i < 256; i++) {
-        if (state->p25_aff_rid[i] != 0) {
-            time_t last = state->p25_aff_last_seen[i];
-            if (last != 0 && (now - last) > P25_AFF_TTL_SEC) {
-                state->p25_aff_rid[i] = 0;
-                state->p25_aff_last_seen[i] = 0;
-                if (state->p25_aff_count > 0) {
-                    state->p25_aff_count--;
-                }
-            }
-        }
+    if (dsd_unit_registry_expire(&state->p25_aff, time(NULL), P25_AFF_TTL_SEC) > 0) {
+        dsd_decoder_events_table(state, DSD_EVENT_AFFILIATION);
     }
 }
 
@@ -1248,30 +1285,11 @@ p25_aff_tick(dsd_state* state) {
 
 #define P25_GA_TTL_SEC ((time_t)30 * 60)
 
-static int
-p25_ga_find_idx(const dsd_state* state, uint32_t rid, uint16_t tg) {
-    if (!state || rid == 0 || tg == 0) {
-        return -1;
-    }
-    for (int i = 0; i < 512; i++) {
-        if (state->p25_ga_rid[i] == rid && state->p25_ga_tg[i] == tg) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-static int
-p25_ga_find_free(const dsd_state* state) {
-    if (!state) {
-        return -1;
-    }
-    for (int i = 0; i < 512; i++) {
-        if (state->p25_ga_rid[i] == 0 || state->p25_ga_tg[i] == 0) {
-            return i;
-        }
-    }
-    return -1;
+static void
+ga_expire_fire(dsd_opts* opts, dsd_state* state) {
+    (void)opts;
+    p25_ga_tick(state);
+    arm_registry_expiry(state, DSD_TRUNK_TIMER_P25_GA, &state->p25_ga, P25_GA_TTL_SEC, ga_expire_fire);
 }
 
 void
@@ -1279,26 +1297,11 @@ p25_ga_add(dsd_state* state, uint32_t rid, uint16_t tg) {
     if (!state || rid == 0 || tg == 0) {
         return;
     }
-    int idx = p25_ga_find_idx(state, rid, tg);
-    if (idx < 0) {
-        idx = p25_ga_find_free(state);
-        if (idx < 0) {
-            time_t oldest = state->p25_ga_last_seen[0];
-            int old_idx = 0;
-            for (int i = 1; i < 512; i++) {
-                if (state->p25_ga_last_seen[i] < oldest) {
-                    oldest = state->p25_ga_last_seen[i];
-                    old_idx = i;
-                }
-            }
-            idx = old_idx;
-        } else {
-            state->p25_ga_count++;
-        }
-        state->p25_ga_rid[idx] = rid;
-        state->p25_ga_tg[idx] = tg;
+    dsd_unit_registry_touch(&state->p25_ga, rid, tg, time(NULL));
+    if (!dsd_trunk_timer_pending(state, DSD_TRUNK_TIMER_P25_GA, NULL)) {
+        arm_registry_expiry(state, DSD_TRUNK_TIMER_P25_GA, &state->p25_ga, P25_GA_TTL_SEC, ga_expire_fire);
     }
-    state->p25_ga_last_seen[idx] = time(NULL);
+    dsd_decoder_events_table(state, DSD_EVENT_GROUP_ATTACH);
 }
 
 void
@@ -1306,14 +1309,8 @@ p25_ga_remove(dsd_state* state, uint32_t rid, uint16_t tg) {
     if (!state || rid == 0 || tg == 0) {
         return;
     }
-    int idx = p25_ga_find_idx(state, rid, tg);
-    if (idx >= 0) {
-        state->p25_ga_rid[idx] = 0;
-        state->p25_ga_tg[idx] = 0;
-        state->p25_ga_last_seen[idx] = 0;
-        if (state->p25_ga_count > 0) {
-            state->p25_ga_count--;
-        }
+    if (dsd_unit_registry_remove(&state->p25_ga, rid, tg)) {
+        dsd_decoder_events_table(state, DSD_EVENT_GROUP_ATTACH);
     }
 }
 
@@ -1322,18 +1319,7 @@ p25_ga_tick(dsd_state* state) {
     if (!state) {
         return;
     }
-    time_t now = time(NULL);
-    for (int i = 0; i < 512; i++) {
-        if (state->p25_ga_rid[i] != 0 && state->p25_ga_tg[i] != 0) {
-            time_t last = state->p25_ga_last_seen[i];
-            if (last != 0 && (now - last) > P25_GA_TTL_SEC) {
-                state->p25_ga_rid[i] = 0;
-                state->p25_ga_tg[i] = 0;
-                state->p25_ga_last_seen[i] = 0;
-                if (state->p25_ga_count > 0) {
-                    state->p25_ga_count--;
-                }
-            }
-        }
+    if (dsd_unit_registry_expire(&state->p25_ga, time(NULL), P25_GA_TTL_SEC) > 0) {
+        dsd_decoder_events_table(state, DSD_EVENT_GROUP_ATTACH);
     }
 }
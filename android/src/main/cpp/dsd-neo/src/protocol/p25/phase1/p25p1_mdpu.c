@@ -14,6 +14,7 @@
 #include <dsd-neo/core/dibit.h>
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
+#include <dsd-neo/fec/crc.h>
 #include <dsd-neo/protocol/dmr/dmr_utils_api.h>
 #include <dsd-neo/protocol/p25/p25_12.h>
 #include <dsd-neo/protocol/p25/p25_crc.h>
@@ -21,6 +22,7 @@
 #include <dsd-neo/protocol/p25/p25p1_mbf34.h>
 #include <dsd-neo/protocol/p25/p25p1_pdu_trunking.h>
 #include <dsd-neo/runtime/colors.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #ifdef USE_RTLSDR
 #include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
 #endif
@@ -29,19 +31,10 @@
 #include <string.h>
 #include <time.h>
 
+//CRC-32 over len bits of MSB-first packed bytes, inverted
 uint32_t
 crc32mbf(uint8_t* buf, int len) {
-    uint32_t g = 0x04c11db7;
-    uint64_t crc = 0;
-    for (int i = 0; i < len; i++) {
-        crc <<= 1;
-        int b = (buf[i / 8] >> (7 - (i % 8))) & 1;
-        if (((crc >> 32) ^ b) & 1) {
-            crc ^= g;
-        }
-    }
-    crc = (crc & 0xffffffff) ^ 0xffffffff;
-    return crc;
+    return dsd_crc_packed_bits(dsd_crc_get(DSD_CRC32_CKSUM), buf, len > 0 ? (size_t)len : 0);
 }
 
 void
@@ -299,6 +292,7 @@ processMPDU(dsd_opts* opts, dsd_state* state) {
             dsd_rtl_stream_metrics_hook_p25p1_ber_update(0, 1);
 #endif
         }
+        dsd_decoder_events_signal(state);
     }
 
     if (err[0] == 0 || opts->aggressive_framesync == 0) {
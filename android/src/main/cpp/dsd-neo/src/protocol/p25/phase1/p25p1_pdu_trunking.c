@@ -20,6 +20,7 @@
 #include <dsd-neo/protocol/p25/p25_vpdu.h>
 #include <dsd-neo/protocol/p25/p25p1_pdu_trunking.h>
 #include <dsd-neo/runtime/colors.h>
+#include <dsd-neo/runtime/decoder_events.h>
 
 #include <stdio.h>
 #include <string.h>
@@ -129,6 +130,7 @@ p25_decode_pdu_trunking(dsd_opts* opts, dsd_state* state, uint8_t* mpdu_byte) {
                     state->p2_sysid = sysid;
                 }
             }
+            dsd_decoder_events_site(state);
 
             long neigh[2] = {ct_freq, cr_freq};
             p25_sm_on_neighbor_update(opts, state, neigh, 2);
@@ -160,6 +162,7 @@ p25_decode_pdu_trunking(dsd_opts* opts, dsd_state* state, uint8_t* mpdu_byte) {
 
         state->p2_siteid = siteid;
         state->p2_rfssid = rfssid;
+        dsd_decoder_events_site(state);
         p25_confirm_idens_for_current_site(state);
     }
 
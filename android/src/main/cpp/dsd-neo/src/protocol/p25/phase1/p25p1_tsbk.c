@@ -26,6 +26,7 @@
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
 #include <dsd-neo/protocol/p25/p25_vpdu.h>
 #include <dsd-neo/runtime/colors.h>
+#include <dsd-neo/runtime/decoder_events.h>
 
 #include <stdio.h>
 #include <string.h>
@@ -192,6 +193,7 @@ processTSBK(dsd_opts* opts, dsd_state* state) {
         dsd_rtl_stream_metrics_hook_p25p1_ber_update(0, 1);
 #endif
     }
+    dsd_decoder_events_signal(state);
 
     // Basic field extraction
     MFID = tsbk_byte[1];
@@ -393,6 +395,7 @@ processTSBK(dsd_opts* opts, dsd_state* state) {
             state->p2_wacn = wacn;
             state->p2_sysid = sysid;
         }
+        dsd_decoder_events_site(state);
         p25_confirm_idens_for_current_site(state);
     }
 
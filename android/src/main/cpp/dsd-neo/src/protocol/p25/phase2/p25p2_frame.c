@@ -165,10 +165,7 @@ int ess_b[2][96] = {0};  //96 bits for 4 - 24 bit ESS_B fields starting bit 168
 int ess_a[2][168] = {0}; //ESS_A 1 (96 bit) and 2 (72 bit) fields, starting at bit 168 and bit 266 (RS Parity)
 
 int facch[2][156] = {0};
-int facch_rs[2][114] = {0};
-
 int sacch[2][180] = {0};
-int sacch_rs[2][132] = {0};
 
 // Reset all P25P2 frame processing global state variables.
 // This must be called when tuning to a new P25P2 voice channel to clear stale
@@ -205,9 +202,7 @@ p25_p2_frame_reset(void) {
 
     // Reset FACCH/SACCH buffers
     memset(facch, 0, sizeof(facch));
-    memset(facch_rs, 0, sizeof(facch_rs));
     memset(sacch, 0, sizeof(sacch));
-    memset(sacch_rs, 0, sizeof(sacch_rs));
 
     // Reset AMBE frame buffers
     memset(ambe_fr1, 0, sizeof(ambe_fr1));
@@ -292,14 +287,12 @@ process_FACCHc(dsd_opts* opts, dsd_state* state) {
     for (int i = 0; i < 22; i++) {
         facch[state->currentslot][i + 134] = p2bit[i + 180 + (ts_counter * 360)];
     }
-    //gather FACCH RS parity bits
-    for (int i = 0; i < 42; i++) {
-        facch_rs[state->currentslot][i] = p2bit[i + 202 + (ts_counter * 360)];
-    }
-    //skip DUID 3
-    for (int i = 0; i < 72; i++) {
-        facch_rs[state->currentslot][i + 42] = p2bit[i + 246 + (ts_counter * 360)];
-    }
+    //gather FACCH RS parity straight into hexbits (7 + 12), skipping DUID 3
+    uint8_t hb[26];
+    uint8_t hb_rs[19];
+    ez_bits_to_hexbits(p2bit + 202 + (ts_counter * 360), hb_rs, 7);
+    ez_bits_to_hexbits(p2bit + 246 + (ts_counter * 360), hb_rs + 7, 12);
+    ez_bits_to_hexbits(facch[state->currentslot], hb, 26);
 
     //send payload and parity to ez_rs28_facch for error correction (RS(63,35), t=14)
     int ec = -2;
@@ -308,13 +301,14 @@ process_FACCHc(dsd_opts* opts, dsd_state* state) {
         /* Use soft-decision erasures */
         int erasures[28] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 54, 55, 56, 57, 58, 59, 60, 61, 62};
         int n_erasures = p25p2_facch_soft_erasures(ts_counter, 0, erasures, 18, 10);
-        ec = ez_rs28_facch_soft(facch[state->currentslot], facch_rs[state->currentslot], erasures, n_erasures);
+        ec = ez_rs28_facch_hb(hb, hb_rs, erasures, n_erasures);
         if (ec >= 0) {
             state->p25_p2_soft_erasure_ok++;
         }
     } else {
-        ec = ez_rs28_facch(facch[state->currentslot], facch_rs[state->currentslot]);
+        ec = ez_rs28_facch_hb(hb, hb_rs, NULL, 0);
     }
+    ez_hexbits_to_bits(hb, facch[state->currentslot], 26);
 
     int opcode = 0;
     opcode =
@@ -358,14 +352,12 @@ process_FACCHs(dsd_opts* opts, dsd_state* state) {
     for (int i = 0; i < 22; i++) {
         facch[state->currentslot][i + 134] = p2xbit[i + 180 + (ts_counter * 360)];
     }
-    //gather FACCh RS parity bits
-    for (int i = 0; i < 42; i++) {
-        facch_rs[state->currentslot][i] = p2xbit[i + 202 + (ts_counter * 360)];
-    }
-    //skip DUID 3
-    for (int i = 0; i < 72; i++) {
-        facch_rs[state->currentslot][i + 42] = p2xbit[i + 246 + (ts_counter * 360)];
-    }
+    //gather FACCH RS parity straight into hexbits (7 + 12), skipping DUID 3
+    uint8_t hb[26];
+    uint8_t hb_rs[19];
+    ez_bits_to_hexbits(p2xbit + 202 + (ts_counter * 360), hb_rs, 7);
+    ez_bits_to_hexbits(p2xbit + 246 + (ts_counter * 360), hb_rs + 7, 12);
+    ez_bits_to_hexbits(facch[state->currentslot], hb, 26);
 
     //send payload and parity to ez_rs28_facch for error correction (RS(63,35), t=14)
     int ec = -2;
@@ -374,13 +366,14 @@ process_FACCHs(dsd_opts* opts, dsd_state* state) {
         /* Use soft-decision erasures (scrambled buffer) */
         int erasures[28] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 54, 55, 56, 57, 58, 59, 60, 61, 62};
         int n_erasures = p25p2_facch_soft_erasures(ts_counter, 1, erasures, 18, 10);
-        ec = ez_rs28_facch_soft(facch[state->currentslot], facch_rs[state->currentslot], erasures, n_erasures);
+        ec = ez_rs28_facch_hb(hb, hb_rs, erasures, n_erasures);
         if (ec >= 0) {
             state->p25_p2_soft_erasure_ok++;
         }
     } else {
-        ec = ez_rs28_facch(facch[state->currentslot], facch_rs[state->currentslot]);
+        ec = ez_rs28_facch_hb(hb, hb_rs, NULL, 0);
     }
+    ez_hexbits_to_bits(hb, facch[state->currentslot], 26);
 
     int opcode = 0;
     opcode =
@@ -420,14 +413,12 @@ process_SACCHc(dsd_opts* opts, dsd_state* state) {
     for (int i = 0; i < 108; i++) {
         sacch[state->currentslot][i + 72] = p2bit[i + 76 + (ts_counter * 360)];
     }
-    //start collecting parity
-    for (int i = 0; i < 60; i++) {
-        sacch_rs[state->currentslot][i] = p2bit[i + 184 + (ts_counter * 360)];
-    }
-    //skip DUID 3
-    for (int i = 0; i < 72; i++) {
-        sacch_rs[state->currentslot][i + 60] = p2bit[i + 246 + (ts_counter * 360)];
-    }
+    //gather SACCH RS parity straight into hexbits (10 + 12), skipping DUID 3
+    uint8_t hb[30];
+    uint8_t hb_rs[22];
+    ez_bits_to_hexbits(p2bit + 184 + (ts_counter * 360), hb_rs, 10);
+    ez_bits_to_hexbits(p2bit + 246 + (ts_counter * 360), hb_rs + 10, 12);
+    ez_bits_to_hexbits(sacch[state->currentslot], hb, 30);
 
     //send payload and parity to ez_rs28_sacch for error correction (RS(63,35), t=14)
     int ec = -2;
@@ -436,13 +427,14 @@ process_SACCHc(dsd_opts* opts, dsd_state* state) {
         /* Use soft-decision erasures */
         int erasures[28] = {0, 1, 2, 3, 4, 57, 58, 59, 60, 61, 62};
         int n_erasures = p25p2_sacch_soft_erasures(ts_counter, 0, erasures, 11, 16);
-        ec = ez_rs28_sacch_soft(sacch[0], sacch_rs[0], erasures, n_erasures);
+        ec = ez_rs28_sacch_hb(hb, hb_rs, erasures, n_erasures);
         if (ec >= 0) {
             state->p25_p2_soft_erasure_ok++;
         }
     } else {
-        ec = ez_rs28_sacch(sacch[0], sacch_rs[0]);
+        ec = ez_rs28_sacch_hb(hb, hb_rs, NULL, 0);
     }
+    ez_hexbits_to_bits(hb, sacch[state->currentslot], 30);
 
     int opcode = 0;
     opcode =
@@ -483,14 +475,12 @@ process_SACCHs(dsd_opts* opts, dsd_state* state) {
     for (int i = 0; i < 108; i++) {
         sacch[state->currentslot][i + 72] = p2xbit[i + 76 + (ts_counter * 360)];
     }
-    //start collecting parity
-    for (int i = 0; i < 60; i++) {
-        sacch_rs[state->currentslot][i] = p2xbit[i + 184 + (ts_counter * 360)];
-    }
-    //skip DUID 3
-    for (int i = 0; i < 72; i++) {
-        sacch_rs[state->currentslot][i + 60] = p2xbit[i + 246 + (ts_counter * 360)];
-    }
+    //gather SACCH RS parity straight into hexbits (10 + 12), skipping DUID 3
+    uint8_t hb[30];
+    uint8_t hb_rs[22];
+    ez_bits_to_hexbits(p2xbit + 184 + (ts_counter * 360), hb_rs, 10);
+    ez_bits_to_hexbits(p2xbit + 246 + (ts_counter * 360), hb_rs + 10, 12);
+    ez_bits_to_hexbits(sacch[state->currentslot], hb, 30);
 
     //send payload and parity to ez_rs28_sacch for error correction (RS(63,35), t=14)
     int ec = -2;
@@ -499,13 +489,14 @@ process_SACCHs(dsd_opts* opts, dsd_state* state) {
         /* Use soft-decision erasures (scrambled buffer) */
         int erasures[28] = {0, 1, 2, 3, 4, 57, 58, 59, 60, 61, 62};
         int n_erasures = p25p2_sacch_soft_erasures(ts_counter, 1, erasures, 11, 16);
-        ec = ez_rs28_sacch_soft(sacch[0], sacch_rs[0], erasures, n_erasures);
+        ec = ez_rs28_sacch_hb(hb, hb_rs, erasures, n_erasures);
         if (ec >= 0) {
             state->p25_p2_soft_erasure_ok++;
         }
     } else {
-        ec = ez_rs28_sacch(sacch[0], sacch_rs[0]);
+        ec = ez_rs28_sacch_hb(hb, hb_rs, NULL, 0);
     }
+    ez_hexbits_to_bits(hb, sacch[state->currentslot], 30);
 
     int opcode = 0;
     opcode =
@@ -766,29 +757,21 @@ process_ESS(dsd_opts* opts, dsd_state* state) {
     //collect and process ESS info (MI, Key ID, Alg ID)
     //hand over to (RS 44,16,29) decoder to receive ESS values
 
-    int payload[96] = {0}; //local storage for ESS_A and ESS_B arrays
-    for (int i = 0; i < 96; i++) {
-        payload[i] = state->ess_b[state->currentslot][i];
-    }
-
-    int parity[168] = {0};
-    for (int i = 0; i < 168; i++) {
-        parity[i] = ess_a[state->currentslot][i];
-    }
+    //convert ESS_B (payload) and ESS_A (parity) to hexbits once; keep a pristine copy for the soft retry
+    uint8_t hb_b[16];
+    uint8_t hb_a[28];
+    ez_bits_to_hexbits(state->ess_b[state->currentslot], hb_b, 16);
+    ez_bits_to_hexbits(ess_a[state->currentslot], hb_a, 28);
+    uint8_t hb_b0[16];
+    uint8_t hb_a0[28];
+    memcpy(hb_b0, hb_b, sizeof(hb_b0));
+    memcpy(hb_a0, hb_a, sizeof(hb_a0));
 
     int ec = 69;
-    ec = ez_rs28_ess(payload, parity);
+    ec = ez_rs28_ess_hb(hb_b, hb_a, NULL, 0);
 
     /* If hard decode failed and soft-decision is enabled, try with erasures */
     if (ec < 0 && opts->p25_p2_soft_erasure) {
-        /* Reload payload and parity (hard decode may have corrupted them) */
-        for (int i = 0; i < 96; i++) {
-            payload[i] = state->ess_b[state->currentslot][i];
-        }
-        for (int i = 0; i < 168; i++) {
-            parity[i] = ess_a[state->currentslot][i];
-        }
-
         /* Build erasure list from reliability info.
          * ESS_B (payload) is collected across 4V frames, ESS_A (parity) from 2V.
          * Use ts_counter=0 as base since ESS spans multiple frames.
@@ -798,13 +781,19 @@ process_ESS(dsd_opts* opts, dsd_state* state) {
         n_erasures = p25p2_ess_soft_erasures(0, 0, erasures, n_erasures, 10); /* 2V parity */
 
         if (n_erasures > 0) {
-            ec = ez_rs28_ess_soft(payload, parity, erasures, n_erasures);
+            /* Restart from the received hexbits (hard decode may have corrupted them) */
+            memcpy(hb_b, hb_b0, sizeof(hb_b));
+            memcpy(hb_a, hb_a0, sizeof(hb_a));
+            ec = ez_rs28_ess_hb(hb_b, hb_a, erasures, n_erasures);
             if (ec >= 0) {
                 state->p25_p2_soft_ess_ok++;
             }
         }
     }
 
+    int payload[96];
+    ez_hexbits_to_bits(hb_b, payload, 16);
+
     int algid = 0;
     for (short i = 0; i < 8; i++) {
         algid = algid << 1;
@@ -1002,7 +991,7 @@ process_ESS(dsd_opts* opts, dsd_state* state) {
                 // Consider per-slot gate, ring, and recent MAC_ACTIVE recency on other slot
                 double mac_hold = 0.75; // seconds; env override aligns with SM/xCCH
                 {
-                    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                     if (state->p25_cfg_mac_hold_s > 0.0) {
                         mac_hold = state->p25_cfg_mac_hold_s;
                     } else if (cfg && cfg->p25_mac_hold_is_set) {
@@ -1013,13 +1002,13 @@ process_ESS(dsd_opts* opts, dsd_state* state) {
                 int other_recent = (state->p25_p2_last_mac_active_m[other] > 0.0)
                                    && ((nowm_hold - state->p25_p2_last_mac_active_m[other]) <= mac_hold);
                 int other_audio =
-                    state->p25_p2_audio_allowed[other] || state->p25_p2_audio_ring_count[other] > 0 || other_recent;
+                    state->p25_p2_audio_allowed[other] || p25_p2_audio_ring_count(state, other) > 0 || other_recent;
                 if (!other_audio) {
                     fprintf(stderr, " No Enc Following on P25p2 Trunking; ");
                     // Defer return to CC within VC grace to protect opposite-slot clear calls
                     double vc_grace = (state->p25_cfg_vc_grace_s > 0.0) ? state->p25_cfg_vc_grace_s : 0.75;
                     if (!(state->p25_cfg_vc_grace_s > 0.0)) {
-                        const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                        const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                         if (cfg && cfg->p25_vc_grace_is_set) {
                             vc_grace = cfg->p25_vc_grace_s;
                         }
@@ -1336,7 +1325,7 @@ process_P2_DUID(dsd_opts* opts, dsd_state* state) {
             // bounce back to CC before audio gates open on fresh calls.
             double vc_grace = 0.75; // seconds; override via DSD_NEO_P25_VC_GRACE
             {
-                const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                 if (state->p25_cfg_vc_grace_s > 0.0) {
                     vc_grace = state->p25_cfg_vc_grace_s;
                 } else if (cfg && cfg->p25_vc_grace_is_set) {
@@ -1355,7 +1344,7 @@ process_P2_DUID(dsd_opts* opts, dsd_state* state) {
             // gates are not yet open but valid voice is present.
             double mac_hold = 0.75; // seconds; override via DSD_NEO_P25_MAC_HOLD
             {
-                const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                 if (state->p25_cfg_mac_hold_s > 0.0) {
                     mac_hold = state->p25_cfg_mac_hold_s;
                 } else if (cfg && cfg->p25_mac_hold_is_set) {
@@ -1539,7 +1528,7 @@ process_P2_DUID(dsd_opts* opts, dsd_state* state) {
             (state->p25_last_vc_tune_time != 0) ? (double)(now2 - state->p25_last_vc_tune_time) : 1e9;
         double vc_grace = 0.75; // seconds; override with DSD_NEO_P25_VC_GRACE
         {
-            const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+            const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
             if (state->p25_cfg_vc_grace_s > 0.0) {
                 vc_grace = state->p25_cfg_vc_grace_s;
             } else if (cfg && cfg->p25_vc_grace_is_set) {
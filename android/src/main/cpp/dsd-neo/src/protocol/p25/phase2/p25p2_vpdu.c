@@ -24,6 +24,7 @@
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
 #include <dsd-neo/protocol/p25/p25_vpdu.h>
 #include <dsd-neo/runtime/colors.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/p25_p2_audio_ring.h>
 
@@ -44,7 +45,7 @@ static inline void dsd_append(char* dst, size_t dstsz, const char* src);
 static void
 p25p2_emit_mac_json_if_enabled(dsd_state* state, int xch_type, uint8_t mfid, uint8_t opcode, int slot, int len_b,
                                int len_c, const char* summary) {
-    const dsdneoRuntimeConfig* rc = dsd_neo_get_config();
+    const dsdneoRuntimeConfig* rc = dsd_neo_config_held(state ? state->rt_cfg : NULL);
     if (!rc || !rc->pdu_json_enable) {
         return;
     }
@@ -1619,6 +1620,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
 
             state->p2_siteid = siteid;
             state->p2_rfssid = rfssid;
+            dsd_decoder_events_site(state);
             // Promote any matching IDENs to trusted on site identification
             p25_confirm_idens_for_current_site(state);
         }
@@ -1642,6 +1644,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
 
             state->p2_siteid = siteid;
             state->p2_rfssid = rfssid;
+            dsd_decoder_events_site(state);
             p25_confirm_idens_for_current_site(state);
         }
 
@@ -2017,6 +2020,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
 
             state->p2_siteid = siteid;
             state->p2_rfssid = rfssid;
+            dsd_decoder_events_site(state);
         }
 
         //Secondary Control Channel Broadcast, Implicit
@@ -2046,6 +2050,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
 
             state->p2_siteid = siteid;
             state->p2_rfssid = rfssid;
+            dsd_decoder_events_site(state);
         }
 
         //MFID90 Group Regroup Voice Channel User - Abbreviated
@@ -2338,7 +2343,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
             // Determine if opposite slot is active using P25 gates/jitter and recent MAC_ACTIVE
             double mac_hold = 0.75; // seconds; override via DSD_NEO_P25_MAC_HOLD
             {
-                const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                 if (state && state->p25_cfg_mac_hold_s > 0.0) {
                     mac_hold = state->p25_cfg_mac_hold_s;
                 } else if (cfg && cfg->p25_mac_hold_is_set) {
@@ -2350,7 +2355,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
             int os = eslot ^ 1;
             double voice_hold = 0.75; // seconds; override via DSD_NEO_P25_VOICE_HOLD
             {
-                const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                 if (cfg && cfg->p25_voice_hold_is_set) {
                     voice_hold = cfg->p25_voice_hold_s;
                 }
@@ -2365,14 +2370,14 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                     ? (nowm2 - state->p25_p2_last_mac_active_m[os])
                     : ((state->p25_p2_last_mac_active[os] != 0) ? (noww2 - (double)state->p25_p2_last_mac_active[os])
                                                                 : 1e9);
-            int other_audio = state->p25_p2_audio_allowed[os] || (state->p25_p2_audio_ring_count[os] > 0)
+            int other_audio = state->p25_p2_audio_allowed[os] || (p25_p2_audio_ring_count(state, os) > 0)
                               || (state->p25_p2_last_mac_active[os] != 0 && dt_mac <= mac_hold) || recent_voice;
             if (!other_audio) {
                 // Only force release outside the VC grace window to avoid dropping
                 // an opposite-slot clear call that hasn't opened its gates yet.
                 double vc_grace = (state->p25_cfg_vc_grace_s > 0.0) ? state->p25_cfg_vc_grace_s : 0.75;
                 if (!(state->p25_cfg_vc_grace_s > 0.0)) {
-                    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                     if (cfg && cfg->p25_vc_grace_is_set) {
                         vc_grace = cfg->p25_vc_grace_s;
                     }
@@ -2505,7 +2510,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                 int other = slot ^ 1;
                 double mac_hold = 0.75; // seconds; override via DSD_NEO_P25_MAC_HOLD
                 {
-                    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                     if (state && state->p25_cfg_mac_hold_s > 0.0) {
                         mac_hold = state->p25_cfg_mac_hold_s;
                     } else if (cfg && cfg->p25_mac_hold_is_set) {
@@ -2516,7 +2521,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                 double noww2 = (double)time(NULL);
                 double voice_hold = 0.6; // seconds; override via DSD_NEO_P25_VOICE_HOLD
                 {
-                    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                    const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                     if (cfg && cfg->p25_voice_hold_is_set) {
                         voice_hold = cfg->p25_voice_hold_s;
                     }
@@ -2531,7 +2536,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                                     : ((state->p25_p2_last_mac_active[other] != 0)
                                            ? (noww2 - (double)state->p25_p2_last_mac_active[other])
                                            : 1e9);
-                int other_audio = state->p25_p2_audio_allowed[other] || (state->p25_p2_audio_ring_count[other] > 0)
+                int other_audio = state->p25_p2_audio_allowed[other] || (p25_p2_audio_ring_count(state, other) > 0)
                                   || (state->p25_p2_last_mac_active[other] != 0 && dt_mac <= mac_hold) || recent_voice;
                 if (!other_audio) {
                     fprintf(stderr, " No Enc Following on P25p2 Trunking (VCH SVC ENC); ");
@@ -2540,7 +2545,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                     // its audio gates.
                     double vc_grace = (state->p25_cfg_vc_grace_s > 0.0) ? state->p25_cfg_vc_grace_s : 0.75;
                     if (!(state->p25_cfg_vc_grace_s > 0.0)) {
-                        const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                        const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                         if (cfg && cfg->p25_vc_grace_is_set) {
                             vc_grace = cfg->p25_vc_grace_s;
                         }
@@ -2664,12 +2669,12 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                 // Gate this slot only
                 state->p25_p2_audio_allowed[slot] = 0;
                 int other = slot ^ 1;
-                int other_audio = state->p25_p2_audio_allowed[other] || state->p25_p2_audio_ring_count[other] > 0;
+                int other_audio = state->p25_p2_audio_allowed[other] || p25_p2_audio_ring_count(state, other) > 0;
                 if (!other_audio) {
                     fprintf(stderr, " No Enc Following on P25p2 Trunking (VCH SVC ENC); ");
                     double vc_grace = (state->p25_cfg_vc_grace_s > 0.0) ? state->p25_cfg_vc_grace_s : 0.75;
                     if (!(state->p25_cfg_vc_grace_s > 0.0)) {
-                        const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+                        const dsdneoRuntimeConfig* cfg = dsd_neo_config_held(state->rt_cfg);
                         if (cfg && cfg->p25_vc_grace_is_set) {
                             vc_grace = cfg->p25_vc_grace_s;
                         }
@@ -2732,6 +2737,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                         state->p2_cc = lcolorcode;
                     }
                 }
+                dsd_decoder_events_site(state);
 
                 //place the cc freq into the list at index 0 if 0 is empty, or not the same,
                 //so we can hunt for rotating CCs without user LCN list
@@ -2779,6 +2785,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
                         state->p2_cc = lcolorcode;
                     }
                 }
+                dsd_decoder_events_site(state);
                 p25_confirm_idens_for_current_site(state);
             } else {
                 fprintf(stderr, "\n  P25 NSB-EXT: ignoring invalid channel->freq (CHAN-T=%04X)", channelt);
@@ -2935,6 +2942,7 @@ process_MAC_VPDU(dsd_opts* opts, dsd_state* state, int type, unsigned long long
             }
             state->p2_siteid = siteid;
             state->p2_rfssid = rfssid;
+            dsd_decoder_events_site(state);
         }
 
         // Power Control Signal Quality (op25 parity: MAC 0x30)
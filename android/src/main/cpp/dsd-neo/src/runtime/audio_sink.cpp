@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+#include <dsd-neo/runtime/audio_sink.h>
+
+#include <mutex>
+
+static std::mutex g_audio_sink_mu;
+
+extern "C" void
+dsd_audio_sink_lock(void) {
+    g_audio_sink_mu.lock();
+}
+
+extern "C" void
+dsd_audio_sink_unlock(void) {
+    g_audio_sink_mu.unlock();
+}
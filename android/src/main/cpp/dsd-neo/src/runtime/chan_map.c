@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Linear-probing tables with backward-shift deletion, so there are no
+ * tombstones and a zero-filled map is a valid empty map.
+ */
+
+#include <dsd-neo/core/chan_map.h>
+
+#include <string.h>
+
+#define CHAN_MAP_MASK  (DSD_CHAN_MAP_SLOTS - 1u)
+#define CHAN_MAP_SHIFT 20 /* 32 - log2(DSD_CHAN_MAP_SLOTS) */
+
+typedef uint32_t (*chan_map_home_fn)(const dsd_chan_map_entry* e);
+
+static uint32_t
+home_by_chan(const dsd_chan_map_entry* e) {
+    return (e->key * 0x9E3779B1u) >> CHAN_MAP_SHIFT;
+}
+
+static uint32_t
+home_by_freq(const dsd_chan_map_entry* e) {
+    return (uint32_t)(((uint64_t)e->freq * 0x9E3779B97F4A7C15ULL) >> (32 + CHAN_MAP_SHIFT));
+}
+
+static void
+table_insert(dsd_chan_map_entry* t, chan_map_home_fn home, uint32_t key, long int freq) {
+    dsd_chan_map_entry e = {key, freq};
+    uint32_t i = home(&e);
+    while (t[i].key != 0) {
+        i = (i + 1u) & CHAN_MAP_MASK;
+    }
+    t[i] = e;
+}
+
+/* Remove slot i and shift later members of the probe run back into the hole. */
+static void
+table_remove_at(dsd_chan_map_entry* t, chan_map_home_fn home, uint32_t i) {
+    uint32_t j = i;
+    for (;;) {
+        j = (j + 1u) & CHAN_MAP_MASK;
+        if (t[j].key == 0) {
+            break;
+        }
+        uint32_t h = home(&t[j]);
+        if (((j - h) & CHAN_MAP_MASK) >= ((j - i) & CHAN_MAP_MASK)) {
+            t[i] = t[j];
+            i = j;
+        }
+    }
+    t[i].key = 0;
+    t[i].freq = 0;
+}
+
+static int
+find_chan_slot(const dsd_chan_map* map, uint32_t key, uint32_t* slot) {
+    dsd_chan_map_entry probe = {key, 0};
+    uint32_t i = home_by_chan(&probe);
+    while (map->by_chan[i].key != 0) {
+        if (map->by_chan[i].key == key) {
+            *slot = i;
+            return 1;
+        }
+        i = (i + 1u) & CHAN_MAP_MASK;
+    }
+    return 0;
+}
+
+static void
+remove_freq_entry(dsd_chan_map* map, uint32_t key, long int freq) {
+    dsd_chan_map_entry probe = {key, freq};
+    uint32_t i = home_by_freq(&probe);
+    while (map->by_freq[i].key != 0) {
+        if (map->by_freq[i].key == key && map->by_freq[i].freq == freq) {
+            table_remove_at(map->by_freq, home_by_freq, i);
+            return;
+        }
+        i = (i + 1u) & CHAN_MAP_MASK;
+    }
+}
+
+/* Index of the first sorted channel not below `channel`. */
+static uint32_t
+sorted_lower_bound(const dsd_chan_map* map, uint16_t channel) {
+    uint32_t lo = 0;
+    uint32_t hi = map->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2u;
+        if (map->sorted[mid] < channel) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void
+sorted_insert(dsd_chan_map* map, uint16_t channel) {
+    uint32_t i = sorted_lower_bound(map, channel);
+    memmove(&map->sorted[i + 1u], &map->sorted[i], (map->count - i) * sizeof(map->sorted[0]));
+    map->sorted[i] = channel;
+}
+
+static void
+sorted_remove(dsd_chan_map* map, uint16_t channel) {
+    uint32_t i = sorted_lower_bound(map, channel);
+    if (i < map->count && map->sorted[i] == channel) {
+        memmove(&map->sorted[i], &map->sorted[i + 1u], (map->count - i - 1u) * sizeof(map->sorted[0]));
+    }
+}
+
+void
+dsd_chan_map_clear(dsd_chan_map* map) {
+    memset(map, 0, sizeof(*map));
+}
+
+long int
+dsd_chan_map_get(const dsd_chan_map* map, long int channel) {
+    if (channel < 0 || channel > DSD_CHAN_MAP_MAX_CHANNEL) {
+        return 0;
+    }
+    uint32_t slot;
+    if (!find_chan_slot(map, (uint32_t)channel + 1u, &slot)) {
+        return 0;
+    }
+    return map->by_chan[slot].freq;
+}
+
+int
+dsd_chan_map_set(dsd_chan_map* map, long int channel, long int freq) {
+    if (channel < 0 || channel > DSD_CHAN_MAP_MAX_CHANNEL) {
+        return -1;
+    }
+    uint32_t key = (uint32_t)channel + 1u;
+    uint32_t slot;
+    if (find_chan_slot(map, key, &slot)) {
+        long int old = map->by_chan[slot].freq;
+        if (old == freq) {
+            return 0;
+        }
+        remove_freq_entry(map, key, old);
+        if (dsd_chan_map_find_freq(map, old) < 0) {
+            map->distinct_freqs--;
+        }
+        if (freq == 0) {
+            table_remove_at(map->by_chan, home_by_chan, slot);
+            sorted_remove(map, (uint16_t)channel);
+            map->count--;
+            return 0;
+        }
+        if (dsd_chan_map_find_freq(map, freq) < 0) {
+            map->distinct_freqs++;
+        }
+        map->by_chan[slot].freq = freq;
+        table_insert(map->by_freq, home_by_freq, key, freq);
+        return 0;
+    }
+    if (freq == 0) {
+        return 0;
+    }
+    if (map->count >= DSD_CHAN_MAP_MAX_ENTRIES) {
+        return -1;
+    }
+    if (dsd_chan_map_find_freq(map, freq) < 0) {
+        map->distinct_freqs++;
+    }
+    table_insert(map->by_chan, home_by_chan, key, freq);
+    table_insert(map->by_freq, home_by_freq, key, freq);
+    sorted_insert(map, (uint16_t)channel);
+    map->count++;
+    return 0;
+}
+
+long int
+dsd_chan_map_find_freq(const dsd_chan_map* map, long int freq) {
+    if (freq == 0) {
+        return -1;
+    }
+    dsd_chan_map_entry probe = {0, freq};
+    uint32_t i = home_by_freq(&probe);
+    uint32_t best = 0;
+    while (map->by_freq[i].key != 0) {
+        if (map->by_freq[i].freq == freq && (best == 0 || map->by_freq[i].key < best)) {
+            best = map->by_freq[i].key;
+        }
+        i = (i + 1u) & CHAN_MAP_MASK;
+    }
+    return (best != 0) ? (long int)best - 1 : -1;
+}
+
+size_t
+dsd_chan_map_foreach(const dsd_chan_map* map, dsd_chan_map_visit_fn fn, void* user) {
+    size_t visited = 0;
+    for (uint32_t i = 0; i < map->count; i++) {
+        long int channel = map->sorted[i];
+        visited++;
+        if (fn && fn(channel, dsd_chan_map_get(map, channel), user) != 0) {
+            break;
+        }
+    }
+    return visited;
+}
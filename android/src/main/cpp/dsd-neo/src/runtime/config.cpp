@@ -9,19 +9,61 @@
  *
  * Parses environment variables into a typed `dsd-neoRuntimeConfig` and exposes
  * an immutable accessor. Intended to be called early during application init.
+ *
+ * Each (re)initialization or setter call publishes a fresh heap snapshot with
+ * a single atomic pointer store; published snapshots are never modified, so
+ * readers may keep the pointer in their context without locking. Superseded
+ * snapshots stay allocated for the life of the process because readers are
+ * not tracked. Snapshots are interned: publishing a config identical to one
+ * published before re-publishes that snapshot, so stream restarts and UI
+ * toggles between known settings allocate nothing and memory stays bounded
+ * by the number of distinct configurations seen.
  */
 
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/dsp/costas.h>
 #include <dsd-neo/platform/posix_compat.h>
 #include <dsd-neo/runtime/config.h>
+#include <atomic>
 #include <limits.h>
 #include <math.h>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
+
+static std::atomic<const dsdneoRuntimeConfig*> g_config{nullptr};
+static std::atomic<unsigned int> g_config_generation{0};
+static std::mutex g_config_write;
 
-static dsdneoRuntimeConfig g_config;
-static int g_config_inited = 0;
+static std::vector<const dsdneoRuntimeConfig*> g_config_published; /* every snapshot, under g_config_write */
+
+/*
+ * Publish `c` as the current snapshot, reusing an identical earlier snapshot
+ * when there is one. Configs are compared bytewise; callers build them from
+ * zero-initialized storage. Caller holds g_config_write.
+ */
+static void
+config_publish_locked(const dsdneoRuntimeConfig& c) {
+    const dsdneoRuntimeConfig* snap = nullptr;
+    for (const dsdneoRuntimeConfig* p : g_config_published) {
+        if (memcmp(p, &c, sizeof(c)) == 0) {
+            snap = p;
+            break;
+        }
+    }
+    if (!snap) {
+        dsdneoRuntimeConfig* fresh = new dsdneoRuntimeConfig();
+        memcpy(fresh, &c, sizeof(c));
+        g_config_published.push_back(fresh);
+        snap = fresh;
+    }
+    if (g_config.load(std::memory_order_relaxed) == snap) {
+        return;
+    }
+    g_config.store(snap, std::memory_order_release);
+    g_config_generation.fetch_add(1, std::memory_order_release);
+}
 
 /**
  * @brief Check whether an environment string is set and non-empty.
@@ -150,7 +192,8 @@ void
 dsd_neo_config_init(const dsd_opts* opts) {
     (void)opts; /* precedence hook reserved for future CLI/opts overrides */
 
-    dsdneoRuntimeConfig c{};
+    dsdneoRuntimeConfig c;
+    memset(&c, 0, sizeof(c)); /* padding too: snapshots are compared bytewise */
 
     /* Defaults for centralized knobs (may be overridden by env parsing below). */
     c.sync_warmstart_enable = 1;
@@ -245,6 +288,19 @@ dsd_neo_config_init(const dsd_opts* opts) {
     const char* cpum = getenv("DSD_NEO_CPU_DEMOD");
     c.cpu_demod_is_set = env_parse_int_range(cpum, 0, 4096, &c.cpu_demod);
 
+    /* Large DSP buffer backing */
+    const char* mhp = getenv("DSD_NEO_MEM_HUGEPAGES");
+    c.mem_hugepages_is_set = env_is_set(mhp);
+    c.mem_hugepages_enable = c.mem_hugepages_is_set ? (env_is_falsey(mhp) ? 0 : 1) : 0;
+
+    const char* mpf = getenv("DSD_NEO_MEM_PREFAULT");
+    c.mem_prefault_is_set = env_is_set(mpf);
+    c.mem_prefault_enable = c.mem_prefault_is_set ? (env_is_falsey(mpf) ? 0 : 1) : 1;
+
+    const char* mlk = getenv("DSD_NEO_MEM_LOCK");
+    c.mem_lock_is_set = env_is_set(mlk);
+    c.mem_lock_enable = c.mem_lock_is_set ? (env_is_falsey(mlk) ? 0 : 1) : 0;
+
     /* Bootstrap/system toggles */
     const char* ftz = getenv("DSD_NEO_FTZ_DAZ");
     c.ftz_daz_is_set = env_is_set(ftz);
@@ -684,6 +740,96 @@ dsd_neo_config_init(const dsd_opts* opts) {
     const char* mt = getenv("DSD_NEO_MT");
     c.mt_is_set = env_is_set(mt);
     c.mt_enable = (c.mt_is_set && mt[0] == '1') ? 1 : 0;
+    const char* mtw = getenv("DSD_NEO_MT_WORKERS");
+    c.mt_workers_is_set = 0;
+    c.mt_workers = 2;
+    if (env_is_set(mtw)) {
+        int v = atoi(mtw);
+        if (v >= 1 && v <= 16) {
+            c.mt_workers_is_set = 1;
+            c.mt_workers = v;
+        }
+    }
+    const char* mtc = getenv("DSD_NEO_MT_CPU");
+    c.mt_cpu_is_set = 0;
+    c.mt_cpu = -1;
+    if (env_is_set(mtc)) {
+        int v = atoi(mtc);
+        if (v >= 0) {
+            c.mt_cpu_is_set = 1;
+            c.mt_cpu = v;
+        }
+    }
+
+    /* Pipelined vocoder synthesis */
+    const char* sp = getenv("DSD_NEO_SYNTH_PIPELINE");
+    c.synth_pipeline_is_set = env_is_set(sp);
+    c.synth_pipeline_enable = (c.synth_pipeline_is_set && sp[0] == '1') ? 1 : 0;
+    const char* sq = getenv("DSD_NEO_SYNTH_QUEUE");
+    c.synth_queue_is_set = 0;
+    c.synth_queue_depth = 8;
+    if (env_is_set(sq)) {
+        int v = atoi(sq);
+        if (v >= 1 && v <= 64) {
+            c.synth_queue_is_set = 1;
+            c.synth_queue_depth = v;
+        }
+    }
+    const char* spol = getenv("DSD_NEO_SYNTH_POLICY");
+    c.synth_policy_is_set = 0;
+    c.synth_policy = 0;
+    if (env_is_set(spol)) {
+        if (dsd_strcasecmp(spol, "oldest") == 0) {
+            c.synth_policy_is_set = 1;
+            c.synth_policy = 0;
+        } else if (dsd_strcasecmp(spol, "newest") == 0) {
+            c.synth_policy_is_set = 1;
+            c.synth_policy = 1;
+        } else if (dsd_strcasecmp(spol, "block") == 0) {
+            c.synth_policy_is_set = 1;
+            c.synth_policy = 2;
+        }
+    }
+    const char* sbm = getenv("DSD_NEO_SYNTH_BLOCK_MS");
+    c.synth_block_ms_is_set = 0;
+    c.synth_block_ms = 5;
+    if (env_is_set(sbm)) {
+        int v = atoi(sbm);
+        if (v >= 0 && v <= 100) {
+            c.synth_block_ms_is_set = 1;
+            c.synth_block_ms = v;
+        }
+    }
+    c.synth_workers_is_set = env_parse_int_range(getenv("DSD_NEO_SYNTH_WORKERS"), 1, 2, &c.synth_workers);
+    if (!c.synth_workers_is_set) {
+        c.synth_workers = 2;
+    }
+    c.p25p2_jitter_depth_is_set =
+        env_parse_int_range(getenv("DSD_NEO_P25P2_JITTER_DEPTH"), 1, 8, &c.p25p2_jitter_depth);
+    if (!c.p25p2_jitter_depth_is_set) {
+        c.p25p2_jitter_depth = 3;
+    }
+
+    /* Symbol capture replay */
+    const char* sfast = getenv("DSD_NEO_SYMBOL_FAST");
+    c.symbol_fast_is_set = env_is_set(sfast);
+    c.symbol_fast_enable = (c.symbol_fast_is_set && sfast[0] == '1') ? 1 : 0;
+    const char* sseek = getenv("DSD_NEO_SYMBOL_SEEK");
+    c.symbol_seek_s = 0.0;
+    c.symbol_seek_is_set = env_parse_double_range(sseek, 0.0, 1e12, &c.symbol_seek_s);
+    const char* ssync = getenv("DSD_NEO_SYMBOL_SEEK_SYNC");
+    c.symbol_seek_sync_is_set = 0;
+    c.symbol_seek_sync = -1;
+    if (env_is_set(ssync)) {
+        if (dsd_strcasecmp(ssync, "any") == 0) {
+            c.symbol_seek_sync_is_set = 1;
+        } else {
+            c.symbol_seek_sync_is_set = env_parse_int_range(ssync, 0, 255, &c.symbol_seek_sync);
+        }
+    }
+    const char* slegacy = getenv("DSD_NEO_SYMBOL_LEGACY");
+    c.symbol_legacy_is_set = env_is_set(slegacy);
+    c.symbol_legacy_enable = (c.symbol_legacy_is_set && slegacy[0] == '1') ? 1 : 0;
 
     /* Disable fs/4 capture shift */
     const char* dfs4 = getenv("DSD_NEO_DISABLE_FS4_SHIFT");
@@ -759,14 +905,18 @@ dsd_neo_config_init(const dsd_opts* opts) {
     c.iq_dc_shift_is_set = env_is_set(dck);
     c.iq_dc_shift = c.iq_dc_shift_is_set ? atoi(dck) : 11;
 
+    const char* iqb = getenv("DSD_NEO_IQ_BALANCE");
+    c.iq_balance_is_set = env_is_set(iqb);
+    c.iq_balance_enable = c.iq_balance_is_set ? (atoi(iqb) != 0) : 0;
+
     /* Channel complex low-pass on RTL baseband (post-HB).
        Default: off for digital voice modes at 24 kHz; may be enabled via env. */
     const char* clpf = getenv("DSD_NEO_CHANNEL_LPF");
     c.channel_lpf_is_set = env_is_set(clpf);
     c.channel_lpf_enable = c.channel_lpf_is_set ? atoi(clpf) : 0;
 
-    g_config = c;
-    g_config_inited = 1;
+    std::lock_guard<std::mutex> lock(g_config_write);
+    config_publish_locked(c);
 }
 
 /**
@@ -777,7 +927,22 @@ dsd_neo_config_init(const dsd_opts* opts) {
  */
 const dsdneoRuntimeConfig*
 dsd_neo_get_config(void) {
-    return g_config_inited ? &g_config : NULL;
+    return g_config.load(std::memory_order_acquire);
+}
+
+extern "C" const dsdneoRuntimeConfig*
+dsd_neo_config_snapshot(const dsd_opts* opts) {
+    const dsdneoRuntimeConfig* cfg = g_config.load(std::memory_order_acquire);
+    if (!cfg) {
+        dsd_neo_config_init(opts);
+        cfg = g_config.load(std::memory_order_acquire);
+    }
+    return cfg;
+}
+
+extern "C" unsigned int
+dsd_neo_config_generation(void) {
+    return g_config_generation.load(std::memory_order_acquire);
 }
 
 extern "C" void
@@ -800,41 +965,49 @@ dsd_neo_env_get(const char* name) {
 /* Runtime control for C4FM clock assist (0=off, 1=EL, 2=MM). */
 extern "C" void
 dsd_neo_set_c4fm_clk(int mode) {
-    if (!g_config_inited) {
-        g_config = dsdneoRuntimeConfig{};
-        g_config_inited = 1;
+    std::lock_guard<std::mutex> lock(g_config_write);
+    const dsdneoRuntimeConfig* cur = g_config.load(std::memory_order_acquire);
+    dsdneoRuntimeConfig c{};
+    if (cur) {
+        memcpy(&c, cur, sizeof(c));
     }
     if (mode >= 0) {
         if (mode > 2) {
             mode = 0;
         }
-        g_config.c4fm_clk_is_set = 1;
-        g_config.c4fm_clk_mode = mode;
+        c.c4fm_clk_is_set = 1;
+        c.c4fm_clk_mode = mode;
     }
+    config_publish_locked(c);
 }
 
 extern "C" int
 dsd_neo_get_c4fm_clk(void) {
-    if (!g_config_inited) {
+    const dsdneoRuntimeConfig* cfg = g_config.load(std::memory_order_acquire);
+    if (!cfg) {
         return 0;
     }
-    return g_config.c4fm_clk_is_set ? g_config.c4fm_clk_mode : 0;
+    return cfg->c4fm_clk_is_set ? cfg->c4fm_clk_mode : 0;
 }
 
 extern "C" void
 dsd_neo_set_c4fm_clk_sync(int enable) {
-    if (!g_config_inited) {
-        g_config = dsdneoRuntimeConfig{};
-        g_config_inited = 1;
+    std::lock_guard<std::mutex> lock(g_config_write);
+    const dsdneoRuntimeConfig* cur = g_config.load(std::memory_order_acquire);
+    dsdneoRuntimeConfig c{};
+    if (cur) {
+        memcpy(&c, cur, sizeof(c));
     }
-    g_config.c4fm_clk_sync_is_set = 1;
-    g_config.c4fm_clk_sync = enable ? 1 : 0;
+    c.c4fm_clk_sync_is_set = 1;
+    c.c4fm_clk_sync = enable ? 1 : 0;
+    config_publish_locked(c);
 }
 
 extern "C" int
 dsd_neo_get_c4fm_clk_sync(void) {
-    if (!g_config_inited) {
+    const dsdneoRuntimeConfig* cfg = g_config.load(std::memory_order_acquire);
+    if (!cfg) {
         return 0;
     }
-    return g_config.c4fm_clk_sync_is_set ? (g_config.c4fm_clk_sync ? 1 : 0) : 0;
+    return cfg->c4fm_clk_sync_is_set ? (cfg->c4fm_clk_sync ? 1 : 0) : 0;
 }
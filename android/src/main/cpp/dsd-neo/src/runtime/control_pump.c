@@ -8,6 +8,7 @@
 #include <stddef.h>
 
 static dsd_control_pump_fn g_control_pump_fn = NULL;
+static dsd_input_wait_pump_fn g_input_wait_pump_fn = NULL;
 
 void
 dsd_runtime_set_control_pump(dsd_control_pump_fn fn) {
@@ -22,3 +23,17 @@ dsd_runtime_pump_controls(dsd_opts* opts, dsd_state* state) {
     }
     fn(opts, state);
 }
+
+void
+dsd_runtime_set_input_wait_pump(dsd_input_wait_pump_fn fn) {
+    g_input_wait_pump_fn = fn;
+}
+
+void
+dsd_runtime_pump_input_wait(void) {
+    dsd_input_wait_pump_fn fn = g_input_wait_pump_fn;
+    if (!fn) {
+        return;
+    }
+    fn();
+}
@@ -0,0 +1,593 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Decoder change-event dispatch and RCU talkgroup filter.
+ *
+ * Both the subscriber list and the filter are immutable heap snapshots behind
+ * an atomic pointer. Readers bump an in-flight counter around their use of
+ * the snapshot; writers serialize on a mutex, swap in a new copy, then wait
+ * for the counter to drain (the grace period) before freeing the old copy.
+ */
+
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/platform/timing.h>
+#include <dsd-neo/runtime/decoder_events.h>
+
+#include <atomic>
+#include <mutex>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+/* Grace period: wait until no reader still holds a snapshot taken before the swap. */
+void
+wait_for_readers(const std::atomic<int>& readers) {
+    while (readers.load() > 0) {
+        dsd_sleep_ms(1);
+    }
+}
+
+/* ---- subscribers ---- */
+
+struct subscriber {
+    int id;
+    uint32_t mask;
+    dsd_decoder_event_fn fn;
+    void* user;
+};
+
+struct subscriber_list {
+    size_t count;
+    uint32_t mask_union;
+    subscriber items[1];
+};
+
+std::atomic<subscriber_list*> g_subs{nullptr};
+std::atomic<int> g_sub_readers{0};
+std::mutex g_sub_write;
+int g_next_sub_id = 1;
+
+subscriber_list*
+subscriber_list_alloc(size_t count) {
+    size_t n = count ? count : 1;
+    size_t bytes = sizeof(subscriber_list) + (n - 1) * sizeof(subscriber);
+    return static_cast<subscriber_list*>(calloc(1, bytes));
+}
+
+/* ---- talkgroup filter ---- */
+
+struct tg_filter {
+    int mode;
+    size_t count;
+    int tgs[1]; /* sorted, unique */
+};
+
+std::atomic<tg_filter*> g_filter{nullptr};
+std::atomic<int> g_filter_readers{0};
+std::mutex g_filter_write;
+
+int
+cmp_int(const void* a, const void* b) {
+    int x = *static_cast<const int*>(a);
+    int y = *static_cast<const int*>(b);
+    return (x > y) - (x < y);
+}
+
+tg_filter*
+tg_filter_build(int mode, const int* tgs, size_t count) {
+    size_t n = count ? count : 1;
+    tg_filter* f = static_cast<tg_filter*>(calloc(1, sizeof(tg_filter) + (n - 1) * sizeof(int)));
+    if (!f) {
+        return nullptr;
+    }
+    f->mode = mode;
+    if (count) {
+        memcpy(f->tgs, tgs, count * sizeof(int));
+        qsort(f->tgs, count, sizeof(int), cmp_int);
+        size_t u = 1;
+        for (size_t i = 1; i < count; i++) {
+            if (f->tgs[i] != f->tgs[u - 1]) {
+                f->tgs[u++] = f->tgs[i];
+            }
+        }
+        f->count = u;
+    }
+    return f;
+}
+
+int
+tg_filter_contains(const tg_filter* f, int tg) {
+    size_t lo = 0;
+    size_t hi = f->count;
+    while (lo < hi) {
+        size_t mid = lo + ((hi - lo) >> 1);
+        if (f->tgs[mid] < tg) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < f->count && f->tgs[lo] == tg;
+}
+
+/* Caller holds g_filter_write. */
+int
+tg_filter_publish(tg_filter* next) {
+    if (!next) {
+        return -1;
+    }
+    tg_filter* prev = g_filter.exchange(next);
+    wait_for_readers(g_filter_readers);
+    free(prev);
+    return 0;
+}
+
+/* ---- per-state reported values ---- */
+
+struct event_tracker {
+    int tg[2];
+    int src[2];
+    uint64_t wacn;
+    uint64_t siteid;
+    uint64_t rfssid;
+    int nac;
+    unsigned int tsbk_ok;
+    unsigned int tsbk_err;
+    int synctype;
+    int carrier;
+    uint64_t signal_last_ns;
+};
+
+const uint64_t kSignalMinIntervalNs = 100ULL * 1000ULL * 1000ULL;
+
+void
+tracker_clear(event_tracker* t) {
+    memset(t, 0, sizeof(*t));
+    t->synctype = -2; /* never a DSD_SYNC_* value: first report always emits signal */
+}
+
+event_tracker*
+tracker_for(dsd_state* state) {
+    event_tracker* t = DSD_STATE_EXT_GET_AS(event_tracker, state, DSD_STATE_EXT_ENGINE_DECODER_EVENTS);
+    if (t) {
+        return t;
+    }
+    t = static_cast<event_tracker*>(calloc(1, sizeof(*t)));
+    if (!t) {
+        return nullptr;
+    }
+    tracker_clear(t);
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_ENGINE_DECODER_EVENTS, t, free) != 0) {
+        free(t);
+        return nullptr;
+    }
+    return t;
+}
+
+/* Whether any subscriber takes `kind`; reporters skip all work otherwise. */
+int
+wanted(dsd_decoder_event_kind kind) {
+    g_sub_readers.fetch_add(1);
+    const subscriber_list* subs = g_subs.load();
+    int want = subs && (subs->mask_union & DSD_EVENT_MASK(kind)) != 0;
+    g_sub_readers.fetch_sub(1);
+    return want;
+}
+
+void
+emit_call(const dsd_state* state, int slot, int phase, int tg, int src) {
+    dsd_decoder_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.kind = DSD_EVENT_CALL;
+    ev.state = state;
+    ev.u.call.phase = phase;
+    ev.u.call.tg = tg;
+    ev.u.call.src = src;
+    ev.u.call.slot = slot;
+    ev.u.call.nac = state->nac;
+    ev.u.call.synctype = state->synctype;
+    if (phase != DSD_CALL_END) {
+        ev.u.call.is_private = state->gi[slot] == 1 ? 1 : 0;
+        ev.u.call.is_emergency = state->p25_call_emergency[slot] ? 1 : 0;
+    }
+    ev.u.call.filtered = dsd_tg_filter_allows(tg) ? 0 : 1;
+    dsd_decoder_events_emit(&ev);
+}
+
+void
+report_end(dsd_state* state, event_tracker* t, int slot) {
+    if (t->tg[slot] != 0 || t->src[slot] != 0) {
+        emit_call(state, slot, DSD_CALL_END, t->tg[slot], t->src[slot]);
+        t->tg[slot] = 0;
+        t->src[slot] = 0;
+    }
+}
+
+void
+report_ids(dsd_state* state, event_tracker* t, int slot, int tg, int src) {
+    if ((tg == 0 && src == 0) || (tg == t->tg[slot] && src == t->src[slot])) {
+        return; /* not identified yet, or nothing new */
+    }
+    int idle = t->tg[slot] == 0 && t->src[slot] == 0;
+    emit_call(state, slot, idle ? DSD_CALL_START : DSD_CALL_UPDATE, tg, src);
+    t->tg[slot] = tg;
+    t->src[slot] = src;
+}
+
+void
+report_call(dsd_state* state, event_tracker* t, int slot, int active) {
+    if (!active) {
+        report_end(state, t, slot);
+        return;
+    }
+    report_ids(state, t, slot, slot ? state->lasttgR : state->lasttg, slot ? state->lastsrcR : state->lastsrc);
+}
+
+/* Callsign fields have no numeric id; sum the characters like the event history does. */
+int
+callsign_id(const char* s, size_t n, size_t blank) {
+    size_t spaces = 0;
+    while (spaces < blank && s[spaces] == ' ') {
+        spaces++;
+    }
+    if (spaces == blank) {
+        return 0;
+    }
+    int sum = 0;
+    for (size_t i = 0; i < n && s[i] != '\0'; i++) {
+        sum += (unsigned char)s[i];
+    }
+    return sum;
+}
+
+/*
+ * Current talkgroup/source for protocols with no report site of their own.
+ * Returns 0 for P25/DMR (reported by their trunk SMs) and for no sync.
+ */
+int
+fallback_ids(const dsd_state* state, int* tg, int* src) {
+    int s = state->synctype;
+    if (DSD_SYNC_IS_NXDN(s)) {
+        *tg = (int)state->nxdn_last_tg;
+        *src = (int)state->nxdn_last_rid;
+    } else if (DSD_SYNC_IS_EDACS(s)) {
+        *tg = state->lasttg;
+        *src = state->lastsrc;
+    } else if (DSD_SYNC_IS_DPMR(s)) {
+        *tg = (int)strtol(state->dpmr_target_id, nullptr, 10);
+        *src = (int)strtol(state->dpmr_caller_id, nullptr, 10);
+    } else if (DSD_SYNC_IS_M17(s)) {
+        *tg = (int)(uint32_t)state->m17_dst;
+        *src = (int)(uint32_t)state->m17_src;
+    } else if (DSD_SYNC_IS_YSF(s)) {
+        *tg = callsign_id(state->ysf_tgt, sizeof(state->ysf_tgt), 10);
+        *src = callsign_id(state->ysf_src, sizeof(state->ysf_src), 10);
+    } else if (DSD_SYNC_IS_DSTAR(s)) {
+        *tg = callsign_id(state->dstar_dst, sizeof(state->dstar_dst), 8);
+        *src = callsign_id(state->dstar_src, sizeof(state->dstar_src), 8);
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+} // namespace
+
+extern "C" {
+
+int
+dsd_decoder_events_subscribe(uint32_t mask, dsd_decoder_event_fn fn, void* user) {
+    if (!fn || (mask & DSD_EVENT_MASK_ALL) == 0) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(g_sub_write);
+    subscriber_list* prev = g_subs.load();
+    size_t n = prev ? prev->count : 0;
+    subscriber_list* next = subscriber_list_alloc(n + 1);
+    if (!next) {
+        return -1;
+    }
+    if (n) {
+        memcpy(next->items, prev->items, n * sizeof(subscriber));
+    }
+    int id = g_next_sub_id++;
+    next->items[n].id = id;
+    next->items[n].mask = mask & DSD_EVENT_MASK_ALL;
+    next->items[n].fn = fn;
+    next->items[n].user = user;
+    next->count = n + 1;
+    next->mask_union = (prev ? prev->mask_union : 0u) | next->items[n].mask;
+    g_subs.store(next);
+    wait_for_readers(g_sub_readers);
+    free(prev);
+    return id;
+}
+
+void
+dsd_decoder_events_unsubscribe(int id) {
+    std::lock_guard<std::mutex> lock(g_sub_write);
+    subscriber_list* prev = g_subs.load();
+    if (!prev) {
+        return;
+    }
+    subscriber_list* next = nullptr;
+    if (prev->count > 1) {
+        next = subscriber_list_alloc(prev->count - 1);
+        if (!next) {
+            return;
+        }
+        for (size_t i = 0; i < prev->count; i++) {
+            if (prev->items[i].id != id) {
+                if (next->count == prev->count - 1) {
+                    free(next); /* id not found */
+                    return;
+                }
+                next->items[next->count] = prev->items[i];
+                next->mask_union |= prev->items[i].mask;
+                next->count++;
+            }
+        }
+    } else if (prev->items[0].id != id) {
+        return;
+    }
+    g_subs.store(next);
+    wait_for_readers(g_sub_readers);
+    free(prev);
+}
+
+void
+dsd_decoder_events_emit(const dsd_decoder_event* ev) {
+    if (!ev || (unsigned)ev->kind >= DSD_EVENT_KIND_COUNT) {
+        return;
+    }
+    g_sub_readers.fetch_add(1);
+    const subscriber_list* subs = g_subs.load();
+    if (subs) {
+        uint32_t bit = DSD_EVENT_MASK(ev->kind);
+        for (size_t i = 0; i < subs->count; i++) {
+            if (subs->items[i].mask & bit) {
+                subs->items[i].fn(ev, subs->items[i].user);
+            }
+        }
+    }
+    g_sub_readers.fetch_sub(1);
+}
+
+void
+dsd_decoder_events_call(dsd_state* state, int slot, int active) {
+    if (!state || slot < -1 || slot > 1 || !wanted(DSD_EVENT_CALL)) {
+        return;
+    }
+    event_tracker* t = tracker_for(state);
+    if (!t) {
+        return;
+    }
+    if (slot < 0) {
+        report_call(state, t, 0, active);
+        report_call(state, t, 1, active);
+    } else {
+        report_call(state, t, slot, active);
+    }
+}
+
+void
+dsd_decoder_events_frame(dsd_state* state) {
+    int tg = 0;
+    int src = 0;
+    if (!state || !fallback_ids(state, &tg, &src) || !wanted(DSD_EVENT_CALL)) {
+        return;
+    }
+    event_tracker* t = tracker_for(state);
+    if (!t) {
+        return;
+    }
+    if (tg == 0 && src == 0) {
+        report_end(state, t, 0);
+    } else {
+        report_ids(state, t, 0, tg, src);
+    }
+}
+
+void
+dsd_decoder_events_site(dsd_state* state) {
+    if (!state || !wanted(DSD_EVENT_SITE)) {
+        return;
+    }
+    event_tracker* t = tracker_for(state);
+    if (!t) {
+        return;
+    }
+    uint64_t wacn = state->p2_wacn;
+    uint64_t siteid = state->p2_siteid;
+    uint64_t rfssid = state->p2_rfssid;
+    if (wacn == t->wacn && siteid == t->siteid && rfssid == t->rfssid && state->nac == t->nac) {
+        return;
+    }
+    if (wacn != 0 || siteid != 0 || rfssid != 0) {
+        dsd_decoder_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.kind = DSD_EVENT_SITE;
+        ev.state = state;
+        ev.u.site.wacn = wacn;
+        ev.u.site.siteid = siteid;
+        ev.u.site.rfssid = rfssid;
+        ev.u.site.nac = state->nac;
+        dsd_decoder_events_emit(&ev);
+    }
+    t->wacn = wacn;
+    t->siteid = siteid;
+    t->rfssid = rfssid;
+    t->nac = state->nac;
+}
+
+void
+dsd_decoder_events_signal(dsd_state* state) {
+    if (!state || !wanted(DSD_EVENT_SIGNAL)) {
+        return;
+    }
+    event_tracker* t = tracker_for(state);
+    if (!t) {
+        return;
+    }
+    int synctype = state->synctype;
+    if (state->p25_p1_fec_ok == t->tsbk_ok && state->p25_p1_fec_err == t->tsbk_err && synctype == t->synctype
+        && state->carrier == t->carrier) {
+        return;
+    }
+    uint64_t now = dsd_time_monotonic_ns();
+    int edge = (synctype != t->synctype) || (state->carrier != t->carrier);
+    if (!edge && now - t->signal_last_ns < kSignalMinIntervalNs) {
+        return;
+    }
+    dsd_decoder_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.kind = DSD_EVENT_SIGNAL;
+    ev.state = state;
+    ev.u.signal.tsbk_ok = state->p25_p1_fec_ok;
+    ev.u.signal.tsbk_err = state->p25_p1_fec_err;
+    ev.u.signal.synctype = synctype;
+    ev.u.signal.carrier = state->carrier;
+    dsd_decoder_events_emit(&ev);
+    t->tsbk_ok = state->p25_p1_fec_ok;
+    t->tsbk_err = state->p25_p1_fec_err;
+    t->synctype = synctype;
+    t->carrier = state->carrier;
+    t->signal_last_ns = now;
+}
+
+void
+dsd_decoder_events_table(dsd_state* state, dsd_decoder_event_kind kind) {
+    if (!state || kind < DSD_EVENT_NEIGHBOR || kind > DSD_EVENT_GROUP_ATTACH || !wanted(kind)) {
+        return;
+    }
+    dsd_decoder_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.kind = kind;
+    ev.state = state;
+    dsd_decoder_events_emit(&ev);
+}
+
+void
+dsd_decoder_events_reset(dsd_state* state) {
+    if (!state) {
+        return;
+    }
+    event_tracker* t = DSD_STATE_EXT_GET_AS(event_tracker, state, DSD_STATE_EXT_ENGINE_DECODER_EVENTS);
+    if (t) {
+        tracker_clear(t);
+    }
+}
+
+int
+dsd_tg_filter_set(int mode, const int* tgs, size_t count) {
+    if (mode < DSD_TG_FILTER_OFF || mode > DSD_TG_FILTER_BLOCK || (count && !tgs)) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(g_filter_write);
+    return tg_filter_publish(tg_filter_build(mode, tgs, count));
+}
+
+int
+dsd_tg_filter_set_mode(int mode) {
+    if (mode < DSD_TG_FILTER_OFF || mode > DSD_TG_FILTER_BLOCK) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(g_filter_write);
+    const tg_filter* cur = g_filter.load();
+    return tg_filter_publish(tg_filter_build(mode, cur ? cur->tgs : nullptr, cur ? cur->count : 0));
+}
+
+int
+dsd_tg_filter_set_list(const int* tgs, size_t count) {
+    if (count && !tgs) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(g_filter_write);
+    const tg_filter* cur = g_filter.load();
+    return tg_filter_publish(tg_filter_build(cur ? cur->mode : DSD_TG_FILTER_OFF, tgs, count));
+}
+
+int
+dsd_tg_filter_add(int tg) {
+    std::lock_guard<std::mutex> lock(g_filter_write);
+    const tg_filter* cur = g_filter.load();
+    if (cur && tg_filter_contains(cur, tg)) {
+        return 0;
+    }
+    size_t n = cur ? cur->count : 0;
+    int* tmp = static_cast<int*>(malloc((n + 1) * sizeof(int)));
+    if (!tmp) {
+        return -1;
+    }
+    if (n) {
+        memcpy(tmp, cur->tgs, n * sizeof(int));
+    }
+    tmp[n] = tg;
+    int rc = tg_filter_publish(tg_filter_build(cur ? cur->mode : DSD_TG_FILTER_OFF, tmp, n + 1));
+    free(tmp);
+    return rc;
+}
+
+int
+dsd_tg_filter_remove(int tg) {
+    std::lock_guard<std::mutex> lock(g_filter_write);
+    const tg_filter* cur = g_filter.load();
+    if (!cur || !tg_filter_contains(cur, tg)) {
+        return 0;
+    }
+    tg_filter* next = tg_filter_build(cur->mode, nullptr, 0);
+    if (!next) {
+        return -1;
+    }
+    tg_filter* sized = static_cast<tg_filter*>(realloc(next, sizeof(tg_filter) + cur->count * sizeof(int)));
+    if (!sized) {
+        free(next);
+        return -1;
+    }
+    for (size_t i = 0; i < cur->count; i++) {
+        if (cur->tgs[i] != tg) {
+            sized->tgs[sized->count++] = cur->tgs[i];
+        }
+    }
+    return tg_filter_publish(sized);
+}
+
+int
+dsd_tg_filter_get_mode(void) {
+    g_filter_readers.fetch_add(1);
+    const tg_filter* f = g_filter.load();
+    int mode = f ? f->mode : DSD_TG_FILTER_OFF;
+    g_filter_readers.fetch_sub(1);
+    return mode;
+}
+
+size_t
+dsd_tg_filter_count(void) {
+    g_filter_readers.fetch_add(1);
+    const tg_filter* f = g_filter.load();
+    size_t n = f ? f->count : 0;
+    g_filter_readers.fetch_sub(1);
+    return n;
+}
+
+int
+dsd_tg_filter_allows(int tg) {
+    g_filter_readers.fetch_add(1);
+    const tg_filter* f = g_filter.load();
+    int allow = 1;
+    if (f && f->mode != DSD_TG_FILTER_OFF) {
+        int listed = tg_filter_contains(f, tg);
+        allow = (f->mode == DSD_TG_FILTER_ALLOW) ? listed : !listed;
+    }
+    g_filter_readers.fetch_sub(1);
+    return allow;
+}
+
+} // extern "C"
@@ -14,14 +14,6 @@ dsd_frame_sync_hooks_set(dsd_frame_sync_hooks hooks) {
     g_frame_sync_hooks = hooks;
 }
 
-void
-dsd_frame_sync_hook_p25_sm_try_tick(dsd_opts* opts, dsd_state* state) {
-    if (!g_frame_sync_hooks.p25_sm_try_tick) {
-        return;
-    }
-    g_frame_sync_hooks.p25_sm_try_tick(opts, state);
-}
-
 void
 dsd_frame_sync_hook_p25_sm_on_release(dsd_opts* opts, dsd_state* state) {
     if (!g_frame_sync_hooks.p25_sm_on_release) {
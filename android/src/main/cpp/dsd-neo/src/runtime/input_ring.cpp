@@ -20,6 +20,17 @@ extern "C" volatile uint8_t exitflag; // defined in src/runtime/exitflag.c
 extern "C" int dsd_rtl_stream_should_exit(void);
 #endif
 
+/* Producer side: stamp a requested retune marker at the current head before
+   publishing samples captured after the retune. */
+static inline void
+input_ring_stamp_marker(struct input_ring_state* r) {
+    uint32_t req = r->marker_req.load(std::memory_order_acquire);
+    if (req != r->marker_seq.load(std::memory_order_relaxed)) {
+        r->marker_pos.store(r->head.load(), std::memory_order_relaxed);
+        r->marker_seq.store(req, std::memory_order_release);
+    }
+}
+
 /**
  * @brief Reserve writable regions in the input ring buffer.
  *
@@ -77,6 +88,7 @@ input_ring_commit(struct input_ring_state* r, size_t produced) {
     if (produced == 0) {
         return;
     }
+    input_ring_stamp_marker(r);
     int need_signal = input_ring_is_empty(r);
     size_t h = r->head.load();
     h += produced;
@@ -102,6 +114,7 @@ input_ring_commit(struct input_ring_state* r, size_t produced) {
  */
 void
 input_ring_write(struct input_ring_state* r, const float* data, size_t count) {
+    input_ring_stamp_marker(r);
     int need_signal = input_ring_is_empty(r);
     while (count > 0 && !exitflag) {
         size_t free_sp = input_ring_free(r);
@@ -153,15 +166,20 @@ input_ring_write(struct input_ring_state* r, const float* data, size_t count) {
 /**
  * @brief Read up to max_count samples from the input ring, blocking until data is available.
  *
- * Returns -1 when an exit condition is observed while waiting for data.
+ * Returns -1 when an exit condition is observed while waiting for data, and 0
+ * after dropping the samples queued ahead of a retune marker.
  *
  * @param r         Input ring buffer state.
  * @param out       Destination buffer for samples.
  * @param max_count Maximum number of samples to read.
- * @return Number of samples read (>=1), 0 if max_count is 0, or -1 on exit.
+ * @param marker    [out] Set to 1 when a marker was crossed (optional).
+ * @return Number of samples read, 0 at a marker or if max_count is 0, or -1 on exit.
  */
 int
-input_ring_read_block(struct input_ring_state* r, float* out, size_t max_count) {
+input_ring_read_block_marker(struct input_ring_state* r, float* out, size_t max_count, int* marker) {
+    if (marker) {
+        *marker = 0;
+    }
     if (max_count == 0) {
         return 0;
     }
@@ -191,8 +209,19 @@ input_ring_read_block(struct input_ring_state* r, float* out, size_t max_count)
     }
 
     size_t available = input_ring_used(r);
-    size_t read_now = (max_count < available) ? max_count : available;
     size_t t = r->tail.load();
+    /* The marker is stamped before the head that covers it, so once `available`
+       includes post-marker samples the stamp is visible here and lies in [tail, head]. */
+    uint32_t seq = r->marker_seq.load(std::memory_order_acquire);
+    if (seq != r->marker_seen) {
+        r->marker_seen = seq;
+        r->tail.store(r->marker_pos.load(std::memory_order_relaxed));
+        if (marker) {
+            *marker = 1;
+        }
+        return 0;
+    }
+    size_t read_now = (max_count < available) ? max_count : available;
     size_t first = r->capacity - t;
     if (first >= read_now) {
         memcpy(out, r->buffer + t, read_now * sizeof(float));
@@ -209,3 +238,8 @@ input_ring_read_block(struct input_ring_state* r, float* out, size_t max_count)
 
     return (int)read_now;
 }
+
+int
+input_ring_read_block(struct input_ring_state* r, float* out, size_t max_count) {
+    return input_ring_read_block_marker(r, out, max_count, NULL);
+}
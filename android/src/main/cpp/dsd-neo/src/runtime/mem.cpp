@@ -8,14 +8,27 @@
  * @brief Aligned memory allocation utilities for DSP operations.
  *
  * Provides `dsd_neo_aligned_malloc` and `dsd_neo_aligned_free` with a default
- * alignment of `DSD_NEO_ALIGN` for SIMD-friendly and cache-efficient buffers.
+ * alignment of `DSD_NEO_ALIGN` for SIMD-friendly and cache-efficient buffers,
+ * and the pooled mapping allocator behind `dsd_neo_buffer_malloc`.
  */
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <mutex>
 
+#include <dsd-neo/platform/platform.h>
 #include <dsd-neo/platform/posix_compat.h>
+#include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/log.h>
 #include <dsd-neo/runtime/mem.h>
 
+#if !DSD_PLATFORM_WIN_NATIVE
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 /**
  * @brief Allocate memory aligned to `DSD_NEO_ALIGN`.
  *
@@ -49,3 +62,299 @@ void
 dsd_neo_aligned_free(void* ptr) {
     dsd_aligned_free(ptr);
 }
+
+#if !DSD_PLATFORM_WIN_NATIVE
+
+namespace {
+
+struct buffer_map {
+    void* ptr;
+    size_t len;
+    int hugetlb;
+    int locked;
+};
+
+enum { kMaxLiveMaps = 32, kMaxPooledMaps = 8 };
+
+constexpr size_t kMaxPooledBytes = (size_t)64 << 20;
+constexpr size_t kThpSize = (size_t)2 << 20;
+
+std::mutex g_buf_mu;
+buffer_map g_live[kMaxLiveMaps];
+int g_live_count = 0;
+buffer_map g_pool[kMaxPooledMaps];
+int g_pool_count = 0;
+unsigned long g_mapped = 0;
+unsigned long g_reused = 0;
+int g_lock_warned = 0;
+
+size_t
+page_size(void) {
+    long ps = sysconf(_SC_PAGESIZE);
+    return (ps > 0) ? (size_t)ps : (size_t)4096;
+}
+
+size_t
+round_up(size_t n, size_t unit) {
+    return (n + unit - 1) / unit * unit;
+}
+
+/* Default explicit hugepage size from /proc/meminfo; 0 when unknown. */
+size_t
+hugetlb_page_size(void) {
+    static size_t cached = (size_t)-1;
+    if (cached != (size_t)-1) {
+        return cached;
+    }
+    cached = 0;
+    FILE* f = fopen("/proc/meminfo", "r");
+    if (!f) {
+        return cached;
+    }
+    char line[128];
+    while (fgets(line, sizeof line, f)) {
+        unsigned long kb = 0;
+        if (sscanf(line, "Hugepagesize: %lu kB", &kb) == 1) {
+            cached = (size_t)kb * 1024u;
+            break;
+        }
+    }
+    fclose(f);
+    return cached;
+}
+
+/* Map `len` bytes (a page multiple) aligned to `align`, trimming the slack. */
+void*
+map_aligned(size_t len, size_t align) {
+    size_t span = len + align;
+    void* raw = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return NULL;
+    }
+    uintptr_t base = (uintptr_t)raw;
+    uintptr_t start = (base + align - 1) & ~(uintptr_t)(align - 1);
+    if (start > base) {
+        munmap(raw, start - base);
+    }
+    size_t tail = (base + span) - (start + len);
+    if (tail > 0) {
+        munmap((void*)(start + len), tail);
+    }
+    return (void*)start;
+}
+
+buffer_map
+map_buffer(size_t size) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg) {
+        dsd_neo_config_init(NULL);
+        cfg = dsd_neo_get_config();
+    }
+    int want_hugetlb = cfg ? cfg->mem_hugepages_enable : 0;
+    int want_prefault = cfg ? cfg->mem_prefault_enable : 1;
+    int want_lock = cfg ? cfg->mem_lock_enable : 0;
+
+    buffer_map m = {NULL, 0, 0, 0};
+#ifdef MAP_HUGETLB
+    size_t hp = want_hugetlb ? hugetlb_page_size() : 0;
+    if (hp > 0) {
+        size_t len = round_up(size, hp);
+        void* p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            m.ptr = p;
+            m.len = len;
+            m.hugetlb = 1;
+        }
+    }
+#else
+    (void)want_hugetlb;
+#endif
+    if (!m.ptr) {
+        size_t len = round_up(size, page_size());
+        /* THP can only back 2 MiB-aligned extents of the mapping. */
+        size_t align = (len >= kThpSize) ? kThpSize : page_size();
+        void* p = map_aligned(len, align);
+        if (!p) {
+            return m;
+        }
+        m.ptr = p;
+        m.len = len;
+#ifdef MADV_HUGEPAGE
+        if (len >= kThpSize) {
+            (void)madvise(p, len, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    if (want_prefault) {
+        /* First touch from this thread also places the pages on its NUMA node. */
+        size_t step = m.hugetlb ? hugetlb_page_size() : page_size();
+        volatile unsigned char* c = (volatile unsigned char*)m.ptr;
+        for (size_t off = 0; off < m.len; off += step) {
+            c[off] = 0;
+        }
+    }
+    if (want_lock) {
+        if (mlock(m.ptr, m.len) == 0) {
+            m.locked = 1;
+        } else if (!g_lock_warned) {
+            g_lock_warned = 1;
+            LOG_WARNING("mlock of %zu-byte DSP buffer failed (raise RLIMIT_MEMLOCK or grant CAP_IPC_LOCK).\n",
+                        m.len);
+        }
+    }
+    g_mapped++;
+    return m;
+}
+
+void
+unmap_buffer(const buffer_map* m) {
+    if (m->locked) {
+        (void)munlock(m->ptr, m->len);
+    }
+    munmap(m->ptr, m->len);
+}
+
+} // namespace
+
+/**
+ * @brief Allocate a large, long-lived DSP buffer.
+ *
+ * Serves large requests from the pool of freed mappings when one fits
+ * (between the request and twice its size), else maps a new region.
+ *
+ * @param size Number of bytes to allocate.
+ * @return Pointer to the buffer, or NULL on failure or when `size` is 0.
+ */
+void*
+dsd_neo_buffer_malloc(size_t size) {
+    if (size < DSD_NEO_BUFFER_MAP_MIN) {
+        return dsd_neo_aligned_malloc(size);
+    }
+    std::lock_guard<std::mutex> lock(g_buf_mu);
+    if (g_live_count >= kMaxLiveMaps) {
+        return dsd_neo_aligned_malloc(size);
+    }
+    size_t want = round_up(size, page_size());
+    int best = -1;
+    for (int i = 0; i < g_pool_count; i++) {
+        size_t len = g_pool[i].len;
+        if (len >= want && len / 2 <= want && (best < 0 || len < g_pool[best].len)) {
+            best = i;
+        }
+    }
+    buffer_map m;
+    if (best >= 0) {
+        m = g_pool[best];
+        g_pool[best] = g_pool[--g_pool_count];
+        g_reused++;
+    } else {
+        m = map_buffer(size);
+        if (!m.ptr) {
+            return dsd_neo_aligned_malloc(size);
+        }
+    }
+    g_live[g_live_count++] = m;
+    return m.ptr;
+}
+
+/**
+ * @brief Release a buffer from `dsd_neo_buffer_malloc`.
+ *
+ * Mappings go back to the pool while it has room (up to 8 mappings and
+ * 64 MiB); anything else is unmapped or freed.
+ *
+ * @param ptr Pointer previously returned by `dsd_neo_buffer_malloc`.
+ */
+void
+dsd_neo_buffer_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_buf_mu);
+    int idx = -1;
+    for (int i = 0; i < g_live_count; i++) {
+        if (g_live[i].ptr == ptr) {
+            idx = i;
+            break;
+        }
+    }
+    if (idx < 0) {
+        dsd_neo_aligned_free(ptr);
+        return;
+    }
+    buffer_map m = g_live[idx];
+    g_live[idx] = g_live[--g_live_count];
+    size_t pooled = 0;
+    for (int i = 0; i < g_pool_count; i++) {
+        pooled += g_pool[i].len;
+    }
+    if (g_pool_count < kMaxPooledMaps && pooled + m.len <= kMaxPooledBytes) {
+        g_pool[g_pool_count++] = m;
+    } else {
+        unmap_buffer(&m);
+    }
+}
+
+/**
+ * @brief Unmap every pooled (free) buffer mapping.
+ */
+void
+dsd_neo_buffer_trim(void) {
+    std::lock_guard<std::mutex> lock(g_buf_mu);
+    for (int i = 0; i < g_pool_count; i++) {
+        unmap_buffer(&g_pool[i]);
+    }
+    g_pool_count = 0;
+}
+
+/**
+ * @brief Snapshot of the buffer pool.
+ *
+ * @param out Receives the counters.
+ */
+void
+dsd_neo_buffer_get_stats(dsd_neo_buffer_stats* out) {
+    if (!out) {
+        return;
+    }
+    std::memset(out, 0, sizeof(*out));
+    std::lock_guard<std::mutex> lock(g_buf_mu);
+    for (int i = 0; i < g_live_count; i++) {
+        out->live_bytes += g_live[i].len;
+        out->live_maps++;
+        out->hugetlb_maps += g_live[i].hugetlb ? 1u : 0u;
+        out->locked_maps += g_live[i].locked ? 1u : 0u;
+    }
+    for (int i = 0; i < g_pool_count; i++) {
+        out->pooled_bytes += g_pool[i].len;
+        out->pooled_maps++;
+        out->hugetlb_maps += g_pool[i].hugetlb ? 1u : 0u;
+        out->locked_maps += g_pool[i].locked ? 1u : 0u;
+    }
+    out->mapped = g_mapped;
+    out->reused = g_reused;
+}
+
+#else /* DSD_PLATFORM_WIN_NATIVE */
+
+void*
+dsd_neo_buffer_malloc(size_t size) {
+    return dsd_neo_aligned_malloc(size);
+}
+
+void
+dsd_neo_buffer_free(void* ptr) {
+    dsd_neo_aligned_free(ptr);
+}
+
+void
+dsd_neo_buffer_trim(void) {}
+
+void
+dsd_neo_buffer_get_stats(dsd_neo_buffer_stats* out) {
+    if (out) {
+        std::memset(out, 0, sizeof(*out));
+    }
+}
+
+#endif /* DSD_PLATFORM_WIN_NATIVE */
@@ -3,32 +3,128 @@
  * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
  */
 
+/*
+ * head/tail are free-running frame counters; the storage index is the counter
+ * masked by a power-of-two capacity of at least depth + 2. Only the producer
+ * advances tail. Both sides advance head with a CAS: the producer to evict
+ * the oldest frame when full, the consumer to claim it. The consumer copies
+ * the frame out before its CAS, seqlock style: the producer can only write
+ * that storage after evicting it (moving head past it), which makes the
+ * consumer's CAS fail and the copy be retried on the next frame.
+ */
+
 #include <dsd-neo/runtime/p25_p2_audio_ring.h>
 
-#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/platform/atomic_compat.h>
+#include <dsd-neo/platform/timing.h>
+#include <dsd-neo/runtime/config.h>
 
+#include <stdlib.h>
 #include <string.h>
 
+#define P25_P2_RING_FRAME 160
+#define P25_P2_RING_SLOTS 16 /* >= P25_P2_AUDIO_RING_MAX_DEPTH + 2, power of two */
+
+typedef struct {
+    atomic_int head;
+    atomic_int tail;
+    atomic_int pushed;
+    atomic_int popped;
+    atomic_int overruns;
+    atomic_int underruns;
+    atomic_int flushed;
+    atomic_int high_water;
+    int depth;
+    unsigned mask;
+    uint64_t ts_ns[P25_P2_RING_SLOTS];
+    float frames[P25_P2_RING_SLOTS][P25_P2_RING_FRAME];
+} p25_p2_ring;
+
+typedef struct {
+    p25_p2_ring slot[2];
+} p25_p2_rings;
+
+static int
+ring_depth_from_config(void) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    int depth = (cfg && cfg->p25p2_jitter_depth_is_set) ? cfg->p25p2_jitter_depth : 3;
+    if (depth < 1) {
+        depth = 1;
+    }
+    if (depth > P25_P2_AUDIO_RING_MAX_DEPTH) {
+        depth = P25_P2_AUDIO_RING_MAX_DEPTH;
+    }
+    return depth;
+}
+
+static p25_p2_rings*
+rings_get(const dsd_state* state) {
+    return state ? DSD_STATE_EXT_GET_AS(p25_p2_rings, (dsd_state*)state, DSD_STATE_EXT_PROTO_P25_P2_AUDIO_RING) : NULL;
+}
+
+/* Producer side only: consumers never create the rings. */
+static p25_p2_rings*
+rings_get_or_create(dsd_state* state) {
+    p25_p2_rings* r = rings_get(state);
+    if (r) {
+        return r;
+    }
+    r = (p25_p2_rings*)calloc(1, sizeof(*r));
+    if (!r) {
+        return NULL;
+    }
+    int depth = ring_depth_from_config();
+    unsigned cap = 1;
+    while (cap < (unsigned)depth + 2u) {
+        cap <<= 1;
+    }
+    for (int s = 0; s < 2; s++) {
+        atomic_store(&r->slot[s].head, 0);
+        atomic_store(&r->slot[s].tail, 0);
+        r->slot[s].depth = depth;
+        r->slot[s].mask = cap - 1u;
+    }
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_PROTO_P25_P2_AUDIO_RING, r, free) != 0) {
+        free(r);
+        return NULL;
+    }
+    return r;
+}
+
+static unsigned
+ring_fill(p25_p2_ring* ring) {
+    unsigned h = (unsigned)atomic_load(&ring->head);
+    unsigned t = (unsigned)atomic_load(&ring->tail);
+    unsigned n = t - h;
+    /* head is read first, so a stale head can only overstate the fill */
+    return (n > (unsigned)ring->depth) ? (unsigned)ring->depth : n;
+}
+
+static void
+ring_flush(p25_p2_ring* ring) {
+    int t = atomic_load(&ring->tail);
+    int h = atomic_load(&ring->head);
+    while (h != t) {
+        if (atomic_compare_exchange_strong(&ring->head, &h, t)) {
+            atomic_fetch_add(&ring->flushed, (int)((unsigned)t - (unsigned)h));
+            break;
+        }
+    }
+}
+
 void
 p25_p2_audio_ring_reset(dsd_state* state, int slot) {
-    if (!state) {
+    p25_p2_rings* r = rings_get(state);
+    if (!r) {
         return;
     }
-
     if (slot < 0 || slot > 1) {
-        for (int s = 0; s < 2; s++) {
-            state->p25_p2_audio_ring_head[s] = 0;
-            state->p25_p2_audio_ring_tail[s] = 0;
-            state->p25_p2_audio_ring_count[s] = 0;
-        }
-        memset(state->p25_p2_audio_ring, 0, sizeof state->p25_p2_audio_ring);
+        ring_flush(&r->slot[0]);
+        ring_flush(&r->slot[1]);
         return;
     }
-
-    state->p25_p2_audio_ring_head[slot] = 0;
-    state->p25_p2_audio_ring_tail[slot] = 0;
-    state->p25_p2_audio_ring_count[slot] = 0;
-    memset(state->p25_p2_audio_ring[slot], 0, sizeof state->p25_p2_audio_ring[slot]);
+    ring_flush(&r->slot[slot]);
 }
 
 int
@@ -36,16 +132,65 @@ p25_p2_audio_ring_push(dsd_state* state, int slot, const float* frame160) {
     if (!state || !frame160 || slot < 0 || slot > 1) {
         return 0;
     }
+    p25_p2_rings* r = rings_get_or_create(state);
+    if (!r) {
+        return 0;
+    }
+    p25_p2_ring* ring = &r->slot[slot];
 
-    if (state->p25_p2_audio_ring_count[slot] >= 3) {
-        state->p25_p2_audio_ring_head[slot] = (state->p25_p2_audio_ring_head[slot] + 1) % 3;
-        state->p25_p2_audio_ring_count[slot]--;
+    int t = atomic_load(&ring->tail);
+    int h = atomic_load(&ring->head);
+    while ((unsigned)t - (unsigned)h >= (unsigned)ring->depth) {
+        if (atomic_compare_exchange_strong(&ring->head, &h, (int)((unsigned)h + 1u))) {
+            atomic_fetch_add(&ring->overruns, 1);
+            h = (int)((unsigned)h + 1u);
+        }
     }
 
-    int idx = state->p25_p2_audio_ring_tail[slot];
-    memcpy(state->p25_p2_audio_ring[slot][idx], frame160, 160U * sizeof(*frame160));
-    state->p25_p2_audio_ring_tail[slot] = (state->p25_p2_audio_ring_tail[slot] + 1) % 3;
-    state->p25_p2_audio_ring_count[slot]++;
+    unsigned idx = (unsigned)t & ring->mask;
+    memcpy(ring->frames[idx], frame160, P25_P2_RING_FRAME * sizeof(*frame160));
+    ring->ts_ns[idx] = dsd_time_monotonic_ns();
+    atomic_store(&ring->tail, (int)((unsigned)t + 1u));
+    atomic_fetch_add(&ring->pushed, 1);
+
+    int fill = (int)((unsigned)t + 1u - (unsigned)h);
+    if (fill > atomic_load(&ring->high_water)) {
+        atomic_store(&ring->high_water, fill);
+    }
+    return 1;
+}
+
+int
+p25_p2_audio_ring_read(dsd_state* state, int slot, float* out160, uint64_t* ts_ns) {
+    if (!out160 || slot < 0 || slot > 1) {
+        return 0;
+    }
+    p25_p2_rings* r = rings_get(state);
+    if (!r) {
+        return 0;
+    }
+    p25_p2_ring* ring = &r->slot[slot];
+
+    int h = atomic_load(&ring->head);
+    uint64_t ts = 0;
+    for (;;) {
+        int t = atomic_load(&ring->tail);
+        if (h == t) {
+            atomic_fetch_add(&ring->underruns, 1);
+            return 0;
+        }
+        unsigned idx = (unsigned)h & ring->mask;
+        memcpy(out160, ring->frames[idx], P25_P2_RING_FRAME * sizeof(*out160));
+        ts = ring->ts_ns[idx];
+        /* Success means frame h was not evicted, so the producer has not reused its storage. */
+        if (atomic_compare_exchange_strong(&ring->head, &h, (int)((unsigned)h + 1u))) {
+            break;
+        }
+    }
+    atomic_fetch_add(&ring->popped, 1);
+    if (ts_ns) {
+        *ts_ns = ts;
+    }
     return 1;
 }
 
@@ -54,15 +199,39 @@ p25_p2_audio_ring_pop(dsd_state* state, int slot, float* out160) {
     if (!state || !out160 || slot < 0 || slot > 1) {
         return 0;
     }
+    if (!p25_p2_audio_ring_read(state, slot, out160, NULL)) {
+        memset(out160, 0, P25_P2_RING_FRAME * sizeof(*out160));
+        return 0;
+    }
+    return 1;
+}
 
-    if (state->p25_p2_audio_ring_count[slot] <= 0) {
-        memset(out160, 0, 160U * sizeof(*out160));
+int
+p25_p2_audio_ring_count(const dsd_state* state, int slot) {
+    p25_p2_rings* r = rings_get(state);
+    if (!r || slot < 0 || slot > 1) {
         return 0;
     }
+    return (int)ring_fill(&r->slot[slot]);
+}
 
-    int idx = state->p25_p2_audio_ring_head[slot];
-    memcpy(out160, state->p25_p2_audio_ring[slot][idx], 160U * sizeof(*out160));
-    state->p25_p2_audio_ring_head[slot] = (state->p25_p2_audio_ring_head[slot] + 1) % 3;
-    state->p25_p2_audio_ring_count[slot]--;
-    return 1;
+void
+p25_p2_audio_ring_get_stats(const dsd_state* state, int slot, p25_p2_audio_ring_stats* out) {
+    if (!out) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    p25_p2_rings* r = rings_get(state);
+    if (!r || slot < 0 || slot > 1) {
+        return;
+    }
+    p25_p2_ring* ring = &r->slot[slot];
+    out->depth = ring->depth;
+    out->count = (int)ring_fill(ring);
+    out->high_water = atomic_load(&ring->high_water);
+    out->pushed = (uint32_t)atomic_load(&ring->pushed);
+    out->popped = (uint32_t)atomic_load(&ring->popped);
+    out->overruns = (uint32_t)atomic_load(&ring->overruns);
+    out->underruns = (uint32_t)atomic_load(&ring->underruns);
+    out->flushed = (uint32_t)atomic_load(&ring->flushed);
 }
@@ -13,6 +13,7 @@
 
 #include <cstring>
 #include <dsd-neo/platform/threading.h>
+#include <dsd-neo/runtime/control_pump.h>
 #include <dsd-neo/runtime/ring.h>
 #include <errno.h>
 
@@ -208,6 +209,8 @@ ring_read_one(struct output_state* o, float* out) {
             }
             /* Metrics: consumer timed out waiting for data */
             o->read_timeouts.fetch_add(1);
+            /* Input stalled: let posted decoder-thread work run */
+            dsd_runtime_pump_input_wait();
             /* Timeout: check again */
             continue;
         }
@@ -261,6 +264,8 @@ ring_read_batch(struct output_state* o, float* out, size_t max_count) {
             }
             /* Metrics: consumer timed out waiting for data */
             o->read_timeouts.fetch_add(1);
+            /* Input stalled: let posted decoder-thread work run */
+            dsd_runtime_pump_input_wait();
             /* Timeout: check again */
             continue;
         }
@@ -0,0 +1,807 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Buffered symbol capture/replay streams.
+ *
+ * Header layout (little-endian, DSD_SYMBOL_FILE_HEADER_SIZE bytes):
+ *   0  magic "DSDNSYM\x1a"
+ *   8  u16 version
+ *  10  u8  format
+ *  11  u8  modulation
+ *  12  u32 symbol rate
+ *  16  i64 start time (unix ns)
+ *  24  u32 header size (payload starts here; lets later versions grow)
+ *  28  u32 reserved
+ *
+ * Version 2 payload is a sequence of chunks, each an index record followed by
+ * `payload_len` dibit bytes. Index record (DSD_SYMBOL_INDEX_RECORD_SIZE bytes):
+ *   0  tag 0xFE 'I' 'X' 0x00 (0xFE never occurs as a dibit value)
+ *   4  u32 payload length
+ *   8  u64 symbol offset
+ *  16  u64 byte offset of this record
+ *  24  i64 wall-clock time (unix ns)
+ *  32  i64 frequency (Hz)
+ *  40  i32 sync type
+ *  44  u32 flags
+ */
+
+#include <dsd-neo/runtime/symbol_file.h>
+
+#include <dsd-neo/core/opts.h>
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/platform/timing.h>
+#include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SYMBOL_FILE_BUF_BYTES (64u * 1024u)
+
+static const uint8_t k_symbol_file_magic[8] = {'D', 'S', 'D', 'N', 'S', 'Y', 'M', 0x1A};
+static const uint8_t k_symbol_index_tag[4] = {0xFE, 'I', 'X', 0x00};
+
+struct dsd_symbol_reader {
+    FILE* f;
+    int format;
+    int has_header;
+    int indexed;
+    dsd_symbol_file_header hdr;
+    long data_start;
+    int have_chunk;
+    dsd_symbol_index_record chunk;
+    size_t chunk_left;
+    uint64_t count;
+    size_t pos;
+    size_t len;
+    uint8_t buf[SYMBOL_FILE_BUF_BYTES];
+};
+
+struct dsd_symbol_writer {
+    FILE* f;
+    int indexed;
+    uint32_t symbol_rate;
+    uint64_t file_off;
+    uint64_t symbols;
+    int chunk_open;
+    dsd_symbol_index_record chunk;
+    size_t len;
+    uint8_t buf[SYMBOL_FILE_BUF_BYTES];
+};
+
+static void
+put_le16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void
+put_le32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static void
+put_le64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint32_t
+get_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t
+get_le64(const uint8_t* p) {
+    return (uint64_t)get_le32(p) | ((uint64_t)get_le32(p + 4) << 32);
+}
+
+size_t
+dsd_symbol_file_header_encode(const dsd_symbol_file_header* hdr, uint8_t out[DSD_SYMBOL_FILE_HEADER_SIZE]) {
+    memset(out, 0, DSD_SYMBOL_FILE_HEADER_SIZE);
+    memcpy(out, k_symbol_file_magic, sizeof k_symbol_file_magic);
+    put_le16(out + 8, hdr->version);
+    out[10] = hdr->format;
+    out[11] = hdr->modulation;
+    put_le32(out + 12, hdr->symbol_rate);
+    put_le64(out + 16, (uint64_t)hdr->start_unix_ns);
+    put_le32(out + 24, DSD_SYMBOL_FILE_HEADER_SIZE);
+    return DSD_SYMBOL_FILE_HEADER_SIZE;
+}
+
+int
+dsd_symbol_file_header_decode(const uint8_t* in, size_t len, dsd_symbol_file_header* hdr) {
+    if (!in || len < DSD_SYMBOL_FILE_HEADER_SIZE || memcmp(in, k_symbol_file_magic, sizeof k_symbol_file_magic) != 0) {
+        return 0;
+    }
+    if (get_le32(in + 24) < DSD_SYMBOL_FILE_HEADER_SIZE) {
+        return 0;
+    }
+    if (hdr) {
+        hdr->version = (uint16_t)(in[8] | (in[9] << 8));
+        hdr->format = in[10];
+        hdr->modulation = in[11];
+        hdr->symbol_rate = get_le32(in + 12);
+        hdr->start_unix_ns = (int64_t)get_le64(in + 16);
+    }
+    return 1;
+}
+
+static void
+index_record_encode(const dsd_symbol_index_record* rec, uint8_t out[DSD_SYMBOL_INDEX_RECORD_SIZE]) {
+    memcpy(out, k_symbol_index_tag, sizeof k_symbol_index_tag);
+    put_le32(out + 4, rec->payload_len);
+    put_le64(out + 8, rec->symbol_offset);
+    put_le64(out + 16, rec->byte_offset);
+    put_le64(out + 24, (uint64_t)rec->wall_unix_ns);
+    put_le64(out + 32, (uint64_t)rec->freq_hz);
+    put_le32(out + 40, (uint32_t)rec->synctype);
+    put_le32(out + 44, rec->flags);
+}
+
+static int
+index_record_decode(const uint8_t* in, dsd_symbol_index_record* rec) {
+    if (memcmp(in, k_symbol_index_tag, sizeof k_symbol_index_tag) != 0) {
+        return 0;
+    }
+    rec->payload_len = get_le32(in + 4);
+    rec->symbol_offset = get_le64(in + 8);
+    rec->byte_offset = get_le64(in + 16);
+    rec->wall_unix_ns = (int64_t)get_le64(in + 24);
+    rec->freq_hz = (int64_t)get_le64(in + 32);
+    rec->synctype = (int32_t)get_le32(in + 40);
+    rec->flags = get_le32(in + 44);
+    return 1;
+}
+
+/* Top up the buffer, keeping any unread tail (partial float/record) at the front. */
+static size_t
+reader_fill(dsd_symbol_reader* r) {
+    size_t keep = r->len - r->pos;
+    if (keep > 0 && r->pos > 0) {
+        memmove(r->buf, r->buf + r->pos, keep);
+    }
+    r->pos = 0;
+    r->len = keep;
+    size_t got = fread(r->buf + keep, 1, sizeof r->buf - keep, r->f);
+    r->len += got;
+    return got;
+}
+
+static int
+reader_need(dsd_symbol_reader* r, size_t n) {
+    while (r->len - r->pos < n) {
+        if (reader_fill(r) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Contiguous payload bytes available at r->pos, stepping over index records; 0 at EOF. */
+static size_t
+reader_payload_avail(dsd_symbol_reader* r) {
+    while (r->indexed && r->chunk_left == 0) {
+        if (!reader_need(r, DSD_SYMBOL_INDEX_RECORD_SIZE) || !index_record_decode(r->buf + r->pos, &r->chunk)) {
+            return 0;
+        }
+        r->pos += DSD_SYMBOL_INDEX_RECORD_SIZE;
+        r->have_chunk = 1;
+        r->chunk_left = r->chunk.payload_len;
+    }
+    if (r->pos == r->len && reader_fill(r) == 0) {
+        return 0;
+    }
+    size_t avail = r->len - r->pos;
+    if (r->indexed && avail > r->chunk_left) {
+        avail = r->chunk_left;
+    }
+    return avail;
+}
+
+static void
+reader_consume(dsd_symbol_reader* r, size_t n) {
+    r->pos += n;
+    if (r->indexed) {
+        r->chunk_left -= n;
+    }
+    r->count += n;
+}
+
+dsd_symbol_reader*
+dsd_symbol_reader_attach(FILE* f, dsd_symbol_format format) {
+    if (!f) {
+        return NULL;
+    }
+    dsd_symbol_reader* r = (dsd_symbol_reader*)calloc(1, sizeof(*r));
+    if (!r) {
+        return NULL;
+    }
+    r->f = f;
+    r->format = (int)format;
+
+    if (format == DSD_SYMBOL_FMT_DIBIT && ftell(f) == 0) {
+        (void)reader_need(r, DSD_SYMBOL_FILE_HEADER_SIZE);
+        if (dsd_symbol_file_header_decode(r->buf, r->len, &r->hdr)) {
+            uint32_t hsz = get_le32(r->buf + 24);
+            r->has_header = 1;
+            r->indexed = (r->hdr.version >= 2);
+            r->pos = (hsz <= r->len) ? hsz : r->len;
+            r->data_start = (long)hsz;
+        }
+    }
+    return r;
+}
+
+void
+dsd_symbol_reader_free(dsd_symbol_reader* r) {
+    free(r);
+}
+
+const dsd_symbol_file_header*
+dsd_symbol_reader_header(const dsd_symbol_reader* r) {
+    return (r && r->has_header) ? &r->hdr : NULL;
+}
+
+const dsd_symbol_index_record*
+dsd_symbol_reader_chunk(const dsd_symbol_reader* r) {
+    return (r && r->have_chunk) ? &r->chunk : NULL;
+}
+
+size_t
+dsd_symbol_reader_read_dibits(dsd_symbol_reader* r, uint8_t* out, size_t n) {
+    if (!r || !out) {
+        return 0;
+    }
+    size_t done = 0;
+    while (done < n) {
+        size_t take = reader_payload_avail(r);
+        if (take == 0) {
+            break;
+        }
+        if (take > n - done) {
+            take = n - done;
+        }
+        memcpy(out + done, r->buf + r->pos, take);
+        reader_consume(r, take);
+        done += take;
+    }
+    return done;
+}
+
+int
+dsd_symbol_reader_next_dibit(dsd_symbol_reader* r) {
+    if (!r || reader_payload_avail(r) == 0) {
+        return -1;
+    }
+    int d = r->buf[r->pos];
+    reader_consume(r, 1);
+    return d;
+}
+
+size_t
+dsd_symbol_reader_read_floats(dsd_symbol_reader* r, float* out, size_t n) {
+    if (!r || !out) {
+        return 0;
+    }
+    size_t done = 0;
+    while (done < n) {
+        if (r->len - r->pos < sizeof(float)) {
+            if (reader_fill(r) == 0) {
+                break; /* EOF; a trailing partial float is dropped */
+            }
+            continue;
+        }
+        size_t avail = (r->len - r->pos) / sizeof(float);
+        if (avail > n - done) {
+            avail = n - done;
+        }
+        memcpy(out + done, r->buf + r->pos, avail * sizeof(float));
+        r->pos += avail * sizeof(float);
+        done += avail;
+    }
+    r->count += done;
+    return done;
+}
+
+uint64_t
+dsd_symbol_reader_count(const dsd_symbol_reader* r) {
+    return r ? r->count : 0;
+}
+
+static int
+read_record_at(FILE* f, long off, dsd_symbol_index_record* rec) {
+    uint8_t raw[DSD_SYMBOL_INDEX_RECORD_SIZE];
+    if (fseek(f, off, SEEK_SET) != 0 || fread(raw, 1, sizeof raw, f) != sizeof raw) {
+        return 0;
+    }
+    return index_record_decode(raw, rec);
+}
+
+/* Drop buffered data and continue reading at the index record at `off`. */
+static void
+reader_position(dsd_symbol_reader* r, long off, const dsd_symbol_index_record* rec) {
+    (void)fseek(r->f, off, SEEK_SET);
+    r->pos = 0;
+    r->len = 0;
+    r->chunk_left = 0;
+    r->have_chunk = 0;
+    r->count = rec->symbol_offset;
+}
+
+/*
+ * Walk the record chain from the first chunk. `mode` 0 picks the last chunk
+ * starting at or before `t` (or the first chunk); mode 1 picks the first sync
+ * event at or after `t` matching `synctype`.
+ */
+static int
+reader_seek(dsd_symbol_reader* r, int mode, int64_t t, int synctype) {
+    if (!r || !r->indexed) {
+        return -1;
+    }
+    long save = ftell(r->f);
+    if (save < 0) {
+        return -1;
+    }
+    dsd_symbol_index_record rec, best;
+    long off = r->data_start;
+    long best_off = -1;
+    while (read_record_at(r->f, off, &rec)) {
+        if (mode == 0) {
+            if (best_off >= 0 && rec.wall_unix_ns > t) {
+                break;
+            }
+            best = rec;
+            best_off = off;
+            if (rec.wall_unix_ns > t) {
+                break;
+            }
+        } else if (rec.wall_unix_ns >= t
+                   && (synctype < 0 ? (rec.flags & DSD_SYMBOL_INDEX_SYNC) != 0 : rec.synctype == synctype)) {
+            best = rec;
+            best_off = off;
+            break;
+        }
+        off += DSD_SYMBOL_INDEX_RECORD_SIZE + (long)rec.payload_len;
+    }
+    if (best_off < 0) {
+        (void)fseek(r->f, save, SEEK_SET);
+        return -1;
+    }
+    reader_position(r, best_off, &best);
+    return 0;
+}
+
+int
+dsd_symbol_reader_seek_time(dsd_symbol_reader* r, int64_t unix_ns) {
+    return reader_seek(r, 0, unix_ns, 0);
+}
+
+int
+dsd_symbol_reader_seek_sync(dsd_symbol_reader* r, int synctype, int64_t from_unix_ns) {
+    return reader_seek(r, 1, from_unix_ns, synctype);
+}
+
+dsd_symbol_writer*
+dsd_symbol_writer_attach(FILE* f, const dsd_symbol_file_header* hdr) {
+    if (!f) {
+        return NULL;
+    }
+    dsd_symbol_writer* w = (dsd_symbol_writer*)calloc(1, sizeof(*w));
+    if (!w) {
+        return NULL;
+    }
+    w->f = f;
+    long at = ftell(f);
+    w->file_off = (at > 0) ? (uint64_t)at : 0;
+    if (hdr) {
+        uint8_t raw[DSD_SYMBOL_FILE_HEADER_SIZE];
+        size_t n = dsd_symbol_file_header_encode(hdr, raw);
+        w->file_off += fwrite(raw, 1, n, f);
+        w->indexed = (hdr->version >= 2);
+        w->symbol_rate = hdr->symbol_rate;
+        w->chunk.wall_unix_ns = hdr->start_unix_ns;
+        w->chunk.synctype = DSD_SYNC_NONE;
+    }
+    return w;
+}
+
+int
+dsd_symbol_writer_flush(dsd_symbol_writer* w) {
+    if (!w || w->len == 0) {
+        return 0;
+    }
+    if (w->indexed) {
+        w->chunk_open = 0;
+        if (w->len == DSD_SYMBOL_INDEX_RECORD_SIZE) {
+            w->len = 0; /* empty chunk */
+            return 0;
+        }
+        w->chunk.payload_len = (uint32_t)(w->len - DSD_SYMBOL_INDEX_RECORD_SIZE);
+        index_record_encode(&w->chunk, w->buf);
+    }
+    size_t wrote = fwrite(w->buf, 1, w->len, w->f);
+    int rc = (wrote == w->len) ? 0 : -1;
+    w->file_off += wrote;
+    w->len = 0;
+    return rc;
+}
+
+static void
+writer_chunk_begin(dsd_symbol_writer* w, int64_t wall_unix_ns, int64_t freq_hz, int synctype, uint32_t flags) {
+    w->chunk.symbol_offset = w->symbols;
+    w->chunk.byte_offset = w->file_off;
+    w->chunk.wall_unix_ns = wall_unix_ns;
+    w->chunk.freq_hz = freq_hz;
+    w->chunk.synctype = synctype;
+    w->chunk.flags = flags;
+    w->chunk.payload_len = 0;
+    w->len = DSD_SYMBOL_INDEX_RECORD_SIZE;
+    w->chunk_open = 1;
+}
+
+/* Make room for at least one payload byte, cutting a continuation chunk when full. */
+static void
+writer_reserve(dsd_symbol_writer* w) {
+    if (w->len == sizeof w->buf) {
+        (void)dsd_symbol_writer_flush(w);
+    }
+    if (w->indexed && !w->chunk_open) {
+        int64_t wall = w->chunk.wall_unix_ns;
+        if (w->symbol_rate > 0) {
+            wall += (int64_t)((w->symbols - w->chunk.symbol_offset) * 1000000000ULL / w->symbol_rate);
+        }
+        writer_chunk_begin(w, wall, w->chunk.freq_hz, w->chunk.synctype, 0);
+    }
+}
+
+void
+dsd_symbol_writer_free(dsd_symbol_writer* w) {
+    if (!w) {
+        return;
+    }
+    (void)dsd_symbol_writer_flush(w);
+    fflush(w->f);
+    free(w);
+}
+
+void
+dsd_symbol_writer_put(dsd_symbol_writer* w, uint8_t dibit) {
+    if (!w) {
+        return;
+    }
+    writer_reserve(w);
+    w->buf[w->len++] = dibit;
+    w->symbols++;
+}
+
+void
+dsd_symbol_writer_write(dsd_symbol_writer* w, const uint8_t* dibits, size_t n) {
+    if (!w || !dibits) {
+        return;
+    }
+    while (n > 0) {
+        writer_reserve(w);
+        size_t take = sizeof w->buf - w->len;
+        if (take > n) {
+            take = n;
+        }
+        memcpy(w->buf + w->len, dibits, take);
+        w->len += take;
+        w->symbols += take;
+        dibits += take;
+        n -= take;
+    }
+}
+
+void
+dsd_symbol_writer_mark(dsd_symbol_writer* w, int64_t wall_unix_ns, int64_t freq_hz, int synctype, uint32_t flags) {
+    if (!w || !w->indexed) {
+        return;
+    }
+    (void)dsd_symbol_writer_flush(w);
+    writer_chunk_begin(w, wall_unix_ns, freq_hz, synctype, flags);
+}
+
+/*
+ * Decoder bindings
+ */
+
+typedef struct symbol_file_binding {
+    dsd_symbol_reader* reader;
+    FILE* reader_f;
+    unsigned int reader_gen; /* opts->symbolfile_gen at attach */
+    int reader_format;
+    uint64_t start_ns;
+    uint64_t start_count;
+    uint64_t next_report;
+    dsd_symbol_writer* writer;
+    FILE* writer_f;
+    int out_indexed;
+    int out_sync;
+    int64_t out_freq;
+    uint64_t out_symbols;
+    uint64_t out_last_mark;
+    uint64_t out_period;
+} symbol_file_binding;
+
+static void
+symbol_file_binding_free(void* ptr) {
+    symbol_file_binding* b = (symbol_file_binding*)ptr;
+    if (!b) {
+        return;
+    }
+    dsd_symbol_reader_free(b->reader);
+    dsd_symbol_writer_free(b->writer);
+    free(b);
+}
+
+static symbol_file_binding*
+symbol_file_binding_get(dsd_state* state) {
+    if (!state) {
+        return NULL;
+    }
+    symbol_file_binding* b = DSD_STATE_EXT_GET_AS(symbol_file_binding, state, DSD_STATE_EXT_IO_SYMBOL_FILE);
+    if (b) {
+        return b;
+    }
+    b = (symbol_file_binding*)calloc(1, sizeof(*b));
+    if (!b) {
+        return NULL;
+    }
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_IO_SYMBOL_FILE, b, symbol_file_binding_free) != 0) {
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+static uint32_t
+symbol_rate_nominal(const dsd_opts* opts, const dsd_state* state) {
+    int fs_hz = (opts->rtl_dsp_bw_khz > 0) ? opts->rtl_dsp_bw_khz * 1000 : 48000;
+    if (state->samplesPerSymbol <= 0) {
+        return 0;
+    }
+    return (uint32_t)(fs_hz / state->samplesPerSymbol);
+}
+
+/* Apply DSD_NEO_SYMBOL_SEEK / DSD_NEO_SYMBOL_SEEK_SYNC to a freshly attached reader. */
+static void
+symbol_in_apply_seek(dsd_symbol_reader* r) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    const dsd_symbol_file_header* hdr = dsd_symbol_reader_header(r);
+    if (!cfg || !hdr || (!cfg->symbol_seek_is_set && !cfg->symbol_seek_sync_is_set)) {
+        return;
+    }
+    int64_t target = hdr->start_unix_ns;
+    if (cfg->symbol_seek_is_set) {
+        target = (cfg->symbol_seek_s >= 1e9) ? (int64_t)(cfg->symbol_seek_s * 1e9)
+                                             : hdr->start_unix_ns + (int64_t)(cfg->symbol_seek_s * 1e9);
+    }
+    int rc = cfg->symbol_seek_sync_is_set ? dsd_symbol_reader_seek_sync(r, cfg->symbol_seek_sync, target)
+                                          : dsd_symbol_reader_seek_time(r, target);
+    if (rc != 0) {
+        LOG_WARNING("Symbol capture: seek target not found; replaying from the start.\n");
+        return;
+    }
+    /* The chunk record is parsed on the next read; peek it for the log line. */
+    (void)reader_payload_avail(r);
+    const dsd_symbol_index_record* c = dsd_symbol_reader_chunk(r);
+    if (c) {
+        LOG_NOTICE("Symbol capture: seek to +%.3f s (symbol %llu, sync %d, %lld Hz).\n",
+                   (double)(c->wall_unix_ns - hdr->start_unix_ns) / 1e9, (unsigned long long)c->symbol_offset,
+                   (int)c->synctype, (long long)c->freq_hz);
+    }
+}
+
+static dsd_symbol_reader*
+symbol_in_reader(dsd_opts* opts, dsd_state* state, dsd_symbol_format format) {
+    symbol_file_binding* b = symbol_file_binding_get(state);
+    if (!b || !opts->symbolfile) {
+        return NULL;
+    }
+    if (b->reader && b->reader_f == opts->symbolfile && b->reader_gen == opts->symbolfile_gen
+        && b->reader_format == (int)format) {
+        return b->reader;
+    }
+    dsd_symbol_reader_free(b->reader);
+    b->reader = dsd_symbol_reader_attach(opts->symbolfile, format);
+    b->reader_f = opts->symbolfile;
+    b->reader_gen = opts->symbolfile_gen;
+    b->reader_format = (int)format;
+    b->next_report = 0;
+
+    const dsd_symbol_file_header* hdr = dsd_symbol_reader_header(b->reader);
+    if (hdr) {
+        LOG_NOTICE("Symbol capture v%u: %u sym/s, mod %u.\n", (unsigned)hdr->version, (unsigned)hdr->symbol_rate,
+                   (unsigned)hdr->modulation);
+        symbol_in_apply_seek(b->reader);
+    }
+    b->start_ns = dsd_time_monotonic_ns();
+    b->start_count = dsd_symbol_reader_count(b->reader);
+    if (hdr && hdr->symbol_rate > 0) {
+        b->next_report = b->start_count + (uint64_t)hdr->symbol_rate * 60u;
+    }
+    return b->reader;
+}
+
+static void
+symbol_in_maybe_report(dsd_opts* opts, dsd_state* state, symbol_file_binding* b) {
+    if (b->next_report == 0 || dsd_symbol_reader_count(b->reader) < b->next_report) {
+        return;
+    }
+    const dsd_symbol_file_header* hdr = dsd_symbol_reader_header(b->reader);
+    b->next_report += (uint64_t)hdr->symbol_rate * 60u;
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (cfg && cfg->symbol_fast_enable) {
+        dsd_symbol_in_report(opts, state);
+    }
+}
+
+int
+dsd_symbol_in_dibit(dsd_opts* opts, dsd_state* state) {
+    dsd_symbol_reader* r = symbol_in_reader(opts, state, DSD_SYMBOL_FMT_DIBIT);
+    if (!r) {
+        return -1;
+    }
+    int d = dsd_symbol_reader_next_dibit(r);
+    symbol_in_maybe_report(opts, state, DSD_STATE_EXT_GET_AS(symbol_file_binding, state, DSD_STATE_EXT_IO_SYMBOL_FILE));
+    return d;
+}
+
+int
+dsd_symbol_in_float(dsd_opts* opts, dsd_state* state, float* out) {
+    dsd_symbol_reader* r = symbol_in_reader(opts, state, DSD_SYMBOL_FMT_FLOAT32);
+    if (!r || !out) {
+        return 0;
+    }
+    return dsd_symbol_reader_read_floats(r, out, 1) == 1;
+}
+
+void
+dsd_symbol_in_reset(dsd_state* state) {
+    symbol_file_binding* b =
+        state ? DSD_STATE_EXT_GET_AS(symbol_file_binding, state, DSD_STATE_EXT_IO_SYMBOL_FILE) : NULL;
+    if (!b) {
+        return;
+    }
+    dsd_symbol_reader_free(b->reader);
+    b->reader = NULL;
+    b->reader_f = NULL;
+}
+
+void
+dsd_symbol_in_close(dsd_opts* opts) {
+    if (!opts) {
+        return;
+    }
+    if (opts->symbolfile) {
+        fclose(opts->symbolfile);
+        opts->symbolfile = NULL;
+    }
+    opts->symbolfile_gen++;
+}
+
+void
+dsd_symbol_in_report(dsd_opts* opts, dsd_state* state) {
+    symbol_file_binding* b =
+        state ? DSD_STATE_EXT_GET_AS(symbol_file_binding, state, DSD_STATE_EXT_IO_SYMBOL_FILE) : NULL;
+    if (!opts || !b || !b->reader) {
+        return;
+    }
+    const dsd_symbol_file_header* hdr = dsd_symbol_reader_header(b->reader);
+    uint32_t rate = (hdr && hdr->symbol_rate > 0) ? hdr->symbol_rate : symbol_rate_nominal(opts, state);
+    uint64_t n = dsd_symbol_reader_count(b->reader) - b->start_count;
+    double wall_s = (double)(dsd_time_monotonic_ns() - b->start_ns) / 1e9;
+    double signal_s = rate > 0 ? (double)n / (double)rate : 0.0;
+    double xrt = wall_s > 0.0 ? signal_s / wall_s : 0.0;
+    LOG_NOTICE("Symbol replay: %llu symbols, %.1f s of signal in %.1f s (%.1fx real time).\n", (unsigned long long)n,
+               signal_s, wall_s, xrt);
+}
+
+void
+dsd_symbol_out_begin(dsd_opts* opts, dsd_state* state) {
+    symbol_file_binding* b = symbol_file_binding_get(state);
+    if (!b || !opts || !opts->symbol_out_f) {
+        return;
+    }
+    dsd_symbol_writer_free(b->writer);
+
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (cfg && cfg->symbol_legacy_enable) {
+        /* Raw dibits only, readable by tools that predate the header. */
+        b->writer = dsd_symbol_writer_attach(opts->symbol_out_f, NULL);
+        b->writer_f = opts->symbol_out_f;
+        b->out_indexed = 0;
+        return;
+    }
+
+    dsd_symbol_file_header hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.version = DSD_SYMBOL_FILE_VERSION;
+    hdr.format = DSD_SYMBOL_FMT_DIBIT;
+    hdr.modulation = (uint8_t)state->rf_mod;
+    hdr.symbol_rate = symbol_rate_nominal(opts, state);
+    hdr.start_unix_ns = (int64_t)dsd_time_realtime_ns();
+    b->writer = dsd_symbol_writer_attach(opts->symbol_out_f, &hdr);
+    b->writer_f = opts->symbol_out_f;
+    b->out_indexed = 1;
+    b->out_sync = state->synctype;
+    b->out_freq = (int64_t)opts->rtlsdr_center_freq;
+    b->out_symbols = 0;
+    b->out_last_mark = 0;
+    b->out_period = hdr.symbol_rate > 0 ? hdr.symbol_rate : 4800;
+    dsd_symbol_writer_mark(b->writer, hdr.start_unix_ns, b->out_freq, b->out_sync,
+                           b->out_sync >= 0 ? DSD_SYMBOL_INDEX_SYNC : 0);
+}
+
+/* Cut a new indexed chunk on sync acquisition/change, retune, or every out_period symbols. */
+static void
+symbol_out_index(dsd_opts* opts, dsd_state* state, symbol_file_binding* b) {
+    int sync = state->synctype;
+    int64_t freq = (int64_t)opts->rtlsdr_center_freq;
+    uint64_t since = b->out_symbols - b->out_last_mark;
+    uint32_t flags = 0;
+
+    /* Type flips between frames of one transmission are only indexed every ~100 ms. */
+    if (sync >= 0 && sync != b->out_sync && (b->out_sync < 0 || since >= b->out_period / 10)) {
+        flags |= DSD_SYMBOL_INDEX_SYNC;
+    }
+    if (freq != b->out_freq) {
+        flags |= DSD_SYMBOL_INDEX_FREQ;
+    }
+    if (since >= b->out_period) {
+        flags |= DSD_SYMBOL_INDEX_PERIODIC;
+    }
+    b->out_sync = sync;
+    if (flags) {
+        dsd_symbol_writer_mark(b->writer, (int64_t)dsd_time_realtime_ns(), freq, sync, flags);
+        b->out_last_mark = b->out_symbols;
+        b->out_freq = freq;
+    }
+}
+
+void
+dsd_symbol_out_put(dsd_opts* opts, dsd_state* state, int dibit) {
+    if (!opts || !opts->symbol_out_f) {
+        return;
+    }
+    symbol_file_binding* b = symbol_file_binding_get(state);
+    if (!b) {
+        fputc(dibit, opts->symbol_out_f);
+        return;
+    }
+    if (!b->writer || b->writer_f != opts->symbol_out_f) {
+        /* Opened outside openSymbolOutFile: append without a header. */
+        dsd_symbol_writer_free(b->writer);
+        b->writer = dsd_symbol_writer_attach(opts->symbol_out_f, NULL);
+        b->writer_f = opts->symbol_out_f;
+        b->out_indexed = 0;
+    }
+    if (b->out_indexed) {
+        symbol_out_index(opts, state, b);
+    }
+    dsd_symbol_writer_put(b->writer, (uint8_t)dibit);
+    b->out_symbols++;
+}
+
+void
+dsd_symbol_out_end(dsd_state* state) {
+    symbol_file_binding* b =
+        state ? DSD_STATE_EXT_GET_AS(symbol_file_binding, state, DSD_STATE_EXT_IO_SYMBOL_FILE) : NULL;
+    if (!b) {
+        return;
+    }
+    dsd_symbol_writer_free(b->writer);
+    b->writer = NULL;
+    b->writer_f = NULL;
+    b->out_indexed = 0;
+}
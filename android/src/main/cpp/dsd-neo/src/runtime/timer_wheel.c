@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Level L holds timers whose distance from now was in [64^L, 64^(L+1)) when
+ * placed, in slot (expires >> 6L) & 63. Each time now crosses a multiple of
+ * 64^L, that level's slot for the new block is re-placed into the levels
+ * below. Level 0 slot now & 63 never holds a future timer, so it doubles as
+ * the ready list for deadlines that were already due when armed.
+ */
+
+#include <dsd-neo/runtime/timer_wheel.h>
+
+#include <stddef.h>
+#include <string.h>
+
+#define WHEEL_MASK ((uint64_t)DSD_TIMER_WHEEL_SLOTS - 1u)
+#define WHEEL_SPAN ((uint64_t)1 << (DSD_TIMER_WHEEL_BITS * DSD_TIMER_WHEEL_LEVELS))
+
+static uint64_t
+level_span(int level) {
+    return (uint64_t)1 << (DSD_TIMER_WHEEL_BITS * level);
+}
+
+static void
+link_at(dsd_timer_wheel* w, dsd_timer* t, int level, unsigned slot) {
+    dsd_timer** head = &w->slots[level][slot];
+    t->next = *head;
+    if (*head) {
+        (*head)->pprev = &t->next;
+    }
+    *head = t;
+    t->pprev = head;
+    t->level = (int8_t)level;
+    t->slot = (uint8_t)slot;
+    w->occupied[level] |= (uint64_t)1 << slot;
+    w->count++;
+}
+
+static void
+unlink_timer(dsd_timer_wheel* w, dsd_timer* t) {
+    *t->pprev = t->next;
+    if (t->next) {
+        t->next->pprev = t->pprev;
+    }
+    if (t->level >= 0 && w->slots[t->level][t->slot] == NULL) {
+        w->occupied[t->level] &= ~((uint64_t)1 << t->slot);
+    }
+    t->next = NULL;
+    t->pprev = NULL;
+    w->count--;
+}
+
+static void
+place(dsd_timer_wheel* w, dsd_timer* t) {
+    if (t->expires <= w->now_tick) {
+        link_at(w, t, 0, (unsigned)(w->now_tick & WHEEL_MASK));
+        return;
+    }
+    uint64_t at = t->expires;
+    if (at - w->now_tick >= WHEEL_SPAN) {
+        at = w->now_tick + WHEEL_SPAN - 1u; /* parked; re-placed on cascade */
+    }
+    int level = 0;
+    while (level < DSD_TIMER_WHEEL_LEVELS - 1 && at - w->now_tick >= level_span(level + 1)) {
+        level++;
+    }
+    link_at(w, t, level, (unsigned)((at >> (DSD_TIMER_WHEEL_BITS * level)) & WHEEL_MASK));
+}
+
+/* Called after now_tick moves: re-place each level whose block just started. */
+static void
+cascade(dsd_timer_wheel* w) {
+    for (int level = 1; level < DSD_TIMER_WHEEL_LEVELS; level++) {
+        if ((w->now_tick & (level_span(level) - 1u)) != 0) {
+            break;
+        }
+        unsigned idx = (unsigned)((w->now_tick >> (DSD_TIMER_WHEEL_BITS * level)) & WHEEL_MASK);
+        dsd_timer* list = w->slots[level][idx];
+        w->slots[level][idx] = NULL;
+        w->occupied[level] &= ~((uint64_t)1 << idx);
+        while (list) {
+            dsd_timer* t = list;
+            list = t->next;
+            t->next = NULL;
+            t->pprev = NULL;
+            w->count--;
+            place(w, t);
+        }
+    }
+}
+
+static int
+fire_slot(dsd_timer_wheel* w, unsigned idx) {
+    dsd_timer* firing = w->slots[0][idx];
+    if (!firing) {
+        return 0;
+    }
+    w->slots[0][idx] = NULL;
+    w->occupied[0] &= ~((uint64_t)1 << idx);
+    firing->pprev = &firing;
+    for (dsd_timer* t = firing; t; t = t->next) {
+        t->level = -1;
+    }
+    int n = 0;
+    while (firing) {
+        dsd_timer* t = firing;
+        unlink_timer(w, t);
+        n++;
+        if (t->fn) {
+            t->fn(t, t->user);
+        }
+    }
+    return n;
+}
+
+/* First set bit of `bits` at or after `start`, wrapping; -1 when none. */
+static int
+first_from(uint64_t bits, unsigned start) {
+    for (unsigned k = 0; k < DSD_TIMER_WHEEL_SLOTS; k++) {
+        unsigned i = (start + k) & (unsigned)WHEEL_MASK;
+        if (bits & ((uint64_t)1 << i)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+void
+dsd_timer_wheel_init(dsd_timer_wheel* w, uint32_t tick_ms, uint64_t now_ms) {
+    memset(w, 0, sizeof(*w));
+    w->tick_ms = tick_ms ? tick_ms : 1u;
+    w->origin_ms = now_ms;
+}
+
+void
+dsd_timer_init(dsd_timer* t, dsd_timer_fn fn, void* user) {
+    memset(t, 0, sizeof(*t));
+    t->fn = fn;
+    t->user = user;
+}
+
+void
+dsd_timer_arm(dsd_timer_wheel* w, dsd_timer* t, uint64_t expires_ms) {
+    if (t->pprev) {
+        unlink_timer(w, t);
+    }
+    uint64_t tick = 0;
+    if (expires_ms > w->origin_ms) {
+        tick = (expires_ms - w->origin_ms + w->tick_ms - 1u) / w->tick_ms;
+    }
+    t->expires = tick;
+    place(w, t);
+}
+
+void
+dsd_timer_cancel(dsd_timer_wheel* w, dsd_timer* t) {
+    if (t->pprev) {
+        unlink_timer(w, t);
+    }
+}
+
+int
+dsd_timer_pending(const dsd_timer* t) {
+    return t->pprev != NULL;
+}
+
+int
+dsd_timer_wheel_advance(dsd_timer_wheel* w, uint64_t now_ms) {
+    uint64_t target = (now_ms > w->origin_ms) ? (now_ms - w->origin_ms) / w->tick_ms : 0;
+    int fired = fire_slot(w, (unsigned)(w->now_tick & WHEEL_MASK));
+    while (w->now_tick < target) {
+        if (w->occupied[0] == 0) {
+            /* Nothing happens before the next block of the lowest occupied level. */
+            int level = 1;
+            while (level < DSD_TIMER_WHEEL_LEVELS && w->occupied[level] == 0) {
+                level++;
+            }
+            if (level == DSD_TIMER_WHEEL_LEVELS) {
+                w->now_tick = target;
+                break;
+            }
+            uint64_t last = w->now_tick | (level_span(level) - 1u);
+            if (last >= target) {
+                w->now_tick = target;
+                break;
+            }
+            w->now_tick = last;
+        }
+        w->now_tick++;
+        cascade(w);
+        fired += fire_slot(w, (unsigned)(w->now_tick & WHEEL_MASK));
+    }
+    return fired;
+}
+
+int
+dsd_timer_wheel_next_expiry(const dsd_timer_wheel* w, uint64_t* out_ms) {
+    if (w->count == 0) {
+        return 0;
+    }
+    uint64_t best = UINT64_MAX;
+    unsigned now0 = (unsigned)(w->now_tick & WHEEL_MASK);
+    int idx = first_from(w->occupied[0], now0);
+    if (idx >= 0) {
+        best = w->now_tick + (((unsigned)idx - now0) & (unsigned)WHEEL_MASK);
+    }
+    for (int level = 1; level < DSD_TIMER_WHEEL_LEVELS; level++) {
+        unsigned cur = (unsigned)((w->now_tick >> (DSD_TIMER_WHEEL_BITS * level)) & WHEEL_MASK);
+        idx = first_from(w->occupied[level], cur + 1u);
+        if (idx < 0) {
+            continue;
+        }
+        for (const dsd_timer* t = w->slots[level][idx]; t; t = t->next) {
+            if (t->expires < best) {
+                best = t->expires;
+            }
+        }
+    }
+    if (out_ms) {
+        *out_ms = w->origin_ms + best * w->tick_ms;
+    }
+    return 1;
+}
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * The wheel is only touched under `lock`. Expired wheel timers just set a
+ * bit; handlers are called after the lock is dropped so they can re-arm.
+ */
+
+#include <dsd-neo/runtime/trunk_timers.h>
+
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/platform/atomic_compat.h>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/platform/timing.h>
+#include <dsd-neo/runtime/timer_wheel.h>
+
+#include <stdlib.h>
+
+#define TRUNK_TIMER_TICK_MS 10u
+
+typedef struct {
+    dsd_mutex_t lock;
+    atomic_int running;
+    dsd_timer_wheel wheel;
+    dsd_timer timers[DSD_TRUNK_TIMER_COUNT];
+    dsd_trunk_timer_fn fns[DSD_TRUNK_TIMER_COUNT];
+    double due_s[DSD_TRUNK_TIMER_COUNT];
+    unsigned fired; /* bit per timer id, under lock */
+} trunk_timers;
+
+static uint64_t
+now_ms(void) {
+    return dsd_time_monotonic_ns() / 1000000ULL;
+}
+
+static void
+on_expire(dsd_timer* t, void* user) {
+    trunk_timers* tt = (trunk_timers*)user;
+    tt->fired |= 1u << (unsigned)(t - tt->timers);
+}
+
+static void
+trunk_timers_free(void* p) {
+    trunk_timers* tt = (trunk_timers*)p;
+    if (!tt) {
+        return;
+    }
+    dsd_mutex_destroy(&tt->lock);
+    free(tt);
+}
+
+static trunk_timers*
+timers_get(const dsd_state* state) {
+    return state ? DSD_STATE_EXT_GET_AS(trunk_timers, (dsd_state*)state, DSD_STATE_EXT_ENGINE_TRUNK_TIMERS) : NULL;
+}
+
+static trunk_timers*
+timers_get_or_create(dsd_state* state) {
+    trunk_timers* tt = timers_get(state);
+    if (tt) {
+        return tt;
+    }
+    tt = (trunk_timers*)calloc(1, sizeof(*tt));
+    if (!tt) {
+        return NULL;
+    }
+    if (dsd_mutex_init(&tt->lock) != 0) {
+        free(tt);
+        return NULL;
+    }
+    atomic_store(&tt->running, 0);
+    dsd_timer_wheel_init(&tt->wheel, TRUNK_TIMER_TICK_MS, now_ms());
+    for (int i = 0; i < DSD_TRUNK_TIMER_COUNT; i++) {
+        dsd_timer_init(&tt->timers[i], on_expire, tt);
+    }
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_ENGINE_TRUNK_TIMERS, tt, trunk_timers_free) != 0) {
+        trunk_timers_free(tt);
+        return NULL;
+    }
+    return tt;
+}
+
+int
+dsd_trunk_timer_arm(dsd_state* state, dsd_trunk_timer_id id, double due_s, dsd_trunk_timer_fn fn) {
+    if ((int)id < 0 || id >= DSD_TRUNK_TIMER_COUNT || !fn) {
+        return -1;
+    }
+    trunk_timers* tt = timers_get_or_create(state);
+    if (!tt) {
+        return -1;
+    }
+    uint64_t due_ms = (due_s > 0.0) ? (uint64_t)(due_s * 1000.0 + 0.5) : 0;
+    dsd_mutex_lock(&tt->lock);
+    tt->fns[id] = fn;
+    tt->due_s[id] = due_s;
+    tt->fired &= ~(1u << (unsigned)id);
+    dsd_timer_arm(&tt->wheel, &tt->timers[id], due_ms);
+    dsd_mutex_unlock(&tt->lock);
+    return 0;
+}
+
+void
+dsd_trunk_timer_cancel(dsd_state* state, dsd_trunk_timer_id id) {
+    trunk_timers* tt = timers_get(state);
+    if (!tt || (int)id < 0 || id >= DSD_TRUNK_TIMER_COUNT) {
+        return;
+    }
+    dsd_mutex_lock(&tt->lock);
+    dsd_timer_cancel(&tt->wheel, &tt->timers[id]);
+    tt->fired &= ~(1u << (unsigned)id);
+    dsd_mutex_unlock(&tt->lock);
+}
+
+int
+dsd_trunk_timer_pending(const dsd_state* state, dsd_trunk_timer_id id, double* due_s) {
+    trunk_timers* tt = timers_get(state);
+    if (!tt || (int)id < 0 || id >= DSD_TRUNK_TIMER_COUNT) {
+        return 0;
+    }
+    dsd_mutex_lock(&tt->lock);
+    int armed = dsd_timer_pending(&tt->timers[id]);
+    if (armed && due_s) {
+        *due_s = tt->due_s[id];
+    }
+    dsd_mutex_unlock(&tt->lock);
+    return armed;
+}
+
+int
+dsd_trunk_timers_run(dsd_opts* opts, dsd_state* state) {
+    trunk_timers* tt = timers_get(state);
+    if (!tt) {
+        return 0;
+    }
+    int expected = 0;
+    if (!atomic_compare_exchange_strong(&tt->running, &expected, 1)) {
+        return 0;
+    }
+    dsd_trunk_timer_fn run[DSD_TRUNK_TIMER_COUNT] = {0};
+    dsd_mutex_lock(&tt->lock);
+    dsd_timer_wheel_advance(&tt->wheel, now_ms());
+    unsigned fired = tt->fired;
+    tt->fired = 0;
+    for (int i = 0; i < DSD_TRUNK_TIMER_COUNT; i++) {
+        if (fired & (1u << (unsigned)i)) {
+            run[i] = tt->fns[i];
+        }
+    }
+    dsd_mutex_unlock(&tt->lock);
+
+    int n = 0;
+    for (int i = 0; i < DSD_TRUNK_TIMER_COUNT; i++) {
+        if (run[i]) {
+            run[i](opts, state);
+            n++;
+        }
+    }
+    atomic_store(&tt->running, 0);
+    return n;
+}
@@ -5,6 +5,8 @@
 
 #include <dsd-neo/runtime/udp_audio_hooks.h>
 
+#include <dsd-neo/runtime/audio_sink.h>
+
 static dsd_udp_audio_hooks g_udp_audio_hooks = {0};
 
 void
@@ -15,13 +17,17 @@ dsd_udp_audio_hooks_set(dsd_udp_audio_hooks hooks) {
 void
 dsd_udp_audio_hook_blast(dsd_opts* opts, dsd_state* state, size_t nsam, void* data) {
     if (g_udp_audio_hooks.blast) {
+        dsd_audio_sink_lock();
         g_udp_audio_hooks.blast(opts, state, nsam, data);
+        dsd_audio_sink_unlock();
     }
 }
 
 void
 dsd_udp_audio_hook_blast_analog(dsd_opts* opts, dsd_state* state, size_t nsam, void* data) {
     if (g_udp_audio_hooks.blast_analog) {
+        dsd_audio_sink_lock();
         g_udp_audio_hooks.blast_analog(opts, state, nsam, data);
+        dsd_audio_sink_unlock();
     }
 }
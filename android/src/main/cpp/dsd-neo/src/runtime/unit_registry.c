@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Dense entry arrays with a chained hash index and an intrusive LRU list,
+ * all addressed by entry index. Bucket count is kept at twice the capacity.
+ * The LRU ends are only meaningful while count > 0, so a zero-filled
+ * registry is a valid empty, unbounded one.
+ */
+
+#include <dsd-neo/core/unit_registry.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UNIT_REGISTRY_MIN_CAPACITY 64
+
+static uint32_t
+key_hash(uint32_t rid, uint16_t tg) {
+    uint32_t h = rid * 0x9E3779B1u ^ (uint32_t)tg * 0x85EBCA6Bu;
+    return h ^ (h >> 15);
+}
+
+static void
+lru_unlink(dsd_unit_registry* reg, int32_t i) {
+    int32_t p = reg->lru_prev[i];
+    int32_t n = reg->lru_next[i];
+    if (p >= 0) {
+        reg->lru_next[p] = n;
+    } else {
+        reg->lru_oldest = n;
+    }
+    if (n >= 0) {
+        reg->lru_prev[n] = p;
+    } else {
+        reg->lru_newest = p;
+    }
+}
+
+static void
+lru_append(dsd_unit_registry* reg, int32_t i) {
+    reg->lru_prev[i] = reg->lru_newest;
+    reg->lru_next[i] = -1;
+    if (reg->lru_newest >= 0) {
+        reg->lru_next[reg->lru_newest] = i;
+    } else {
+        reg->lru_oldest = i;
+    }
+    reg->lru_newest = i;
+}
+
+static void
+hash_link(dsd_unit_registry* reg, int32_t i) {
+    uint32_t b = key_hash(reg->rid[i], reg->tg[i]) & reg->bucket_mask;
+    reg->hash_next[i] = reg->buckets[b];
+    reg->buckets[b] = i;
+}
+
+static void
+hash_unlink(dsd_unit_registry* reg, int32_t i) {
+    int32_t* link = &reg->buckets[key_hash(reg->rid[i], reg->tg[i]) & reg->bucket_mask];
+    while (*link != i) {
+        link = &reg->hash_next[*link];
+    }
+    *link = reg->hash_next[i];
+}
+
+/* Re-point every reference to entry `from` at `to` after copying it there. */
+static void
+move_entry(dsd_unit_registry* reg, int32_t from, int32_t to) {
+    int32_t* link = &reg->buckets[key_hash(reg->rid[from], reg->tg[from]) & reg->bucket_mask];
+    while (*link != from) {
+        link = &reg->hash_next[*link];
+    }
+    *link = to;
+    reg->rid[to] = reg->rid[from];
+    reg->tg[to] = reg->tg[from];
+    reg->last_seen[to] = reg->last_seen[from];
+    reg->hash_next[to] = reg->hash_next[from];
+    reg->lru_prev[to] = reg->lru_prev[from];
+    reg->lru_next[to] = reg->lru_next[from];
+    if (reg->lru_prev[to] >= 0) {
+        reg->lru_next[reg->lru_prev[to]] = to;
+    } else {
+        reg->lru_oldest = to;
+    }
+    if (reg->lru_next[to] >= 0) {
+        reg->lru_prev[reg->lru_next[to]] = to;
+    } else {
+        reg->lru_newest = to;
+    }
+}
+
+static void
+remove_at(dsd_unit_registry* reg, int32_t i) {
+    hash_unlink(reg, i);
+    lru_unlink(reg, i);
+    int32_t last = reg->count - 1;
+    if (i != last) {
+        move_entry(reg, last, i);
+    }
+    reg->count--;
+}
+
+static int
+limit_of(const dsd_unit_registry* reg) {
+    return (reg->max_entries > 0) ? reg->max_entries : INT32_MAX / 2;
+}
+
+static int
+grow(dsd_unit_registry* reg) {
+    int limit = limit_of(reg);
+    int cap = reg->capacity ? reg->capacity : UNIT_REGISTRY_MIN_CAPACITY / 2;
+    cap = (cap > limit / 2) ? limit : cap * 2;
+    if (cap <= reg->capacity) {
+        return -1;
+    }
+    uint32_t nbuckets = 1;
+    while (nbuckets < (uint32_t)cap * 2u) {
+        nbuckets <<= 1;
+    }
+    uint32_t* rid = (uint32_t*)realloc(reg->rid, (size_t)cap * sizeof(*rid));
+    if (rid) {
+        reg->rid = rid;
+    }
+    uint16_t* tg = (uint16_t*)realloc(reg->tg, (size_t)cap * sizeof(*tg));
+    if (tg) {
+        reg->tg = tg;
+    }
+    time_t* seen = (time_t*)realloc(reg->last_seen, (size_t)cap * sizeof(*seen));
+    if (seen) {
+        reg->last_seen = seen;
+    }
+    int32_t* prev = (int32_t*)realloc(reg->lru_prev, (size_t)cap * sizeof(*prev));
+    if (prev) {
+        reg->lru_prev = prev;
+    }
+    int32_t* next = (int32_t*)realloc(reg->lru_next, (size_t)cap * sizeof(*next));
+    if (next) {
+        reg->lru_next = next;
+    }
+    int32_t* chain = (int32_t*)realloc(reg->hash_next, (size_t)cap * sizeof(*chain));
+    if (chain) {
+        reg->hash_next = chain;
+    }
+    int32_t* buckets = (int32_t*)malloc((size_t)nbuckets * sizeof(*buckets));
+    if (!rid || !tg || !seen || !prev || !next || !chain || !buckets) {
+        free(buckets);
+        return -1;
+    }
+    free(reg->buckets);
+    reg->buckets = buckets;
+    reg->bucket_mask = nbuckets - 1u;
+    reg->capacity = cap;
+    memset(reg->buckets, 0xFF, (size_t)nbuckets * sizeof(*buckets));
+    for (int32_t i = 0; i < reg->count; i++) {
+        hash_link(reg, i);
+    }
+    return 0;
+}
+
+void
+dsd_unit_registry_init(dsd_unit_registry* reg, int max_entries) {
+    memset(reg, 0, sizeof(*reg));
+    reg->lru_oldest = -1;
+    reg->lru_newest = -1;
+    reg->max_entries = (max_entries > 0) ? max_entries : 0;
+}
+
+void
+dsd_unit_registry_free(dsd_unit_registry* reg) {
+    free(reg->rid);
+    free(reg->tg);
+    free(reg->last_seen);
+    free(reg->lru_prev);
+    free(reg->lru_next);
+    free(reg->hash_next);
+    free(reg->buckets);
+    dsd_unit_registry_init(reg, reg->max_entries);
+}
+
+void
+dsd_unit_registry_clear(dsd_unit_registry* reg) {
+    if (reg->buckets) {
+        memset(reg->buckets, 0xFF, (size_t)(reg->bucket_mask + 1u) * sizeof(*reg->buckets));
+    }
+    reg->count = 0;
+    reg->lru_oldest = -1;
+    reg->lru_newest = -1;
+}
+
+int
+dsd_unit_registry_find(const dsd_unit_registry* reg, uint32_t rid, uint16_t tg) {
+    if (reg->count == 0) {
+        return -1;
+    }
+    int32_t i = reg->buckets[key_hash(rid, tg) & reg->bucket_mask];
+    while (i >= 0) {
+        if (reg->rid[i] == rid && reg->tg[i] == tg) {
+            return i;
+        }
+        i = reg->hash_next[i];
+    }
+    return -1;
+}
+
+int
+dsd_unit_registry_touch(dsd_unit_registry* reg, uint32_t rid, uint16_t tg, time_t now) {
+    int32_t i = dsd_unit_registry_find(reg, rid, tg);
+    if (i >= 0) {
+        reg->last_seen[i] = now;
+        if (i != reg->lru_newest) {
+            lru_unlink(reg, i);
+            lru_append(reg, i);
+        }
+        return i;
+    }
+    if (reg->count >= limit_of(reg)) {
+        remove_at(reg, reg->lru_oldest);
+    } else if (reg->count >= reg->capacity && grow(reg) != 0) {
+        return -1;
+    }
+    if (reg->count == 0) {
+        reg->lru_oldest = -1;
+        reg->lru_newest = -1;
+    }
+    i = reg->count++;
+    reg->rid[i] = rid;
+    reg->tg[i] = tg;
+    reg->last_seen[i] = now;
+    hash_link(reg, i);
+    lru_append(reg, i);
+    return i;
+}
+
+int
+dsd_unit_registry_remove(dsd_unit_registry* reg, uint32_t rid, uint16_t tg) {
+    int32_t i = dsd_unit_registry_find(reg, rid, tg);
+    if (i < 0) {
+        return 0;
+    }
+    remove_at(reg, i);
+    return 1;
+}
+
+int
+dsd_unit_registry_expire(dsd_unit_registry* reg, time_t now, time_t ttl) {
+    int removed = 0;
+    while (reg->count > 0) {
+        int32_t i = reg->lru_oldest;
+        if (reg->last_seen[i] == 0 || (now - reg->last_seen[i]) <= ttl) {
+            break;
+        }
+        remove_at(reg, i);
+        removed++;
+    }
+    return removed;
+}
+
+time_t
+dsd_unit_registry_oldest_seen(const dsd_unit_registry* reg) {
+    return (reg->count > 0) ? reg->last_seen[reg->lru_oldest] : 0;
+}
+
+time_t
+dsd_unit_registry_newest_seen(const dsd_unit_registry* reg) {
+    return (reg->count > 0) ? reg->last_seen[reg->lru_newest] : 0;
+}
+
+int
+dsd_unit_registry_recent(const dsd_unit_registry* reg, int* out, int max) {
+    int n = 0;
+    if (reg->count == 0) {
+        return 0;
+    }
+    for (int32_t i = reg->lru_newest; i >= 0 && n < max; i = reg->lru_prev[i]) {
+        out[n++] = i;
+    }
+    return n;
+}
+
+int
+dsd_unit_registry_copy_recent(dsd_unit_registry* dst, const dsd_unit_registry* src, int max) {
+    dsd_unit_registry_clear(dst);
+    if (dst->max_entries > 0 && dst->max_entries < max) {
+        dst->max_entries = max;
+    }
+    if (src->count == 0 || max <= 0) {
+        return 0;
+    }
+    /* Find the oldest of the newest `max`, then replay them in LRU order. */
+    int32_t i = src->lru_newest;
+    for (int k = 1; i >= 0 && k < max && src->lru_prev[i] >= 0; k++) {
+        i = src->lru_prev[i];
+    }
+    int copied = 0;
+    for (; i >= 0 && copied < max; i = src->lru_next[i]) {
+        if (dsd_unit_registry_touch(dst, src->rid[i], src->tg[i], src->last_seen[i]) < 0) {
+            return -1;
+        }
+        copied++;
+    }
+    return copied;
+}
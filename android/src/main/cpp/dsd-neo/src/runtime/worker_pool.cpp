@@ -5,61 +5,174 @@
 
 /**
  * @file
- * @brief Minimal 2-thread worker pool for intra-block demodulation tasks.
+ * @brief N-worker fork/join pool for intra-block demodulation tasks.
  *
- * Provides a tiny env-gated pool (set `DSD_NEO_MT=1`) addressed by `demod_state*`.
- * Used to run up to two inner-loop tasks in parallel per processing block.
+ * Queues are bounded lock-free MPMC rings (per-cell sequence numbers). Each
+ * worker drains its own affinity queue before the shared queue. Workers spin
+ * for a short while when idle and then park; the park protocol publishes a
+ * parked count before the final queue re-check, so a submitter that sees no
+ * parked workers never needs the mutex and one that does cannot miss them.
  */
 
+#include <atomic>
+#include <dsd-neo/dsp/demod_state.h>
+#include <dsd-neo/platform/posix_compat.h>
 #include <dsd-neo/platform/threading.h>
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/worker_pool.h>
-#include <mutex>
+#include <new>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unordered_map>
+#include <thread>
 
-/* Opaque handle keyed off demod_state* to avoid depending on its layout here */
-struct WorkerCtx {
-    bool enabled;
-    dsd_thread_t threads[2];
-    dsd_mutex_t lock;
-    dsd_cond_t cv;
-    dsd_cond_t done_cv;
-    bool should_exit;
-    int epoch;
-    int completed_in_epoch;
-    int posted_count;
-
-    struct {
-        void (*run)(void*);
-        void* arg;
-    } tasks[2];
+namespace {
+
+constexpr unsigned kQueueSize = 256; /* per queue, power of two */
+constexpr int kSpinIters = 2048;     /* idle polls before parking */
+constexpr int kSpinYieldAfter = 64;  /* polls before yielding the CPU between polls */
+
+struct Task {
+    dsd_worker_task_fn fn;
+    dsd_worker_range_fn range_fn;
+    void* arg;
+    int begin;
+    int end;
+};
+
+struct alignas(64) TaskQueue {
+    struct Cell {
+        std::atomic<size_t> seq;
+        Task task;
+    };
+
+    Cell cells[kQueueSize];
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+
+    void
+    init() {
+        for (unsigned i = 0; i < kQueueSize; i++) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    bool
+    push(const Task& t) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells[pos & (kQueueSize - 1)];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.task = t;
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; /* full */
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool
+    pop(Task* out) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells[pos & (kQueueSize - 1)];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    *out = c.task;
+                    c.seq.store(pos + kQueueSize, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; /* empty */
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
 };
 
 struct WorkerArg {
-    WorkerCtx* ctx;
+    dsd_worker_pool* pool;
     int id;
 };
 
-static std::unordered_map<const void*, WorkerCtx*> g_ctx_map;
-static std::mutex g_ctx_mu;
+} // namespace
 
-static WorkerCtx*
-get_ctx(const void* key) {
-    std::lock_guard<std::mutex> lg(g_ctx_mu);
-    auto it = g_ctx_map.find(key);
-    return (it == g_ctx_map.end()) ? nullptr : it->second;
+struct dsd_worker_pool {
+    int n_workers;
+    int first_cpu;
+    dsd_thread_t threads[DSD_WORKER_POOL_MAX_WORKERS];
+    WorkerArg args[DSD_WORKER_POOL_MAX_WORKERS];
+    TaskQueue shared;
+    TaskQueue local[DSD_WORKER_POOL_MAX_WORKERS];
+
+    alignas(64) std::atomic<int> pending; /* submitted but not finished */
+    alignas(64) std::atomic<int> parked;  /* workers parked or about to park */
+    std::atomic<int> owner_parked;        /* owner parked in join */
+    std::atomic<bool> should_exit;
+    dsd_mutex_t lock;
+    dsd_cond_t wake_cv; /* workers park here */
+    dsd_cond_t done_cv; /* owner parks here */
+};
+
+static void
+run_task(const Task& t) {
+    if (t.range_fn) {
+        t.range_fn(t.arg, t.begin, t.end);
+    } else if (t.fn) {
+        t.fn(t.arg);
+    }
 }
 
+/* Wake parked workers after queueing; the fence orders the push before the parked check. */
 static void
-set_ctx(const void* key, WorkerCtx* ctx) {
-    std::lock_guard<std::mutex> lg(g_ctx_mu);
-    if (ctx) {
-        g_ctx_map[key] = ctx;
+wake_workers(dsd_worker_pool* pool, bool all) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pool->parked.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    dsd_mutex_lock(&pool->lock);
+    if (all) {
+        dsd_cond_broadcast(&pool->wake_cv);
     } else {
-        g_ctx_map.erase(key);
+        dsd_cond_signal(&pool->wake_cv);
+    }
+    dsd_mutex_unlock(&pool->lock);
+}
+
+static void
+finish_task(dsd_worker_pool* pool) {
+    if (pool->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pool->owner_parked.load(std::memory_order_relaxed) != 0) {
+        dsd_mutex_lock(&pool->lock);
+        dsd_cond_signal(&pool->done_cv);
+        dsd_mutex_unlock(&pool->lock);
+    }
+}
+
+static bool
+take_task(dsd_worker_pool* pool, int id, Task* t) {
+    return pool->local[id].pop(t) || pool->shared.pop(t);
+}
+
+static void
+spin_pause(int iter) {
+    if (iter >= kSpinYieldAfter) {
+        std::this_thread::yield();
     }
 }
 
@@ -67,130 +180,270 @@ static DSD_THREAD_RETURN_TYPE
 #if DSD_PLATFORM_WIN_NATIVE
     __stdcall
 #endif
-    demod_mt_worker(void* arg) {
+    worker_main(void* arg) {
     WorkerArg* wa = (WorkerArg*)arg;
-    WorkerCtx* ctx = wa->ctx;
+    dsd_worker_pool* pool = wa->pool;
     const int id = wa->id;
-    int local_epoch = 0;
+    if (pool->first_cpu >= 0) {
+        (void)dsd_thread_set_affinity(pool->first_cpu + id);
+    }
+    Task t{};
     for (;;) {
-        dsd_mutex_lock(&ctx->lock);
-        while (!ctx->should_exit && ctx->epoch == local_epoch) {
-            dsd_cond_wait(&ctx->cv, &ctx->lock);
+        bool got = false;
+        for (int i = 0; i < kSpinIters; i++) {
+            if (take_task(pool, id, &t)) {
+                got = true;
+                break;
+            }
+            if (pool->should_exit.load(std::memory_order_acquire)) {
+                break;
+            }
+            spin_pause(i);
+        }
+        if (got) {
+            run_task(t);
+            finish_task(pool);
+            continue;
+        }
+        /* Park: announce first, then re-check, so a concurrent submit either
+         * is seen here or sees parked > 0 and signals under the lock. */
+        dsd_mutex_lock(&pool->lock);
+        pool->parked.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!pool->should_exit.load(std::memory_order_acquire) && !take_task(pool, id, &t)) {
+            dsd_cond_wait(&pool->wake_cv, &pool->lock);
+        }
+        pool->parked.fetch_sub(1, std::memory_order_relaxed);
+        bool exiting = pool->should_exit.load(std::memory_order_acquire);
+        dsd_mutex_unlock(&pool->lock);
+        if (exiting) {
+            /* Drain anything still queued for this worker before leaving. */
+            while (take_task(pool, id, &t)) {
+                run_task(t);
+                finish_task(pool);
+            }
+            break;
         }
-        if (ctx->should_exit) {
-            dsd_mutex_unlock(&ctx->lock);
+        run_task(t);
+        finish_task(pool);
+    }
+    DSD_THREAD_RETURN;
+}
+
+dsd_worker_pool*
+dsd_worker_pool_create(int workers, int first_cpu) {
+    if (workers < 1) {
+        workers = 1;
+    }
+    if (workers > DSD_WORKER_POOL_MAX_WORKERS) {
+        workers = DSD_WORKER_POOL_MAX_WORKERS;
+    }
+    void* mem = dsd_aligned_alloc(64, sizeof(dsd_worker_pool));
+    if (!mem) {
+        return NULL;
+    }
+    dsd_worker_pool* pool = new (mem) dsd_worker_pool();
+    pool->n_workers = 0;
+    pool->first_cpu = first_cpu;
+    pool->shared.init();
+    for (int i = 0; i < DSD_WORKER_POOL_MAX_WORKERS; i++) {
+        pool->local[i].init();
+    }
+    pool->pending.store(0);
+    pool->parked.store(0);
+    pool->owner_parked.store(0);
+    pool->should_exit.store(false);
+    dsd_mutex_init(&pool->lock);
+    dsd_cond_init(&pool->wake_cv);
+    dsd_cond_init(&pool->done_cv);
+    for (int i = 0; i < workers; i++) {
+        pool->args[i].pool = pool;
+        pool->args[i].id = i;
+        if (dsd_thread_create(&pool->threads[i], (dsd_thread_fn)worker_main, (void*)&pool->args[i]) != 0) {
             break;
         }
-        local_epoch = ctx->epoch;
-        void (*fn)(void*) = nullptr;
-        void* fn_arg = nullptr;
-        if (id < ctx->posted_count) {
-            fn = ctx->tasks[id].run;
-            fn_arg = ctx->tasks[id].arg;
+        pool->n_workers++;
+    }
+    if (pool->n_workers == 0) {
+        dsd_worker_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void
+dsd_worker_pool_destroy(dsd_worker_pool* pool) {
+    if (!pool) {
+        return;
+    }
+    dsd_worker_pool_join(pool);
+    dsd_mutex_lock(&pool->lock);
+    pool->should_exit.store(true, std::memory_order_release);
+    dsd_cond_broadcast(&pool->wake_cv);
+    dsd_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->n_workers; i++) {
+        dsd_thread_join(pool->threads[i]);
+    }
+    dsd_cond_destroy(&pool->done_cv);
+    dsd_cond_destroy(&pool->wake_cv);
+    dsd_mutex_destroy(&pool->lock);
+    pool->~dsd_worker_pool();
+    dsd_aligned_free(pool);
+}
+
+int
+dsd_worker_pool_size(const dsd_worker_pool* pool) {
+    return pool ? pool->n_workers : 0;
+}
+
+int
+dsd_worker_pool_submit(dsd_worker_pool* pool, int worker, dsd_worker_task_fn fn, void* arg) {
+    Task t = {fn, NULL, arg, 0, 0};
+    if (!pool) {
+        run_task(t);
+        return 1;
+    }
+    TaskQueue* q = (worker >= 0 && worker < pool->n_workers) ? &pool->local[worker] : &pool->shared;
+    pool->pending.fetch_add(1, std::memory_order_relaxed);
+    if (!q->push(t)) {
+        run_task(t);
+        pool->pending.fetch_sub(1, std::memory_order_relaxed);
+        return 1;
+    }
+    /* Affinity tasks need their own worker, so wake everyone in that case. */
+    wake_workers(pool, q != &pool->shared);
+    return 0;
+}
+
+static int
+submit_range(dsd_worker_pool* pool, dsd_worker_range_fn fn, void* arg, int begin, int end) {
+    Task t = {NULL, fn, arg, begin, end};
+    pool->pending.fetch_add(1, std::memory_order_relaxed);
+    if (!pool->shared.push(t)) {
+        run_task(t);
+        pool->pending.fetch_sub(1, std::memory_order_relaxed);
+        return 1;
+    }
+    return 0;
+}
+
+void
+dsd_worker_pool_join(dsd_worker_pool* pool) {
+    if (!pool) {
+        return;
+    }
+    Task t{};
+    for (int i = 0; pool->pending.load(std::memory_order_acquire) > 0; i++) {
+        /* Help with shared work first; affinity tasks stay with their worker. */
+        if (pool->shared.pop(&t)) {
+            run_task(t);
+            finish_task(pool);
+            i = 0;
+            continue;
         }
-        dsd_mutex_unlock(&ctx->lock);
-        if (fn) {
-            fn(fn_arg);
+        if (i < kSpinIters) {
+            spin_pause(i);
+            continue;
         }
-        dsd_mutex_lock(&ctx->lock);
-        ctx->completed_in_epoch++;
-        if (ctx->completed_in_epoch >= ctx->posted_count) {
-            dsd_cond_signal(&ctx->done_cv);
+        dsd_mutex_lock(&pool->lock);
+        pool->owner_parked.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (pool->pending.load(std::memory_order_acquire) > 0) {
+            dsd_cond_timedwait(&pool->done_cv, &pool->lock, 10);
         }
-        dsd_mutex_unlock(&ctx->lock);
+        pool->owner_parked.store(0, std::memory_order_relaxed);
+        dsd_mutex_unlock(&pool->lock);
     }
-    DSD_THREAD_RETURN;
+}
+
+void
+dsd_worker_pool_parallel_for(dsd_worker_pool* pool, int begin, int end, int grain, dsd_worker_range_fn fn,
+                             void* arg) {
+    if (!fn || end <= begin) {
+        return;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+    const int len = end - begin;
+    int chunks = pool ? pool->n_workers + 1 : 1;
+    if (chunks > len / grain) {
+        chunks = len / grain;
+    }
+    if (chunks <= 1) {
+        fn(arg, begin, end);
+        return;
+    }
+    /* Even split; the first `rem` chunks take one extra element. */
+    const int base = len / chunks;
+    const int rem = len % chunks;
+    const int first_end = begin + base + (rem > 0 ? 1 : 0);
+    int pos = first_end;
+    int woke = 0;
+    for (int c = 1; c < chunks; c++) {
+        int n = base + (c < rem ? 1 : 0);
+        woke |= (submit_range(pool, fn, arg, pos, pos + n) == 0);
+        pos += n;
+    }
+    if (woke) {
+        wake_workers(pool, true);
+    }
+    fn(arg, begin, first_end);
+    dsd_worker_pool_join(pool);
 }
 
 /**
- * @brief Initialize the minimal worker pool when `DSD_NEO_MT=1`.
+ * @brief Initialize the worker pool for a demodulator when `DSD_NEO_MT=1`.
  *
  * Safe to call multiple times per demodulator instance.
- * @param s Demodulator state used as a key for the worker context.
+ * @param s Demodulator state that owns the pool.
  * @note No-op when multithreading is disabled via environment.
  */
 void
 demod_mt_init(struct demod_state* s) {
+    if (!s) {
+        return;
+    }
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
     if (!cfg) {
         dsd_neo_config_init(NULL);
         cfg = dsd_neo_get_config();
     }
     bool enable = (cfg && cfg->mt_is_set && cfg->mt_enable) ? true : false;
-    if (!enable) {
-        // No context needed if disabled
-        set_ctx((const void*)s, nullptr);
-        return;
+    if (!enable || s->mt_pool) {
+        return; // disabled, or already initialized
     }
-    WorkerCtx* ctx = get_ctx((const void*)s);
-    if (ctx) {
-        return; // already initialized
-    }
-    ctx = (WorkerCtx*)calloc(1, sizeof(WorkerCtx));
-    if (!ctx) {
-        return;
-    }
-    ctx->enabled = true;
-    ctx->should_exit = false;
-    ctx->epoch = 0;
-    ctx->completed_in_epoch = 0;
-    ctx->posted_count = 0;
-    dsd_mutex_init(&ctx->lock);
-    dsd_cond_init(&ctx->cv);
-    dsd_cond_init(&ctx->done_cv);
-    WorkerArg* args = (WorkerArg*)calloc(2, sizeof(WorkerArg));
-    if (args == NULL) {
-        fprintf(stderr, "Failed to allocate worker thread arguments\n");
-        dsd_mutex_destroy(&ctx->lock);
-        dsd_cond_destroy(&ctx->cv);
-        dsd_cond_destroy(&ctx->done_cv);
-        free(ctx);
+    int workers = (cfg->mt_workers_is_set) ? cfg->mt_workers : 2;
+    int first_cpu = (cfg->mt_cpu_is_set) ? cfg->mt_cpu : -1;
+    s->mt_pool = dsd_worker_pool_create(workers, first_cpu);
+    if (!s->mt_pool) {
+        fprintf(stderr, "Failed to start intra-block worker pool; continuing single-threaded\n");
         return;
     }
-    for (int i = 0; i < 2; i++) {
-        args[i].ctx = ctx;
-        args[i].id = i;
-        dsd_thread_create(&ctx->threads[i], (dsd_thread_fn)demod_mt_worker, (void*)&args[i]);
-    }
-    // Intentionally leak args array until threads exit to keep pointers valid; freed in destroy
-    set_ctx((const void*)s, ctx);
-    fprintf(stderr, "Intra-block multithreading enabled (DSD_NEO_MT=1), workers: 2.\n");
+    fprintf(stderr, "Intra-block multithreading enabled (DSD_NEO_MT=1), workers: %d.\n",
+            dsd_worker_pool_size(s->mt_pool));
 }
 
 /**
  * @brief Tear down worker threads created by `demod_mt_init`.
  *
- * @param s Demodulator state used as a key for the worker context.
+ * @param s Demodulator state that owns the pool.
  * @note Safe no-op if the pool was never enabled/initialized.
  */
 void
 demod_mt_destroy(struct demod_state* s) {
-    WorkerCtx* ctx = get_ctx((const void*)s);
-    if (!ctx || !ctx->enabled) {
-        set_ctx((const void*)s, nullptr);
+    if (!s) {
         return;
     }
-    dsd_mutex_lock(&ctx->lock);
-    ctx->should_exit = true;
-    dsd_cond_broadcast(&ctx->cv);
-    dsd_mutex_unlock(&ctx->lock);
-    for (int i = 0; i < 2; i++) {
-        dsd_thread_join(ctx->threads[i]);
-    }
-    dsd_cond_destroy(&ctx->done_cv);
-    dsd_cond_destroy(&ctx->cv);
-    dsd_mutex_destroy(&ctx->lock);
-    // Free leaked WorkerArg array: not tracked; threads have exited so it's safe to free if we had kept pointer.
-    // Since we didn't keep it, allow small leak to be reclaimed on process exit. Not critical during normal teardown.
-    free(ctx);
-    set_ctx((const void*)s, nullptr);
+    dsd_worker_pool_destroy(s->mt_pool);
+    s->mt_pool = NULL;
 }
 
 /**
- * @brief Post up to two tasks and wait for completion.
+ * @brief Run up to two tasks in parallel and wait for completion.
  *
  * Runs synchronously in the caller thread when the pool is disabled.
- * @param s Demodulator state key for the worker context.
+ * @param s Demodulator state that owns the pool.
  * @param f0 Function pointer for the first task (may be NULL).
  * @param a0 Argument for the first task.
  * @param f1 Function pointer for the second task (may be NULL).
@@ -198,8 +451,8 @@ demod_mt_destroy(struct demod_state* s) {
  */
 void
 demod_mt_run_two(struct demod_state* s, void (*f0)(void*), void* a0, void (*f1)(void*), void* a1) {
-    WorkerCtx* ctx = get_ctx((const void*)s);
-    if (!ctx || !ctx->enabled) {
+    dsd_worker_pool* pool = s ? s->mt_pool : NULL;
+    if (!pool || !f0 || !f1) {
         if (f0) {
             f0(a0);
         }
@@ -208,17 +461,7 @@ demod_mt_run_two(struct demod_state* s, void (*f0)(void*), void* a0, void (*f1)(
         }
         return;
     }
-    dsd_mutex_lock(&ctx->lock);
-    ctx->tasks[0].run = f0;
-    ctx->tasks[0].arg = a0;
-    ctx->tasks[1].run = f1;
-    ctx->tasks[1].arg = a1;
-    ctx->posted_count = (f1 != NULL) ? 2 : 1;
-    ctx->completed_in_epoch = 0;
-    ctx->epoch++;
-    dsd_cond_broadcast(&ctx->cv);
-    while (ctx->completed_in_epoch < ctx->posted_count) {
-        dsd_cond_wait(&ctx->done_cv, &ctx->lock);
-    }
-    dsd_mutex_unlock(&ctx->lock);
+    dsd_worker_pool_submit(pool, -1, f1, a1);
+    f0(a0);
+    dsd_worker_pool_join(pool);
 }
@@ -1020,28 +1020,9 @@ ncursesPrinter(dsd_opts* opts, dsd_state* state) {
         if (opts->show_p25_affiliations == 1 && (is_p25p1 || is_p25p2)) {
             ui_print_header("P25 Affiliations");
             // Compose a recent-first list of up to 20 RIDs
-            int idxs[256];
-            int n = 0;
+            int idxs[20];
+            int n = dsd_unit_registry_recent(&state->p25_aff, idxs, 20);
             time_t now = time(NULL);
-            for (int i = 0; i < 256; i++) {
-                if (state->p25_aff_rid[i] != 0) {
-                    idxs[n++] = i;
-                }
-            }
-            // Selection sort by last_seen desc (n is typically small)
-            for (int i = 0; i < n; i++) {
-                int best = i;
-                for (int j = i + 1; j < n; j++) {
-                    if (state->p25_aff_last_seen[idxs[j]] > state->p25_aff_last_seen[idxs[best]]) {
-                        best = j;
-                    }
-                }
-                if (best != i) {
-                    int tmp = idxs[i];
-                    idxs[i] = idxs[best];
-                    idxs[best] = tmp;
-                }
-            }
             int shown = 0;
             int rows = 0, cols = 80;
             getmaxyx(stdscr, rows, cols);
@@ -1053,8 +1034,8 @@ ncursesPrinter(dsd_opts* opts, dsd_state* state) {
             int line_used = 0;
             for (int i = 0; i < n && shown < 20; i++) {
                 int k = idxs[i];
-                uint32_t rid = state->p25_aff_rid[k];
-                long age = (long)((state->p25_aff_last_seen[k] != 0) ? (now - state->p25_aff_last_seen[k]) : 0);
+                uint32_t rid = state->p25_aff.rid[k];
+                long age = (long)((state->p25_aff.last_seen[k] != 0) ? (now - state->p25_aff.last_seen[k]) : 0);
                 if (age < 0) {
                     age = 0;
                 }
@@ -1100,27 +1081,9 @@ ncursesPrinter(dsd_opts* opts, dsd_state* state) {
         int is_p25p2 = DSD_SYNC_IS_P25P2(lls);
         if (opts->show_p25_group_affiliations == 1 && (is_p25p1 || is_p25p2)) {
             ui_print_header("P25 Group Affiliation");
-            int idxs[512];
-            int n = 0;
+            int idxs[20];
+            int n = dsd_unit_registry_recent(&state->p25_ga, idxs, 20);
             time_t now = time(NULL);
-            for (int i = 0; i < 512; i++) {
-                if (state->p25_ga_rid[i] != 0 && state->p25_ga_tg[i] != 0) {
-                    idxs[n++] = i;
-                }
-            }
-            for (int i = 0; i < n; i++) {
-                int best = i;
-                for (int j = i + 1; j < n; j++) {
-                    if (state->p25_ga_last_seen[idxs[j]] > state->p25_ga_last_seen[idxs[best]]) {
-                        best = j;
-                    }
-                }
-                if (best != i) {
-                    int tmp = idxs[i];
-                    idxs[i] = idxs[best];
-                    idxs[best] = tmp;
-                }
-            }
             int shown = 0;
             int rows = 0, cols = 80;
             getmaxyx(stdscr, rows, cols);
@@ -1131,9 +1094,9 @@ ncursesPrinter(dsd_opts* opts, dsd_state* state) {
             int line_used = 0;
             for (int i = 0; i < n && shown < 20; i++) {
                 int k = idxs[i];
-                uint32_t rid = state->p25_ga_rid[k];
-                uint16_t tg = state->p25_ga_tg[k];
-                long age = (long)((state->p25_ga_last_seen[k] != 0) ? (now - state->p25_ga_last_seen[k]) : 0);
+                uint32_t rid = state->p25_ga.rid[k];
+                uint16_t tg = state->p25_ga.tg[k];
+                long age = (long)((state->p25_ga.last_seen[k] != 0) ? (now - state->p25_ga.last_seen[k]) : 0);
                 if (age < 0) {
                     age = 0;
                 }
@@ -1540,8 +1503,9 @@ ncursesPrinter(dsd_opts* opts, dsd_state* state) {
             printw("%s", state->dmr_site_parms); //site id, net id, etc
             if (state->dmr_rest_channel > 0) {
                 printw("Rest LSN: %02d; ", state->dmr_rest_channel);
-                if (state->trunk_chan_map[state->dmr_rest_channel] != 0) {
-                    printw("Freq: %.06lf Mhz", (double)state->trunk_chan_map[state->dmr_rest_channel] / 1000000);
+                if (dsd_chan_map_get(&state->trunk_chan_map, state->dmr_rest_channel) != 0) {
+                    printw("Freq: %.06lf Mhz",
+                           (double)dsd_chan_map_get(&state->trunk_chan_map, state->dmr_rest_channel) / 1000000);
                 }
             } else if (state->trunk_cc_freq != 0 || state->p25_cc_freq != 0) {
                 long f = (state->trunk_cc_freq != 0) ? state->trunk_cc_freq : state->p25_cc_freq;
@@ -21,6 +21,7 @@
 
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/log.h>
+#include <dsd-neo/runtime/symbol_file.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -82,10 +83,10 @@ svc_open_symbol_out(dsd_opts* opts, dsd_state* state, const char* filename) {
 
 int
 svc_open_symbol_in(dsd_opts* opts, dsd_state* state, const char* filename) {
-    (void)state;
     if (!opts || !filename || !*filename) {
         return -1;
     }
+    dsd_symbol_in_reset(state);
     opts->symbolfile = fopen(filename, "r");
     if (!opts->symbolfile) {
         LOG_ERROR("Error, couldn't open %s\n", filename);
@@ -94,14 +95,12 @@ svc_open_symbol_in(dsd_opts* opts, dsd_state* state, const char* filename) {
     dsd_stat_t sb;
     if (dsd_fstat(dsd_fileno(opts->symbolfile), &sb) != 0) {
         LOG_ERROR("Error, couldn't stat %s\n", filename);
-        fclose(opts->symbolfile);
-        opts->symbolfile = NULL;
+        dsd_symbol_in_close(opts);
         return -1;
     }
     if (!S_ISREG(sb.st_mode)) {
         LOG_ERROR("Error, %s is not a regular file\n", filename);
-        fclose(opts->symbolfile);
-        opts->symbolfile = NULL;
+        dsd_symbol_in_close(opts);
         return -1;
     }
     snprintf(opts->audio_in_dev, sizeof opts->audio_in_dev, "%s", filename);
@@ -111,10 +110,10 @@ svc_open_symbol_in(dsd_opts* opts, dsd_state* state, const char* filename) {
 
 int
 svc_replay_last_symbol(dsd_opts* opts, dsd_state* state) {
-    (void)state;
     if (!opts) {
         return -1;
     }
+    dsd_symbol_in_reset(state);
     opts->symbolfile = fopen(opts->audio_in_dev, "r");
     if (!opts->symbolfile) {
         LOG_ERROR("Error, couldn't open %s\n", opts->audio_in_dev);
@@ -123,14 +122,12 @@ svc_replay_last_symbol(dsd_opts* opts, dsd_state* state) {
     dsd_stat_t sb;
     if (dsd_fstat(dsd_fileno(opts->symbolfile), &sb) != 0) {
         LOG_ERROR("Error, couldn't stat %s\n", opts->audio_in_dev);
-        fclose(opts->symbolfile);
-        opts->symbolfile = NULL;
+        dsd_symbol_in_close(opts);
         return -1;
     }
     if (!S_ISREG(sb.st_mode)) {
         LOG_ERROR("Error, %s is not a regular file\n", opts->audio_in_dev);
-        fclose(opts->symbolfile);
-        opts->symbolfile = NULL;
+        dsd_symbol_in_close(opts);
         return -1;
     }
     opts->audio_in_type = AUDIO_IN_SYMBOL_BIN; // symbol capture bin
@@ -144,7 +141,7 @@ svc_stop_symbol_playback(dsd_opts* opts) {
     }
     if (opts->symbolfile != NULL) {
         if (opts->audio_in_type == AUDIO_IN_SYMBOL_BIN) {
-            fclose(opts->symbolfile);
+            dsd_symbol_in_close(opts);
         }
         opts->symbolfile = NULL;
     }
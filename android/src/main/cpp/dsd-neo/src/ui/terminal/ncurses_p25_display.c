@@ -17,6 +17,7 @@
 #include <dsd-neo/protocol/p25/p25_sm_watchdog.h>
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
 #include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/p25_p2_audio_ring.h>
 #include <dsd-neo/runtime/trunk_cc_candidates.h>
 #include <dsd-neo/ui/ncurses_internal.h>
 #include <dsd-neo/ui/ui_prims.h>
@@ -404,8 +405,8 @@ ui_print_p25_metrics(const dsd_opts* opts, const dsd_state* state) {
     /* P2 slot and jitter ring status (when on a P2 channel) */
     if (is_p25p2) {
         int act = state->p25_p2_active_slot;
-        int lfill = state->p25_p2_audio_ring_count[0];
-        int rfill = state->p25_p2_audio_ring_count[1];
+        int lfill = p25_p2_audio_ring_count(state, 0);
+        int rfill = p25_p2_audio_ring_count(state, 1);
         if (lfill < 0) {
             lfill = 0;
         }
@@ -442,8 +443,8 @@ ui_print_p25_metrics(const dsd_opts* opts, const dsd_state* state) {
             }
         }
         // After hangtime, ignore stale audio_allowed alone; require ring gated by MAC recency
-        int l_ring = (state->p25_p2_audio_ring_count[0] > 0) && (l_dmac >= 0.0) && (l_dmac <= ring_hold);
-        int r_ring = (state->p25_p2_audio_ring_count[1] > 0) && (r_dmac >= 0.0) && (r_dmac <= ring_hold);
+        int l_ring = (p25_p2_audio_ring_count(state, 0) > 0) && (l_dmac >= 0.0) && (l_dmac <= ring_hold);
+        int r_ring = (p25_p2_audio_ring_count(state, 1) > 0) && (r_dmac >= 0.0) && (r_dmac <= ring_hold);
         int l_has = state->p25_p2_audio_allowed[0] || l_ring;
         int r_has = state->p25_p2_audio_allowed[1] || r_ring;
         if (opts && dt >= opts->trunk_hangtime) {
@@ -459,8 +460,8 @@ ui_print_p25_metrics(const dsd_opts* opts, const dsd_state* state) {
             r_act = 1;
         }
         printw("| SM Gate: L[a=%d rc=%d dMAC=%4.1fs act=%d]  R[a=%d rc=%d dMAC=%4.1fs act=%d]  dt=%4.1fs tune=%4.1fs\n",
-               state->p25_p2_audio_allowed[0] ? 1 : 0, state->p25_p2_audio_ring_count[0], l_dmac, l_act,
-               state->p25_p2_audio_allowed[1] ? 1 : 0, state->p25_p2_audio_ring_count[1], r_dmac, r_act, dt, dt_tune);
+               state->p25_p2_audio_allowed[0] ? 1 : 0, p25_p2_audio_ring_count(state, 0), l_dmac, l_act,
+               state->p25_p2_audio_allowed[1] ? 1 : 0, p25_p2_audio_ring_count(state, 1), r_dmac, r_act, dt, dt_tune);
         lines++;
     }
 
@@ -752,14 +753,14 @@ ui_guess_active_vc_freq(const dsd_state* state) {
         char* endp = NULL;
         long ch_hex = strtol(tok, &endp, 16);
         if (endp && *endp == '\0' && ch_hex > 0 && ch_hex < 65535) {
-            long int f = state->trunk_chan_map[ch_hex];
+            long int f = dsd_chan_map_get(&state->trunk_chan_map, ch_hex);
             if (f != 0) {
                 return f;
             }
         }
         long ch_dec = strtol(tok, &endp, 10);
         if (endp && *endp == '\0' && ch_dec > 0 && ch_dec < 65535) {
-            long int f = state->trunk_chan_map[ch_dec];
+            long int f = dsd_chan_map_get(&state->trunk_chan_map, ch_dec);
             if (f != 0) {
                 return f;
             }
@@ -19,6 +19,23 @@
 #include <string.h>
 #include <time.h>
 
+// Channel listed for a learned frequency: the lowest channel mapping it, skipping
+// channel 0, which is never listed.
+static long int
+listed_channel(const dsd_chan_map* map, long int freq) {
+    long int ch = dsd_chan_map_find_freq(map, freq);
+    if (ch != 0) {
+        return ch;
+    }
+    const uint16_t* sorted = dsd_chan_map_sorted(map);
+    for (uint32_t n = 1; n < dsd_chan_map_count(map); n++) {
+        if (dsd_chan_map_get(map, sorted[n]) == freq) {
+            return sorted[n];
+        }
+    }
+    return -1;
+}
+
 // Print learned trunking LCNs and their mapped frequencies
 void
 ui_print_learned_lcns(const dsd_opts* opts, const dsd_state* state) {
@@ -37,14 +54,11 @@ ui_print_learned_lcns(const dsd_opts* opts, const dsd_state* state) {
         }
     }
 
-    int have_chan_map = 0;
-    // Presence check across the full range; needed because many systems use high channel indices
-    for (int i = 1; i < 65535; i++) {
-        if (state->trunk_chan_map[i] != 0) {
-            have_chan_map = 1;
-            break;
-        }
-    }
+    // The map keeps its channels sorted, so nothing is collected or sorted per refresh
+    const dsd_chan_map* map = &state->trunk_chan_map;
+    const uint16_t* sorted = dsd_chan_map_sorted(map);
+    uint32_t map_count = dsd_chan_map_count(map);
+    int have_chan_map = map_count > 0;
 
     if (!have_lcn_freq && !have_chan_map) {
         return;
@@ -59,64 +73,50 @@ ui_print_learned_lcns(const dsd_opts* opts, const dsd_state* state) {
         attron(COLOR_PAIR(4));
     }
 
-    // Track which freqs we've already shown to avoid duplicates across LCNs and CH map
-    long int seen_freqs[256];
-    int seen_count = 0;
     int cols_per_line = 3;
     int col_in_row = 0;
 
-    // First: render known channel->frequency pairs as CH <hex>
+    // First: render known channel->frequency pairs as CH <hex>, one per distinct frequency
     if (have_chan_map) {
         int printed = 0;
-        int extra = 0;
-        for (int i = 1; i < 65535; i++) {
-            long int f = state->trunk_chan_map[i];
-            if (f == 0) {
+        for (uint32_t n = 0; n < map_count && printed < 32; n++) { // cap to avoid flooding (rows of 3)
+            int i = (int)sorted[n];
+            long int f = dsd_chan_map_get(map, i);
+            if (i < 1 || listed_channel(map, f) != i) {
                 continue;
             }
-            int dup = 0;
-            for (int k = 0; k < seen_count; k++) {
-                if (seen_freqs[k] == f) {
-                    dup = 1;
-                    break;
-                }
-            }
-            if (dup) {
-                continue;
+            if (col_in_row == 0) {
+                ui_print_lborder_green();
+                addch(' ');
             }
-            if (printed < 32) { // cap to avoid flooding (rows of 3)
-                if (col_in_row == 0) {
-                    ui_print_lborder_green();
-                    addch(' ');
-                }
-                // Temporarily tint IDEN-derived channels
-                attr_t saved_attrs = 0;
-                short saved_pair = 0;
-                attr_get(&saved_attrs, &saved_pair, NULL);
-                int iden = -1;
-                int is_iden = ui_match_iden_channel(state, i, f, &iden);
-                if (is_iden) {
-                    attron(COLOR_PAIR(ui_iden_color_pair(iden)));
-                    printw("CH %04X[I%d]: %010.06lf MHz", i & 0xFFFF, iden & 0xF, (double)f / 1000000.0);
-                    attr_set(saved_attrs, saved_pair, NULL);
-                } else {
-                    printw("CH %04X: %010.06lf MHz", i & 0xFFFF, (double)f / 1000000.0);
-                }
-                col_in_row++;
-                printed++;
-                if (col_in_row >= cols_per_line) {
-                    addch('\n');
-                    col_in_row = 0;
-                } else {
-                    addstr("   "); // spacing between columns
-                }
+            // Temporarily tint IDEN-derived channels
+            attr_t saved_attrs = 0;
+            short saved_pair = 0;
+            attr_get(&saved_attrs, &saved_pair, NULL);
+            int iden = -1;
+            int is_iden = ui_match_iden_channel(state, i, f, &iden);
+            if (is_iden) {
+                attron(COLOR_PAIR(ui_iden_color_pair(iden)));
+                printw("CH %04X[I%d]: %010.06lf MHz", i & 0xFFFF, iden & 0xF, (double)f / 1000000.0);
+                attr_set(saved_attrs, saved_pair, NULL);
             } else {
-                extra++;
+                printw("CH %04X: %010.06lf MHz", i & 0xFFFF, (double)f / 1000000.0);
             }
-            if (seen_count < (int)(sizeof(seen_freqs) / sizeof(seen_freqs[0]))) {
-                seen_freqs[seen_count++] = f;
+            col_in_row++;
+            printed++;
+            if (col_in_row >= cols_per_line) {
+                addch('\n');
+                col_in_row = 0;
+            } else {
+                addstr("   "); // spacing between columns
             }
         }
+        // Frequencies mapped only by channel 0 are not listed here
+        int listed = (int)dsd_chan_map_distinct_freqs(map);
+        if (map_count > 0 && sorted[0] == 0 && listed_channel(map, dsd_chan_map_get(map, 0)) < 0) {
+            listed--;
+        }
+        int extra = listed - printed;
         if (col_in_row > 0) { // flush partial row before switching to LCN list
             addch('\n');
             col_in_row = 0; // reset so the next section starts with a fresh border
@@ -131,12 +131,12 @@ ui_print_learned_lcns(const dsd_opts* opts, const dsd_state* state) {
     if (have_lcn_freq) {
         for (int i = 0; i < 26; i++) {
             long int f = state->trunk_lcn_freq[i];
-            if (f == 0) {
-                continue;
+            if (f == 0 || listed_channel(map, f) >= 0) {
+                continue; // empty, or already counted with the learned channels above
             }
             int dup = 0;
-            for (int k = 0; k < seen_count; k++) {
-                if (seen_freqs[k] == f) {
+            for (int k = 0; k < i; k++) {
+                if (state->trunk_lcn_freq[k] == f) {
                     dup = 1;
                     break;
                 }
@@ -145,13 +145,7 @@ ui_print_learned_lcns(const dsd_opts* opts, const dsd_state* state) {
                 continue;
             }
             // Try to find a matching channel id for this freq
-            int found_ch = -1;
-            for (int j = 1; j < 65535; j++) {
-                if (state->trunk_chan_map[j] == f) {
-                    found_ch = j;
-                    break;
-                }
-            }
+            int found_ch = (int)dsd_chan_map_find_freq(map, f);
             if (found_ch >= 0) {
                 if (col_in_row == 0) {
                     ui_print_lborder_green();
@@ -184,9 +178,6 @@ ui_print_learned_lcns(const dsd_opts* opts, const dsd_state* state) {
             } else {
                 addstr("   ");
             }
-            if (seen_count < (int)(sizeof(seen_freqs) / sizeof(seen_freqs[0]))) {
-                seen_freqs[seen_count++] = f;
-            }
         }
         if (col_in_row > 0) {
             addch('\n');
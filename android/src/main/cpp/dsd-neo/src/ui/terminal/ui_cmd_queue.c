@@ -32,6 +32,7 @@
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/freq_parse.h>
 #include <dsd-neo/runtime/log.h>
+#include <dsd-neo/runtime/symbol_file.h>
 #include <dsd-neo/ui/menu_services.h>
 
 #include <stdio.h>
@@ -622,6 +623,7 @@ apply_cmd(dsd_opts* opts, dsd_state* state, const struct UiCmd* c) {
                 break;
             }
             if (S_ISREG(sb.st_mode)) {
+                dsd_symbol_in_reset(state);
                 opts->symbolfile = fopen(opts->audio_in_dev, "r");
                 if (opts->symbolfile) {
                     opts->audio_in_type = AUDIO_IN_SYMBOL_BIN;
@@ -656,9 +658,10 @@ apply_cmd(dsd_opts* opts, dsd_state* state, const struct UiCmd* c) {
             break;
         }
         case UI_CMD_STOP_PLAYBACK: {
+            dsd_symbol_in_reset(state);
             if (opts->symbolfile != NULL) {
                 if (opts->audio_in_type == AUDIO_IN_SYMBOL_BIN) {
-                    fclose(opts->symbolfile);
+                    dsd_symbol_in_close(opts);
                 }
                 opts->symbolfile = NULL;
             }
@@ -12,10 +12,24 @@
 
 static dsd_state g_pub;     // latest published by demod thread
 static dsd_state g_consume; // last copied out for UI
-// Deep-copied backing for pointer-backed members the UI dereferences.
-// Currently, only event history is pointer-backed in dsd_state for UI reads.
+// Deep-copied backing for pointer-backed members the UI dereferences:
+// event history, and the most recent entries of the P25 affiliation registries.
 static Event_History_I g_pub_eh[2];
 static Event_History_I g_consume_eh[2];
+static dsd_unit_registry g_pub_aff, g_pub_ga;
+static dsd_unit_registry g_consume_aff, g_consume_ga;
+
+// The UI lists at most 20 entries per registry, newest first
+#define UI_SNAPSHOT_REGISTRY_MAX 20
+
+// Point `out` at a bounded copy of `src` owned by `backing`, or at an empty table on failure.
+static void
+snapshot_registry(dsd_unit_registry* out, dsd_unit_registry* backing, const dsd_unit_registry* src) {
+    if (dsd_unit_registry_copy_recent(backing, src, UI_SNAPSHOT_REGISTRY_MAX) < 0) {
+        dsd_unit_registry_clear(backing);
+    }
+    *out = *backing;
+}
 static int g_have = 0;
 static dsd_mutex_t g_mu;
 static atomic_int g_mu_init = 0;
@@ -45,6 +59,8 @@ ui_terminal_telemetry_publish_snapshot(const dsd_state* state) {
     } else {
         g_pub.event_history_s = NULL;
     }
+    snapshot_registry(&g_pub.p25_aff, &g_pub_aff, &state->p25_aff);
+    snapshot_registry(&g_pub.p25_ga, &g_pub_ga, &state->p25_ga);
     g_have = 1;
     dsd_mutex_unlock(&g_mu);
 }
@@ -67,6 +83,8 @@ ui_get_latest_snapshot(void) {
     } else {
         g_consume.event_history_s = NULL;
     }
+    snapshot_registry(&g_consume.p25_aff, &g_consume_aff, &g_pub_aff);
+    snapshot_registry(&g_consume.p25_ga, &g_consume_ga, &g_pub_ga);
     dsd_mutex_unlock(&g_mu);
     return &g_consume;
 }
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Sparse channel map: set/get/remove, reverse lookup with shared frequencies,
+ * capacity limit, ordered iteration, and consistency of both tables, the
+ * sorted channel list and the distinct-frequency count against a flat
+ * reference array under random churn (exercises backward-shift deletion).
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dsd-neo/core/chan_map.h>
+
+static dsd_chan_map g_map;
+static long int g_ref[DSD_CHAN_MAP_MAX_CHANNEL + 1];
+
+static uint32_t g_rng = 0x1234567u;
+
+static uint32_t
+rnd(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+typedef struct {
+    long int sum_chan;
+    long int sum_freq;
+    size_t stop_after;
+    size_t calls;
+} visit_ctx;
+
+static int
+visit(long int channel, long int freq, void* user) {
+    visit_ctx* ctx = (visit_ctx*)user;
+    ctx->sum_chan += channel;
+    ctx->sum_freq += freq;
+    ctx->calls++;
+    return (ctx->stop_after != 0 && ctx->calls >= ctx->stop_after) ? 1 : 0;
+}
+
+static long int
+ref_find_freq(long int freq) {
+    for (long int ch = 0; ch <= DSD_CHAN_MAP_MAX_CHANNEL; ch++) {
+        if (g_ref[ch] == freq) {
+            return ch;
+        }
+    }
+    return -1;
+}
+
+/* Sorted list holds exactly the reference's mapped channels, ascending. */
+static void
+check_sorted(void) {
+    const uint16_t* sorted = dsd_chan_map_sorted(&g_map);
+    uint32_t n = 0;
+    for (long int ch = 0; ch <= DSD_CHAN_MAP_MAX_CHANNEL; ch++) {
+        if (g_ref[ch] == 0) {
+            continue;
+        }
+        if (n >= dsd_chan_map_count(&g_map) || sorted[n] != ch) {
+            fprintf(stderr, "sorted[%u] != %ld\n", n, ch);
+            exit(1);
+        }
+        n++;
+    }
+    assert(n == dsd_chan_map_count(&g_map));
+    (void)sorted;
+}
+
+static void
+test_basic(void) {
+    dsd_chan_map_clear(&g_map);
+    assert(dsd_chan_map_count(&g_map) == 0);
+    assert(dsd_chan_map_get(&g_map, 5) == 0);
+    assert(dsd_chan_map_find_freq(&g_map, 851000000) == -1);
+
+    int rc = dsd_chan_map_set(&g_map, 0x1234, 851012500);
+    assert(rc == 0);
+    rc = dsd_chan_map_set(&g_map, 0, 851000000);
+    assert(rc == 0);
+    rc = dsd_chan_map_set(&g_map, DSD_CHAN_MAP_MAX_CHANNEL, 852000000);
+    assert(rc == 0);
+    assert(dsd_chan_map_count(&g_map) == 3);
+    assert(dsd_chan_map_get(&g_map, 0x1234) == 851012500);
+    assert(dsd_chan_map_get(&g_map, 0) == 851000000);
+    assert(dsd_chan_map_get(&g_map, DSD_CHAN_MAP_MAX_CHANNEL) == 852000000);
+
+    /* Out-of-range channels are rejected and read as unmapped. */
+    rc = dsd_chan_map_set(&g_map, -1, 1);
+    assert(rc == -1);
+    rc = dsd_chan_map_set(&g_map, DSD_CHAN_MAP_MAX_CHANNEL + 1, 1);
+    assert(rc == -1);
+    assert(dsd_chan_map_get(&g_map, -1) == 0);
+    assert(dsd_chan_map_get(&g_map, 0x10000) == 0);
+
+    /* Overwrite moves the reverse entry. */
+    rc = dsd_chan_map_set(&g_map, 0x1234, 853000000);
+    assert(rc == 0);
+    assert(dsd_chan_map_count(&g_map) == 3);
+    assert(dsd_chan_map_find_freq(&g_map, 851012500) == -1);
+    assert(dsd_chan_map_find_freq(&g_map, 853000000) == 0x1234);
+
+    /* Shared frequency resolves to the lowest channel. */
+    rc = dsd_chan_map_set(&g_map, 0x0100, 853000000);
+    assert(rc == 0);
+    assert(dsd_chan_map_find_freq(&g_map, 853000000) == 0x0100);
+    rc = dsd_chan_map_set(&g_map, 0x0100, 0);
+    assert(rc == 0);
+    assert(dsd_chan_map_find_freq(&g_map, 853000000) == 0x1234);
+
+    /* Zero frequency removes; removing an absent channel is a no-op. */
+    rc = dsd_chan_map_set(&g_map, 0x1234, 0);
+    assert(rc == 0);
+    rc = dsd_chan_map_set(&g_map, 0x4321, 0);
+    assert(rc == 0);
+    assert(dsd_chan_map_get(&g_map, 0x1234) == 0);
+    assert(dsd_chan_map_count(&g_map) == 2);
+
+    visit_ctx ctx = {0, 0, 0, 0};
+    size_t n = dsd_chan_map_foreach(&g_map, visit, &ctx);
+    assert(n == 2);
+    assert(ctx.sum_chan == DSD_CHAN_MAP_MAX_CHANNEL);
+    assert(ctx.sum_freq == 851000000L + 852000000L);
+    assert(dsd_chan_map_distinct_freqs(&g_map) == 2);
+
+    /* Iteration is in channel order; the first visit is the lowest channel. */
+    visit_ctx stop = {0, 0, 1, 0};
+    n = dsd_chan_map_foreach(&g_map, visit, &stop);
+    assert(n == 1 && stop.sum_chan == 0 && stop.sum_freq == 851000000);
+    (void)n;
+    (void)rc;
+}
+
+static void
+test_capacity(void) {
+    dsd_chan_map_clear(&g_map);
+    for (long int ch = 0; ch < DSD_CHAN_MAP_MAX_ENTRIES; ch++) {
+        int rc = dsd_chan_map_set(&g_map, ch * 7, 850000000 + ch * 12500);
+        assert(rc == 0);
+        (void)rc;
+    }
+    assert(dsd_chan_map_count(&g_map) == DSD_CHAN_MAP_MAX_ENTRIES);
+    int rc = dsd_chan_map_set(&g_map, 0xFFF0, 1);
+    assert(rc == -1);
+    /* Updating an existing channel still works when full. */
+    rc = dsd_chan_map_set(&g_map, 7, 1);
+    assert(rc == 0);
+    assert(dsd_chan_map_get(&g_map, 7) == 1);
+    for (long int ch = 0; ch < DSD_CHAN_MAP_MAX_ENTRIES; ch++) {
+        long int want = (ch == 1) ? 1 : 850000000 + ch * 12500;
+        assert(dsd_chan_map_get(&g_map, ch * 7) == want);
+        assert(dsd_chan_map_find_freq(&g_map, want) == ch * 7);
+        (void)want;
+    }
+    (void)rc;
+}
+
+static void
+test_churn(void) {
+    dsd_chan_map_clear(&g_map);
+    memset(g_ref, 0, sizeof(g_ref));
+    uint32_t count = 0;
+    for (int step = 0; step < 200000; step++) {
+        long int ch = (long int)(rnd() % 2048u) * 31;
+        /* Few distinct frequencies so reverse-index runs collide. */
+        long int freq = (rnd() % 4u == 0) ? 0 : 851000000 + (long int)(rnd() % 64u) * 6250;
+        int rc = dsd_chan_map_set(&g_map, ch, freq);
+        assert(rc == 0);
+        (void)rc;
+        if (g_ref[ch] == 0 && freq != 0) {
+            count++;
+        } else if (g_ref[ch] != 0 && freq == 0) {
+            count--;
+        }
+        g_ref[ch] = freq;
+        assert(dsd_chan_map_count(&g_map) == count);
+        if ((step % 20000) == 0) {
+            for (long int c = 0; c <= DSD_CHAN_MAP_MAX_CHANNEL; c++) {
+                assert(dsd_chan_map_get(&g_map, c) == g_ref[c]);
+            }
+            uint32_t distinct = 0;
+            for (int k = 0; k < 64; k++) {
+                long int f = 851000000 + (long int)k * 6250;
+                long int want = ref_find_freq(f);
+                assert(dsd_chan_map_find_freq(&g_map, f) == want);
+                distinct += (want >= 0) ? 1u : 0u;
+            }
+            assert(dsd_chan_map_distinct_freqs(&g_map) == distinct);
+            (void)distinct;
+            check_sorted();
+        }
+    }
+}
+
+int
+main(void) {
+    test_basic();
+    test_capacity();
+    test_churn();
+    printf("CORE_CHAN_MAP: OK\n");
+    return 0;
+}
@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Synth pipeline queue behavior: drop policies, muted frames, reset markers,
+ * per-slot lanes and metrics, using a sink that can be held closed to
+ * simulate slow audio.
+ */
+
+#include <dsd-neo/core/synth_pipeline.h>
+#include <dsd-neo/platform/atomic_compat.h>
+#include <dsd-neo/platform/timing.h>
+
+#include <stdio.h>
+#include <string.h>
+
+static atomic_int s_gate_open;
+static atomic_int s_sink_entered;
+static atomic_int s_sink_calls;
+
+static void
+test_sink(void* user, int slot, const short* pcm, size_t n) {
+    (void)user;
+    (void)slot;
+    (void)pcm;
+    if (n != 160) {
+        return;
+    }
+    atomic_store(&s_sink_entered, 1);
+    while (!atomic_load(&s_gate_open)) {
+        dsd_sleep_ms(1);
+    }
+    atomic_fetch_add(&s_sink_calls, 1);
+}
+
+static void
+make_frame(dsd_synth_frame* f, int slot) {
+    memset(f, 0, sizeof(*f));
+    f->slot = slot;
+    f->vocoder = DSD_SYNTH_AMBE_2450;
+    f->gain = 0.0f;
+}
+
+static void
+reset_sink(void) {
+    atomic_store(&s_gate_open, 0);
+    atomic_store(&s_sink_entered, 0);
+    atomic_store(&s_sink_calls, 0);
+}
+
+static int
+wait_sink_entered(void) {
+    for (int i = 0; i < 2000; i++) {
+        if (atomic_load(&s_sink_entered)) {
+            return 1;
+        }
+        dsd_sleep_ms(1);
+    }
+    return 0;
+}
+
+/* Holds the worker inside the sink with one frame, then overfills a depth-2 queue. */
+static int
+run_policy(int policy, int expect_accepts, dsd_synth_pipeline_metrics* m) {
+    dsd_synth_pipeline_config cfg = {2, policy, 5};
+    dsd_synth_frame f;
+    int accepted = 0;
+
+    reset_sink();
+    dsd_synth_pipeline* p = dsd_synth_pipeline_create(&cfg, test_sink, NULL);
+    if (!p) {
+        fprintf(stderr, "create failed\n");
+        return 1;
+    }
+    make_frame(&f, 0);
+    if (dsd_synth_pipeline_submit(p, &f) != 1 || !wait_sink_entered()) {
+        fprintf(stderr, "worker did not start\n");
+        dsd_synth_pipeline_destroy(p);
+        return 1;
+    }
+    for (int i = 0; i < 4; i++) {
+        make_frame(&f, i & 1);
+        accepted += (dsd_synth_pipeline_submit(p, &f) == 1);
+    }
+    atomic_store(&s_gate_open, 1);
+    if (dsd_synth_pipeline_wait_idle(p, 2000) != 0) {
+        fprintf(stderr, "wait_idle timed out\n");
+        dsd_synth_pipeline_destroy(p);
+        return 1;
+    }
+    dsd_synth_pipeline_get_metrics(p, m);
+    dsd_synth_pipeline_destroy(p);
+
+    if (accepted != expect_accepts) {
+        fprintf(stderr, "policy %d accepted %d, expected %d\n", policy, accepted, expect_accepts);
+        return 1;
+    }
+    if (m->synthesized != 3 || m->played != 3 || atomic_load(&s_sink_calls) != 3 || m->max_depth != 2
+        || m->depth != 0) {
+        fprintf(stderr, "policy %d: synthesized=%llu played=%llu max_depth=%d\n", policy,
+                (unsigned long long)m->synthesized, (unsigned long long)m->played, m->max_depth);
+        return 1;
+    }
+    if (m->latency_max_ns == 0 || m->latency_sum_ns < m->latency_max_ns) {
+        fprintf(stderr, "policy %d: latency metrics not recorded\n", policy);
+        return 1;
+    }
+    return 0;
+}
+
+/* With per-slot lanes a stalled slot 0 must not back up slot 1's queue. */
+static int
+run_lanes(void) {
+    dsd_synth_pipeline_config cfg = {2, DSD_SYNTH_DROP_NEWEST, 0, 2};
+    dsd_synth_pipeline_metrics m;
+    dsd_synth_frame f;
+    int rc = 0;
+
+    reset_sink();
+    dsd_synth_pipeline* p = dsd_synth_pipeline_create(&cfg, test_sink, NULL);
+    if (!p || dsd_synth_pipeline_lanes(p) != 2) {
+        fprintf(stderr, "two-lane create failed\n");
+        dsd_synth_pipeline_destroy(p);
+        return 1;
+    }
+    make_frame(&f, 0);
+    if (dsd_synth_pipeline_submit(p, &f) != 1 || !wait_sink_entered()) {
+        fprintf(stderr, "lane 0 worker did not start\n");
+        dsd_synth_pipeline_destroy(p);
+        return 1;
+    }
+    int accepted0 = 0;
+    for (int i = 0; i < 3; i++) {
+        accepted0 += (dsd_synth_pipeline_submit(p, &f) == 1);
+    }
+    make_frame(&f, 1);
+    int accepted1 = 0;
+    for (int i = 0; i < 2; i++) {
+        accepted1 += (dsd_synth_pipeline_submit(p, &f) == 1);
+    }
+    atomic_store(&s_gate_open, 1);
+    if (dsd_synth_pipeline_wait_idle(p, 2000) != 0) {
+        fprintf(stderr, "two-lane wait_idle timed out\n");
+        dsd_synth_pipeline_destroy(p);
+        return 1;
+    }
+    dsd_synth_pipeline_get_metrics(p, &m);
+    dsd_synth_pipeline_destroy(p);
+
+    if (accepted0 != 2 || accepted1 != 2) {
+        fprintf(stderr, "lanes accepted %d/%d, expected 2/2\n", accepted0, accepted1);
+        rc = 1;
+    }
+    if (m.synthesized != 5 || m.played != 5 || atomic_load(&s_sink_calls) != 5 || m.dropped_newest != 1
+        || m.depth != 0) {
+        fprintf(stderr, "two-lane counters wrong: synthesized=%llu dropped_newest=%llu\n",
+                (unsigned long long)m.synthesized, (unsigned long long)m.dropped_newest);
+        rc = 1;
+    }
+    return rc;
+}
+
+int
+main(void) {
+    dsd_synth_pipeline_metrics m;
+    int rc = 0;
+
+    if (dsd_synth_pipeline_create(NULL, NULL, NULL) != NULL) {
+        return 1;
+    }
+    dsd_synth_pipeline_config bad = {0, DSD_SYNTH_DROP_OLDEST, 0};
+    if (dsd_synth_pipeline_create(&bad, test_sink, NULL) != NULL) {
+        return 2;
+    }
+
+    rc |= run_policy(DSD_SYNTH_DROP_OLDEST, 4, &m);
+    if (m.submitted != 5 || m.dropped_oldest != 2 || m.dropped_newest != 0) {
+        fprintf(stderr, "drop-oldest counters wrong\n");
+        rc |= 1;
+    }
+
+    rc |= run_policy(DSD_SYNTH_DROP_NEWEST, 2, &m);
+    if (m.submitted != 3 || m.dropped_oldest != 0 || m.dropped_newest != 2) {
+        fprintf(stderr, "drop-newest counters wrong\n");
+        rc |= 1;
+    }
+
+    rc |= run_policy(DSD_SYNTH_BLOCK, 2, &m);
+    if (m.dropped_newest != 2 || m.producer_waits != 2) {
+        fprintf(stderr, "block counters wrong\n");
+        rc |= 1;
+    }
+
+    rc |= run_lanes();
+
+    /* Muted frames are synthesized for continuity but never reach the sink; resets are not frames. */
+    reset_sink();
+    atomic_store(&s_gate_open, 1);
+    dsd_synth_pipeline* p = dsd_synth_pipeline_create(NULL, test_sink, NULL);
+    if (!p) {
+        return 3;
+    }
+    dsd_synth_frame f;
+    make_frame(&f, 1);
+    f.muted = 1;
+    (void)dsd_synth_pipeline_submit(p, &f);
+    dsd_synth_pipeline_reset(p, -1);
+    make_frame(&f, 1);
+    f.vocoder = DSD_SYNTH_IMBE_4400;
+    (void)dsd_synth_pipeline_submit(p, &f);
+    if (dsd_synth_pipeline_wait_idle(p, 2000) != 0) {
+        dsd_synth_pipeline_destroy(p);
+        return 4;
+    }
+    dsd_synth_pipeline_get_metrics(p, &m);
+    dsd_synth_pipeline_destroy(p);
+    if (m.synthesized != 2 || m.played != 1 || atomic_load(&s_sink_calls) != 1) {
+        fprintf(stderr, "muted/reset handling wrong: synthesized=%llu played=%llu\n",
+                (unsigned long long)m.synthesized, (unsigned long long)m.played);
+        rc |= 1;
+    }
+
+    return rc;
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Unit registry: touch/find/remove, dense storage and growth past the
+ * initial capacity, LRU eviction at the cap, expiry from the old end,
+ * recent-first listing, bounded copies, and a zero-filled registry.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dsd-neo/core/unit_registry.h>
+
+static void
+check_dense(const dsd_unit_registry* reg) {
+    for (int i = 0; i < reg->count; i++) {
+        int idx = dsd_unit_registry_find(reg, reg->rid[i], reg->tg[i]);
+        assert(idx == i);
+        (void)idx;
+    }
+}
+
+static void
+test_basic(void) {
+    dsd_unit_registry reg;
+    dsd_unit_registry_init(&reg, 0);
+    assert(dsd_unit_registry_find(&reg, 1, 0) == -1);
+    assert(dsd_unit_registry_newest_seen(&reg) == 0);
+    assert(dsd_unit_registry_oldest_seen(&reg) == 0);
+
+    /* Grows well past the old fixed 512-entry table. */
+    for (uint32_t rid = 1; rid <= 5000; rid++) {
+        int idx = dsd_unit_registry_touch(&reg, rid, (uint16_t)(rid % 7), (time_t)rid);
+        assert(idx >= 0);
+        (void)idx;
+    }
+    assert(reg.count == 5000);
+    check_dense(&reg);
+    assert(dsd_unit_registry_newest_seen(&reg) == 5000);
+    assert(dsd_unit_registry_oldest_seen(&reg) == 1);
+
+    /* Same RID with another TG is a distinct entry; a repeat touch is not. */
+    int a = dsd_unit_registry_touch(&reg, 10, 100, 6000);
+    int b = dsd_unit_registry_touch(&reg, 10, 100, 6001);
+    assert(a >= 0 && a == b);
+    assert(reg.count == 5001);
+    assert(reg.last_seen[b] == 6001);
+    (void)a;
+    (void)b;
+
+    assert(dsd_unit_registry_remove(&reg, 10, 100) == 1);
+    assert(dsd_unit_registry_remove(&reg, 10, 100) == 0);
+    assert(dsd_unit_registry_find(&reg, 10, 100) == -1);
+    assert(dsd_unit_registry_find(&reg, 10, 10 % 7) >= 0);
+    assert(reg.count == 5000);
+    check_dense(&reg);
+
+    /* Expiry removes the oldest first and stops at the first fresh entry. */
+    int removed = dsd_unit_registry_expire(&reg, 4000, 1000);
+    assert(removed == 2999);
+    assert(reg.count == 2001);
+    assert(dsd_unit_registry_find(&reg, 2999, 2999 % 7) == -1);
+    assert(dsd_unit_registry_find(&reg, 3000, 3000 % 7) >= 0);
+    check_dense(&reg);
+    (void)removed;
+
+    /* Refreshing moves an entry to the newest end. */
+    dsd_unit_registry_touch(&reg, 3000, 3000 % 7, 7000);
+    int recent[4];
+    int n = dsd_unit_registry_recent(&reg, recent, 4);
+    assert(n == 4);
+    assert(reg.rid[recent[0]] == 3000);
+    assert(reg.rid[recent[1]] == 5000);
+    assert(reg.rid[recent[2]] == 4999);
+    (void)n;
+
+    dsd_unit_registry_clear(&reg);
+    assert(reg.count == 0);
+    assert(dsd_unit_registry_find(&reg, 5000, 5000 % 7) == -1);
+    assert(dsd_unit_registry_touch(&reg, 42, 0, 1) == 0);
+    dsd_unit_registry_free(&reg);
+}
+
+static void
+test_cap(void) {
+    dsd_unit_registry reg;
+    dsd_unit_registry_init(&reg, 100);
+    for (uint32_t rid = 1; rid <= 100; rid++) {
+        dsd_unit_registry_touch(&reg, rid, 0, (time_t)rid);
+    }
+    /* Keep RID 1 alive, then overflow: RIDs 2 and 3 are evicted. */
+    dsd_unit_registry_touch(&reg, 1, 0, 200);
+    dsd_unit_registry_touch(&reg, 500, 0, 201);
+    dsd_unit_registry_touch(&reg, 501, 0, 202);
+    assert(reg.count == 100);
+    assert(dsd_unit_registry_find(&reg, 1, 0) >= 0);
+    assert(dsd_unit_registry_find(&reg, 2, 0) == -1);
+    assert(dsd_unit_registry_find(&reg, 3, 0) == -1);
+    assert(dsd_unit_registry_find(&reg, 4, 0) >= 0);
+    assert(dsd_unit_registry_find(&reg, 501, 0) >= 0);
+    check_dense(&reg);
+
+    dsd_unit_registry copy;
+    memset(&copy, 0, sizeof(copy));
+    int copied = dsd_unit_registry_copy_recent(&copy, &reg, 3);
+    assert(copied == 3);
+    assert(copy.count == 3);
+    int recent[3];
+    int n = dsd_unit_registry_recent(&copy, recent, 3);
+    assert(n == 3);
+    assert(copy.rid[recent[0]] == 501 && copy.rid[recent[1]] == 500 && copy.rid[recent[2]] == 1);
+    assert(copy.last_seen[recent[2]] == 200);
+    (void)copied;
+    (void)n;
+    dsd_unit_registry_free(&copy);
+    dsd_unit_registry_free(&reg);
+}
+
+static void
+test_zeroed(void) {
+    dsd_unit_registry reg;
+    memset(&reg, 0, sizeof(reg));
+    assert(dsd_unit_registry_expire(&reg, 100, 1) == 0);
+    assert(dsd_unit_registry_remove(&reg, 1, 0) == 0);
+    int recent[2];
+    assert(dsd_unit_registry_recent(&reg, recent, 2) == 0);
+    assert(dsd_unit_registry_touch(&reg, 7, 0, 5) == 0);
+    assert(dsd_unit_registry_touch(&reg, 8, 0, 6) == 1);
+    assert(dsd_unit_registry_expire(&reg, 100, 1) == 2);
+    assert(reg.count == 0);
+    assert(dsd_unit_registry_touch(&reg, 9, 0, 7) == 0);
+    dsd_unit_registry_free(&reg);
+}
+
+int
+main(void) {
+    test_basic();
+    test_cap();
+    test_zeroed();
+    printf("CORE_UNIT_REGISTRY: OK\n");
+    return 0;
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * 8 kHz to 48 kHz polyphase upsampler: unity DC gain, seamless output across
+ * arbitrary block splits, independent per-channel state, passband level and
+ * image rejection for a 1 kHz tone.
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dsd-neo/core/upsample.h>
+
+#define N_IN 480 /* 60 ms at 8 kHz */
+
+static const double k_pi = 3.14159265358979323846;
+
+/* Single-bin DFT magnitude, normalized to the amplitude of a sinusoid. */
+static double
+tone_level(const float* x, int n, double freq, double fs) {
+    double re = 0.0;
+    double im = 0.0;
+    for (int i = 0; i < n; i++) {
+        double ph = 2.0 * k_pi * freq * (double)i / fs;
+        re += x[i] * cos(ph);
+        im -= x[i] * sin(ph);
+    }
+    return 2.0 * sqrt((re * re) + (im * im)) / (double)n;
+}
+
+int
+main(void) {
+    static float in[N_IN];
+    static float out_a[N_IN * DSD_UPSAMPLE_FACTOR];
+    static float out_b[N_IN * DSD_UPSAMPLE_FACTOR];
+    dsd_upsampler us;
+
+    /* DC: after the filter fills, every phase reproduces the input level */
+    for (int i = 0; i < N_IN; i++) {
+        in[i] = 1000.0f;
+    }
+    dsd_upsampler_reset(&us);
+    dsd_upsample_8k_48k(&us, in, N_IN, out_a);
+    for (int i = DSD_UPSAMPLE_TAPS * DSD_UPSAMPLE_FACTOR; i < N_IN * DSD_UPSAMPLE_FACTOR; i++) {
+        assert(fabsf(out_a[i] - 1000.0f) < 0.05f);
+    }
+
+    /* 1 kHz tone: one whole block vs. ragged pieces must match exactly */
+    for (int i = 0; i < N_IN; i++) {
+        in[i] = (float)(8000.0 * sin(2.0 * k_pi * 1000.0 * (double)i / 8000.0));
+    }
+    dsd_upsampler_reset(&us);
+    dsd_upsample_8k_48k(&us, in, N_IN, out_a);
+
+    dsd_upsampler split;
+    dsd_upsampler_reset(&split);
+    static const int k_pieces[] = {1, 7, 160, 3, 200, 109};
+    int pos = 0;
+    for (size_t k = 0; k < sizeof(k_pieces) / sizeof(k_pieces[0]); k++) {
+        dsd_upsample_8k_48k(&split, &in[pos], (size_t)k_pieces[k], &out_b[pos * DSD_UPSAMPLE_FACTOR]);
+        pos += k_pieces[k];
+    }
+    assert(pos == N_IN);
+    assert(memcmp(out_a, out_b, sizeof(out_a)) == 0);
+    assert(memcmp(&us, &split, sizeof(us)) == 0);
+
+    /* Passband level and image rejection on the settled part (whole 1 kHz periods) */
+    const float* settled = &out_a[48 * 2];
+    int n = (N_IN * DSD_UPSAMPLE_FACTOR) - (48 * 2);
+    n -= n % 48;
+    double fund = tone_level(settled, n, 1000.0, 48000.0);
+    double image = tone_level(settled, n, 7000.0, 48000.0);
+    double image2 = tone_level(settled, n, 9000.0, 48000.0);
+    assert(fabs(fund - 8000.0) < 8000.0 * 0.01);
+    assert(image < 8000.0 * 0.001 && image2 < 8000.0 * 0.001); /* better than -60 dB */
+
+    /* Per-channel state: feeding a second channel leaves the first untouched */
+    dsd_upsampler left;
+    dsd_upsampler right;
+    dsd_upsampler_reset(&left);
+    dsd_upsampler_reset(&right);
+    dsd_upsample_8k_48k(&left, in, 160, out_a);
+    dsd_upsampler saved = left;
+    for (int i = 0; i < 160; i++) {
+        in[i] = -in[i];
+    }
+    dsd_upsample_8k_48k(&right, in, 160, out_b);
+    assert(memcmp(&left, &saved, sizeof(left)) == 0);
+    for (int i = 0; i < 160 * DSD_UPSAMPLE_FACTOR; i++) {
+        assert(out_a[i] == -out_b[i]);
+    }
+
+    (void)fund;
+    (void)image;
+    (void)image2;
+    printf("CORE_UPSAMPLE: OK\n");
+    return 0;
+}
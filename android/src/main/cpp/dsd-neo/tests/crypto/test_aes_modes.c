@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * NIST SP 800-38A known answers for the AES mode wrappers, run through both
+ * the runtime-dispatched rounds and the forced portable rounds, plus key
+ * schedule cache churn.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dsd-neo/crypto/aes.h>
+
+static const uint8_t k128[16] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+static const uint8_t k192[24] = {0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b,
+                                 0x80, 0x90, 0x79, 0xe5, 0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b};
+static const uint8_t k256[32] = {0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae,
+                                 0xf0, 0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61,
+                                 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4};
+static const uint8_t iv[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                               0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+static const uint8_t pt[32] = {0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+                               0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+                               0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51};
+
+static int
+expect(const uint8_t* got, const uint8_t* want, size_t n, const char* what) {
+    if (memcmp(got, want, n) != 0) {
+        fprintf(stderr, "%s (%s): mismatch\n", what, aes_get_impl_name());
+        return 1;
+    }
+    return 0;
+}
+
+static int
+run_vectors(void) {
+    int rc = 0;
+    uint8_t out[32];
+    uint8_t back[32];
+
+    static const uint8_t ecb192[16] = {0xbd, 0x33, 0x4f, 0x1d, 0x6e, 0x45, 0xf2, 0x5f,
+                                       0xf7, 0x12, 0xa2, 0x14, 0x57, 0x1f, 0xa5, 0xcc};
+    static const uint8_t ecb256[16] = {0xf3, 0xee, 0xd1, 0xbd, 0xb5, 0xd2, 0xa0, 0x3c,
+                                       0x06, 0x4b, 0x5a, 0x7e, 0x3d, 0xb1, 0x81, 0xf8};
+    aes_ecb_bytewise_payload_crypt((uint8_t*)pt, (uint8_t*)k192, out, 1, 1);
+    rc |= expect(out, ecb192, 16, "ECB-AES192 encrypt");
+    aes_ecb_bytewise_payload_crypt(out, (uint8_t*)k192, back, 1, 0);
+    rc |= expect(back, pt, 16, "ECB-AES192 decrypt");
+    aes_ecb_bytewise_payload_crypt((uint8_t*)pt, (uint8_t*)k256, out, 2, 1);
+    rc |= expect(out, ecb256, 16, "ECB-AES256 encrypt");
+    aes_ecb_bytewise_payload_crypt(out, (uint8_t*)k256, back, 2, 0);
+    rc |= expect(back, pt, 16, "ECB-AES256 decrypt");
+
+    static const uint8_t cbc128[32] = {0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e,
+                                       0x9b, 0x12, 0xe9, 0x19, 0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72,
+                                       0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2};
+    aes_cbc_bytewise_payload_crypt((uint8_t*)iv, (uint8_t*)k128, (uint8_t*)pt, out, 0, 2, 1);
+    rc |= expect(out, cbc128, 32, "CBC-AES128 encrypt");
+    aes_cbc_bytewise_payload_crypt((uint8_t*)iv, (uint8_t*)k128, out, back, 0, 2, 0);
+    rc |= expect(back, pt, 32, "CBC-AES128 decrypt");
+
+    /* CBC-MAC of the same plaintext with the IV pre-XOR'd equals the last CBC block. */
+    uint8_t mac_in[32];
+    uint8_t mac[16];
+    memcpy(mac_in, pt, sizeof mac_in);
+    for (int i = 0; i < 16; i++) {
+        mac_in[i] ^= iv[i];
+    }
+    aes_cbc_mac_generator((uint8_t*)k128, mac_in, mac, 0, 2);
+    rc |= expect(mac, cbc128 + 16, 16, "CBC-MAC-AES128");
+
+    static const uint8_t cfb128[32] = {0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49,
+                                       0xf8, 0xe8, 0x3c, 0xfb, 0x4a, 0xc8, 0xa6, 0x45, 0x37, 0xa0, 0xb3,
+                                       0xa9, 0x3f, 0xcd, 0xe3, 0xcd, 0xad, 0x9f, 0x1c, 0xe5, 0x8b};
+    aes_cfb_bytewise_payload_crypt((uint8_t*)iv, (uint8_t*)k128, (uint8_t*)pt, out, 0, 2, 1);
+    rc |= expect(out, cfb128, 32, "CFB-AES128 encrypt");
+    aes_cfb_bytewise_payload_crypt((uint8_t*)iv, (uint8_t*)k128, out, back, 0, 2, 0);
+    rc |= expect(back, pt, 32, "CFB-AES128 decrypt");
+
+    /* OFB keystream XOR plaintext gives the SP 800-38A OFB ciphertext. */
+    static const uint8_t ofb256[32] = {0xdc, 0x7e, 0x84, 0xbf, 0xda, 0x79, 0x16, 0x4b, 0x7e, 0xcd, 0x84,
+                                       0x86, 0x98, 0x5d, 0x38, 0x60, 0x4f, 0xeb, 0xdc, 0x67, 0x40, 0xd2,
+                                       0x0b, 0x3a, 0xc8, 0x8f, 0x6a, 0xd8, 0x2a, 0x4f, 0xb0, 0x8d};
+    aes_ofb_keystream_output((uint8_t*)iv, (uint8_t*)k256, out, 2, 2);
+    for (int i = 0; i < 32; i++) {
+        out[i] ^= pt[i];
+    }
+    rc |= expect(out, ofb256, 32, "OFB-AES256");
+
+    static const uint8_t ctr_iv[16] = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                                       0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+    static const uint8_t ctr128[16] = {0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26,
+                                       0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce};
+    memcpy(out, pt, 16);
+    aes_ctr_bytewise_payload_crypt((uint8_t*)ctr_iv, (uint8_t*)k128, out, 0);
+    rc |= expect(out, ctr128, 16, "CTR-AES128");
+
+    uint8_t bits[128];
+    for (int i = 0; i < 128; i++) {
+        bits[i] = (pt[i / 8] >> (7 - (i % 8))) & 1;
+    }
+    aes_ctr_bitwise_payload_crypt((uint8_t*)ctr_iv, (uint8_t*)k128, bits, 0);
+    for (int i = 0; i < 16; i++) {
+        out[i] = 0;
+        for (int b = 0; b < 8; b++) {
+            out[i] = (uint8_t)((out[i] << 1) | bits[i * 8 + b]);
+        }
+    }
+    rc |= expect(out, ctr128, 16, "CTR-AES128 bitwise");
+    return rc;
+}
+
+/* More distinct keys than cache slots, interleaved: every result must match a cold computation. */
+static int
+run_cache_churn(void) {
+    uint8_t keys[7][32];
+    uint8_t ref[7][16];
+    for (int k = 0; k < 7; k++) {
+        for (int i = 0; i < 32; i++) {
+            keys[k][i] = (uint8_t)(k * 37 + i * 11);
+        }
+        aes_ofb_keystream_output((uint8_t*)iv, keys[k], ref[k], k % 3, 1);
+    }
+    for (int round = 0; round < 50; round++) {
+        int k = (round * 5) % 7;
+        uint8_t out[16];
+        aes_ofb_keystream_output((uint8_t*)iv, keys[k], out, k % 3, 1);
+        if (memcmp(out, ref[k], 16) != 0) {
+            fprintf(stderr, "cache churn: key %d round %d mismatch\n", k, round);
+            return 1;
+        }
+    }
+    /* Same bytes, different key size must not alias in the cache. */
+    uint8_t a[16];
+    uint8_t b[16];
+    aes_ofb_keystream_output((uint8_t*)iv, keys[0], a, 0, 1);
+    aes_ofb_keystream_output((uint8_t*)iv, keys[0], b, 2, 1);
+    if (memcmp(a, b, 16) == 0) {
+        fprintf(stderr, "cache churn: key sizes aliased\n");
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(void) {
+    int rc = 0;
+    const char* native = aes_get_impl_name();
+    rc |= run_vectors();
+    rc |= run_cache_churn();
+
+    aes_set_portable_only(1);
+    if (strcmp(aes_get_impl_name(), "portable") != 0) {
+        fprintf(stderr, "portable override not applied\n");
+        rc = 1;
+    }
+    rc |= run_vectors();
+    rc |= run_cache_churn();
+    aes_set_portable_only(0);
+
+    if (rc == 0) {
+        fprintf(stderr, "AES mode tests (%s + portable): OK\n", native);
+    }
+    return rc;
+}
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * DES/TDEA known answers for the SP-box engine and its mode wrappers. The CA
+ * (DES-XL) and TOFB vectors were captured from the previous bit-permutation
+ * implementation so the keystreams stay byte-identical.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dsd-neo/crypto/des.h>
+
+static const uint8_t k3[24] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x23, 0x45, 0x67, 0x89,
+                               0xAB, 0xCD, 0xEF, 0x01, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x01, 0x23};
+
+static int
+expect(const uint8_t* got, const uint8_t* want, size_t n, const char* what) {
+    if (memcmp(got, want, n) != 0) {
+        fprintf(stderr, "%s: mismatch\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+static int
+test_block(void) {
+    int rc = 0;
+    static const uint8_t key[8] = {0x13, 0x34, 0x57, 0x79, 0x9B, 0xBC, 0xDF, 0xF1};
+    static const uint8_t pt[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    static const uint8_t ct[8] = {0x85, 0xE8, 0x13, 0x54, 0x0F, 0x0A, 0xB4, 0x05};
+    des_key_schedule ks;
+    uint8_t out[8];
+
+    des_key_setup(&ks, key);
+    des_crypt_block(&ks, pt, out, 1);
+    rc |= expect(out, ct, 8, "DES encrypt");
+    des_crypt_block(&ks, out, out, 0); /* in place */
+    rc |= expect(out, pt, 8, "DES decrypt");
+
+    /* SP 800-67 TDEA example, three blocks of "The qufck brown fox jump". */
+    static const uint8_t tpt[24] = "The qufck brown fox jump";
+    static const uint8_t tct[24] = {0xA8, 0x26, 0xFD, 0x8C, 0xE5, 0x3B, 0x85, 0x5F, 0xCC, 0xE2, 0x1C, 0x81,
+                                    0x12, 0x25, 0x6F, 0xE6, 0x68, 0xD5, 0xC0, 0x5D, 0xD9, 0xB6, 0xB9, 0x00};
+    uint8_t t[24];
+    uint8_t back[24];
+    uint8_t* K1 = (uint8_t*)k3;
+    uint8_t* K2 = (uint8_t*)k3 + 8;
+    uint8_t* K3 = (uint8_t*)k3 + 16;
+    for (int i = 0; i < 3; i++) {
+        tdea_ecb_payload_crypt(K1, K2, K3, (uint8_t*)tpt + 8 * i, t + 8 * i, 1);
+        tdea_ecb_payload_crypt(K3, K2, K1, t + 8 * i, back + 8 * i, 0);
+    }
+    rc |= expect(t, tct, 24, "TDEA-ECB encrypt");
+    rc |= expect(back, tpt, 24, "TDEA-ECB decrypt");
+    return rc;
+}
+
+static int
+test_keystreams(void) {
+    int rc = 0;
+    uint8_t ks[216];
+
+    static const uint8_t ca_full[16] = {0xCC, 0xB8, 0xCE, 0x77, 0x8D, 0x18, 0xC4, 0x24,
+                                        0x9C, 0xDD, 0xC0, 0x46, 0xAB, 0x34, 0x08, 0xAF};
+    static const uint8_t ca_tail[5] = {0xCD, 0x3A, 0x93, 0xC5, 0xDF}; /* bytes 208..212 */
+    memset(ks, 0, sizeof ks);
+    des_multi_keystream_output(0x1122334455667788ULL, 0x0123456789ABCDEFULL, ks, 2, 0);
+    rc |= expect(ks, ca_full, 16, "DES-XL keystream (ff 806)");
+    rc |= expect(ks + 208, ca_tail, 5, "DES-XL keystream tail");
+
+    static const uint8_t ca_short[16] = {0x7E, 0x85, 0x74, 0xEB, 0x76, 0x27, 0x68, 0xD5,
+                                         0x47, 0x83, 0xEB, 0xA9, 0x63, 0xAD, 0x4D, 0x0A};
+    memset(ks, 0, sizeof ks);
+    des_multi_keystream_output(0x1122334455667788ULL, 0x0123456789ABCDEFULL, ks, 2, 1);
+    rc |= expect(ks, ca_short, 16, "DES-XL keystream (ff 110)");
+
+    static const uint8_t tofb[24] = {0x88, 0xBE, 0x35, 0x4D, 0x2E, 0x0B, 0x28, 0x69, 0x57, 0x05, 0xF7, 0x7B,
+                                     0xC2, 0x3A, 0xCF, 0x23, 0x94, 0xEF, 0xAE, 0x2E, 0xA4, 0x0C, 0x3D, 0xC1};
+    memset(ks, 0, sizeof ks);
+    tdea_multi_keystream_output(0x1122334455667788ULL, (uint8_t*)k3, ks, 1, 3);
+    rc |= expect(ks, tofb, 24, "TDEA-OFB keystream");
+
+    /* DES56 OFB is TDEA OFB with K1 == K2 == K3. */
+    uint8_t iv[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+    uint8_t ofb[32];
+    des56_ofb_keystream_output((uint8_t*)k3, iv, ofb, 1, 4);
+    tdea_tofb_keystream_output((uint8_t*)k3, (uint8_t*)k3, (uint8_t*)k3, iv, ks, 1, 4);
+    rc |= expect(ofb, ks, 32, "DES56 OFB vs single-key TDEA");
+    return rc;
+}
+
+static int
+test_modes(void) {
+    int rc = 0;
+    uint8_t* K1 = (uint8_t*)k3;
+    uint8_t* K2 = (uint8_t*)k3 + 8;
+    uint8_t* K3 = (uint8_t*)k3 + 16;
+    uint8_t iv[8] = {0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0xFF};
+    uint8_t pt[40];
+    uint8_t ct[40];
+    uint8_t back[40];
+    for (int i = 0; i < 40; i++) {
+        pt[i] = (uint8_t)(i * 37 + 5);
+    }
+
+    /* CBC: second block chains off the first, and decrypt works in place. */
+    tdea_cbc_payload_crypt(K1, K2, K3, iv, pt, ct, 5, 1);
+    uint8_t first[8];
+    tdea_cbc_payload_crypt(K1, K2, K3, iv, pt, first, 1, 1);
+    rc |= expect(ct, first, 8, "TDEA-CBC first block");
+    memcpy(back, ct, sizeof back);
+    tdea_cbc_payload_crypt(K1, K2, K3, iv, back, back, 5, 0);
+    rc |= expect(back, pt, 40, "TDEA-CBC round trip");
+
+    /* CBC-MAC is the last CBC block with a zero IV. */
+    uint8_t zero[8] = {0};
+    uint8_t mac[8];
+    tdea_cbc_payload_crypt(K1, K2, K3, zero, pt, ct, 5, 1);
+    tdea_cbc_mac_generator(K1, K2, K3, pt, mac, 5);
+    rc |= expect(mac, ct + 32, 8, "TDEA-CBC-MAC");
+
+    tdea_cfb_payload_crypt(K1, K2, K3, iv, pt, ct, 5, 1);
+    tdea_cfb_payload_crypt(K1, K2, K3, iv, ct, back, 5, 0);
+    rc |= expect(back, pt, 40, "TDEA-CFB round trip");
+
+    /* CTR advances the caller's counter with carry. */
+    uint8_t ctr[8] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE};
+    static const uint8_t ctr_end[8] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03};
+    tdea_ctr_payload_crypt(K1, K2, K3, ctr, pt, ct, 5);
+    rc |= expect(ctr, ctr_end, 8, "TDEA-CTR counter");
+    uint8_t ctr2[8] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE};
+    tdea_ctr_payload_crypt(K1, K2, K3, ctr2, ct, back, 5);
+    rc |= expect(back, pt, 40, "TDEA-CTR round trip");
+    return rc;
+}
+
+int
+main(void) {
+    int rc = 0;
+    rc |= test_block();
+    rc |= test_keystreams();
+    rc |= test_modes();
+    if (rc == 0) {
+        printf("DES_MODES: OK\n");
+    }
+    return rc;
+}
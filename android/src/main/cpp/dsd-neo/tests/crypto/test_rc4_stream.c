@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * RC4 voice keystream reuse: rc4_stream_decrypt() must match the one-shot
+ * rc4_voice_decrypt() across a superframe of consecutive windows, skipped
+ * frames, MI changes and drop counter resets.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dsd-neo/crypto/rc4.h>
+
+static uint32_t g_rng = 0x1234567u;
+
+static uint8_t
+rnd8(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return (uint8_t)g_rng;
+}
+
+static int
+check_window(rc4_stream* rc, int drop, uint8_t keylen, uint8_t len, const uint8_t* key) {
+    uint8_t cipher[16], want[16], got[16];
+    uint8_t k[16];
+    for (int i = 0; i < len; i++) {
+        cipher[i] = rnd8();
+    }
+    memcpy(k, key, keylen);
+    rc4_voice_decrypt(drop, keylen, len, k, cipher, want);
+    rc4_stream_decrypt(rc, drop, keylen, len, key, cipher, got);
+    if (memcmp(want, got, len) != 0) {
+        fprintf(stderr, "mismatch: drop=%d keylen=%u len=%u\n", drop, keylen, len);
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(void) {
+    int rc = 0;
+    rc4_stream st;
+    rc4_stream_reset(&st);
+
+    uint8_t key[13];
+    for (int call = 0; call < 20; call++) {
+        uint8_t keylen = (call & 1) ? 9 : 13;
+        uint8_t len = (keylen == 9) ? 7 : 11;
+        for (int i = 0; i < keylen; i++) {
+            key[i] = rnd8();
+        }
+        /* Two superframes under the same MI: the second restarts drop at 256. */
+        for (int sf = 0; sf < 2; sf++) {
+            int drop = (keylen == 9) ? 256 : 267;
+            for (int f = 0; f < 18; f++) {
+                /* Skip an occasional frame the way errored DMR frames do. */
+                if ((rnd8() & 7) != 0) {
+                    rc |= check_window(&st, drop, keylen, len, key);
+                }
+                drop += len;
+                if (f == 8 && keylen == 13) {
+                    drop += 2; /* LSD bytes between LDU halves */
+                }
+            }
+        }
+    }
+
+    /* Negative drop clamps to zero like the one-shot path. */
+    rc |= check_window(&st, -5, 9, 7, key);
+    rc |= check_window(&st, 0, 9, 7, key);
+
+    if (rc == 0) {
+        printf("RC4_STREAM: OK\n");
+    }
+    return rc;
+}
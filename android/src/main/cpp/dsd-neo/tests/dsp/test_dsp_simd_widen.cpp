@@ -3,7 +3,7 @@
  * Copyright (C) 2025 by arancormonk <180709949+arancormonk@users.noreply.github.com>
  */
 
-/* Focused unit test for SIMD u8->float widening and 90° rotate+widen. */
+/* Focused unit test for SIMD u8/s8/s16->float widening and 90° rotate+widen. */
 
 #include <dsd-neo/dsp/simd_widen.h>
 #include <math.h>
@@ -52,5 +52,26 @@ main(void) {
         return 1;
     }
 
+    // cs8 must match the u8 path on the offset-binary equivalent (s + 128)
+    const int8_t s8[8] = {-128, -1, 0, 127, 2, -3, 64, -64};
+    unsigned char u8[8];
+    for (int i = 0; i < 8; i++) {
+        u8[i] = (unsigned char)(s8[i] + 128);
+    }
+    widen_u8_to_f32_bias127(u8, ref, 8);
+    widen_s8_to_f32(s8, dst, 8);
+    if (!arrays_close(dst, ref, 8, 1e-6f)) {
+        fprintf(stderr, "SIMD widen s8: mismatch\n");
+        return 1;
+    }
+
+    const int16_t s16[4] = {-32768, 0, 16384, 32767};
+    const float ref16[4] = {-1.0f, 0.0f, 0.5f, 32767.0f / 32768.0f};
+    widen_s16_to_f32(s16, dst, 4);
+    if (!arrays_close(dst, ref16, 4, 1e-7f)) {
+        fprintf(stderr, "SIMD widen s16: mismatch\n");
+        return 1;
+    }
+
     return 0;
 }
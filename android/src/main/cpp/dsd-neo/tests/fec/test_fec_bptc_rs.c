@@ -172,6 +172,109 @@ test_bptc_196x96_deinterleave(void) {
     return 0;
 }
 
+static int
+test_bptc_196x96_extract(void) {
+    InitAllFecFunction();
+    // Build a valid 13x15 product code: Hamming(15,11) rows 0..8, Hamming(13,9) on every column
+    uint8_t mat[13][15] = {{0}};
+    uint8_t bits96[96];
+    uint8_t R[3] = {1, 0, 1};
+    for (int i = 0; i < 96; i++) {
+        bits96[i] = (uint8_t)(((i * 7) >> 2) & 1U);
+    }
+    int k = 0;
+    for (int row = 0; row < 9; row++) {
+        uint8_t orig[11];
+        uint8_t enc[15];
+        for (int j = 0; j < 11; j++) {
+            if (row == 0 && j < 3) {
+                orig[j] = R[2 - j]; // R(2), R(1), R(0)
+            } else {
+                orig[j] = bits96[k++];
+            }
+        }
+        Hamming_15_11_encode(orig, enc);
+        memcpy(mat[row], enc, 15);
+    }
+    for (int col = 0; col < 15; col++) {
+        uint8_t orig[9];
+        uint8_t enc[13];
+        for (int row = 0; row < 9; row++) {
+            orig[row] = mat[row][col];
+        }
+        Hamming_13_9_encode(orig, enc);
+        for (int row = 9; row < 13; row++) {
+            mat[row][col] = enc[row];
+        }
+    }
+
+    // One flipped bit per data row (distinct columns) plus one in a column parity row
+    uint8_t deint[196];
+    deint[0] = 0;
+    for (int row = 0; row < 13; row++) {
+        for (int col = 0; col < 15; col++) {
+            deint[1 + (row * 15) + col] = mat[row][col];
+        }
+    }
+    for (int row = 0; row < 9; row++) {
+        deint[1 + (row * 15) + ((row * 4) % 15)] ^= 1U;
+    }
+    deint[1 + (11 * 15) + 6] ^= 1U;
+
+    uint8_t out[96];
+    uint8_t r_out[3];
+    uint32_t irr = BPTC_196x96_Extract_Data(deint, out, r_out);
+    assert(irr == 0);
+    assert(memcmp(out, bits96, 96) == 0);
+    assert(r_out[0] == R[0] && r_out[1] == R[1] && r_out[2] == R[2]);
+
+    // Column parity rows are not row-corrected; some double errors there land on syndromes
+    // no single bit explains, which must be reported
+    deint[1 + (11 * 15) + 6] ^= 1U;
+    uint32_t reported = 0;
+    for (int a = 9; a < 13; a++) {
+        for (int b = a + 1; b < 13; b++) {
+            deint[1 + (a * 15) + 6] ^= 1U;
+            deint[1 + (b * 15) + 6] ^= 1U;
+            reported += BPTC_196x96_Extract_Data(deint, out, r_out);
+            deint[1 + (a * 15) + 6] ^= 1U;
+            deint[1 + (b * 15) + 6] ^= 1U;
+        }
+    }
+    assert(reported > 0);
+    (void)reported;
+    return 0;
+}
+
+static int
+test_bptc_16x2_uncorrectable(void) {
+    InitAllFecFunction();
+    uint8_t info[11];
+    set_bits_from_u32_u8(info, 11, 0x155);
+    uint8_t enc16[16];
+    Hamming_16_11_4_encode(info, enc16);
+    uint8_t dmat[32];
+    for (int i = 0; i < 16; i++) {
+        dmat[i] = enc16[i] & 1U;
+        dmat[16 + i] = dmat[i];
+    }
+    // Two flipped bits: detected, not corrected, and the received bits pass through unchanged
+    dmat[0] ^= 1U;
+    dmat[5] ^= 1U;
+    uint8_t interleaved[32];
+    for (int i = 0; i < 32; i++) {
+        interleaved[i] = dmat[DeInterleaveReverseChannelBptcPlacement[DeInterleaveReverseChannelBptc[i]]];
+    }
+    uint8_t outbits[32];
+    uint32_t irr = BPTC_16x2_Extract_Data(interleaved, outbits, 0 /* even */);
+    assert(irr == 1 + 2); // Hamming failure + the two parity mismatches
+    for (int i = 0; i < 32; i++) {
+        assert(outbits[i] == dmat[i]);
+    }
+    (void)irr;
+    return 0;
+}
+
 static int
 test_rs_12_9(void) {
     // Build a codeword = 9 data + 3 checksum
@@ -204,6 +307,26 @@ test_rs_12_9(void) {
     rc = rs_12_9_correct_errors(&cw, &syn, &fixed);
     assert(rc == RS_12_9_CORRECT_ERRORS_RESULT_ERRORS_CANT_BE_CORRECTED);
 
+    // Any single byte error, data or checksum, is restored exactly
+    rs_12_9_codeword_t ref = {0};
+    for (int i = 0; i < RS_12_9_DATASIZE; i++) {
+        ref.data[i] = (uint8_t)(0xC3 ^ (i * 29));
+    }
+    cks = rs_12_9_calc_checksum(&ref);
+    memcpy(&ref.data[RS_12_9_DATASIZE], cks->bytes, RS_12_9_CHECKSUMSIZE);
+    for (int pos = 0; pos < 12; pos++) {
+        for (int v = 1; v < 256; v += 37) {
+            rs_12_9_codeword_t bad = ref;
+            bad.data[pos] ^= (uint8_t)v;
+            rs_12_9_calc_syndrome(&bad, &syn);
+            assert(rs_12_9_check_syndrome(&syn) == 1);
+            rc = rs_12_9_correct_errors(&bad, &syn, &fixed);
+            assert(rc == RS_12_9_CORRECT_ERRORS_RESULT_ERRORS_CORRECTED && fixed == 1);
+            assert(memcmp(&bad, &ref, sizeof(ref)) == 0);
+        }
+    }
+    (void)rc;
+
     return 0;
 }
 
@@ -218,6 +341,12 @@ main(void) {
     if (test_bptc_196x96_deinterleave() != 0) {
         return 1;
     }
+    if (test_bptc_196x96_extract() != 0) {
+        return 1;
+    }
+    if (test_bptc_16x2_uncorrectable() != 0) {
+        return 1;
+    }
     if (test_rs_12_9() != 0) {
         return 1;
     }
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Shared CRC engine: catalog check values, and agreement with the bit-serial
+ * routines the protocol decoders used before (P25 CCITT/CRC-12/CRC-32 MBF,
+ * NXDN LFSRs including the CAC preset, M17, DMR CRC-3/4/7/8/9/32) across
+ * lengths that straddle the slice-by-8 and bit-packing boundaries.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dsd-neo/fec/crc.h>
+
+/* Legacy references */
+
+static uint32_t
+ref_register(const uint8_t* bits, size_t n, unsigned width, uint32_t poly, uint32_t init) {
+    uint32_t top = 1U << (width - 1);
+    uint32_t mask = (width == 32) ? 0xFFFFFFFFU : ((1U << width) - 1U);
+    uint32_t crc = init;
+    for (size_t i = 0; i < n; i++) {
+        if (((crc & top) != 0) ^ (bits[i] & 1)) {
+            crc = ((crc << 1) ^ poly) & mask;
+        } else {
+            crc = (crc << 1) & mask;
+        }
+    }
+    return crc;
+}
+
+/* OP25-style long division with K appended zeros (P25 crc12, DMR crc3/4/7/8). */
+static uint32_t
+ref_division(const uint8_t* bits, unsigned len, const uint8_t* poly, unsigned K) {
+    uint8_t buf[256];
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, bits, len);
+    for (unsigned i = 0; i < len; i++) {
+        if (buf[i]) {
+            for (unsigned j = 0; j < K + 1; j++) {
+                buf[i + j] ^= poly[j];
+            }
+        }
+    }
+    uint32_t crc = 0;
+    for (unsigned i = 0; i < K; i++) {
+        crc = (crc << 1) + buf[len + i];
+    }
+    return crc;
+}
+
+static uint16_t
+ref_crc6_nxdn(const uint8_t* buf, int len) {
+    uint8_t s[6];
+    memset(s, 1, sizeof(s));
+    for (int i = 0; i < len; i++) {
+        uint8_t a = buf[i] ^ s[0];
+        s[0] = a ^ s[1];
+        s[1] = s[2];
+        s[2] = s[3];
+        s[3] = a ^ s[4];
+        s[4] = a ^ s[5];
+        s[5] = a;
+    }
+    return (uint16_t)dsd_crc_load_bits(s, 6);
+}
+
+static uint16_t
+ref_crc15_nxdn(const uint8_t* buf, int len) {
+    uint8_t s[15];
+    memset(s, 1, sizeof(s));
+    for (int i = 0; i < len; i++) {
+        uint8_t a = buf[i] ^ s[0];
+        s[0] = a ^ s[1];
+        s[1] = s[2];
+        s[2] = s[3];
+        s[3] = a ^ s[4];
+        s[4] = a ^ s[5];
+        s[5] = s[6];
+        s[6] = s[7];
+        s[7] = a ^ s[8];
+        s[8] = a ^ s[9];
+        s[9] = s[10];
+        s[10] = s[11];
+        s[11] = s[12];
+        s[12] = a ^ s[13];
+        s[13] = s[14];
+        s[14] = a;
+    }
+    return (uint16_t)dsd_crc_load_bits(s, 15);
+}
+
+static uint16_t
+ref_crc16cac(const uint8_t* buf, int len) {
+    uint32_t crc = 0xc3ee;
+    for (int i = 0; i < len; i++) {
+        crc = ((crc << 1) | buf[i]) & 0x1ffff;
+        if (crc & 0x10000) {
+            crc = (crc & 0xffff) ^ 0x1021;
+        }
+    }
+    return (uint16_t)((crc ^ 0xffff) & 0xffff);
+}
+
+static uint32_t
+ref_crc32mbf(const uint8_t* buf, int len) {
+    uint64_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        crc <<= 1;
+        int b = (buf[i / 8] >> (7 - (i % 8))) & 1;
+        if (((crc >> 32) ^ b) & 1) {
+            crc ^= 0x04c11db7;
+        }
+    }
+    return (uint32_t)((crc & 0xffffffff) ^ 0xffffffff);
+}
+
+static uint16_t
+ref_crc16m17(const uint8_t* in, uint16_t len) {
+    uint32_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= (uint32_t)in[i] << 8;
+        for (int j = 0; j < 8; j++) {
+            crc <<= 1;
+            if (crc & 0x10000) {
+                crc = (crc ^ 0x5935) & 0xFFFF;
+            }
+        }
+    }
+    return (uint16_t)crc;
+}
+
+static uint32_t g_rng = 0x2545F491U;
+
+static uint8_t
+rnd8(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return (uint8_t)g_rng;
+}
+
+static void
+test_check_values(void) {
+    static const uint8_t msg[] = "123456789";
+    /* Reveng catalog: CRC-16/GSM, CRC-16/M17, CRC-32/CKSUM, CRC-8/SMBUS, CRC-32/MPEG-2 style poly w/o preset. */
+    assert(dsd_crc_bytes(dsd_crc_get(DSD_CRC16_CCITT), msg, 9) == 0xCE3C);
+    assert(dsd_crc_bytes(dsd_crc_get(DSD_CRC16_M17), msg, 9) == 0x772B);
+    assert(dsd_crc_bytes(dsd_crc_get(DSD_CRC32_CKSUM), msg, 9) == 0x765E7680);
+    assert(dsd_crc_bytes(dsd_crc_get(DSD_CRC8_DMR), msg, 9) == 0xF4);
+
+    /* Same message as bits, packed bits, and bytes. */
+    uint8_t bits[72];
+    for (int i = 0; i < 72; i++) {
+        bits[i] = (uint8_t)((msg[i / 8] >> (7 - i % 8)) & 1);
+    }
+    for (int id = 0; id < DSD_CRC_ID_COUNT; id++) {
+        const dsd_crc* crc = dsd_crc_get((dsd_crc_id)id);
+        assert(crc != NULL && crc == dsd_crc_get((dsd_crc_id)id));
+        uint32_t v = dsd_crc_bytes(crc, msg, 9);
+        assert(dsd_crc_bits(crc, bits, 72) == v);
+        assert(dsd_crc_packed_bits(crc, msg, 72) == v);
+    }
+    assert(dsd_crc_get(DSD_CRC_ID_COUNT) == NULL);
+
+    dsd_crc custom;
+    dsd_crc_model bad = {33, 1, 0, 0};
+    assert(dsd_crc_init(&custom, &bad) == -1);
+    bad.width = 0;
+    assert(dsd_crc_init(&custom, &bad) == -1);
+}
+
+static void
+test_against_legacy(void) {
+    static const uint8_t poly12[13] = {1, 1, 0, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1};
+    static const uint8_t poly3[4] = {1, 1, 0, 1};
+    static const uint8_t poly4[5] = {1, 0, 0, 1, 1};
+    static const uint8_t poly7[8] = {1, 0, 1, 0, 0, 1, 1, 1};
+    static const uint8_t poly8[9] = {1, 0, 0, 0, 0, 0, 1, 1, 1};
+    uint8_t bits[240];
+    uint8_t bytes[64];
+
+    for (int iter = 0; iter < 400; iter++) {
+        unsigned n = (unsigned)(iter % 200) + (unsigned)(iter / 200); /* 0..200, every residue mod 8 and 64 */
+        for (unsigned i = 0; i < sizeof(bits); i++) {
+            bits[i] = rnd8() & 1;
+        }
+        for (unsigned i = 0; i < sizeof(bytes); i++) {
+            bytes[i] = rnd8();
+        }
+
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC16_CCITT), bits, n) == (ref_register(bits, n, 16, 0x1021, 0) ^ 0xFFFF));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC9_DMR), bits, n) == (ref_register(bits, n, 9, 0x059, 0) ^ 0x1FF));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC32_DMR), bits, n) == ref_register(bits, n, 32, 0x04C11DB7, 0));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC12_P25), bits, n) == (ref_division(bits, n, poly12, 12) ^ 0xFFF));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC3_DMR), bits, n) == ref_division(bits, n, poly3, 3));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC4_DMR), bits, n) == (ref_division(bits, n, poly4, 4) ^ 0xF));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC7_DMR), bits, n) == ref_division(bits, n, poly7, 7));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC8_DMR), bits, n) == ref_division(bits, n, poly8, 8));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC6_NXDN), bits, n) == ref_crc6_nxdn(bits, (int)n));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC15_NXDN), bits, n) == ref_crc15_nxdn(bits, (int)n));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC12_NXDN), bits, n) == ref_register(bits, n, 12, 0x80F, 0xFFF));
+        assert(dsd_crc_bits(dsd_crc_get(DSD_CRC7_NXDN_SCCH), bits, n) == ref_register(bits, n, 7, 0x09, 0x7F));
+        assert(dsd_crc_packed_bits(dsd_crc_get(DSD_CRC32_CKSUM), bytes, n) == ref_crc32mbf(bytes, (int)n));
+        unsigned nb = n % 64;
+        assert(dsd_crc_bytes(dsd_crc_get(DSD_CRC16_M17), bytes, nb) == ref_crc16m17(bytes, (uint16_t)nb));
+
+        /* NXDN CAC: preset register fed without trailing zeros (0xc3ee * x^16 mod G). */
+        if (n >= 16) {
+            const dsd_crc* c = dsd_crc_get(DSD_CRC16_CCITT);
+            uint8_t zeros[16] = {0};
+            assert(dsd_crc_bits_update(c, 0xc3ee, zeros, 16) == 0x5fe7);
+            uint32_t reg = dsd_crc_bits_update(c, 0x5fe7, bits, n - 16) ^ dsd_crc_load_bits(bits + n - 16, 16);
+            assert((uint16_t)(reg ^ 0xffff) == ref_crc16cac(bits, (int)n));
+        }
+
+        /* Append the CRC and the check helper accepts it; a flipped bit does not. */
+        const dsd_crc* c12 = dsd_crc_get(DSD_CRC12_P25);
+        uint32_t v = dsd_crc_bits(c12, bits, n);
+        for (int i = 0; i < 12; i++) {
+            bits[n + i] = (uint8_t)((v >> (11 - i)) & 1);
+        }
+        assert(dsd_crc_bits_check(c12, bits, n) == 1);
+        bits[(n + 5) % (n + 12)] ^= 1;
+        assert(dsd_crc_bits_check(c12, bits, n) == 0);
+    }
+
+    /* Incremental updates compose. */
+    const dsd_crc* c = dsd_crc_get(DSD_CRC16_CCITT);
+    uint32_t whole = dsd_crc_bits_update(c, 0, bits, 200);
+    uint32_t part = dsd_crc_bits_update(c, dsd_crc_bits_update(c, 0, bits, 77), bits + 77, 123);
+    assert(whole == part);
+}
+
+int
+main(void) {
+    test_check_values();
+    test_against_legacy();
+    printf("FEC_CRC: OK\n");
+    return 0;
+}
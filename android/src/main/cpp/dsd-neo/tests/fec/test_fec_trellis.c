@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Shared 1/2- and 3/4-rate trellis engine: encode/decode round trips through
+ * the interleaver, correction of scattered symbol errors, soft metrics
+ * steering around unreliable dibits, forced end states, and the P25/DMR
+ * wrappers agreeing with the engine.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dsd-neo/fec/trellis_4fsk.h>
+#include <dsd-neo/protocol/dmr/r34_viterbi.h>
+#include <dsd-neo/protocol/p25/p25_12.h>
+#include <dsd-neo/protocol/p25/p25p1_mbf34.h>
+
+static uint32_t g_rng = 0x1234567U;
+
+static uint8_t
+rnd8(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return (uint8_t)g_rng;
+}
+
+static void
+test_tables(void) {
+    const dsd_trellis* c12 = dsd_trellis_get(DSD_TRELLIS_12);
+    const dsd_trellis* c34 = dsd_trellis_get(DSD_TRELLIS_34);
+    assert(c12 && c34 && c12 == dsd_trellis_get(DSD_TRELLIS_12));
+    assert(dsd_trellis_get(DSD_TRELLIS_ID_COUNT) == NULL);
+    assert(c12->states == 4 && c12->bits == 2 && c34->states == 8 && c34->bits == 3);
+
+    /* Schedule is a permutation; each code's transitions out of a state are distinct nibbles. */
+    uint8_t seen[98] = {0};
+    for (int i = 0; i < 98; i++) {
+        seen[dsd_trellis_interleave[i]]++;
+    }
+    for (int i = 0; i < 98; i++) {
+        assert(seen[i] == 1);
+    }
+    for (int ps = 0; ps < 8; ps++) {
+        uint8_t used[16] = {0};
+        for (int ns = 0; ns < 8; ns++) {
+            uint8_t nib = c34->expect[ps * 8 + ns];
+            assert(used[nib] == 0);
+            used[nib] = 1;
+            assert(c34->hard[nib][ps * 8 + ns] == 0);
+        }
+    }
+}
+
+static void
+test_round_trip(dsd_trellis_id id, int nbytes) {
+    const dsd_trellis* code = dsd_trellis_get(id);
+    for (int iter = 0; iter < 200; iter++) {
+        uint8_t in[18];
+        uint8_t out[18];
+        uint8_t dibits[98];
+        uint8_t nibs[49];
+        uint8_t path[49];
+        for (int i = 0; i < nbytes; i++) {
+            in[i] = rnd8();
+        }
+        dsd_trellis_encode(code, in, dibits);
+
+        dsd_trellis_deinterleave(dibits, NULL, nibs, NULL, NULL);
+        uint32_t clean = dsd_trellis_viterbi(code, nibs, NULL, NULL, DSD_TRELLIS_UNREACHABLE, 0, path);
+        assert(clean == 0);
+        dsd_trellis_pack(code, path, out);
+        assert(memcmp(in, out, (size_t)nbytes) == 0);
+
+        /* 1/2 rate: a single dibit error ahead of the flush symbol is corrected. */
+        if (id != DSD_TRELLIS_12) {
+            (void)clean;
+            continue;
+        }
+        int pos = rnd8() % 90;
+        int a = 0;
+        while (dsd_trellis_interleave[a] != pos) {
+            a++;
+        }
+        dibits[a] ^= 1 + (rnd8() % 3);
+        dsd_trellis_deinterleave(dibits, NULL, nibs, NULL, NULL);
+        uint32_t m = dsd_trellis_viterbi(code, nibs, NULL, NULL, DSD_TRELLIS_UNREACHABLE, -1, path);
+        assert(m > 0 && m < DSD_TRELLIS_UNREACHABLE);
+        dsd_trellis_pack(code, path, out);
+        assert(memcmp(in, out, (size_t)nbytes) == 0);
+        (void)clean;
+        (void)m;
+    }
+}
+
+static void
+test_soft_and_wrappers(void) {
+    const dsd_trellis* c12 = dsd_trellis_get(DSD_TRELLIS_12);
+    const dsd_trellis* c34 = dsd_trellis_get(DSD_TRELLIS_34);
+    uint8_t in[18];
+    uint8_t out[18];
+    uint8_t dibits[98];
+    uint8_t reliab[98];
+    for (int i = 0; i < 18; i++) {
+        in[i] = rnd8();
+    }
+
+    /* Burst of errors, all flagged unreliable: soft decoding rides through it. */
+    dsd_trellis_encode(c12, in, dibits);
+    for (int i = 0; i < 98; i++) {
+        reliab[i] = 200;
+    }
+    for (int i = 10; i < 16; i++) {
+        dibits[i] ^= 3;
+        reliab[i] = 0;
+    }
+    int sm = p25_12_soft(dibits, reliab, out);
+    assert(sm == 0);
+    assert(memcmp(in, out, 12) == 0);
+    uint8_t hard[12];
+    int hm = p25_12(dibits, hard);
+    assert(hm > 0);
+    (void)sm;
+    (void)hm;
+
+    /* DMR and P25 MBF 3/4 wrappers both run the engine. */
+    dsd_trellis_encode(c34, in, dibits);
+    int rc = dmr_r34_viterbi_decode(dibits, out);
+    assert(rc == 0 && memcmp(in, out, 18) == 0);
+    memset(out, 0, sizeof(out));
+    rc = p25_mbf34_decode(dibits, out);
+    assert(rc == 0 && memcmp(in, out, 18) == 0);
+    rc = dmr_r34_viterbi_decode_endstate(dibits, 0, out);
+    assert(rc == 0 && memcmp(in, out, 18) == 0);
+    rc = dmr_r34_viterbi_decode_endstate(dibits, 8, out);
+    assert(rc == -1);
+
+    /* The point-distance hard metric rarely recovers a flipped dibit; an erasure flag does. */
+    dibits[7] ^= 2;
+    for (int i = 0; i < 98; i++) {
+        reliab[i] = (i == 7) ? 0 : 255;
+    }
+    rc = dmr_r34_viterbi_decode_soft(dibits, reliab, out);
+    assert(rc == 0 && memcmp(in, out, 18) == 0);
+    (void)rc;
+}
+
+int
+main(void) {
+    test_tables();
+    test_round_trip(DSD_TRELLIS_12, 12);
+    test_round_trip(DSD_TRELLIS_34, 18);
+    test_soft_and_wrappers();
+    printf("FEC_TRELLIS: OK\n");
+    return 0;
+}
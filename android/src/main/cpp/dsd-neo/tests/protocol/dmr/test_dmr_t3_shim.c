@@ -167,7 +167,7 @@ test_lpcn_trust_gating(void) {
     // On CC (trunk_is_tuned==0): allow tuning with untrusted LPCN mapping
     int lpcn = 0x0123;
     long f1 = 853000000;
-    state.trunk_chan_map[lpcn] = f1;
+    dsd_chan_map_set(&state.trunk_chan_map, lpcn, f1);
     state.dmr_lcn_trust[lpcn] = 1; // unconfirmed
     opts.trunk_is_tuned = 0;       // on CC
     ctx->state = DMR_SM_ON_CC;
@@ -178,7 +178,7 @@ test_lpcn_trust_gating(void) {
     // Off CC (currently tuned to VC): block tune with untrusted mapping
     int lpcn2 = 0x0124;
     long f2 = 854000000;
-    state.trunk_chan_map[lpcn2] = f2;
+    dsd_chan_map_set(&state.trunk_chan_map, lpcn2, f2);
     state.dmr_lcn_trust[lpcn2] = 1; // unconfirmed
     long prev = state.trunk_vc_freq[0];
     opts.trunk_is_tuned = 1; // off CC
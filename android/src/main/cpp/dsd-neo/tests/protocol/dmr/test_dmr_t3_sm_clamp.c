@@ -63,7 +63,7 @@ main(int argc, char** argv) {
     // Map LCN 100 -> 851.0125 MHz but mark as untrusted (1)
     int lcn = 100;
     long freq = 851012500;
-    state.trunk_chan_map[lcn] = freq;
+    dsd_chan_map_set(&state.trunk_chan_map, lcn, freq);
     state.dmr_lcn_trust[lcn] = 1; // learned off-CC
 
     // Off-CC: should NOT tune
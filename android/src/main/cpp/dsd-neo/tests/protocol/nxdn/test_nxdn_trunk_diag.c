@@ -62,7 +62,7 @@ main(void) {
     rc |= expect_eq_u16("out1-ch13", out[1], 13);
 
     // If a channel becomes mapped later in the run, the summary should no longer report it.
-    state.trunk_chan_map[12] = 851000000;
+    dsd_chan_map_set(&state.trunk_chan_map, 12, 851000000);
     memset(out, 0, sizeof out);
     rc |= expect_eq_size("total-1-after-map", nxdn_trunk_diag_collect_unmapped_channels(&state, out, 8), 1);
     rc |= expect_eq_u16("out0-ch13-after-map", out[0], 13);
@@ -5,18 +5,32 @@
 
 /*
  * P25p2 audio jitter ring helpers:
- * - reset clears head/tail/count and zeroes frames
+ * - reset discards buffered frames
  * - push/pop maintain FIFO order for up to 3 frames
- * - overflow drops the oldest frame (bounded latency)
- * - pop from empty returns zeros and 0 status.
+ * - overflow drops the oldest frame (bounded latency) and counts it
+ * - pop from empty returns zeros and 0 status and counts an underrun
+ * - read copies the frame out with its push timestamp
+ * - a consumer racing a producer that keeps overrunning never sees a torn
+ *   frame, and every frame is read or counted as an overrun exactly once
+ * - DSD_NEO_P25P2_JITTER_DEPTH sets the depth of newly created rings.
  */
 
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/platform/atomic_compat.h>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/p25_p2_audio_ring.h>
 
+#include "test_support.h"
+
+#define setenv dsd_test_setenv
+
 static int
 expect_int(const char* tag, int got, int want) {
     if (got != want) {
@@ -37,6 +51,75 @@ expect_frame(const char* tag, const float* got, const float* want) {
     return 0;
 }
 
+#define RACE_FRAMES 200000
+
+static atomic_int g_race_done;
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    race_producer(void* arg) {
+    dsd_state* st = (dsd_state*)arg;
+    float frame[160];
+    for (int k = 1; k <= RACE_FRAMES; k++) {
+        for (int i = 0; i < 160; i++) {
+            frame[i] = (float)k;
+        }
+        p25_p2_audio_ring_push(st, 0, frame);
+    }
+    atomic_store(&g_race_done, 1);
+    DSD_THREAD_RETURN;
+}
+
+/* Producer on its own thread overruns constantly; every frame read must be whole and in order. */
+static int
+test_concurrent_read(void) {
+    static dsd_state st;
+    memset(&st, 0, sizeof st);
+    float seed[160] = {0};
+    p25_p2_audio_ring_push(&st, 0, seed); /* create the ring before the race */
+    p25_p2_audio_ring_reset(&st, 0);
+
+    atomic_store(&g_race_done, 0);
+    dsd_thread_t th;
+    if (dsd_thread_create(&th, race_producer, &st) != 0) {
+        fprintf(stderr, "race: thread create failed\n");
+        return 1;
+    }
+    int rc = 0;
+    float last = 0.0f;
+    float out[160];
+    for (;;) {
+        int done = atomic_load(&g_race_done);
+        while (p25_p2_audio_ring_read(&st, 0, out, NULL)) {
+            for (int i = 1; i < 160; i++) {
+                if (out[i] != out[0]) {
+                    fprintf(stderr, "race: torn frame (%.0f vs %.0f)\n", out[0], out[i]);
+                    rc = 1;
+                    break;
+                }
+            }
+            if (out[0] <= last) {
+                fprintf(stderr, "race: frame %.0f after %.0f\n", out[0], last);
+                rc = 1;
+            }
+            last = out[0];
+        }
+        if (done || rc) {
+            break;
+        }
+    }
+    dsd_thread_join(th);
+
+    p25_p2_audio_ring_stats stats;
+    p25_p2_audio_ring_get_stats(&st, 0, &stats);
+    rc |= expect_int("race accounted", (int)(stats.popped + stats.overruns + (uint32_t)stats.count),
+                     RACE_FRAMES + 1 - (int)stats.flushed);
+    dsd_state_ext_free_all(&st);
+    return rc;
+}
+
 int
 main(void) {
     int rc = 0;
@@ -45,8 +128,8 @@ main(void) {
 
     /* Reset both slots and verify counters. */
     p25_p2_audio_ring_reset(&st, -1);
-    rc |= expect_int("reset both count0", st.p25_p2_audio_ring_count[0], 0);
-    rc |= expect_int("reset both count1", st.p25_p2_audio_ring_count[1], 0);
+    rc |= expect_int("reset both count0", p25_p2_audio_ring_count(&st, 0), 0);
+    rc |= expect_int("reset both count1", p25_p2_audio_ring_count(&st, 1), 0);
 
     /* Slot 0 basic FIFO semantics. */
     float f0[160];
@@ -61,28 +144,28 @@ main(void) {
     }
 
     p25_p2_audio_ring_reset(&st, 0);
-    rc |= expect_int("reset slot0 count", st.p25_p2_audio_ring_count[0], 0);
+    rc |= expect_int("reset slot0 count", p25_p2_audio_ring_count(&st, 0), 0);
 
     rc |= expect_int("push f0", p25_p2_audio_ring_push(&st, 0, f0), 1);
     rc |= expect_int("push f1", p25_p2_audio_ring_push(&st, 0, f1), 1);
     rc |= expect_int("push f2", p25_p2_audio_ring_push(&st, 0, f2), 1);
-    rc |= expect_int("count after 3 pushes", st.p25_p2_audio_ring_count[0], 3);
+    rc |= expect_int("count after 3 pushes", p25_p2_audio_ring_count(&st, 0), 3);
 
     float out[160];
     memset(out, 0, sizeof out);
     rc |= expect_int("pop f0 ok", p25_p2_audio_ring_pop(&st, 0, out), 1);
     rc |= expect_frame("pop f0 frame", out, f0);
-    rc |= expect_int("count after pop1", st.p25_p2_audio_ring_count[0], 2);
+    rc |= expect_int("count after pop1", p25_p2_audio_ring_count(&st, 0), 2);
 
     memset(out, 0, sizeof out);
     rc |= expect_int("pop f1 ok", p25_p2_audio_ring_pop(&st, 0, out), 1);
     rc |= expect_frame("pop f1 frame", out, f1);
-    rc |= expect_int("count after pop2", st.p25_p2_audio_ring_count[0], 1);
+    rc |= expect_int("count after pop2", p25_p2_audio_ring_count(&st, 0), 1);
 
     memset(out, 0, sizeof out);
     rc |= expect_int("pop f2 ok", p25_p2_audio_ring_pop(&st, 0, out), 1);
     rc |= expect_frame("pop f2 frame", out, f2);
-    rc |= expect_int("count after pop3", st.p25_p2_audio_ring_count[0], 0);
+    rc |= expect_int("count after pop3", p25_p2_audio_ring_count(&st, 0), 0);
 
     /* Pop from empty should return 0 and zero-fill out buffer. */
     for (int i = 0; i < 160; i++) {
@@ -99,13 +182,13 @@ main(void) {
 
     /* Overflow: push 4 frames; ring keeps last 3 (f1,f2,f3). */
     p25_p2_audio_ring_reset(&st, 0);
-    rc |= expect_int("reset slot0 count (2)", st.p25_p2_audio_ring_count[0], 0);
+    rc |= expect_int("reset slot0 count (2)", p25_p2_audio_ring_count(&st, 0), 0);
 
     p25_p2_audio_ring_push(&st, 0, f0);
     p25_p2_audio_ring_push(&st, 0, f1);
     p25_p2_audio_ring_push(&st, 0, f2);
     p25_p2_audio_ring_push(&st, 0, f3); /* should evict f0 */
-    rc |= expect_int("count after overflow pushes", st.p25_p2_audio_ring_count[0], 3);
+    rc |= expect_int("count after overflow pushes", p25_p2_audio_ring_count(&st, 0), 3);
 
     memset(out, 0, sizeof out);
     rc |= expect_int("pop f1 ok (overflow)", p25_p2_audio_ring_pop(&st, 0, out), 1);
@@ -118,7 +201,66 @@ main(void) {
     memset(out, 0, sizeof out);
     rc |= expect_int("pop f3 ok (overflow)", p25_p2_audio_ring_pop(&st, 0, out), 1);
     rc |= expect_frame("pop f3 frame (overflow)", out, f3);
-    rc |= expect_int("count after draining overflow", st.p25_p2_audio_ring_count[0], 0);
+    rc |= expect_int("count after draining overflow", p25_p2_audio_ring_count(&st, 0), 0);
+
+    /* Counters: 7 pushes, 1 eviction, 6 pops, 1 empty pop, nothing flushed yet. */
+    p25_p2_audio_ring_stats stats;
+    p25_p2_audio_ring_get_stats(&st, 0, &stats);
+    rc |= expect_int("stats depth", stats.depth, 3);
+    rc |= expect_int("stats high water", stats.high_water, 3);
+    rc |= expect_int("stats pushed", (int)stats.pushed, 7);
+    rc |= expect_int("stats popped", (int)stats.popped, 6);
+    rc |= expect_int("stats overruns", (int)stats.overruns, 1);
+    rc |= expect_int("stats underruns", (int)stats.underruns, 1);
+    rc |= expect_int("stats flushed", (int)stats.flushed, 0);
+
+    /* Reset accounts for discarded frames and leaves slot 1 alone. */
+    p25_p2_audio_ring_push(&st, 0, f0);
+    p25_p2_audio_ring_push(&st, 0, f1);
+    p25_p2_audio_ring_push(&st, 1, f2);
+    p25_p2_audio_ring_reset(&st, 0);
+    p25_p2_audio_ring_get_stats(&st, 0, &stats);
+    rc |= expect_int("flushed after reset", (int)stats.flushed, 2);
+    rc |= expect_int("slot1 kept", p25_p2_audio_ring_count(&st, 1), 1);
+
+    /* Read copies frames out in order with non-decreasing timestamps. */
+    p25_p2_audio_ring_push(&st, 0, f0);
+    p25_p2_audio_ring_push(&st, 0, f1);
+    uint64_t ts0 = 0;
+    uint64_t ts1 = 0;
+    rc |= expect_int("read f0 ok", p25_p2_audio_ring_read(&st, 0, out, &ts0), 1);
+    rc |= expect_frame("read f0 frame", out, f0);
+
+    rc |= expect_int("read f1 ok", p25_p2_audio_ring_read(&st, 0, out, &ts1), 1);
+    rc |= expect_frame("read f1 frame", out, f1);
+    rc |= expect_int("read timestamps set", ts0 != 0 && ts1 >= ts0, 1);
+    out[0] = 42.0f;
+    rc |= expect_int("read empty", p25_p2_audio_ring_read(&st, 0, out, NULL), 0);
+    rc |= expect_int("read empty leaves out", out[0] == 42.0f, 1);
+    rc |= expect_int("read bad slot", p25_p2_audio_ring_read(&st, 2, out, NULL), 0);
+
+    dsd_state_ext_free_all(&st);
+
+    /* A state that never pushed has no ring: reads are empty, stats zero. */
+    static dsd_state fresh;
+    memset(&fresh, 0, sizeof fresh);
+    rc |= expect_int("fresh count", p25_p2_audio_ring_count(&fresh, 0), 0);
+    rc |= expect_int("fresh pop", p25_p2_audio_ring_pop(&fresh, 0, out), 0);
+    p25_p2_audio_ring_get_stats(&fresh, 0, &stats);
+    rc |= expect_int("fresh stats depth", stats.depth, 0);
+
+    /* Configured depth applies to rings created afterwards. */
+    setenv("DSD_NEO_P25P2_JITTER_DEPTH", "5", 1);
+    dsd_neo_config_init(NULL);
+    for (int i = 0; i < 7; i++) {
+        p25_p2_audio_ring_push(&fresh, 1, f0);
+    }
+    p25_p2_audio_ring_get_stats(&fresh, 1, &stats);
+    rc |= expect_int("env depth", stats.depth, 5);
+    rc |= expect_int("env depth count", p25_p2_audio_ring_count(&fresh, 1), 5);
+    rc |= expect_int("env depth overruns", (int)stats.overruns, 2);
+    dsd_state_ext_free_all(&fresh);
 
+    rc |= test_concurrent_read();
     return rc;
 }
@@ -12,6 +12,7 @@
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/runtime/trunk_tuning_hooks.h>
+#include <dsd-neo/runtime/p25_p2_audio_ring.h>
 
 // Helper from shim that mirrors early ENC handling and now flushes ring
 int p25_test_p2_early_enc_handle(dsd_opts* opts, dsd_state* state, int slot);
@@ -69,6 +70,16 @@ return_to_cc(dsd_opts* opts, dsd_state* state) {
     g_return_to_cc_called++;
 }
 
+/* Queue n silent frames on a slot so the ring reports n buffered. */
+static void
+fill_ring(dsd_state* st, int slot, int n) {
+    static const float frame[160];
+    p25_p2_audio_ring_reset(st, slot);
+    for (int i = 0; i < n; i++) {
+        p25_p2_audio_ring_push(st, slot, frame);
+    }
+}
+
 static void
 install_trunk_tuning_hooks(void) {
     dsd_trunk_tuning_hooks hooks = {0};
@@ -99,8 +110,8 @@ main(void) {
     opts.trunk_tune_enc_calls = 0; // ENC lockout enabled
 
     // Pre-fill ring counts to simulate queued audio
-    st.p25_p2_audio_ring_count[0] = 2;
-    st.p25_p2_audio_ring_count[1] = 3;
+    fill_ring(&st, 0, 2);
+    fill_ring(&st, 1, 3);
     st.p25_p2_audio_allowed[0] = 1; // clear slot active
     st.p25_p2_audio_allowed[1] = 1; // will be gated (enc)
 
@@ -108,19 +119,19 @@ main(void) {
     g_return_to_cc_called = 0;
     (void)p25_test_p2_early_enc_handle(&opts, &st, /*slot*/ 1);
     rc |= expect_eq("slot1 muted", st.p25_p2_audio_allowed[1], 0);
-    rc |= expect_eq("slot1 ring flushed", st.p25_p2_audio_ring_count[1], 0);
-    rc |= expect_eq("slot0 ring preserved", st.p25_p2_audio_ring_count[0], 2);
+    rc |= expect_eq("slot1 ring flushed", p25_p2_audio_ring_count(&st, 1), 0);
+    rc |= expect_eq("slot0 ring preserved", p25_p2_audio_ring_count(&st, 0), 2);
     rc |= expect_eq("no immediate release", g_return_to_cc_called, 0);
 
     // Now both slots idle, ENC on slot 0 should flush slot 0 and release
     st.p25_p2_audio_allowed[0] = 1; // active and will be gated
     st.p25_p2_audio_allowed[1] = 0; // other idle
-    st.p25_p2_audio_ring_count[0] = 1;
-    st.p25_p2_audio_ring_count[1] = 0;
+    fill_ring(&st, 0, 1);
+    p25_p2_audio_ring_reset(&st, 1);
     g_return_to_cc_called = 0;
     (void)p25_test_p2_early_enc_handle(&opts, &st, /*slot*/ 0);
     rc |= expect_eq("slot0 muted", st.p25_p2_audio_allowed[0], 0);
-    rc |= expect_eq("slot0 ring flushed", st.p25_p2_audio_ring_count[0], 0);
+    rc |= expect_eq("slot0 ring flushed", p25_p2_audio_ring_count(&st, 0), 0);
     rc |= expect_eq("released to CC", g_return_to_cc_called, 1);
 
     return rc;
@@ -221,6 +221,53 @@ ez_rs28_ess_soft(int* payload, int* parity, const int* erasures, int n_erasures)
     return 0;
 }
 
+int
+ez_rs28_facch_hb(uint8_t* payload, uint8_t* parity, const int* erasures, int n_erasures) {
+    (void)payload;
+    (void)parity;
+    (void)erasures;
+    (void)n_erasures;
+    return 0;
+}
+
+int
+ez_rs28_sacch_hb(uint8_t* payload, uint8_t* parity, const int* erasures, int n_erasures) {
+    (void)payload;
+    (void)parity;
+    (void)erasures;
+    (void)n_erasures;
+    return 0;
+}
+
+int
+ez_rs28_ess_hb(uint8_t* payload, uint8_t* parity, const int* erasures, int n_erasures) {
+    (void)payload;
+    (void)parity;
+    (void)erasures;
+    (void)n_erasures;
+    return 0;
+}
+
+void
+ez_bits_to_hexbits(const int* bits, uint8_t* hexbits, int n_hexbits) {
+    for (int i = 0; i < n_hexbits; i++) {
+        uint8_t v = 0;
+        for (int j = 0; j < 6; j++) {
+            v = (uint8_t)((v << 1) | (bits[(i * 6) + j] & 1));
+        }
+        hexbits[i] = v;
+    }
+}
+
+void
+ez_hexbits_to_bits(const uint8_t* hexbits, int* bits, int n_hexbits) {
+    for (int i = 0; i < n_hexbits; i++) {
+        for (int j = 0; j < 6; j++) {
+            bits[(i * 6) + j] = (hexbits[i] >> (5 - j)) & 1;
+        }
+    }
+}
+
 /* MAC PDU handlers */
 void
 process_SACCH_MAC_PDU(dsd_opts* opts, dsd_state* state, int* bits) {
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * P25 Phase 2 RS(63,35) reentrant entry points.
+ *
+ * Build valid ESS/FACCH/SACCH codewords with ezpwd, corrupt a few payload
+ * hexbits and check that the hexbit, packed-bit and int wrappers agree and
+ * correct them. Two threads then decode disjoint blocks at the same time to
+ * catch any shared scratch state.
+ */
+
+#include <exception>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include <dsd-neo/fec/ez.h>
+#include <dsd-neo/platform/threading.h>
+
+#include "ezpwd/rs"
+
+struct Block {
+    uint8_t cw[63]; /* systematic codeword, leading shortened positions zero */
+};
+
+static uint32_t
+lcg(uint32_t* s) {
+    *s = (*s * 1103515245u) + 12345u;
+    return (*s >> 8);
+}
+
+/* Encode a codeword whose first `pad` data symbols are zero (shortened code). */
+static Block
+make_block(int pad, uint32_t seed) {
+    static const ezpwd::RS<63, 35> rs;
+    std::vector<uint8_t> data(35, 0), parity(28, 0);
+    for (int i = pad; i < 35; i++) {
+        data[(size_t)i] = (uint8_t)(lcg(&seed) & 0x3F);
+    }
+    rs.encode(data, parity);
+    Block b;
+    memcpy(b.cw, data.data(), 35);
+    memcpy(b.cw + 35, parity.data(), 28);
+    return b;
+}
+
+static void
+hexbits_to_int_bits(const uint8_t* hb, int* bits, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 6; j++) {
+            bits[(i * 6) + j] = (hb[i] >> (5 - j)) & 1;
+        }
+    }
+}
+
+static void
+int_bits_to_packed(const int* bits, int nbits, uint8_t* out, int nbytes) {
+    memset(out, 0, (size_t)nbytes);
+    for (int i = 0; i < nbits; i++) {
+        out[i / 8] |= (uint8_t)((bits[i] & 1) << (7 - (i % 8)));
+    }
+}
+
+static int
+packed_matches(const uint8_t* packed, const uint8_t* hb, int n) {
+    int bits[180];
+    uint8_t ref[23];
+    hexbits_to_int_bits(hb, bits, n);
+    int_bits_to_packed(bits, n * 6, ref, (n * 6 + 7) / 8);
+    return memcmp(packed, ref, (size_t)((n * 6 + 7) / 8)) == 0;
+}
+
+/* FACCH: payload at RS positions 9..34, parity 35..53. Returns 0 on success. */
+static int
+check_facch(uint32_t seed) {
+    Block b = make_block(9, seed);
+    uint8_t p[26], q[19];
+    memcpy(p, b.cw + 9, 26);
+    memcpy(q, b.cw + 35, 19);
+    p[lcg(&seed) % 26] ^= 0x15;
+    p[lcg(&seed) % 26] ^= 0x2A;
+    p[lcg(&seed) % 26] ^= 0x01;
+
+    int pb[156], qb[114];
+    hexbits_to_int_bits(p, pb, 26);
+    hexbits_to_int_bits(q, qb, 19);
+    uint8_t pp[20], qp[15];
+    int_bits_to_packed(pb, 156, pp, 20);
+    int_bits_to_packed(qb, 114, qp, 15);
+
+    int ec_hb = ez_rs28_facch_hb(p, q, NULL, 0);
+    int ec_pk = ez_rs28_facch_packed(pp, qp, NULL, 0);
+    int ec_int = ez_rs28_facch(pb, qb);
+    if (ec_hb < 1 || ec_hb != ec_pk || ec_hb != ec_int) {
+        fprintf(stderr, "FACCH: ec hb=%d packed=%d int=%d\n", ec_hb, ec_pk, ec_int);
+        return 1;
+    }
+    int ref[156];
+    hexbits_to_int_bits(b.cw + 9, ref, 26);
+    if (memcmp(p, b.cw + 9, 26) != 0 || memcmp(pb, ref, sizeof(ref)) != 0 || !packed_matches(pp, b.cw + 9, 26)) {
+        fprintf(stderr, "FACCH: corrected payload mismatch\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* SACCH: payload at RS positions 5..34, parity 35..56; caller erasures extend the fixed list. */
+static int
+check_sacch(uint32_t seed) {
+    Block b = make_block(5, seed);
+    uint8_t p[30], q[22];
+    memcpy(p, b.cw + 5, 30);
+    memcpy(q, b.cw + 35, 22);
+    int erasures[28] = {0, 1, 2, 3, 4, 57, 58, 59, 60, 61, 62};
+    int n = 11;
+    for (int k = 0; k < 4; k++) {
+        int pos = 5 + (int)((lcg(&seed) % 7) + (k * 7));
+        p[pos - 5] ^= 0x3F;
+        erasures[n++] = pos;
+    }
+    p[29] ^= 0x11; /* one unflagged error on top */
+
+    int pb[180], qb[132];
+    hexbits_to_int_bits(p, pb, 30);
+    hexbits_to_int_bits(q, qb, 22);
+    uint8_t pp[23], qp[17];
+    int_bits_to_packed(pb, 180, pp, 23);
+    int_bits_to_packed(qb, 132, qp, 17);
+
+    int ec_hb = ez_rs28_sacch_hb(p, q, erasures, n);
+    int ec_pk = ez_rs28_sacch_packed(pp, qp, erasures, n);
+    int ec_int = ez_rs28_sacch_soft(pb, qb, erasures, n);
+    if (ec_hb < 0 || ec_hb != ec_pk || ec_hb != ec_int) {
+        fprintf(stderr, "SACCH: ec hb=%d packed=%d int=%d\n", ec_hb, ec_pk, ec_int);
+        return 1;
+    }
+    int ref[180];
+    hexbits_to_int_bits(b.cw + 5, ref, 30);
+    if (memcmp(p, b.cw + 5, 30) != 0 || memcmp(pb, ref, sizeof(ref)) != 0 || !packed_matches(pp, b.cw + 5, 30)) {
+        fprintf(stderr, "SACCH: corrected payload mismatch\n");
+        return 1;
+    }
+    return 0;
+}
+
+/* ESS: RS(44,16,29), payload (ESS_B) at RS positions 0..15, parity (ESS_A) 16..43. */
+static int
+check_ess(uint32_t seed) {
+    Block b = make_block(19, seed);
+    uint8_t p[16], q[28];
+    memcpy(p, b.cw + 19, 16);
+    memcpy(q, b.cw + 35, 28);
+    for (int k = 0; k < 6; k++) {
+        p[(lcg(&seed) % 8) + (k & 1) * 8] ^= (uint8_t)(1 + k);
+    }
+
+    int pb[96], qb[168];
+    hexbits_to_int_bits(p, pb, 16);
+    hexbits_to_int_bits(q, qb, 28);
+    uint8_t pp[12], qp[21];
+    int_bits_to_packed(pb, 96, pp, 12);
+    int_bits_to_packed(qb, 168, qp, 21);
+
+    int ec_hb = ez_rs28_ess_hb(p, q, NULL, 0);
+    int ec_pk = ez_rs28_ess_packed(pp, qp, NULL, 0);
+    int ec_int = ez_rs28_ess(pb, qb);
+    if (ec_hb < 1 || ec_hb != ec_pk || ec_hb != ec_int) {
+        fprintf(stderr, "ESS: ec hb=%d packed=%d int=%d\n", ec_hb, ec_pk, ec_int);
+        return 1;
+    }
+    int ref[96];
+    hexbits_to_int_bits(b.cw + 19, ref, 16);
+    if (memcmp(p, b.cw + 19, 16) != 0 || memcmp(pb, ref, sizeof(ref)) != 0 || !packed_matches(pp, b.cw + 19, 16)) {
+        fprintf(stderr, "ESS: corrected payload mismatch\n");
+        return 1;
+    }
+    return 0;
+}
+
+struct WorkerArgs {
+    uint32_t seed;
+    int failures;
+};
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    decode_worker(void* arg) {
+    WorkerArgs* w = (WorkerArgs*)arg;
+    for (int i = 0; i < 300; i++) {
+        uint32_t s = w->seed + (uint32_t)i * 7919u;
+        w->failures += check_facch(s) + check_sacch(s) + check_ess(s);
+    }
+    DSD_THREAD_RETURN;
+}
+
+int
+main(void) try {
+    int rc = 0;
+    for (uint32_t s = 1; s <= 50; s++) {
+        rc |= check_facch(s);
+        rc |= check_sacch(s);
+        rc |= check_ess(s);
+    }
+
+    /* Beyond capacity: the hexbit entry point reports failure like the int wrapper. */
+    {
+        Block b = make_block(9, 77);
+        uint8_t p[26], q[19];
+        memcpy(p, b.cw + 9, 26);
+        memcpy(q, b.cw + 35, 19);
+        for (int i = 0; i < 12; i++) {
+            p[i * 2] ^= 0x2D;
+        }
+        int pb[156], qb[114];
+        hexbits_to_int_bits(p, pb, 26);
+        hexbits_to_int_bits(q, qb, 19);
+        int ec_hb = ez_rs28_facch_hb(p, q, NULL, 0);
+        int ec_int = ez_rs28_facch(pb, qb);
+        if (ec_hb != ec_int || ec_hb >= 0) {
+            fprintf(stderr, "FACCH overload: hb=%d int=%d\n", ec_hb, ec_int);
+            rc |= 1;
+        }
+    }
+
+    WorkerArgs a = {1000u, 0};
+    WorkerArgs c = {500000u, 0};
+    dsd_thread_t ta;
+    dsd_thread_t tc;
+    if (dsd_thread_create(&ta, (dsd_thread_fn)decode_worker, &a) != 0
+        || dsd_thread_create(&tc, (dsd_thread_fn)decode_worker, &c) != 0) {
+        fprintf(stderr, "failed to create decode threads\n");
+        return 1;
+    }
+    dsd_thread_join(ta);
+    dsd_thread_join(tc);
+    if (a.failures != 0 || c.failures != 0) {
+        fprintf(stderr, "concurrent decode failures: %d %d\n", a.failures, c.failures);
+        rc |= 1;
+    }
+
+    return rc;
+} catch (const std::exception& e) {
+    fprintf(stderr, "Unhandled exception: %s\n", e.what());
+    return 1;
+} catch (...) {
+    fprintf(stderr, "Unhandled exception\n");
+    return 1;
+}
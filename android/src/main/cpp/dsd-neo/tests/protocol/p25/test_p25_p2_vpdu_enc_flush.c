@@ -14,6 +14,7 @@
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/protocol/p25/p25_vpdu.h>
 #include <dsd-neo/runtime/trunk_tuning_hooks.h>
+#include <dsd-neo/runtime/p25_p2_audio_ring.h>
 
 // Stubs to satisfy external references
 
@@ -89,6 +90,16 @@ return_to_cc(dsd_opts* opts, dsd_state* state) {
     g_return_to_cc_called++;
 }
 
+/* Queue n silent frames on a slot so the ring reports n buffered. */
+static void
+fill_ring(dsd_state* st, int slot, int n) {
+    static const float frame[160];
+    p25_p2_audio_ring_reset(st, slot);
+    for (int i = 0; i < n; i++) {
+        p25_p2_audio_ring_push(st, slot, frame);
+    }
+}
+
 static void
 install_trunk_tuning_hooks(void) {
     dsd_trunk_tuning_hooks hooks = {0};
@@ -123,8 +134,8 @@ main(void) {
     st.currentslot = 0;             // so VPDU slot=0 for FACCH
     st.p25_p2_audio_allowed[0] = 1; // will be gated
     st.p25_p2_audio_allowed[1] = 1; // other slot active
-    st.p25_p2_audio_ring_count[0] = 2;
-    st.p25_p2_audio_ring_count[1] = 1;
+    fill_ring(&st, 0, 2);
+    fill_ring(&st, 1, 1);
     g_return_to_cc_called = 0;
 
     // Pre-mark TG as already DE to skip event emission branches in VPDU
@@ -144,22 +155,22 @@ main(void) {
     process_MAC_VPDU(&opts, &st, /*type FACCH*/ 0, MAC);
 
     rc |= expect_eq("slot0 muted", st.p25_p2_audio_allowed[0], 0);
-    rc |= expect_eq("slot0 ring flushed", st.p25_p2_audio_ring_count[0], 0);
-    rc |= expect_eq("slot1 ring kept", st.p25_p2_audio_ring_count[1], 1);
+    rc |= expect_eq("slot0 ring flushed", p25_p2_audio_ring_count(&st, 0), 0);
+    rc |= expect_eq("slot1 ring kept", p25_p2_audio_ring_count(&st, 1), 1);
     rc |= expect_eq("no release", g_return_to_cc_called, 0);
 
     // Scenario 2: other slot idle. ENC should gate current slot and release to CC.
     st.currentslot = 0;
     st.p25_p2_audio_allowed[0] = 1;
     st.p25_p2_audio_allowed[1] = 0; // other idle
-    st.p25_p2_audio_ring_count[0] = 1;
-    st.p25_p2_audio_ring_count[1] = 0;
+    fill_ring(&st, 0, 1);
+    p25_p2_audio_ring_reset(&st, 1);
     g_return_to_cc_called = 0;
 
     process_MAC_VPDU(&opts, &st, 0, MAC);
 
     rc |= expect_eq("slot0 muted again", st.p25_p2_audio_allowed[0], 0);
-    rc |= expect_eq("slot0 ring flushed again", st.p25_p2_audio_ring_count[0], 0);
+    rc |= expect_eq("slot0 ring flushed again", p25_p2_audio_ring_count(&st, 0), 0);
     rc |= expect_eq("released to CC", g_return_to_cc_called, 1);
 
     return rc;
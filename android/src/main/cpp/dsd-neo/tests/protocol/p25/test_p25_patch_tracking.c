@@ -130,10 +130,13 @@ main(void) {
     if (idx142 >= 0) {
         st.p25_patch_last_update[idx142] = time(NULL) - 21; // >20s ago (op25 aligned)
     }
+    int count_before = st.p25_patch_count;
     (void)p25_patch_compose_summary(&st, sum, sizeof sum);
     rc |= expect_eq_str("summary after TTL", sum, "P: 069");
     (void)p25_patch_compose_details(&st, det, sizeof det);
     rc |= expect_true("details dropped SG142", strstr(det, "SG142[") == NULL);
+    // Compose is read-only: the stale entry stays until the expiry timer sweeps it
+    rc |= expect_true("compose leaves table", st.p25_patch_count == count_before && find_idx(&st, 142) >= 0);
 
     // Clear SG069; expect no summary and SG069 inactive
     p25_patch_clear_sg(&st, 69);
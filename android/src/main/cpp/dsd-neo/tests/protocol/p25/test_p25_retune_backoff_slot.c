@@ -20,6 +20,7 @@
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
+#include <dsd-neo/runtime/p25_p2_audio_ring.h>
 
 // --- IO control stubs (rigctl/RTL) ---
 
@@ -108,8 +109,7 @@ main(void) {
     st.p25_p2_last_mac_active[1] = 0;
     st.p25_p2_audio_allowed[0] = 0;
     st.p25_p2_audio_allowed[1] = 0;
-    st.p25_p2_audio_ring_count[0] = 0;
-    st.p25_p2_audio_ring_count[1] = 0;
+    p25_p2_audio_ring_reset(&st, -1);
     st.p25_last_vc_tune_time = time(NULL) - 1; // > 0.5s
     st.p25_p2_active_slot = 1;                 // last active slot = 1
     st.p25_sm_force_release = 1;               // force immediate return to CC
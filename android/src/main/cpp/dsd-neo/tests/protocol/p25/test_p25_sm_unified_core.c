@@ -15,11 +15,22 @@
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/protocol/p25/p25_trunk_sm.h>
+#include <dsd-neo/runtime/p25_p2_audio_ring.h>
 
 // Minimal stubs for testing
 static dsd_opts g_opts;
 static dsd_state g_state;
 
+/* Queue n silent frames on a slot so the ring reports n buffered. */
+static void
+fill_ring(dsd_state* st, int slot, int n) {
+    static const float frame[160];
+    p25_p2_audio_ring_reset(st, slot);
+    for (int i = 0; i < n; i++) {
+        p25_p2_audio_ring_push(st, slot, frame);
+    }
+}
+
 static void
 reset_test_state(void) {
     memset(&g_opts, 0, sizeof(g_opts));
@@ -72,7 +83,7 @@ static int
 test_grant_to_tuned(void) {
     reset_test_state();
     // Set up a channel->freq mapping so grant can compute frequency
-    g_state.trunk_chan_map[0x1234] = 851500000;
+    dsd_chan_map_set(&g_state.trunk_chan_map, 0x1234, 851500000);
 
     p25_sm_ctx_t ctx;
     p25_sm_init_ctx(&ctx, &g_opts, &g_state);
@@ -100,7 +111,7 @@ test_grant_to_tuned(void) {
 static int
 test_ptt_voice_active(void) {
     reset_test_state();
-    g_state.trunk_chan_map[0x1234] = 851500000;
+    dsd_chan_map_set(&g_state.trunk_chan_map, 0x1234, 851500000);
 
     p25_sm_ctx_t ctx;
     p25_sm_init_ctx(&ctx, &g_opts, &g_state);
@@ -131,7 +142,7 @@ test_ptt_voice_active(void) {
 static int
 test_end_clears_voice(void) {
     reset_test_state();
-    g_state.trunk_chan_map[0x1234] = 851500000;
+    dsd_chan_map_set(&g_state.trunk_chan_map, 0x1234, 851500000);
 
     p25_sm_ctx_t ctx;
     p25_sm_init_ctx(&ctx, &g_opts, &g_state);
@@ -227,7 +238,7 @@ test_singleton(void) {
 static int
 test_audio_allowed(void) {
     reset_test_state();
-    g_state.trunk_chan_map[0x1234] = 851500000;
+    dsd_chan_map_set(&g_state.trunk_chan_map, 0x1234, 851500000);
 
     p25_sm_ctx_t ctx;
     p25_sm_init_ctx(&ctx, &g_opts, &g_state);
@@ -284,7 +295,7 @@ test_sacch_slot_mapping(void) {
 static int
 test_tdma_partial_end_stays_tuned(void) {
     reset_test_state();
-    g_state.trunk_chan_map[0x1234] = 851500000;
+    dsd_chan_map_set(&g_state.trunk_chan_map, 0x1234, 851500000);
     // Mark this channel as TDMA (P25P2)
     g_state.p25_chan_tdma_explicit[1] = 2; // iden=1, explicit TDMA hint
 
@@ -341,7 +352,7 @@ test_tdma_partial_end_stays_tuned(void) {
 static int
 test_tdma_single_slot_end_releases(void) {
     reset_test_state();
-    g_state.trunk_chan_map[0x1234] = 851500000;
+    dsd_chan_map_set(&g_state.trunk_chan_map, 0x1234, 851500000);
     // Mark this channel as TDMA (P25P2)
     g_state.p25_chan_tdma_explicit[1] = 2; // iden=1, explicit TDMA hint
 
@@ -366,7 +377,7 @@ test_tdma_single_slot_end_releases(void) {
     g_state.p25_p2_audio_allowed[0] = 1;
 
     // Simulate audio in the ring buffer (jitter buffer has samples)
-    g_state.p25_p2_audio_ring_count[0] = 5;
+    fill_ring(&g_state, 0, 3);
 
     // Verify slot 1 never had activity
     if (ctx.slots[1].last_active_m != 0.0) {
@@ -120,6 +120,7 @@ unset_all_runtime_env(void) {
         "DSD_NEO_FTZ_DAZ",
         "DSD_NEO_INPUT_VOLUME",
         "DSD_NEO_INPUT_WARN_DB",
+        "DSD_NEO_IQ_BALANCE",
         "DSD_NEO_IQ_DC_BLOCK",
         "DSD_NEO_IQ_DC_SHIFT",
         "DSD_NEO_MT",
@@ -1718,6 +1719,100 @@ test_auto_ppm_env(void) {
     return 0;
 }
 
+static int
+test_snapshot_publish(void) {
+    unsetenv("DSD_NEO_TCPIN_BACKOFF_MS");
+    unsetenv("DSD_NEO_IQ_BALANCE");
+    dsd_neo_config_init(NULL);
+    const dsdneoRuntimeConfig* a = dsd_neo_config_snapshot(NULL);
+    unsigned int gen_a = dsd_neo_config_generation();
+    int rc = expect(a != NULL && a == dsd_neo_get_config(), 1800, "snapshot differs from current config");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(a->iq_balance_is_set, 0, 1801, "iq_balance_is_set (default)");
+    if (rc != 0) {
+        return rc;
+    }
+
+    /* Re-init publishes a new snapshot; the held one is left untouched. */
+    setenv("DSD_NEO_TCPIN_BACKOFF_MS", "1000", 1);
+    setenv("DSD_NEO_IQ_BALANCE", "1", 1);
+    dsd_neo_config_init(NULL);
+    const dsdneoRuntimeConfig* b = dsd_neo_config_snapshot(NULL);
+    rc = expect(b != a, 1802, "re-init reused the held snapshot");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect(dsd_neo_config_generation() != gen_a, 1803, "generation not bumped");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(a->tcpin_backoff_ms_is_set, 0, 1804, "held snapshot mutated");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(b->tcpin_backoff_ms, 1000, 1805, "tcpin_backoff_ms (new snapshot)");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(b->iq_balance_is_set && b->iq_balance_enable, 1, 1806, "iq_balance (1)");
+    if (rc != 0) {
+        return rc;
+    }
+
+    /* Setters are copy-on-write and keep the other fields. */
+    dsd_neo_set_c4fm_clk(2);
+    const dsdneoRuntimeConfig* c = dsd_neo_get_config();
+    rc = expect(c != b && b->c4fm_clk_is_set == 0, 1807, "c4fm setter mutated the held snapshot");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(c->c4fm_clk_mode, 2, 1808, "c4fm_clk_mode");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(c->tcpin_backoff_ms, 1000, 1809, "tcpin_backoff_ms (after setter)");
+    if (rc != 0) {
+        return rc;
+    }
+
+    /* Identical configs reuse their snapshot instead of allocating another. */
+    unsigned int gen_c = dsd_neo_config_generation();
+    dsd_neo_set_c4fm_clk(2);
+    rc = expect(dsd_neo_get_config() == c && dsd_neo_config_generation() == gen_c, 1812,
+                "unchanged setter published a new snapshot");
+    if (rc != 0) {
+        return rc;
+    }
+    dsd_neo_set_c4fm_clk(0);
+    dsd_neo_set_c4fm_clk(2);
+    rc = expect(dsd_neo_get_config() == c && dsd_neo_config_generation() != gen_c, 1813,
+                "toggle back did not reuse the earlier snapshot");
+    if (rc != 0) {
+        return rc;
+    }
+
+    /* The cached helper fills an empty slot and then keeps it. */
+    const dsdneoRuntimeConfig* slot = NULL;
+    const dsdneoRuntimeConfig* got = dsd_neo_config_cached(&slot, NULL);
+    rc = expect(got == c && slot == c, 1810, "cached helper did not fill the slot");
+    if (rc != 0) {
+        return rc;
+    }
+    dsd_neo_config_init(NULL);
+    got = dsd_neo_config_cached(&slot, NULL);
+    rc = expect(got == c, 1811, "cached helper replaced a held snapshot");
+    if (rc != 0) {
+        return rc;
+    }
+
+    unsetenv("DSD_NEO_TCPIN_BACKOFF_MS");
+    unsetenv("DSD_NEO_IQ_BALANCE");
+    dsd_neo_config_init(NULL);
+    return 0;
+}
+
 static int
 test_dsp_misc_env(void) {
     setenv("DSD_NEO_COMBINE_ROT", "0", 1);
@@ -2253,6 +2348,10 @@ main(void) {
     if (rc != 0) {
         return rc;
     }
+    rc = test_snapshot_publish();
+    if (rc != 0) {
+        return rc;
+    }
 
     return 0;
 }
@@ -8,6 +8,7 @@
 #include <stddef.h>
 
 static int s_calls = 0;
+static int s_wait_calls = 0;
 
 static void
 test_pump(dsd_opts* opts, dsd_state* state) {
@@ -16,6 +17,11 @@ test_pump(dsd_opts* opts, dsd_state* state) {
     s_calls++;
 }
 
+static void
+test_wait_pump(void) {
+    s_wait_calls++;
+}
+
 int
 main(void) {
     // Default behavior is a safe no-op until a pump is registered.
@@ -45,5 +51,19 @@ main(void) {
     }
 
     dsd_runtime_set_control_pump(NULL);
+
+    // Input wait pump is independent of the control pump.
+    dsd_runtime_pump_input_wait();
+    dsd_runtime_set_input_wait_pump(test_wait_pump);
+    dsd_runtime_pump_input_wait();
+    dsd_runtime_pump_controls(NULL, NULL);
+    if (s_wait_calls != 1 || s_calls != 3) {
+        return 5;
+    }
+    dsd_runtime_set_input_wait_pump(NULL);
+    dsd_runtime_pump_input_wait();
+    if (s_wait_calls != 1) {
+        return 6;
+    }
     return 0;
 }
@@ -0,0 +1,315 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/runtime/decoder_events.h>
+
+#define MAX_SEEN 32
+
+typedef struct {
+    int n;
+    dsd_decoder_event ev[MAX_SEEN];
+} recorder;
+
+static void
+record(const dsd_decoder_event* ev, void* user) {
+    recorder* r = (recorder*)user;
+    assert(r->n < MAX_SEEN);
+    r->ev[r->n++] = *ev;
+}
+
+static int
+count_kind(const recorder* r, dsd_decoder_event_kind kind) {
+    int n = 0;
+    for (int i = 0; i < r->n; i++) {
+        n += r->ev[i].kind == kind;
+    }
+    return n;
+}
+
+static const dsd_decoder_event*
+last_kind(const recorder* r, dsd_decoder_event_kind kind) {
+    for (int i = r->n - 1; i >= 0; i--) {
+        if (r->ev[i].kind == kind) {
+            return &r->ev[i];
+        }
+    }
+    return NULL;
+}
+
+static void
+test_filter(void) {
+    assert(dsd_tg_filter_get_mode() == DSD_TG_FILTER_OFF);
+    assert(dsd_tg_filter_allows(100) == 1);
+
+    const int tgs[] = {300, 100, 200, 100};
+    assert(dsd_tg_filter_set(DSD_TG_FILTER_ALLOW, tgs, 4) == 0);
+    assert(dsd_tg_filter_count() == 3); /* duplicates collapse */
+    assert(dsd_tg_filter_allows(100) == 1);
+    assert(dsd_tg_filter_allows(300) == 1);
+    assert(dsd_tg_filter_allows(150) == 0);
+
+    /* Mode flip keeps the list. */
+    assert(dsd_tg_filter_set_mode(DSD_TG_FILTER_BLOCK) == 0);
+    assert(dsd_tg_filter_count() == 3);
+    assert(dsd_tg_filter_allows(100) == 0);
+    assert(dsd_tg_filter_allows(150) == 1);
+
+    assert(dsd_tg_filter_add(150) == 0);
+    assert(dsd_tg_filter_add(150) == 0);
+    assert(dsd_tg_filter_count() == 4);
+    assert(dsd_tg_filter_allows(150) == 0);
+    assert(dsd_tg_filter_remove(100) == 0);
+    assert(dsd_tg_filter_remove(999) == 0);
+    assert(dsd_tg_filter_count() == 3);
+    assert(dsd_tg_filter_allows(100) == 1);
+
+    assert(dsd_tg_filter_set_mode(7) == -1);
+    assert(dsd_tg_filter_set(DSD_TG_FILTER_ALLOW, NULL, 2) == -1);
+    assert(dsd_tg_filter_get_mode() == DSD_TG_FILTER_BLOCK);
+
+    /* Emptying the list leaves block mode allowing everything, allow mode nothing. */
+    assert(dsd_tg_filter_set_list(NULL, 0) == 0);
+    assert(dsd_tg_filter_allows(150) == 1);
+    assert(dsd_tg_filter_set_mode(DSD_TG_FILTER_ALLOW) == 0);
+    assert(dsd_tg_filter_allows(150) == 0);
+    assert(dsd_tg_filter_set(DSD_TG_FILTER_OFF, NULL, 0) == 0);
+    assert(dsd_tg_filter_allows(150) == 1);
+}
+
+static void
+test_subscriptions(void) {
+    recorder a;
+    recorder b;
+    memset(&a, 0, sizeof a);
+    memset(&b, 0, sizeof b);
+    assert(dsd_decoder_events_subscribe(0, record, &a) == -1);
+    assert(dsd_decoder_events_subscribe(DSD_EVENT_MASK_ALL, NULL, &a) == -1);
+
+    int ia = dsd_decoder_events_subscribe(DSD_EVENT_MASK_ALL, record, &a);
+    int ib = dsd_decoder_events_subscribe(DSD_EVENT_MASK(DSD_EVENT_SITE), record, &b);
+    assert(ia > 0 && ib > 0 && ia != ib);
+
+    dsd_decoder_event ev;
+    memset(&ev, 0, sizeof ev);
+    ev.kind = DSD_EVENT_CALL;
+    dsd_decoder_events_emit(&ev);
+    ev.kind = DSD_EVENT_SITE;
+    dsd_decoder_events_emit(&ev);
+    assert(a.n == 2 && b.n == 1 && b.ev[0].kind == DSD_EVENT_SITE);
+
+    dsd_decoder_events_unsubscribe(ia);
+    dsd_decoder_events_unsubscribe(ia); /* unknown id is ignored */
+    dsd_decoder_events_emit(&ev);
+    assert(a.n == 2 && b.n == 2);
+    dsd_decoder_events_unsubscribe(ib);
+    dsd_decoder_events_emit(&ev);
+    assert(b.n == 2);
+}
+
+static void
+test_reporting(void) {
+    dsd_state* st = calloc(1, sizeof(*st));
+    assert(st);
+    recorder r;
+    memset(&r, 0, sizeof r);
+
+    /* Without subscribers nothing is tracked. */
+    st->lasttg = 1;
+    dsd_decoder_events_call(st, 0, 1);
+    dsd_decoder_events_signal(st);
+    assert(dsd_state_ext_get(st, DSD_STATE_EXT_ENGINE_DECODER_EVENTS) == NULL);
+    st->lasttg = 0;
+
+    int id = dsd_decoder_events_subscribe(DSD_EVENT_MASK_ALL, record, &r);
+    assert(id > 0);
+    st->synctype = DSD_SYNC_NONE;
+
+    /* First signal report always emits; an unchanged one does not. */
+    dsd_decoder_events_signal(st);
+    assert(r.n == 1 && r.ev[0].kind == DSD_EVENT_SIGNAL);
+    dsd_decoder_events_signal(st);
+    assert(r.n == 1);
+
+    /* Activity before the call is identified reports nothing. */
+    dsd_decoder_events_call(st, 0, 1);
+    assert(r.n == 1);
+
+    /* Call start, update, end; filtered flag follows the filter snapshot. */
+    const int blocked = 201;
+    assert(dsd_tg_filter_set(DSD_TG_FILTER_BLOCK, &blocked, 1) == 0);
+    r.n = 0;
+    st->lasttg = 101;
+    st->lastsrc = 5001;
+    st->nac = 0x293;
+    dsd_decoder_events_call(st, 0, 1);
+    dsd_decoder_events_call(st, 0, 1);
+    const dsd_decoder_event* e = last_kind(&r, DSD_EVENT_CALL);
+    assert(e && e->u.call.phase == DSD_CALL_START && e->u.call.tg == 101 && e->u.call.src == 5001);
+    assert(e->u.call.nac == 0x293 && e->u.call.filtered == 0 && e->u.call.slot == 0);
+    assert(count_kind(&r, DSD_EVENT_CALL) == 1);
+    st->lasttg = 201;
+    dsd_decoder_events_call(st, 0, 1);
+    e = last_kind(&r, DSD_EVENT_CALL);
+    assert(e->u.call.phase == DSD_CALL_UPDATE && e->u.call.tg == 201 && e->u.call.filtered == 1);
+    dsd_decoder_events_call(st, 0, 0);
+    e = last_kind(&r, DSD_EVENT_CALL);
+    assert(e->u.call.phase == DSD_CALL_END && e->u.call.tg == 201 && e->u.call.src == 5001);
+    dsd_decoder_events_call(st, 0, 0);
+    assert(count_kind(&r, DSD_EVENT_CALL) == 3);
+    dsd_tg_filter_set(DSD_TG_FILTER_OFF, NULL, 0);
+
+    /* Slots are tracked separately; slot 1 reads the R fields; -1 ends both. */
+    r.n = 0;
+    st->synctype = DSD_SYNC_DMR_BS_VOICE_POS;
+    st->lasttg = 1;
+    st->lastsrc = 2;
+    st->lasttgR = 9;
+    st->lastsrcR = 8;
+    dsd_decoder_events_call(st, 1, 1);
+    e = last_kind(&r, DSD_EVENT_CALL);
+    assert(e && e->u.call.tg == 9 && e->u.call.src == 8 && e->u.call.slot == 1);
+    assert(e->u.call.phase == DSD_CALL_START && e->u.call.synctype == DSD_SYNC_DMR_BS_VOICE_POS);
+    dsd_decoder_events_call(st, 0, 1);
+    assert(count_kind(&r, DSD_EVENT_CALL) == 2 && last_kind(&r, DSD_EVENT_CALL)->u.call.tg == 1);
+    dsd_decoder_events_call(st, -1, 0);
+    assert(count_kind(&r, DSD_EVENT_CALL) == 4);
+    assert(last_kind(&r, DSD_EVENT_CALL)->u.call.phase == DSD_CALL_END);
+
+    /* Sync edges bypass the rate limit; counters alone are limited. */
+    r.n = 0;
+    dsd_decoder_events_signal(st);
+    assert(count_kind(&r, DSD_EVENT_SIGNAL) == 1);
+    st->p25_p1_fec_ok++;
+    dsd_decoder_events_signal(st);
+    st->p25_p1_fec_ok++;
+    dsd_decoder_events_signal(st);
+    assert(count_kind(&r, DSD_EVENT_SIGNAL) == 1);
+
+    /* Site: reported once per change, suppressed while all IDs are zero. */
+    r.n = 0;
+    dsd_decoder_events_site(st);
+    assert(count_kind(&r, DSD_EVENT_SITE) == 0);
+    st->p2_wacn = 0xBEE00;
+    st->p2_siteid = 0x1;
+    st->p2_rfssid = 0x2;
+    dsd_decoder_events_site(st);
+    dsd_decoder_events_site(st);
+    assert(count_kind(&r, DSD_EVENT_SITE) == 1);
+    e = last_kind(&r, DSD_EVENT_SITE);
+    assert(e->u.site.wacn == 0xBEE00 && e->u.site.siteid == 1 && e->u.site.rfssid == 2);
+
+    /* Tables: each report is one event carrying the state; other kinds are rejected. */
+    r.n = 0;
+    dsd_decoder_events_table(st, DSD_EVENT_AFFILIATION);
+    dsd_decoder_events_table(st, DSD_EVENT_PATCH);
+    dsd_decoder_events_table(st, DSD_EVENT_GROUP_ATTACH);
+    dsd_decoder_events_table(st, DSD_EVENT_NEIGHBOR);
+    dsd_decoder_events_table(st, DSD_EVENT_CALL);
+    assert(r.n == 4 && last_kind(&r, DSD_EVENT_AFFILIATION)->state == st);
+
+    /* Reset re-announces the current call and site. */
+    r.n = 0;
+    dsd_decoder_events_call(st, 0, 1);
+    dsd_decoder_events_site(st);
+    assert(r.n == 1);
+    dsd_decoder_events_reset(st);
+    r.n = 0;
+    dsd_decoder_events_call(st, 0, 1);
+    dsd_decoder_events_site(st);
+    assert(count_kind(&r, DSD_EVENT_CALL) == 1 && count_kind(&r, DSD_EVENT_SITE) == 1);
+
+    dsd_decoder_events_unsubscribe(id);
+    dsd_state_ext_free_all(st);
+    free(st);
+}
+
+/* A subscriber only to calls leaves the other reporters inert. */
+static void
+test_reporting_masked(void) {
+    dsd_state* st = calloc(1, sizeof(*st));
+    assert(st);
+    recorder r;
+    memset(&r, 0, sizeof r);
+    int id = dsd_decoder_events_subscribe(DSD_EVENT_MASK(DSD_EVENT_CALL), record, &r);
+    assert(id > 0);
+    st->p2_wacn = 1;
+    dsd_decoder_events_site(st);
+    dsd_decoder_events_signal(st);
+    dsd_decoder_events_table(st, DSD_EVENT_PATCH);
+    assert(r.n == 0);
+    st->lasttg = 7;
+    dsd_decoder_events_call(st, 0, 1);
+    assert(r.n == 1 && r.ev[0].kind == DSD_EVENT_CALL);
+    dsd_decoder_events_unsubscribe(id);
+    dsd_state_ext_free_all(st);
+    free(st);
+}
+
+/* Protocols without trunk SM report sites go through the per-frame fallback. */
+static void
+test_frame_fallback(void) {
+    dsd_state* st = calloc(1, sizeof(*st));
+    assert(st);
+    recorder r;
+    memset(&r, 0, sizeof r);
+    int id = dsd_decoder_events_subscribe(DSD_EVENT_MASK(DSD_EVENT_CALL), record, &r);
+    assert(id > 0);
+
+    /* NXDN voice: identity comes from the NXDN fields, not lasttg/lastsrc. */
+    st->synctype = DSD_SYNC_NXDN_POS;
+    dsd_decoder_events_frame(st);
+    assert(r.n == 0);
+    st->nxdn_last_tg = 44;
+    st->nxdn_last_rid = 1201;
+    dsd_decoder_events_frame(st);
+    dsd_decoder_events_frame(st);
+    assert(r.n == 1);
+    assert(r.ev[0].u.call.phase == DSD_CALL_START && r.ev[0].u.call.tg == 44 && r.ev[0].u.call.src == 1201);
+    assert(r.ev[0].u.call.slot == 0 && r.ev[0].u.call.synctype == DSD_SYNC_NXDN_POS);
+    st->nxdn_last_tg = 0;
+    st->nxdn_last_rid = 0;
+    dsd_decoder_events_frame(st);
+    assert(r.n == 2 && r.ev[1].u.call.phase == DSD_CALL_END && r.ev[1].u.call.tg == 44);
+
+    /* dPMR ids are decimal strings; blank (spaces) is no call. */
+    st->synctype = DSD_SYNC_DPMR_FS2_POS;
+    memcpy(st->dpmr_target_id, "      ", 7);
+    memcpy(st->dpmr_caller_id, "      ", 7);
+    dsd_decoder_events_frame(st);
+    assert(r.n == 2);
+    snprintf(st->dpmr_target_id, sizeof st->dpmr_target_id, "%s", "0000012");
+    snprintf(st->dpmr_caller_id, sizeof st->dpmr_caller_id, "%s", "0000345");
+    dsd_decoder_events_frame(st);
+    assert(r.n == 3 && r.ev[2].u.call.phase == DSD_CALL_START && r.ev[2].u.call.tg == 12 && r.ev[2].u.call.src == 345);
+
+    /* P25/DMR are left to their own report sites. */
+    st->synctype = DSD_SYNC_P25P1_POS;
+    st->dpmr_target_id[0] = '\0';
+    st->dpmr_caller_id[0] = '\0';
+    dsd_decoder_events_frame(st);
+    assert(r.n == 3);
+
+    dsd_decoder_events_unsubscribe(id);
+    dsd_state_ext_free_all(st);
+    free(st);
+}
+
+int
+main(void) {
+    test_filter();
+    test_subscriptions();
+    test_reporting();
+    test_reporting_masked();
+    test_frame_fallback();
+    return 0;
+}
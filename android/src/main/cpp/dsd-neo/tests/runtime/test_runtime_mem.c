@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Pooled DSP buffer allocator: small requests stay on the aligned heap,
+ * large ones get aligned mappings that are pooled on free, reused for a
+ * similar size, and unmapped by trim.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <dsd-neo/platform/platform.h>
+#include <dsd-neo/runtime/mem.h>
+
+#define MIB ((size_t)1 << 20)
+
+int
+main(void) {
+    dsd_neo_buffer_stats st;
+
+    void* small = dsd_neo_buffer_malloc(4096);
+    assert(small != NULL && ((uintptr_t)small % DSD_NEO_ALIGN) == 0);
+    dsd_neo_buffer_get_stats(&st);
+    assert(st.live_maps == 0);
+    dsd_neo_buffer_free(small);
+
+    void* none = dsd_neo_buffer_malloc(0);
+    assert(none == NULL);
+    dsd_neo_buffer_free(NULL);
+    (void)none;
+
+#if !DSD_PLATFORM_WIN_NATIVE
+    unsigned char* a = (unsigned char*)dsd_neo_buffer_malloc(8 * MIB);
+    assert(a != NULL && ((uintptr_t)a % DSD_NEO_ALIGN) == 0);
+    memset(a, 0x5a, 8 * MIB);
+    dsd_neo_buffer_get_stats(&st);
+    assert(st.live_maps == 1 && st.live_bytes >= 8 * MIB && st.mapped == 1);
+
+    /* Freed mapping is pooled and handed back to a request of similar size. */
+    dsd_neo_buffer_free(a);
+    dsd_neo_buffer_get_stats(&st);
+    assert(st.live_maps == 0 && st.pooled_maps == 1);
+    unsigned char* b = (unsigned char*)dsd_neo_buffer_malloc(7 * MIB);
+    dsd_neo_buffer_get_stats(&st);
+    assert(b == a && st.reused == 1 && st.pooled_maps == 0 && st.mapped == 1);
+
+    /* Far smaller requests do not take an oversized pooled mapping. */
+    dsd_neo_buffer_free(b);
+    unsigned char* c = (unsigned char*)dsd_neo_buffer_malloc(1 * MIB);
+    assert(c != NULL && c != a);
+    c[1 * MIB - 1] = 1;
+    dsd_neo_buffer_get_stats(&st);
+    assert(st.live_maps == 1 && st.pooled_maps == 1 && st.mapped == 2);
+
+    dsd_neo_buffer_free(c);
+    dsd_neo_buffer_trim();
+    dsd_neo_buffer_get_stats(&st);
+    assert(st.live_maps == 0 && st.pooled_maps == 0 && st.pooled_bytes == 0);
+    (void)b;
+#endif
+
+    /* Plain aligned allocations may be released through the buffer API too. */
+    void* heap = dsd_neo_aligned_malloc(1024);
+    assert(heap != NULL);
+    dsd_neo_buffer_free(heap);
+    return 0;
+}
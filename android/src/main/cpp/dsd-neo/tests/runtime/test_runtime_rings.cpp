@@ -159,6 +159,63 @@ test_input_ring_drop_on_full(void) {
     return 0;
 }
 
+static int
+test_input_ring_retune_marker(void) {
+    const size_t cap = 8;
+    struct input_ring_state r;
+    memset(&r, 0, sizeof(r));
+
+    r.buffer = (float*)calloc(cap, sizeof(float));
+    if (!r.buffer) {
+        fprintf(stderr, "input_ring marker: allocation failed\n");
+        return 1;
+    }
+    r.capacity = cap;
+    dsd_cond_init(&r.ready);
+    dsd_mutex_init(&r.ready_m);
+
+    /* Old-frequency samples, then a retune, then new-frequency samples (wraps). */
+    float out[8] = {0};
+    float warm[4] = {1, 2, 3, 4};
+    input_ring_write(&r, warm, 4);
+    if (input_ring_read_block(&r, out, 4) != 4) {
+        fprintf(stderr, "input_ring marker: warm-up read failed\n");
+        return 1;
+    }
+    float old_freq[3] = {5, 6, 7};
+    input_ring_write(&r, old_freq, 3);
+    input_ring_request_marker(&r);
+    input_ring_request_marker(&r); /* back-to-back requests collapse */
+    float new_freq[4] = {100, 101, 102, 103};
+    input_ring_write(&r, new_freq, 4);
+
+    int marker = 0;
+    int got = input_ring_read_block_marker(&r, out, 8, &marker);
+    if (got != 0 || marker != 1) {
+        fprintf(stderr, "input_ring marker: expected marker stop, got=%d marker=%d\n", got, marker);
+        return 1;
+    }
+    got = input_ring_read_block_marker(&r, out, 8, &marker);
+    if (got != 4 || marker != 0 || !float_arrays_equal(out, new_freq, 4)) {
+        fprintf(stderr, "input_ring marker: expected only post-marker samples, got=%d marker=%d\n", got, marker);
+        return 1;
+    }
+
+    /* No further marker until another request. */
+    float more[2] = {104, 105};
+    input_ring_write(&r, more, 2);
+    got = input_ring_read_block_marker(&r, out, 8, &marker);
+    if (got != 2 || marker != 0) {
+        fprintf(stderr, "input_ring marker: unexpected marker on plain read\n");
+        return 1;
+    }
+
+    dsd_mutex_destroy(&r.ready_m);
+    dsd_cond_destroy(&r.ready);
+    free(r.buffer);
+    return 0;
+}
+
 static int
 test_output_ring_wrap_and_read(void) {
     const size_t cap = 8;
@@ -402,6 +459,7 @@ main(void) {
     rc |= test_input_ring_wrap_and_read();
     rc |= test_output_ring_wrap_and_read();
     rc |= test_input_ring_drop_on_full();
+    rc |= test_input_ring_retune_marker();
     rc |= test_output_ring_blocking_producer_consumer();
     if (rc == 0) {
         fprintf(stderr, "runtime ring tests: OK\n");
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dsd-neo/core/opts.h>
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/symbol_file.h>
+
+#include "test_support.h"
+
+#define setenv   dsd_test_setenv
+#define unsetenv dsd_test_unsetenv
+
+#define N_DIBITS (200 * 1000)
+
+static void
+test_header_round_trip(void) {
+    dsd_symbol_file_header in = {DSD_SYMBOL_FILE_VERSION, DSD_SYMBOL_FMT_DIBIT, 1, 6000, 1700000000123456789LL};
+    dsd_symbol_file_header out;
+    uint8_t buf[DSD_SYMBOL_FILE_HEADER_SIZE];
+
+    assert(dsd_symbol_file_header_encode(&in, buf) == DSD_SYMBOL_FILE_HEADER_SIZE);
+    assert(dsd_symbol_file_header_decode(buf, sizeof buf, &out) == 1);
+    assert(out.version == in.version);
+    assert(out.format == in.format);
+    assert(out.modulation == in.modulation);
+    assert(out.symbol_rate == in.symbol_rate);
+    assert(out.start_unix_ns == in.start_unix_ns);
+
+    assert(dsd_symbol_file_header_decode(buf, sizeof buf - 1, &out) == 0);
+    buf[0] = 0;
+    assert(dsd_symbol_file_header_decode(buf, sizeof buf, &out) == 0);
+}
+
+/* Multi-buffer write with header, then read back both in blocks and one at a time. */
+static void
+test_dibit_stream(void) {
+    FILE* f = tmpfile();
+    assert(f != NULL);
+    uint8_t* data = malloc(N_DIBITS);
+    uint8_t* back = malloc(N_DIBITS);
+    assert(data && back);
+    for (size_t i = 0; i < N_DIBITS; i++) {
+        data[i] = (i % 97 == 0) ? 0xFF : (uint8_t)((i * 7u) & 3u);
+    }
+
+    dsd_symbol_file_header hdr = {1, DSD_SYMBOL_FMT_DIBIT, 0, 4800, 42};
+    dsd_symbol_writer* w = dsd_symbol_writer_attach(f, &hdr);
+    assert(w != NULL);
+    dsd_symbol_writer_put(w, data[0]);
+    dsd_symbol_writer_write(w, data + 1, N_DIBITS - 1);
+    dsd_symbol_writer_free(w);
+    assert(ftell(f) == DSD_SYMBOL_FILE_HEADER_SIZE + N_DIBITS);
+
+    rewind(f);
+    dsd_symbol_reader* r = dsd_symbol_reader_attach(f, DSD_SYMBOL_FMT_DIBIT);
+    assert(r != NULL);
+    const dsd_symbol_file_header* got = dsd_symbol_reader_header(r);
+    assert(got != NULL);
+    assert(got->symbol_rate == 4800 && got->start_unix_ns == 42);
+    assert(dsd_symbol_reader_read_dibits(r, back, 3) == 3);
+    assert(dsd_symbol_reader_read_dibits(r, back + 3, N_DIBITS) == N_DIBITS - 3);
+    assert(memcmp(data, back, N_DIBITS) == 0);
+    assert(dsd_symbol_reader_next_dibit(r) == -1);
+    assert(dsd_symbol_reader_count(r) == N_DIBITS);
+    assert(dsd_symbol_reader_chunk(r) == NULL);
+    assert(dsd_symbol_reader_seek_time(r, 0) == -1);
+    dsd_symbol_reader_free(r);
+
+    /* Legacy capture: raw dibits, no header. */
+    rewind(f);
+    fseek(f, DSD_SYMBOL_FILE_HEADER_SIZE, SEEK_SET);
+    FILE* legacy = tmpfile();
+    assert(legacy != NULL);
+    size_t n = fread(back, 1, N_DIBITS, f);
+    assert(n == N_DIBITS);
+    fwrite(back, 1, n, legacy);
+    rewind(legacy);
+    r = dsd_symbol_reader_attach(legacy, DSD_SYMBOL_FMT_DIBIT);
+    assert(dsd_symbol_reader_header(r) == NULL);
+    for (size_t i = 0; i < N_DIBITS; i++) {
+        assert(dsd_symbol_reader_next_dibit(r) == data[i]);
+    }
+    assert(dsd_symbol_reader_next_dibit(r) == -1);
+    dsd_symbol_reader_free(r);
+
+    fclose(legacy);
+    fclose(f);
+    free(data);
+    free(back);
+}
+
+/* Indexed capture: marks at known times/syncs, buffer-full continuation chunks, and seeks. */
+static void
+test_indexed_stream(void) {
+    FILE* f = tmpfile();
+    assert(f != NULL);
+    const int64_t t0 = 1000LL * 1000000000LL;
+    dsd_symbol_file_header hdr = {DSD_SYMBOL_FILE_VERSION, DSD_SYMBOL_FMT_DIBIT, 0, 4800, t0};
+    dsd_symbol_writer* w = dsd_symbol_writer_attach(f, &hdr);
+    assert(w != NULL);
+
+    /* 10 one-second chunks; chunk 4 starts a sync event of type 7, chunk 8 retunes. */
+    for (int sec = 0; sec < 10; sec++) {
+        int sync = (sec >= 4) ? 7 : -1;
+        uint32_t flags = DSD_SYMBOL_INDEX_PERIODIC;
+        if (sec == 4) {
+            flags |= DSD_SYMBOL_INDEX_SYNC;
+        }
+        if (sec == 8) {
+            flags |= DSD_SYMBOL_INDEX_FREQ;
+        }
+        dsd_symbol_writer_mark(w, t0 + (int64_t)sec * 1000000000LL, sec >= 8 ? 852000000 : 851000000, sync, flags);
+        for (int i = 0; i < 4800; i++) {
+            dsd_symbol_writer_put(w, (uint8_t)(sec & 3));
+        }
+    }
+    /* One oversized chunk to force continuation records. */
+    dsd_symbol_writer_mark(w, t0 + 10LL * 1000000000LL, 852000000, 7, DSD_SYMBOL_INDEX_PERIODIC);
+    uint8_t* big = malloc(150000);
+    assert(big != NULL);
+    memset(big, 2, 150000);
+    dsd_symbol_writer_write(w, big, 150000);
+    dsd_symbol_writer_free(w);
+
+    const size_t total = 10 * 4800 + 150000;
+    rewind(f);
+    dsd_symbol_reader* r = dsd_symbol_reader_attach(f, DSD_SYMBOL_FMT_DIBIT);
+    assert(r != NULL);
+    assert(dsd_symbol_reader_header(r)->version == DSD_SYMBOL_FILE_VERSION);
+    uint8_t* back = malloc(total + 16);
+    assert(back != NULL);
+    assert(dsd_symbol_reader_read_dibits(r, back, total + 16) == total);
+    for (size_t i = 0; i < 10 * 4800; i++) {
+        assert(back[i] == (uint8_t)((i / 4800) & 3));
+    }
+    assert(memcmp(back + 10 * 4800, big, 150000) == 0);
+    const dsd_symbol_index_record* c = dsd_symbol_reader_chunk(r);
+    assert(c != NULL && c->flags == 0 && c->synctype == 7);
+    assert(c->wall_unix_ns > t0 + 10LL * 1000000000LL); /* extrapolated from the symbol rate */
+
+    /* Seek to t0 + 6.5 s lands on chunk 6. */
+    assert(dsd_symbol_reader_seek_time(r, t0 + 6500000000LL) == 0);
+    assert(dsd_symbol_reader_next_dibit(r) == 2);
+    c = dsd_symbol_reader_chunk(r);
+    assert(c->wall_unix_ns == t0 + 6000000000LL);
+    assert(c->symbol_offset == 6 * 4800);
+    assert(dsd_symbol_reader_count(r) == 6 * 4800 + 1);
+
+    /* Before the start selects the first chunk. */
+    assert(dsd_symbol_reader_seek_time(r, 0) == 0);
+    assert(dsd_symbol_reader_next_dibit(r) == 0);
+
+    /* First sync event, any type and by type. */
+    assert(dsd_symbol_reader_seek_sync(r, -1, 0) == 0);
+    assert(dsd_symbol_reader_next_dibit(r) == 0);
+    assert(dsd_symbol_reader_chunk(r)->symbol_offset == 4 * 4800);
+    assert(dsd_symbol_reader_seek_sync(r, 7, t0 + 5000000000LL) == 0);
+    assert(dsd_symbol_reader_chunk(r) == NULL);
+    assert(dsd_symbol_reader_next_dibit(r) == 1);
+    c = dsd_symbol_reader_chunk(r);
+    assert(c->symbol_offset == 5 * 4800);
+    assert(c->byte_offset == DSD_SYMBOL_FILE_HEADER_SIZE + 5 * (DSD_SYMBOL_INDEX_RECORD_SIZE + 4800));
+    assert(c->freq_hz == 851000000);
+
+    /* Failed seek leaves the position alone. */
+    assert(dsd_symbol_reader_seek_sync(r, 9, 0) == -1);
+    assert(dsd_symbol_reader_next_dibit(r) == 1);
+    assert(dsd_symbol_reader_count(r) == 5 * 4800 + 2);
+
+    dsd_symbol_reader_free(r);
+    free(back);
+    free(big);
+    fclose(f);
+}
+
+static void
+test_float_stream(void) {
+    FILE* f = tmpfile();
+    assert(f != NULL);
+    float vals[5] = {0.1f, -0.2f, 0.3f, -0.4f, 0.5f};
+    fwrite(vals, sizeof(float), 5, f);
+    fputc(0x55, f); /* trailing partial float is dropped */
+    rewind(f);
+
+    dsd_symbol_reader* r = dsd_symbol_reader_attach(f, DSD_SYMBOL_FMT_FLOAT32);
+    float out[8];
+    assert(dsd_symbol_reader_header(r) == NULL);
+    assert(dsd_symbol_reader_read_floats(r, out, 2) == 2);
+    assert(dsd_symbol_reader_read_floats(r, out + 2, 8) == 3);
+    assert(memcmp(vals, out, sizeof vals) == 0);
+    assert(dsd_symbol_reader_read_floats(r, out, 1) == 0);
+    dsd_symbol_reader_free(r);
+    fclose(f);
+}
+
+/* opts/state bindings: header written on begin, legacy-style puts, replay through the state binding. */
+static void
+test_state_bindings(void) {
+    dsd_opts* opts = calloc(1, sizeof(*opts));
+    dsd_state* st = calloc(1, sizeof(*st));
+    assert(opts && st);
+    st->samplesPerSymbol = 10;
+    st->rf_mod = 0;
+
+    dsd_symbol_out_put(opts, st, 1); /* capture off: no-op */
+    opts->symbol_out_f = tmpfile();
+    assert(opts->symbol_out_f != NULL);
+    dsd_symbol_out_begin(opts, st);
+    for (int i = 0; i < 1000; i++) {
+        dsd_symbol_out_put(opts, st, i & 3);
+    }
+    dsd_symbol_out_end(st);
+    assert(ftell(opts->symbol_out_f) == DSD_SYMBOL_FILE_HEADER_SIZE + DSD_SYMBOL_INDEX_RECORD_SIZE + 1000);
+
+    rewind(opts->symbol_out_f);
+    opts->symbolfile = opts->symbol_out_f;
+    opts->symbol_out_f = NULL;
+    for (int i = 0; i < 1000; i++) {
+        assert(dsd_symbol_in_dibit(opts, st) == (i & 3));
+    }
+    assert(dsd_symbol_in_dibit(opts, st) == -1);
+
+    /* A reopened file at the same FILE* address gets a fresh reader (header consumed again). */
+    rewind(opts->symbolfile);
+    opts->symbolfile_gen++;
+    for (int i = 0; i < 4; i++) {
+        assert(dsd_symbol_in_dibit(opts, st) == (i & 3));
+    }
+    dsd_symbol_in_close(opts);
+    assert(opts->symbolfile == NULL);
+    assert(dsd_symbol_in_dibit(opts, st) == -1);
+
+    /* Legacy switch: raw dibits, no header or index. */
+    setenv("DSD_NEO_SYMBOL_LEGACY", "1", 1);
+    dsd_neo_config_init(NULL);
+    opts->symbol_out_f = tmpfile();
+    assert(opts->symbol_out_f != NULL);
+    dsd_symbol_out_begin(opts, st);
+    for (int i = 0; i < 1000; i++) {
+        dsd_symbol_out_put(opts, st, i & 3);
+    }
+    dsd_symbol_out_end(st);
+    assert(ftell(opts->symbol_out_f) == 1000);
+    rewind(opts->symbol_out_f);
+    for (int i = 0; i < 1000; i++) {
+        assert(fgetc(opts->symbol_out_f) == (i & 3));
+    }
+    fclose(opts->symbol_out_f);
+    opts->symbol_out_f = NULL;
+    unsetenv("DSD_NEO_SYMBOL_LEGACY");
+    dsd_neo_config_init(NULL);
+
+    dsd_state_ext_free_all(st);
+    free(st);
+    free(opts);
+}
+
+int
+main(void) {
+    test_header_round_trip();
+    test_dibit_stream();
+    test_indexed_stream();
+    test_float_stream();
+    test_state_bindings();
+    return 0;
+}
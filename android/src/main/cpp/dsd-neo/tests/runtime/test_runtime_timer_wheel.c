@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Timing wheel: tick rounding, already-due timers, re-arm and cancel,
+ * periodic timers re-armed from their callback, cancellation from another
+ * callback, deadlines on the upper levels and past the wheel span, and a
+ * randomized run against the expected fire times. Trunk timers: arm,
+ * pending, run, cancel and re-arming from a handler.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <dsd-neo/core/dsd_time.h>
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/runtime/timer_wheel.h>
+#include <dsd-neo/runtime/trunk_timers.h>
+
+#define T0 1000000ULL
+
+typedef struct {
+    dsd_timer_wheel* w;
+    dsd_timer* other;
+    uint64_t deadline;
+    uint64_t period;
+    uint64_t floor_ms; /* must fire after this */
+    int fired;
+} probe;
+
+static uint64_t g_now;
+
+static void
+on_fire(dsd_timer* t, void* user) {
+    probe* p = (probe*)user;
+    assert(g_now >= p->deadline);
+    assert(p->deadline > p->floor_ms);
+    p->fired++;
+    if (p->other) {
+        dsd_timer_cancel(p->w, p->other);
+    }
+    if (p->period) {
+        p->deadline += p->period;
+        dsd_timer_arm(p->w, t, p->deadline);
+    }
+}
+
+static int
+advance(dsd_timer_wheel* w, uint64_t now) {
+    g_now = now;
+    return dsd_timer_wheel_advance(w, now);
+}
+
+static void
+test_basic(void) {
+    dsd_timer_wheel w;
+    dsd_timer_wheel_init(&w, 10, T0);
+    probe a = {&w, NULL, T0 + 50, 0, 0, 0};
+    probe b = {&w, NULL, T0 + 25, 0, 0, 0};
+    dsd_timer ta;
+    dsd_timer tb;
+    dsd_timer_init(&ta, on_fire, &a);
+    dsd_timer_init(&tb, on_fire, &b);
+    dsd_timer_arm(&w, &ta, a.deadline);
+    dsd_timer_arm(&w, &tb, b.deadline);
+    assert(dsd_timer_pending(&ta) && dsd_timer_pending(&tb));
+
+    uint64_t next = 0;
+    int have = dsd_timer_wheel_next_expiry(&w, &next);
+    assert(have == 1 && next == T0 + 30); /* rounded up to the tick */
+
+    int n = advance(&w, T0 + 20);
+    assert(n == 0);
+    n = advance(&w, T0 + 30);
+    assert(n == 1 && b.fired == 1 && a.fired == 0);
+    assert(!dsd_timer_pending(&tb));
+    n = advance(&w, T0 + 49);
+    assert(n == 0);
+    n = advance(&w, T0 + 50);
+    assert(n == 1 && a.fired == 1);
+    have = dsd_timer_wheel_next_expiry(&w, NULL);
+    assert(have == 0);
+
+    /* Already due: fires on the next advance even without time moving. */
+    dsd_timer_arm(&w, &ta, T0);
+    a.deadline = T0;
+    n = advance(&w, T0 + 50);
+    assert(n == 1 && a.fired == 2);
+
+    /* Re-arm moves, cancel removes. */
+    dsd_timer_arm(&w, &ta, T0 + 100);
+    dsd_timer_arm(&w, &ta, T0 + 200);
+    a.deadline = T0 + 200;
+    n = advance(&w, T0 + 150);
+    assert(n == 0);
+    dsd_timer_cancel(&w, &ta);
+    dsd_timer_cancel(&w, &ta);
+    assert(!dsd_timer_pending(&ta));
+    n = advance(&w, T0 + 300);
+    assert(n == 0);
+    (void)n;
+    (void)have;
+}
+
+static void
+test_periodic_and_cancel_in_callback(void) {
+    dsd_timer_wheel w;
+    dsd_timer_wheel_init(&w, 10, T0);
+    probe p = {&w, NULL, T0 + 100, 100, 0, 0};
+    dsd_timer t;
+    dsd_timer_init(&t, on_fire, &p);
+    dsd_timer_arm(&w, &t, p.deadline);
+    /* One catch-up advance runs every period that elapsed. */
+    int n = advance(&w, T0 + 1000);
+    assert(n == 10 && p.fired == 10 && dsd_timer_pending(&t));
+    dsd_timer_cancel(&w, &t);
+
+    /* Two timers due together: the first cancels the second. */
+    probe second = {&w, NULL, T0 + 1500, 0, 0, 0};
+    dsd_timer t2;
+    dsd_timer_init(&t2, on_fire, &second);
+    probe first = {&w, &t2, T0 + 1500, 0, 0, 0};
+    dsd_timer t1;
+    dsd_timer_init(&t1, on_fire, &first);
+    dsd_timer_arm(&w, &t2, T0 + 1500);
+    dsd_timer_arm(&w, &t1, T0 + 1500);
+    n = advance(&w, T0 + 2000);
+    assert(n == 1 && first.fired == 1 && second.fired == 0 && !dsd_timer_pending(&t2));
+    (void)n;
+}
+
+static void
+test_long_range(void) {
+    dsd_timer_wheel w;
+    dsd_timer_wheel_init(&w, 10, T0);
+    const uint64_t min45 = 45ULL * 60 * 1000;
+    const uint64_t hours50 = 50ULL * 3600 * 1000; /* beyond the wheel span */
+    probe a = {&w, NULL, T0 + min45, 0, 0, 0};
+    probe b = {&w, NULL, T0 + hours50, 0, 0, 0};
+    dsd_timer ta;
+    dsd_timer tb;
+    dsd_timer_init(&ta, on_fire, &a);
+    dsd_timer_init(&tb, on_fire, &b);
+    dsd_timer_arm(&w, &ta, a.deadline);
+    dsd_timer_arm(&w, &tb, b.deadline);
+
+    uint64_t next = 0;
+    int have = dsd_timer_wheel_next_expiry(&w, &next);
+    assert(have == 1 && next == a.deadline);
+    int n = advance(&w, a.deadline - 10);
+    assert(n == 0);
+    n = advance(&w, a.deadline);
+    assert(n == 1 && a.fired == 1);
+    have = dsd_timer_wheel_next_expiry(&w, &next);
+    assert(have == 1 && next == b.deadline);
+    n = advance(&w, b.deadline - 3600 * 1000);
+    assert(n == 0);
+    n = advance(&w, b.deadline - 10);
+    assert(n == 0);
+    n = advance(&w, b.deadline);
+    assert(n == 1 && b.fired == 1);
+    (void)n;
+    (void)have;
+}
+
+static void
+test_random_against_reference(void) {
+    enum { N = 300 };
+    dsd_timer_wheel w;
+    dsd_timer_wheel_init(&w, 10, T0);
+    static probe p[N];
+    static dsd_timer t[N];
+    srand(12345);
+    for (int i = 0; i < N; i++) {
+        uint64_t d = (uint64_t)(rand() % 5000) * 1000u + (uint64_t)(rand() % 1000);
+        p[i] = (probe){&w, NULL, T0 + ((d + 9u) / 10u) * 10u, 0, 0, 0};
+        dsd_timer_init(&t[i], on_fire, &p[i]);
+        dsd_timer_arm(&w, &t[i], p[i].deadline);
+    }
+    uint64_t now = T0;
+    int total = 0;
+    while (total < N) {
+        uint64_t next = 0;
+        int have = dsd_timer_wheel_next_expiry(&w, &next);
+        assert(have == 1);
+        (void)have;
+        for (int i = 0; i < N; i++) {
+            /* nothing unfired is earlier than the reported next expiry */
+            assert(p[i].fired || p[i].deadline >= next);
+        }
+        for (int i = 0; i < N; i++) {
+            p[i].floor_ms = now;
+        }
+        now += (uint64_t)(rand() % 200000);
+        total += advance(&w, now);
+        for (int i = 0; i < N; i++) {
+            if ((p[i].deadline <= now) != (p[i].fired == 1)) {
+                fprintf(stderr, "timer %d: deadline %llu now %llu fired %d\n", i, (unsigned long long)p[i].deadline,
+                        (unsigned long long)now, p[i].fired);
+                exit(1);
+            }
+        }
+    }
+    assert(w.count == 0);
+    for (int i = 0; i < N; i++) {
+        if (p[i].fired != 1) {
+            fprintf(stderr, "timer %d fired %d times\n", i, p[i].fired);
+            exit(1);
+        }
+    }
+}
+
+static int g_jobs;
+
+static void
+job(dsd_opts* opts, dsd_state* state) {
+    (void)opts;
+    (void)state;
+    g_jobs++;
+}
+
+static void
+job_rearm(dsd_opts* opts, dsd_state* state) {
+    job(opts, state);
+    dsd_trunk_timer_arm(state, DSD_TRUNK_TIMER_P25_GA, dsd_time_now_monotonic_s() - 1.0, job);
+}
+
+static void
+test_trunk_timers(void) {
+    dsd_state* st = calloc(1, sizeof(*st));
+    assert(st != NULL);
+    int n = dsd_trunk_timers_run(NULL, st);
+    assert(n == 0);
+    int rc = dsd_trunk_timer_arm(st, DSD_TRUNK_TIMER_COUNT, 1.0, job);
+    assert(rc == -1);
+
+    double now = dsd_time_now_monotonic_s();
+    double due = 0.0;
+    rc = dsd_trunk_timer_arm(st, DSD_TRUNK_TIMER_P25_AFF, now - 1.0, job);
+    assert(rc == 0);
+    rc = dsd_trunk_timer_arm(st, DSD_TRUNK_TIMER_DMR_SM, now + 3600.0, job);
+    assert(rc == 0);
+    int armed = dsd_trunk_timer_pending(st, DSD_TRUNK_TIMER_DMR_SM, &due);
+    assert(armed == 1 && due == now + 3600.0);
+
+    g_jobs = 0;
+    n = dsd_trunk_timers_run(NULL, st);
+    assert(n == 1 && g_jobs == 1);
+    armed = dsd_trunk_timer_pending(st, DSD_TRUNK_TIMER_P25_AFF, NULL);
+    assert(armed == 0);
+    n = dsd_trunk_timers_run(NULL, st);
+    assert(n == 0);
+
+    dsd_trunk_timer_cancel(st, DSD_TRUNK_TIMER_DMR_SM);
+    armed = dsd_trunk_timer_pending(st, DSD_TRUNK_TIMER_DMR_SM, NULL);
+    assert(armed == 0);
+
+    /* A handler may arm another job; it runs on the following pass. */
+    rc = dsd_trunk_timer_arm(st, DSD_TRUNK_TIMER_P25_SM, now - 1.0, job_rearm);
+    assert(rc == 0);
+    n = dsd_trunk_timers_run(NULL, st);
+    assert(n == 1 && g_jobs == 2);
+    armed = dsd_trunk_timer_pending(st, DSD_TRUNK_TIMER_P25_GA, NULL);
+    assert(armed == 1);
+    n = dsd_trunk_timers_run(NULL, st);
+    assert(n == 1 && g_jobs == 3);
+    (void)n;
+    (void)rc;
+    (void)armed;
+
+    dsd_state_ext_free_all(st);
+    free(st);
+}
+
+int
+main(void) {
+    test_basic();
+    test_periodic_and_cancel_in_callback();
+    test_long_range();
+    test_random_against_reference();
+    test_trunk_timers();
+    return 0;
+}
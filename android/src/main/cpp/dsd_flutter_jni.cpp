@@ -1,6 +1,7 @@
 #include <jni.h>
 #include <android/log.h>
 #include <string>
+#include <atomic>
 #include <pthread.h>
 #include <cstdio>
 #include <unistd.h>
@@ -22,6 +23,8 @@ extern "C" {
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/engine/engine.h>
+#include <dsd-neo/io/rtl_device.h>
+#include <dsd-neo/runtime/decoder_events.h>
 #include <dsd-neo/runtime/exitflag.h>
 // Forward declare to avoid C++ incompatibility with headers
 void p25_sm_init(dsd_opts* opts, dsd_state* state);
@@ -33,7 +36,6 @@ int dsd_rtl_stream_tune(dsd_opts* opts, long int frequency);
 #ifdef NATIVE_RTLSDR_ENABLED
 #include <rtl-sdr.h>
 #include <rtl-sdr-android.h>
-#include <dsd-neo/io/rtl_device.h>
 #include <dsd-neo/io/rtl_stream_c.h>
 #endif
 
@@ -43,14 +45,9 @@ static dsd_state* g_state = nullptr;
 static JavaVM* g_jvm = nullptr;
 static pthread_t g_engine_thread;
 static pthread_t g_stderr_thread;
-static pthread_t g_poll_thread;
 static bool g_engine_running = false;
 static int g_stderr_pipe[2] = {-1, -1};
-static pthread_t g_hackrf_tcp_server_thread;
-static int g_hackrf_tcp_server_sock = -1;
-static int g_hackrf_tcp_client_sock = -1;
-static bool g_hackrf_tcp_server_running = false;
-static bool g_hackrf_mode = false;
+static std::atomic<bool> g_hackrf_mode{false};
 static jclass g_plugin_class = nullptr;
 static jmethodID g_send_output_method = nullptr;
 static jmethodID g_send_call_event_method = nullptr;
@@ -61,41 +58,23 @@ static jmethodID g_send_patch_event_method = nullptr;
 static jmethodID g_send_ga_event_method = nullptr;
 static jmethodID g_send_aff_event_method = nullptr;
 
-// Last known call state for change detection
-static int g_last_tg = 0;
-static int g_last_src = 0;
-
-// Last known signal state for change detection
-static unsigned int g_last_tsbk_ok = 0;
-static unsigned int g_last_tsbk_err = 0;
-static int g_last_synctype = -1;
-static int g_last_carrier = 0;
-
-// Last known network state for change detection
-static int g_last_nb_count = 0;
-static int g_last_patch_count = 0;
-static int g_last_ga_count = 0;
-static int g_last_aff_count = 0;
+// Talkgroup of the active call per TDMA slot as last reported by the decoder
+// (0 when idle); FDMA protocols only use slot 0
+static std::atomic<int> g_slot_tg[2] = {{0}, {0}};
 
 // ============================================================================
 // Talkgroup Filtering (Whitelist/Blacklist)
 // ============================================================================
 
-#include <set>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
-#include <atomic>
-
-enum FilterMode {
-    FILTER_MODE_DISABLED = 0,  // No filtering - hear all calls
-    FILTER_MODE_WHITELIST = 1, // Only hear whitelisted talkgroups
-    FILTER_MODE_BLACKLIST = 2  // Hear all except blacklisted talkgroups
-};
 
-static FilterMode g_filter_mode = FILTER_MODE_DISABLED;
-static std::set<int> g_filter_talkgroups;
-static std::mutex g_filter_mutex;
-static bool g_audio_enabled_by_user = true;  // Track user's audio preference
-static bool g_audio_muted_by_filter = false; // Track if filter muted audio
+// Filter mode/list live in dsd-neo (dsd_tg_filter_*) so the P25 trunk SM can
+// skip filtered grants; modes map 1:1 (0=disabled, 1=whitelist, 2=blacklist).
+static std::atomic<bool> g_audio_enabled_by_user{true};  // Track user's audio preference
+static std::atomic<bool> g_audio_muted_by_filter{false}; // Track if filter muted audio
+static std::atomic<bool> g_slot_filtered[2] = {{false}, {false}}; // Active call on slot rejected by filter
 
 // Custom DSD command arguments
 static std::string g_custom_args;
@@ -104,55 +83,49 @@ static std::mutex g_custom_args_mutex;
 // Retune freeze - temporarily block auto-retunes during system switch
 static std::atomic<bool> g_retune_freeze{false};
 
-// Check if a talkgroup should be heard based on filter settings
-static bool should_hear_talkgroup(int tg) {
-    std::lock_guard<std::mutex> lock(g_filter_mutex);
-    
-    if (g_filter_mode == FILTER_MODE_DISABLED) {
-        return true;
-    }
-    
-    bool in_list = g_filter_talkgroups.find(tg) != g_filter_talkgroups.end();
-    
-    if (g_filter_mode == FILTER_MODE_WHITELIST) {
-        return in_list;  // Only hear if in whitelist
-    } else { // FILTER_MODE_BLACKLIST
-        return !in_list; // Hear unless in blacklist
-    }
-}
-
-// Update audio output state based on filter
-static void update_audio_for_talkgroup(int tg) {
+// Audio output is a single switch: keep it muted while any slot carries a
+// filtered call, and restore it once none does
+static void apply_filter_mute() {
     if (!g_opts) return;
     
-    bool should_hear = should_hear_talkgroup(tg);
-    
-    if (should_hear && g_audio_enabled_by_user) {
-        if (g_audio_muted_by_filter) {
-            g_opts->audio_out = 1;
-            g_audio_muted_by_filter = false;
-            LOGI("Audio unmuted for TG %d", tg);
-        }
-    } else if (!should_hear) {
+    if (g_slot_filtered[0] || g_slot_filtered[1]) {
         if (!g_audio_muted_by_filter && g_opts->audio_out) {
             g_opts->audio_out = 0;
             g_audio_muted_by_filter = true;
-            LOGI("Audio muted for filtered TG %d", tg);
+            LOGI("Audio muted for filtered TG (slot1=%d slot2=%d)", g_slot_tg[0].load(), g_slot_tg[1].load());
+        }
+    } else if (g_audio_muted_by_filter) {
+        g_audio_muted_by_filter = false;
+        if (g_audio_enabled_by_user) {
+            g_opts->audio_out = 1;
+            LOGI("Audio restored, no filtered call active");
         }
     }
 }
 
-// Public function to check if voice channel should be followed for a talkgroup
-// Used by DSD-neo to skip voice channel grants for filtered talkgroups
-extern "C" int dsd_flutter_should_follow_tg(int tg) {
-    return should_hear_talkgroup(tg) ? 1 : 0;
+// Record the call on `slot` (tg 0 = slot idle) and update muting for it
+static void update_audio_for_call(int slot, int tg) {
+    g_slot_tg[slot] = tg;
+    g_slot_filtered[slot] = tg != 0 && dsd_tg_filter_allows(tg) == 0;
+    apply_filter_mute();
+}
+
+// Re-check the active calls against a changed filter
+static void refresh_filter_mute() {
+    for (int slot = 0; slot < 2; slot++) {
+        int tg = g_slot_tg[slot];
+        g_slot_filtered[slot] = tg != 0 && dsd_tg_filter_allows(tg) == 0;
+    }
+    apply_filter_mute();
 }
 
-// Last known site state for change detection
-static unsigned long long g_last_wacn = 0;
-static unsigned long long g_last_siteid = 0;
-static unsigned long long g_last_rfssid = 0;
-static int g_last_nac = 0;
+// Forget active calls (engine start/init)
+static void reset_call_tracking() {
+    for (int slot = 0; slot < 2; slot++) {
+        g_slot_tg[slot] = 0;
+        g_slot_filtered[slot] = false;
+    }
+}
 
 // Helper function to sanitize string for UTF-8 conversion
 // Replaces invalid UTF-8 bytes with '?' to prevent JNI crashes
@@ -695,268 +668,311 @@ static void send_aff_event_to_flutter(
     }
 }
 
-// Poll thread - checks state for call and site changes
-static void* poll_thread_func(void* arg) {
-    LOGI("Poll thread started");
-    
-    while (g_engine_running && g_state) {
-        // Check for call state changes
-        // For DMR TDMA: slot 1 uses lasttg/lastsrc, slot 2 uses lasttgR/lastsrcR
-        int tg = g_state->lasttg;
-        int src = g_state->lastsrc;
-        int tgR = g_state->lasttgR;
-        int srcR = g_state->lastsrcR;
-        int nac = g_state->nac;
-        int slot = g_state->currentslot;
-        int synctype = g_state->synctype;
-        
-        // For DMR, check both slots and use whichever has activity
-        // Slot numbers appear to be 0-indexed (0=TS1, 1=TS2)
-        // lasttgR/lastsrcR are for timeslot 2 regardless of currentslot value
-        if (DSD_SYNC_IS_DMR(synctype)) {
-            // Prioritize TS2 (R fields) if they have data
-            if (tgR != 0 || srcR != 0) {
-                tg = tgR;
-                src = srcR;
+static const char* protocol_name(int synctype) {
+    if (DSD_SYNC_IS_DMR(synctype)) {
+        return "DMR";
+    }
+    if (DSD_SYNC_IS_P25P1(synctype)) {
+        return "P25 Phase 1";
+    }
+    if (DSD_SYNC_IS_P25P2(synctype)) {
+        return "P25 Phase 2";
+    }
+    if (DSD_SYNC_IS_P25(synctype)) {
+        return "P25";
+    }
+    if (DSD_SYNC_IS_NXDN(synctype)) {
+        return "NXDN";
+    }
+    if (DSD_SYNC_IS_DPMR(synctype)) {
+        return "dPMR";
+    }
+    if (DSD_SYNC_IS_PROVOICE(synctype)) {
+        return "ProVoice";
+    }
+    if (DSD_SYNC_IS_EDACS(synctype)) {
+        return "EDACS";
+    }
+    if (DSD_SYNC_IS_YSF(synctype)) {
+        return "YSF";
+    }
+    if (DSD_SYNC_IS_M17(synctype)) {
+        return "M17";
+    }
+    return DSD_SYNC_IS_DSTAR(synctype) ? "D-STAR" : "";
+}
+
+// ============================================================================
+// Decoder Event Delivery
+// ============================================================================
+
+// Decoder callbacks run on the engine thread and must not block, so they only
+// copy what Flutter needs into a queued event; a delivery thread attached to
+// the JVM makes the JNI calls. Signal and table events only matter in their
+// latest form, so a newer one replaces a queued one of the same kind.
+
+// The affiliation registries hold up to 16K/32K entries; Flutter only lists
+// the newest, so each table event carries a bounded most-recent slice.
+#define REGISTRY_EVENT_MAX 64
+#define EVENT_QUEUE_MAX 256
+
+struct queued_event {
+    dsd_decoder_event_kind kind;
+    union {
+        struct {
+            dsd_call_event call;
+            const char* protocol;
+        } call;
+        dsd_site_event site;
+        dsd_signal_event signal;
+        struct {
+            int count;
+            long int freq[32];
+            time_t last_seen[32];
+        } nb;
+        struct {
+            int count;
+            uint16_t sgid[8];
+            uint8_t is_patch[8];
+            uint8_t active[8];
+            time_t last_update[8];
+            uint8_t wgid_count[8];
+            uint16_t wgid[8][8];
+            uint8_t wuid_count[8];
+            uint32_t wuid[8][8];
+            uint16_t key[8];
+            uint8_t alg[8];
+            uint8_t key_valid[8];
+        } patch;
+        struct {
+            int count;
+            uint32_t rid[REGISTRY_EVENT_MAX];
+            uint16_t tg[REGISTRY_EVENT_MAX];
+            time_t last_seen[REGISTRY_EVENT_MAX];
+        } reg;
+    } u;
+};
+
+static std::mutex g_event_mutex;
+static std::condition_variable g_event_cv;
+static std::deque<queued_event> g_event_queue;
+static bool g_event_stop = false;
+static pthread_t g_event_thread;
+static bool g_event_thread_running = false;
+static unsigned long g_event_dropped = 0;
+
+static void copy_recent(const dsd_unit_registry* reg, queued_event* q) {
+    int idx[REGISTRY_EVENT_MAX];
+    int n = dsd_unit_registry_recent(reg, idx, REGISTRY_EVENT_MAX);
+    for (int i = 0; i < n; i++) {
+        q->u.reg.rid[i] = reg->rid[idx[i]];
+        q->u.reg.tg[i] = reg->tg[idx[i]];
+        q->u.reg.last_seen[i] = reg->last_seen[idx[i]];
+    }
+    q->u.reg.count = n;
+}
+
+static void copy_patches(const dsd_state* st, queued_event* q) {
+    int n = st->p25_patch_count < 0 ? 0 : (st->p25_patch_count > 8 ? 8 : st->p25_patch_count);
+    q->u.patch.count = n;
+    memcpy(q->u.patch.sgid, st->p25_patch_sgid, sizeof(q->u.patch.sgid));
+    memcpy(q->u.patch.is_patch, st->p25_patch_is_patch, sizeof(q->u.patch.is_patch));
+    memcpy(q->u.patch.active, st->p25_patch_active, sizeof(q->u.patch.active));
+    memcpy(q->u.patch.last_update, st->p25_patch_last_update, sizeof(q->u.patch.last_update));
+    memcpy(q->u.patch.wgid_count, st->p25_patch_wgid_count, sizeof(q->u.patch.wgid_count));
+    memcpy(q->u.patch.wgid, st->p25_patch_wgid, sizeof(q->u.patch.wgid));
+    memcpy(q->u.patch.wuid_count, st->p25_patch_wuid_count, sizeof(q->u.patch.wuid_count));
+    memcpy(q->u.patch.wuid, st->p25_patch_wuid, sizeof(q->u.patch.wuid));
+    memcpy(q->u.patch.key, st->p25_patch_key, sizeof(q->u.patch.key));
+    memcpy(q->u.patch.alg, st->p25_patch_alg, sizeof(q->u.patch.alg));
+    memcpy(q->u.patch.key_valid, st->p25_patch_key_valid, sizeof(q->u.patch.key_valid));
+}
+
+static void enqueue_event(const queued_event& q) {
+    {
+        std::lock_guard<std::mutex> lock(g_event_mutex);
+        if (q.kind != DSD_EVENT_CALL && q.kind != DSD_EVENT_SITE) {
+            for (queued_event& pending : g_event_queue) {
+                if (pending.kind == q.kind) {
+                    pending = q;
+                    return;
+                }
             }
-            // Otherwise use TS1 if it has data (tg/src already set)
         }
-        
-        // Debug: Log state values periodically (every 100 iterations to avoid spam)
-        static int debug_counter = 0;
-        if (++debug_counter >= 100) {
-            debug_counter = 0;
-            LOGI("Poll: tg=%d src=%d tgR=%d srcR=%d synctype=%d slot=%d DMR=%d P25=%d",
-                 tg, src, tgR, srcR, synctype, slot, 
-                 DSD_SYNC_IS_DMR(synctype), DSD_SYNC_IS_P25(synctype));
+        if (g_event_queue.size() >= EVENT_QUEUE_MAX) {
+            // Flutter has stopped draining; drop rather than stall the decoder
+            g_event_dropped++;
+            return;
         }
-        
-        // Detect call changes
-        if (tg != g_last_tg || src != g_last_src) {
-            if (tg != 0 || src != 0) {
-                // New or updated call - apply talkgroup filter
-                update_audio_for_talkgroup(tg);
-                
-                // New or updated call
-                const char* callType = "Group";
-                if (g_state->gi[0] == 1) {
-                    callType = "Private";
-                }
-                
-                bool isEncrypted = false;
-                bool isEmergency = g_state->p25_call_emergency[0] != 0;
-                
-                // Determine protocol from synctype
-                const char* algName = "";
-                if (DSD_SYNC_IS_DMR(synctype)) {
-                    algName = "DMR";
-                } else if (DSD_SYNC_IS_P25(synctype)) {
-                    if (DSD_SYNC_IS_P25P1(synctype)) {
-                        algName = "P25 Phase 1";
-                    } else if (DSD_SYNC_IS_P25P2(synctype)) {
-                        algName = "P25 Phase 2";
-                    } else {
-                        algName = "P25";
-                    }
-                }
-                
-                // Get group/source names from call_string if available
-                const char* groupName = "";
-                const char* sourceName = "";
-                
-                int eventType = (g_last_tg == 0 && g_last_src == 0) ? 0 : 1; // 0=start, 1=update
-                
-                // Add isFiltered flag to indicate if audio is muted
-                bool isFiltered = !should_hear_talkgroup(tg);
-                
-                LOGI("Call event: type=%d tg=%d src=%d nac=0x%X slot=%d protocol=%s filtered=%d", 
-                     eventType, tg, src, nac, slot, algName, isFiltered);
-                
-                send_call_event_to_flutter(
-                    eventType,
-                    tg,
-                    src,
-                    nac,
-                    callType,
-                    isEncrypted,
-                    isEmergency,
-                    algName,  // Now includes DMR/P25
-                    slot,
-                    0.0, // frequency
-                    "",  // system name
-                    groupName,
-                    sourceName
-                );
-            } else if (g_last_tg != 0 || g_last_src != 0) {
-                // Call ended - restore audio if it was muted by filter
-                if (g_audio_muted_by_filter && g_audio_enabled_by_user && g_opts) {
-                    g_opts->audio_out = 1;
-                    g_audio_muted_by_filter = false;
-                    LOGI("Audio restored after filtered call ended");
-                }
-                
-                // Determine protocol from synctype for call end event
-                const char* algName = "";
-                if (DSD_SYNC_IS_DMR(synctype)) {
-                    algName = "DMR";
-                } else if (DSD_SYNC_IS_P25(synctype)) {
-                    if (DSD_SYNC_IS_P25P1(synctype)) {
-                        algName = "P25 Phase 1";
-                    } else if (DSD_SYNC_IS_P25P2(synctype)) {
-                        algName = "P25 Phase 2";
-                    } else {
-                        algName = "P25";
-                    }
-                }
-                
-                // Call ended
-                LOGI("Call ended: was tg=%d src=%d protocol=%s", g_last_tg, g_last_src, algName);
-                send_call_event_to_flutter(
-                    2,  // call_end
-                    g_last_tg,
-                    g_last_src,
-                    nac,
-                    "Group",
-                    false,
-                    false,
-                    algName,
-                    slot,
-                    0.0,
-                    "",
-                    "",
-                    ""
-                );
-            }
-            
-            g_last_tg = tg;
-            g_last_src = src;
+        g_event_queue.push_back(q);
+    }
+    g_event_cv.notify_one();
+}
+
+// Decoder event subscriber - runs on the engine thread right after the state
+// changes, so the copies below are consistent with the event.
+static void on_decoder_event(const dsd_decoder_event* ev, void* user) {
+    (void)user;
+    const dsd_state* st = ev->state;
+    queued_event q;
+    q.kind = ev->kind;
+    
+    switch (ev->kind) {
+        case DSD_EVENT_CALL: {
+            const dsd_call_event& c = ev->u.call;
+            // Audio muting follows the filter immediately; only the Flutter
+            // notification is deferred.
+            update_audio_for_call(c.slot ? 1 : 0, c.phase == DSD_CALL_END ? 0 : c.tg);
+            q.u.call.call = c;
+            q.u.call.protocol = protocol_name(c.synctype);
+            break;
         }
-        
-        // Check for site detail changes
-        unsigned long long wacn = g_state->p2_wacn;
-        unsigned long long siteid = g_state->p2_siteid;
-        unsigned long long rfssid = g_state->p2_rfssid;
-        
-        if (wacn != g_last_wacn || siteid != g_last_siteid || 
-            rfssid != g_last_rfssid || nac != g_last_nac) {
-            
-            if (wacn != 0 || siteid != 0 || rfssid != 0) {
-                LOGI("Site details: WACN=0x%llX Site=0x%llX RFSS=0x%llX NAC=0x%X",
-                     wacn, siteid, rfssid, nac);
-                
-                send_site_event_to_flutter(
-                    wacn,
-                    siteid,
-                    rfssid,
-                    0,  // systemId (can add if needed)
-                    nac
-                );
+        case DSD_EVENT_SITE:
+            q.u.site = ev->u.site;
+            break;
+        case DSD_EVENT_SIGNAL:
+            q.u.signal = ev->u.signal;
+            break;
+        case DSD_EVENT_NEIGHBOR: {
+            int n = st->p25_nb_count < 0 ? 0 : (st->p25_nb_count > 32 ? 32 : st->p25_nb_count);
+            q.u.nb.count = n;
+            memcpy(q.u.nb.freq, st->p25_nb_freq, sizeof(q.u.nb.freq));
+            memcpy(q.u.nb.last_seen, st->p25_nb_last_seen, sizeof(q.u.nb.last_seen));
+            break;
+        }
+        case DSD_EVENT_PATCH:
+            copy_patches(st, &q);
+            break;
+        case DSD_EVENT_GROUP_ATTACH:
+            copy_recent(&st->p25_ga, &q);
+            break;
+        case DSD_EVENT_AFFILIATION:
+            copy_recent(&st->p25_aff, &q);
+            break;
+        default:
+            return;
+    }
+    enqueue_event(q);
+}
+
+// Make the JNI calls for one queued event (delivery thread)
+static void deliver_event(const queued_event& q) {
+    switch (q.kind) {
+        case DSD_EVENT_CALL: {
+            const dsd_call_event& c = q.u.call.call;
+            if (c.phase == DSD_CALL_END) {
+                LOGI("Call ended: was tg=%d src=%d protocol=%s", c.tg, c.src, q.u.call.protocol);
+                send_call_event_to_flutter(2, c.tg, c.src, c.nac, "Group", false, false, q.u.call.protocol,
+                                           c.slot, 0.0, "", "", "");
+                break;
             }
-            
-            g_last_wacn = wacn;
-            g_last_siteid = siteid;
-            g_last_rfssid = rfssid;
-            g_last_nac = nac;
+            LOGI("Call event: type=%d tg=%d src=%d nac=0x%X slot=%d protocol=%s filtered=%d",
+                 c.phase, c.tg, c.src, c.nac, c.slot, q.u.call.protocol, c.filtered);
+            send_call_event_to_flutter(c.phase, c.tg, c.src, c.nac, c.is_private ? "Private" : "Group",
+                                       false, c.is_emergency != 0, q.u.call.protocol, c.slot, 0.0, "", "", "");
+            break;
         }
-        
-        // Check for signal quality changes (using state fields instead of parsing logs)
-        unsigned int tsbk_ok = g_state->p25_p1_fec_ok;
-        unsigned int tsbk_err = g_state->p25_p1_fec_err;
-        // synctype already declared above
-        int carrier = g_state->carrier;
-        
-        // Send signal updates if metrics changed
-        if (tsbk_ok != g_last_tsbk_ok || tsbk_err != g_last_tsbk_err || 
-            synctype != g_last_synctype || carrier != g_last_carrier) {
-            
-            // Check if we have sync (DMR or P25)
+        case DSD_EVENT_SITE:
+            LOGI("Site details: WACN=0x%llX Site=0x%llX RFSS=0x%llX NAC=0x%X",
+                 (unsigned long long)q.u.site.wacn, (unsigned long long)q.u.site.siteid,
+                 (unsigned long long)q.u.site.rfssid, q.u.site.nac);
+            send_site_event_to_flutter(q.u.site.wacn, q.u.site.siteid, q.u.site.rfssid,
+                                       0,  // systemId (can add if needed)
+                                       q.u.site.nac);
+            break;
+        case DSD_EVENT_SIGNAL: {
+            int synctype = q.u.signal.synctype;
             bool hasSync = DSD_SYNC_IS_DMR(synctype) || DSD_SYNC_IS_P25(synctype);
-            bool hasCarrier = (carrier != 0);
-            
-            send_signal_event_to_flutter(
-                tsbk_ok,
-                tsbk_err,
-                synctype,
-                hasCarrier,
-                hasSync
-            );
-            
-            g_last_tsbk_ok = tsbk_ok;
-            g_last_tsbk_err = tsbk_err;
-            g_last_synctype = synctype;
-            g_last_carrier = carrier;
-        }
-        
-        // Check for neighbor site changes
-        int nb_count = g_state->p25_nb_count;
-        
-        if (nb_count != g_last_nb_count) {
-            send_neighbor_event_to_flutter(
-                nb_count,
-                g_state->p25_nb_freq,
-                g_state->p25_nb_last_seen
-            );
-            
-            g_last_nb_count = nb_count;
+            send_signal_event_to_flutter(q.u.signal.tsbk_ok, q.u.signal.tsbk_err, synctype,
+                                         q.u.signal.carrier != 0, hasSync);
+            break;
         }
-        
-        // Check for patch changes
-        int patch_count = g_state->p25_patch_count;
-        
-        if (patch_count != g_last_patch_count) {
+        case DSD_EVENT_NEIGHBOR:
+            send_neighbor_event_to_flutter(q.u.nb.count, q.u.nb.freq, q.u.nb.last_seen);
+            break;
+        case DSD_EVENT_PATCH:
             send_patch_event_to_flutter(
-                patch_count,
-                g_state->p25_patch_sgid,
-                g_state->p25_patch_is_patch,
-                g_state->p25_patch_active,
-                g_state->p25_patch_last_update,
-                g_state->p25_patch_wgid_count,
-                g_state->p25_patch_wgid,
-                g_state->p25_patch_wuid_count,
-                g_state->p25_patch_wuid,
-                g_state->p25_patch_key,
-                g_state->p25_patch_alg,
-                g_state->p25_patch_key_valid
+                q.u.patch.count,
+                q.u.patch.sgid,
+                q.u.patch.is_patch,
+                q.u.patch.active,
+                q.u.patch.last_update,
+                q.u.patch.wgid_count,
+                q.u.patch.wgid,
+                q.u.patch.wuid_count,
+                q.u.patch.wuid,
+                q.u.patch.key,
+                q.u.patch.alg,
+                q.u.patch.key_valid
             );
-            
-            g_last_patch_count = patch_count;
-        }
-        
-        // Check for group attachment changes
-        int ga_count = g_state->p25_ga_count;
-        
-        if (ga_count != g_last_ga_count) {
-            send_ga_event_to_flutter(
-                ga_count,
-                g_state->p25_ga_rid,
-                g_state->p25_ga_tg,
-                g_state->p25_ga_last_seen
-            );
-            
-            g_last_ga_count = ga_count;
-        }
-        
-        // Check for affiliation changes
-        int aff_count = g_state->p25_aff_count;
-        
-        if (aff_count != g_last_aff_count) {
-            send_aff_event_to_flutter(
-                aff_count,
-                g_state->p25_aff_rid,
-                g_state->p25_aff_last_seen
-            );
-            
-            g_last_aff_count = aff_count;
+            break;
+        case DSD_EVENT_GROUP_ATTACH:
+            send_ga_event_to_flutter(q.u.reg.count, q.u.reg.rid, q.u.reg.tg, q.u.reg.last_seen);
+            break;
+        case DSD_EVENT_AFFILIATION:
+            send_aff_event_to_flutter(q.u.reg.count, q.u.reg.rid, q.u.reg.last_seen);
+            break;
+        default:
+            break;
+    }
+}
+
+// Delivery thread: attached once so the send_*_to_flutter helpers don't
+// attach/detach per event; drains the queue before exiting.
+static void* event_thread_func(void* arg) {
+    (void)arg;
+    JNIEnv* env = nullptr;
+    bool attached = g_jvm && g_jvm->AttachCurrentThread(&env, nullptr) == JNI_OK;
+    
+    std::unique_lock<std::mutex> lock(g_event_mutex);
+    for (;;) {
+        g_event_cv.wait(lock, [] { return g_event_stop || !g_event_queue.empty(); });
+        if (g_event_queue.empty()) {
+            break;
         }
-        
-        // Poll every 100ms
-        usleep(100000);
+        queued_event q = g_event_queue.front();
+        g_event_queue.pop_front();
+        lock.unlock();
+        deliver_event(q);
+        lock.lock();
+    }
+    if (g_event_dropped > 0) {
+        LOGE("Dropped %lu decoder events while Flutter was not draining", g_event_dropped);
+        g_event_dropped = 0;
     }
+    lock.unlock();
     
-    LOGI("Poll thread finished");
+    if (attached) {
+        g_jvm->DetachCurrentThread();
+    }
     return nullptr;
 }
 
+static void start_event_delivery() {
+    {
+        std::lock_guard<std::mutex> lock(g_event_mutex);
+        g_event_stop = false;
+        g_event_queue.clear();
+    }
+    g_event_thread_running = pthread_create(&g_event_thread, nullptr, event_thread_func, nullptr) == 0;
+    if (!g_event_thread_running) {
+        LOGE("Failed to start decoder event thread");
+    }
+}
+
+static void stop_event_delivery() {
+    if (!g_event_thread_running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_event_mutex);
+        g_event_stop = true;
+    }
+    g_event_cv.notify_one();
+    pthread_join(g_event_thread, nullptr);
+    g_event_thread_running = false;
+}
+
 // Thread to redirect stderr to logcat AND Flutter
 static void* stderr_thread_func(void* arg) {
     char buf[512];
@@ -997,8 +1013,18 @@ static void* engine_thread_func(void* arg) {
     LOGI("Engine thread started");
     
     if (g_opts && g_state) {
+        start_event_delivery();
+        dsd_decoder_events_reset(g_state);
+        int sub = dsd_decoder_events_subscribe(DSD_EVENT_MASK_ALL, on_decoder_event, nullptr);
+        if (sub < 0) {
+            LOGE("Failed to subscribe to decoder events");
+        }
         int rc = dsd_engine_run(g_opts, g_state);
         LOGI("Engine exited with code %d", rc);
+        if (sub > 0) {
+            dsd_decoder_events_unsubscribe(sub);
+        }
+        stop_event_delivery();
     }
     
     g_engine_running = false;
@@ -1057,7 +1083,6 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeInit(
         if (g_engine_running) {
             exitflag = 1;
             pthread_join(g_engine_thread, nullptr);
-            pthread_join(g_poll_thread, nullptr);
         }
         if (g_state) {
             freeState(g_state);
@@ -1195,14 +1220,7 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeInit(
     g_opts->rtl_android_usb_path[0] = '\0';
     
     // Reset call tracking
-    g_last_tg = 0;
-    g_last_src = 0;
-    
-    // Reset site tracking
-    g_last_wacn = 0;
-    g_last_siteid = 0;
-    g_last_rfssid = 0;
-    g_last_nac = 0;
+    reset_call_tracking();
     
     LOGI("DSD initialized successfully");
 }
@@ -1235,6 +1253,7 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeConnect(
         snprintf(g_opts->rtltcp_hostname, sizeof(g_opts->rtltcp_hostname), "%s", host_str);
         g_opts->rtltcp_portno = port;
         g_opts->rtltcp_enabled = 1;
+        g_opts->rtl_external_iq = 0;
         g_opts->rtlsdr_center_freq = (uint32_t)freq_hz;
         g_opts->rtl_gain_value = gain;
         g_opts->rtlsdr_ppm_error = ppm;
@@ -1325,8 +1344,7 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStart(
         LOGI("Config: rtl_android_usb_path=%s", g_opts->rtl_android_usb_path);
         
         // Reset call tracking
-        g_last_tg = 0;
-        g_last_src = 0;
+        reset_call_tracking();
         
         exitflag = 0;
         g_engine_running = true;
@@ -1337,14 +1355,6 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStart(
             g_engine_running = false;
         } else {
             LOGI("Engine thread created");
-            
-            // Start poll thread for call events
-            rc = pthread_create(&g_poll_thread, nullptr, poll_thread_func, nullptr);
-            if (rc != 0) {
-                LOGE("Failed to create poll thread: %d", rc);
-            } else {
-                LOGI("Poll thread created");
-            }
         }
     } else {
         LOGE("DSD not initialized");
@@ -1360,10 +1370,9 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStop(
     
     if (g_engine_running) {
         exitflag = 1;
-        g_engine_running = false;  // Signal poll thread to stop
+        g_engine_running = false;
         pthread_join(g_engine_thread, nullptr);
-        pthread_join(g_poll_thread, nullptr);
-        LOGI("Engine threads stopped");
+        LOGI("Engine thread stopped");
         
         // Reset P25 state to prevent retune to old system
         if (g_state) {
@@ -1390,7 +1399,6 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeCleanup(
         exitflag = 1;
         g_engine_running = false;
         pthread_join(g_engine_thread, nullptr);
-        pthread_join(g_poll_thread, nullptr);
     }
     
     if (g_state) {
@@ -1424,7 +1432,7 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeSetAudioEnabled(
         }
         LOGI("Audio output %s (user=%d, filter_muted=%d)", 
              g_opts->audio_out ? "enabled" : "disabled",
-             g_audio_enabled_by_user, g_audio_muted_by_filter);
+             g_audio_enabled_by_user.load(), g_audio_muted_by_filter.load());
     }
 }
 
@@ -1442,19 +1450,14 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeSetFilterMode(
     jobject thiz,
     jint mode) {
     
-    int current_tg = 0;
-    
-    {
-        std::lock_guard<std::mutex> lock(g_filter_mutex);
-        g_filter_mode = static_cast<FilterMode>(mode);
-        LOGI("Filter mode set to: %d", mode);
-        current_tg = g_last_tg;
-    } // Mutex released here
-    
-    // Apply filter change immediately if there's an active call
-    if (current_tg != 0) {
-        update_audio_for_talkgroup(current_tg);
+    if (dsd_tg_filter_set_mode(mode) != 0) {
+        LOGE("Invalid filter mode: %d", mode);
+        return;
     }
+    LOGI("Filter mode set to: %d", mode);
+    
+    // Apply filter change immediately to any active call
+    refresh_filter_mute();
 }
 
 /**
@@ -1467,33 +1470,22 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeSetFilterTalkgroups(
     jobject thiz,
     jintArray talkgroups) {
     
-    int current_tg = 0;
-    
-    {
-        std::lock_guard<std::mutex> lock(g_filter_mutex);
-        g_filter_talkgroups.clear();
-        
-        if (talkgroups != nullptr) {
-            jsize len = env->GetArrayLength(talkgroups);
-            jint* tgs = env->GetIntArrayElements(talkgroups, nullptr);
-            
-            for (jsize i = 0; i < len; i++) {
-                g_filter_talkgroups.insert(tgs[i]);
-            }
-            
-            env->ReleaseIntArrayElements(talkgroups, tgs, 0);
-            LOGI("Filter talkgroups updated: %zu entries", g_filter_talkgroups.size());
-        } else {
-            LOGI("Filter talkgroups cleared");
+    if (talkgroups != nullptr) {
+        jsize len = env->GetArrayLength(talkgroups);
+        jint* tgs = env->GetIntArrayElements(talkgroups, nullptr);
+        if (tgs) {
+            static_assert(sizeof(jint) == sizeof(int), "jint must alias int");
+            dsd_tg_filter_set_list(reinterpret_cast<const int*>(tgs), static_cast<size_t>(len));
+            env->ReleaseIntArrayElements(talkgroups, tgs, JNI_ABORT);
         }
-        
-        current_tg = g_last_tg;
-    } // Mutex released here
-    
-    // Apply filter change immediately if there's an active call
-    if (current_tg != 0) {
-        update_audio_for_talkgroup(current_tg);
+        LOGI("Filter talkgroups updated: %zu entries", dsd_tg_filter_count());
+    } else {
+        dsd_tg_filter_set_list(nullptr, 0);
+        LOGI("Filter talkgroups cleared");
     }
+    
+    // Apply filter change immediately to any active call
+    refresh_filter_mute();
 }
 
 /**
@@ -1505,19 +1497,11 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeAddFilterTalkgroup(
     jobject thiz,
     jint talkgroup) {
     
-    int current_tg = 0;
-    
-    {
-        std::lock_guard<std::mutex> lock(g_filter_mutex);
-        g_filter_talkgroups.insert(talkgroup);
-        LOGI("Added TG %d to filter list (now %zu entries)", talkgroup, g_filter_talkgroups.size());
-        current_tg = g_last_tg;
-    } // Mutex released here
+    dsd_tg_filter_add(talkgroup);
+    LOGI("Added TG %d to filter list (now %zu entries)", talkgroup, dsd_tg_filter_count());
     
-    // Apply filter change immediately if it affects current call
-    if (current_tg == talkgroup) {
-        update_audio_for_talkgroup(current_tg);
-    }
+    // Apply filter change immediately to any active call
+    refresh_filter_mute();
 }
 
 /**
@@ -1529,19 +1513,11 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeRemoveFilterTalkgroup(
     jobject thiz,
     jint talkgroup) {
     
-    int current_tg = 0;
-    
-    {
-        std::lock_guard<std::mutex> lock(g_filter_mutex);
-        g_filter_talkgroups.erase(talkgroup);
-        LOGI("Removed TG %d from filter list (now %zu entries)", talkgroup, g_filter_talkgroups.size());
-        current_tg = g_last_tg;
-    } // Mutex released here
+    dsd_tg_filter_remove(talkgroup);
+    LOGI("Removed TG %d from filter list (now %zu entries)", talkgroup, dsd_tg_filter_count());
     
-    // Apply filter change immediately if it affects current call
-    if (current_tg == talkgroup) {
-        update_audio_for_talkgroup(current_tg);
-    }
+    // Apply filter change immediately to any active call
+    refresh_filter_mute();
 }
 
 /**
@@ -1552,19 +1528,11 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeClearFilterTalkgroups(
     JNIEnv* env,
     jobject thiz) {
     
-    int current_tg = 0;
-    
-    {
-        std::lock_guard<std::mutex> lock(g_filter_mutex);
-        g_filter_talkgroups.clear();
-        LOGI("Filter talkgroups cleared");
-        current_tg = g_last_tg;
-    } // Mutex released here
+    dsd_tg_filter_set_list(nullptr, 0);
+    LOGI("Filter talkgroups cleared");
     
-    // Apply filter change immediately if there's an active call
-    if (current_tg != 0) {
-        update_audio_for_talkgroup(current_tg);
-    }
+    // Apply filter change immediately to any active call
+    refresh_filter_mute();
 }
 
 /**
@@ -1575,8 +1543,7 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeGetFilterMode(
     JNIEnv* env,
     jobject thiz) {
     
-    std::lock_guard<std::mutex> lock(g_filter_mutex);
-    return static_cast<jint>(g_filter_mode);
+    return static_cast<jint>(dsd_tg_filter_get_mode());
 }
 
 // ============================================================================
@@ -1671,6 +1638,7 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeOpenRtlSdrUsb(
     g_opts->rtlsdr_ppm_error = ppm;
     g_opts->rtl_bias_tee = bias_tee;
     g_opts->rtltcp_enabled = 0;  // Not using rtl_tcp
+    g_opts->rtl_external_iq = 0;
     g_opts->audio_in_type = AUDIO_IN_RTL;
     
     // DSP parameters (same as rtl_tcp mode)
@@ -1811,89 +1779,10 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeSetRtlSdrGain(
 #endif // NATIVE_RTLSDR_ENABLED
 
 // ============================================================================
-// HackRF Sample Feeding Support (rtl_tcp emulation)
+// HackRF Sample Feeding Support (in-process external IQ)
 // ============================================================================
 
-// TCP server thread that emulates rtl_tcp protocol for HackRF
-static void* hackrf_tcp_server_thread(void* arg) {
-    LOGI("HackRF TCP server thread started, waiting for connections...");
-    
-    while (g_hackrf_tcp_server_running) {
-        // Accept incoming connection
-        struct sockaddr_in client_addr;
-        socklen_t client_len = sizeof(client_addr);
-        
-        LOGI("Waiting for DSD to connect on 127.0.0.1:1235...");
-        int client_sock = accept(g_hackrf_tcp_server_sock, 
-                                 (struct sockaddr*)&client_addr, 
-                                 &client_len);
-        
-        if (client_sock < 0) {
-            if (g_hackrf_tcp_server_running) {
-                LOGE("Accept failed: %s (errno=%d)", strerror(errno), errno);
-                sleep(1);
-            }
-            continue;
-        }
-        
-        LOGI("DSD connected! Client socket=%d", client_sock);
-        g_hackrf_tcp_client_sock = client_sock;
-        
-        // Send rtl_tcp header: "RTL0" + tuner_type(4) + ngains(4)
-        uint8_t header[12];
-        header[0] = 'R';
-        header[1] = 'T';
-        header[2] = 'L';
-        header[3] = '0';
-        // Tuner type: 0 (unknown) - big endian
-        header[4] = 0;
-        header[5] = 0;
-        header[6] = 0;
-        header[7] = 0;
-        // Number of gains: 0 - big endian
-        header[8] = 0;
-        header[9] = 0;
-        header[10] = 0;
-        header[11] = 0;
-        
-        ssize_t sent = send(client_sock, header, sizeof(header), 0);
-        if (sent != sizeof(header)) {
-            LOGE("Failed to send rtl_tcp header: sent=%zd, expected=%zu, errno=%d (%s)", 
-                 sent, sizeof(header), errno, strerror(errno));
-            close(client_sock);
-            g_hackrf_tcp_client_sock = -1;
-            continue;
-        }
-        
-        LOGI("Sent rtl_tcp header (%zu bytes), ready for sample streaming", sizeof(header));
-        
-        // Keep connection alive - samples are fed via nativeFeedHackRfSamples()
-        while (g_hackrf_tcp_server_running && g_hackrf_tcp_client_sock == client_sock) {
-            // Check if client is still connected
-            uint8_t dummy;
-            ssize_t n = recv(client_sock, &dummy, 1, MSG_DONTWAIT);
-            if (n == 0) {
-                LOGI("Client disconnected cleanly");
-                break;
-            } else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
-                LOGI("Client disconnected with error: %s (errno=%d)", strerror(errno), errno);
-                break;
-            }
-            usleep(100000); // 100ms
-        }
-        
-        if (g_hackrf_tcp_client_sock == client_sock) {
-            close(client_sock);
-            g_hackrf_tcp_client_sock = -1;
-        }
-        LOGI("Client connection closed");
-    }
-    
-    LOGI("HackRF TCP server thread exiting");
-    return nullptr;
-}
-
-// Start HackRF mode - creates a TCP server for rtl_tcp emulation
+// Start HackRF mode - samples are pushed straight into the RTL input ring
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStartHackRfMode(
     JNIEnv* env,
@@ -1903,66 +1792,11 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStartHackRfMode(
     
     LOGI("Starting HackRF mode: freq=%lld Hz, sampleRate=%d Hz", (long long)frequency, sampleRate);
     
-    // Create TCP server socket
-    g_hackrf_tcp_server_sock = socket(AF_INET, SOCK_STREAM, 0);
-    if (g_hackrf_tcp_server_sock < 0) {
-        LOGE("Failed to create TCP socket: %s", strerror(errno));
-        return JNI_FALSE;
-    }
-    
-    // Set socket options
-    int opt = 1;
-    if (setsockopt(g_hackrf_tcp_server_sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-        LOGE("setsockopt SO_REUSEADDR failed: %s", strerror(errno));
-    }
-    
-    // Bind to localhost:1235
-    struct sockaddr_in server_addr;
-    memset(&server_addr, 0, sizeof(server_addr));
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // 127.0.0.1
-    server_addr.sin_port = htons(1235);
-    
-    if (bind(g_hackrf_tcp_server_sock, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
-        LOGE("Failed to bind TCP socket: %s", strerror(errno));
-        close(g_hackrf_tcp_server_sock);
-        g_hackrf_tcp_server_sock = -1;
-        return JNI_FALSE;
-    }
-    
-    // Listen for connections
-    if (listen(g_hackrf_tcp_server_sock, 1) < 0) {
-        LOGE("Failed to listen on TCP socket: %s", strerror(errno));
-        close(g_hackrf_tcp_server_sock);
-        g_hackrf_tcp_server_sock = -1;
-        return JNI_FALSE;
-    }
-    
-    LOGI("HackRF TCP server listening on 127.0.0.1:1235");
-    
-    // Start TCP server thread
-    g_hackrf_tcp_server_running = true;
-    if (pthread_create(&g_hackrf_tcp_server_thread, nullptr, hackrf_tcp_server_thread, nullptr) != 0) {
-        LOGE("Failed to create HackRF TCP server thread");
-        close(g_hackrf_tcp_server_sock);
-        g_hackrf_tcp_server_sock = -1;
-        g_hackrf_tcp_server_running = false;
-        return JNI_FALSE;
-    }
-    
-    // Give server thread time to start accepting connections
-    usleep(100000); // 100ms
-    LOGI("HackRF TCP server thread started and ready");
-    
     // Initialize DSD options if not already done
     if (!g_opts) {
         g_opts = (dsd_opts*)calloc(1, sizeof(dsd_opts));
         if (!g_opts) {
             LOGE("Failed to allocate opts");
-            g_hackrf_tcp_server_running = false;
-            pthread_join(g_hackrf_tcp_server_thread, nullptr);
-            close(g_hackrf_tcp_server_sock);
-            g_hackrf_tcp_server_sock = -1;
             return JNI_FALSE;
         }
         initOpts(g_opts);
@@ -1972,23 +1806,18 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStartHackRfMode(
         g_state = (dsd_state*)calloc(1, sizeof(dsd_state));
         if (!g_state) {
             LOGE("Failed to allocate state");
-            g_hackrf_tcp_server_running = false;
-            pthread_join(g_hackrf_tcp_server_thread, nullptr);
-            close(g_hackrf_tcp_server_sock);
-            g_hackrf_tcp_server_sock = -1;
             return JNI_FALSE;
         }
         initState(g_state);
     }
     
-    // Configure for HackRF input via rtl_tcp emulation
+    // Configure for HackRF input via the external IQ backend of the RTL pipeline
     g_opts->audio_in_type = AUDIO_IN_RTL;
-    snprintf(g_opts->audio_in_dev, sizeof(g_opts->audio_in_dev), "rtltcp");
-    
-    // Set RTL-TCP mode to read HackRF samples from localhost
-    g_opts->rtltcp_enabled = 1;
-    strcpy(g_opts->rtltcp_hostname, "127.0.0.1");
-    g_opts->rtltcp_portno = 1235; // Use non-standard port to avoid conflicts
+    snprintf(g_opts->audio_in_dev, sizeof(g_opts->audio_in_dev), "rtl");
+    g_opts->rtl_external_iq = 1;
+    g_opts->rtltcp_enabled = 0;
+    g_opts->rtl_android_usb_fd = -1;
+    g_opts->rtl_android_usb_path[0] = '\0';
     
     // Set RTL parameters for HackRF - HackRF sends raw IQ that needs FM demod
     g_opts->rtlsdr_center_freq = (uint32_t)frequency;
@@ -2000,7 +1829,7 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStartHackRfMode(
     g_opts->rtl_squelch_level = 0;  // Disabled - wide open for digital
     g_opts->rtl_volume_multiplier = 2;
     
-    LOGI("HackRF configured: rtl_tcp mode on %s:%d", g_opts->rtltcp_hostname, g_opts->rtltcp_portno);
+    LOGI("HackRF configured: external IQ push");
     
     // Audio output configuration - stereo for P25 Phase 2 TDMA support
     snprintf(g_opts->audio_out_dev, sizeof(g_opts->audio_out_dev), "android");
@@ -2035,25 +1864,23 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStartHackRfMode(
     return JNI_TRUE;
 }
 
-// Get the HackRF TCP server status
+// Legacy pipe/socket query; samples no longer travel through a descriptor
 extern "C" JNIEXPORT jint JNICALL
 Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeGetHackRfPipeFd(
     JNIEnv* env,
     jobject thiz) {
     
-    // Return the server socket FD (for compatibility, though not used for writing)
-    return g_hackrf_tcp_server_sock;
+    return -1;
 }
 
-// Feed samples from HackRF into DSD via TCP
+// Feed signed 8-bit HackRF samples directly into the RTL input ring
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeFeedHackRfSamples(
     JNIEnv* env,
     jobject thiz,
     jbyteArray samples) {
     
-    if (!g_hackrf_mode || g_hackrf_tcp_client_sock < 0) {
-        // No client connected yet, just drop samples
+    if (!g_hackrf_mode) {
         return JNI_TRUE;
     }
     
@@ -2062,47 +1889,17 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeFeedHackRfSamples(
         return JNI_TRUE;
     }
     
-    jbyte* buffer = env->GetByteArrayElements(samples, nullptr);
+    // Critical access avoids a JVM copy; the push only converts into the ring and never blocks
+    void* buffer = env->GetPrimitiveArrayCritical(samples, nullptr);
     if (!buffer) {
         LOGE("Failed to get sample buffer");
         return JNI_FALSE;
     }
     
-    // HackRF sends signed 8-bit samples (-128 to +127)
-    // rtl_tcp expects unsigned 8-bit samples (0 to 255)
-    // Convert: unsigned = signed + 128
-    uint8_t* converted = (uint8_t*)malloc(len);
-    if (!converted) {
-        env->ReleaseByteArrayElements(samples, buffer, JNI_ABORT);
-        return JNI_FALSE;
-    }
-    
-    for (jsize i = 0; i < len; i++) {
-        converted[i] = (uint8_t)(buffer[i] + 128);
-    }
-    
-    // Write converted samples to TCP client
-    ssize_t written = send(g_hackrf_tcp_client_sock, converted, len, MSG_NOSIGNAL);
-    
-    free(converted);
-    env->ReleaseByteArrayElements(samples, buffer, JNI_ABORT);
-    
-    if (written < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            // Would block - client reading too slow
-            return JNI_TRUE;
-        } else if (errno == EPIPE || errno == ECONNRESET) {
-            // Client disconnected
-            LOGI("TCP client disconnected (errno=%d)", errno);
-            close(g_hackrf_tcp_client_sock);
-            g_hackrf_tcp_client_sock = -1;
-            return JNI_TRUE;
-        } else {
-            LOGE("TCP send error: %s", strerror(errno));
-            return JNI_FALSE;
-        }
-    }
+    // -1 means the RTL stream has not started (or already stopped); drop samples until it does
+    (void)rtl_device_push_iq(RTL_IQ_CS8, buffer, (size_t)len);
     
+    env->ReleasePrimitiveArrayCritical(samples, buffer, JNI_ABORT);
     return JNI_TRUE;
 }
 
@@ -2115,24 +1912,10 @@ Java_com_example_dsd_1flutter_DsdFlutterPlugin_nativeStopHackRfMode(
     LOGI("Stopping HackRF mode");
     
     g_hackrf_mode = false;
-    g_hackrf_tcp_server_running = false;
-    
-    // Close client connection
-    if (g_hackrf_tcp_client_sock >= 0) {
-        close(g_hackrf_tcp_client_sock);
-        g_hackrf_tcp_client_sock = -1;
-    }
-    
-    // Close server socket
-    if (g_hackrf_tcp_server_sock >= 0) {
-        shutdown(g_hackrf_tcp_server_sock, SHUT_RDWR);
-        close(g_hackrf_tcp_server_sock);
-        g_hackrf_tcp_server_sock = -1;
+    if (g_opts) {
+        g_opts->rtl_external_iq = 0;
     }
     
-    // Wait for server thread to exit
-    pthread_join(g_hackrf_tcp_server_thread, nullptr);
-    
     LOGI("HackRF mode stopped");
 }
 